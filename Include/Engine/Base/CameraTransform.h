@@ -3,9 +3,10 @@
 #define CAMERATRANSFORM_H_
 
 #include <d3d12.h>
-#include <wrl.h>
 
 #include "MathUtility.h"
+#include "TrackedCommandList.h"
+#include "Geometry.h"
 
 class Camera3D
 {
@@ -18,266 +19,271 @@ private:
 
 public:
 	/// <summary>
-	/// J̍W擾
+	/// カメラの座標を取得
 	/// </summary>
 	/// <returns></returns>
 	inline const Vector3& GetEye()const { return eye_; }
 	/// <summary>
-	/// J̍WZbg
+	/// カメラの座標をセット
 	/// </summary>
 	/// <param name="eye"></param>
 	inline void SetEye(const Vector3& eye) { eye_ = eye; }
 	/// <summary>
-	/// _擾
+	/// 注視点を取得
 	/// </summary>
 	/// <returns></returns>
 	inline const Vector3& GetTarget()const { return target_; }
 	/// <summary>
-	/// _Zbg
+	/// 注視点をセット
 	/// </summary>
 	/// <param name="target"></param>
 	inline void SetTarget(const Vector3& target) { target_ = target; }
 	/// <summary>
-	/// xNg擾
+	/// 上ベクトルを取得
 	/// </summary>
 	/// <returns></returns>
 	inline const Vector3& GetUp()const { return up_; }
 	/// <summary>
-	/// xNgZbg
+	/// 上ベクトルをセット
 	/// </summary>
 	/// <param name="up"></param>
 	inline void SetUp(const Vector3& up) { up_ = up; }
 	/// <summary>
-	/// r[s擾
+	/// ビュー行列を取得
 	/// </summary>
 	/// <returns></returns>
 	inline const Matrix44& GetViewMatrix() const { return viewMatrix_; }
 
 	/// <summary>
-	/// ㉺p擾
+	/// 上下画角を取得
 	/// </summary>
 	/// <returns></returns>
 	inline float GetFovAngleY() const { return fovAngleY_; }
 	/// <summary>
-	/// ㉺pZbg
+	/// 上下画角をセット
 	/// </summary>
 	/// <param name="fovAngleY"></param>
 	inline void SetFovAngleY(float fovAngleY) { fovAngleY_ = fovAngleY; }
 	/// <summary>
-	/// AXyNg擾
+	/// アスペクト比を取得
 	/// </summary>
 	/// <returns></returns>
 	inline float GetAspectRatio() const { return aspectRatio_; }
 	/// <summary>
-	/// AXyNgZbg
+	/// アスペクト比をセット
 	/// </summary>
 	/// <param name="aspectRatio"></param>
 	inline void SetAspectRatio(float aspectRatio) { aspectRatio_ = aspectRatio; }
 	/// <summary>
-	/// O[擾
+	/// 前端を取得
 	/// </summary>
 	/// <returns></returns>
 	inline float GetNearZ() const { return nearZ_; }
 	/// <summary>
-	/// O[Zbg
+	/// 前端をセット
 	/// </summary>
 	/// <param name="nearZ"></param>
 	inline void SetNearZ(float nearZ) { nearZ_ = nearZ; }
 	/// <summary>
-	/// [擾
+	/// 奥端を取得
 	/// </summary>
 	/// <returns></returns>
 	inline float GetFarZ() const { return farZ_; }
 	/// <summary>
-	/// [Zbg
+	/// 奥端をセット
 	/// </summary>
 	/// <param name="farZ"></param>
 	inline void SetFarZ(float farZ) { farZ_ = farZ; }
 	/// <summary>
-	/// ˉes擾
+	/// 射影行列を取得
 	/// </summary>
 	/// <returns></returns>
 	inline const Matrix44& GetProjMatrix() const { return projMatrix_; }
+	/// <summary>
+	/// ビュー射影行列を取得
+	/// </summary>
+	/// <returns></returns>
+	inline const Matrix44& GetViewProjMatrix() const { return viewProjMatrix_; }
+	/// <summary>
+	/// 視錐台を取得(ワールド空間)
+	/// </summary>
+	/// <returns></returns>
+	inline const Frustum& GetFrustum() const { return frustum_; }
 
 	/// <summary>
-	/// OxNg擾
+	/// 前方ベクトルを取得
 	/// </summary>
 	/// <returns></returns>
 	inline Vector3 GetForward() const { return target_ - eye_; }
 	/// <summary>
-	/// OxNgZbg
+	/// 前方ベクトルをセット
 	/// </summary>
 	/// <param name="ray"></param>
 	inline void SetForward(const Vector3& ray) { target_ = eye_ + ray; }
 	/// <summary>
-	/// ExNg擾
+	/// 右ベクトルを取得
 	/// </summary>
 	/// <returns></returns>
 	inline Vector3 GetRight() const { return Cross(GetForward(), up_).Normalized(); }
 	
 	/// <summary>
-	/// _ړ
+	/// 注視点移動
 	/// </summary>
 	/// <param name="move"></param>
 	inline void MoveVector(const Vector3& move) { eye_ += move; target_ += move; }
 	/// <summary>
-	/// _ړ
+	/// 視点移動
 	/// </summary>
 	/// <param name="move"></param>
 	inline void MoveEyeVector(const Vector3& move) { eye_ += move; }
 
 	/// <summary>
-	/// obt@𐶐
-	/// </summary>
-	void CreateBuffer();
-	/// <summary>
-	/// sXV
+	/// 行列を更新
 	/// </summary>
 	void UpdateMatrix();
 	/// <summary>
-	/// s]
+	/// 行列を転送(フレームごとのアップロード領域に書き込む)
 	/// </summary>
-	/// <param name="cmdList">R}hXg</param>
-	/// <param name="rootParameterIndexWorldTransform">[gp[^̃CfbNX</param>
-	void SetGraphicsCommand(ID3D12GraphicsCommandList* cmdList, UINT rootParameterIndex);
+	/// <param name="cmdList">コマンドリスト</param>
+	/// <param name="rootParameterIndexWorldTransform">ルートパラメータのインデックス</param>
+	void SetGraphicsCommand(TrackedCommandList* cmdList, UINT rootParameterIndex);
 
 private:
-	// _W
+	// 視点座標
 	Vector3 eye_ = Vector3(0.0f, 0.0f, -1.0f);
-	// _W
+	// 注視点座標
 	Vector3 target_ = Vector3(0.0f, 0.0f, 0.0f);
-	// xNg
+	// 上ベクトル
 	Vector3 up_ = Vector3(0.0f, 1.0f, 0.0f);
-	// r[s
-	Matrix44 viewMatrix_;
+	// ビュー行列
+	Matrix44 viewMatrix_ = Matrix44::Identity;
 
-	// ㉺p
+	// 上下画角
 	float fovAngleY_ = Math::ToRadians(45.0f);
-	// AXyNg
+	// アスペクト比
 	float aspectRatio_ = 1280.0f / 720.0f;
-	// O[
+	// 前端
 	float nearZ_ = 0.1f;
-	// [
+	// 奥端
 	float farZ_ = 1000.0f;
-	// ˉes
-	Matrix44 projMatrix_;
-
-	//@萔obt@
-	Microsoft::WRL::ComPtr<ID3D12Resource> constBuffer_;
-	// }bvp
-	ConstDataCameraTransform* map_ = nullptr;
+	// 射影行列
+	Matrix44 projMatrix_ = Matrix44::Identity;
+	// ビュー射影行列
+	Matrix44 viewProjMatrix_ = Matrix44::Identity;
+	// 視錐台(UpdateMatrix で更新)
+	Frustum frustum_ = {};
 
 };
 
 class Camera2D {
 public:
 	/// <summary>
-	/// J̍W擾
+	/// カメラの座標を取得
 	/// </summary>
 	/// <returns></returns>
 	const Vector2& GetPosition() const { return position_; }
 	/// <summary>
-	/// J̍WZbg
+	/// カメラの座標をセット
 	/// </summary>
 	/// <param name="position"></param>
 	void SetPosition(const Vector2& position) { position_ = position; }
 	/// <summary>
-	/// J̔{擾
+	/// カメラの倍率を取得
 	/// </summary>
 	/// <returns></returns>
 	const Vector2& GetZoom() const { return zoom_; }
 	/// <summary>
-	/// J̔{Zbg
+	/// カメラの倍率をセット
 	/// </summary>
 	/// <param name="zoom"></param>
 	void SetZoom(const Vector2& zoom) { zoom_ = zoom; }
 	/// <summary>
-	/// r[s擾
+	/// ビュー行列を取得
 	/// </summary>
 	/// <returns></returns>
 	const Matrix44& GetViewMatrix() const { return viewMatrix_; }
 
 	/// <summary>
-	/// JW̍[擾
+	/// カメラ座標の左端を取得
 	/// </summary>
 	/// <returns></returns>
 	float GetLeft() const { return left_; }
 	/// <summary>
-	/// JW̍[Zbg
+	/// カメラ座標の左端をセット
 	/// </summary>
 	/// <param name="left"></param>
 	void SetLeft(float left) { left_ = left; }
 	/// <summary>
-	/// JW̉E[擾
+	/// カメラ座標の右端を取得
 	/// </summary>
 	/// <returns></returns>
 	float GetRight() const { return right_; }
 	/// <summary>
-	/// JW̉E[Zbg
+	/// カメラ座標の右端をセット
 	/// </summary>
 	/// <param name="right"></param>
 	void SetRight(float right) { right_ = right; }
 	/// <summary>
-	/// JW̏[擾
+	/// カメラ座標の上端を取得
 	/// </summary>
 	/// <returns></returns>
 	float GetTop() const { return top_; }
 	/// <summary>
-	/// JW̏[Zbg
+	/// カメラ座標の上端をセット
 	/// </summary>
 	/// <param name="top"></param>
 	void SetTop(float top) { top_ = top; }
 	/// <summary>
-	/// JW̉[擾
+	/// カメラ座標の下端を取得
 	/// </summary>
 	/// <returns></returns>
 	float GetBottom() const { return bottom_; }
 	/// <summary>
-	/// JW̉[Zbg
+	/// カメラ座標の下端をセット
 	/// </summary>
 	/// <param name="bottom"></param>
 	void SetBottom(float bottom) { bottom_ = bottom; }
 	/// <summary>
-	/// ˉes擾
+	/// 射影行列を取得
 	/// </summary>
 	/// <returns></returns>
 	const Matrix44& GetProjMatrix() const { return projMatrix_; }
 
 	/// <summary>
-	/// r[ˉes擾
+	/// ビュー射影行列を取得
 	/// </summary>
 	/// <returns></returns>
 	const Matrix44& GetViewProjMatrix() const { return viewProjMatrix_; }
 
 	/// <summary>
-	/// sXV
+	/// 行列を更新
 	/// </summary>
 	void UpdateMatrix();
 
 private:
-	// J̃[hW
+	// カメラのワールド座標
 	Vector2 position_ = {};
-	// Y[
+	// ズーム
 	Vector2 zoom_ = Vector2(1.0f, 1.0f);
-	// r[s
-	Matrix44 viewMatrix_;
+	// ビュー行列
+	Matrix44 viewMatrix_ = Matrix44::Identity;
 
-	// 
+	// 左
 	float left_ = -640.0f;
-	// E
+	// 右
 	float right_ = 640.0f;
-	// 
+	// 上
 	float top_ = 360;
-	// 
+	// 下
 	float bottom_ = -360;
-	// O[
+	// 前端
 	float nearZ_ = 0.1f;
-	// [
+	// 奥端
 	float farZ_ = 1000.0f;
-	// ˉes
-	Matrix44 projMatrix_;
-	// r[ˉes
-	Matrix44 viewProjMatrix_;
+	// 射影行列
+	Matrix44 projMatrix_ = Matrix44::Identity;
+	// ビュー射影行列
+	Matrix44 viewProjMatrix_ = Matrix44::Identity;
 
 };
 
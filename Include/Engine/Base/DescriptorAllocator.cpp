@@ -0,0 +1,306 @@
+#include "DescriptorAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+void DescriptorFreeList::Initalize(uint32_t capacity) {
+	capacity_ = capacity;
+	usedCount_ = 0;
+	freeRanges_.clear();
+	if (capacity > 0) {
+		freeRanges_.emplace(0, capacity);
+	}
+}
+
+uint32_t DescriptorFreeList::Allocate(uint32_t count) {
+	assert(count > 0);
+	for (auto it = freeRanges_.begin(); it != freeRanges_.end(); ++it) {
+		if (it->second < count) {
+			continue;
+		}
+		uint32_t offset = it->first;
+		uint32_t rest = it->second - count;
+		freeRanges_.erase(it);
+		if (rest > 0) {
+			freeRanges_.emplace(offset + count, rest);
+		}
+		usedCount_ += count;
+		return offset;
+	}
+	return kInvalidOffset;
+}
+
+void DescriptorFreeList::Free(uint32_t offset, uint32_t count) {
+	assert(count > 0 && offset + count <= capacity_);
+	assert(usedCount_ >= count);
+	usedCount_ -= count;
+
+	auto next = freeRanges_.lower_bound(offset);
+	assert(next == freeRanges_.end() || offset + count <= next->first);
+	// 後ろの空きとつなげる
+	if (next != freeRanges_.end() && offset + count == next->first) {
+		count += next->second;
+		next = freeRanges_.erase(next);
+	}
+	// 前の空きとつなげる
+	if (next != freeRanges_.begin()) {
+		auto prev = std::prev(next);
+		assert(prev->first + prev->second <= offset);
+		if (prev->first + prev->second == offset) {
+			prev->second += count;
+			return;
+		}
+	}
+	freeRanges_.emplace_hint(next, offset, count);
+}
+
+void DescriptorRing::Initalize(uint32_t capacity, WaitFunction wait) {
+	capacity_ = capacity;
+	wait_ = std::move(wait);
+
+	head_ = 0;
+	tail_ = 0;
+	usedCount_ = 0;
+	frameCount_ = 0;
+	pendingFrames_.clear();
+	statistics_ = {};
+}
+
+uint32_t DescriptorRing::Allocate(uint32_t count) {
+	assert(count > 0 && count <= capacity_);
+
+	uint32_t offset = 0;
+	while (!TryAllocate(count, offset)) {
+		// 現在のフレームだけで埋まっている場合は待っても空かない
+		if (pendingFrames_.empty()) {
+			assert(false && "フレームごとのディスクリプタが足りません");
+			return kInvalidOffset;
+		}
+		assert(wait_);
+		statistics_.stallCount++;
+		Release(wait_(pendingFrames_.front().fenceValue));
+	}
+
+	statistics_.usedCount = usedCount_;
+	statistics_.peakUsedCount = std::max(statistics_.peakUsedCount, usedCount_);
+	return offset;
+}
+
+void DescriptorRing::FinishFrame(uint64_t fenceValue) {
+	assert(pendingFrames_.empty() || pendingFrames_.back().fenceValue < fenceValue);
+	if (frameCount_ == 0) {
+		return;
+	}
+	pendingFrames_.push_back(PendingFrame{ fenceValue, head_, frameCount_ });
+	frameCount_ = 0;
+}
+
+void DescriptorRing::Release(uint64_t completedFenceValue) {
+	while (!pendingFrames_.empty() && pendingFrames_.front().fenceValue <= completedFenceValue) {
+		const PendingFrame& frame = pendingFrames_.front();
+		tail_ = frame.end;
+		usedCount_ -= frame.count;
+		pendingFrames_.pop_front();
+	}
+	// 空になったら先頭から使う(折り返しを減らす)
+	if (usedCount_ == 0) {
+		head_ = 0;
+		tail_ = 0;
+	}
+	statistics_.usedCount = usedCount_;
+}
+
+void DescriptorRing::ResetStatistics() {
+	statistics_ = {};
+	statistics_.usedCount = usedCount_;
+	statistics_.peakUsedCount = usedCount_;
+}
+
+bool DescriptorRing::TryAllocate(uint32_t count, uint32_t& offset) {
+	// head_ == tail_ は空か満杯のどちらか
+	if (head_ == tail_ && usedCount_ != 0) {
+		return false;
+	}
+
+	if (head_ >= tail_) {
+		// 空きは [head_, capacity_) と [0, tail_)
+		if (head_ + count > capacity_) {
+			// テーブルは連続している必要があるので末尾を捨てて先頭に折り返す
+			if (count > tail_) {
+				return false;
+			}
+			uint32_t waste = capacity_ - head_;
+			usedCount_ += waste;
+			frameCount_ += waste;
+			head_ = 0;
+			statistics_.wrapCount++;
+		}
+	}
+	else if (head_ + count > tail_) {
+		// 空きは [head_, tail_)
+		return false;
+	}
+
+	offset = head_;
+	usedCount_ += count;
+	frameCount_ += count;
+	head_ += count;
+	return true;
+}
+
+void StagingDescriptorAllocator::Initalize(CreateHeapFunction createHeap, uint32_t incrementSize, uint32_t pageSize) {
+	assert(createHeap);
+	assert(incrementSize > 0 && pageSize > 0);
+	createHeap_ = std::move(createHeap);
+	incrementSize_ = incrementSize;
+	pageSize_ = pageSize;
+	pages_.clear();
+	peakUsedCount_ = 0;
+}
+
+DescriptorHandle StagingDescriptorAllocator::Allocate(uint32_t count) {
+	assert(count > 0 && count <= pageSize_);
+
+	uint32_t pageIndex = 0;
+	uint32_t offset = DescriptorFreeList::kInvalidOffset;
+	for (; pageIndex < pages_.size(); pageIndex++) {
+		offset = pages_[pageIndex].freeList.Allocate(count);
+		if (offset != DescriptorFreeList::kInvalidOffset) {
+			break;
+		}
+	}
+	// どのページにも空きがなければ足す
+	if (offset == DescriptorFreeList::kInvalidOffset) {
+		Page& page = pages_.emplace_back();
+		page.heap = createHeap_(pageSize_);
+		page.freeList.Initalize(pageSize_);
+		offset = page.freeList.Allocate(count);
+	}
+
+	uint32_t usedCount = 0;
+	for (auto& page : pages_) {
+		usedCount += page.freeList.GetUsedCount();
+	}
+	peakUsedCount_ = std::max(peakUsedCount_, usedCount);
+
+	DescriptorHandle handle;
+	handle.cpu.ptr = pages_[pageIndex].heap.cpuStart.ptr + static_cast<SIZE_T>(offset) * incrementSize_;
+	handle.page = pageIndex;
+	handle.offset = offset;
+	handle.count = count;
+	handle.incrementSize = incrementSize_;
+	return handle;
+}
+
+void StagingDescriptorAllocator::Free(DescriptorHandle& handle) {
+	if (!handle.IsValid()) {
+		return;
+	}
+	assert(handle.page < pages_.size());
+	pages_[handle.page].freeList.Free(handle.offset, handle.count);
+	handle = {};
+}
+
+StagingDescriptorAllocator::Statistics StagingDescriptorAllocator::GetStatistics() const {
+	Statistics statistics;
+	statistics.pageCount = static_cast<uint32_t>(pages_.size());
+	statistics.capacity = pageSize_ * statistics.pageCount;
+	statistics.peakUsedCount = peakUsedCount_;
+	for (auto& page : pages_) {
+		statistics.usedCount += page.freeList.GetUsedCount();
+		statistics.freeRangeCount += page.freeList.GetFreeRangeCount();
+	}
+	return statistics;
+}
+
+void ShaderVisibleDescriptorAllocator::Initalize(
+	CreateHeapFunction createHeap, uint32_t incrementSize, uint32_t persistentCount, uint32_t dynamicCount, WaitFunction wait) {
+	assert(createHeap);
+	assert(incrementSize > 0);
+	heap_ = createHeap(persistentCount + dynamicCount);
+	incrementSize_ = incrementSize;
+	persistentCount_ = persistentCount;
+
+	freeList_.Initalize(persistentCount);
+	peakUsedCount_ = 0;
+	frameFrees_.clear();
+	pendingFrees_.clear();
+	pendingFreeCount_ = 0;
+
+	ring_.Initalize(dynamicCount, std::move(wait));
+}
+
+DescriptorHandle ShaderVisibleDescriptorAllocator::Allocate(uint32_t count) {
+	uint32_t offset = freeList_.Allocate(count);
+	if (offset == DescriptorFreeList::kInvalidOffset) {
+		assert(false && "永続的に割り当てるディスクリプタが足りません");
+		return DescriptorHandle{};
+	}
+	peakUsedCount_ = std::max(peakUsedCount_, freeList_.GetUsedCount());
+	return MakeHandle(offset, count);
+}
+
+void ShaderVisibleDescriptorAllocator::Free(DescriptorHandle& handle) {
+	if (!handle.IsValid()) {
+		return;
+	}
+	assert(handle.offset + handle.count <= persistentCount_);
+	frameFrees_.push_back(PendingFree{ 0, handle.offset, handle.count });
+	pendingFreeCount_ += handle.count;
+	handle = {};
+}
+
+DescriptorHandle ShaderVisibleDescriptorAllocator::AllocateDynamic(uint32_t count) {
+	uint32_t offset = ring_.Allocate(count);
+	if (offset == DescriptorRing::kInvalidOffset) {
+		return DescriptorHandle{};
+	}
+	return MakeHandle(persistentCount_ + offset, count);
+}
+
+void ShaderVisibleDescriptorAllocator::FinishFrame(uint64_t fenceValue) {
+	for (auto& frameFree : frameFrees_) {
+		frameFree.fenceValue = fenceValue;
+		pendingFrees_.push_back(frameFree);
+	}
+	frameFrees_.clear();
+	ring_.FinishFrame(fenceValue);
+}
+
+void ShaderVisibleDescriptorAllocator::Release(uint64_t completedFenceValue) {
+	while (!pendingFrees_.empty() && pendingFrees_.front().fenceValue <= completedFenceValue) {
+		const PendingFree& pendingFree = pendingFrees_.front();
+		freeList_.Free(pendingFree.offset, pendingFree.count);
+		pendingFreeCount_ -= pendingFree.count;
+		pendingFrees_.pop_front();
+	}
+	ring_.Release(completedFenceValue);
+}
+
+ShaderVisibleDescriptorAllocator::Statistics ShaderVisibleDescriptorAllocator::GetStatistics() const {
+	Statistics statistics;
+	statistics.capacity = persistentCount_;
+	statistics.usedCount = freeList_.GetUsedCount();
+	statistics.peakUsedCount = peakUsedCount_;
+	statistics.freeRangeCount = freeList_.GetFreeRangeCount();
+	statistics.pendingFreeCount = pendingFreeCount_;
+	statistics.dynamicCapacity = ring_.GetCapacity();
+	statistics.dynamic = ring_.GetStatistics();
+	return statistics;
+}
+
+void ShaderVisibleDescriptorAllocator::ResetStatistics() {
+	peakUsedCount_ = freeList_.GetUsedCount();
+	ring_.ResetStatistics();
+}
+
+DescriptorHandle ShaderVisibleDescriptorAllocator::MakeHandle(uint32_t offset, uint32_t count) const {
+	DescriptorHandle handle;
+	handle.cpu.ptr = heap_.cpuStart.ptr + static_cast<SIZE_T>(offset) * incrementSize_;
+	handle.gpu.ptr = heap_.gpuStart.ptr + static_cast<UINT64>(offset) * incrementSize_;
+	handle.offset = offset;
+	handle.count = count;
+	handle.incrementSize = incrementSize_;
+	return handle;
+}
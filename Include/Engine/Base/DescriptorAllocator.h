@@ -0,0 +1,361 @@
+#pragma once
+#ifndef DESCRIPTORALLOCATOR_H_
+#define DESCRIPTORALLOCATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <d3d12.h>
+#include <deque>
+#include <functional>
+#include <map>
+#include <vector>
+
+/// <summary>
+/// 切り出したディスクリプタ(連続した count 個)
+/// </summary>
+struct DescriptorHandle {
+	D3D12_CPU_DESCRIPTOR_HANDLE cpu = {};
+	// シェーダーから見えないヒープでは 0
+	D3D12_GPU_DESCRIPTOR_HANDLE gpu = {};
+	// ヒープ(ページ)の番号
+	uint32_t page = 0;
+	// ヒープ内の位置
+	uint32_t offset = 0;
+	uint32_t count = 0;
+	uint32_t incrementSize = 0;
+
+	inline bool IsValid() const { return count != 0; }
+	/// <summary>
+	/// i 番目の CPU ハンドルを取得
+	/// </summary>
+	inline D3D12_CPU_DESCRIPTOR_HANDLE GetCpuHandle(uint32_t i = 0) const {
+		return D3D12_CPU_DESCRIPTOR_HANDLE{ cpu.ptr + static_cast<SIZE_T>(i) * incrementSize };
+	}
+	/// <summary>
+	/// i 番目の GPU ハンドルを取得
+	/// </summary>
+	inline D3D12_GPU_DESCRIPTOR_HANDLE GetGpuHandle(uint32_t i = 0) const {
+		return D3D12_GPU_DESCRIPTOR_HANDLE{ gpu.ptr + static_cast<UINT64>(i) * incrementSize };
+	}
+};
+
+/// <summary>
+/// ディスクリプタヒープ(ページ)
+/// </summary>
+struct DescriptorHeapPage {
+	// テスト用の偽のヒープでは nullptr でよい
+	ID3D12DescriptorHeap* heap = nullptr;
+	D3D12_CPU_DESCRIPTOR_HANDLE cpuStart = {};
+	D3D12_GPU_DESCRIPTOR_HANDLE gpuStart = {};
+};
+
+/// <summary>
+/// 範囲を空きリストで管理する(先頭から探し、解放した範囲は隣とつなげる)
+/// </summary>
+class DescriptorFreeList
+{
+public:
+	static constexpr uint32_t kInvalidOffset = UINT32_MAX;
+
+public:
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="capacity">個数</param>
+	void Initalize(uint32_t capacity);
+	/// <summary>
+	/// 切り出す
+	/// </summary>
+	/// <param name="count">個数</param>
+	/// <returns>位置(空きがない場合は kInvalidOffset)</returns>
+	uint32_t Allocate(uint32_t count);
+	/// <summary>
+	/// 解放
+	/// </summary>
+	/// <param name="offset">位置</param>
+	/// <param name="count">個数</param>
+	void Free(uint32_t offset, uint32_t count);
+
+	inline uint32_t GetCapacity() const { return capacity_; }
+	inline uint32_t GetUsedCount() const { return usedCount_; }
+	/// <summary>
+	/// 空き範囲の数(多いほど断片化している)
+	/// </summary>
+	inline size_t GetFreeRangeCount() const { return freeRanges_.size(); }
+
+private:
+	uint32_t capacity_ = 0;
+	uint32_t usedCount_ = 0;
+	// 位置 → 個数
+	std::map<uint32_t, uint32_t> freeRanges_;
+
+};
+
+/// <summary>
+/// フレームごとに使い捨てる範囲を輪状に切り出す
+/// 切り出した範囲は FinishFrame で渡したフェンス値を GPU が通過するまで再利用しない
+/// </summary>
+class DescriptorRing
+{
+public:
+	// フェンス値まで待ち、完了したフェンス値を返す
+	using WaitFunction = std::function<uint64_t(uint64_t fenceValue)>;
+
+	static constexpr uint32_t kInvalidOffset = UINT32_MAX;
+
+	/// <summary>
+	/// 統計
+	/// </summary>
+	struct Statistics {
+		// 使用中の個数(GPU 待ちのフレームと現在のフレームの合計、折り返しの無駄を含む)
+		uint32_t usedCount = 0;
+		// 使用中の個数の最大
+		uint32_t peakUsedCount = 0;
+		// 末尾から先頭に折り返した回数
+		size_t wrapCount = 0;
+		// 空きがなく GPU を待った回数
+		size_t stallCount = 0;
+	};
+
+public:
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="capacity">個数</param>
+	/// <param name="wait">空きがないときに GPU を待つ関数</param>
+	void Initalize(uint32_t capacity, WaitFunction wait);
+	/// <summary>
+	/// 連続した範囲を切り出す
+	/// 空きがない場合は古いフレームの完了を待つ
+	/// </summary>
+	/// <param name="count">個数</param>
+	/// <returns>位置(現在のフレームの間だけ有効)</returns>
+	uint32_t Allocate(uint32_t count);
+	/// <summary>
+	/// 現在のフレームを締める
+	/// </summary>
+	/// <param name="fenceValue">このフレームのコマンドの完了を示すフェンス値</param>
+	void FinishFrame(uint64_t fenceValue);
+	/// <summary>
+	/// 完了したフレームの範囲を解放
+	/// </summary>
+	/// <param name="completedFenceValue">GPU が通過したフェンス値</param>
+	void Release(uint64_t completedFenceValue);
+
+	inline uint32_t GetCapacity() const { return capacity_; }
+	inline const Statistics& GetStatistics() const { return statistics_; }
+	void ResetStatistics();
+
+private:
+	// GPU の完了を待っているフレーム
+	struct PendingFrame {
+		uint64_t fenceValue;
+		// フレーム終了時の書き込み位置
+		uint32_t end;
+		// フレームで使った個数
+		uint32_t count;
+	};
+
+	/// <summary>
+	/// 空きから切り出す
+	/// </summary>
+	/// <returns>空きがない場合は false</returns>
+	bool TryAllocate(uint32_t count, uint32_t& offset);
+
+private:
+	uint32_t capacity_ = 0;
+	WaitFunction wait_;
+
+	uint32_t head_ = 0;
+	uint32_t tail_ = 0;
+	uint32_t usedCount_ = 0;
+	uint32_t frameCount_ = 0;
+	std::deque<PendingFrame> pendingFrames_;
+
+	Statistics statistics_;
+
+};
+
+/// <summary>
+/// シェーダーから見えないディスクリプタの割り当て(RTV、DSV、テーブルの元にするビュー)
+/// 足りなくなったらページ(ヒープ)を足す。解放はすぐに再利用する
+/// (CPU 側のディスクリプタはコマンドの記録時やコピー時に読まれるため GPU を待たなくてよい)
+/// </summary>
+class StagingDescriptorAllocator
+{
+public:
+	// count 個のヒープを作る関数(ヒープの種類は関数側で決める)
+	using CreateHeapFunction = std::function<DescriptorHeapPage(uint32_t count)>;
+
+	/// <summary>
+	/// 統計
+	/// </summary>
+	struct Statistics {
+		uint32_t pageCount = 0;
+		uint32_t capacity = 0;
+		uint32_t usedCount = 0;
+		uint32_t peakUsedCount = 0;
+		// 全ページの空き範囲の数
+		size_t freeRangeCount = 0;
+	};
+
+public:
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="createHeap">ヒープを作る関数</param>
+	/// <param name="incrementSize">ディスクリプタの間隔</param>
+	/// <param name="pageSize">ページあたりの個数</param>
+	void Initalize(CreateHeapFunction createHeap, uint32_t incrementSize, uint32_t pageSize);
+	/// <summary>
+	/// 連続した count 個を切り出す
+	/// </summary>
+	/// <param name="count">個数(ページの大きさ以下)</param>
+	/// <returns></returns>
+	DescriptorHandle Allocate(uint32_t count = 1);
+	/// <summary>
+	/// 解放
+	/// </summary>
+	/// <param name="handle">Allocate の戻り値(解放後は無効になる)</param>
+	void Free(DescriptorHandle& handle);
+
+	/// <summary>
+	/// 統計を取得
+	/// </summary>
+	/// <returns></returns>
+	Statistics GetStatistics() const;
+
+private:
+	struct Page {
+		DescriptorHeapPage heap;
+		DescriptorFreeList freeList;
+	};
+
+private:
+	CreateHeapFunction createHeap_;
+	uint32_t incrementSize_ = 0;
+	uint32_t pageSize_ = 0;
+	std::vector<Page> pages_;
+	uint32_t peakUsedCount_ = 0;
+
+};
+
+/// <summary>
+/// シェーダーから見えるディスクリプタヒープの割り当て
+/// 前半は永続的な割り当て(空きリストで再利用)、後半はフレームごとのテーブル(輪状に切り出す)
+/// 永続的な割り当ての解放は、そのフレームを GPU が終えるまで再利用しない
+/// ヒープは切り替えるとコストがかかるので一つだけ作る
+/// </summary>
+class ShaderVisibleDescriptorAllocator
+{
+public:
+	using CreateHeapFunction = StagingDescriptorAllocator::CreateHeapFunction;
+	using WaitFunction = DescriptorRing::WaitFunction;
+
+	/// <summary>
+	/// 統計
+	/// </summary>
+	struct Statistics {
+		uint32_t capacity = 0;
+		uint32_t usedCount = 0;
+		uint32_t peakUsedCount = 0;
+		size_t freeRangeCount = 0;
+		// GPU の完了を待って解放する個数
+		uint32_t pendingFreeCount = 0;
+		uint32_t dynamicCapacity = 0;
+		DescriptorRing::Statistics dynamic;
+	};
+
+public:
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="createHeap">ヒープを作る関数</param>
+	/// <param name="incrementSize">ディスクリプタの間隔</param>
+	/// <param name="persistentCount">永続的に割り当てる個数</param>
+	/// <param name="dynamicCount">フレームごとに割り当てる個数</param>
+	/// <param name="wait">フレームごとの範囲に空きがないときに GPU を待つ関数</param>
+	void Initalize(CreateHeapFunction createHeap, uint32_t incrementSize, uint32_t persistentCount, uint32_t dynamicCount, WaitFunction wait);
+	/// <summary>
+	/// 永続的に使う連続した count 個を切り出す
+	/// </summary>
+	/// <param name="count">個数</param>
+	/// <returns></returns>
+	DescriptorHandle Allocate(uint32_t count = 1);
+	/// <summary>
+	/// 永続的な割り当てを解放(現在のフレームを GPU が終えた後に再利用する)
+	/// </summary>
+	/// <param name="handle">Allocate の戻り値(解放後は無効になる)</param>
+	void Free(DescriptorHandle& handle);
+	/// <summary>
+	/// 現在のフレームだけ使う連続した count 個を切り出す
+	/// </summary>
+	/// <param name="count">個数</param>
+	/// <returns></returns>
+	DescriptorHandle AllocateDynamic(uint32_t count);
+	/// <summary>
+	/// 現在のフレームを締める
+	/// </summary>
+	/// <param name="fenceValue">このフレームのコマンドの完了を示すフェンス値</param>
+	void FinishFrame(uint64_t fenceValue);
+	/// <summary>
+	/// 完了したフレームの範囲を解放
+	/// </summary>
+	/// <param name="completedFenceValue">GPU が通過したフェンス値</param>
+	void Release(uint64_t completedFenceValue);
+
+	/// <summary>
+	/// ヒープを取得(SetDescriptorHeaps に渡す)
+	/// </summary>
+	/// <returns></returns>
+	inline ID3D12DescriptorHeap* GetHeap() const { return heap_.heap; }
+	/// <summary>
+	/// 永続的な割り当て全体を指すテーブルを取得(位置 offset がテーブルの offset 番目になる)
+	/// </summary>
+	/// <returns></returns>
+	inline D3D12_GPU_DESCRIPTOR_HANDLE GetPersistentTable() const { return heap_.gpuStart; }
+	/// <summary>
+	/// 永続的に割り当てられる個数を取得
+	/// </summary>
+	/// <returns></returns>
+	inline uint32_t GetPersistentCount() const { return persistentCount_; }
+	/// <summary>
+	/// 統計を取得(ピークや回数は ResetStatistics からの値)
+	/// </summary>
+	/// <returns></returns>
+	Statistics GetStatistics() const;
+	/// <summary>
+	/// 統計をリセット
+	/// </summary>
+	void ResetStatistics();
+
+private:
+	// GPU の完了を待っている解放
+	struct PendingFree {
+		uint64_t fenceValue;
+		uint32_t offset;
+		uint32_t count;
+	};
+
+	/// <summary>
+	/// ヒープ内の位置からハンドルを作る
+	/// </summary>
+	DescriptorHandle MakeHandle(uint32_t offset, uint32_t count) const;
+
+private:
+	DescriptorHeapPage heap_;
+	uint32_t incrementSize_ = 0;
+	uint32_t persistentCount_ = 0;
+
+	DescriptorFreeList freeList_;
+	uint32_t peakUsedCount_ = 0;
+	// 現在のフレームで解放したもの(fenceValue は FinishFrame で決まる)
+	std::vector<PendingFree> frameFrees_;
+	std::deque<PendingFree> pendingFrees_;
+	uint32_t pendingFreeCount_ = 0;
+
+	DescriptorRing ring_;
+
+};
+
+#endif
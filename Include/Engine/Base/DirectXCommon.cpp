@@ -1,5 +1,6 @@
 #include "DirectXCommon.h"
 
+#include <algorithm>
 #include <cassert>
 #include <d3dx12.h>
 #include <string>
@@ -13,18 +14,18 @@ DirectXCommon* DirectXCommon::GetInstance() {
 }
 
 void DirectXCommon::SetViewport(float left, float top, float width, float height) {
-	// r[|[g
+	// ビューポート
 	D3D12_VIEWPORT viewport = CD3DX12_VIEWPORT(left, top, width, height);
 	cmdList_->RSSetViewports(1, &viewport);
 }
 
 void DirectXCommon::SetScissorRect(int left, int top, int right, int bottom) {
-	// VU[`
+	// シザー矩形
 	D3D12_RECT scissorRect = CD3DX12_RECT(left, top, right, bottom);
 	cmdList_->RSSetScissorRects(1, &scissorRect);
 }
 
-void DirectXCommon::Initalize() {
+void DirectXCommon::Initalize(uint32_t frameCount) {
 	winApp_ = WinApp::GetInstance();
 
 #ifdef _DEBUG
@@ -38,155 +39,181 @@ void DirectXCommon::Initalize() {
 	DebugSuppressError();
 #endif // _DEBUG
 
-	CreateCommand();
-	CreateSwapChain();
+	gpuMemoryAllocator_.Initalize(device_.Get());
+	CreateDescriptorAllocators();
+	pipelineCache_.Initalize(device_.Get(), kPipelineCacheFilePath);
+	CreateCommand(frameCount);
+	CreateSwapChain(frameCount);
 	CreateRenderTargetView();
-	CreateDepthBuffer();
-	CreateFence();
+	renderGraphExecutor_.Initalize(device_.Get(), trackedCmdList_.GetStateTracker(), &rtvAllocator_, &dsvAllocator_);
+	CreateFence(frameCount);
+	CreateUploadRing();
+	CreateTextureUploader();
 }
 
 void DirectXCommon::PreDraw() {
-	// obNobt@̔ԍ擾iQȂ̂łOԂPԁj
-	UINT bbIndex = swapChain_->GetCurrentBackBufferIndex();
+	HRESULT result = S_FALSE;
+	// このフレームコンテキストを前回使ったフレームを GPU が終えるまで待つ
+	FrameContext& frame = frameContexts_[framePacer_.BeginFrame()];
+	uploadRing_.Release(framePacer_.GetCompletedValue());
+	srvAllocator_.Release(framePacer_.GetCompletedValue());
+	gpuMemoryAllocator_.Release(framePacer_.GetCompletedValue());
+	renderGraphExecutor_.Release(framePacer_.GetCompletedValue());
+	pipelineCache_.BeginFrame();
+	// キューをクリア
+	result = frame.cmdAllocator->Reset();
+	assert(SUCCEEDED(result));
+	// コマンドリストをためる準備
+	result = cmdList_->Reset(frame.cmdAllocator.Get(), nullptr);
+	assert(SUCCEEDED(result));
 
-	D3D12_RESOURCE_BARRIER barrierDesc = CD3DX12_RESOURCE_BARRIER::Transition(
-		backBuffers_[bbIndex].Get(),
-		D3D12_RESOURCE_STATE_PRESENT,
-		D3D12_RESOURCE_STATE_RENDER_TARGET);
+	// 覚えた状態と統計をフレームごとにリセット
+	trackedCmdList_.BeginFrame(cmdList_.Get());
 
-	cmdList_->ResourceBarrier(1, &barrierDesc);
+	// バックバッファの番号を取得
+	UINT bbIndex = swapChain_->GetCurrentBackBufferIndex();
+	// レンダーターゲットビューのハンドルを取得
+	D3D12_CPU_DESCRIPTOR_HANDLE rtvH = backBufferRtvs_.GetCpuHandle(bbIndex);
+
+	// バックバッファは表示状態で受け取って表示状態で返す(バリアはグラフが入れる)
+	renderGraph_.Reset();
+	backBufferHandle_ = renderGraph_.ImportTexture("BackBuffer", RenderGraph::kUsagePresent, RenderGraph::kUsagePresent);
+	renderGraphExecutor_.BindTexture(backBufferHandle_, backBuffers_[bbIndex].Get(), rtvH);
+
+	// 深度バッファは使うパスがあるフレームだけ一時リソースとして置く
+	RenderGraph::TextureDesc depthDesc;
+	depthDesc.width = winApp_->GetWindowWidth();
+	depthDesc.height = winApp_->GetWindowHeight();
+	depthDesc.format = DXGI_FORMAT_D32_FLOAT;
+	depthDesc.clearDepth = 1.0f;
+	depthBufferHandle_ = renderGraph_.CreateTexture("DepthBuffer", depthDesc);
+}
 
-	// _[^[Qbgr[pfBXNv^q[ṽnh擾
-	CD3DX12_CPU_DESCRIPTOR_HANDLE rtvH = CD3DX12_CPU_DESCRIPTOR_HANDLE(
-		rtvHeap_->GetCPUDescriptorHandleForHeapStart(), bbIndex,
-		device_->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV));
-	// [xXeVr[pfXNv^q[ṽnh擾
-	CD3DX12_CPU_DESCRIPTOR_HANDLE dsvH =
-		CD3DX12_CPU_DESCRIPTOR_HANDLE(dsvHeap_->GetCPUDescriptorHandleForHeapStart());
-	cmdList_->OMSetRenderTargets(1, &rtvH, false, &dsvH);
+void DirectXCommon::AddScenePass(std::function<void()> draw) {
+	renderGraph_.AddPass("Scene",
+		{ { backBufferHandle_, RenderGraph::kUsageRenderTarget }, { depthBufferHandle_, RenderGraph::kUsageDepthWrite } },
+		[this, draw = std::move(draw)](RenderGraphExecutor& executor) {
+			D3D12_CPU_DESCRIPTOR_HANDLE rtvH = executor.GetView(backBufferHandle_);
+			D3D12_CPU_DESCRIPTOR_HANDLE dsvH = executor.GetView(depthBufferHandle_);
+			cmdList_->OMSetRenderTargets(1, &rtvH, false, &dsvH);
 
-	ClearRenderTarget();
-	ClearDepthBuffer();
+			ClearRenderTarget();
+			ClearDepthBuffer();
 
+			// ビューポート
+			SetViewport(0.0f, 0.0f, static_cast<float>(winApp_->GetWindowWidth()), static_cast<float>(winApp_->GetWindowHeight()));
+			// シザー矩形
+			SetScissorRect(0, 0, winApp_->GetWindowWidth(), winApp_->GetWindowHeight());
 
-	// r[|[g
-	SetViewport(0.0f, 0.0f, static_cast<float>(winApp_->GetWindowWidth()), static_cast<float>(winApp_->GetWindowHeight()));
-	// VU[`
-	SetScissorRect(0, 0, winApp_->GetWindowWidth(), winApp_->GetWindowHeight());
+			draw();
+		});
 }
 
 void DirectXCommon::PostDraw() {
 	HRESULT result = S_FALSE;
-	// obNobt@̔ԍ擾iQȂ̂łOԂPԁj
-	UINT bbIndex = swapChain_->GetCurrentBackBufferIndex();
 
-	D3D12_RESOURCE_BARRIER barrierDesc = CD3DX12_RESOURCE_BARRIER::Transition(
-		backBuffers_[bbIndex].Get(),
-		D3D12_RESOURCE_STATE_RENDER_TARGET,
-		D3D12_RESOURCE_STATE_PRESENT);
-	// \[XoA߂
-	cmdList_->ResourceBarrier(1, &barrierDesc);
+	// パスをバリアと共に記録
+	renderGraphExecutor_.Compile(renderGraph_);
+	renderGraphExecutor_.Execute(renderGraph_, &trackedCmdList_);
 
-	// ߂̃N[Y
+	// 命令のクローズ
 	result = cmdList_->Close();
 	assert(SUCCEEDED(result));
 
-	// R}hXg̎s
+	// 積んだテクスチャのコピーをまとめて送り、終えてから描画を始めるよう GPU を待たせる(CPU は待たない)
+	textureUploader_.Submit();
+	if (textureUploader_.GetLastFenceValue() > textureCopyWaitValue_) {
+		textureCopyWaitValue_ = textureUploader_.GetLastFenceValue();
+		textureCopyQueue_.InsertWait(cmdQueue_.Get(), textureCopyWaitValue_);
+	}
+
+	// コマンドリストの実行
 	ID3D12CommandList* cmdLists[] = { cmdList_.Get() };
 	cmdQueue_->ExecuteCommandLists(1, cmdLists);
 
-	// ʂɕ\obt@tbvi\̓ւj
+	// 画面に表示するバッファをフリップ（裏表の入れ替え）
 	result = swapChain_->Present(1, 0);
 	assert(SUCCEEDED(result));
 
-	// R}h̎s҂
-	cmdQueue_->Signal(fence_.Get(), ++fenceVal_);
-	if (fence_->GetCompletedValue() != fenceVal_) {
-		HANDLE event = CreateEvent(nullptr, false, false, nullptr);
-		fence_->SetEventOnCompletion(fenceVal_, event);
-		if (event != 0) {
-			WaitForSingleObject(event, INFINITE);
-			CloseHandle(event);
-		}
-	}
-	// L[NA
-	result = cmdAllocator_->Reset();
-	assert(SUCCEEDED(result));
-	// ĂуR}hXg߂鏀
-	result = cmdList_->Reset(cmdAllocator_.Get(), nullptr);
-	assert(SUCCEEDED(result));
+	// 完了は待たずに次のフレームへ(待つのはフレームコンテキストが一周したときだけ)
+	uint64_t fenceValue = framePacer_.EndFrame();
+	uploadRing_.FinishFrame(fenceValue);
+	srvAllocator_.FinishFrame(fenceValue);
+	gpuMemoryAllocator_.FinishFrame(fenceValue);
+	renderGraphExecutor_.FinishFrame(fenceValue);
 }
 
 void DirectXCommon::ClearRenderTarget() {
-	UINT bbIndex = swapChain_->GetCurrentBackBufferIndex();
-
-	// _[^[Qbgr[pfBXNv^q[ṽnh擾
-	CD3DX12_CPU_DESCRIPTOR_HANDLE rtvH = CD3DX12_CPU_DESCRIPTOR_HANDLE(
-		rtvHeap_->GetCPUDescriptorHandleForHeapStart(), bbIndex,
-		device_->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV));
-
 	FLOAT clearcolor[] = { clearColor_.x, clearColor_.y, clearColor_.z, clearColor_.w };
-	cmdList_->ClearRenderTargetView(rtvH, clearcolor, 0, nullptr);
+	cmdList_->ClearRenderTargetView(renderGraphExecutor_.GetView(backBufferHandle_), clearcolor, 0, nullptr);
 }
 
 void DirectXCommon::ClearDepthBuffer() {
-	CD3DX12_CPU_DESCRIPTOR_HANDLE dsvH =
-		CD3DX12_CPU_DESCRIPTOR_HANDLE(dsvHeap_->GetCPUDescriptorHandleForHeapStart());
-	// [xobt@̃NA
-	cmdList_->ClearDepthStencilView(dsvH, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr);
+	// 深度バッファのクリア
+	cmdList_->ClearDepthStencilView(renderGraphExecutor_.GetView(depthBufferHandle_), D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr);
 }
 
-DirectXCommon::ComPtr<ID3D12Resource> DirectXCommon::CreateResourceBuffer(UINT64 size)	{
-	HRESULT result = S_FALSE;
-	ComPtr<ID3D12Resource> tmpBuffer;
+void DirectXCommon::WaitIdle() {
+	textureUploader_.WaitIdle();
+	uint64_t completedValue = framePacer_.WaitIdle();
+	uploadRing_.Release(completedValue);
+	srvAllocator_.Release(completedValue);
+	gpuMemoryAllocator_.Release(completedValue);
+	renderGraphExecutor_.Release(completedValue);
+}
 
-	D3D12_HEAP_PROPERTIES heapProp = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-	D3D12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
-	// obt@̐
-	result = device_->CreateCommittedResource(
-		&heapProp, D3D12_HEAP_FLAG_NONE,
-		&resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ,
-		nullptr, IID_PPV_ARGS(&tmpBuffer));
-	assert(SUCCEEDED(result));
+D3D12_GPU_DESCRIPTOR_HANDLE DirectXCommon::CreateDescriptorTable(std::span<const D3D12_CPU_DESCRIPTOR_HANDLE> sources) {
+	assert(!sources.empty());
+	DescriptorHandle table = srvAllocator_.AllocateDynamic(static_cast<uint32_t>(sources.size()));
+	// 元のディスクリプタはばらばらの位置にあるので一つずつコピー
+	for (uint32_t i = 0; i < table.count; i++) {
+		device_->CopyDescriptorsSimple(1, table.GetCpuHandle(i), sources[i], D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	}
+	return table.gpu;
+}
 
-	return tmpBuffer;
+GpuAllocation DirectXCommon::CreateResourceBuffer(UINT64 size)	{
+	D3D12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+	// バッファの生成(共有のアップロードヒープに配置)
+	return gpuMemoryAllocator_.CreateResource(
+		GpuMemoryAllocator::kMemoryTypeUpload, resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ);
 }
 
 void DirectXCommon::CreateFactory() {
 	HRESULT result = S_FALSE;
-	// DXGIt@Ng[̐
+	// DXGIファクトリーの生成
 	result = CreateDXGIFactory(IID_PPV_ARGS(&dxgiFactory_));
 	assert(SUCCEEDED(result));
 }
 
 void DirectXCommon::CreateDevice() {
 	HRESULT result = S_FALSE;
-	// A_v^[̗񋓗p
+	// アダプターの列挙用
 	std::vector<ComPtr<IDXGIAdapter4>> adapters;
-	// ɓ̖OA_v^[IuWFNg
+	// ここに特定の名前を持つアダプターオブジェクトが入る
 	ComPtr<IDXGIAdapter4> tmpAdapter = nullptr;
 
-	// ptH[}X̂珇ɁAׂẴA_v^[񋓂
+	// パフォーマンスが高いものから順に、すべてのアダプターを列挙する
 	for (UINT i = 0;
 		dxgiFactory_->EnumAdapterByGpuPreference(
 			i, DXGI_GPU_PREFERENCE_HIGH_PERFORMANCE, IID_PPV_ARGS(&tmpAdapter)) != DXGI_ERROR_NOT_FOUND;
 		i++) {
-		adapters.push_back(tmpAdapter); // zɒǉ
+		adapters.push_back(tmpAdapter); // 配列に追加する
 	}
 
-	// ÓȃA_v^Iʂ
+	// 妥当なアダプタを選別する
 	for (auto& it : adapters) {
 		DXGI_ADAPTER_DESC3 adapterDesc;
-		// A_v^[̏擾
+		// アダプターの情報を取得する
 		it->GetDesc3(&adapterDesc);
-		// \tgEFAfoCX
+		// ソフトウェアデバイスを回避
 		if (!(adapterDesc.Flags & DXGI_ADAPTER_FLAG3_SOFTWARE)) {
 			tmpAdapter = it;
 			break;
 		}
 	}
 
-	// Ήxz
+	// 対応レベル配列
 	D3D_FEATURE_LEVEL levels[] =
 	{	D3D_FEATURE_LEVEL_12_1,
 		D3D_FEATURE_LEVEL_12_0,
@@ -203,36 +230,60 @@ void DirectXCommon::CreateDevice() {
 	}
 }
 
-void DirectXCommon::CreateCommand() {
+void DirectXCommon::CreateDescriptorAllocators() {
+	auto createHeap = [this](D3D12_DESCRIPTOR_HEAP_TYPE type, bool isShaderVisible) {
+		return [this, type, isShaderVisible](uint32_t count) { return CreateDescriptorHeap(type, count, isShaderVisible); };
+	};
+	// テクスチャとフレームごとのテーブルで一つのヒープを共有する(切り替えはコストがかかる)
+	srvAllocator_.Initalize(createHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, true),
+		device_->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV),
+		kPersistentDescriptorCount, kDynamicDescriptorCount,
+		[this](uint64_t fenceValue) { return framePacer_.Wait(fenceValue); });
+	// シェーダーから見えないヒープは足りなくなったらページを足す
+	stagingAllocator_.Initalize(createHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, false),
+		device_->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV), kStagingDescriptorPageSize);
+	rtvAllocator_.Initalize(createHeap(D3D12_DESCRIPTOR_HEAP_TYPE_RTV, false),
+		device_->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV), kRtvDescriptorPageSize);
+	dsvAllocator_.Initalize(createHeap(D3D12_DESCRIPTOR_HEAP_TYPE_DSV, false),
+		device_->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_DSV), kRtvDescriptorPageSize);
+}
+
+void DirectXCommon::CreateCommand(uint32_t frameCount) {
 	HRESULT result = S_FALSE;
-	// R}hAP[^𐶐
-	result = device_->CreateCommandAllocator(
-		D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&cmdAllocator_));
-	assert(SUCCEEDED(result));
+	// フレームコンテキストごとにコマンドアロケータを生成
+	frameContexts_.resize(frameCount);
+	for (auto& frame : frameContexts_) {
+		result = device_->CreateCommandAllocator(
+			D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&frame.cmdAllocator));
+		assert(SUCCEEDED(result));
+	}
 
-	// R}hXg𐶐
+	// コマンドリストを生成
 	result = device_->CreateCommandList(
-		0, D3D12_COMMAND_LIST_TYPE_DIRECT, cmdAllocator_.Get(), nullptr, IID_PPV_ARGS(&cmdList_));
+		0, D3D12_COMMAND_LIST_TYPE_DIRECT, frameContexts_[0].cmdAllocator.Get(), nullptr, IID_PPV_ARGS(&cmdList_));
+	assert(SUCCEEDED(result));
+	// PreDraw でリセットするので閉じておく
+	result = cmdList_->Close();
 	assert(SUCCEEDED(result));
 
-	// R}hL[̐ݒ
+	// コマンドキューの設定
 	D3D12_COMMAND_QUEUE_DESC cmdQueueDesc = {};
-	// R}hL[𐶐
+	// コマンドキューを生成
 	result = device_->CreateCommandQueue(&cmdQueueDesc, IID_PPV_ARGS(&cmdQueue_));
 	assert(SUCCEEDED(result));
 }
 
-void DirectXCommon::CreateSwapChain() {
+void DirectXCommon::CreateSwapChain(uint32_t frameCount) {
 	HRESULT result = S_FALSE;
-	// Xbv`F[̐ݒ
+	// スワップチェーンの設定
 	DXGI_SWAP_CHAIN_DESC1 swapChainDesc = {};
 
 	swapChainDesc.Width = winApp_->GetWindowWidth();
 	swapChainDesc.Height = winApp_->GetWindowHeight();
-	swapChainDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM; // F̏
-	swapChainDesc.SampleDesc.Count = 1; // }`TvȂ
-	swapChainDesc.BufferUsage = DXGI_USAGE_BACK_BUFFER; // obNobt@p
-	swapChainDesc.BufferCount = 2; // obt@Qݒ
+	swapChainDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM; // 色情報の書式
+	swapChainDesc.SampleDesc.Count = 1; // マルチサンプルしない
+	swapChainDesc.BufferUsage = DXGI_USAGE_BACK_BUFFER; // バックバッファ用
+	swapChainDesc.BufferCount = std::max(frameCount, 2u); // 先行して積むフレーム数(最低２つ)
 	swapChainDesc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
 	swapChainDesc.Flags = DXGI_SWAP_CHAIN_FLAG_ALLOW_MODE_SWITCH;
 
@@ -243,7 +294,7 @@ void DirectXCommon::CreateSwapChain() {
 		nullptr, nullptr, &swapChain1);
 	assert(SUCCEEDED(result));
 
-	// IDXGISwapChain1̃IuWFNgIDXGISwapChain4ɕϊ
+	// 生成したIDXGISwapChain1のオブジェクトをIDXGISwapChain4に変換する
 	result = swapChain1.As(&swapChain_);
 	assert(SUCCEEDED(result));
 }
@@ -255,73 +306,214 @@ void DirectXCommon::CreateRenderTargetView() {
 	result = swapChain_->GetDesc(&swapChainDesc);
 	assert(SUCCEEDED(result));
 
-	// fXNv^q[v̐
-	D3D12_DESCRIPTOR_HEAP_DESC rtvHeapDesc = {};
-	rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV; // _[^[Qbgr[Ȃ̂ RTV
-	rtvHeapDesc.NodeMask = 0;
-	rtvHeapDesc.NumDescriptors = swapChainDesc.BufferCount; // \̂Q
-	rtvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE; // ɎwȂ
-
-	result = device_->CreateDescriptorHeap(&rtvHeapDesc, IID_PPV_ARGS(&rtvHeap_));
-	assert(SUCCEEDED(result));
-
+	// バッファの数だけ並べて確保
+	backBufferRtvs_ = rtvAllocator_.Allocate(swapChainDesc.BufferCount);
 
 	backBuffers_.resize(swapChainDesc.BufferCount);
-	// Xbv`F[ׂ̂Ẵobt@ɂď
+	// スワップチェーンのすべてのバッファについて処理する
 	for (size_t i = 0; i < backBuffers_.size(); i++) {
-		// Xbv`F[obt@擾
+		// スワップチェーンからバッファを取得
 		result = swapChain_->GetBuffer((UINT)i, IID_PPV_ARGS(&backBuffers_[i]));
 		assert(SUCCEEDED(result));
-		// fXNv^q[ṽnh擾
-		D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = rtvHeap_->GetCPUDescriptorHandleForHeapStart();
-		// \ŃAhX
-		rtvHandle.ptr += i * device_->GetDescriptorHandleIncrementSize(rtvHeapDesc.Type);
-		// _[^[Qbgr[̐ݒ
+		// 裏か表かでアドレスがずれる
+		D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = backBufferRtvs_.GetCpuHandle(static_cast<uint32_t>(i));
+		// レンダーターゲットビューの設定
 		D3D12_RENDER_TARGET_VIEW_DESC rtvDesc = {};
-		// VF[_[̌vZʂSRGBɕϊď
+		// シェーダーの計算結果をSRGBに変換して書き込む
 		rtvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
 		rtvDesc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2D;
-		// _[^[Qbgr[̐
+		// レンダーターゲットビューの生成
 		device_->CreateRenderTargetView(backBuffers_[i].Get(), &rtvDesc, rtvHandle);
+		// 表示状態から始まる
+		trackedCmdList_.GetStateTracker()->Register(backBuffers_[i].Get(), D3D12_RESOURCE_STATE_PRESENT);
+	}
+}
+
+void DirectXCommon::CreateFence(uint32_t frameCount)
+{
+	fenceQueue_.Initalize(device_.Get(), cmdQueue_.Get());
+	framePacer_.Initalize(&fenceQueue_, frameCount);
+}
+
+void DirectXCommon::CreateUploadRing()
+{
+	// 永続的にマップしておく
+	uploadBuffer_ = CreateResourceBuffer(kUploadRingSize);
+	void* map = nullptr;
+	HRESULT result = uploadBuffer_->Map(0, nullptr, &map);
+	assert(SUCCEEDED(result));
+
+	uploadRing_.Initalize(map, uploadBuffer_->GetGPUVirtualAddress(), kUploadRingSize,
+		[this](uint64_t fenceValue) { return framePacer_.Wait(fenceValue); });
+}
+
+void DirectXCommon::CreateTextureUploader()
+{
+	// 永続的にマップしておく
+	textureStagingBuffer_ = CreateResourceBuffer(kTextureStagingSize);
+	void* map = nullptr;
+	HRESULT result = textureStagingBuffer_->Map(0, nullptr, &map);
+	assert(SUCCEEDED(result));
+
+	textureCopyQueue_.Initalize(device_.Get(), textureStagingBuffer_.Get());
+	textureUploader_.Initalize(&textureCopyQueue_, map, kTextureStagingSize);
+}
+
+DescriptorHeapPage DirectXCommon::CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t count, bool isShaderVisible)
+{
+	D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+	heapDesc.Type = type;
+	heapDesc.NumDescriptors = count;
+	heapDesc.Flags = isShaderVisible ? D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE : D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+	ComPtr<ID3D12DescriptorHeap>& heap = descriptorHeaps_.emplace_back();
+	HRESULT result = device_->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&heap));
+	assert(SUCCEEDED(result));
+
+	DescriptorHeapPage page;
+	page.heap = heap.Get();
+	page.cpuStart = heap->GetCPUDescriptorHandleForHeapStart();
+	if (isShaderVisible) {
+		page.gpuStart = heap->GetGPUDescriptorHandleForHeapStart();
 	}
+	return page;
 }
 
-void DirectXCommon::CreateDepthBuffer()
+DirectXCommon::FenceQueue::~FenceQueue()
+{
+	if (event_ != nullptr) {
+		CloseHandle(event_);
+	}
+}
+
+void DirectXCommon::FenceQueue::Initalize(ID3D12Device* device, ID3D12CommandQueue* cmdQueue)
 {
 	HRESULT result = S_FALSE;
+	cmdQueue_ = cmdQueue;
+	result = device->CreateFence(fenceVal_, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence_));
+	assert(SUCCEEDED(result));
+	// 待つたびに作らないように一度だけ生成
+	event_ = CreateEvent(nullptr, false, false, nullptr);
+	assert(event_ != nullptr);
+}
 
-	CD3DX12_HEAP_PROPERTIES depthHeapProp = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+uint64_t DirectXCommon::FenceQueue::Signal()
+{
+	HRESULT result = cmdQueue_->Signal(fence_.Get(), ++fenceVal_);
+	assert(SUCCEEDED(result));
+	return fenceVal_;
+}
 
-	CD3DX12_RESOURCE_DESC depthResourceDesc = CD3DX12_RESOURCE_DESC::Tex2D(
-		DXGI_FORMAT_D32_FLOAT, winApp_->GetWindowWidth(), winApp_->GetWindowHeight(), 1, 0, 1, 0,
-		D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL);
+uint64_t DirectXCommon::FenceQueue::GetCompletedValue()
+{
+	return fence_->GetCompletedValue();
+}
 
-	CD3DX12_CLEAR_VALUE depthClearValue = CD3DX12_CLEAR_VALUE(DXGI_FORMAT_D32_FLOAT, 1.0f, 0);
+uint64_t DirectXCommon::FenceQueue::Wait(uint64_t fenceValue)
+{
+	if (fence_->GetCompletedValue() < fenceValue) {
+		HRESULT result = fence_->SetEventOnCompletion(fenceValue, event_);
+		assert(SUCCEEDED(result));
+		WaitForSingleObject(event_, INFINITE);
+	}
+	return fence_->GetCompletedValue();
+}
 
-	result = device_->CreateCommittedResource(
-		&depthHeapProp, D3D12_HEAP_FLAG_NONE,
-		&depthResourceDesc, D3D12_RESOURCE_STATE_DEPTH_WRITE,
-		&depthClearValue, IID_PPV_ARGS(&depthBuff_));
+void DirectXCommon::FenceQueue::InsertWait(ID3D12CommandQueue* queue, uint64_t fenceValue)
+{
+	HRESULT result = queue->Wait(fence_.Get(), fenceValue);
 	assert(SUCCEEDED(result));
+}
+
+void DirectXCommon::TextureCopyQueue::Initalize(ID3D12Device* device, ID3D12Resource* staging)
+{
+	HRESULT result = S_FALSE;
+	device_ = device;
+	staging_ = staging;
 
-	D3D12_DESCRIPTOR_HEAP_DESC dsvHeapDesc = {};
-	dsvHeapDesc.NumDescriptors = 1;
-	dsvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_DSV;
-	result = device_->CreateDescriptorHeap(&dsvHeapDesc, IID_PPV_ARGS(&dsvHeap_));
+	// コピー専用のキュー
+	D3D12_COMMAND_QUEUE_DESC cmdQueueDesc = {};
+	cmdQueueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+	result = device_->CreateCommandQueue(&cmdQueueDesc, IID_PPV_ARGS(&cmdQueue_));
 	assert(SUCCEEDED(result));
 
-	D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc = {};
-	dsvDesc.Format = DXGI_FORMAT_D32_FLOAT;
-	dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
-	device_->CreateDepthStencilView(
-		depthBuff_.Get(), &dsvDesc, dsvHeap_->GetCPUDescriptorHandleForHeapStart());
+	result = device_->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&cmdAllocator_));
+	assert(SUCCEEDED(result));
+	result = device_->CreateCommandList(
+		0, D3D12_COMMAND_LIST_TYPE_COPY, cmdAllocator_.Get(), nullptr, IID_PPV_ARGS(&cmdList_));
+	assert(SUCCEEDED(result));
+	// 最初のコピーでリセットするので閉じておく
+	result = cmdList_->Close();
+	assert(SUCCEEDED(result));
+
+	fenceQueue_.Initalize(device_, cmdQueue_.Get());
 }
 
-void DirectXCommon::CreateFence()
+void DirectXCommon::TextureCopyQueue::CopyTextureRegion(ID3D12Resource* destination, uint32_t subresource, uint32_t destinationY,
+	uint64_t sourceOffset, const D3D12_SUBRESOURCE_FOOTPRINT& footprint)
 {
 	HRESULT result = S_FALSE;
-	result = device_->CreateFence(fenceVal_, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence_));
+	if (!isRecording_) {
+		// GPU が終えたコマンドアロケータがあれば使い回す
+		if (cmdAllocator_ == nullptr) {
+			if (!pendingAllocators_.empty() && pendingAllocators_.front().fenceValue <= fenceQueue_.GetCompletedValue()) {
+				cmdAllocator_ = std::move(pendingAllocators_.front().cmdAllocator);
+				pendingAllocators_.pop_front();
+			}
+			else {
+				result = device_->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&cmdAllocator_));
+				assert(SUCCEEDED(result));
+			}
+		}
+		result = cmdAllocator_->Reset();
+		assert(SUCCEEDED(result));
+		result = cmdList_->Reset(cmdAllocator_.Get(), nullptr);
+		assert(SUCCEEDED(result));
+		isRecording_ = true;
+	}
+
+	// コピー先は COMMON から暗黙に COPY_DEST になり、送り終えると COMMON に戻る
+	CD3DX12_TEXTURE_COPY_LOCATION dest(destination, subresource);
+	D3D12_PLACED_SUBRESOURCE_FOOTPRINT layout = {};
+	layout.Offset = sourceOffset;
+	layout.Footprint = footprint;
+	CD3DX12_TEXTURE_COPY_LOCATION source(staging_, layout);
+	cmdList_->CopyTextureRegion(&dest, 0, destinationY, 0, &source, nullptr);
+}
+
+void DirectXCommon::TextureCopyQueue::Execute()
+{
+	assert(isRecording_);
+	HRESULT result = cmdList_->Close();
 	assert(SUCCEEDED(result));
+	ID3D12CommandList* cmdLists[] = { cmdList_.Get() };
+	cmdQueue_->ExecuteCommandLists(1, cmdLists);
+	isRecording_ = false;
+}
+
+uint64_t DirectXCommon::TextureCopyQueue::Signal()
+{
+	uint64_t fenceValue = fenceQueue_.Signal();
+	// 送ったコマンドアロケータはこのフェンス値を GPU が通過するまで使わない
+	if (cmdAllocator_ != nullptr && !isRecording_) {
+		pendingAllocators_.push_back(PendingAllocator{ std::move(cmdAllocator_), fenceValue });
+		cmdAllocator_ = nullptr;
+	}
+	return fenceValue;
+}
+
+uint64_t DirectXCommon::TextureCopyQueue::GetCompletedValue()
+{
+	return fenceQueue_.GetCompletedValue();
+}
+
+uint64_t DirectXCommon::TextureCopyQueue::Wait(uint64_t fenceValue)
+{
+	return fenceQueue_.Wait(fenceValue);
+}
+
+void DirectXCommon::TextureCopyQueue::InsertWait(ID3D12CommandQueue* queue, uint64_t fenceValue)
+{
+	fenceQueue_.InsertWait(queue, fenceValue);
 }
 
 #ifdef _DEBUG
@@ -340,21 +532,21 @@ void DirectXCommon::DebugSuppressError()
 	if (SUCCEEDED(device_->QueryInterface(IID_PPV_ARGS(&_infoQueue)))) {
 		D3D12_MESSAGE_ID denyIds[] = {
 			/*
-			 * Windows11łDXGIfobOC[DX12fobOC[̑ݍpoOɂG[bZ[W
+			 * Windows11でのDXGIデバッグレイヤーとDX12デバッグレイヤーの相互作用バグによるエラーメッセージ
 			 * https://stackoverflow.com/questions/69805245/directx-12-application-is-crashing-in-windows-11
 			 */
 			 D3D12_MESSAGE_ID_RESOURCE_BARRIER_MISMATCHING_COMMAND_LIST_TYPE
 		};
-		// }\x
+		// 抑制する表示レベル
 		D3D12_MESSAGE_SEVERITY severities[] = { D3D12_MESSAGE_SEVERITY_INFO };
 		D3D12_INFO_QUEUE_FILTER filter = {};
 		filter.DenyList.NumIDs = _countof(denyIds);
 		filter.DenyList.pIDList = denyIds;
 		filter.DenyList.NumSeverities = _countof(severities);
 		filter.DenyList.pSeverityList = severities;
-		// w肵G[̕\}
+		// 指定したエラーの表示を抑制する
 		_infoQueue->PushStorageFilter(&filter);
-		// G[Ƀu[N𔭐
+		// エラー時にブレークを発生させる
 		_infoQueue->SetBreakOnSeverity(D3D12_MESSAGE_SEVERITY_CORRUPTION, TRUE);
 		_infoQueue->SetBreakOnSeverity(D3D12_MESSAGE_SEVERITY_ERROR, TRUE);
 	}
@@ -363,7 +555,7 @@ void DirectXCommon::DebugSuppressError()
 void ShalderFileLoadCheak(const HRESULT& result, ID3DBlob* errorBlob)
 {
 	if (FAILED(result)) {
-		// errorBlobG[estring^ɃRs[
+		// errorBlobからエラー内容をstring型にコピー
 		std::string error;
 		error.resize(errorBlob->GetBufferSize());
 
@@ -371,7 +563,7 @@ void ShalderFileLoadCheak(const HRESULT& result, ID3DBlob* errorBlob)
 			errorBlob->GetBufferSize(),
 			error.begin());
 		error += "\n";
-		// G[eo̓EBhEɕ\
+		// エラー内容を出力ウィンドウに表示
 		OutputDebugStringA(error.c_str());
 		assert(0);
 	}
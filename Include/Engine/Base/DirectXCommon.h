@@ -3,12 +3,24 @@
 #define DIRECTXCOMMON_H_
 
 #include <d3d12.h>
+#include <deque>
 #include <dxgi1_6.h>
+#include <functional>
+#include <span>
 #include <vector>
 #include <wrl.h>
 
 #include "WinApp.h"
+#include "DescriptorAllocator.h"
+#include "FramePacer.h"
+#include "GpuMemoryAllocator.h"
 #include "MathUtility.h"
+#include "PipelineCache.h"
+#include "RenderGraph.h"
+#include "RenderGraphExecutor.h"
+#include "TextureUploader.h"
+#include "TrackedCommandList.h"
+#include "UploadRingBuffer.h"
 
 class DirectXCommon final
 {
@@ -16,43 +28,212 @@ private:
 	template<class TYPE>
 	using ComPtr = Microsoft::WRL::ComPtr<TYPE>;
 
-public: // ÓIo֐
+public: // 定数
+	// GPU に先行して積むフレーム数の既定値
+	static constexpr uint32_t kDefaultFrameCount = 2;
+
+private: // 定数
+	// アップロード領域のバイト数(GPU が終えていない全フレームで共有)
+	static constexpr size_t kUploadRingSize = 8 * 1024 * 1024;
+	// テクスチャのステージング領域のバイト数(これより大きなテクスチャは行ごとに分けて送る)
+	static constexpr size_t kTextureStagingSize = 32 * 1024 * 1024;
+	// シェーダーから見えるヒープの永続的な割り当ての数(テクスチャなど)
+	static constexpr uint32_t kPersistentDescriptorCount = 4096;
+	// シェーダーから見えるヒープのフレームごとのテーブルの数(GPU が終えていない全フレームで共有)
+	static constexpr uint32_t kDynamicDescriptorCount = 4096;
+	// シェーダーから見えないヒープのページあたりの数
+	static constexpr uint32_t kStagingDescriptorPageSize = 256;
+	static constexpr uint32_t kRtvDescriptorPageSize = 64;
+	// パイプラインのキャッシュファイル(GPU とドライバに依存するので配布しない)
+	static constexpr const char* kPipelineCacheFilePath = "../Resources/Cache/PipelineCache.bin";
+
+private: // サブクラス
+	/// <summary>
+	/// コマンドキューとフェンス
+	/// </summary>
+	class FenceQueue final : public GpuQueue
+	{
+	public:
+		~FenceQueue();
+
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="device">デバイス</param>
+		/// <param name="cmdQueue">コマンドキュー</param>
+		void Initalize(ID3D12Device* device, ID3D12CommandQueue* cmdQueue);
+
+		uint64_t Signal() override;
+		uint64_t GetCompletedValue() override;
+		uint64_t Wait(uint64_t fenceValue) override;
+		/// <summary>
+		/// 別のキューの GPU をこのフェンス値まで待たせる(CPU は止めない)
+		/// </summary>
+		/// <param name="queue">待たせるキュー</param>
+		/// <param name="fenceValue">フェンス値</param>
+		void InsertWait(ID3D12CommandQueue* queue, uint64_t fenceValue);
+
+	private:
+		ID3D12CommandQueue* cmdQueue_ = nullptr;
+		ComPtr<ID3D12Fence> fence_;
+		UINT64 fenceVal_ = 0;
+		// 待機用のイベント(使い回す)
+		HANDLE event_ = nullptr;
+	};
+
 	/// <summary>
-	/// VOgCX^X擾
+	/// テクスチャを読み込むコピーキュー
+	/// 描画とは別のキューで送り、コマンドアロケータは GPU が終えたものから使い回す
 	/// </summary>
-	/// <returns>CX^X̃|C^</returns>
+	class TextureCopyQueue final : public CopyCommandQueue
+	{
+	public:
+		/// <summary>
+		/// 初期化
+		/// </summary>
+		/// <param name="device">デバイス</param>
+		/// <param name="staging">ステージング領域のバッファ</param>
+		void Initalize(ID3D12Device* device, ID3D12Resource* staging);
+
+		void CopyTextureRegion(ID3D12Resource* destination, uint32_t subresource, uint32_t destinationY,
+			uint64_t sourceOffset, const D3D12_SUBRESOURCE_FOOTPRINT& footprint) override;
+		void Execute() override;
+		uint64_t Signal() override;
+		uint64_t GetCompletedValue() override;
+		uint64_t Wait(uint64_t fenceValue) override;
+		/// <summary>
+		/// 別のキューの GPU をコピーの完了まで待たせる(CPU は止めない)
+		/// </summary>
+		/// <param name="queue">待たせるキュー</param>
+		/// <param name="fenceValue">フェンス値</param>
+		void InsertWait(ID3D12CommandQueue* queue, uint64_t fenceValue);
+
+	private:
+		// GPU が使っているコマンドアロケータ
+		struct PendingAllocator {
+			ComPtr<ID3D12CommandAllocator> cmdAllocator;
+			uint64_t fenceValue;
+		};
+
+	private:
+		ID3D12Device* device_ = nullptr;
+		ID3D12Resource* staging_ = nullptr;
+		ComPtr<ID3D12CommandQueue> cmdQueue_;
+		ComPtr<ID3D12GraphicsCommandList> cmdList_;
+		// 記録中(送った後はシグナルするまで)のコマンドアロケータ
+		ComPtr<ID3D12CommandAllocator> cmdAllocator_;
+		std::deque<PendingAllocator> pendingAllocators_;
+		bool isRecording_ = false;
+		FenceQueue fenceQueue_;
+	};
+
+	/// <summary>
+	/// フレームコンテキスト
+	/// </summary>
+	struct FrameContext {
+		ComPtr<ID3D12CommandAllocator> cmdAllocator;
+	};
+
+public: // 静的メンバ関数
+	/// <summary>
+	/// シングルトンインスタンスを取得
+	/// </summary>
+	/// <returns>インスタンスのポインタ</returns>
 	static DirectXCommon* GetInstance();
 
-public: // o֐
+public: // メンバ関数
 	/// <summary>
-	/// foCX擾
+	/// デバイスを取得
 	/// </summary>
 	/// <returns></returns>
 	inline ID3D12Device* GetDevice() { return device_.Get(); }
 	/// <summary>
-	/// R}hXg擾
+	/// コマンドリストを取得
 	/// </summary>
 	/// <returns></returns>
-	inline ID3D12GraphicsCommandList* GetCommandList() { return cmdList_.Get(); }
+	/// <remarks>同じ状態のセットを省く。直接状態を変える場合は Get() で取り出し、後で Invalidate を呼ぶ</remarks>
+	inline TrackedCommandList* GetCommandList() { return &trackedCmdList_; }
 	/// <summary>
-	/// Xbv`F[擾
+	/// スワップチェーンを取得
 	/// </summary>
 	/// <returns></returns>
 	inline IDXGISwapChain4* GetSwapChain() { return swapChain_.Get(); }
 	/// <summary>
-	/// obNobt@擾
+	/// バックバッファを取得
 	/// </summary>
-	/// <param name="i">ԍ</param>
+	/// <param name="i">番号</param>
 	/// <returns></returns>
 	inline ID3D12Resource* GetBackBaffer(size_t i) { return backBuffers_[i].Get(); }
+	/// <summary>
+	/// フレームごとのアップロード領域を取得
+	/// 定数バッファや動的な頂点はここから毎フレーム切り出す
+	/// </summary>
+	/// <returns></returns>
+	inline UploadRingBuffer* GetUploadRing() { return &uploadRing_; }
+	/// <summary>
+	/// シェーダーから見えるディスクリプタの割り当てを取得
+	/// </summary>
+	/// <returns></returns>
+	inline ShaderVisibleDescriptorAllocator* GetSrvAllocator() { return &srvAllocator_; }
+	/// <summary>
+	/// シェーダーから見えない CBV/SRV/UAV の割り当てを取得(CreateDescriptorTable の元にする)
+	/// </summary>
+	/// <returns></returns>
+	inline StagingDescriptorAllocator* GetStagingAllocator() { return &stagingAllocator_; }
+	/// <summary>
+	/// レンダーターゲットビューの割り当てを取得
+	/// </summary>
+	/// <returns></returns>
+	inline StagingDescriptorAllocator* GetRtvAllocator() { return &rtvAllocator_; }
+	/// <summary>
+	/// 深度ステンシルビューの割り当てを取得
+	/// </summary>
+	/// <returns></returns>
+	inline StagingDescriptorAllocator* GetDsvAllocator() { return &dsvAllocator_; }
+	/// <summary>
+	/// バッファとテクスチャを配置するヒープの割り当てを取得
+	/// </summary>
+	/// <returns></returns>
+	inline GpuMemoryAllocator* GetGpuMemoryAllocator() { return &gpuMemoryAllocator_; }
+	/// <summary>
+	/// テクスチャの読み込みを取得
+	/// 積んだコピーは PostDraw でまとめて送り、そのフレームの描画はコピーを終えてから始まる
+	/// </summary>
+	/// <returns></returns>
+	inline TextureUploader* GetTextureUploader() { return &textureUploader_; }
+	/// <summary>
+	/// パイプラインとルートシグネチャのキャッシュを取得
+	/// </summary>
+	/// <returns></returns>
+	inline PipelineCache* GetPipelineCache() { return &pipelineCache_; }
+	/// <summary>
+	/// フレームの同期を取得
+	/// </summary>
+	/// <returns></returns>
+	inline const FramePacer& GetFramePacer() const { return framePacer_; }
+	/// <summary>
+	/// フレームのレンダーグラフを取得(PreDraw から PostDraw の間にパスを追加する)
+	/// </summary>
+	/// <returns></returns>
+	inline RenderGraph* GetRenderGraph() { return &renderGraph_; }
+	/// <summary>
+	/// 現在のバックバッファのハンドルを取得
+	/// </summary>
+	/// <returns></returns>
+	inline RenderGraph::ResourceHandle GetBackBufferHandle() const { return backBufferHandle_; }
+	/// <summary>
+	/// 深度バッファのハンドルを取得
+	/// </summary>
+	/// <returns></returns>
+	inline RenderGraph::ResourceHandle GetDepthBufferHandle() const { return depthBufferHandle_; }
 
 	/// <summary>
-	/// NAJ[Zbg
+	/// クリアカラーをセット
 	/// </summary>
 	/// <param name="color"></param>
 	inline void SetClearColor(const Vector4& color) { clearColor_ = color; }
 	/// <summary>
-	/// r[|[gZbg
+	/// ビューポートをセット
 	/// </summary>
 	/// <param name="left"></param>
 	/// <param name="top"></param>
@@ -60,7 +241,7 @@ public: // 
 	/// <param name="height"></param>
 	void SetViewport(float left, float top, float width, float height);
 	/// <summary>
-	/// VU[`Zbg
+	/// シザー矩形をセット
 	/// </summary>
 	/// <param name="left"></param>
 	/// <param name="top"></param>
@@ -69,34 +250,54 @@ public: // 
 	void SetScissorRect(int left, int top, int right, int bottom);
 
 	/// <summary>
-	/// 
+	/// 初期化
 	/// </summary>
-	void Initalize();
+	/// <param name="frameCount">GPU に先行して積むフレーム数</param>
+	void Initalize(uint32_t frameCount = kDefaultFrameCount);
 	/// <summary>
-	/// `O
+	/// 描画前処理(レンダーグラフにバックバッファと深度バッファを用意する)
 	/// </summary>
 	void PreDraw();
 	/// <summary>
-	/// `㏈
+	/// バックバッファに描くパスを追加
+	/// ターゲットのセット、クリア、ビューポートとシザー矩形のセットの後に draw を呼ぶ
+	/// </summary>
+	/// <param name="draw">描画</param>
+	void AddScenePass(std::function<void()> draw);
+	/// <summary>
+	/// 描画後処理(レンダーグラフを記録して実行)
 	/// </summary>
 	void PostDraw();
 	/// <summary>
-	/// _[^[QbgNA
+	/// レンダーターゲットをクリア(パスの中で呼ぶ)
 	/// </summary>
 	void ClearRenderTarget();
 	/// <summary>
-	/// [xobt@NA
+	/// 深度バッファをクリア(パスの中で呼ぶ)
 	/// </summary>
 	void ClearDepthBuffer();
+	/// <summary>
+	/// 送ったコマンドを GPU が全て終えるまで待つ(積んだテクスチャのコピーも送って待つ)
+	/// 使用中のリソースを書き換える前や終了時に呼ぶ
+	/// </summary>
+	void WaitIdle();
 
 	/// <summary>
-	/// \[Xobt@̐
+	/// シェーダーから見えないディスクリプタを並べ、現在のフレームだけ使うテーブルを作る
+	/// </summary>
+	/// <param name="sources">テーブルに並べるディスクリプタ</param>
+	/// <returns>SetGraphicsRootDescriptorTable に渡すハンドル</returns>
+	D3D12_GPU_DESCRIPTOR_HANDLE CreateDescriptorTable(std::span<const D3D12_CPU_DESCRIPTOR_HANDLE> sources);
+
+	/// <summary>
+	/// リソースバッファの生成(アップロードヒープに配置する)
+	/// 使い終えたら GetGpuMemoryAllocator()->Free に渡す
 	/// </summary>
 	/// <param name="size"></param>
 	/// <returns></returns>
-	ComPtr<ID3D12Resource> CreateResourceBuffer(UINT64 size);
+	GpuAllocation CreateResourceBuffer(UINT64 size);
 
-private: // o֐
+private: // メンバ関数
 	DirectXCommon() = default;
 	~DirectXCommon() = default;
 	DirectXCommon(const DirectXCommon&) = delete;
@@ -104,32 +305,55 @@ private: // 
 
 	void CreateFactory();
 	void CreateDevice();
-	void CreateCommand();
-	void CreateSwapChain();
+	void CreateDescriptorAllocators();
+	void CreateCommand(uint32_t frameCount);
+	void CreateSwapChain(uint32_t frameCount);
 	void CreateRenderTargetView();
-	void CreateDepthBuffer();
-	void CreateFence();
+	void CreateFence(uint32_t frameCount);
+	void CreateUploadRing();
+	void CreateTextureUploader();
+	/// <summary>
+	/// ディスクリプタヒープを生成(DescriptorAllocator のページ)
+	/// </summary>
+	DescriptorHeapPage CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t count, bool isShaderVisible);
 
 #ifdef _DEBUG
 	void DebugLayer();
 	void DebugSuppressError();
 #endif // _DEBUG
 
-private: // oϐ
+private: // メンバ変数
 	WinApp* winApp_ = nullptr;
 
 	ComPtr<ID3D12Device>				 device_;
 	ComPtr<IDXGIFactory6>				 dxgiFactory_;
-	ComPtr<ID3D12CommandAllocator>		 cmdAllocator_;
+	std::vector<FrameContext>			 frameContexts_;
 	ComPtr<ID3D12GraphicsCommandList>	 cmdList_;
+	TrackedCommandList					 trackedCmdList_;
 	ComPtr<ID3D12CommandQueue>			 cmdQueue_;
 	ComPtr<IDXGISwapChain4>				 swapChain_;
 	std::vector<ComPtr<ID3D12Resource>>	 backBuffers_;
-	ComPtr<ID3D12Resource>				 depthBuff_;
-	ComPtr<ID3D12Fence>					 fence_;
-	ComPtr<ID3D12DescriptorHeap>		 rtvHeap_;
-	ComPtr<ID3D12DescriptorHeap>		 dsvHeap_;
-	UINT64 fenceVal_ = 0;
+	DescriptorHandle					 backBufferRtvs_;
+	std::vector<ComPtr<ID3D12DescriptorHeap>> descriptorHeaps_;
+	ShaderVisibleDescriptorAllocator srvAllocator_;
+	StagingDescriptorAllocator stagingAllocator_;
+	StagingDescriptorAllocator rtvAllocator_;
+	StagingDescriptorAllocator dsvAllocator_;
+	PipelineCache pipelineCache_;
+	GpuMemoryAllocator gpuMemoryAllocator_;
+	GpuAllocation uploadBuffer_;
+	FenceQueue fenceQueue_;
+	FramePacer framePacer_;
+	UploadRingBuffer uploadRing_;
+	GpuAllocation textureStagingBuffer_;
+	TextureCopyQueue textureCopyQueue_;
+	TextureUploader textureUploader_;
+	// 描画のキューに待たせたコピーキューのフェンス値
+	uint64_t textureCopyWaitValue_ = 0;
+	RenderGraph renderGraph_;
+	RenderGraphExecutor renderGraphExecutor_;
+	RenderGraph::ResourceHandle backBufferHandle_ = RenderGraph::kInvalidResource;
+	RenderGraph::ResourceHandle depthBufferHandle_ = RenderGraph::kInvalidResource;
 	Vector4 clearColor_ = Vector4(0.1f, 0.25f, 0.5f, 0.0f);
 
 };
@@ -0,0 +1,52 @@
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <cassert>
+
+void FramePacer::Initalize(GpuQueue* queue, uint32_t frameCount) {
+	assert(queue != nullptr);
+	assert(frameCount > 0 && frameCount <= kMaxFrameCount);
+	queue_ = queue;
+	frameCount_ = frameCount;
+	frameIndex_ = 0;
+	frameFenceValues_.assign(frameCount, 0);
+	completedValue_ = queue_->GetCompletedValue();
+	lastSignaledValue_ = completedValue_;
+	statistics_ = {};
+}
+
+uint32_t FramePacer::BeginFrame() {
+	assert(queue_ != nullptr);
+	uint64_t fenceValue = frameFenceValues_[frameIndex_];
+	completedValue_ = queue_->GetCompletedValue();
+	if (completedValue_ < fenceValue) {
+		// GPU に一周追いついた
+		statistics_.stallCount++;
+		completedValue_ = queue_->Wait(fenceValue);
+	}
+	return frameIndex_;
+}
+
+uint64_t FramePacer::EndFrame() {
+	assert(queue_ != nullptr);
+	lastSignaledValue_ = queue_->Signal();
+	frameFenceValues_[frameIndex_] = lastSignaledValue_;
+	frameIndex_ = (frameIndex_ + 1) % frameCount_;
+	statistics_.frameCount++;
+	return lastSignaledValue_;
+}
+
+uint64_t FramePacer::Wait(uint64_t fenceValue) {
+	assert(queue_ != nullptr);
+	if (completedValue_ < fenceValue) {
+		completedValue_ = std::max(completedValue_, queue_->GetCompletedValue());
+	}
+	if (completedValue_ < fenceValue) {
+		completedValue_ = queue_->Wait(fenceValue);
+	}
+	return completedValue_;
+}
+
+uint64_t FramePacer::WaitIdle() {
+	return Wait(lastSignaledValue_);
+}
@@ -0,0 +1,129 @@
+#pragma once
+#ifndef FRAMEPACER_H_
+#define FRAMEPACER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// GPU のキューとフェンス
+/// FramePacer はこれを通してのみ GPU と同期する(テストでは遅延を持たせたシミュレーションに差し替える)
+/// </summary>
+class GpuQueue
+{
+public:
+	virtual ~GpuQueue() = default;
+
+	/// <summary>
+	/// これまで送ったコマンドの後にフェンスをシグナル
+	/// </summary>
+	/// <returns>シグナルしたフェンス値(前回より大きい)</returns>
+	virtual uint64_t Signal() = 0;
+	/// <summary>
+	/// GPU が通過したフェンス値を取得
+	/// </summary>
+	/// <returns></returns>
+	virtual uint64_t GetCompletedValue() = 0;
+	/// <summary>
+	/// GPU がフェンス値を通過するまで CPU を止める
+	/// </summary>
+	/// <param name="fenceValue">フェンス値</param>
+	/// <returns>GPU が通過したフェンス値</returns>
+	virtual uint64_t Wait(uint64_t fenceValue) = 0;
+};
+
+/// <summary>
+/// 複数のフレームを GPU に先行して積む
+/// フレームごとにシグナルしたフェンス値を覚え、同じフレームコンテキストを使い回す前にだけ待つ
+/// </summary>
+class FramePacer
+{
+public:
+	/// <summary>
+	/// 統計
+	/// </summary>
+	struct Statistics {
+		// 終えたフレーム数
+		size_t frameCount = 0;
+		// GPU に一周追いついて待った回数
+		size_t stallCount = 0;
+	};
+
+	// フレームコンテキストの最大数
+	static constexpr uint32_t kMaxFrameCount = 4;
+
+public:
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="queue">キュー</param>
+	/// <param name="frameCount">フレームコンテキストの数(1 なら毎フレーム GPU を待つ)</param>
+	void Initalize(GpuQueue* queue, uint32_t frameCount);
+	/// <summary>
+	/// フレームを始める
+	/// このフレームコンテキストを前回使ったフレームを GPU が終えていなければ待つ
+	/// </summary>
+	/// <returns>フレームコンテキストの番号</returns>
+	uint32_t BeginFrame();
+	/// <summary>
+	/// フレームを終える(コマンドを送った後に呼ぶ)
+	/// </summary>
+	/// <returns>このフレームの完了を示すフェンス値</returns>
+	uint64_t EndFrame();
+	/// <summary>
+	/// フェンス値まで待つ
+	/// </summary>
+	/// <param name="fenceValue">フェンス値</param>
+	/// <returns>GPU が通過したフェンス値</returns>
+	uint64_t Wait(uint64_t fenceValue);
+	/// <summary>
+	/// 送ったフレームを全て終えるまで待つ
+	/// </summary>
+	/// <returns>GPU が通過したフェンス値</returns>
+	uint64_t WaitIdle();
+
+	/// <summary>
+	/// 現在のフレームコンテキストの番号を取得
+	/// </summary>
+	/// <returns></returns>
+	inline uint32_t GetFrameIndex() const { return frameIndex_; }
+	/// <summary>
+	/// フレームコンテキストの数を取得
+	/// </summary>
+	/// <returns></returns>
+	inline uint32_t GetFrameCount() const { return frameCount_; }
+	/// <summary>
+	/// 最後に確認した GPU の通過済みフェンス値を取得
+	/// </summary>
+	/// <returns></returns>
+	inline uint64_t GetCompletedValue() const { return completedValue_; }
+	/// <summary>
+	/// 最後にシグナルしたフェンス値を取得
+	/// </summary>
+	/// <returns></returns>
+	inline uint64_t GetLastSignaledValue() const { return lastSignaledValue_; }
+	/// <summary>
+	/// GPU が終えていないフレーム数を取得
+	/// </summary>
+	/// <returns></returns>
+	inline uint64_t GetFramesInFlight() const { return lastSignaledValue_ - completedValue_; }
+	/// <summary>
+	/// 統計を取得
+	/// </summary>
+	/// <returns></returns>
+	inline const Statistics& GetStatistics() const { return statistics_; }
+
+private:
+	GpuQueue* queue_ = nullptr;
+	uint32_t frameCount_ = 0;
+	uint32_t frameIndex_ = 0;
+	// フレームコンテキストを最後に使ったフレームのフェンス値
+	std::vector<uint64_t> frameFenceValues_;
+	uint64_t completedValue_ = 0;
+	uint64_t lastSignaledValue_ = 0;
+	Statistics statistics_;
+
+};
+
+#endif
@@ -0,0 +1,107 @@
+#include "FrustumCulling.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "ThreadPool.h"
+#include "WorldTransform.h"
+
+namespace {
+	ConstVector3SoA Slice(const ConstVector3SoA& soa, size_t offset, size_t count) {
+		return ConstVector3SoA(soa.x.subspan(offset, count), soa.y.subspan(offset, count), soa.z.subspan(offset, count));
+	}
+	SphereSoA Slice(const SphereSoA& soa, size_t offset, size_t count) {
+		return SphereSoA{ Slice(soa.center, offset, count), soa.radius.subspan(offset, count) };
+	}
+	AABBSoA Slice(const AABBSoA& soa, size_t offset, size_t count) {
+		return AABBSoA{ Slice(soa.center, offset, count), Slice(soa.extents, offset, count) };
+	}
+
+	// 要素数によってスレッドで分割する
+	void Dispatch(size_t count, size_t jobCount, const ThreadPool::RangeFunction& func) {
+		if (count < FrustumCulling::kParallelThreshold) {
+			func(0, jobCount);
+			return;
+		}
+		ThreadPool::GetInstance()->ParallelFor(jobCount, 1, func);
+	}
+}
+
+std::span<const uint32_t> FrustumCulling::Cull(const Frustum& frustum, const SphereSoA& spheres) {
+	assert(spheres.center.size() == spheres.radius.size());
+	return CullImpl(frustum, spheres);
+}
+
+std::span<const uint32_t> FrustumCulling::Cull(const Frustum& frustum, const AABBSoA& aabbs) {
+	assert(aabbs.center.size() == aabbs.extents.size());
+	return CullImpl(frustum, aabbs);
+}
+
+std::span<const uint32_t> FrustumCulling::Cull(const Frustum& frustum, std::span<const WorldTransform* const> transforms, const Sphere& localBounds) {
+	size_t count = transforms.size();
+	sphereX_.resize(count);
+	sphereY_.resize(count);
+	sphereZ_.resize(count);
+	sphereRadius_.resize(count);
+
+	// ワールド空間の球に変換して SoA に並べる
+	size_t chunkCount = (count + kChunkSize - 1) / kChunkSize;
+	Dispatch(count, chunkCount, [&](size_t begin, size_t end) {
+		size_t last = std::min(end * kChunkSize, count);
+		for (size_t i = begin * kChunkSize; i < last; i++) {
+			assert(transforms[i]);
+			Sphere sphere = localBounds.Transformed(transforms[i]->worldMatrix);
+			sphereX_[i] = sphere.center.x;
+			sphereY_[i] = sphere.center.y;
+			sphereZ_[i] = sphere.center.z;
+			sphereRadius_[i] = sphere.radius;
+		}
+		});
+
+	SphereSoA spheres{ ConstVector3SoA(sphereX_, sphereY_, sphereZ_), sphereRadius_ };
+	return CullImpl(frustum, spheres);
+}
+
+template<class SOA_TYPE>
+std::span<const uint32_t> FrustumCulling::CullImpl(const Frustum& frustum, const SOA_TYPE& soa) {
+	size_t count = soa.size();
+	assert(count <= UINT32_MAX);
+	visibleIndices_.resize(count);
+	results_.resize(count);
+	size_t chunkCount = (count + kChunkSize - 1) / kChunkSize;
+	chunkVisibleCounts_.resize(chunkCount);
+
+	// 塊ごとに判定し、塊の先頭から見えているインデックスを詰める
+	Dispatch(count, chunkCount, [&](size_t begin, size_t end) {
+		for (size_t chunk = begin; chunk < end; chunk++) {
+			size_t offset = chunk * kChunkSize;
+			size_t chunkSize = std::min(kChunkSize, count - offset);
+			std::span<uint8_t> results(results_.data() + offset, chunkSize);
+			Math::IntersectsBatch(frustum, Slice(soa, offset, chunkSize), results);
+
+			uint32_t* indices = visibleIndices_.data() + offset;
+			size_t visibleCount = 0;
+			for (size_t i = 0; i < chunkSize; i++) {
+				indices[visibleCount] = static_cast<uint32_t>(offset + i);
+				visibleCount += results[i];
+			}
+			chunkVisibleCounts_[chunk] = visibleCount;
+		}
+		});
+
+	// 塊同士の隙間を詰める
+	// 移動先は移動元より前なので前から写せばよいが、同じ位置(ここまで全て見えている)は std::copy に渡せないので飛ばす
+	size_t visibleCount = 0;
+	for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+		size_t offset = chunk * kChunkSize;
+		if (offset != visibleCount) {
+			auto first = visibleIndices_.begin() + offset;
+			std::copy(first, first + chunkVisibleCounts_[chunk], visibleIndices_.begin() + visibleCount);
+		}
+		visibleCount += chunkVisibleCounts_[chunk];
+	}
+
+	statistics_.testedCount += count;
+	statistics_.visibleCount += visibleCount;
+	return std::span<const uint32_t>(visibleIndices_.data(), visibleCount);
+}
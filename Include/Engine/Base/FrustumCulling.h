@@ -0,0 +1,92 @@
+#pragma once
+#ifndef FRUSTUMCULLING_H_
+#define FRUSTUMCULLING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Geometry.h"
+
+class WorldTransform;
+
+/// <summary>
+/// 視錐台カリング
+/// ワールド空間の境界ボリュームをまとめて判定し、見えているもののインデックスを詰めて返す
+/// 要素数が kParallelThreshold 以上の場合は ThreadPool で分割して処理する
+/// </summary>
+class FrustumCulling
+{
+public:
+	/// <summary>
+	/// 統計
+	/// </summary>
+	struct Statistics {
+		// 判定した数
+		size_t testedCount = 0;
+		// 見えていた数
+		size_t visibleCount = 0;
+	};
+
+	// 並列処理を行う要素数
+	static constexpr size_t kParallelThreshold = 8 * 1024;
+	// 1ジョブで処理する要素数
+	static constexpr size_t kChunkSize = 2 * 1024;
+
+public:
+	/// <summary>
+	/// 球を判定
+	/// </summary>
+	/// <param name="frustum">視錐台</param>
+	/// <param name="spheres">ワールド空間の球</param>
+	/// <returns>見えている球のインデックス(昇順、次の Cull まで有効)</returns>
+	std::span<const uint32_t> Cull(const Frustum& frustum, const SphereSoA& spheres);
+	/// <summary>
+	/// 軸平行境界ボックスを判定
+	/// </summary>
+	/// <param name="frustum">視錐台</param>
+	/// <param name="aabbs">ワールド空間のボックス</param>
+	/// <returns>見えているボックスのインデックス(昇順、次の Cull まで有効)</returns>
+	std::span<const uint32_t> Cull(const Frustum& frustum, const AABBSoA& aabbs);
+	/// <summary>
+	/// ワールド変換を判定
+	/// </summary>
+	/// <param name="frustum">視錐台</param>
+	/// <param name="transforms">ワールド変換(UpdateMatrix 済み)</param>
+	/// <param name="localBounds">ローカル空間の境界球(すべて共通)</param>
+	/// <returns>見えているワールド変換のインデックス(昇順、次の Cull まで有効)</returns>
+	std::span<const uint32_t> Cull(const Frustum& frustum, std::span<const WorldTransform* const> transforms, const Sphere& localBounds);
+
+	/// <summary>
+	/// 統計を取得(ResetStatistics からの累計)
+	/// </summary>
+	/// <returns></returns>
+	inline const Statistics& GetStatistics() const { return statistics_; }
+	/// <summary>
+	/// 統計をリセット(フレームの最初に呼ぶ)
+	/// </summary>
+	inline void ResetStatistics() { statistics_ = {}; }
+
+private:
+	template<class SOA_TYPE>
+	std::span<const uint32_t> CullImpl(const Frustum& frustum, const SOA_TYPE& soa);
+
+private:
+	// 見えているもののインデックス
+	std::vector<uint32_t> visibleIndices_;
+	// 判定結果
+	std::vector<uint8_t> results_;
+	// 塊ごとの見えている数
+	std::vector<size_t> chunkVisibleCounts_;
+	// ワールド変換から作った球(SoA)
+	std::vector<float> sphereX_;
+	std::vector<float> sphereY_;
+	std::vector<float> sphereZ_;
+	std::vector<float> sphereRadius_;
+	// 統計
+	Statistics statistics_;
+
+};
+
+#endif
@@ -0,0 +1,292 @@
+#include "GpuMemoryAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <d3dx12.h>
+
+namespace {
+	inline uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+void GpuMemoryAllocator::Initalize(ID3D12Device* device, uint64_t pageSize) {
+	assert(device != nullptr);
+	device_ = device;
+	pageSize_ = AlignUp(pageSize, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+	for (uint32_t i = 0; i < pools_.size(); i++) {
+		pools_[i].memoryType = static_cast<MemoryType>(i / kResourceCategoryCount);
+		pools_[i].category = static_cast<ResourceCategory>(i % kResourceCategoryCount);
+		pools_[i].pages.clear();
+	}
+	frameFrees_.clear();
+	pendingFrees_.clear();
+}
+
+GpuAllocation GpuMemoryAllocator::CreateResource(MemoryType memoryType, const D3D12_RESOURCE_DESC& desc,
+	D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE* clearValue) {
+	assert(device_ != nullptr);
+	HRESULT result = S_FALSE;
+
+	ResourceCategory category = kResourceCategoryTexture;
+	if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER) {
+		category = kResourceCategoryBuffer;
+	}
+	else if (desc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)) {
+		category = kResourceCategoryRenderTarget;
+	}
+	// アップロードヒープにはテクスチャを置けない
+	assert(memoryType != kMemoryTypeUpload || category == kResourceCategoryBuffer);
+	uint32_t poolIndex = memoryType * kResourceCategoryCount + category;
+	Pool& pool = pools_[poolIndex];
+
+	// 小さなテクスチャは 4KB 境界に置ける(置けなければ既定の 64KB 境界)
+	D3D12_RESOURCE_DESC resourceDesc = desc;
+	D3D12_RESOURCE_ALLOCATION_INFO info = {};
+	resourceDesc.Alignment = 0;
+	if (category == kResourceCategoryTexture) {
+		resourceDesc.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+		info = device_->GetResourceAllocationInfo(0, 1, &resourceDesc);
+		if (info.Alignment != D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT) {
+			resourceDesc.Alignment = 0;
+		}
+	}
+	if (resourceDesc.Alignment == 0) {
+		info = device_->GetResourceAllocationInfo(0, 1, &resourceDesc);
+	}
+	assert(info.SizeInBytes != UINT64_MAX);
+
+	GpuAllocation allocation;
+	allocation.pool = poolIndex;
+	if (info.SizeInBytes > pageSize_ / 2) {
+		// 大きなリソースは専用のページに置く(共有のページに置くと空きが細切れになる)
+		allocation.page = CreatePage(pool, info.SizeInBytes, true);
+		allocation.block = pool.pages[allocation.page].allocator.Allocate(info.SizeInBytes, info.Alignment);
+	}
+	else {
+		for (uint32_t i = 0; i < pool.pages.size(); i++) {
+			Page& page = pool.pages[i];
+			if (!page.heap || page.isDedicated) {
+				continue;
+			}
+			allocation.block = page.allocator.Allocate(info.SizeInBytes, info.Alignment);
+			if (allocation.block.IsValid()) {
+				allocation.page = i;
+				break;
+			}
+		}
+		// 入らなければページを足す
+		if (!allocation.block.IsValid()) {
+			allocation.page = CreatePage(pool, pageSize_, false);
+			allocation.block = pool.pages[allocation.page].allocator.Allocate(info.SizeInBytes, info.Alignment);
+		}
+	}
+	assert(allocation.block.IsValid());
+
+	Page& page = pool.pages[allocation.page];
+	result = device_->CreatePlacedResource(
+		page.heap.Get(), allocation.block.offset, &resourceDesc,
+		initialState, clearValue, IID_PPV_ARGS(&allocation.resource));
+	assert(SUCCEEDED(result));
+	// Defragment で持ち主に渡す
+	page.allocator.SetUserData(allocation.block, allocation.resource.Get());
+	return allocation;
+}
+
+void GpuMemoryAllocator::Free(GpuAllocation& allocation) {
+	if (!allocation.IsValid()) {
+		return;
+	}
+	// リソースも GPU が読み終えるまで残す
+	frameFrees_.push_back(std::move(allocation));
+	allocation = {};
+}
+
+void GpuMemoryAllocator::FinishFrame(uint64_t fenceValue) {
+	for (auto& frameFree : frameFrees_) {
+		pendingFrees_.push_back(PendingFree{ fenceValue, std::move(frameFree) });
+	}
+	frameFrees_.clear();
+}
+
+void GpuMemoryAllocator::Release(uint64_t completedFenceValue) {
+	while (!pendingFrees_.empty() && pendingFrees_.front().fenceValue <= completedFenceValue) {
+		FreeBlock(pendingFrees_.front().allocation);
+		pendingFrees_.pop_front();
+	}
+}
+
+uint32_t GpuMemoryAllocator::Defragment(uint32_t maxMoveCount, const RelocateFunction& relocate) {
+	uint32_t moveCount = 0;
+	for (uint32_t poolIndex = 0; poolIndex < pools_.size(); poolIndex++) {
+		Pool& pool = pools_[poolIndex];
+		for (uint32_t pageIndex = 0; pageIndex < pool.pages.size() && moveCount < maxMoveCount; pageIndex++) {
+			Page& page = pool.pages[pageIndex];
+			if (!page.heap || page.isDedicated) {
+				continue;
+			}
+			moveCount += page.allocator.Defragment(maxMoveCount - moveCount,
+				[&](const TlsfAllocator::Allocation& fromBlock, const TlsfAllocator::Allocation& toBlock, void* userData) {
+					GpuAllocation from;
+					from.resource = static_cast<ID3D12Resource*>(userData);
+					from.pool = poolIndex;
+					from.page = pageIndex;
+					from.block = fromBlock;
+
+					// 中身は持ち主がコピーするので、コピー先になれる状態で作る
+					D3D12_RESOURCE_DESC resourceDesc = from->GetDesc();
+					D3D12_RESOURCE_STATES initialState = pool.memoryType == kMemoryTypeUpload ?
+						D3D12_RESOURCE_STATE_GENERIC_READ : D3D12_RESOURCE_STATE_COMMON;
+					GpuAllocation to;
+					to.pool = poolIndex;
+					to.page = pageIndex;
+					to.block = toBlock;
+					HRESULT result = device_->CreatePlacedResource(
+						page.heap.Get(), toBlock.offset, &resourceDesc,
+						initialState, nullptr, IID_PPV_ARGS(&to.resource));
+					if (FAILED(result) || !relocate(from, to)) {
+						return false;
+					}
+					page.allocator.SetUserData(toBlock, to.resource.Get());
+					Free(from);
+					return true;
+				});
+		}
+	}
+	return moveCount;
+}
+
+GpuMemoryAllocator::Statistics GpuMemoryAllocator::GetStatistics(MemoryType memoryType) const {
+	Statistics statistics;
+	uint64_t largestFreeSum = 0;
+	for (auto& pool : pools_) {
+		if (pool.memoryType == memoryType) {
+			AccumulateStatistics(pool, statistics, largestFreeSum);
+		}
+	}
+	auto addPending = [&](const GpuAllocation& allocation) {
+		if (pools_[allocation.pool].memoryType == memoryType) {
+			statistics.pendingFreeSize += allocation.block.size;
+		}
+	};
+	for (auto& allocation : frameFrees_) {
+		addPending(allocation);
+	}
+	for (auto& pendingFree : pendingFrees_) {
+		addPending(pendingFree.allocation);
+	}
+	uint64_t freeSize = statistics.heapSize - statistics.usedSize;
+	if (freeSize != 0) {
+		statistics.fragmentation = 1.0 - static_cast<double>(largestFreeSum) / static_cast<double>(freeSize);
+	}
+	return statistics;
+}
+
+GpuMemoryAllocator::Statistics GpuMemoryAllocator::GetStatistics() const {
+	Statistics statistics;
+	uint64_t largestFreeSum = 0;
+	for (auto& pool : pools_) {
+		AccumulateStatistics(pool, statistics, largestFreeSum);
+	}
+	for (auto& allocation : frameFrees_) {
+		statistics.pendingFreeSize += allocation.block.size;
+	}
+	for (auto& pendingFree : pendingFrees_) {
+		statistics.pendingFreeSize += pendingFree.allocation.block.size;
+	}
+	uint64_t freeSize = statistics.heapSize - statistics.usedSize;
+	if (freeSize != 0) {
+		statistics.fragmentation = 1.0 - static_cast<double>(largestFreeSum) / static_cast<double>(freeSize);
+	}
+	return statistics;
+}
+
+uint32_t GpuMemoryAllocator::CreatePage(Pool& pool, uint64_t size, bool isDedicated) {
+	// 返したページの番号を使い回す
+	uint32_t index = 0;
+	while (index < pool.pages.size() && pool.pages[index].heap) {
+		index++;
+	}
+	if (index == pool.pages.size()) {
+		pool.pages.emplace_back();
+	}
+	Page& page = pool.pages[index];
+
+	D3D12_HEAP_DESC heapDesc = {};
+	heapDesc.SizeInBytes = AlignUp(size, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+	switch (pool.memoryType) {
+	case kMemoryTypeDefault:
+		heapDesc.Properties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+		break;
+	case kMemoryTypeUpload:
+		heapDesc.Properties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+		break;
+	case kMemoryTypeCpuWritable:
+		heapDesc.Properties = CD3DX12_HEAP_PROPERTIES(D3D12_CPU_PAGE_PROPERTY_WRITE_BACK, D3D12_MEMORY_POOL_L0);
+		break;
+	default:
+		assert(false);
+		break;
+	}
+	switch (pool.category) {
+	case kResourceCategoryBuffer:
+		heapDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+		heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+		break;
+	case kResourceCategoryTexture:
+		heapDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+		heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+		break;
+	case kResourceCategoryRenderTarget:
+		// マルチサンプルのリソースは 4MB 境界に置く
+		heapDesc.Alignment = D3D12_DEFAULT_MSAA_RESOURCE_PLACEMENT_ALIGNMENT;
+		heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+		break;
+	default:
+		assert(false);
+		break;
+	}
+	HRESULT result = device_->CreateHeap(&heapDesc, IID_PPV_ARGS(&page.heap));
+	assert(SUCCEEDED(result));
+
+	page.allocator.Initalize(heapDesc.SizeInBytes);
+	page.isDedicated = isDedicated;
+	return index;
+}
+
+void GpuMemoryAllocator::FreeBlock(GpuAllocation& allocation) {
+	assert(allocation.pool < pools_.size());
+	Pool& pool = pools_[allocation.pool];
+	assert(allocation.page < pool.pages.size());
+	Page& page = pool.pages[allocation.page];
+	// ヒープより先にリソースを手放す
+	allocation.resource.Reset();
+	page.allocator.Free(allocation.block);
+
+	// 空になったページは返す(最初のページは作り直さないように残す)
+	if (page.allocator.GetAllocationCount() == 0 && (page.isDedicated || allocation.page != 0)) {
+		page.heap.Reset();
+		page.allocator.Initalize(0);
+		page.isDedicated = false;
+	}
+	allocation = {};
+}
+
+void GpuMemoryAllocator::AccumulateStatistics(const Pool& pool, Statistics& statistics, uint64_t& largestFreeSum) const {
+	for (auto& page : pool.pages) {
+		if (!page.heap) {
+			continue;
+		}
+		TlsfAllocator::Statistics pageStatistics = page.allocator.GetStatistics();
+		statistics.pageCount++;
+		if (page.isDedicated) {
+			statistics.dedicatedPageCount++;
+		}
+		statistics.heapSize += pageStatistics.capacity;
+		statistics.usedSize += pageStatistics.usedSize;
+		statistics.allocationCount += pageStatistics.allocationCount;
+		statistics.freeBlockCount += pageStatistics.freeBlockCount;
+		statistics.largestFreeSize = std::max(statistics.largestFreeSize, pageStatistics.largestFreeSize);
+		largestFreeSum += pageStatistics.largestFreeSize;
+	}
+}
@@ -0,0 +1,191 @@
+#pragma once
+#ifndef GPUMEMORYALLOCATOR_H_
+#define GPUMEMORYALLOCATOR_H_
+
+#include <array>
+#include <cstdint>
+#include <d3d12.h>
+#include <deque>
+#include <functional>
+#include <vector>
+#include <wrl.h>
+
+#include "TlsfAllocator.h"
+
+/// <summary>
+/// ヒープに配置したリソース
+/// </summary>
+struct GpuAllocation {
+	Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+	// プールとページ(ヒープ)の番号
+	uint32_t pool = 0;
+	uint32_t page = 0;
+	// ヒープ内の範囲
+	TlsfAllocator::Allocation block;
+
+	inline bool IsValid() const { return resource != nullptr; }
+	inline ID3D12Resource* Get() const { return resource.Get(); }
+	inline ID3D12Resource* operator->() const { return resource.Get(); }
+};
+
+/// <summary>
+/// 大きなヒープをヒープの種類ごとに作り、そこからリソースを配置する(CreatePlacedResource)
+/// リソースごとにヒープを作る CreateCommittedResource より OS の割り当てが少ない
+/// ヒープ内の範囲は TlsfAllocator で管理し、足りなくなったらページ(ヒープ)を足す
+/// 解放した範囲は FinishFrame で渡したフェンス値を GPU が通過するまで再利用しない
+/// スレッドセーフではない
+/// </summary>
+class GpuMemoryAllocator
+{
+public:
+	/// <summary>
+	/// メモリの種類
+	/// </summary>
+	enum MemoryType {
+		kMemoryTypeDefault,		// GPU だけが触る
+		kMemoryTypeUpload,		// CPU が書き GPU が読む(バッファのみ)
+		kMemoryTypeCpuWritable,	// CPU が WriteToSubresource で書くテクスチャ(ライトバック、L0)
+
+		kMemoryTypeCount
+	};
+
+	/// <summary>
+	/// 統計(プールごと、全体)
+	/// </summary>
+	struct Statistics {
+		uint32_t pageCount = 0;
+		// 一つのリソースのためのページの数
+		uint32_t dedicatedPageCount = 0;
+		// ヒープのバイト数
+		uint64_t heapSize = 0;
+		// 配置したリソースのバイト数(境界の切り上げを含む)
+		uint64_t usedSize = 0;
+		uint32_t allocationCount = 0;
+		// 空き範囲の数
+		uint32_t freeBlockCount = 0;
+		// 一度に配置できる最大(ページの中の最大)
+		uint64_t largestFreeSize = 0;
+		// 断片化の度合い(空きのうち最大の空きに入らない割合)
+		double fragmentation = 0.0;
+		// GPU の完了を待って解放するバイト数
+		uint64_t pendingFreeSize = 0;
+	};
+
+	// 配置し直したリソースを持ち主に渡す(to に中身をコピーする命令を積み、to を持ったら true)
+	// true を返すと from は GPU が読み終えてから解放する
+	using RelocateFunction = std::function<bool(const GpuAllocation& from, const GpuAllocation& to)>;
+
+	// ページ(ヒープ)の既定のバイト数
+	static constexpr uint64_t kDefaultPageSize = 64 * 1024 * 1024;
+
+public:
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="device">デバイス</param>
+	/// <param name="pageSize">ページのバイト数(これの半分より大きいリソースは専用のページに置く)</param>
+	void Initalize(ID3D12Device* device, uint64_t pageSize = kDefaultPageSize);
+	/// <summary>
+	/// リソースを配置する
+	/// </summary>
+	/// <param name="memoryType">メモリの種類</param>
+	/// <param name="desc">リソースの設定(Alignment は上書きする)</param>
+	/// <param name="initialState">初期状態</param>
+	/// <param name="clearValue">最適化されたクリア値(レンダーターゲットと深度のみ)</param>
+	/// <returns></returns>
+	GpuAllocation CreateResource(MemoryType memoryType, const D3D12_RESOURCE_DESC& desc,
+		D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE* clearValue = nullptr);
+	/// <summary>
+	/// 解放(現在のフレームを GPU が終えた後に範囲を再利用する)
+	/// </summary>
+	/// <param name="allocation">CreateResource の戻り値(解放後は無効になる)</param>
+	void Free(GpuAllocation& allocation);
+	/// <summary>
+	/// 現在のフレームを締める
+	/// </summary>
+	/// <param name="fenceValue">このフレームのコマンドの完了を示すフェンス値</param>
+	void FinishFrame(uint64_t fenceValue);
+	/// <summary>
+	/// 完了したフレームで解放したものを再利用できるようにする(空になったページは返す)
+	/// </summary>
+	/// <param name="completedFenceValue">GPU が通過したフェンス値</param>
+	void Release(uint64_t completedFenceValue);
+	/// <summary>
+	/// 後ろに置いたリソースを前の空きへ配置し直し、ページ内の空きをまとめる
+	/// </summary>
+	/// <param name="maxMoveCount">配置し直す最大の数</param>
+	/// <param name="relocate">持ち主に渡す関数(false を返したものは配置し直さない)</param>
+	/// <returns>配置し直した数</returns>
+	uint32_t Defragment(uint32_t maxMoveCount, const RelocateFunction& relocate);
+
+	/// <summary>
+	/// メモリの種類ごとの統計を取得
+	/// </summary>
+	/// <param name="memoryType">メモリの種類</param>
+	/// <returns></returns>
+	Statistics GetStatistics(MemoryType memoryType) const;
+	/// <summary>
+	/// 全体の統計を取得
+	/// </summary>
+	/// <returns></returns>
+	Statistics GetStatistics() const;
+
+private:
+	/// <summary>
+	/// リソースの分類(リソースヒープ階層 1 では同じヒープに置けない)
+	/// </summary>
+	enum ResourceCategory {
+		kResourceCategoryBuffer,
+		kResourceCategoryTexture,
+		kResourceCategoryRenderTarget,	// レンダーターゲットと深度
+
+		kResourceCategoryCount
+	};
+
+	struct Page {
+		Microsoft::WRL::ComPtr<ID3D12Heap> heap;
+		TlsfAllocator allocator;
+		// 一つのリソースのためのページ(空になったら返す)
+		bool isDedicated = false;
+	};
+
+	struct Pool {
+		MemoryType memoryType = kMemoryTypeDefault;
+		ResourceCategory category = kResourceCategoryBuffer;
+		// 返したページは heap が空(番号は使い回す)
+		std::vector<Page> pages;
+	};
+
+	// GPU の完了を待っている解放
+	struct PendingFree {
+		uint64_t fenceValue;
+		GpuAllocation allocation;
+	};
+
+	/// <summary>
+	/// ページを作る
+	/// </summary>
+	/// <returns>ページの番号</returns>
+	uint32_t CreatePage(Pool& pool, uint64_t size, bool isDedicated);
+	/// <summary>
+	/// 範囲を返す(空になったページはヒープも返す)
+	/// </summary>
+	void FreeBlock(GpuAllocation& allocation);
+	/// <summary>
+	/// プールの統計を足す
+	/// </summary>
+	/// <param name="largestFreeSum">ページごとの最大の空きの合計(断片化の度合いに使う)</param>
+	void AccumulateStatistics(const Pool& pool, Statistics& statistics, uint64_t& largestFreeSum) const;
+
+private:
+	ID3D12Device* device_ = nullptr;
+	uint64_t pageSize_ = kDefaultPageSize;
+	std::array<Pool, kMemoryTypeCount * kResourceCategoryCount> pools_;
+
+	// 現在のフレームで解放したもの(fenceValue は FinishFrame で決まる)
+	std::vector<GpuAllocation> frameFrees_;
+	std::deque<PendingFree> pendingFrees_;
+
+};
+
+#endif
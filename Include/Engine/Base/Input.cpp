@@ -18,30 +18,30 @@ void Input::Initialize()
 	winApp_ = WinApp::GetInstance();
 
 	HRESULT result = S_FALSE;
-	// DirectInput̏
+	// DirectInputの初期化
 	result = DirectInput8Create(
 		winApp_->GetWindowClassHInstance(), DIRECTINPUT_HEADER_VERSION,
 		IID_IDirectInput8, static_cast<void**>(&directInput_), nullptr);
 	assert(SUCCEEDED(result));
 
-	// L[{[hfoCX̐
+	// キーボードデバイスの生成
 	result = directInput_->CreateDevice(GUID_SysKeyboard, &keyboard_, NULL);
 	assert(SUCCEEDED(result));
-	// ̓f[^[`̃Zbg
+	// 入力データー形式のセット
 	result = keyboard_->SetDataFormat(&c_dfDIKeyboard);
 	assert(SUCCEEDED(result));
-	// r䃌x̃Zbg
+	// 排他制御レベルのセット
 	result = keyboard_->SetCooperativeLevel(
 		winApp_->GetHwnd(), DISCL_FOREGROUND | DISCL_NONEXCLUSIVE | DISCL_NOWINKEY);
 	assert(SUCCEEDED(result));
 
-	// }EXfoCX̐
+	// マウスデバイスの生成
 	result = directInput_->CreateDevice(GUID_SysMouse, &mouse_, NULL);
 	assert(SUCCEEDED(result));
-	// ̓f[^[`̃Zbg
+	// 入力データー形式のセット
 	result = mouse_->SetDataFormat(&c_dfDIMouse);
 	assert(SUCCEEDED(result));
-	// r䃌x̃Zbg
+	// 排他制御レベルのセット
 	result = mouse_->SetCooperativeLevel(
 		winApp_->GetHwnd(), DISCL_FOREGROUND | DISCL_NONEXCLUSIVE | DISCL_NOWINKEY);
 	assert(SUCCEEDED(result));
@@ -49,15 +49,15 @@ void Input::Initialize()
 
 void Input::Update() {
 	memcpy(preKeys_, curkeys_, kKeyDataNum);
-	// L[{[h̎擾Jn
+	// キーボード情報の取得開始
 	keyboard_->Acquire();
-	// SL[̓͏Ԃ擾
+	// 全キーの入力状態を取得する
 	keyboard_->GetDeviceState(sizeof(curkeys_), curkeys_);
 	
 	preMouseState_ = curMouseState_;
-	// }EX̎擾Jn
+	// マウス情報の取得開始
 	mouse_->Acquire();
-	// }EX̏Ԃ擾
+	// マウスの状態を取得する
 	mouse_->GetDeviceState(sizeof(DIMOUSESTATE),&curMouseState_);
 
 	POINT p;
@@ -66,7 +66,7 @@ void Input::Update() {
 	mousePos_ = Vector2(static_cast<float>(p.x), static_cast<float>(p.y));
 
 	
-	// ݂̏ԂȌԂɕۑ
+	// 現在の状態を前回の状態に保存
 	for (auto& it : gamePads_) {
 		it.preState = it.curState;
 	}
@@ -12,7 +12,7 @@
 #include "MathUtility.h"
 #include "WinApp.h"
 
-#define DIRECTINPUT_VERSION 0x0800 // DirectIput̃o[Ww
+#define DIRECTINPUT_VERSION 0x0800 // DirectIputのバージョン指定
 #define MOOUSE_ON_VALUE 0x80
 
 enum MouseButton 
@@ -22,14 +22,14 @@ enum MouseButton
 	kMouseButtonMid,
 };
 
-// Rg[[{^
+// コントローラーボタン
 enum PadButton {
-	kPadButtonUp = 0x0001,			// 
-	kPadButtonDown = 0x0002,			// 
-	kPadButtonLeft = 0x0004,			// 
-	kPadButtonRight = 0x0008,		// E
-	kPadButtonStart = 0x0010,		// j[
-	kPadButtonBack = 0x0020,			// r[
+	kPadButtonUp = 0x0001,			// 上
+	kPadButtonDown = 0x0002,			// 下
+	kPadButtonLeft = 0x0004,			// 左
+	kPadButtonRight = 0x0008,		// 右
+	kPadButtonStart = 0x0010,		// メニュー
+	kPadButtonBack = 0x0020,			// ビュー
 	kPadButtonLeftThumb = 0x0040,			// L3
 	kPadButtonRightThumb = 0x0080,			// R3
 	kPadButtonLeftShoulder = 0x0100,		// L1
@@ -38,11 +38,11 @@ enum PadButton {
 	kPadButtonB = 0x2000,			// B
 	kPadButtonX = 0x4000,			// X
 	kPadButtonY = 0x8000,			// Y
-	kPadLeftTrigger = 0x000F0000,	// L2 (KȐ蓖)
-	kPadRightTrigger = 0x00FF0000,	// R2 (KȐ蓖)
+	kPadLeftTrigger = 0x000F0000,	// L2 (適当な数字を割り当て)
+	kPadRightTrigger = 0x00FF0000,	// R2 (適当な数字を割り当て)
 };
 
-// XeBbŇ
+// スティックの向き
 enum StickDirection {
 	kStickDirectionUp,			// LEFT STICK DIRECTION UP
 	kStickDirectionDown,		// LEFT STICK DIRECTION DOWN
@@ -62,211 +62,211 @@ private:
 	{
 		XINPUT_STATE curState = {};
 		XINPUT_STATE preState = {};
-		BYTE triggerDeadZone = XINPUT_GAMEPAD_TRIGGER_THRESHOLD; // gK[̃fbh][
-		SHORT leftStickDeadZone = XINPUT_GAMEPAD_LEFT_THUMB_DEADZONE; // XeBbÑfbh][
-		SHORT rightStickDeadZone = XINPUT_GAMEPAD_RIGHT_THUMB_DEADZONE;	// EXeBbÑfbh][
+		BYTE triggerDeadZone = XINPUT_GAMEPAD_TRIGGER_THRESHOLD; // トリガーのデッドゾーン
+		SHORT leftStickDeadZone = XINPUT_GAMEPAD_LEFT_THUMB_DEADZONE; // 左スティックのデッドゾーン
+		SHORT rightStickDeadZone = XINPUT_GAMEPAD_RIGHT_THUMB_DEADZONE;	// 右スティックのデッドゾーン
 	};
 
 private:
 	static constexpr int kKeyDataNum = 256;
 	static constexpr int kXInputConnectMaxCount = 4;
 
-public: // ÓIo֐
+public: // 静的メンバ関数
 	static Input* GetInstance();
 
-public: // o֐
-#pragma region L[{[h֌W
+public: // メンバ関数
+#pragma region キーボード関係
 
 	/// <summary>
-	/// Ă
+	/// 押されている
 	/// </summary>
-	/// <param name="keycode">L[R[h</param>
+	/// <param name="keycode">キーコード</param>
 	/// <returns></returns>
 	inline bool IsKeyPressed(uint8_t keycode) const;
 	/// <summary>
-	/// ĂȂ
+	/// 押されていない
 	/// </summary>
-	/// <param name="keycode">L[R[h</param>
+	/// <param name="keycode">キーコード</param>
 	/// <returns></returns>
 	inline bool IsKeyEmpty(uint8_t keycode) const;
 	/// <summary>
-	/// u
+	/// 押した瞬間
 	/// </summary>
-	/// <param name="keycode">L[R[h</param>
+	/// <param name="keycode">キーコード</param>
 	/// <returns></returns>
 	inline bool IsKeyTrigger(uint8_t keycode) const;
 	/// <summary>
-	/// u
+	/// 離した瞬間
 	/// </summary>
-	/// <param name="keycode">L[R[h</param>
+	/// <param name="keycode">キーコード</param>
 	/// <returns></returns>
 	inline bool IsKeyRelease(uint8_t keycode) const;
 	
 #pragma endregion
 
-#pragma region }EX֌W
+#pragma region マウス関係
 	
 	/// <summary>
-	/// }EX{^Ă
+	/// マウスボタンが押されている
 	/// </summary>
-	/// <param name="buttontype">{^R[h</param>
+	/// <param name="buttontype">ボタンコード</param>
 	/// <returns></returns>
 	inline bool IsMousePressed(MouseButton buttontype) const;
 	/// <summary>
-	/// }EX{^ĂȂ
+	/// マウスボタンが押されていない
 	/// </summary>
-	/// <param name="buttontype">{^R[h</param>
+	/// <param name="buttontype">ボタンコード</param>
 	/// <returns></returns>
 	inline bool IsMouseEmpty(MouseButton buttontype) const;
 	/// <summary>
-	/// }EX{^ꂽu
+	/// マウスボタンが押された瞬間
 	/// </summary>
-	/// <param name="buttontype">{^R[h</param>
+	/// <param name="buttontype">ボタンコード</param>
 	/// <returns></returns>
 	inline bool IsMouseTrigger(MouseButton buttontype) const;
 	/// <summary>
-	/// }EX{^𗣂u
+	/// マウスボタンを離した瞬間
 	/// </summary>
-	/// <param name="buttontype">{^R[h</param>
+	/// <param name="buttontype">ボタンコード</param>
 	/// <returns></returns>
 	inline bool IsMouseRelease(MouseButton buttontype) const;
 	/// <summary>
-	/// }EX̃XN[W
+	/// マウスのスクリーン座標
 	/// </summary>
 	/// <returns></returns>
 	inline const Vector2& GetMousePosition() const;
 	/// <summary>
-	/// }EẌړ
+	/// マウスの移動量
 	/// </summary>
 	/// <returns></returns>
 	inline const Vector2 GetMouseMove() const;
 	/// <summary>
-	/// }EXzC[
+	/// マウスホイール
 	/// </summary>
 	/// <returns></returns>
 	inline float GetWheel() const;
 	
 #pragma endregion
 
-#pragma region Rg[[֌W
+#pragma region コントローラー関係
 	
 	/// <summary>
-	/// gK[̃fbh][ύX
+	/// トリガーのデッドゾーンを変更する
 	/// </summary>
-	/// <param name="number">Rg[[ԍ</param>
-	/// <param name="deadzone">fbh][@F@0`255(0 ~ 0xFF)</param>
+	/// <param name="number">コントローラー番号</param>
+	/// <param name="deadzone">デッドゾーン　：　0～255(0 ~ 0xFF)</param>
 	inline void SetTriggerDeadZone(int index, int deadzone);
 	/// <summary>
-	/// EXeBbÑfbh][ύX
+	/// 右スティックのデッドゾーンを変更する
 	/// </summary>
-	/// <param name="number">Rg[[ԍ</param>
-	/// <param name="deadzone">fbh][@F@0`32768(0 ~ 0x8000)</param>
+	/// <param name="number">コントローラー番号</param>
+	/// <param name="deadzone">デッドゾーン　：　0～32768(0 ~ 0x8000)</param>
 	inline void SetRightStickDeadZone(int index, int deadzone);
 	/// <summary>
-	/// XeBbÑfbh][ύX
+	/// 左スティックのデッドゾーンを変更する
 	/// </summary>
-	/// <param name="number">Rg[[ԍ</param>
-	/// <param name="deadzone">fbh][@F@0`32768(0 ~ 0x8000)</param>
+	/// <param name="number">コントローラー番号</param>
+	/// <param name="deadzone">デッドゾーン　：　0～32768(0 ~ 0x8000)</param>
 	inline void SetLeftStickDeadZone(int index, int deadzone);
 
 	/// <summary>
-	/// gK[̃fbh][ύX
+	/// トリガーのデッドゾーンを変更する
 	/// </summary>
-	/// <param name="number">Rg[[ԍ</param>
+	/// <param name="number">コントローラー番号</param>
 	inline int GetTriggerDeadZone(int index);
 	/// <summary>
-	/// EXeBbÑfbh][ύX
+	/// 右スティックのデッドゾーンを変更する
 	/// </summary>
-	/// <param name="number">Rg[[ԍ</param>
+	/// <param name="number">コントローラー番号</param>
 	inline int GetRightStickDeadZone(int index);
 	/// <summary>
-	/// XeBbÑfbh][ύX
+	/// 左スティックのデッドゾーンを変更する
 	/// </summary>
-	/// <param name="number">Rg[[ԍ</param>
+	/// <param name="number">コントローラー番号</param>
 	inline int GetLeftStickDeadZone(int index);
 
 	/// <summary>
-	/// {^ꂽ
+	/// ボタンが押された時
 	/// </summary>
-	/// <param name="number">Rg[[ԍ</param>
-	/// <param name="button">{^ԍ</param>
+	/// <param name="number">コントローラー番号</param>
+	/// <param name="button">ボタン番号</param>
 	/// <returns></returns>
 	bool IsPadButtonTrigger(int index, PadButton button) const;
 	/// <summary>
-	/// {^Ă鎞
+	/// ボタンが押されている時
 	/// </summary>
-	/// <param name="number">Rg[[ԍ</param>
-	/// <param name="button">{^ԍ</param>
+	/// <param name="number">コントローラー番号</param>
+	/// <param name="button">ボタン番号</param>
 	/// <returns></returns>
 	bool IsPadButtonPressed(int index, PadButton button) const;
 	/// <summary>
-	/// {^ꂽ
+	/// ボタンが離された時
 	/// </summary>
-	/// <param name="number">Rg[[ԍ</param>
-	/// <param name="button">{^ԍ</param>
+	/// <param name="number">コントローラー番号</param>
+	/// <param name="button">ボタン番号</param>
 	/// <returns></returns>
 	bool IsPadButtonRelease(int index, PadButton button) const;
 	/// <summary>
-	/// EXeBbNw̌ɓ|ꂽ
+	/// 右スティックが指定の向きに倒された時
 	/// </summary>
-	/// <param name="number">Rg[[ԍ</param>
-	/// <param name="direction">XeBbN</param>
+	/// <param name="number">コントローラー番号</param>
+	/// <param name="direction">スティック向き</param>
 	/// <returns></returns>
 	bool IsRightStickDirection(int index, StickDirection direction) const;
 	/// <summary>
-	/// XeBbNw̌ɓ|ꂽ
+	/// 左スティックが指定の向きに倒された時
 	/// </summary>
-	/// <param name="number">Rg[[ԍ</param>
-	/// <param name="direction">XeBbN</param>
+	/// <param name="number">コントローラー番号</param>
+	/// <param name="direction">スティック向き</param>
 	/// <returns></returns>
 	bool IsLeftStickDirection(int index, StickDirection direction) const;
 	/// <summary>
-	/// EgK[
+	/// 右トリガー
 	/// </summary>
-	/// <param name="number">Rg[[ԍ</param>
-	/// <param name="out">0`255</param>
-	/// <returns>@or@s</returns>
+	/// <param name="number">コントローラー番号</param>
+	/// <param name="out">0～255</param>
+	/// <returns>成功　or　失敗</returns>
 	int GetRightTrigger(int index) const;
 	/// <summary>
-	/// gK[
+	/// 左トリガー
 	/// </summary>
-	/// <param name="number">Rg[[ԍ</param>
-	/// <param name="out">0`255</param>
-	/// <returns>@or@s</returns>
+	/// <param name="number">コントローラー番号</param>
+	/// <param name="out">0～255</param>
+	/// <returns>成功　or　失敗</returns>
 	int GetLeftTrigger(int index) const;
 	/// <summary>
-	/// EXeBbN
+	/// 右スティック
 	/// </summary>
-	/// <param name="number">Rg[[ԍ</param>
-	/// <param name="outx">X</param>
-	/// <param name="outy">Y</param>
+	/// <param name="number">コントローラー番号</param>
+	/// <param name="outx">X軸</param>
+	/// <param name="outy">Y軸</param>
 	void GetRightStick(int index, int* outx, int* outy) const;
 	/// <summary>
-	/// EXeBbN
+	/// 右スティック
 	/// </summary>
-	/// <param name="number">Rg[[ԍ</param>
+	/// <param name="number">コントローラー番号</param>
 	Vector2 GetRightStick(int index) const;
 	/// <summary>
-	/// XeBbN
+	/// 左スティック
 	/// </summary>
-	/// <param name="number">Rg[[ԍ</param>
-	/// <param name="outx">X</param>
-	/// <param name="outy">Y</param>
+	/// <param name="number">コントローラー番号</param>
+	/// <param name="outx">X軸</param>
+	/// <param name="outy">Y軸</param>
 	void GetLeftStick(int index, int* outx, int* outy) const;
 	/// <summary>
-	/// XeBbN
+	/// 左スティック
 	/// </summary>
-	/// <param name="number">Rg[[ԍ</param>
+	/// <param name="number">コントローラー番号</param>
 	Vector2 GetLeftStick(int index) const;
 
 #pragma endregion
 
 	/// <summary>
-	/// 
+	/// 初期化
 	/// </summary>
 	void Initialize();
 	/// <summary>
-	/// XV
+	/// 更新
 	/// </summary>
 	void Update();
 
@@ -277,18 +277,18 @@ private:
 	ComPtr<IDirectInputDevice8> keyboard_;
 	ComPtr<IDirectInputDevice8> mouse_;
 
-	BYTE curkeys_[kKeyDataNum] = {}; // ݂̃L[̓͏
-	BYTE preKeys_[kKeyDataNum] = {}; // ÕL[̓͏
+	BYTE curkeys_[kKeyDataNum] = {}; // 現在のキーの入力状態
+	BYTE preKeys_[kKeyDataNum] = {}; // 前回のキーの入力状態
 
-	DIMOUSESTATE2 curMouseState_ = {}; // ݂̃}EX̓͏
-	DIMOUSESTATE2 preMouseState_ = {}; // Õ}EX̓͏
-	Vector2 mousePos_;					// }EX̃XN[W
+	DIMOUSESTATE2 curMouseState_ = {}; // 現在のマウスの入力状態
+	DIMOUSESTATE2 preMouseState_ = {}; // 前回のマウスの入力状態
+	Vector2 mousePos_ = {};				// マウスのスクリーン座標
 
 	std::array<GamePad, kXInputConnectMaxCount> gamePads_;
 
 };
 
-#pragma region CC`
+#pragma region インライン定義
 
 inline bool Input::IsKeyPressed(uint8_t keycode) const { return curkeys_[keycode] != 0; }
 inline bool Input::IsKeyEmpty(uint8_t keycode) const { return curkeys_[keycode] == 0; }
@@ -346,15 +346,15 @@ inline bool Input::IsPadButtonTrigger(int index, PadButton button) const
 {
 	switch (button)
 	{
-	case kPadLeftTrigger: // gK[
+	case kPadLeftTrigger: // 左トリガー
 		return (gamePads_[index].curState.Gamepad.bLeftTrigger > gamePads_[index].triggerDeadZone) &&
 			!(gamePads_[index].preState.Gamepad.bLeftTrigger > gamePads_[index].triggerDeadZone);
 
-	case kPadRightTrigger: // EgK[
+	case kPadRightTrigger: // 右トリガー
 		return (gamePads_[index].curState.Gamepad.bRightTrigger > gamePads_[index].triggerDeadZone) &&
 			!(gamePads_[index].preState.Gamepad.bRightTrigger > gamePads_[index].triggerDeadZone);
 
-	default: // ̑{^
+	default: // その他ボタン
 		return (gamePads_[index].curState.Gamepad.wButtons & button) &&
 			!(gamePads_[index].preState.Gamepad.wButtons & button);
 
@@ -366,13 +366,13 @@ inline bool Input::IsPadButtonPressed(int index, PadButton button) const
 {
 	switch (button)
 	{
-	case kPadLeftTrigger: // gK[
+	case kPadLeftTrigger: // 左トリガー
 		return (gamePads_[index].curState.Gamepad.bLeftTrigger > gamePads_[index].triggerDeadZone);
 
-	case kPadRightTrigger: // EgK[
+	case kPadRightTrigger: // 右トリガー
 		return (gamePads_[index].curState.Gamepad.bRightTrigger > gamePads_[index].triggerDeadZone);
 
-	default: // ̑{^
+	default: // その他ボタン
 		return (gamePads_[index].curState.Gamepad.wButtons & button);
 
 	}
@@ -383,15 +383,15 @@ inline bool Input::IsPadButtonRelease(int index, PadButton button) const
 {
 	switch (button)
 	{
-	case kPadLeftTrigger: // gK[
+	case kPadLeftTrigger: // 左トリガー
 		return !(gamePads_[index].curState.Gamepad.bLeftTrigger > gamePads_[index].triggerDeadZone) &&
 			(gamePads_[index].preState.Gamepad.bLeftTrigger > gamePads_[index].triggerDeadZone);
 
-	case kPadRightTrigger: // EgK[
+	case kPadRightTrigger: // 右トリガー
 		return !(gamePads_[index].curState.Gamepad.bRightTrigger > gamePads_[index].triggerDeadZone) &&
 			(gamePads_[index].preState.Gamepad.bRightTrigger > gamePads_[index].triggerDeadZone);
 
-	default: // ̑{^
+	default: // その他ボタン
 		return !(gamePads_[index].curState.Gamepad.wButtons & button) &&
 			(gamePads_[index].preState.Gamepad.wButtons & button);
 
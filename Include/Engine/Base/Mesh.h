@@ -11,52 +11,54 @@
 #include "DirectXCommon.h"
 
 /// <summary>
-/// bVi_ƃCfbNXj
+/// メッシュ（頂点とインデックス）
 /// </summary>
-/// <typeparam name="VERTEX_TYPE">_̌^</typeparam>
+/// <typeparam name="VERTEX_TYPE">頂点の型</typeparam>
 template<class VERTEX_TYPE>
 class Mesh
 {
 public:
+	~Mesh();
+
 	/// <summary>
-	/// _ǉ
+	/// 頂点を追加
 	/// </summary>
-	/// <param name="vertex">_</param>
+	/// <param name="vertex">頂点</param>
 	inline void AddVertex(const VERTEX_TYPE& vertex) { indcies_.emplace_back(vertex); }
 	/// <summary>
-	/// CfbNXǉ
+	/// インデックスを追加
 	/// </summary>
-	/// <param name="index">CfbNX</param>
+	/// <param name="index">インデックス</param>
 	inline void AddIndex(uint16_t index) { indcies_.emplace_back(index); }
 	/// <summary>
-	/// _擾
+	/// 頂点数を取得
 	/// </summary>
 	/// <returns></returns>
 	inline size_t GetVertexCount() const { return vertcies_.size(); }
 	/// <summary>
-	/// CfbNX擾
+	/// インデックス数を取得
 	/// </summary>
 	/// <returns></returns>
 	inline size_t GetIndexCount() const { return indcies_.size(); }
 	/// <summary>
-	/// _z擾
+	/// 頂点配列を取得
 	/// </summary>
 	/// <returns></returns>
 	inline const std::vector<VERTEX_TYPE>& GetVertcies() const { return vertcies_; }
 	/// <summary>
-	/// CfbNXz擾
+	/// インデックス配列を取得
 	/// </summary>
 	/// <returns></returns>
 	inline const std::vector<uint16_t>& GetIndcies() const { return indcies_; }
 	/// <summary>
-	/// obt@𐶐
+	/// バッファを生成
 	/// </summary>
 	void CreateBuffers();
 	/// <summary>
-	/// `
+	/// 描画
 	/// </summary>
-	/// <param name="cmdList">R}hXg</param>
-	void Draw(ID3D12GraphicsCommandList* cmdList);
+	/// <param name="cmdList">コマンドリスト</param>
+	void Draw(TrackedCommandList* cmdList);
 	
 private:
 	Mesh(const Mesh&) = delete;
@@ -66,8 +68,8 @@ private:
 	void CreateIndexBuffer();
 
 private:
-	Microsoft::WRL::ComPtr<ID3D12Resource> vertexBuffer_;
-	Microsoft::WRL::ComPtr<ID3D12Resource> indexBuffer_;
+	GpuAllocation vertexBuffer_;
+	GpuAllocation indexBuffer_;
 	D3D12_VERTEX_BUFFER_VIEW vertexBufferView_ = {};
 	D3D12_INDEX_BUFFER_VIEW indexBufferView_ = {};
 	std::vector<VERTEX_TYPE> vertcies_;
@@ -75,7 +77,16 @@ private:
 
 };
 
-#pragma region // ֐̎
+#pragma region // 関数の実装
+
+template<class VERTEX_TYPE>
+inline Mesh<VERTEX_TYPE>::~Mesh()
+{
+	// GPU が読み終えてからヒープに返す
+	auto gpuMemoryAllocator = DirectXCommon::GetInstance()->GetGpuMemoryAllocator();
+	gpuMemoryAllocator->Free(vertexBuffer_);
+	gpuMemoryAllocator->Free(indexBuffer_);
+}
 
 template<class VERTEX_TYPE>
 inline void Mesh<VERTEX_TYPE>::CreateBuffers()
@@ -85,7 +96,7 @@ inline void Mesh<VERTEX_TYPE>::CreateBuffers()
 }
 
 template<class VERTEX_TYPE>
-inline void Mesh<VERTEX_TYPE>::Draw(ID3D12GraphicsCommandList* cmdList) {
+inline void Mesh<VERTEX_TYPE>::Draw(TrackedCommandList* cmdList) {
 	cmdList->IASetVertexBuffers(0, 1, &vertexBufferView_);
 	cmdList->IASetIndexBuffer(&indexBufferView_);
 	cmdList->DrawIndexedInstanced(indcies_.size(), 1, 0, 0, 0);
@@ -97,19 +108,21 @@ void Mesh<VERTEX_TYPE>::CreateVertexBuffer() {
 	auto dixCom = DirectXCommon::GetInstance();
 
 	UINT byteSize = static_cast<UINT>(sizeof(VERTEX_TYPE) * vertcies_.size());
-	vertexBuffer_ = DirectXCommon::GetInstance()->CreateResourceBuffer(byteSize);
+	// 作り直す場合は前のバッファを返す
+	dixCom->GetGpuMemoryAllocator()->Free(vertexBuffer_);
+	vertexBuffer_ = dixCom->CreateResourceBuffer(byteSize);
 
-	// r[𐶐
-	// GPUzAhX
+	// ビューを生成
+	// GPU仮想アドレス
 	vertexBufferView_.BufferLocation = vertexBuffer_->GetGPUVirtualAddress();
 	vertexBufferView_.SizeInBytes = byteSize;
 	vertexBufferView_.StrideInBytes = sizeof(VERTEX_TYPE);
 
-	// }bsO
+	// マッピング
 	VERTEX_TYPE* map = nullptr;
 	result = vertexBuffer_->Map(0, nullptr, (void**)&map);
 	assert(SUCCEEDED(result));
-	// Rs[
+	// コピー
 	std::copy(vertcies_.begin(), vertcies_.end(), map);
 	vertexBuffer_->Unmap(0, nullptr);
 }
@@ -120,19 +133,21 @@ void Mesh<VERTEX_TYPE>::CreateIndexBuffer() {
 	auto dixCom = DirectXCommon::GetInstance();
 
 	UINT byteSize = static_cast<UINT>(sizeof(uint16_t) * indcies_.size());
-	indexBuffer_ = DirectXCommon::GetInstance()->CreateResourceBuffer(byteSize);
+	// 作り直す場合は前のバッファを返す
+	dixCom->GetGpuMemoryAllocator()->Free(indexBuffer_);
+	indexBuffer_ = dixCom->CreateResourceBuffer(byteSize);
 
-	// r[𐶐
-	// GPUzAhX
+	// ビューを生成
+	// GPU仮想アドレス
 	indexBufferView_.BufferLocation = indexBuffer_->GetGPUVirtualAddress();
 	indexBufferView_.Format = DXGI_FORMAT_R16_UINT;
 	indexBufferView_.SizeInBytes = byteSize;
 
-	// }bsO
+	// マッピング
 	uint16_t* map = nullptr;
-	result = indexBuffer_->Map(0, nullptr, (void**)&map); // }bsO
+	result = indexBuffer_->Map(0, nullptr, (void**)&map); // マッピング
 	assert(SUCCEEDED(result));
-	// Rs[
+	// コピー
 	std::copy(indcies_.begin(), indcies_.end(), map);
 	indexBuffer_->Unmap(0, nullptr);
 }
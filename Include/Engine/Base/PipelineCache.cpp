@@ -0,0 +1,279 @@
+#include "PipelineCache.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+#include "ThreadPool.h"
+
+namespace {
+	// 経過時間(ミリ秒)
+	class ScopedTimer {
+	public:
+		explicit ScopedTimer(double& milliseconds) :
+			milliseconds_(milliseconds), start_(std::chrono::steady_clock::now()) {}
+		~ScopedTimer() {
+			milliseconds_ += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_).count();
+		}
+
+	private:
+		double& milliseconds_;
+		std::chrono::steady_clock::time_point start_;
+	};
+}
+
+PipelineCache::~PipelineCache() {
+	WaitBackground();
+}
+
+void PipelineCache::Initalize(ID3D12Device* device, const std::string& filePath, bool isPrewarmEnabled) {
+	assert(device != nullptr);
+	WaitBackground();
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	device_ = device;
+	filePath_ = filePath;
+	isPrewarmEnabled_ = isPrewarmEnabled;
+	rootSignatures_.clear();
+	rootSignatureHashes_.clear();
+	pipelines_.clear();
+	statistics_ = {};
+	frameStatistics_ = {};
+	lastFrameStatistics_ = {};
+
+	ScopedTimer timer(statistics_.loadMilliseconds);
+	// 無いか壊れていれば空から始める
+	store_.Load(filePath_);
+	prewarmKeys_.clear();
+	prewarmKeys_.insert(store_.GetPrewarmKeys().begin(), store_.GetPrewarmKeys().end());
+}
+
+void PipelineCache::Save() {
+	WaitBackground();
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	// 今回使ったものを次回の起動で先に作る
+	std::vector<PipelineKey> usedKeys;
+	for (auto& [key, pipeline] : pipelines_) {
+		if (pipeline->isUsed) {
+			usedKeys.push_back(key);
+		}
+	}
+	std::sort(usedKeys.begin(), usedKeys.end());
+	store_.SetPrewarmKeys(std::move(usedKeys));
+
+	if (!store_.IsDirty()) {
+		return;
+	}
+	// 書けなくても次回の起動が遅くなるだけ
+	store_.Save(filePath_);
+}
+
+void PipelineCache::BeginFrame() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	lastFrameStatistics_ = frameStatistics_;
+	frameStatistics_ = {};
+}
+
+ID3D12RootSignature* PipelineCache::GetRootSignature(const D3D12_ROOT_SIGNATURE_DESC& desc) {
+	uint64_t key = PipelineCacheStore::HashRootSignature(desc);
+	std::lock_guard<std::mutex> lock(mutex_);
+	auto it = rootSignatures_.find(key);
+	if (it != rootSignatures_.end()) {
+		statistics_.rootSignatureHitCount++;
+		return it->second.Get();
+	}
+
+	ScopedTimer timer(statistics_.createMilliseconds);
+	HRESULT result = S_FALSE;
+	ComPtr<ID3D12RootSignature> rootSignature;
+	// シリアライズ済みならそのまま使う
+	if (auto blob = store_.Find(key)) {
+		result = device_->CreateRootSignature(0, blob->data(), blob->size(), IID_PPV_ARGS(&rootSignature));
+		if (SUCCEEDED(result)) {
+			statistics_.rootSignatureDiskHitCount++;
+		}
+	}
+	if (!rootSignature) {
+		ComPtr<ID3DBlob> rootSigBlob;
+		ComPtr<ID3DBlob> errorBlob;
+		result = D3D12SerializeRootSignature(&desc, D3D_ROOT_SIGNATURE_VERSION_1_0, &rootSigBlob, &errorBlob);
+		assert(SUCCEEDED(result));
+		result = device_->CreateRootSignature(0,
+			rootSigBlob->GetBufferPointer(), rootSigBlob->GetBufferSize(),
+			IID_PPV_ARGS(&rootSignature));
+		assert(SUCCEEDED(result));
+		store_.Store(key, rootSigBlob->GetBufferPointer(), rootSigBlob->GetBufferSize());
+		statistics_.rootSignatureMissCount++;
+	}
+
+	rootSignatureHashes_[rootSignature.Get()] = key;
+	return (rootSignatures_[key] = rootSignature).Get();
+}
+
+PipelineCache::PipelineKey PipelineCache::RegisterGraphicsPipeline(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc) {
+	// ストリーム出力は複製しない
+	assert(desc.StreamOutput.NumEntries == 0);
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	auto rootSignatureHash = rootSignatureHashes_.find(desc.pRootSignature);
+	// ルートシグネチャもキャッシュから取得しておく
+	assert(rootSignatureHash != rootSignatureHashes_.end());
+	PipelineKey key = PipelineCacheStore::HashGraphicsPipeline(desc, rootSignatureHash->second);
+	auto& slot = pipelines_[key];
+	if (slot) {
+		return key;
+	}
+
+	slot = std::make_unique<Pipeline>();
+	Pipeline* pipeline = slot.get();
+	pipeline->key = key;
+	pipeline->index = static_cast<uint32_t>(pipelines_.size() - 1);
+	pipeline->desc = desc;
+	pipeline->desc.CachedPSO = {};
+	// 頂点レイアウトは呼び出し元の配列を指しているので複製する
+	UINT elementCount = desc.InputLayout.NumElements;
+	pipeline->inputElements.assign(desc.InputLayout.pInputElementDescs, desc.InputLayout.pInputElementDescs + elementCount);
+	pipeline->semanticNames.reserve(elementCount);
+	for (auto& element : pipeline->inputElements) {
+		element.SemanticName = pipeline->semanticNames.emplace_back(element.SemanticName).c_str();
+	}
+	pipeline->desc.InputLayout = { pipeline->inputElements.data(), elementCount };
+
+	// 前回使ったものは使う前に作り始める
+	bool isPrewarm = isPrewarmEnabled_ && prewarmKeys_.contains(key);
+	if (!isPrewarm) {
+		return key;
+	}
+	pipeline->state = kPipelineStateCreating;
+	backgroundCount_++;
+	statistics_.prewarmCount++;
+	lock.unlock();
+	RequestBackground(pipeline);
+	return key;
+}
+
+ID3D12PipelineState* PipelineCache::GetGraphicsPipeline(PipelineKey key) {
+	std::unique_lock<std::mutex> lock(mutex_);
+	auto it = pipelines_.find(key);
+	assert(it != pipelines_.end());
+	Pipeline* pipeline = it->second.get();
+	pipeline->isUsed = true;
+	if (pipeline->state == kPipelineStateReady) {
+		statistics_.pipelineHitCount++;
+		return pipeline->pipelineState.Get();
+	}
+
+	if (fallbackPolicy_ == kFallbackPolicySkip) {
+		frameStatistics_.skippedDrawCount++;
+		if (pipeline->state == kPipelineStateRegistered) {
+			pipeline->state = kPipelineStateCreating;
+			backgroundCount_++;
+			lock.unlock();
+			RequestBackground(pipeline);
+		}
+		return nullptr;
+	}
+
+	// ここから描画するスレッドが止まる
+	auto start = std::chrono::steady_clock::now();
+	if (pipeline->state == kPipelineStateCreating) {
+		condition_.wait(lock, [pipeline]() { return pipeline->state == kPipelineStateReady; });
+		frameStatistics_.blockingWaitCount++;
+	}
+	else {
+		pipeline->state = kPipelineStateCreating;
+		lock.unlock();
+		CreatePipeline(pipeline);
+		lock.lock();
+		frameStatistics_.blockingCreateCount++;
+	}
+	frameStatistics_.blockingMilliseconds +=
+		std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return pipeline->pipelineState.Get();
+}
+
+void PipelineCache::WaitBackground() {
+	std::unique_lock<std::mutex> lock(mutex_);
+	condition_.wait(lock, [this]() { return backgroundCount_ == 0; });
+}
+
+uint32_t PipelineCache::GetPipelineIndex(PipelineKey key) const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	auto it = pipelines_.find(key);
+	// 登録していない
+	assert(it != pipelines_.end());
+	return it->second->index;
+}
+
+PipelineCache::Statistics PipelineCache::GetStatistics() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return statistics_;
+}
+
+void PipelineCache::RequestBackground(Pipeline* pipeline) {
+	ThreadPool::GetInstance()->EnqueueBackground([this, pipeline]() {
+		CreatePipeline(pipeline);
+		// 待っていたスレッドがキャッシュを破棄できるので、ロックを持ったまま知らせる
+		std::lock_guard<std::mutex> lock(mutex_);
+		backgroundCount_--;
+		frameStatistics_.backgroundCreateCount++;
+		condition_.notify_all();
+		});
+}
+
+void PipelineCache::CreatePipeline(Pipeline* pipeline) {
+	auto start = std::chrono::steady_clock::now();
+
+	// 他のスレッドが書き足すので複製しておく
+	std::vector<uint8_t> cachedData;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (auto data = store_.Find(pipeline->key)) {
+			cachedData = *data;
+		}
+	}
+
+	HRESULT result = S_FALSE;
+	ComPtr<ID3D12PipelineState> pipelineState;
+	bool isRejected = false;
+	if (!cachedData.empty()) {
+		D3D12_GRAPHICS_PIPELINE_STATE_DESC cachedDesc = pipeline->desc;
+		cachedDesc.CachedPSO.pCachedBlob = cachedData.data();
+		cachedDesc.CachedPSO.CachedBlobSizeInBytes = cachedData.size();
+		result = device_->CreateGraphicsPipelineState(&cachedDesc, IID_PPV_ARGS(&pipelineState));
+		// 失敗したらアダプタやドライバが変わった
+		isRejected = FAILED(result);
+	}
+	ComPtr<ID3DBlob> cachedBlob;
+	if (!pipelineState) {
+		result = device_->CreateGraphicsPipelineState(&pipeline->desc, IID_PPV_ARGS(&pipelineState));
+		assert(SUCCEEDED(result));
+		result = pipelineState->GetCachedBlob(&cachedBlob);
+		if (FAILED(result)) {
+			cachedBlob.Reset();
+		}
+	}
+	double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (isRejected) {
+			store_.Remove(pipeline->key);
+			statistics_.pipelineRejectCount++;
+		}
+		if (cachedData.empty() || isRejected) {
+			if (cachedBlob) {
+				store_.Store(pipeline->key, cachedBlob->GetBufferPointer(), cachedBlob->GetBufferSize());
+			}
+			statistics_.pipelineMissCount++;
+		}
+		else {
+			statistics_.pipelineDiskHitCount++;
+		}
+		statistics_.createMilliseconds += milliseconds;
+		pipeline->pipelineState = pipelineState;
+		pipeline->state = kPipelineStateReady;
+		condition_.notify_all();
+	}
+}
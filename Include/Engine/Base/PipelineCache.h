@@ -0,0 +1,206 @@
+#pragma once
+#ifndef PIPELINECACHE_H_
+#define PIPELINECACHE_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <d3d12.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <wrl.h>
+
+#include "PipelineCacheStore.h"
+
+/// <summary>
+/// 設定のハッシュでパイプラインとルートシグネチャを使い回す
+/// 実行中は生成済みのものを返し、次回の起動にはドライバのバイナリ(CachedPSO)とシリアライズ済みのルートシグネチャを残す
+/// ドライバが変わってバイナリが使えなければ作り直して置き換える
+/// パイプラインは登録だけしておき、初めて使うときに作る(前回使ったものは登録時にワーカースレッドで作り始める)
+/// </summary>
+class PipelineCache
+{
+private:
+	template<class TYPE>
+	using ComPtr = Microsoft::WRL::ComPtr<TYPE>;
+
+public:
+	// 登録したパイプライン(設定のハッシュ)
+	using PipelineKey = uint64_t;
+
+	/// <summary>
+	/// 使うときにまだパイプラインが無い場合
+	/// </summary>
+	enum FallbackPolicy {
+		kFallbackPolicyBlock,	// その場で作る(ワーカーが作っていれば待つ)
+		kFallbackPolicySkip,	// ワーカーに作らせ、その描画は飛ばす
+	};
+
+	/// <summary>
+	/// 統計(Initalize からの累計)
+	/// </summary>
+	struct Statistics {
+		// 実行中に生成済みのものを返した回数
+		size_t rootSignatureHitCount = 0;
+		size_t pipelineHitCount = 0;
+		// ファイルのバイナリから生成した回数
+		size_t rootSignatureDiskHitCount = 0;
+		size_t pipelineDiskHitCount = 0;
+		// 一から生成した回数
+		size_t rootSignatureMissCount = 0;
+		size_t pipelineMissCount = 0;
+		// ファイルのバイナリをドライバが受け付けなかった回数
+		size_t pipelineRejectCount = 0;
+		// 前回の実行で使ったのでワーカーで作り始めた数
+		size_t prewarmCount = 0;
+		// 生成にかかった時間(ミリ秒、ワーカーの分を含む)
+		double createMilliseconds = 0.0;
+		// ファイルの読み込みにかかった時間(ミリ秒)
+		double loadMilliseconds = 0.0;
+	};
+
+	/// <summary>
+	/// フレームごとの統計(描画するスレッドが止まった分)
+	/// </summary>
+	struct FrameStatistics {
+		// その場で作った数
+		size_t blockingCreateCount = 0;
+		// ワーカーが作り終えるのを待った数
+		size_t blockingWaitCount = 0;
+		// 止まった時間(ミリ秒)
+		double blockingMilliseconds = 0.0;
+		// パイプラインが無く飛ばした描画の数
+		size_t skippedDrawCount = 0;
+		// ワーカーが作り終えた数
+		size_t backgroundCreateCount = 0;
+	};
+
+public:
+	~PipelineCache();
+
+	/// <summary>
+	/// 初期化(ファイルがあれば読み込む)
+	/// </summary>
+	/// <param name="device">デバイス</param>
+	/// <param name="filePath">キャッシュファイルのパス</param>
+	/// <param name="isPrewarmEnabled">前回使ったパイプラインを登録時にワーカーで作るか</param>
+	void Initalize(ID3D12Device* device, const std::string& filePath, bool isPrewarmEnabled = true);
+	/// <summary>
+	/// ワーカーが作り終えるのを待ち、変わっていればファイルに書き出す
+	/// </summary>
+	void Save();
+	/// <summary>
+	/// フレームの開始(前のフレームで描画が止まっていれば出力する)
+	/// </summary>
+	void BeginFrame();
+	/// <summary>
+	/// ルートシグネチャを取得(同じ設定なら同じもの)
+	/// </summary>
+	/// <param name="desc">設定</param>
+	/// <returns>キャッシュが持つルートシグネチャ</returns>
+	ID3D12RootSignature* GetRootSignature(const D3D12_ROOT_SIGNATURE_DESC& desc);
+	/// <summary>
+	/// パイプラインを登録(作るのは初めて使うとき)
+	/// 頂点レイアウトは複製する。シェーダーのバイトコードは作り終えるまで残しておく(ShaderLibrary のもの)
+	/// </summary>
+	/// <param name="desc">設定(pRootSignature は GetRootSignature で取得したもの)</param>
+	/// <returns>GetGraphicsPipeline に渡すキー</returns>
+	PipelineKey RegisterGraphicsPipeline(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc);
+	/// <summary>
+	/// 登録したパイプラインを取得(無ければ FallbackPolicy に従う)
+	/// </summary>
+	/// <param name="key">RegisterGraphicsPipeline のキー</param>
+	/// <returns>kFallbackPolicySkip でまだ無ければ nullptr(描画を飛ばす)</returns>
+	ID3D12PipelineState* GetGraphicsPipeline(PipelineKey key);
+	/// <summary>
+	/// 登録した順の番号を取得(描画のソートキーに使う)
+	/// </summary>
+	/// <param name="key">RegisterGraphicsPipeline のキー</param>
+	/// <returns></returns>
+	uint32_t GetPipelineIndex(PipelineKey key) const;
+	/// <summary>
+	/// ワーカーが作っているパイプラインを全て待つ
+	/// </summary>
+	void WaitBackground();
+
+	/// <summary>
+	/// 使うときにまだパイプラインが無い場合の扱いを設定
+	/// </summary>
+	/// <param name="policy"></param>
+	inline void SetFallbackPolicy(FallbackPolicy policy) { fallbackPolicy_ = policy; }
+	/// <summary>
+	/// 統計を取得
+	/// </summary>
+	/// <returns></returns>
+	Statistics GetStatistics() const;
+	/// <summary>
+	/// 前のフレームの統計を取得(BeginFrame を呼ぶスレッドから読む)
+	/// 描画するスレッドで作った(待った)フレームは blockingCreateCount か blockingWaitCount が 0 でない
+	/// </summary>
+	/// <returns></returns>
+	inline const FrameStatistics& GetLastFrameStatistics() const { return lastFrameStatistics_; }
+
+private:
+	/// <summary>
+	/// パイプラインの生成状態
+	/// </summary>
+	enum PipelineState {
+		kPipelineStateRegistered,	// まだ作っていない
+		kPipelineStateCreating,		// 作っている
+		kPipelineStateReady,		// 作り終えた
+	};
+
+	/// <summary>
+	/// 登録したパイプライン(設定を持ち続けるのでアドレスを変えない)
+	/// </summary>
+	struct Pipeline {
+		PipelineKey key = 0;
+		// 登録した順の番号
+		uint32_t index = 0;
+		D3D12_GRAPHICS_PIPELINE_STATE_DESC desc = {};
+		std::vector<D3D12_INPUT_ELEMENT_DESC> inputElements;
+		std::vector<std::string> semanticNames;
+		ComPtr<ID3D12PipelineState> pipelineState;
+		PipelineState state = kPipelineStateRegistered;
+		// 今回の実行で使ったか(次回先に作る)
+		bool isUsed = false;
+	};
+
+	/// <summary>
+	/// ワーカーに作らせる(kPipelineStateCreating にしてから mutex_ を持たずに呼ぶ)
+	/// </summary>
+	void RequestBackground(Pipeline* pipeline);
+	/// <summary>
+	/// パイプラインを作る(mutex_ を持たずに呼ぶ)
+	/// </summary>
+	void CreatePipeline(Pipeline* pipeline);
+
+private:
+	ID3D12Device* device_ = nullptr;
+	std::string filePath_;
+	bool isPrewarmEnabled_ = true;
+	FallbackPolicy fallbackPolicy_ = kFallbackPolicyBlock;
+
+	// 以下はワーカーと共有する
+	mutable std::mutex mutex_;
+	std::condition_variable condition_;
+	PipelineCacheStore store_;
+	std::unordered_map<uint64_t, ComPtr<ID3D12RootSignature>> rootSignatures_;
+	// パイプラインのハッシュに使う
+	std::unordered_map<ID3D12RootSignature*, uint64_t> rootSignatureHashes_;
+	std::unordered_map<PipelineKey, std::unique_ptr<Pipeline>> pipelines_;
+	// 前回の実行で使ったパイプライン
+	std::unordered_set<PipelineKey> prewarmKeys_;
+	// ワーカーが作っている数
+	size_t backgroundCount_ = 0;
+
+	Statistics statistics_;
+	FrameStatistics frameStatistics_;
+	FrameStatistics lastFrameStatistics_;
+
+};
+
+#endif
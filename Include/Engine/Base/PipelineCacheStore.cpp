@@ -0,0 +1,358 @@
+#include "PipelineCacheStore.h"
+
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+
+namespace {
+	// 壊れたファイルで巨大な確保をしない
+	constexpr uint32_t kMaxEntrySize = 64 * 1024 * 1024;
+
+	// ハッシュの種類(同じ内容でもキーが重ならない)
+	enum HashKind : uint64_t {
+		kHashKindRootSignature = 1,
+		kHashKindGraphicsPipeline = 2,
+	};
+
+	/// <summary>
+	/// FNV-1a 64bit
+	/// 構造体の隙間を含めないようにメンバを一つずつ加える
+	/// </summary>
+	class Hasher {
+	public:
+		explicit Hasher(HashKind kind) { Add(kind); }
+
+		void AddBytes(const void* data, size_t size) {
+			auto bytes = static_cast<const uint8_t*>(data);
+			for (size_t i = 0; i < size; i++) {
+				value_ ^= bytes[i];
+				value_ *= 1099511628211ull;
+			}
+		}
+		template<class TYPE>
+		void Add(const TYPE& value) {
+			static_assert(std::is_arithmetic_v<TYPE> || std::is_enum_v<TYPE>);
+			AddBytes(&value, sizeof(value));
+		}
+		void AddString(const char* str) {
+			// nullptr と空文字を区別する
+			if (str == nullptr) {
+				Add(uint8_t(0));
+				return;
+			}
+			Add(uint8_t(1));
+			AddBytes(str, std::strlen(str) + 1);
+		}
+		void AddShader(const D3D12_SHADER_BYTECODE& shader) {
+			Add(static_cast<uint64_t>(shader.BytecodeLength));
+			if (shader.pShaderBytecode != nullptr) {
+				AddBytes(shader.pShaderBytecode, shader.BytecodeLength);
+			}
+		}
+		void AddStencilOp(const D3D12_DEPTH_STENCILOP_DESC& desc) {
+			Add(desc.StencilFailOp);
+			Add(desc.StencilDepthFailOp);
+			Add(desc.StencilPassOp);
+			Add(desc.StencilFunc);
+		}
+
+		uint64_t GetValue() const { return value_; }
+
+	private:
+		uint64_t value_ = 14695981039346656037ull;
+	};
+
+	template<class TYPE>
+	void WriteValue(std::ostream& stream, const TYPE& value) {
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	template<class TYPE>
+	bool ReadValue(std::istream& stream, TYPE& value) {
+		return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(value)));
+	}
+}
+
+uint64_t PipelineCacheStore::HashRootSignature(const D3D12_ROOT_SIGNATURE_DESC& desc) {
+	Hasher hasher(kHashKindRootSignature);
+	hasher.Add(desc.NumParameters);
+	for (UINT i = 0; i < desc.NumParameters; i++) {
+		const D3D12_ROOT_PARAMETER& param = desc.pParameters[i];
+		hasher.Add(param.ParameterType);
+		hasher.Add(param.ShaderVisibility);
+		switch (param.ParameterType) {
+		case D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE:
+			hasher.Add(param.DescriptorTable.NumDescriptorRanges);
+			for (UINT j = 0; j < param.DescriptorTable.NumDescriptorRanges; j++) {
+				const D3D12_DESCRIPTOR_RANGE& range = param.DescriptorTable.pDescriptorRanges[j];
+				hasher.Add(range.RangeType);
+				hasher.Add(range.NumDescriptors);
+				hasher.Add(range.BaseShaderRegister);
+				hasher.Add(range.RegisterSpace);
+				hasher.Add(range.OffsetInDescriptorsFromTableStart);
+			}
+			break;
+		case D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS:
+			hasher.Add(param.Constants.ShaderRegister);
+			hasher.Add(param.Constants.RegisterSpace);
+			hasher.Add(param.Constants.Num32BitValues);
+			break;
+		default:
+			hasher.Add(param.Descriptor.ShaderRegister);
+			hasher.Add(param.Descriptor.RegisterSpace);
+			break;
+		}
+	}
+
+	hasher.Add(desc.NumStaticSamplers);
+	for (UINT i = 0; i < desc.NumStaticSamplers; i++) {
+		const D3D12_STATIC_SAMPLER_DESC& sampler = desc.pStaticSamplers[i];
+		hasher.Add(sampler.Filter);
+		hasher.Add(sampler.AddressU);
+		hasher.Add(sampler.AddressV);
+		hasher.Add(sampler.AddressW);
+		hasher.Add(sampler.MipLODBias);
+		hasher.Add(sampler.MaxAnisotropy);
+		hasher.Add(sampler.ComparisonFunc);
+		hasher.Add(sampler.BorderColor);
+		hasher.Add(sampler.MinLOD);
+		hasher.Add(sampler.MaxLOD);
+		hasher.Add(sampler.ShaderRegister);
+		hasher.Add(sampler.RegisterSpace);
+		hasher.Add(sampler.ShaderVisibility);
+	}
+	hasher.Add(desc.Flags);
+	return hasher.GetValue();
+}
+
+uint64_t PipelineCacheStore::HashGraphicsPipeline(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, uint64_t rootSignatureHash) {
+	Hasher hasher(kHashKindGraphicsPipeline);
+	hasher.Add(rootSignatureHash);
+
+	// シェーダー
+	hasher.AddShader(desc.VS);
+	hasher.AddShader(desc.PS);
+	hasher.AddShader(desc.DS);
+	hasher.AddShader(desc.HS);
+	hasher.AddShader(desc.GS);
+
+	// ストリーム出力
+	hasher.Add(desc.StreamOutput.NumEntries);
+	for (UINT i = 0; i < desc.StreamOutput.NumEntries; i++) {
+		const D3D12_SO_DECLARATION_ENTRY& entry = desc.StreamOutput.pSODeclaration[i];
+		hasher.Add(entry.Stream);
+		hasher.AddString(entry.SemanticName);
+		hasher.Add(entry.SemanticIndex);
+		hasher.Add(entry.StartComponent);
+		hasher.Add(entry.ComponentCount);
+		hasher.Add(entry.OutputSlot);
+	}
+	hasher.Add(desc.StreamOutput.NumStrides);
+	for (UINT i = 0; i < desc.StreamOutput.NumStrides; i++) {
+		hasher.Add(desc.StreamOutput.pBufferStrides[i]);
+	}
+	hasher.Add(desc.StreamOutput.RasterizedStream);
+
+	// ブレンド
+	hasher.Add(desc.BlendState.AlphaToCoverageEnable);
+	hasher.Add(desc.BlendState.IndependentBlendEnable);
+	for (auto& blend : desc.BlendState.RenderTarget) {
+		hasher.Add(blend.BlendEnable);
+		hasher.Add(blend.LogicOpEnable);
+		hasher.Add(blend.SrcBlend);
+		hasher.Add(blend.DestBlend);
+		hasher.Add(blend.BlendOp);
+		hasher.Add(blend.SrcBlendAlpha);
+		hasher.Add(blend.DestBlendAlpha);
+		hasher.Add(blend.BlendOpAlpha);
+		hasher.Add(blend.LogicOp);
+		hasher.Add(blend.RenderTargetWriteMask);
+	}
+	hasher.Add(desc.SampleMask);
+
+	// ラスタライザ
+	hasher.Add(desc.RasterizerState.FillMode);
+	hasher.Add(desc.RasterizerState.CullMode);
+	hasher.Add(desc.RasterizerState.FrontCounterClockwise);
+	hasher.Add(desc.RasterizerState.DepthBias);
+	hasher.Add(desc.RasterizerState.DepthBiasClamp);
+	hasher.Add(desc.RasterizerState.SlopeScaledDepthBias);
+	hasher.Add(desc.RasterizerState.DepthClipEnable);
+	hasher.Add(desc.RasterizerState.MultisampleEnable);
+	hasher.Add(desc.RasterizerState.AntialiasedLineEnable);
+	hasher.Add(desc.RasterizerState.ForcedSampleCount);
+	hasher.Add(desc.RasterizerState.ConservativeRaster);
+
+	// 深度ステンシル
+	hasher.Add(desc.DepthStencilState.DepthEnable);
+	hasher.Add(desc.DepthStencilState.DepthWriteMask);
+	hasher.Add(desc.DepthStencilState.DepthFunc);
+	hasher.Add(desc.DepthStencilState.StencilEnable);
+	hasher.Add(desc.DepthStencilState.StencilReadMask);
+	hasher.Add(desc.DepthStencilState.StencilWriteMask);
+	hasher.AddStencilOp(desc.DepthStencilState.FrontFace);
+	hasher.AddStencilOp(desc.DepthStencilState.BackFace);
+
+	// 頂点レイアウト
+	hasher.Add(desc.InputLayout.NumElements);
+	for (UINT i = 0; i < desc.InputLayout.NumElements; i++) {
+		const D3D12_INPUT_ELEMENT_DESC& element = desc.InputLayout.pInputElementDescs[i];
+		hasher.AddString(element.SemanticName);
+		hasher.Add(element.SemanticIndex);
+		hasher.Add(element.Format);
+		hasher.Add(element.InputSlot);
+		hasher.Add(element.AlignedByteOffset);
+		hasher.Add(element.InputSlotClass);
+		hasher.Add(element.InstanceDataStepRate);
+	}
+	hasher.Add(desc.IBStripCutValue);
+	hasher.Add(desc.PrimitiveTopologyType);
+
+	// 出力先
+	hasher.Add(desc.NumRenderTargets);
+	for (UINT i = 0; i < desc.NumRenderTargets; i++) {
+		hasher.Add(desc.RTVFormats[i]);
+	}
+	hasher.Add(desc.DSVFormat);
+	hasher.Add(desc.SampleDesc.Count);
+	hasher.Add(desc.SampleDesc.Quality);
+	hasher.Add(desc.NodeMask);
+	hasher.Add(desc.Flags);
+	return hasher.GetValue();
+}
+
+const std::vector<uint8_t>* PipelineCacheStore::Find(uint64_t key) {
+	auto it = entries_.find(key);
+	if (it == entries_.end()) {
+		return nullptr;
+	}
+	MarkUsed(it->second);
+	return &it->second.data;
+}
+
+void PipelineCacheStore::Store(uint64_t key, const void* data, size_t size) {
+	assert(size <= kMaxEntrySize);
+	Entry& entry = entries_[key];
+	auto bytes = static_cast<const uint8_t*>(data);
+	entry.data.assign(bytes, bytes + size);
+	MarkUsed(entry);
+	isModified_ = true;
+}
+
+void PipelineCacheStore::Remove(uint64_t key) {
+	auto it = entries_.find(key);
+	if (it == entries_.end()) {
+		return;
+	}
+	if (it->second.isUsed) {
+		usedCount_--;
+	}
+	entries_.erase(it);
+	isModified_ = true;
+}
+
+void PipelineCacheStore::Clear() {
+	entries_.clear();
+	prewarmKeys_.clear();
+	usedCount_ = 0;
+	isModified_ = false;
+}
+
+void PipelineCacheStore::SetPrewarmKeys(std::vector<uint64_t> keys) {
+	if (keys != prewarmKeys_) {
+		prewarmKeys_ = std::move(keys);
+		isModified_ = true;
+	}
+}
+
+bool PipelineCacheStore::Read(std::istream& stream) {
+	Clear();
+
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t count = 0;
+	if (!ReadValue(stream, magic) || !ReadValue(stream, version) || !ReadValue(stream, count) ||
+		magic != kMagic || version != kVersion) {
+		return false;
+	}
+
+	for (uint32_t i = 0; i < count; i++) {
+		uint64_t key = 0;
+		uint32_t size = 0;
+		if (!ReadValue(stream, key) || !ReadValue(stream, size) || size > kMaxEntrySize) {
+			Clear();
+			return false;
+		}
+		Entry& entry = entries_[key];
+		entry.data.resize(size);
+		if (!stream.read(reinterpret_cast<char*>(entry.data.data()), size)) {
+			Clear();
+			return false;
+		}
+	}
+
+	uint32_t prewarmCount = 0;
+	if (!ReadValue(stream, prewarmCount) || prewarmCount > kMaxEntrySize / sizeof(uint64_t)) {
+		Clear();
+		return false;
+	}
+	prewarmKeys_.resize(prewarmCount);
+	for (auto& key : prewarmKeys_) {
+		if (!ReadValue(stream, key)) {
+			Clear();
+			return false;
+		}
+	}
+	return true;
+}
+
+void PipelineCacheStore::Write(std::ostream& stream) const {
+	WriteValue(stream, kMagic);
+	WriteValue(stream, kVersion);
+	WriteValue(stream, static_cast<uint32_t>(usedCount_));
+	for (auto& [key, entry] : entries_) {
+		if (!entry.isUsed) {
+			continue;
+		}
+		WriteValue(stream, key);
+		WriteValue(stream, static_cast<uint32_t>(entry.data.size()));
+		stream.write(reinterpret_cast<const char*>(entry.data.data()), entry.data.size());
+	}
+
+	WriteValue(stream, static_cast<uint32_t>(prewarmKeys_.size()));
+	for (uint64_t key : prewarmKeys_) {
+		WriteValue(stream, key);
+	}
+}
+
+bool PipelineCacheStore::Load(const std::string& filePath) {
+	std::ifstream file(filePath, std::ios::binary);
+	if (!file) {
+		Clear();
+		return false;
+	}
+	return Read(file);
+}
+
+bool PipelineCacheStore::Save(const std::string& filePath) const {
+	std::filesystem::path path(filePath);
+	if (path.has_parent_path()) {
+		std::error_code error;
+		std::filesystem::create_directories(path.parent_path(), error);
+	}
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		return false;
+	}
+	Write(file);
+	return static_cast<bool>(file);
+}
+
+void PipelineCacheStore::MarkUsed(Entry& entry) {
+	if (!entry.isUsed) {
+		entry.isUsed = true;
+		usedCount_++;
+	}
+}
@@ -0,0 +1,129 @@
+#pragma once
+#ifndef PIPELINECACHESTORE_H_
+#define PIPELINECACHESTORE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <d3d12.h>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// パイプラインとルートシグネチャの設定から求めたハッシュをキーに、バイナリを保存する
+/// ファイルには今回の実行で使ったものだけを書く(使われなくなったものは消える)
+/// 前回の実行で使ったパイプラインのキーも残し、次回の起動で先に作っておけるようにする
+/// D3D のデバイスに依存しない(生成は PipelineCache)
+/// </summary>
+class PipelineCacheStore
+{
+public:
+	// ファイルの先頭 "PSOC"
+	static constexpr uint32_t kMagic = 0x434F5350;
+	// 形式を変えたら上げる(古いファイルは読まない)
+	static constexpr uint32_t kVersion = 2;
+
+public:
+	/// <summary>
+	/// ルートシグネチャの設定のハッシュを求める
+	/// </summary>
+	/// <param name="desc">設定</param>
+	/// <returns></returns>
+	static uint64_t HashRootSignature(const D3D12_ROOT_SIGNATURE_DESC& desc);
+	/// <summary>
+	/// パイプラインの設定のハッシュを求める(シェーダーは中身、ルートシグネチャはそのハッシュ、CachedPSO は含めない)
+	/// </summary>
+	/// <param name="desc">設定</param>
+	/// <param name="rootSignatureHash">pRootSignature の HashRootSignature</param>
+	/// <returns></returns>
+	static uint64_t HashGraphicsPipeline(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, uint64_t rootSignatureHash);
+
+public:
+	/// <summary>
+	/// バイナリを探す(見つかったものは保存の対象になる)
+	/// </summary>
+	/// <param name="key">ハッシュ</param>
+	/// <returns>無ければ nullptr</returns>
+	const std::vector<uint8_t>* Find(uint64_t key);
+	/// <summary>
+	/// バイナリを追加か上書き
+	/// </summary>
+	/// <param name="key">ハッシュ</param>
+	/// <param name="data">データ</param>
+	/// <param name="size">バイト数</param>
+	void Store(uint64_t key, const void* data, size_t size);
+	/// <summary>
+	/// バイナリを取り除く
+	/// </summary>
+	/// <param name="key">ハッシュ</param>
+	void Remove(uint64_t key);
+	/// <summary>
+	/// 全て取り除く
+	/// </summary>
+	void Clear();
+	/// <summary>
+	/// 次回の起動で先に作るパイプラインのキーを設定
+	/// </summary>
+	/// <param name="keys">キー</param>
+	void SetPrewarmKeys(std::vector<uint64_t> keys);
+	/// <summary>
+	/// 前回の実行で使ったパイプラインのキーを取得
+	/// </summary>
+	/// <returns></returns>
+	inline const std::vector<uint64_t>& GetPrewarmKeys() const { return prewarmKeys_; }
+
+	/// <summary>
+	/// 読み込む(壊れていれば空にして false)
+	/// </summary>
+	/// <param name="stream">バイナリのストリーム</param>
+	/// <returns></returns>
+	bool Read(std::istream& stream);
+	/// <summary>
+	/// 今回使ったものを書き出す
+	/// </summary>
+	/// <param name="stream">バイナリのストリーム</param>
+	void Write(std::ostream& stream) const;
+	/// <summary>
+	/// ファイルから読み込む(無いか壊れていれば空にして false)
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	/// <returns></returns>
+	bool Load(const std::string& filePath);
+	/// <summary>
+	/// ファイルに書き出す(ディレクトリが無ければ作る)
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	/// <returns></returns>
+	bool Save(const std::string& filePath) const;
+
+	/// <summary>
+	/// 持っているバイナリの数を取得
+	/// </summary>
+	/// <returns></returns>
+	inline size_t GetEntryCount() const { return entries_.size(); }
+	/// <summary>
+	/// 書き出す内容が読み込んだときから変わったか
+	/// </summary>
+	/// <returns></returns>
+	inline bool IsDirty() const { return isModified_ || usedCount_ != entries_.size(); }
+
+private:
+	struct Entry {
+		std::vector<uint8_t> data;
+		// 今回の実行で使ったか
+		bool isUsed = false;
+	};
+
+	void MarkUsed(Entry& entry);
+
+private:
+	std::unordered_map<uint64_t, Entry> entries_;
+	std::vector<uint64_t> prewarmKeys_;
+	size_t usedCount_ = 0;
+	bool isModified_ = false;
+
+};
+
+#endif
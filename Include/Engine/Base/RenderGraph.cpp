@@ -0,0 +1,338 @@
+#include "RenderGraph.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace {
+	inline uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	inline bool IsWrite(uint32_t usage) {
+		return (usage & RenderGraph::kUsageWriteMask) != 0;
+	}
+
+	inline bool IsCombinableRead(uint32_t usage) {
+		return usage != RenderGraph::kUsageNone && (usage & ~RenderGraph::kUsageCombinableReadMask) == 0;
+	}
+}
+
+void RenderGraph::Reset() {
+	resources_.clear();
+	passes_.clear();
+	compiledPasses_.clear();
+	barriers_.clear();
+	finalBarrierOffset_ = 0;
+	splitBarriers_.clear();
+	std::fill(std::begin(heapSizes_), std::end(heapSizes_), uint64_t(0));
+	report_ = {};
+}
+
+RenderGraph::ResourceHandle RenderGraph::ImportTexture(const std::string& name, uint32_t initialUsage, uint32_t finalUsage) {
+	Resource& resource = resources_.emplace_back();
+	resource.name = name;
+	resource.isImported = true;
+	resource.initialUsage = initialUsage;
+	resource.finalUsage = finalUsage;
+	return static_cast<ResourceHandle>(resources_.size() - 1);
+}
+
+RenderGraph::ResourceHandle RenderGraph::CreateTexture(const std::string& name, const TextureDesc& desc) {
+	assert(desc.width > 0 && desc.height > 0);
+	Resource& resource = resources_.emplace_back();
+	resource.name = name;
+	resource.desc = desc;
+	return static_cast<ResourceHandle>(resources_.size() - 1);
+}
+
+void RenderGraph::AddPass(const std::string& name, std::initializer_list<Access> accesses, ExecuteFunction execute, bool hasSideEffect) {
+	Pass& pass = passes_.emplace_back();
+	pass.name = name;
+	pass.accesses.assign(accesses.begin(), accesses.end());
+	pass.execute = std::move(execute);
+	pass.hasSideEffect = hasSideEffect;
+#ifdef _DEBUG
+	for (auto& access : pass.accesses) {
+		assert(access.resource < resources_.size());
+		// 同じパスで書きながら別の使い方はできない
+		uint32_t usage = GetPassUsage(pass, access.resource);
+		assert(!IsWrite(usage) || (usage & (usage - 1)) == 0);
+	}
+#endif // _DEBUG
+}
+
+void RenderGraph::Compile(const AllocationInfoFunction& getAllocationInfo) {
+	compiledPasses_.clear();
+	barriers_.clear();
+	splitBarriers_.clear();
+	report_ = {};
+
+	CullPasses();
+	ComputeLifetimes();
+	AllocateTransients(getAllocationInfo);
+	ComputeBarriers();
+
+	report_.passCount = passes_.size();
+	report_.culledPassCount = passes_.size() - compiledPasses_.size();
+	report_.barrierCount = barriers_.size();
+	report_.splitBarrierCount = splitBarriers_.size();
+	for (auto& compiledPass : compiledPasses_) {
+		report_.barrierBatchCount += (compiledPass.barrierCount + compiledPass.splitBarrierCount) > 0 ? 1 : 0;
+	}
+	report_.barrierBatchCount += finalBarrierOffset_ < barriers_.size() ? 1 : 0;
+}
+
+void RenderGraph::CullPasses() {
+	// 取り込んだリソースは外から見える
+	std::vector<bool> isRequired(resources_.size(), false);
+	for (size_t i = 0; i < resources_.size(); i++) {
+		isRequired[i] = resources_[i].isImported;
+	}
+
+	// 後ろから、必要なリソースに書くパスを残し、そのパスが触るリソースを必要にする
+	std::vector<bool> isAlive(passes_.size(), false);
+	for (size_t i = passes_.size(); i-- > 0;) {
+		const Pass& pass = passes_[i];
+		bool alive = pass.hasSideEffect;
+		for (auto& access : pass.accesses) {
+			if (IsWrite(access.usage) && isRequired[access.resource]) {
+				alive = true;
+				break;
+			}
+		}
+		if (!alive) {
+			continue;
+		}
+		isAlive[i] = true;
+		for (auto& access : pass.accesses) {
+			isRequired[access.resource] = true;
+		}
+	}
+
+	for (uint32_t i = 0; i < passes_.size(); i++) {
+		if (isAlive[i]) {
+			compiledPasses_.push_back(CompiledPass{ i, 0, 0 });
+		}
+	}
+}
+
+void RenderGraph::ComputeLifetimes() {
+	for (auto& resource : resources_) {
+		resource.usages = kUsageNone;
+		resource.firstPass = UINT32_MAX;
+		resource.lastPass = 0;
+		resource.heapOffset = 0;
+		resource.allocation = {};
+		resource.isAliased = false;
+	}
+	for (uint32_t i = 0; i < compiledPasses_.size(); i++) {
+		for (auto& access : passes_[compiledPasses_[i].pass].accesses) {
+			Resource& resource = resources_[access.resource];
+			resource.usages |= access.usage;
+			resource.firstPass = std::min(resource.firstPass, i);
+			resource.lastPass = std::max(resource.lastPass, i);
+		}
+	}
+}
+
+void RenderGraph::ComputeBarriers() {
+	// フレーム開始時の使い方
+	std::vector<uint32_t> states(resources_.size(), kUsageNone);
+	for (size_t i = 0; i < resources_.size(); i++) {
+		states[i] = resources_[i].initialUsage;
+	}
+	// 最後に使ったパスの次の番号(フレーム内で未使用なら 0)
+	std::vector<uint32_t> splitBeginPasses(resources_.size(), 0);
+	// 分割バリアを始めるパスの番号と遷移
+	std::vector<std::pair<uint32_t, Barrier>> splits;
+	// 間にパスがあれば、前に使ったパスの後で始めて、使うパスの前で終える
+	auto pushTransition = [&](uint32_t passIndex, ResourceHandle handle, uint32_t before, uint32_t after) {
+		Barrier barrier{ Barrier::kTypeTransition, handle, before, after };
+		barrier.isSplit = splitBeginPasses[handle] < passIndex;
+		if (barrier.isSplit) {
+			splits.emplace_back(splitBeginPasses[handle], barrier);
+		}
+		barriers_.push_back(barrier);
+		};
+
+	for (uint32_t i = 0; i < compiledPasses_.size(); i++) {
+		CompiledPass& compiledPass = compiledPasses_[i];
+		const Pass& pass = passes_[compiledPass.pass];
+		compiledPass.barrierOffset = static_cast<uint32_t>(barriers_.size());
+
+		for (size_t a = 0; a < pass.accesses.size(); a++) {
+			ResourceHandle handle = pass.accesses[a].resource;
+			// 同じリソースへのアクセスは最初の一つでまとめて扱う
+			bool isFirstAccess = true;
+			for (size_t b = 0; b < a; b++) {
+				isFirstAccess &= pass.accesses[b].resource != handle;
+			}
+			if (!isFirstAccess) {
+				continue;
+			}
+
+			Resource& resource = resources_[handle];
+			uint32_t usage = GetPassUsage(pass, handle);
+			uint32_t& state = states[handle];
+
+			// 読み込みが続く間は一度の遷移で済むように先の読み込みもまとめる
+			if (IsCombinableRead(usage) && !(IsCombinableRead(state) && (state & usage) == usage)) {
+				for (uint32_t next = i + 1; next < compiledPasses_.size(); next++) {
+					uint32_t nextUsage = GetPassUsage(passes_[compiledPasses_[next].pass], handle);
+					if (nextUsage == kUsageNone) {
+						continue;
+					}
+					if (!IsCombinableRead(nextUsage)) {
+						break;
+					}
+					usage |= nextUsage;
+				}
+			}
+
+			if (!resource.isImported && resource.firstPass == i) {
+				// 一時リソースは最初の使い方で生成する
+				resource.initialUsage = usage;
+				resource.finalUsage = usage;
+				state = usage;
+				if (resource.isAliased) {
+					barriers_.push_back(Barrier{ Barrier::kTypeAliasing, handle });
+				}
+				splitBeginPasses[handle] = i + 1;
+				continue;
+			}
+
+			if (state == usage || (IsCombinableRead(state) && (state & usage) == usage)) {
+				// 書き込みが続く場合は順序だけ保証する
+				if (usage == kUsageUnorderedAccess) {
+					barriers_.push_back(Barrier{ Barrier::kTypeUnorderedAccess, handle });
+				}
+				splitBeginPasses[handle] = i + 1;
+				continue;
+			}
+			pushTransition(i, handle, state, usage);
+			state = usage;
+			splitBeginPasses[handle] = i + 1;
+		}
+
+		compiledPass.barrierCount = static_cast<uint32_t>(barriers_.size()) - compiledPass.barrierOffset;
+	}
+
+	// フレーム終了時の使い方に戻す(一時リソースは次のフレームのために生成時の使い方へ)
+	finalBarrierOffset_ = static_cast<uint32_t>(barriers_.size());
+	for (ResourceHandle handle = 0; handle < resources_.size(); handle++) {
+		const Resource& resource = resources_[handle];
+		if (!resource.isImported && !resource.IsUsed()) {
+			continue;
+		}
+		if (states[handle] != resource.finalUsage) {
+			pushTransition(static_cast<uint32_t>(compiledPasses_.size()), handle, states[handle], resource.finalUsage);
+		}
+	}
+
+	// 始めるパスの順に並べる(始めるのは必ず使うパスより前)
+	std::stable_sort(splits.begin(), splits.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+	size_t splitIndex = 0;
+	for (uint32_t i = 0; i < compiledPasses_.size(); i++) {
+		CompiledPass& compiledPass = compiledPasses_[i];
+		compiledPass.splitBarrierOffset = static_cast<uint32_t>(splitBarriers_.size());
+		for (; splitIndex < splits.size() && splits[splitIndex].first == i; splitIndex++) {
+			splitBarriers_.push_back(splits[splitIndex].second);
+		}
+		compiledPass.splitBarrierCount = static_cast<uint32_t>(splitBarriers_.size()) - compiledPass.splitBarrierOffset;
+	}
+	assert(splitIndex == splits.size());
+}
+
+void RenderGraph::AllocateTransients(const AllocationInfoFunction& getAllocationInfo) {
+	std::fill(std::begin(heapSizes_), std::end(heapSizes_), uint64_t(0));
+
+	std::vector<ResourceHandle> transients;
+	for (ResourceHandle handle = 0; handle < resources_.size(); handle++) {
+		Resource& resource = resources_[handle];
+		if (resource.isImported || !resource.IsUsed()) {
+			continue;
+		}
+		resource.heapType = (resource.usages & (kUsageRenderTarget | kUsageDepthWrite | kUsageDepthRead)) ?
+			kHeapTypeRenderTarget : kHeapTypeTexture;
+		resource.allocation = getAllocationInfo(resource.desc, resource.usages);
+		assert(resource.allocation.alignment > 0 && (resource.allocation.alignment & (resource.allocation.alignment - 1)) == 0);
+		report_.unaliasedBytes += AlignUp(resource.allocation.size, resource.allocation.alignment);
+		transients.push_back(handle);
+	}
+	report_.transientCount = transients.size();
+
+	// 大きい順に、寿命が重なるものと重ならない一番低い位置に置く
+	std::stable_sort(transients.begin(), transients.end(), [&](ResourceHandle a, ResourceHandle b) {
+		return resources_[a].allocation.size > resources_[b].allocation.size;
+		});
+
+	auto isLifetimeOverlapped = [](const Resource& a, const Resource& b) {
+		return a.firstPass <= b.lastPass && b.firstPass <= a.lastPass;
+		};
+	auto isMemoryOverlapped = [](uint64_t offset, uint64_t size, const Resource& other) {
+		return offset < other.heapOffset + other.allocation.size && other.heapOffset < offset + size;
+		};
+
+	std::vector<ResourceHandle> placed;
+	std::vector<uint64_t> candidates;
+	for (ResourceHandle handle : transients) {
+		Resource& resource = resources_[handle];
+		uint64_t size = resource.allocation.size;
+		uint64_t alignment = resource.allocation.alignment;
+
+		candidates.assign(1, 0);
+		for (ResourceHandle other : placed) {
+			const Resource& otherResource = resources_[other];
+			if (otherResource.heapType == resource.heapType && isLifetimeOverlapped(resource, otherResource)) {
+				candidates.push_back(AlignUp(otherResource.heapOffset + otherResource.allocation.size, alignment));
+			}
+		}
+		std::sort(candidates.begin(), candidates.end());
+
+		for (uint64_t offset : candidates) {
+			bool isFree = true;
+			for (ResourceHandle other : placed) {
+				const Resource& otherResource = resources_[other];
+				if (otherResource.heapType == resource.heapType &&
+					isLifetimeOverlapped(resource, otherResource) &&
+					isMemoryOverlapped(offset, size, otherResource)) {
+					isFree = false;
+					break;
+				}
+			}
+			if (isFree) {
+				resource.heapOffset = offset;
+				break;
+			}
+		}
+		heapSizes_[resource.heapType] = std::max(heapSizes_[resource.heapType], resource.heapOffset + size);
+		placed.push_back(handle);
+	}
+
+	// メモリを共有するリソースは使い始めに切り替えのバリアが要る
+	for (size_t i = 0; i < placed.size(); i++) {
+		Resource& a = resources_[placed[i]];
+		for (size_t j = i + 1; j < placed.size(); j++) {
+			Resource& b = resources_[placed[j]];
+			if (a.heapType == b.heapType && isMemoryOverlapped(a.heapOffset, a.allocation.size, b)) {
+				a.isAliased = true;
+				b.isAliased = true;
+			}
+		}
+	}
+
+	for (uint64_t heapSize : heapSizes_) {
+		report_.heapBytes += heapSize;
+	}
+}
+
+uint32_t RenderGraph::GetPassUsage(const Pass& pass, ResourceHandle resource) const {
+	uint32_t usage = kUsageNone;
+	for (auto& access : pass.accesses) {
+		if (access.resource == resource) {
+			usage |= access.usage;
+		}
+	}
+	return usage;
+}
@@ -0,0 +1,312 @@
+#pragma once
+#ifndef RENDERGRAPH_H_
+#define RENDERGRAPH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <vector>
+
+class RenderGraphExecutor;
+
+/// <summary>
+/// パスが名前付きのリソースの読み書きを宣言し、Compile でフレームの実行順を決める
+/// 出力に関係しないパスの除外、まとめたバリアの計算、寿命が重ならない一時リソースのメモリ共有を行う
+/// D3D に依存しない(リソースの生成と記録は RenderGraphExecutor)
+/// </summary>
+class RenderGraph
+{
+public:
+	using ResourceHandle = uint32_t;
+	// パスの記録(Compile で残ったパスだけ呼ばれる)
+	using ExecuteFunction = std::function<void(RenderGraphExecutor& executor)>;
+
+	/// <summary>
+	/// リソースの使い方(組み合わせは読み込み同士のみ)
+	/// </summary>
+	enum Usage : uint32_t {
+		kUsageNone = 0,
+		kUsageRenderTarget = 1 << 0,
+		kUsageDepthWrite = 1 << 1,
+		kUsageDepthRead = 1 << 2,
+		kUsageShaderResource = 1 << 3,
+		kUsageUnorderedAccess = 1 << 4,
+		kUsageCopySource = 1 << 5,
+		kUsageCopyDest = 1 << 6,
+		kUsagePresent = 1 << 7,
+
+		// 書き込み
+		kUsageWriteMask = kUsageRenderTarget | kUsageDepthWrite | kUsageUnorderedAccess | kUsageCopyDest,
+		// 同時に取れる読み込み
+		kUsageCombinableReadMask = kUsageDepthRead | kUsageShaderResource | kUsageCopySource,
+	};
+
+	/// <summary>
+	/// 一時リソースを置くヒープの種類
+	/// </summary>
+	enum HeapType : uint32_t {
+		kHeapTypeRenderTarget,	// レンダーターゲット、深度
+		kHeapTypeTexture,		// それ以外のテクスチャ
+
+		kHeapTypeCount
+	};
+
+	/// <summary>
+	/// 一時テクスチャの設定
+	/// </summary>
+	struct TextureDesc {
+		uint32_t width = 0;
+		uint32_t height = 0;
+		// DXGI_FORMAT の値
+		uint32_t format = 0;
+		// レンダーターゲットのクリア値
+		float clearColor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		// 深度のクリア値
+		float clearDepth = 1.0f;
+	};
+
+	/// <summary>
+	/// GPU 上の大きさ
+	/// </summary>
+	struct AllocationInfo {
+		uint64_t size = 0;
+		// 配置境界(2の累乗)
+		uint64_t alignment = 0;
+	};
+	// 設定と使い方の組み合わせから GPU 上の大きさを求める
+	using AllocationInfoFunction = std::function<AllocationInfo(const TextureDesc& desc, uint32_t usages)>;
+
+	/// <summary>
+	/// パスからリソースへのアクセス
+	/// </summary>
+	struct Access {
+		ResourceHandle resource;
+		Usage usage;
+	};
+
+	/// <summary>
+	/// バリア
+	/// </summary>
+	struct Barrier {
+		enum Type : uint32_t {
+			kTypeTransition,
+			// 同じメモリを使う別のリソースから切り替える
+			kTypeAliasing,
+			// 書き込み同士の順序を保証する
+			kTypeUnorderedAccess,
+		};
+		Type type = kTypeTransition;
+		ResourceHandle resource = kInvalidResource;
+		// 遷移前の使い方(kTypeTransition のみ)
+		uint32_t before = kUsageNone;
+		// 遷移後の使い方(kTypeTransition のみ)
+		uint32_t after = kUsageNone;
+		// 前のパスの後に始めた分割バリアを終えるか(kTypeTransition のみ)
+		bool isSplit = false;
+	};
+
+	/// <summary>
+	/// リソース
+	/// </summary>
+	struct Resource {
+		std::string name;
+		bool isImported = false;
+		TextureDesc desc;
+		// フレーム開始時の使い方(一時リソースは最初のパスの使い方で生成する)
+		uint32_t initialUsage = kUsageNone;
+		// フレーム終了時の使い方
+		uint32_t finalUsage = kUsageNone;
+
+		// 以下 Compile の結果
+		// 残ったパスでの使い方の和
+		uint32_t usages = kUsageNone;
+		// 最初と最後に使う Compile 後のパス番号
+		uint32_t firstPass = UINT32_MAX;
+		uint32_t lastPass = 0;
+		// ヒープ上の位置(一時リソースのみ)
+		HeapType heapType = kHeapTypeTexture;
+		uint64_t heapOffset = 0;
+		AllocationInfo allocation;
+		// 他の一時リソースとメモリを共有するか
+		bool isAliased = false;
+
+		// 残ったパスで使われるか
+		inline bool IsUsed() const { return firstPass != UINT32_MAX; }
+	};
+
+	/// <summary>
+	/// パス
+	/// </summary>
+	struct Pass {
+		std::string name;
+		std::vector<Access> accesses;
+		ExecuteFunction execute;
+		// 出力に関係しなくても残す
+		bool hasSideEffect = false;
+	};
+
+	/// <summary>
+	/// Compile 後のパス
+	/// </summary>
+	struct CompiledPass {
+		uint32_t pass = 0;
+		// パスの前にまとめて発行するバリアの範囲
+		uint32_t barrierOffset = 0;
+		uint32_t barrierCount = 0;
+		// パスの前に始める分割バリア(後のパスの前で終える)の範囲
+		uint32_t splitBarrierOffset = 0;
+		uint32_t splitBarrierCount = 0;
+	};
+
+	/// <summary>
+	/// Compile の結果
+	/// </summary>
+	struct Report {
+		size_t passCount = 0;
+		size_t culledPassCount = 0;
+		size_t barrierCount = 0;
+		// ResourceBarrier の呼び出し回数
+		size_t barrierBatchCount = 0;
+		// 分割した遷移
+		size_t splitBarrierCount = 0;
+		size_t transientCount = 0;
+		// 一時リソースを個別に確保した場合のバイト数
+		uint64_t unaliasedBytes = 0;
+		// 共有したヒープのバイト数
+		uint64_t heapBytes = 0;
+
+		inline uint64_t GetSavedBytes() const { return unaliasedBytes - heapBytes; }
+	};
+
+	static constexpr ResourceHandle kInvalidResource = UINT32_MAX;
+
+public:
+	/// <summary>
+	/// 空にする(毎フレーム作り直す)
+	/// </summary>
+	void Reset();
+	/// <summary>
+	/// 外部のリソースを取り込む
+	/// </summary>
+	/// <param name="name">名前</param>
+	/// <param name="initialUsage">フレーム開始時の使い方</param>
+	/// <param name="finalUsage">フレーム終了時に戻す使い方</param>
+	/// <returns></returns>
+	ResourceHandle ImportTexture(const std::string& name, uint32_t initialUsage, uint32_t finalUsage);
+	/// <summary>
+	/// 一時テクスチャを作る(フレーム内でのみ有効、寿命が重ならない一時リソースとメモリを共有する)
+	/// </summary>
+	/// <param name="name">名前</param>
+	/// <param name="desc">設定</param>
+	/// <returns></returns>
+	ResourceHandle CreateTexture(const std::string& name, const TextureDesc& desc);
+	/// <summary>
+	/// パスを追加
+	/// </summary>
+	/// <param name="name">名前</param>
+	/// <param name="accesses">読み書きするリソース</param>
+	/// <param name="execute">記録</param>
+	/// <param name="hasSideEffect">取り込んだリソースに書かなくても残すか</param>
+	void AddPass(const std::string& name, std::initializer_list<Access> accesses, ExecuteFunction execute, bool hasSideEffect = false);
+	/// <summary>
+	/// パスの除外、バリア、メモリの配置を決める
+	/// </summary>
+	/// <param name="getAllocationInfo">GPU 上の大きさを求める関数</param>
+	void Compile(const AllocationInfoFunction& getAllocationInfo);
+
+	/// <summary>
+	/// リソースを取得
+	/// </summary>
+	/// <param name="handle">ハンドル</param>
+	/// <returns></returns>
+	inline const Resource& GetResource(ResourceHandle handle) const { return resources_[handle]; }
+	/// <summary>
+	/// リソースの一覧を取得
+	/// </summary>
+	/// <returns></returns>
+	inline std::span<const Resource> GetResources() const { return resources_; }
+	/// <summary>
+	/// パスを取得
+	/// </summary>
+	/// <param name="index">追加した順の番号</param>
+	/// <returns></returns>
+	inline const Pass& GetPass(uint32_t index) const { return passes_[index]; }
+	/// <summary>
+	/// 残ったパスを実行順に取得
+	/// </summary>
+	/// <returns></returns>
+	inline std::span<const CompiledPass> GetCompiledPasses() const { return compiledPasses_; }
+	/// <summary>
+	/// パスの前のバリアを取得
+	/// </summary>
+	/// <param name="compiledPass">Compile 後のパス</param>
+	/// <returns></returns>
+	inline std::span<const Barrier> GetBarriers(const CompiledPass& compiledPass) const {
+		return std::span<const Barrier>(barriers_).subspan(compiledPass.barrierOffset, compiledPass.barrierCount);
+	}
+	/// <summary>
+	/// 全てのパスの後のバリアを取得
+	/// </summary>
+	/// <returns></returns>
+	inline std::span<const Barrier> GetFinalBarriers() const {
+		return std::span<const Barrier>(barriers_).subspan(finalBarrierOffset_);
+	}
+	/// <summary>
+	/// パスの前に始める分割バリアを取得
+	/// </summary>
+	/// <param name="compiledPass">Compile 後のパス</param>
+	/// <returns></returns>
+	inline std::span<const Barrier> GetSplitBarriers(const CompiledPass& compiledPass) const {
+		return std::span<const Barrier>(splitBarriers_).subspan(compiledPass.splitBarrierOffset, compiledPass.splitBarrierCount);
+	}
+	/// <summary>
+	/// ヒープの大きさを取得
+	/// </summary>
+	/// <param name="heapType">種類</param>
+	/// <returns></returns>
+	inline uint64_t GetHeapSize(HeapType heapType) const { return heapSizes_[heapType]; }
+	/// <summary>
+	/// Compile の結果を取得
+	/// </summary>
+	/// <returns></returns>
+	inline const Report& GetReport() const { return report_; }
+
+private:
+	/// <summary>
+	/// 出力に関係しないパスを除き、実行順を決める
+	/// </summary>
+	void CullPasses();
+	/// <summary>
+	/// リソースの寿命と使い方を集める
+	/// </summary>
+	void ComputeLifetimes();
+	/// <summary>
+	/// バリアを計算
+	/// </summary>
+	void ComputeBarriers();
+	/// <summary>
+	/// 一時リソースをヒープに配置
+	/// </summary>
+	void AllocateTransients(const AllocationInfoFunction& getAllocationInfo);
+	/// <summary>
+	/// パスでのリソースの使い方を取得(同じリソースへの複数のアクセスはまとめる)
+	/// </summary>
+	uint32_t GetPassUsage(const Pass& pass, ResourceHandle resource) const;
+
+private:
+	std::vector<Resource> resources_;
+	std::vector<Pass> passes_;
+
+	std::vector<CompiledPass> compiledPasses_;
+	std::vector<Barrier> barriers_;
+	uint32_t finalBarrierOffset_ = 0;
+	std::vector<Barrier> splitBarriers_;
+	uint64_t heapSizes_[kHeapTypeCount] = {};
+	Report report_;
+
+};
+
+#endif
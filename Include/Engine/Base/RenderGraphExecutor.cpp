@@ -0,0 +1,249 @@
+#include "RenderGraphExecutor.h"
+
+#include <cassert>
+#include <d3dx12.h>
+
+D3D12_RESOURCE_STATES RenderGraphExecutor::ToResourceState(uint32_t usages) {
+	D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_COMMON;
+	if (usages & RenderGraph::kUsageRenderTarget) { state |= D3D12_RESOURCE_STATE_RENDER_TARGET; }
+	if (usages & RenderGraph::kUsageDepthWrite) { state |= D3D12_RESOURCE_STATE_DEPTH_WRITE; }
+	if (usages & RenderGraph::kUsageDepthRead) { state |= D3D12_RESOURCE_STATE_DEPTH_READ; }
+	if (usages & RenderGraph::kUsageShaderResource) {
+		state |= D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+	}
+	if (usages & RenderGraph::kUsageUnorderedAccess) { state |= D3D12_RESOURCE_STATE_UNORDERED_ACCESS; }
+	if (usages & RenderGraph::kUsageCopySource) { state |= D3D12_RESOURCE_STATE_COPY_SOURCE; }
+	if (usages & RenderGraph::kUsageCopyDest) { state |= D3D12_RESOURCE_STATE_COPY_DEST; }
+	// kUsagePresent は D3D12_RESOURCE_STATE_PRESENT(COMMON)
+	return state;
+}
+
+void RenderGraphExecutor::Initalize(ID3D12Device* device, ResourceStateTracker* stateTracker,
+	StagingDescriptorAllocator* rtvAllocator, StagingDescriptorAllocator* dsvAllocator) {
+	assert(device != nullptr);
+	assert(stateTracker != nullptr);
+	assert(rtvAllocator != nullptr && dsvAllocator != nullptr);
+	device_ = device;
+	stateTracker_ = stateTracker;
+	rtvAllocator_ = rtvAllocator;
+	dsvAllocator_ = dsvAllocator;
+}
+
+void RenderGraphExecutor::BindTexture(RenderGraph::ResourceHandle handle, ID3D12Resource* resource, D3D12_CPU_DESCRIPTOR_HANDLE view) {
+	if (bindings_.size() <= handle) {
+		bindings_.resize(handle + 1);
+	}
+	bindings_[handle] = Binding{ resource, view };
+}
+
+void RenderGraphExecutor::Compile(RenderGraph& graph) {
+	graph.Compile([this](const RenderGraph::TextureDesc& desc, uint32_t usages) {
+		D3D12_RESOURCE_DESC resourceDesc = ToResourceDesc(desc, usages);
+		D3D12_RESOURCE_ALLOCATION_INFO info = device_->GetResourceAllocationInfo(0, 1, &resourceDesc);
+		return RenderGraph::AllocationInfo{ info.SizeInBytes, info.Alignment };
+		});
+
+	bindings_.resize(graph.GetResources().size());
+
+	// 前のフレームと同じ配置なら使い回す
+	bool isSame = true;
+	size_t transientIndex = 0;
+	auto resources = graph.GetResources();
+	for (auto& resource : resources) {
+		if (resource.isImported || !resource.IsUsed()) {
+			continue;
+		}
+		if (transientIndex >= transients_.size() || !IsSameTransient(transients_[transientIndex], resource)) {
+			isSame = false;
+			break;
+		}
+		transientIndex++;
+	}
+	if (!isSame || transientIndex != transients_.size()) {
+		CreateTransients(graph);
+	}
+
+	transientIndex = 0;
+	for (RenderGraph::ResourceHandle handle = 0; handle < resources.size(); handle++) {
+		if (resources[handle].isImported || !resources[handle].IsUsed()) {
+			continue;
+		}
+		Transient& transient = transients_[transientIndex++];
+		bindings_[handle] = Binding{ transient.resource.Get(), transient.view.GetCpuHandle() };
+	}
+}
+
+void RenderGraphExecutor::Execute(const RenderGraph& graph, TrackedCommandList* cmdList) {
+	assert(cmdList != nullptr);
+	cmdList_ = cmdList;
+
+	for (auto& compiledPass : graph.GetCompiledPasses()) {
+		auto barriers = graph.GetBarriers(compiledPass);
+		RecordBarriers(barriers, graph.GetSplitBarriers(compiledPass));
+		// 他のリソースと共有するメモリの内容は不定なので捨てておく(パス内でクリアする)
+		for (auto& barrier : barriers) {
+			if (barrier.type != RenderGraph::Barrier::kTypeAliasing) {
+				continue;
+			}
+			if (graph.GetResource(barrier.resource).initialUsage & (RenderGraph::kUsageRenderTarget | RenderGraph::kUsageDepthWrite)) {
+				cmdList_->Get()->DiscardResource(GetResource(barrier.resource), nullptr);
+			}
+		}
+
+		auto& pass = graph.GetPass(compiledPass.pass);
+		if (pass.execute) {
+			pass.execute(*this);
+		}
+	}
+	RecordBarriers(graph.GetFinalBarriers(), {});
+}
+
+void RenderGraphExecutor::FinishFrame(uint64_t fenceValue) {
+	if (frameReleasedTransients_.empty() && frameReleasedHeaps_.empty()) {
+		return;
+	}
+	pendingReleases_.push_back(PendingRelease{ fenceValue, std::move(frameReleasedTransients_), std::move(frameReleasedHeaps_) });
+	frameReleasedTransients_.clear();
+	frameReleasedHeaps_.clear();
+}
+
+void RenderGraphExecutor::Release(uint64_t completedFenceValue) {
+	while (!pendingReleases_.empty() && pendingReleases_.front().fenceValue <= completedFenceValue) {
+		for (auto& transient : pendingReleases_.front().transients) {
+			if (transient.usages & RenderGraph::kUsageRenderTarget) {
+				rtvAllocator_->Free(transient.view);
+			}
+			else {
+				dsvAllocator_->Free(transient.view);
+			}
+		}
+		pendingReleases_.pop_front();
+	}
+}
+
+D3D12_RESOURCE_DESC RenderGraphExecutor::ToResourceDesc(const RenderGraph::TextureDesc& desc, uint32_t usages) {
+	D3D12_RESOURCE_FLAGS flags = D3D12_RESOURCE_FLAG_NONE;
+	if (usages & RenderGraph::kUsageRenderTarget) {
+		flags |= D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+	}
+	if (usages & (RenderGraph::kUsageDepthWrite | RenderGraph::kUsageDepthRead)) {
+		flags |= D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+	}
+	if (usages & RenderGraph::kUsageUnorderedAccess) {
+		flags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+	}
+	return CD3DX12_RESOURCE_DESC::Tex2D(
+		static_cast<DXGI_FORMAT>(desc.format), desc.width, desc.height, 1, 1, 1, 0, flags);
+}
+
+bool RenderGraphExecutor::IsSameTransient(const Transient& transient, const RenderGraph::Resource& resource) {
+	const RenderGraph::TextureDesc& a = transient.desc;
+	const RenderGraph::TextureDesc& b = resource.desc;
+	return
+		a.width == b.width && a.height == b.height && a.format == b.format &&
+		a.clearColor[0] == b.clearColor[0] && a.clearColor[1] == b.clearColor[1] &&
+		a.clearColor[2] == b.clearColor[2] && a.clearColor[3] == b.clearColor[3] &&
+		a.clearDepth == b.clearDepth &&
+		transient.usages == resource.usages &&
+		transient.initialUsage == resource.initialUsage &&
+		transient.heapType == resource.heapType &&
+		transient.heapOffset == resource.heapOffset;
+}
+
+void RenderGraphExecutor::CreateTransients(const RenderGraph& graph) {
+	HRESULT result = S_FALSE;
+	// 先行しているフレームが古いリソースを使っているので、解放はそのフレームを GPU が終えてから
+	for (auto& transient : transients_) {
+		stateTracker_->Unregister(transient.resource.Get());
+		frameReleasedTransients_.push_back(std::move(transient));
+	}
+	transients_.clear();
+
+	// ヒープは足りない場合だけ大きくする
+	for (uint32_t i = 0; i < RenderGraph::kHeapTypeCount; i++) {
+		auto heapType = static_cast<RenderGraph::HeapType>(i);
+		uint64_t size = graph.GetHeapSize(heapType);
+		if (size == 0 || (heaps_[i] && heaps_[i]->GetDesc().SizeInBytes >= size)) {
+			continue;
+		}
+		D3D12_HEAP_DESC heapDesc = {};
+		heapDesc.SizeInBytes = (size + D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT - 1) & ~uint64_t(D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT - 1);
+		heapDesc.Properties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+		heapDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+		heapDesc.Flags = heapType == RenderGraph::kHeapTypeRenderTarget ?
+			D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES : D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+		if (heaps_[i]) {
+			frameReleasedHeaps_.push_back(std::move(heaps_[i]));
+		}
+		result = device_->CreateHeap(&heapDesc, IID_PPV_ARGS(&heaps_[i]));
+		assert(SUCCEEDED(result));
+	}
+
+	for (auto& resource : graph.GetResources()) {
+		if (resource.isImported || !resource.IsUsed()) {
+			continue;
+		}
+		Transient& transient = transients_.emplace_back();
+		transient.desc = resource.desc;
+		transient.usages = resource.usages;
+		transient.initialUsage = resource.initialUsage;
+		transient.heapType = resource.heapType;
+		transient.heapOffset = resource.heapOffset;
+
+		DXGI_FORMAT format = static_cast<DXGI_FORMAT>(resource.desc.format);
+		D3D12_RESOURCE_DESC resourceDesc = ToResourceDesc(resource.desc, resource.usages);
+		D3D12_CLEAR_VALUE clearValue = {};
+		const D3D12_CLEAR_VALUE* optimizedClearValue = nullptr;
+		if (resource.usages & RenderGraph::kUsageRenderTarget) {
+			clearValue = CD3DX12_CLEAR_VALUE(format, resource.desc.clearColor);
+			optimizedClearValue = &clearValue;
+		}
+		else if (resource.usages & (RenderGraph::kUsageDepthWrite | RenderGraph::kUsageDepthRead)) {
+			clearValue = CD3DX12_CLEAR_VALUE(format, resource.desc.clearDepth, 0);
+			optimizedClearValue = &clearValue;
+		}
+		result = device_->CreatePlacedResource(
+			heaps_[resource.heapType].Get(), resource.heapOffset, &resourceDesc,
+			ToResourceState(resource.initialUsage), optimizedClearValue, IID_PPV_ARGS(&transient.resource));
+		assert(SUCCEEDED(result));
+		stateTracker_->Register(transient.resource.Get(), ToResourceState(resource.initialUsage));
+
+		// レンダーターゲットか深度のビュー
+		if (resource.usages & RenderGraph::kUsageRenderTarget) {
+			transient.view = rtvAllocator_->Allocate();
+			device_->CreateRenderTargetView(transient.resource.Get(), nullptr, transient.view.GetCpuHandle());
+		}
+		else if (resource.usages & (RenderGraph::kUsageDepthWrite | RenderGraph::kUsageDepthRead)) {
+			transient.view = dsvAllocator_->Allocate();
+			D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc = {};
+			dsvDesc.Format = format;
+			dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
+			device_->CreateDepthStencilView(transient.resource.Get(), &dsvDesc, transient.view.GetCpuHandle());
+		}
+	}
+}
+
+void RenderGraphExecutor::RecordBarriers(std::span<const RenderGraph::Barrier> barriers, std::span<const RenderGraph::Barrier> splitBarriers) {
+	for (auto& barrier : barriers) {
+		ID3D12Resource* resource = GetResource(barrier.resource);
+		assert(resource != nullptr);
+		switch (barrier.type) {
+		case RenderGraph::Barrier::kTypeTransition:
+			// 分割バリアを終える場合は始めたときに状態が変わっている
+			assert(barrier.isSplit || stateTracker_->GetState(resource) == ToResourceState(barrier.before));
+			stateTracker_->Transition(resource, ToResourceState(barrier.after));
+			break;
+		case RenderGraph::Barrier::kTypeAliasing:
+			stateTracker_->Aliasing(nullptr, resource);
+			break;
+		case RenderGraph::Barrier::kTypeUnorderedAccess:
+			stateTracker_->UnorderedAccess(resource);
+			break;
+		}
+	}
+	// 後のパスで使うリソースの遷移を今から始めておく
+	for (auto& barrier : splitBarriers) {
+		stateTracker_->BeginTransition(GetResource(barrier.resource), ToResourceState(barrier.after));
+	}
+	cmdList_->FlushResourceBarriers();
+}
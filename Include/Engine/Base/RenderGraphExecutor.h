@@ -0,0 +1,154 @@
+#pragma once
+#ifndef RENDERGRAPHEXECUTOR_H_
+#define RENDERGRAPHEXECUTOR_H_
+
+#include <cstdint>
+#include <d3d12.h>
+#include <deque>
+#include <vector>
+#include <wrl.h>
+
+#include "DescriptorAllocator.h"
+#include "RenderGraph.h"
+#include "TrackedCommandList.h"
+
+/// <summary>
+/// RenderGraph の一時リソースをヒープ上に配置し、バリアとパスを記録する
+/// 配置が前のフレームと同じならリソースを使い回す
+/// 作り直した場合の古いリソースは FinishFrame で渡したフェンス値を GPU が通過するまで残す
+/// バリアは ResourceStateTracker を通して発行する(取り込むリソースは登録しておく)
+/// </summary>
+class RenderGraphExecutor
+{
+private:
+	template<class TYPE>
+	using ComPtr = Microsoft::WRL::ComPtr<TYPE>;
+
+public:
+	/// <summary>
+	/// 使い方をリソースの状態に変換
+	/// </summary>
+	/// <param name="usages">RenderGraph::Usage の組み合わせ</param>
+	/// <returns></returns>
+	static D3D12_RESOURCE_STATES ToResourceState(uint32_t usages);
+
+public:
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="device">デバイス</param>
+	/// <param name="stateTracker">記録するコマンドリストのリソースの状態</param>
+	/// <param name="rtvAllocator">一時リソースのレンダーターゲットビューの割り当て</param>
+	/// <param name="dsvAllocator">一時リソースの深度ステンシルビューの割り当て</param>
+	void Initalize(ID3D12Device* device, ResourceStateTracker* stateTracker,
+		StagingDescriptorAllocator* rtvAllocator, StagingDescriptorAllocator* dsvAllocator);
+	/// <summary>
+	/// 取り込んだリソースを結び付ける(Compile の前に毎フレーム呼ぶ)
+	/// </summary>
+	/// <param name="handle">ImportTexture のハンドル</param>
+	/// <param name="resource">リソース</param>
+	/// <param name="view">レンダーターゲットか深度のビュー</param>
+	void BindTexture(RenderGraph::ResourceHandle handle, ID3D12Resource* resource, D3D12_CPU_DESCRIPTOR_HANDLE view);
+	/// <summary>
+	/// グラフを Compile し、一時リソースを用意する
+	/// 配置が変わった場合は作り直す(GPU は待たない。古いリソースは Release まで残す)
+	/// </summary>
+	/// <param name="graph">グラフ</param>
+	void Compile(RenderGraph& graph);
+	/// <summary>
+	/// 残ったパスをバリアと共に記録
+	/// </summary>
+	/// <param name="graph">Compile 済みのグラフ</param>
+	/// <param name="cmdList">コマンドリスト</param>
+	void Execute(const RenderGraph& graph, TrackedCommandList* cmdList);
+	/// <summary>
+	/// フレームを終える(このフレームで作り直した古いリソースにフェンス値を付ける)
+	/// </summary>
+	/// <param name="fenceValue">このフレームのコマンドの完了を示すフェンス値</param>
+	void FinishFrame(uint64_t fenceValue);
+	/// <summary>
+	/// 完了したフレームが使っていた古いリソースを解放する
+	/// </summary>
+	/// <param name="completedFenceValue">GPU が通過したフェンス値</param>
+	void Release(uint64_t completedFenceValue);
+
+	/// <summary>
+	/// 記録中のコマンドリストを取得
+	/// </summary>
+	/// <returns></returns>
+	inline TrackedCommandList* GetCommandList() const { return cmdList_; }
+	/// <summary>
+	/// リソースを取得
+	/// </summary>
+	/// <param name="handle">ハンドル</param>
+	/// <returns></returns>
+	inline ID3D12Resource* GetResource(RenderGraph::ResourceHandle handle) const { return bindings_[handle].resource; }
+	/// <summary>
+	/// レンダーターゲットか深度のビューを取得
+	/// </summary>
+	/// <param name="handle">ハンドル</param>
+	/// <returns></returns>
+	inline D3D12_CPU_DESCRIPTOR_HANDLE GetView(RenderGraph::ResourceHandle handle) const { return bindings_[handle].view; }
+
+private:
+	// リソースとビュー
+	struct Binding {
+		ID3D12Resource* resource = nullptr;
+		D3D12_CPU_DESCRIPTOR_HANDLE view = {};
+	};
+
+	// 生成済みの一時リソース
+	struct Transient {
+		RenderGraph::TextureDesc desc;
+		uint32_t usages = 0;
+		uint32_t initialUsage = 0;
+		RenderGraph::HeapType heapType = RenderGraph::kHeapTypeTexture;
+		uint64_t heapOffset = 0;
+		ComPtr<ID3D12Resource> resource;
+		DescriptorHandle view;
+	};
+
+	// GPU が使い終えるのを待っている古いリソースとヒープ
+	struct PendingRelease {
+		uint64_t fenceValue;
+		std::vector<Transient> transients;
+		std::vector<ComPtr<ID3D12Heap>> heaps;
+	};
+
+	/// <summary>
+	/// リソースの設定を作る
+	/// </summary>
+	static D3D12_RESOURCE_DESC ToResourceDesc(const RenderGraph::TextureDesc& desc, uint32_t usages);
+	/// <summary>
+	/// 同じ設定で同じ位置に置かれているか
+	/// </summary>
+	static bool IsSameTransient(const Transient& transient, const RenderGraph::Resource& resource);
+	/// <summary>
+	/// 一時リソースとヒープを作り直す
+	/// </summary>
+	void CreateTransients(const RenderGraph& graph);
+	/// <summary>
+	/// バリアと分割バリアの開始をまとめて記録
+	/// </summary>
+	void RecordBarriers(std::span<const RenderGraph::Barrier> barriers, std::span<const RenderGraph::Barrier> splitBarriers);
+
+private:
+	ID3D12Device* device_ = nullptr;
+	ResourceStateTracker* stateTracker_ = nullptr;
+	TrackedCommandList* cmdList_ = nullptr;
+
+	ComPtr<ID3D12Heap> heaps_[RenderGraph::kHeapTypeCount];
+	std::vector<Transient> transients_;
+	// 現在のフレームで作り直したもの(fenceValue は FinishFrame で決まる)
+	std::vector<Transient> frameReleasedTransients_;
+	std::vector<ComPtr<ID3D12Heap>> frameReleasedHeaps_;
+	std::deque<PendingRelease> pendingReleases_;
+	// ハンドルごとのリソース
+	std::vector<Binding> bindings_;
+
+	StagingDescriptorAllocator* rtvAllocator_ = nullptr;
+	StagingDescriptorAllocator* dsvAllocator_ = nullptr;
+
+};
+
+#endif
@@ -0,0 +1,29 @@
+#include "RenderQueue.h"
+
+#include <cassert>
+
+#include "TextureManager.h"
+
+void RenderQueue::Execute(TrackedCommandList* cmdList) {
+	assert(cmdList != nullptr);
+	if (!isSorted_) {
+		Sort();
+	}
+
+	auto texMana = TextureManager::GetInstance();
+	StateTracker tracker;
+	for (auto& item : sortItems_) {
+		const Command& command = commands_[item.index];
+		bool isRootSignatureChanged = command.rootSignature != tracker.rootSignature;
+		if (tracker.ChangePipeline(command)) {
+			if (isRootSignatureChanged) {
+				cmdList->SetGraphicsRootSignature(command.rootSignature);
+			}
+			cmdList->SetPipelineState(command.pipelineState);
+		}
+		if (tracker.ChangeTexture(command)) {
+			texMana->SetGraphicsRootDescriptorTable(cmdList, command.textureRootParameterIndex, command.textureHandle);
+		}
+		command.draw(cmdList);
+	}
+}
@@ -0,0 +1,172 @@
+#pragma once
+#ifndef RENDERQUEUE_H_
+#define RENDERQUEUE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <d3d12.h>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "TrackedCommandList.h"
+
+/// <summary>
+/// 描画を集めてソートキー順に記録する
+/// キーは上位から レイヤー、ブレンドモード、パイプライン、テクスチャ、深度、マテリアル
+/// キーを作って並べる部分は RenderQueueSort.cpp(デバイスを使わずにテストする)
+/// </summary>
+class RenderQueue
+{
+public:
+	// 描画コマンドを記録する関数
+	using DrawFunction = std::function<void(TrackedCommandList* cmdList)>;
+
+	/// <summary>
+	/// 一回の描画
+	/// パイプラインとテクスチャは直前と違うときだけセットする
+	/// </summary>
+	struct Command {
+		ID3D12RootSignature* rootSignature = nullptr;
+		ID3D12PipelineState* pipelineState = nullptr;
+		// テクスチャのルートパラメータ番号
+		UINT textureRootParameterIndex = 0;
+		// テクスチャハンドル(kNoTexture ならセットしない)
+		UINT textureHandle = kNoTexture;
+		DrawFunction draw;
+	};
+
+	/// <summary>
+	/// ソート対象
+	/// </summary>
+	struct SortItem {
+		uint64_t key;
+		uint32_t index;
+	};
+
+	/// <summary>
+	/// 統計
+	/// </summary>
+	struct Statistics {
+		// 描画数
+		size_t commandCount = 0;
+		// ソート後のパイプラインの切り替え回数
+		size_t pipelineChangeCount = 0;
+		// ソート後のテクスチャの切り替え回数
+		size_t textureChangeCount = 0;
+		// 追加した順に記録した場合のパイプラインの切り替え回数
+		size_t unsortedPipelineChangeCount = 0;
+		// 追加した順に記録した場合のテクスチャの切り替え回数
+		size_t unsortedTextureChangeCount = 0;
+	};
+
+	static constexpr UINT kNoTexture = UINT32_MAX;
+
+	// キーのビット数
+	static constexpr uint32_t kLayerBits = 4;
+	static constexpr uint32_t kBlendModeBits = 4;
+	static constexpr uint32_t kPipelineBits = 10;
+	static constexpr uint32_t kTextureBits = 14;
+	static constexpr uint32_t kDepthBits = 24;
+	static constexpr uint32_t kMaterialBits = 8;
+	static_assert(kLayerBits + kBlendModeBits + kPipelineBits + kTextureBits + kDepthBits + kMaterialBits == 64);
+
+	// キーのビット位置
+	static constexpr uint32_t kMaterialShift = 0;
+	static constexpr uint32_t kDepthShift = kMaterialShift + kMaterialBits;
+	static constexpr uint32_t kTextureShift = kDepthShift + kDepthBits;
+	static constexpr uint32_t kPipelineShift = kTextureShift + kTextureBits;
+	static constexpr uint32_t kBlendModeShift = kPipelineShift + kPipelineBits;
+	static constexpr uint32_t kLayerShift = kBlendModeShift + kBlendModeBits;
+
+public:
+	/// <summary>
+	/// ソートキーを作る(小さいほど先に描画)
+	/// </summary>
+	/// <param name="layer">レイヤー</param>
+	/// <param name="blendMode">ブレンドモード</param>
+	/// <param name="pipeline">パイプラインの番号</param>
+	/// <param name="texture">テクスチャハンドル</param>
+	/// <param name="depth">0(手前) ~ 1(奥) 奥から描く場合は 1 - depth を渡す(範囲外は端に、NaN は奥にする)</param>
+	/// <param name="material">マテリアルの番号</param>
+	/// <returns></returns>
+	static uint64_t CreateKey(uint32_t layer, uint32_t blendMode, uint32_t pipeline, uint32_t texture, float depth, uint32_t material);
+	/// <summary>
+	/// キーの昇順に並べる(同じキーは追加した順のまま)
+	/// </summary>
+	/// <param name="items">並べる対象</param>
+	/// <param name="buffer">作業領域(items と同じ大きさ)</param>
+	static void RadixSort(std::span<SortItem> items, std::span<SortItem> buffer);
+
+	/// <summary>
+	/// 空にする
+	/// </summary>
+	void Clear();
+	/// <summary>
+	/// 描画を追加
+	/// </summary>
+	/// <param name="key">ソートキー</param>
+	/// <param name="command">描画</param>
+	void Submit(uint64_t key, Command command);
+	/// <summary>
+	/// キー順に並べる
+	/// </summary>
+	void Sort();
+	/// <summary>
+	/// 並べた順に記録
+	/// </summary>
+	/// <param name="cmdList">コマンドリスト</param>
+	void Execute(TrackedCommandList* cmdList);
+
+	/// <summary>
+	/// 描画数を取得
+	/// </summary>
+	/// <returns></returns>
+	inline size_t GetCount() const { return commands_.size(); }
+	/// <summary>
+	/// 並べた順を取得
+	/// </summary>
+	/// <returns></returns>
+	inline std::span<const SortItem> GetSortItems() const { return sortItems_; }
+	/// <summary>
+	/// 直前の Sort の統計を取得
+	/// </summary>
+	/// <returns></returns>
+	inline const Statistics& GetStatistics() const { return statistics_; }
+
+private:
+	/// <summary>
+	/// 直前の状態と比べる
+	/// </summary>
+	struct StateTracker {
+		ID3D12RootSignature* rootSignature = nullptr;
+		ID3D12PipelineState* pipelineState = nullptr;
+		UINT textureRootParameterIndex = 0;
+		UINT textureHandle = kNoTexture;
+
+		/// <summary>
+		/// パイプラインが変わったか(変わっていれば覚え直す)
+		/// </summary>
+		bool ChangePipeline(const Command& command);
+		/// <summary>
+		/// テクスチャが変わったか(変わっていれば覚え直す)
+		/// </summary>
+		bool ChangeTexture(const Command& command);
+	};
+
+private:
+	/// <summary>
+	/// 記録する順で状態の切り替え回数を数える
+	/// </summary>
+	void CountStateChanges(std::span<const SortItem> order, size_t& pipelineChangeCount, size_t& textureChangeCount) const;
+
+private:
+	std::vector<Command> commands_;
+	std::vector<SortItem> sortItems_;
+	std::vector<SortItem> sortBuffer_;
+	bool isSorted_ = false;
+	Statistics statistics_;
+
+};
+
+#endif
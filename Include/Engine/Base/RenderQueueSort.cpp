@@ -0,0 +1,149 @@
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+// キーを作って並べる部分(デバイスを使わない)
+
+namespace {
+	// 基数ソートの一桁
+	constexpr uint32_t kRadixBits = 8;
+	constexpr uint32_t kRadixSize = 1 << kRadixBits;
+	constexpr uint32_t kRadixPassCount = 64 / kRadixBits;
+}
+
+uint64_t RenderQueue::CreateKey(uint32_t layer, uint32_t blendMode, uint32_t pipeline, uint32_t texture, float depth, uint32_t material) {
+	assert(layer < (1u << kLayerBits));
+	assert(blendMode < (1u << kBlendModeBits));
+	assert(pipeline < (1u << kPipelineBits));
+	assert(texture < (1u << kTextureBits));
+	assert(material < (1u << kMaterialBits));
+
+	constexpr uint32_t kDepthMax = (1u << kDepthBits) - 1;
+	// NaN は clamp を素通りして変換が未定義になるので奥にする
+	if (std::isnan(depth)) {
+		depth = 1.0f;
+	}
+	uint32_t depthBits = static_cast<uint32_t>(std::clamp(depth, 0.0f, 1.0f) * static_cast<float>(kDepthMax));
+
+	return
+		static_cast<uint64_t>(layer) << kLayerShift |
+		static_cast<uint64_t>(blendMode) << kBlendModeShift |
+		static_cast<uint64_t>(pipeline) << kPipelineShift |
+		static_cast<uint64_t>(texture) << kTextureShift |
+		static_cast<uint64_t>(depthBits) << kDepthShift |
+		static_cast<uint64_t>(material) << kMaterialShift;
+}
+
+void RenderQueue::RadixSort(std::span<SortItem> items, std::span<SortItem> buffer) {
+	assert(buffer.size() >= items.size());
+	if (items.size() <= 1) {
+		return;
+	}
+
+	// 全ての桁の個数を一度に数える
+	std::array<std::array<uint32_t, kRadixSize>, kRadixPassCount> histograms = {};
+	for (auto& item : items) {
+		for (uint32_t pass = 0; pass < kRadixPassCount; pass++) {
+			histograms[pass][(item.key >> (pass * kRadixBits)) & (kRadixSize - 1)]++;
+		}
+	}
+
+	SortItem* src = items.data();
+	SortItem* dst = buffer.data();
+	for (uint32_t pass = 0; pass < kRadixPassCount; pass++) {
+		auto& histogram = histograms[pass];
+		uint32_t shift = pass * kRadixBits;
+		// 全て同じ値の桁は並びが変わらない
+		if (histogram[(src[0].key >> shift) & (kRadixSize - 1)] == items.size()) {
+			continue;
+		}
+
+		// 書き込み位置
+		uint32_t offset = 0;
+		for (auto& count : histogram) {
+			uint32_t next = offset + count;
+			count = offset;
+			offset = next;
+		}
+		for (size_t i = 0; i < items.size(); i++) {
+			dst[histogram[(src[i].key >> shift) & (kRadixSize - 1)]++] = src[i];
+		}
+		std::swap(src, dst);
+	}
+
+	if (src != items.data()) {
+		std::copy(src, src + items.size(), items.data());
+	}
+}
+
+void RenderQueue::Clear() {
+	commands_.clear();
+	sortItems_.clear();
+	isSorted_ = false;
+}
+
+void RenderQueue::Submit(uint64_t key, Command command) {
+	assert(command.draw);
+	assert(commands_.size() < UINT32_MAX);
+	sortItems_.push_back(SortItem{ key, static_cast<uint32_t>(commands_.size()) });
+	commands_.push_back(std::move(command));
+	isSorted_ = false;
+}
+
+void RenderQueue::Sort() {
+	statistics_ = {};
+	statistics_.commandCount = commands_.size();
+	// 追加した順
+	CountStateChanges(sortItems_, statistics_.unsortedPipelineChangeCount, statistics_.unsortedTextureChangeCount);
+
+	sortBuffer_.resize(sortItems_.size());
+	RadixSort(sortItems_, sortBuffer_);
+	isSorted_ = true;
+
+	CountStateChanges(sortItems_, statistics_.pipelineChangeCount, statistics_.textureChangeCount);
+}
+
+bool RenderQueue::StateTracker::ChangePipeline(const Command& command) {
+	if (command.rootSignature != rootSignature) {
+		rootSignature = command.rootSignature;
+		pipelineState = command.pipelineState;
+		// ルートシグネチャが変わるとルートパラメータは無効になる
+		textureHandle = kNoTexture;
+		return true;
+	}
+	if (command.pipelineState != pipelineState) {
+		pipelineState = command.pipelineState;
+		return true;
+	}
+	return false;
+}
+
+bool RenderQueue::StateTracker::ChangeTexture(const Command& command) {
+	if (command.textureHandle == kNoTexture) {
+		return false;
+	}
+	if (command.textureHandle != textureHandle || command.textureRootParameterIndex != textureRootParameterIndex) {
+		textureHandle = command.textureHandle;
+		textureRootParameterIndex = command.textureRootParameterIndex;
+		return true;
+	}
+	return false;
+}
+
+void RenderQueue::CountStateChanges(std::span<const SortItem> order, size_t& pipelineChangeCount, size_t& textureChangeCount) const {
+	pipelineChangeCount = 0;
+	textureChangeCount = 0;
+	StateTracker tracker;
+	for (auto& item : order) {
+		const Command& command = commands_[item.index];
+		if (tracker.ChangePipeline(command)) {
+			pipelineChangeCount++;
+		}
+		if (tracker.ChangeTexture(command)) {
+			textureChangeCount++;
+		}
+	}
+}
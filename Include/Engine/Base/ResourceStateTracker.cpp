@@ -0,0 +1,199 @@
+#include "ResourceStateTracker.h"
+
+#include <cassert>
+
+namespace {
+	inline D3D12_RESOURCE_BARRIER MakeTransition(
+		ID3D12Resource* resource, UINT subresource,
+		D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after, D3D12_RESOURCE_BARRIER_FLAGS flags) {
+		D3D12_RESOURCE_BARRIER barrier = {};
+		barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+		barrier.Flags = flags;
+		barrier.Transition.pResource = resource;
+		barrier.Transition.Subresource = subresource;
+		barrier.Transition.StateBefore = before;
+		barrier.Transition.StateAfter = after;
+		return barrier;
+	}
+
+	// バリアがリソースに関わるか(対象を指定しないバリアは全てに関わる)
+	inline bool IsTouching(const D3D12_RESOURCE_BARRIER& barrier, ID3D12Resource* resource) {
+		switch (barrier.Type) {
+		case D3D12_RESOURCE_BARRIER_TYPE_TRANSITION:
+			return barrier.Transition.pResource == resource;
+		case D3D12_RESOURCE_BARRIER_TYPE_ALIASING:
+			return barrier.Aliasing.pResourceBefore == nullptr ||
+				barrier.Aliasing.pResourceBefore == resource || barrier.Aliasing.pResourceAfter == resource;
+		case D3D12_RESOURCE_BARRIER_TYPE_UAV:
+			return barrier.UAV.pResource == nullptr || barrier.UAV.pResource == resource;
+		default:
+			return true;
+		}
+	}
+}
+
+void ResourceStateTracker::Register(ID3D12Resource* resource, D3D12_RESOURCE_STATES state, UINT subresourceCount) {
+	assert(resource != nullptr);
+	assert(subresourceCount > 0);
+	ResourceState& resourceState = states_[resource];
+	resourceState = {};
+	resourceState.state = state;
+	resourceState.subresourceCount = subresourceCount;
+}
+
+void ResourceStateTracker::Unregister(ID3D12Resource* resource) {
+	states_.erase(resource);
+}
+
+D3D12_RESOURCE_STATES ResourceStateTracker::GetState(ID3D12Resource* resource, UINT subresource) const {
+	auto it = states_.find(resource);
+	assert(it != states_.end());
+	const ResourceState& state = it->second;
+	if (state.subresourceStates.empty()) {
+		return state.state;
+	}
+	assert(subresource < state.subresourceCount);
+	return state.subresourceStates[subresource];
+}
+
+void ResourceStateTracker::Transition(ID3D12Resource* resource, D3D12_RESOURCE_STATES after, UINT subresource) {
+	statistics_.requestedCount++;
+	ResourceState& state = GetResourceState(resource);
+
+	// 始めた分割バリアを終える(状態は始めたときに遷移後にしてある)
+	if (state.isSplitPending) {
+		state.isSplitPending = false;
+		pendingBarriers_.push_back(MakeTransition(
+			resource, state.splitSubresource, state.splitBefore, state.splitAfter, D3D12_RESOURCE_BARRIER_FLAG_END_ONLY));
+		if (subresource == state.splitSubresource && after == state.splitAfter) {
+			return;
+		}
+	}
+
+	if (subresource == kAllSubresources) {
+		if (state.subresourceStates.empty()) {
+			if (state.state == after) {
+				statistics_.mergedCount++;
+				return;
+			}
+			PushTransition(resource, kAllSubresources, state.state, after);
+		}
+		else {
+			// 揃っていないサブリソースは個別に遷移する
+			for (UINT i = 0; i < state.subresourceCount; i++) {
+				if (state.subresourceStates[i] != after) {
+					PushTransition(resource, i, state.subresourceStates[i], after);
+				}
+			}
+			state.subresourceStates.clear();
+		}
+		state.state = after;
+		return;
+	}
+
+	assert(subresource < state.subresourceCount);
+	D3D12_RESOURCE_STATES before = state.subresourceStates.empty() ? state.state : state.subresourceStates[subresource];
+	if (before == after) {
+		statistics_.mergedCount++;
+		return;
+	}
+	PushTransition(resource, subresource, before, after);
+	SetSubresourceState(state, subresource, after);
+}
+
+void ResourceStateTracker::BeginTransition(ID3D12Resource* resource, D3D12_RESOURCE_STATES after, UINT subresource) {
+	ResourceState& state = GetResourceState(resource);
+	assert(!state.isSplitPending && "分割バリアを終える前に次の分割バリアは始められません");
+
+	// 状態が揃っていないと一つのバリアで表せない
+	if (subresource == kAllSubresources && !state.subresourceStates.empty()) {
+		Transition(resource, after, subresource);
+		return;
+	}
+
+	assert(subresource == kAllSubresources || subresource < state.subresourceCount);
+	D3D12_RESOURCE_STATES before =
+		(subresource == kAllSubresources || state.subresourceStates.empty()) ? state.state : state.subresourceStates[subresource];
+	if (before == after) {
+		return;
+	}
+
+	pendingBarriers_.push_back(MakeTransition(resource, subresource, before, after, D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY));
+	statistics_.splitBeginCount++;
+	state.isSplitPending = true;
+	state.splitSubresource = subresource;
+	state.splitBefore = before;
+	state.splitAfter = after;
+	if (subresource == kAllSubresources) {
+		state.state = after;
+	}
+	else {
+		SetSubresourceState(state, subresource, after);
+	}
+}
+
+void ResourceStateTracker::Aliasing(ID3D12Resource* before, ID3D12Resource* after) {
+	D3D12_RESOURCE_BARRIER barrier = {};
+	barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+	barrier.Aliasing.pResourceBefore = before;
+	barrier.Aliasing.pResourceAfter = after;
+	pendingBarriers_.push_back(barrier);
+}
+
+void ResourceStateTracker::UnorderedAccess(ID3D12Resource* resource) {
+	D3D12_RESOURCE_BARRIER barrier = {};
+	barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+	barrier.UAV.pResource = resource;
+	pendingBarriers_.push_back(barrier);
+}
+
+ResourceStateTracker::ResourceState& ResourceStateTracker::GetResourceState(ID3D12Resource* resource) {
+	auto it = states_.find(resource);
+	assert(it != states_.end() && "登録されていないリソースです");
+	return it->second;
+}
+
+void ResourceStateTracker::PushTransition(ID3D12Resource* resource, UINT subresource, D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after) {
+	// 同じリソースに最後にためたバリアが同じサブリソースの遷移ならつなげる
+	for (size_t i = pendingBarriers_.size(); i-- > 0;) {
+		D3D12_RESOURCE_BARRIER& barrier = pendingBarriers_[i];
+		if (!IsTouching(barrier, resource)) {
+			continue;
+		}
+		if (barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION &&
+			barrier.Flags == D3D12_RESOURCE_BARRIER_FLAG_NONE &&
+			barrier.Transition.Subresource == subresource) {
+			statistics_.mergedCount++;
+			if (barrier.Transition.StateBefore == after) {
+				// 元に戻るだけなら要らない
+				pendingBarriers_.erase(pendingBarriers_.begin() + i);
+			}
+			else {
+				barrier.Transition.StateAfter = after;
+			}
+			return;
+		}
+		break;
+	}
+	pendingBarriers_.push_back(MakeTransition(resource, subresource, before, after, D3D12_RESOURCE_BARRIER_FLAG_NONE));
+}
+
+void ResourceStateTracker::SetSubresourceState(ResourceState& state, UINT subresource, D3D12_RESOURCE_STATES after) {
+	if (state.subresourceStates.empty()) {
+		if (state.subresourceCount == 1) {
+			state.state = after;
+			return;
+		}
+		state.subresourceStates.assign(state.subresourceCount, state.state);
+	}
+	state.subresourceStates[subresource] = after;
+
+	// 揃ったら一つにまとめる
+	for (auto subresourceState : state.subresourceStates) {
+		if (subresourceState != after) {
+			return;
+		}
+	}
+	state.subresourceStates.clear();
+	state.state = after;
+}
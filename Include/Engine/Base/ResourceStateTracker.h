@@ -0,0 +1,159 @@
+#pragma once
+#ifndef RESOURCESTATETRACKER_H_
+#define RESOURCESTATETRACKER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <d3d12.h>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// リソースの状態を覚え、遷移のバリアをためてまとめて発行する
+/// 状態はサブリソース(ミップマップ)ごとに持てる
+/// 発行前の遷移は同じリソースの前の遷移とつなげ(A→B→C は A→C、A→B→A は無し)、
+/// 分割バリアは BeginTransition で始め、同じ遷移を Transition で要求したときに終える
+/// </summary>
+class ResourceStateTracker
+{
+public:
+	/// <summary>
+	/// 統計
+	/// </summary>
+	struct Statistics {
+		// 要求された遷移
+		size_t requestedCount = 0;
+		// 既にその状態だった、またはつなげて消えた遷移
+		size_t mergedCount = 0;
+		// 発行したバリア
+		size_t barrierCount = 0;
+		// ResourceBarrier の呼び出し回数
+		size_t batchCount = 0;
+		// 分割バリアの開始
+		size_t splitBeginCount = 0;
+	};
+
+	static constexpr UINT kAllSubresources = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+
+public:
+	/// <summary>
+	/// リソースを登録
+	/// </summary>
+	/// <param name="resource">リソース</param>
+	/// <param name="state">現在の状態</param>
+	/// <param name="subresourceCount">サブリソース数</param>
+	void Register(ID3D12Resource* resource, D3D12_RESOURCE_STATES state, UINT subresourceCount = 1);
+	/// <summary>
+	/// リソースの登録を外す(解放する前に呼ぶ)
+	/// </summary>
+	/// <param name="resource">リソース</param>
+	void Unregister(ID3D12Resource* resource);
+	/// <summary>
+	/// 登録されているか
+	/// </summary>
+	/// <param name="resource">リソース</param>
+	/// <returns></returns>
+	inline bool IsRegistered(ID3D12Resource* resource) const { return states_.contains(resource); }
+	/// <summary>
+	/// 状態を取得(ためている遷移の後の状態)
+	/// </summary>
+	/// <param name="resource">リソース</param>
+	/// <param name="subresource">サブリソース</param>
+	/// <returns></returns>
+	D3D12_RESOURCE_STATES GetState(ID3D12Resource* resource, UINT subresource = 0) const;
+
+	/// <summary>
+	/// 遷移をためる
+	/// </summary>
+	/// <param name="resource">リソース</param>
+	/// <param name="after">遷移後の状態</param>
+	/// <param name="subresource">サブリソース</param>
+	void Transition(ID3D12Resource* resource, D3D12_RESOURCE_STATES after, UINT subresource = kAllSubresources);
+	/// <summary>
+	/// 分割バリアを始める(同じ遷移を Transition で要求したときに終わる)
+	/// 状態が揃っていない全サブリソースの遷移は分割せずにためる
+	/// </summary>
+	/// <param name="resource">リソース</param>
+	/// <param name="after">遷移後の状態</param>
+	/// <param name="subresource">サブリソース</param>
+	void BeginTransition(ID3D12Resource* resource, D3D12_RESOURCE_STATES after, UINT subresource = kAllSubresources);
+	/// <summary>
+	/// メモリを共有するリソースの切り替えをためる
+	/// </summary>
+	/// <param name="before">切り替え前(nullptr なら全て)</param>
+	/// <param name="after">切り替え後</param>
+	void Aliasing(ID3D12Resource* before, ID3D12Resource* after);
+	/// <summary>
+	/// UAV の書き込みの順序の保証をためる
+	/// </summary>
+	/// <param name="resource">リソース</param>
+	void UnorderedAccess(ID3D12Resource* resource);
+
+	/// <summary>
+	/// ためたバリアを一度に発行
+	/// </summary>
+	/// <typeparam name="COMMAND_LIST">コマンドリストの型</typeparam>
+	/// <param name="cmdList">コマンドリスト</param>
+	template<class COMMAND_LIST>
+	inline void Flush(COMMAND_LIST* cmdList) {
+		if (pendingBarriers_.empty()) {
+			return;
+		}
+		cmdList->ResourceBarrier(static_cast<UINT>(pendingBarriers_.size()), pendingBarriers_.data());
+		statistics_.barrierCount += pendingBarriers_.size();
+		statistics_.batchCount++;
+		pendingBarriers_.clear();
+	}
+	/// <summary>
+	/// ためているバリアを取得
+	/// </summary>
+	/// <returns></returns>
+	inline std::span<const D3D12_RESOURCE_BARRIER> GetPendingBarriers() const { return pendingBarriers_; }
+
+	/// <summary>
+	/// 統計を取得
+	/// </summary>
+	/// <returns></returns>
+	inline const Statistics& GetStatistics() const { return statistics_; }
+	/// <summary>
+	/// 統計をリセット
+	/// </summary>
+	inline void ResetStatistics() { statistics_ = {}; }
+
+private:
+	// リソースの状態
+	struct ResourceState {
+		// 全サブリソースが同じ状態のときの状態
+		D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_COMMON;
+		// サブリソースごとの状態(揃っているときは空)
+		std::vector<D3D12_RESOURCE_STATES> subresourceStates;
+		UINT subresourceCount = 1;
+		// 始めて終えていない分割バリア
+		bool isSplitPending = false;
+		UINT splitSubresource = 0;
+		D3D12_RESOURCE_STATES splitBefore = D3D12_RESOURCE_STATE_COMMON;
+		D3D12_RESOURCE_STATES splitAfter = D3D12_RESOURCE_STATE_COMMON;
+	};
+
+	/// <summary>
+	/// 状態を取得
+	/// </summary>
+	ResourceState& GetResourceState(ID3D12Resource* resource);
+	/// <summary>
+	/// 遷移をためる(前の遷移とつなげられる場合はつなげる)
+	/// </summary>
+	void PushTransition(ID3D12Resource* resource, UINT subresource, D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after);
+	/// <summary>
+	/// 一つのサブリソースの状態を変える(揃ったら一つにまとめる)
+	/// </summary>
+	void SetSubresourceState(ResourceState& state, UINT subresource, D3D12_RESOURCE_STATES after);
+
+private:
+	std::unordered_map<ID3D12Resource*, ResourceState> states_;
+	std::vector<D3D12_RESOURCE_BARRIER> pendingBarriers_;
+	Statistics statistics_;
+
+};
+
+#endif
@@ -22,7 +22,7 @@ void SceneManager::Initalize()
 
 void SceneManager::Update()
 {
-    // ̃V[ꍇ
+    // 次のシーンがある場合
     if (nextScene_) {
         currentScene_ = std::move(nextScene_);
         currentScene_->Initalize();
@@ -7,7 +7,7 @@
 
 #include "SceneSharedData.h"
 
-// V[NX̐e
+// シーンクラスの親
 class BaseScene 
 {
 public:
@@ -23,58 +23,58 @@ protected:
 
 };
 
-// V[}l[W[
+// シーンマネージャー
 class SceneManager
 {
 public:
 	/// <summary>
-	/// VOgCX^X擾
+	/// シングルトンインスタンスを取得
 	/// </summary>
 	/// <returns></returns>
 	static SceneManager* GetInstance();
 
 public:
 	/// <summary>
-	/// 
+	/// 初期化
 	/// </summary>
 	void Initalize();
 	/// <summary>
-	/// XV
+	/// 更新
 	/// </summary>
 	void Update();
 	/// <summary>
-	/// `
+	/// 描画
 	/// </summary>
 	void Draw();
 	/// <summary>
-	/// V[`FW(̃t[UpdateOɕς)
+	/// シーンチェンジ(次のフレームのUpdate前に変わる)
 	/// </summary>
-	/// <typeparam name="NEXT_SCENE">̃V[(BaseScenep)</typeparam>
+	/// <typeparam name="NEXT_SCENE">次のシーン(BaseSceneを継承)</typeparam>
 	template<class NEXT_SCENE>
 	void Transition();
 
 	/// <summary>
-	/// ʃf[^擾
+	/// 共通データを取得
 	/// </summary>
 	/// <returns></returns>
 	std::shared_ptr<SceneSharedData> GetSharedData() { return sharedData_; }
 
 private:
-	// V[Lf[^
+	// シーン共有データ
 	std::shared_ptr<SceneSharedData> sharedData_;
-	// ݂̃V[
+	// 現在のシーン
 	std::unique_ptr<BaseScene> currentScene_;
-	// ̃V[
+	// 次のシーン
 	std::unique_ptr<BaseScene> nextScene_;
 };
 
 template<class NEXT_SCENE>
 inline void SceneManager::Transition()
 {
-	// NEXT_SCENEBaseScenepĂ
+	// NEXT_SCENEがBaseSceneを継承している
 	bool isInheritance = std::is_base_of<BaseScene, NEXT_SCENE>::value;
 	assert(isInheritance);
-	// nextSceneɃCX^XȂ
+	// nextSceneにインスタンスがない
 	assert(!nextScene_);
 	nextScene_ = std::make_unique<NEXT_SCENE>();
 }
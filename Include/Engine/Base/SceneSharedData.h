@@ -2,7 +2,7 @@
 #ifndef SCENESHAREDDATA_H_
 #define SCENESHAREDDATA_H_
 
-// V[ŋLf[^
+// シーンで共有されるデータ
 struct SceneSharedData {
 	int frame = {};
 
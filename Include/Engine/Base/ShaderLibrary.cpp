@@ -0,0 +1,91 @@
+#include "ShaderLibrary.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <fstream>
+#include <Windows.h>
+#include <bcrypt.h>
+
+#pragma comment(lib, "bcrypt.lib")
+
+ShaderLibrary* ShaderLibrary::GetInstance() {
+	static ShaderLibrary instance;
+	return &instance;
+}
+
+std::string ShaderLibrary::ComputeHash(const void* data, size_t size) {
+	uint8_t digest[32] = {};
+	NTSTATUS status = BCryptHash(BCRYPT_SHA256_ALG_HANDLE, nullptr, 0,
+		static_cast<PUCHAR>(const_cast<void*>(data)), static_cast<ULONG>(size), digest, sizeof(digest));
+	assert(BCRYPT_SUCCESS(status));
+
+	constexpr char kDigits[] = "0123456789ABCDEF";
+	std::string hash;
+	hash.reserve(sizeof(digest) * 2);
+	for (uint8_t byte : digest) {
+		hash += kDigits[byte >> 4];
+		hash += kDigits[byte & 0xF];
+	}
+	return hash;
+}
+
+void ShaderLibrary::Initalize(const std::string& directory) {
+	shaders_.clear();
+
+	std::string manifestPath = directory + kManifestFileName;
+	std::ifstream file(manifestPath);
+	if (!file) {
+		Fatal(manifestPath + " is missing. Build the project to compile shaders.");
+	}
+	Manifest manifest;
+	std::string error;
+	if (!ParseManifest(file, manifest, error)) {
+		Fatal(manifestPath + ": " + error);
+	}
+	if (manifest.profile != kProfile) {
+		Fatal(manifestPath + " is for " + manifest.profile + " but this build is " + kProfile + ".");
+	}
+
+	// ソースが書き換わっていればシェーダーは古い
+	if (!VerifySources(manifest, ReadFile, ComputeHash, error)) {
+		Fatal(error);
+	}
+
+	std::vector<char> data;
+	for (auto& shader : manifest.shaders) {
+		std::string shaderPath = directory + shader.hash + ".cso";
+		if (!ReadFile(shaderPath, data)) {
+			Fatal(shader.name + " (" + shaderPath + ") is missing. Rebuild the project.");
+		}
+		if (ComputeHash(data.data(), data.size()) != shader.hash) {
+			Fatal(shader.name + " (" + shaderPath + ") is corrupted. Rebuild the project.");
+		}
+		shaders_[shader.name] = std::move(data);
+	}
+}
+
+D3D12_SHADER_BYTECODE ShaderLibrary::GetShader(const std::string& name) const {
+	auto it = shaders_.find(name);
+	if (it == shaders_.end()) {
+		Fatal(name + " is not in the manifest.");
+	}
+	return D3D12_SHADER_BYTECODE{ it->second.data(), it->second.size() };
+}
+
+bool ShaderLibrary::ReadFile(const std::string& filePath, std::vector<char>& data) {
+	std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+	if (!file) {
+		return false;
+	}
+	data.resize(static_cast<size_t>(file.tellg()));
+	file.seekg(0);
+	file.read(data.data(), data.size());
+	return static_cast<bool>(file);
+}
+
+void ShaderLibrary::Fatal(const std::string& message) {
+	std::string text = "ShaderLibrary: " + message + "\n";
+	OutputDebugStringA(text.c_str());
+	assert(0);
+	std::abort();
+}
@@ -0,0 +1,125 @@
+#pragma once
+#ifndef SHADERLIBRARY_H_
+#define SHADERLIBRARY_H_
+
+#include <cstdint>
+#include <d3d12.h>
+#include <functional>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// ビルド時にコンパイルしたシェーダーを読み込む
+/// ビルドがシェーダーを "ハッシュ.cso" として並べ、名前とハッシュをマニフェストに書き出す
+/// 無いもの、壊れたもの、ソースより古いものは初期化の時点で止める
+/// マニフェストを読んで確かめる部分は ShaderManifest.cpp(デバイスを使わずにテストする)
+/// </summary>
+class ShaderLibrary final
+{
+public:
+	// マニフェストの一行
+	struct ManifestEntry {
+		// シェーダー名かソースのパス
+		std::string name;
+		// SHA-256 (16進数の大文字)
+		std::string hash;
+	};
+
+	// マニフェスト
+	struct Manifest {
+		// Debug か Release
+		std::string profile;
+		// シェーダーのソース(パスは作業ディレクトリから)
+		std::vector<ManifestEntry> sources;
+		// コンパイル済みのシェーダー
+		std::vector<ManifestEntry> shaders;
+	};
+
+	// ファイルを全て読む(読めなければ false)
+	using ReadFunction = std::function<bool(const std::string& filePath, std::vector<char>& data)>;
+	// ハッシュを16進数の大文字で求める
+	using HashFunction = std::function<std::string(const void* data, size_t size)>;
+
+	static constexpr const char* kManifestFileName = "manifest.txt";
+#ifdef _DEBUG
+	static constexpr const char* kProfile = "Debug";
+	static constexpr const char* kDefaultDirectory = "../Resources/Shaders/Bin/Debug/";
+#else
+	static constexpr const char* kProfile = "Release";
+	static constexpr const char* kDefaultDirectory = "../Resources/Shaders/Bin/Release/";
+#endif // _DEBUG
+
+public: // 静的メンバ関数
+	/// <summary>
+	/// シングルトンインスタンスを取得
+	/// </summary>
+	/// <returns>インスタンスのポインタ</returns>
+	static ShaderLibrary* GetInstance();
+	/// <summary>
+	/// マニフェストを読む
+	/// 一行ずつ "profile 名前", "source パス ハッシュ", "shader 名前 ハッシュ"
+	/// </summary>
+	/// <param name="stream">マニフェスト</param>
+	/// <param name="manifest">読んだ結果</param>
+	/// <param name="error">失敗した理由</param>
+	/// <returns>成功したか</returns>
+	static bool ParseManifest(std::istream& stream, Manifest& manifest, std::string& error);
+	/// <summary>
+	/// マニフェストのソースが今のファイルと同じか確かめる(ソースが無い場合も失敗)
+	/// </summary>
+	/// <param name="manifest">マニフェスト</param>
+	/// <param name="read">ファイルを読む関数</param>
+	/// <param name="hash">ハッシュを求める関数</param>
+	/// <param name="error">失敗した理由</param>
+	/// <returns>全てのソースがコンパイルしたときと同じか</returns>
+	static bool VerifySources(const Manifest& manifest, const ReadFunction& read, const HashFunction& hash, std::string& error);
+	/// <summary>
+	/// SHA-256 を16進数の大文字で求める
+	/// </summary>
+	/// <param name="data">データ</param>
+	/// <param name="size">バイト数</param>
+	/// <returns></returns>
+	static std::string ComputeHash(const void* data, size_t size);
+
+public: // メンバ関数
+	/// <summary>
+	/// マニフェストにある全てのシェーダーを読み込んで確かめる(失敗したら止める)
+	/// </summary>
+	/// <param name="directory">マニフェストとシェーダーのあるディレクトリ</param>
+	void Initalize(const std::string& directory = kDefaultDirectory);
+	/// <summary>
+	/// シェーダーを取得(無い名前は止める)
+	/// </summary>
+	/// <param name="name">拡張子を除いたソースのファイル名</param>
+	/// <returns>パイプラインに渡すバイトコード</returns>
+	D3D12_SHADER_BYTECODE GetShader(const std::string& name) const;
+	/// <summary>
+	/// 読み込んだシェーダーの数を取得
+	/// </summary>
+	/// <returns></returns>
+	inline size_t GetShaderCount() const { return shaders_.size(); }
+
+private: // メンバ関数
+	ShaderLibrary() = default;
+	~ShaderLibrary() = default;
+	ShaderLibrary(const ShaderLibrary&) = delete;
+	const ShaderLibrary& operator=(const ShaderLibrary&) = delete;
+
+	/// <summary>
+	/// ファイルを全て読む
+	/// </summary>
+	static bool ReadFile(const std::string& filePath, std::vector<char>& data);
+	/// <summary>
+	/// エラーを出力して止める
+	/// </summary>
+	[[noreturn]] static void Fatal(const std::string& message);
+
+private: // メンバ変数
+	// 名前ごとのバイトコード
+	std::unordered_map<std::string, std::vector<char>> shaders_;
+
+};
+
+#endif
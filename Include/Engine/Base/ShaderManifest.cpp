@@ -0,0 +1,96 @@
+#include "ShaderLibrary.h"
+
+#include <cctype>
+#include <sstream>
+
+// マニフェストを読んで確かめる部分(デバイスと OS の API を使わない)
+
+namespace {
+	constexpr size_t kHashLength = 64;
+}
+
+bool ShaderLibrary::ParseManifest(std::istream& stream, Manifest& manifest, std::string& error) {
+	manifest = {};
+	std::string line;
+	uint32_t lineNumber = 0;
+	while (std::getline(stream, line)) {
+		lineNumber++;
+		if (lineNumber == 1 && line.starts_with("\xEF\xBB\xBF")) {
+			line.erase(0, 3);
+		}
+		if (!line.empty() && line.back() == '\r') {
+			line.pop_back();
+		}
+		if (line.empty()) {
+			continue;
+		}
+
+		std::istringstream lineStream(line);
+		std::string kind;
+		lineStream >> kind;
+		if (kind == "profile") {
+			lineStream >> manifest.profile;
+			if (manifest.profile.empty()) {
+				error = "line " + std::to_string(lineNumber) + ": profile is empty";
+				return false;
+			}
+			continue;
+		}
+
+		ManifestEntry entry;
+		lineStream >> entry.name >> entry.hash;
+		if (entry.name.empty() || entry.hash.empty()) {
+			error = "line " + std::to_string(lineNumber) + ": expected name and hash";
+			return false;
+		}
+		std::string extra;
+		if (lineStream >> extra) {
+			error = "line " + std::to_string(lineNumber) + ": unexpected '" + extra + "'";
+			return false;
+		}
+		// SHA-256 は16進数で 64 文字
+		if (entry.hash.size() != kHashLength) {
+			error = "line " + std::to_string(lineNumber) + ": hash must be " + std::to_string(kHashLength) + " hex digits";
+			return false;
+		}
+		// 書き出す側の大文字小文字に依らない
+		for (auto& c : entry.hash) {
+			if (!std::isxdigit(static_cast<unsigned char>(c))) {
+				error = "line " + std::to_string(lineNumber) + ": hash must be hex digits";
+				return false;
+			}
+			c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+		}
+
+		if (kind == "source") {
+			manifest.sources.push_back(std::move(entry));
+		}
+		else if (kind == "shader") {
+			manifest.shaders.push_back(std::move(entry));
+		}
+		else {
+			error = "line " + std::to_string(lineNumber) + ": unknown kind '" + kind + "'";
+			return false;
+		}
+	}
+	if (manifest.profile.empty()) {
+		error = "profile is missing";
+		return false;
+	}
+	return true;
+}
+
+bool ShaderLibrary::VerifySources(const Manifest& manifest, const ReadFunction& read, const HashFunction& hash, std::string& error) {
+	std::vector<char> data;
+	for (auto& source : manifest.sources) {
+		if (!read(source.name, data)) {
+			error = source.name + " is missing. Shaders cannot be checked against their sources.";
+			return false;
+		}
+		if (hash(data.data(), data.size()) != source.hash) {
+			error = source.name + " has changed since shaders were compiled. Rebuild the project.";
+			return false;
+		}
+	}
+	return true;
+}
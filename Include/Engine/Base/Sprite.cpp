@@ -1,23 +1,25 @@
 #include "Sprite.h"
 
 #include <cassert>
-#include <d3dcompiler.h>
 #include <d3dx12.h>
 
 #include "CameraTransform.h"
 #include "DirectXCommon.h"
+#include "RenderQueue.h"
+#include "ShaderLibrary.h"
 #include "TextureManager.h"
 #include "WinApp.h"
 
-#pragma comment(lib,"d3dcompiler.lib")
-
 using namespace Microsoft::WRL;
 
 DirectXCommon* Sprite::sDiXCom_ = nullptr;
 TextureManager* Sprite::sTexMana_ = nullptr;
-ID3D12GraphicsCommandList* Sprite::sCmdList_ = nullptr;
+TrackedCommandList* Sprite::sCmdList_ = nullptr;
 ComPtr<ID3D12RootSignature> Sprite::sRootSignature_;
-std::array<ComPtr<ID3D12PipelineState>, Sprite::kBlendModeCount> Sprite::sPipelineState_; 
+std::array<PipelineCache::PipelineKey, Sprite::kBlendModeCount> Sprite::sPipelineKey_;
+std::array<uint32_t, Sprite::kBlendModeCount> Sprite::sPipelineIndex_ = {};
+std::array<ID3D12PipelineState*, Sprite::kBlendModeCount> Sprite::sPipelineState_ = {};
+bool Sprite::sIsPipelineReady_ = true;
 Matrix44 Sprite::sDefultProjMatrix_;
 
 void Sprite::StaticInitalize()
@@ -35,20 +37,27 @@ void Sprite::StaticInitalize()
 	CreatePipelineSet();
 }
 
-void Sprite::PreDraw(ID3D12GraphicsCommandList* cmdList)
+void Sprite::PreDraw(TrackedCommandList* cmdList)
 {
 	assert(sCmdList_ == nullptr);
 	sCmdList_ = cmdList;
+	sIsPipelineReady_ = true;
 }
 
 void Sprite::SetPipeline(BlendMode blendMode)
 {
 	assert(sCmdList_ != nullptr);
-	// pCvCZbg
-	sCmdList_->SetPipelineState(sPipelineState_[blendMode].Get());
-	// VOl`Zbg
+	ID3D12PipelineState* pipelineState = GetPipelineState(blendMode);
+	// 作っている間は描画を飛ばす
+	sIsPipelineReady_ = pipelineState != nullptr;
+	if (!sIsPipelineReady_) {
+		return;
+	}
+	// パイプラインをセット
+	sCmdList_->SetPipelineState(pipelineState);
+	// シグネチャをセット
 	sCmdList_->SetGraphicsRootSignature(sRootSignature_.Get());
-	// Op`XgɃZbg
+	// 三角形リストにセット
 	sCmdList_->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
 }
 
@@ -59,38 +68,13 @@ void Sprite::PostDraw()
 
 void Sprite::CreatePipelineSet()
 {
-	auto diXCom = DirectXCommon::GetInstance();
-
-	HRESULT result = S_FALSE;
-
-	ComPtr<ID3DBlob> vsBlob; // _VF[_IuWFNg
-	ComPtr<ID3DBlob> psBlob; // sNZVF[_IuWFNg
-	ComPtr<ID3DBlob> errorBlob; // G[IuWFNg
+	// 同じ設定なら前回の起動のバイナリから作る
+	auto pipelineCache = DirectXCommon::GetInstance()->GetPipelineCache();
 
-	// _VF[_̓ǂݍ݂ƃRpC
-	result = D3DCompileFromFile(
-		L"../Resources/Shaders/SpriteVS.hlsl", // VF[_t@C
-		nullptr,
-		D3D_COMPILE_STANDARD_FILE_INCLUDE,
-		"main", "vs_5_0", // Gg[|CgAVF[_[fw
-		D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION, // fobOpݒ
-		0, &vsBlob, &errorBlob);
-
-#ifdef _DEBUG
-	ShalderFileLoadCheak(result, errorBlob.Get());
-#endif // _DEBUG
-
-	result = D3DCompileFromFile(
-		L"../Resources/Shaders/SpritePS.hlsl", // VF[_t@C
-		nullptr,
-		D3D_COMPILE_STANDARD_FILE_INCLUDE,
-		"main", "ps_5_0", // Gg[|CgAVF[_[fw
-		D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION, // fobOpݒ
-		0, &psBlob, &errorBlob);
-
-#ifdef _DEBUG
-	ShalderFileLoadCheak(result, errorBlob.Get());
-#endif // _DEBUG
+	// ビルド時にコンパイル済みのシェーダー
+	auto shaderLib = ShaderLibrary::GetInstance();
+	D3D12_SHADER_BYTECODE vs = shaderLib->GetShader("SpriteVS");
+	D3D12_SHADER_BYTECODE ps = shaderLib->GetShader("SpritePS");
 
 
 	D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
@@ -107,18 +91,19 @@ void Sprite::CreatePipelineSet()
 	};
 
 
-	// [gVOl`
+	// ルートシグネチャ
 
-	// fBXNv^W
+	// ディスクリプタレンジ(全テクスチャを t0, space1 から並べる)
 	D3D12_DESCRIPTOR_RANGE descriptorRange =
-		CD3DX12_DESCRIPTOR_RANGE(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0);
+		CD3DX12_DESCRIPTOR_RANGE(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, UINT_MAX, 0, 1);
 
-	// [gp[^
+	// ルートパラメータ
 	CD3DX12_ROOT_PARAMETER rootParams[kRootParameterCount] = {};
 	rootParams[kConstData].InitAsConstantBufferView(0);
-	rootParams[kTexture].InitAsDescriptorTable(1, &descriptorRange);
+	rootParams[kTexture].InitAsDescriptorTable(1, &descriptorRange, D3D12_SHADER_VISIBILITY_PIXEL);
+	rootParams[kTextureIndex].InitAsConstants(1, 1, 0, D3D12_SHADER_VISIBILITY_PIXEL);
 
-	// eNX`Tv[̐ݒ
+	// テクスチャサンプラーの設定
 	D3D12_STATIC_SAMPLER_DESC samplerDesc = {};
 	samplerDesc.AddressU = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
 	samplerDesc.AddressV = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
@@ -130,167 +115,221 @@ void Sprite::CreatePipelineSet()
 	samplerDesc.ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER;
 	samplerDesc.ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
 
-	// [gVOl`ݒ
+	// ルートシグネチャ設定
 	D3D12_ROOT_SIGNATURE_DESC rootSignatureDesc = {};
 	rootSignatureDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
-	rootSignatureDesc.pParameters = rootParams; // [gp[^̐擪AhX
-	rootSignatureDesc.NumParameters = _countof(rootParams);		// [gp[^̐
+	rootSignatureDesc.pParameters = rootParams; // ルートパラメータの先頭アドレス
+	rootSignatureDesc.NumParameters = _countof(rootParams);		// ルートパラメータの数
 	rootSignatureDesc.pStaticSamplers = &samplerDesc;
 	rootSignatureDesc.NumStaticSamplers = 1;
 
-	// [gVOl`̃VACY
-	ComPtr<ID3DBlob> rootSigBlob;
-	result = D3D12SerializeRootSignature(&rootSignatureDesc,
-		D3D_ROOT_SIGNATURE_VERSION_1_0, &rootSigBlob, &errorBlob);
-	assert(SUCCEEDED(result));
-
-	result = diXCom->GetDevice()->CreateRootSignature(0,
-		rootSigBlob->GetBufferPointer(), rootSigBlob->GetBufferSize(),
-		IID_PPV_ARGS(&sRootSignature_));
-	assert(SUCCEEDED(result));
+	// ルートシグネチャの生成
+	sRootSignature_ = pipelineCache->GetRootSignature(rootSignatureDesc);
 
 
 	for (int i = 0; i < kBlendModeCount; i++) {
 
-		// OtBbNXpCvCݒ
+		// グラフィックスパイプライン設定
 		D3D12_GRAPHICS_PIPELINE_STATE_DESC pipelineDesc = {};
-		// VF[_̐ݒ
-		pipelineDesc.VS = CD3DX12_SHADER_BYTECODE(vsBlob.Get());
-		pipelineDesc.PS = CD3DX12_SHADER_BYTECODE(psBlob.Get());
+		// シェーダの設定
+		pipelineDesc.VS = vs;
+		pipelineDesc.PS = ps;
 
-		// Tv}XNݒ
+		// サンプルマスク設定
 		pipelineDesc.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
-		// X^CU̐ݒ
+		// ラスタライザの設定
 		pipelineDesc.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
-		pipelineDesc.RasterizerState.CullMode = D3D12_CULL_MODE_NONE; // JOȂ
-		//pipelineDesc.RasterizerState.FillMode = D3D12_FILL_MODE_WIREFRAME; // C[t[
+		pipelineDesc.RasterizerState.CullMode = D3D12_CULL_MODE_NONE; // カリングしない
+		//pipelineDesc.RasterizerState.FillMode = D3D12_FILL_MODE_WIREFRAME; // ワイヤーフレーム
 
-		// uhXe[g
-		pipelineDesc.BlendState.RenderTarget[0].RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL; // RGBAׂẴ`l`
-		pipelineDesc.BlendState.RenderTarget[0].BlendOpAlpha = D3D12_BLEND_OP_ADD;			// Z
-		pipelineDesc.BlendState.RenderTarget[0].SrcBlendAlpha = D3D12_BLEND_ONE;			// \[X̒l 100% g
-		pipelineDesc.BlendState.RenderTarget[0].DestBlendAlpha = D3D12_BLEND_ZERO;			// fXg̒l   0% g
+		// ブレンドステート
+		pipelineDesc.BlendState.RenderTarget[0] = CreateBlendDesc(static_cast<BlendMode>(i));
 
-		switch (static_cast<BlendMode>(i))
-		{
-		case kBlendModeNone: {
-			pipelineDesc.BlendState.RenderTarget[0].BlendEnable = false;						// uhȂ
-			break;
-			}
-		case kBlendModeNormal: {
-			pipelineDesc.BlendState.RenderTarget[0].BlendEnable = true;						// uhLɂ
-			pipelineDesc.BlendState.RenderTarget[0].BlendOp = D3D12_BLEND_OP_ADD;
-			pipelineDesc.BlendState.RenderTarget[0].SrcBlend = D3D12_BLEND_SRC_ALPHA;
-			pipelineDesc.BlendState.RenderTarget[0].DestBlend = D3D12_BLEND_INV_SRC_ALPHA;	// 1.0f-\[X̃At@l
-			break;
-			}
-		case kBlendModeAdd: {
-			pipelineDesc.BlendState.RenderTarget[0].BlendEnable = true;						// uhLɂ
-			pipelineDesc.BlendState.RenderTarget[0].BlendOp = D3D12_BLEND_OP_ADD;				// Z
-			pipelineDesc.BlendState.RenderTarget[0].SrcBlend = D3D12_BLEND_ONE;				// \[X̒l 100% g
-			pipelineDesc.BlendState.RenderTarget[0].DestBlend = D3D12_BLEND_ONE;				// fXg̒l 100% g
-			break;
-			}
-		case kBlendModeSubtract: {
-			pipelineDesc.BlendState.RenderTarget[0].BlendEnable = true;						// uhLɂ
-			pipelineDesc.BlendState.RenderTarget[0].BlendOp = D3D12_BLEND_OP_REV_SUBTRACT;	// fXg\[XZ
-			pipelineDesc.BlendState.RenderTarget[0].SrcBlend = D3D12_BLEND_ONE;				// \[X̒l 100% g
-			pipelineDesc.BlendState.RenderTarget[0].DestBlend = D3D12_BLEND_ONE;				// fXg̒l 100% g
-			break;
-			}
-		case kBlendModeMultiply: {
-			pipelineDesc.BlendState.RenderTarget[0].BlendEnable = true;						// uhLɂ
-			pipelineDesc.BlendState.RenderTarget[0].BlendOp = D3D12_BLEND_OP_ADD;				// Z
-			pipelineDesc.BlendState.RenderTarget[0].SrcBlend = D3D12_BLEND_ZERO;				// gȂ
-			pipelineDesc.BlendState.RenderTarget[0].DestBlend = D3D12_BLEND_SRC_COLOR;		// fXg̒l ~ \[X̒l
-			break;
-			}
-		case kBlendModeInversion: {
-			pipelineDesc.BlendState.RenderTarget[0].BlendEnable = true;						// uhLɂ
-			pipelineDesc.BlendState.RenderTarget[0].BlendOp = D3D12_BLEND_OP_ADD;				// Z
-			pipelineDesc.BlendState.RenderTarget[0].SrcBlend = D3D12_BLEND_INV_DEST_COLOR;	// 1.0f-fXgJ[̒l
-			pipelineDesc.BlendState.RenderTarget[0].DestBlend = D3D12_BLEND_ZERO;				// gȂ
-			break;
-			}
-		default:
-			assert(false);
-		}
-
-		// _CAEg̐ݒ
+		// 頂点レイアウトの設定
 		pipelineDesc.InputLayout.pInputElementDescs = inputLayout;
 		pipelineDesc.InputLayout.NumElements = _countof(inputLayout);
 
-		// }`̌`ݒ
+		// 図形の形状設定
 		pipelineDesc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
 
-		pipelineDesc.NumRenderTargets = 1; // `Ώۂ͂P
-		pipelineDesc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB; // 0 ~ 255wRGBA
-		pipelineDesc.SampleDesc.Count = 1; // PsNZɒPTvO
+		pipelineDesc.NumRenderTargets = 1; // 描画対象は１つ
+		pipelineDesc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB; // 0 ~ 255指定のRGBA
+		pipelineDesc.SampleDesc.Count = 1; // １ピクセルに着き１回サンプリング
 
 		//pipelineDesc.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
 		pipelineDesc.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ZERO;
 		pipelineDesc.DSVFormat = DXGI_FORMAT_D32_FLOAT;
 
-		// pCvCɃ[gVOl`Zbg
+		// パイプラインにルートシグネチャをセット
 		pipelineDesc.pRootSignature = sRootSignature_.Get();
 
-		// pCvCXe[g̐
-		result = diXCom->GetDevice()->CreateGraphicsPipelineState(&pipelineDesc, IID_PPV_ARGS(&sPipelineState_[i]));
-		assert(SUCCEEDED(result));
+		// パイプラインステートは初めて使うときに作る
+		sPipelineKey_[i] = pipelineCache->RegisterGraphicsPipeline(pipelineDesc);
+		sPipelineIndex_[i] = pipelineCache->GetPipelineIndex(sPipelineKey_[i]);
 	}
 }
 
-void Sprite::CreateBuffers() {
-	// ÓI֐Ă΂ĂȂ
-	assert(sDiXCom_ != nullptr);
-	assert(sTexMana_ != nullptr);
-	
-	constexpr UINT kConstBufferByteSize = (sizeof(ConstDataMatrixColor) + 0xFF) & ~0xFF;
-	constexpr UINT kVertexBufferByteSize = static_cast<UINT>(sizeof(VertexPosUv) * kVertexCount);
-	
-	// _obt@̍쐬
-	vertexBuffer_ = sDiXCom_->CreateResourceBuffer(kVertexBufferByteSize);
-	// 萔obt@̍쐬
-	constBuffer_ = sDiXCom_->CreateResourceBuffer(kConstBufferByteSize);
-
-	// r[𐶐
-	// GPUzAhX
-	vertexBufferView_.BufferLocation = vertexBuffer_->GetGPUVirtualAddress();
-	vertexBufferView_.SizeInBytes = kVertexBufferByteSize;
-	vertexBufferView_.StrideInBytes = sizeof(VertexPosUv);
-
-	UpdateVertexBuffer();
-	UpdateConstBuffer(sDefultProjMatrix_);
+ID3D12PipelineState* Sprite::GetPipelineState(BlendMode blendMode)
+{
+	if (sPipelineState_[blendMode] == nullptr) {
+		sPipelineState_[blendMode] = sDiXCom_->GetPipelineCache()->GetGraphicsPipeline(sPipelineKey_[blendMode]);
+	}
+	return sPipelineState_[blendMode];
 }
 
-void Sprite::Draw() 
+D3D12_RENDER_TARGET_BLEND_DESC Sprite::CreateBlendDesc(BlendMode blendMode)
 {
-	if (isNeedVertexUpdate_) {
-		UpdateVertexBuffer();
+	D3D12_RENDER_TARGET_BLEND_DESC blendDesc = {};
+	blendDesc.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL; // RGBAすべてのチャンネルを描画
+	blendDesc.BlendOpAlpha = D3D12_BLEND_OP_ADD;			// 加算
+	blendDesc.SrcBlendAlpha = D3D12_BLEND_ONE;			// ソースの値を 100% 使う
+	blendDesc.DestBlendAlpha = D3D12_BLEND_ZERO;			// デストの値を   0% 使う
+
+	switch (blendMode)
+	{
+	case kBlendModeNone: {
+		blendDesc.BlendEnable = false;						// ブレンドしない
+		break;
+		}
+	case kBlendModeNormal: {
+		blendDesc.BlendEnable = true;						// ブレンドを有効にする
+		blendDesc.BlendOp = D3D12_BLEND_OP_ADD;
+		blendDesc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+		blendDesc.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;	// 1.0f-ソースのアルファ値
+		break;
+		}
+	case kBlendModeAdd: {
+		blendDesc.BlendEnable = true;						// ブレンドを有効にする
+		blendDesc.BlendOp = D3D12_BLEND_OP_ADD;				// 加算
+		blendDesc.SrcBlend = D3D12_BLEND_ONE;				// ソースの値を 100% 使う
+		blendDesc.DestBlend = D3D12_BLEND_ONE;				// デストの値を 100% 使う
+		break;
+		}
+	case kBlendModeSubtract: {
+		blendDesc.BlendEnable = true;						// ブレンドを有効にする
+		blendDesc.BlendOp = D3D12_BLEND_OP_REV_SUBTRACT;	// デストからソースを減算
+		blendDesc.SrcBlend = D3D12_BLEND_ONE;				// ソースの値を 100% 使う
+		blendDesc.DestBlend = D3D12_BLEND_ONE;				// デストの値を 100% 使う
+		break;
+		}
+	case kBlendModeMultiply: {
+		blendDesc.BlendEnable = true;						// ブレンドを有効にする
+		blendDesc.BlendOp = D3D12_BLEND_OP_ADD;				// 加算
+		blendDesc.SrcBlend = D3D12_BLEND_ZERO;				// 使わない
+		blendDesc.DestBlend = D3D12_BLEND_SRC_COLOR;		// デストの値 × ソースの値
+		break;
+		}
+	case kBlendModeInversion: {
+		blendDesc.BlendEnable = true;						// ブレンドを有効にする
+		blendDesc.BlendOp = D3D12_BLEND_OP_ADD;				// 加算
+		blendDesc.SrcBlend = D3D12_BLEND_INV_DEST_COLOR;	// 1.0f-デストカラーの値
+		blendDesc.DestBlend = D3D12_BLEND_ZERO;				// 使わない
+		break;
+		}
+	default:
+		assert(false);
 	}
-	UpdateConstBuffer(sDefultProjMatrix_);
-	sCmdList_->IASetVertexBuffers(0, 1, &vertexBufferView_);
-	sCmdList_->SetGraphicsRootConstantBufferView(kConstData, constBuffer_->GetGPUVirtualAddress());
-	sTexMana_->SetGraphicsRootDescriptorTable(sCmdList_, kTexture,textureHandle_);
-	sCmdList_->DrawInstanced(kVertexCount, 1, 0, 0);
+	return blendDesc;
+}
+
+void Sprite::Draw() 
+{
+	Draw(sDefultProjMatrix_);
 }
 
 void Sprite::Draw(const Camera2D& camera)
 {
+	Draw(camera.GetViewProjMatrix());
+}
+
+void Sprite::Draw(RenderQueue& queue, BlendMode blendMode, uint32_t layer)
+{
+	Draw(queue, sDefultProjMatrix_, blendMode, layer);
+}
+
+void Sprite::Draw(RenderQueue& queue, const Camera2D& camera, BlendMode blendMode, uint32_t layer)
+{
+	Draw(queue, camera.GetViewProjMatrix(), blendMode, layer);
+}
+
+void Sprite::Draw(const Matrix44& viewProjMatrix)
+{
+	assert(sCmdList_ != nullptr);
+	if (!sIsPipelineReady_) {
+		return;
+	}
+	Record(sCmdList_, viewProjMatrix);
+}
+
+void Sprite::Draw(RenderQueue& queue, const Matrix44& viewProjMatrix, BlendMode blendMode, uint32_t layer)
+{
+	// 静的初期化関数が呼ばれていない
+	assert(sDiXCom_ != nullptr);
+
+	ID3D12PipelineState* pipelineState = GetPipelineState(blendMode);
+	// 作っている間は描画を飛ばす
+	if (pipelineState == nullptr) {
+		return;
+	}
+
+	RenderQueue::Command command;
+	command.rootSignature = sRootSignature_.Get();
+	command.pipelineState = pipelineState;
+	// テクスチャはルート定数の番号で選ぶのでテーブルの切り替えは要らない
+	command.draw = [this, viewProjMatrix](TrackedCommandList* cmdList) {
+		cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+		Record(cmdList, viewProjMatrix);
+	};
+	// テクスチャはルート定数で選び状態の切り替えが無いのでキーに入れない(同じパイプラインの中は追加した順)
+	queue.Submit(RenderQueue::CreateKey(layer, blendMode, sPipelineIndex_[blendMode], 0, 0.0f, 0), std::move(command));
+}
+
+void Sprite::Record(TrackedCommandList* cmdList, const Matrix44& viewProjMatrix)
+{
+	// 静的初期化関数が呼ばれていない
+	assert(sDiXCom_ != nullptr);
+
 	if (isNeedVertexUpdate_) {
-		UpdateVertexBuffer();
+		UpdateVertices();
 	}
-	UpdateConstBuffer(camera.GetViewProjMatrix());
-	sCmdList_->IASetVertexBuffers(0, 1, &vertexBufferView_);
-	sCmdList_->SetGraphicsRootConstantBufferView(kConstData, constBuffer_->GetGPUVirtualAddress());
-	sTexMana_->SetGraphicsRootDescriptorTable(sCmdList_, kTexture,textureHandle_);
-	sCmdList_->DrawInstanced(kVertexCount, 1, 0, 0);
+	auto uploadRing = sDiXCom_->GetUploadRing();
+
+	// 頂点をフレームごとのアップロード領域にコピー
+	auto vertexData = uploadRing->Allocate(sizeof(vertices_), alignof(VertexPosUv));
+	std::copy(vertices_.begin(), vertices_.end(), static_cast<VertexPosUv*>(vertexData.cpuAddress));
+	D3D12_VERTEX_BUFFER_VIEW vertexBufferView = {};
+	vertexBufferView.BufferLocation = vertexData.gpuAddress;
+	vertexBufferView.SizeInBytes = static_cast<UINT>(vertexData.size);
+	vertexBufferView.StrideInBytes = sizeof(VertexPosUv);
+
+	// 回転 * 平行移動
+	worldMatrix_ = Matrix44::CreateRotationZ(rotate_);
+	worldMatrix_.m[3][0] = position_.x;
+	worldMatrix_.m[3][1] = position_.y;
+	auto constData = uploadRing->Push(ConstDataMatrixColor{ color_, worldMatrix_ * viewProjMatrix });
+
+	cmdList->IASetVertexBuffers(0, 1, &vertexBufferView);
+	cmdList->SetGraphicsRootConstantBufferView(kConstData, constData.gpuAddress);
+	// テーブルは同じなのでセットされるのはルートシグネチャが変わった後だけ
+	sTexMana_->SetGraphicsRootBindlessTable(cmdList, kTexture);
+	cmdList->SetGraphicsRoot32BitConstant(kTextureIndex, sTexMana_->ResolveTextureHandle(textureHandle_), 0);
+	cmdList->DrawInstanced(kVertexCount, 1, 0, 0);
 }
 
-void Sprite::UpdateVertexBuffer()
+void Sprite::SetTextureRect(const std::string& name)
 {
-	HRESULT result = S_FALSE;
+	// 静的初期化関数が呼ばれていない
+	assert(sTexMana_ != nullptr);
+	SetTextureHandle(TextureManager::LoadTexture(name));
 
+	// 画像全体
+	Vector2 imageBase;
+	sTexMana_->GetTextureRect(textureHandle_, imageBase, textureSize_);
+	textureBase_ = Vector2(0.0f, 0.0f);
+}
+
+void Sprite::UpdateVertices()
+{
 	float left = (0.0f - anchorPoint_.x) * size_.x;
 	float right = (1.0f - anchorPoint_.x) * size_.x;
 	float top = (0.0f - anchorPoint_.y) * size_.y;
@@ -305,45 +344,26 @@ void Sprite::UpdateVertexBuffer()
 		bottom = -bottom;
 	}
 
-	VertexPosUv vertices[kVertexCount] = {};
-
-	vertices[0].position = Vector3(left, bottom, 0.0f);		// 
-	vertices[1].position = Vector3(left, top, 0.0f);		// 
-	vertices[2].position = Vector3(right, bottom, 0.0f);	// E
-	vertices[3].position = Vector3(right, top, 0.0f);		// E
+	vertices_[0].position = Vector3(left, bottom, 0.0f);		// 左下
+	vertices_[1].position = Vector3(left, top, 0.0f);		// 左上
+	vertices_[2].position = Vector3(right, bottom, 0.0f);	// 右下
+	vertices_[3].position = Vector3(right, top, 0.0f);		// 右上
 
+	// アトラス内の画像はページ内の位置をずらす
+	Vector2 imageBase, imageSize;
+	sTexMana_->GetTextureRect(textureHandle_, imageBase, imageSize);
 	auto resDesc = sTexMana_->GetResourceDesc(textureHandle_);
 
-	float uvLeft = textureBase_.x / resDesc.Width;
-	float uvRight = (textureBase_.x + textureSize_.x) / resDesc.Width;
-	float uvTop = textureBase_.y / resDesc.Height;
-	float uvBottom = (textureBase_.y + textureSize_.y) / resDesc.Height;
-
-	vertices[0].uv = Vector2(uvLeft, uvBottom);		// 
-	vertices[1].uv = Vector2(uvLeft, uvTop);		// 
-	vertices[2].uv = Vector2(uvRight, uvBottom);	// E
-	vertices[3].uv = Vector2(uvRight, uvTop);		// E
-
-	VertexPosUv* map = nullptr;
-	result = vertexBuffer_->Map(0, nullptr, (void**)&map);
-	assert(SUCCEEDED(result));
-	std::copy(std::begin(vertices), std::end(vertices), map);
-	vertexBuffer_->Unmap(0, nullptr);
-}
+	float uvLeft = (imageBase.x + textureBase_.x) / resDesc.Width;
+	float uvRight = (imageBase.x + textureBase_.x + textureSize_.x) / resDesc.Width;
+	float uvTop = (imageBase.y + textureBase_.y) / resDesc.Height;
+	float uvBottom = (imageBase.y + textureBase_.y + textureSize_.y) / resDesc.Height;
 
-void Sprite::UpdateConstBuffer(const Matrix44& mat)
-{
-	HRESULT result = S_FALSE;
-
-	worldMatrix_ = Matrix44::Identity;
-	worldMatrix_ *= Matrix44::CreateRotationZ(rotate_);
-	worldMatrix_ *= Matrix44::CreateTranslation(Vector3(position_, 0.0f));
-	
-	ConstDataMatrixColor* map = nullptr;
-	result = constBuffer_->Map(0, nullptr, (void**)&map);
-	assert(SUCCEEDED(result));
-	map->matrix = worldMatrix_ * mat;
-	map->color = color_;
-	constBuffer_->Unmap(0, nullptr);
+	vertices_[0].uv = Vector2(uvLeft, uvBottom);		// 左下
+	vertices_[1].uv = Vector2(uvLeft, uvTop);		// 左上
+	vertices_[2].uv = Vector2(uvRight, uvBottom);	// 右下
+	vertices_[3].uv = Vector2(uvRight, uvTop);		// 右上
+
+	isNeedVertexUpdate_ = false;
 }
 
@@ -4,24 +4,28 @@
 
 #include <array>
 #include <d3d12.h>
+#include <string>
 #include <wrl.h>
 
 #include "MathUtility.h"
+#include "PipelineCache.h"
+#include "TrackedCommandList.h"
 
 class DirectXCommon;
 class TextureManager;
 class Camera2D;
+class RenderQueue;
 
 class Sprite
 {
 public:
 	enum BlendMode {
-		kBlendModeNone,			// uhȂ
-		kBlendModeNormal,		// ʏ
-		kBlendModeAdd,			// Z
-		kBlendModeSubtract,		// Z
-		kBlendModeMultiply,		// Z
-		kBlendModeInversion,	// F]
+		kBlendModeNone,			// ブレンドなし
+		kBlendModeNormal,		// 通常
+		kBlendModeAdd,			// 加算合成
+		kBlendModeSubtract,		// 減算合成
+		kBlendModeMultiply,		// 乗算合成
+		kBlendModeInversion,	// 色反転
 
 		kBlendModeCount
 	};
@@ -36,10 +40,10 @@ public:
 		Matrix44 matrix;
 	};
 
-private:
 	enum RootParameter {
 		kConstData,
-		kTexture,
+		kTexture,		// 全テクスチャのテーブル(Bindless.hlsli)
+		kTextureIndex,	// テクスチャ配列の番号(ルート定数)
 
 		kRootParameterCount
 	};
@@ -49,9 +53,21 @@ private:
 
 public:
 	static void StaticInitalize();
-	static void PreDraw(ID3D12GraphicsCommandList* cmdList);
+	static void PreDraw(TrackedCommandList* cmdList);
+	/// <summary>
+	/// パイプラインをセット(まだ無く、飛ばす設定の場合は次の SetPipeline まで Draw を飛ばす)
+	/// </summary>
 	static void SetPipeline(BlendMode blendMode);
 	static void PostDraw();
+	static ID3D12RootSignature* GetRootSignature() { return sRootSignature_.Get(); }
+	static const Matrix44& GetDefaultProjMatrix() { return sDefultProjMatrix_; }
+	static D3D12_RENDER_TARGET_BLEND_DESC CreateBlendDesc(BlendMode blendMode);
+	/// <summary>
+	/// パイプラインを取得(初めて使うときに作る)
+	/// </summary>
+	/// <param name="blendMode">ブレンドモード</param>
+	/// <returns>まだ無く、飛ばす設定の場合は nullptr</returns>
+	static ID3D12PipelineState* GetPipelineState(BlendMode blendMode);
 
 private:
 	static void CreatePipelineSet();
@@ -59,9 +75,15 @@ private:
 private:
 	static DirectXCommon* sDiXCom_;
 	static TextureManager* sTexMana_;
-	static ID3D12GraphicsCommandList* sCmdList_;
+	static TrackedCommandList* sCmdList_;
 	static Microsoft::WRL::ComPtr<ID3D12RootSignature> sRootSignature_;
-	static std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, kBlendModeCount> sPipelineState_;
+	// 登録したパイプライン
+	static std::array<PipelineCache::PipelineKey, kBlendModeCount> sPipelineKey_;
+	// 登録したパイプラインの番号(ソートキーに使う)
+	static std::array<uint32_t, kBlendModeCount> sPipelineIndex_;
+	// 作り終えたパイプライン(キャッシュに毎回問い合わせない)
+	static std::array<ID3D12PipelineState*, kBlendModeCount> sPipelineState_;
+	static bool sIsPipelineReady_;
 	static Matrix44 sDefultProjMatrix_;
 
 public:
@@ -76,37 +98,63 @@ public:
 	inline void SetTextureBase(const Vector2& base);
 	inline void SetTextureSize(const Vector2& size);
 	inline void SetTextureRect(const Vector2& base, const Vector2& size);
+	/// <summary>
+	/// 画像をロードして全体を表示する(アトラス内の画像は名前から位置を引く)
+	/// </summary>
+	/// <param name="name">画像のパス</param>
+	void SetTextureRect(const std::string& name);
+
+	UINT GetTextureHandle() const { return textureHandle_; }
+	const Vector4& GetColor() const { return color_; }
+	const Vector2& GetPosition() const { return position_; }
+	float GetRotate() const { return rotate_; }
+	const Vector2& GetSize() const { return size_; }
+	const Vector2& GetAnchorPoint() const { return anchorPoint_; }
+	bool GetIsFlipX() const { return isFlipX_; }
+	bool GetIsFlipY() const { return isFlipY_; }
+	const Vector2& GetTextureBase() const { return textureBase_; }
+	const Vector2& GetTextureSize() const { return textureSize_; }
 
-	void CreateBuffers();
 	void Draw();
 	void Draw(const Camera2D& camera);
+	/// <summary>
+	/// 描画キューに追加(記録は RenderQueue::Execute で行う)
+	/// </summary>
+	/// <param name="queue">描画キュー</param>
+	/// <param name="blendMode">ブレンドモード</param>
+	/// <param name="layer">レイヤー(小さいほど先に描画)</param>
+	void Draw(RenderQueue& queue, BlendMode blendMode, uint32_t layer = 0);
+	void Draw(RenderQueue& queue, const Camera2D& camera, BlendMode blendMode, uint32_t layer = 0);
 
 private:
-	void UpdateVertexBuffer();
-	void UpdateConstBuffer(const Matrix44& mat);
+	void Draw(const Matrix44& viewProjMatrix);
+	void Draw(RenderQueue& queue, const Matrix44& viewProjMatrix, BlendMode blendMode, uint32_t layer);
+	// テクスチャ以外をセットして描画
+	void Record(TrackedCommandList* cmdList, const Matrix44& viewProjMatrix);
+	void UpdateVertices();
 
 private:
 	UINT textureHandle_ = 0;
 	Vector2 position_ = {};
 	float rotate_ = {};
 	Vector2 size_ = Vector2(100.0f, 100.0f);
-	Vector2 anchorPoint_ = {}; // ]ړs_
-	Matrix44 worldMatrix_; // [hs
-	Vector4 color_ = Color::White; // F
-	bool isFlipX_ = false; // E]s
-	bool isFlipY_ = false; // ㉺]s
+	Vector2 anchorPoint_ = {}; // 回転移動を行う基準点
+	Matrix44 worldMatrix_; // ワールド行列
+	Vector4 color_ = Color::White; // 色
+	bool isFlipX_ = false; // 左右反転を行うか
+	bool isFlipY_ = false; // 上下反転を行うか
 	Vector2 textureBase_ = {};
 	Vector2 textureSize_ = Vector2(1.0f, 1.0f);
 
-	Microsoft::WRL::ComPtr<ID3D12Resource> vertexBuffer_;
-	Microsoft::WRL::ComPtr<ID3D12Resource> constBuffer_;
-	D3D12_VERTEX_BUFFER_VIEW vertexBufferView_ = {};
-	bool isNeedVertexUpdate_ = false;
+	// 頂点(描画のたびにフレームごとのアップロード領域へコピーする)
+	std::array<VertexPosUv, kVertexCount> vertices_ = {};
+	bool isNeedVertexUpdate_ = true;
 };
 
-#pragma region // CC֐̎
+#pragma region // インライン関数の実装
 inline void Sprite::SetTextureHandle(UINT textureHandle) {
 	textureHandle_ = textureHandle;
+	isNeedVertexUpdate_ = true; // UV はテクスチャの大きさで変わる
 }
 inline void Sprite::SetColor(const Vector4& color) {
 	color_ = color;
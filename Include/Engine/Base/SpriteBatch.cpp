@@ -0,0 +1,308 @@
+#include "SpriteBatch.h"
+
+#include <cassert>
+#include <d3dx12.h>
+
+#include "CameraTransform.h"
+#include "DirectXCommon.h"
+#include "ShaderLibrary.h"
+#include "TextureManager.h"
+
+using namespace Microsoft::WRL;
+
+SpriteBatch::PipelineSet SpriteBatch::sPipelineSet_;
+SpriteBatch::PipelineSet SpriteBatch::sInstancingPipelineSet_;
+
+void SpriteBatch::StaticInitalize()
+{
+	// Sprite のルートシグネチャを使う
+	assert(Sprite::GetRootSignature() != nullptr);
+
+	CreatePipelineSet();
+}
+
+void SpriteBatch::Begin()
+{
+	Begin(Sprite::GetDefaultProjMatrix());
+}
+
+void SpriteBatch::Begin(const Camera2D& camera)
+{
+	Begin(camera.GetViewProjMatrix());
+}
+
+void SpriteBatch::Draw(const Sprite& sprite, Sprite::BlendMode blendMode)
+{
+	assert(isBegin_);
+
+	SpriteDrawDesc desc;
+	desc.position = sprite.GetPosition();
+	desc.rotate = sprite.GetRotate();
+	desc.size = sprite.GetSize();
+	desc.anchorPoint = sprite.GetAnchorPoint();
+	desc.isFlipX = sprite.GetIsFlipX();
+	desc.isFlipY = sprite.GetIsFlipY();
+	desc.color = sprite.GetColor();
+	desc.blendMode = blendMode;
+
+	// アトラス内の画像はページにまとめて描画する
+	auto texMana = TextureManager::GetInstance();
+	desc.textureHandle = texMana->ResolveTextureHandle(sprite.GetTextureHandle());
+	Vector2 imageBase, imageSize;
+	texMana->GetTextureRect(sprite.GetTextureHandle(), imageBase, imageSize);
+
+	// テクスチャ座標を 0 ~ 1 に変換
+	auto resDesc = texMana->GetResourceDesc(desc.textureHandle);
+	float width = static_cast<float>(resDesc.Width);
+	float height = static_cast<float>(resDesc.Height);
+	desc.uvBase = Vector2((imageBase.x + sprite.GetTextureBase().x) / width, (imageBase.y + sprite.GetTextureBase().y) / height);
+	desc.uvSize = Vector2(sprite.GetTextureSize().x / width, sprite.GetTextureSize().y / height);
+
+	builder_.Add(desc);
+}
+
+void SpriteBatch::Draw(const SpriteDrawDesc& desc)
+{
+	assert(isBegin_);
+	assert(desc.blendMode < Sprite::kBlendModeCount);
+	builder_.Add(desc);
+}
+
+void SpriteBatch::End(TrackedCommandList* cmdList)
+{
+	assert(isBegin_);
+	assert(cmdList != nullptr);
+	isBegin_ = false;
+
+	statistics_ = {};
+	if (builder_.GetSpriteCount() == 0) {
+		return;
+	}
+
+	auto constData = DirectXCommon::GetInstance()->GetUploadRing()->Push(ConstData{ viewProjMatrix_ });
+
+	cmdList->SetGraphicsRootSignature(Sprite::GetRootSignature());
+	cmdList->SetGraphicsRootConstantBufferView(Sprite::kConstData, constData.gpuAddress);
+	// テクスチャはスプライトごとの番号でシェーダーが選ぶ
+	TextureManager::GetInstance()->SetGraphicsRootBindlessTable(cmdList, Sprite::kTexture);
+	if (isInstancing_) {
+		SetInstances(cmdList);
+	}
+	else {
+		SetVertices(cmdList);
+	}
+
+	auto& pipelineSet = isInstancing_ ? sInstancingPipelineSet_ : sPipelineSet_;
+	for (auto& run : builder_.GetDrawRuns()) {
+		// 描画はブレンドモードが変わったときだけ分かれる
+		ID3D12PipelineState* pipelineState = GetPipelineState(pipelineSet, run.blendMode);
+		// 作っている間は描画を飛ばす
+		if (pipelineState == nullptr) {
+			continue;
+		}
+		cmdList->SetPipelineState(pipelineState);
+		if (isInstancing_) {
+			cmdList->DrawInstanced(SpriteBatchBuilder::kVertexCountPerSprite, run.spriteCount, 0, run.spriteOffset);
+		}
+		else {
+			cmdList->DrawIndexedInstanced(
+				run.spriteCount * SpriteBatchBuilder::kIndexCountPerSprite, 1,
+				run.spriteOffset * SpriteBatchBuilder::kIndexCountPerSprite, 0, 0);
+		}
+		statistics_.drawCount++;
+	}
+
+	statistics_.spriteCount = builder_.GetSpriteCount();
+	builder_.Clear();
+}
+
+void SpriteBatch::Begin(const Matrix44& viewProjMatrix)
+{
+	assert(!isBegin_);
+	isBegin_ = true;
+	viewProjMatrix_ = viewProjMatrix;
+	builder_.Clear();
+}
+
+void SpriteBatch::SetVertices(TrackedCommandList* cmdList)
+{
+	using Vertex = SpriteBatchBuilder::Vertex;
+	auto uploadRing = DirectXCommon::GetInstance()->GetUploadRing();
+
+	// 全スプライトの頂点とインデックスをフレームごとのアップロード領域に書き込む
+	auto vertexData = uploadRing->Allocate(sizeof(Vertex) * builder_.GetVertexCount(), alignof(Vertex));
+	auto indexData = uploadRing->Allocate(sizeof(uint32_t) * builder_.GetIndexCount(), alignof(uint32_t));
+	builder_.Build(
+		{ static_cast<Vertex*>(vertexData.cpuAddress), builder_.GetVertexCount() },
+		{ static_cast<uint32_t*>(indexData.cpuAddress), builder_.GetIndexCount() });
+
+	D3D12_VERTEX_BUFFER_VIEW vertexBufferView = {};
+	vertexBufferView.BufferLocation = vertexData.gpuAddress;
+	vertexBufferView.SizeInBytes = static_cast<UINT>(vertexData.size);
+	vertexBufferView.StrideInBytes = sizeof(Vertex);
+
+	D3D12_INDEX_BUFFER_VIEW indexBufferView = {};
+	indexBufferView.BufferLocation = indexData.gpuAddress;
+	indexBufferView.SizeInBytes = static_cast<UINT>(indexData.size);
+	indexBufferView.Format = DXGI_FORMAT_R32_UINT;
+
+	cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	cmdList->IASetVertexBuffers(0, 1, &vertexBufferView);
+	cmdList->IASetIndexBuffer(&indexBufferView);
+
+	statistics_.uploadBytes = vertexData.size + indexData.size;
+}
+
+void SpriteBatch::SetInstances(TrackedCommandList* cmdList)
+{
+	using Instance = SpriteBatchBuilder::Instance;
+	auto uploadRing = DirectXCommon::GetInstance()->GetUploadRing();
+
+	// スプライト一枚につき一つの記録だけを書き込む
+	auto instanceData = uploadRing->Allocate(sizeof(Instance) * builder_.GetSpriteCount(), alignof(Instance));
+	builder_.BuildInstances({ static_cast<Instance*>(instanceData.cpuAddress), builder_.GetSpriteCount() });
+
+	D3D12_VERTEX_BUFFER_VIEW instanceBufferView = {};
+	instanceBufferView.BufferLocation = instanceData.gpuAddress;
+	instanceBufferView.SizeInBytes = static_cast<UINT>(instanceData.size);
+	instanceBufferView.StrideInBytes = sizeof(Instance);
+
+	// 四隅は SV_VertexID から作るので頂点バッファは使わない
+	cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+	cmdList->IASetVertexBuffers(0, 1, &instanceBufferView);
+
+	statistics_.uploadBytes = instanceData.size;
+}
+
+void SpriteBatch::CreatePipelineSet()
+{
+	// 同じ設定なら前回の起動のバイナリから作る
+	auto pipelineCache = DirectXCommon::GetInstance()->GetPipelineCache();
+
+	// ビルド時にコンパイル済みのシェーダー
+	auto shaderLib = ShaderLibrary::GetInstance();
+	D3D12_SHADER_BYTECODE vs = shaderLib->GetShader("SpriteBatchVS");
+	D3D12_SHADER_BYTECODE instancingVs = shaderLib->GetShader("SpriteInstancedVS"); // インスタンス描画用
+	D3D12_SHADER_BYTECODE ps = shaderLib->GetShader("SpriteBatchPS");
+
+	// SpriteBatchBuilder::Vertex と合わせる
+	D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
+		{
+			"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0,
+			D3D12_APPEND_ALIGNED_ELEMENT,
+			D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0
+		},
+		{
+			"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0,
+			D3D12_APPEND_ALIGNED_ELEMENT,
+			D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0
+		},
+		{
+			"COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0,
+			D3D12_APPEND_ALIGNED_ELEMENT,
+			D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0
+		},
+		{
+			"TEXINDEX", 0, DXGI_FORMAT_R32_UINT, 0,
+			D3D12_APPEND_ALIGNED_ELEMENT,
+			D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0
+		},
+	};
+
+	// SpriteBatchBuilder::Instance と合わせる
+	D3D12_INPUT_ELEMENT_DESC instancingInputLayout[] = {
+		{
+			"INSTANCE_POSITION", 0, DXGI_FORMAT_R32G32_FLOAT, 0,
+			D3D12_APPEND_ALIGNED_ELEMENT,
+			D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1
+		},
+		{
+			"INSTANCE_ROTATE", 0, DXGI_FORMAT_R32_FLOAT, 0,
+			D3D12_APPEND_ALIGNED_ELEMENT,
+			D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1
+		},
+		{
+			"INSTANCE_SIZE", 0, DXGI_FORMAT_R32G32_FLOAT, 0,
+			D3D12_APPEND_ALIGNED_ELEMENT,
+			D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1
+		},
+		{
+			"INSTANCE_ANCHOR", 0, DXGI_FORMAT_R32G32_FLOAT, 0,
+			D3D12_APPEND_ALIGNED_ELEMENT,
+			D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1
+		},
+		{
+			"INSTANCE_UVBASE", 0, DXGI_FORMAT_R32G32_FLOAT, 0,
+			D3D12_APPEND_ALIGNED_ELEMENT,
+			D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1
+		},
+		{
+			"INSTANCE_UVSIZE", 0, DXGI_FORMAT_R32G32_FLOAT, 0,
+			D3D12_APPEND_ALIGNED_ELEMENT,
+			D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1
+		},
+		{
+			"COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0,
+			D3D12_APPEND_ALIGNED_ELEMENT,
+			D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1
+		},
+		{
+			"INSTANCE_TEXINDEX", 0, DXGI_FORMAT_R32_UINT, 0,
+			D3D12_APPEND_ALIGNED_ELEMENT,
+			D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1
+		},
+	};
+
+	auto createPipelineStates = [&](
+		const D3D12_SHADER_BYTECODE& vertexShader,
+		const D3D12_INPUT_LAYOUT_DESC& inputLayoutDesc,
+		PipelineSet& pipelineSet) {
+		for (int i = 0; i < Sprite::kBlendModeCount; i++) {
+
+			// グラフィックスパイプライン設定
+			D3D12_GRAPHICS_PIPELINE_STATE_DESC pipelineDesc = {};
+			// シェーダの設定
+			pipelineDesc.VS = vertexShader;
+			pipelineDesc.PS = ps;
+
+			// サンプルマスク設定
+			pipelineDesc.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
+			// ラスタライザの設定
+			pipelineDesc.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+			pipelineDesc.RasterizerState.CullMode = D3D12_CULL_MODE_NONE; // カリングしない
+
+			// ブレンドステート
+			pipelineDesc.BlendState.RenderTarget[0] = Sprite::CreateBlendDesc(static_cast<Sprite::BlendMode>(i));
+
+			// 頂点レイアウトの設定
+			pipelineDesc.InputLayout = inputLayoutDesc;
+
+			// 図形の形状設定
+			pipelineDesc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+
+			pipelineDesc.NumRenderTargets = 1; // 描画対象は１つ
+			pipelineDesc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB; // 0 ~ 255指定のRGBA
+			pipelineDesc.SampleDesc.Count = 1; // １ピクセルに着き１回サンプリング
+
+			pipelineDesc.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ZERO;
+			pipelineDesc.DSVFormat = DXGI_FORMAT_D32_FLOAT;
+
+			// パイプラインにルートシグネチャをセット
+			pipelineDesc.pRootSignature = Sprite::GetRootSignature();
+
+			// パイプラインステートは初めて使うときに作る
+			pipelineSet.keys[i] = pipelineCache->RegisterGraphicsPipeline(pipelineDesc);
+		}
+	};
+
+	createPipelineStates(vs, { inputLayout, _countof(inputLayout) }, sPipelineSet_);
+	createPipelineStates(instancingVs, { instancingInputLayout, _countof(instancingInputLayout) }, sInstancingPipelineSet_);
+}
+
+ID3D12PipelineState* SpriteBatch::GetPipelineState(PipelineSet& pipelineSet, uint32_t blendMode)
+{
+	if (pipelineSet.pipelineStates[blendMode] == nullptr) {
+		pipelineSet.pipelineStates[blendMode] = DirectXCommon::GetInstance()->GetPipelineCache()->GetGraphicsPipeline(pipelineSet.keys[blendMode]);
+	}
+	return pipelineSet.pipelineStates[blendMode];
+}
@@ -0,0 +1,129 @@
+#pragma once
+#ifndef SPRITEBATCH_H_
+#define SPRITEBATCH_H_
+
+#include <array>
+#include <d3d12.h>
+#include <wrl.h>
+
+#include "MathUtility.h"
+#include "Sprite.h"
+#include "SpriteBatchBuilder.h"
+
+class Camera2D;
+
+/// <summary>
+/// スプライトをまとめて描画する
+/// Begin から End までに追加したスプライトを一つの頂点、インデックス列に書き込み、
+/// ブレンドモードが続く間は一回の描画にまとめる(テクスチャが違ってもシェーダーが番号で選ぶ)
+/// インスタンス描画ではスプライト一枚につき一つの記録だけを送り、頂点シェーダで四隅に展開する
+/// </summary>
+class SpriteBatch
+{
+public:
+	/// <summary>
+	/// 統計
+	/// </summary>
+	struct Statistics {
+		// 描画したスプライト数
+		size_t spriteCount = 0;
+		// 描画コマンド数
+		size_t drawCount = 0;
+		// アップロードしたバイト数(定数バッファを除く)
+		size_t uploadBytes = 0;
+	};
+
+private:
+	struct ConstData {
+		Matrix44 viewProjMatrix;
+	};
+
+public:
+	/// <summary>
+	/// 静的初期化(Sprite::StaticInitalize の後に呼ぶ)
+	/// </summary>
+	static void StaticInitalize();
+
+public:
+	/// <summary>
+	/// 追加を開始(スクリーン座標)
+	/// </summary>
+	void Begin();
+	/// <summary>
+	/// 追加を開始
+	/// </summary>
+	/// <param name="camera">カメラ</param>
+	void Begin(const Camera2D& camera);
+	/// <summary>
+	/// スプライトを追加
+	/// </summary>
+	/// <param name="sprite">スプライト</param>
+	/// <param name="blendMode">ブレンドモード</param>
+	void Draw(const Sprite& sprite, Sprite::BlendMode blendMode = Sprite::kBlendModeNormal);
+	/// <summary>
+	/// スプライトを追加
+	/// </summary>
+	/// <param name="desc">スプライト</param>
+	void Draw(const SpriteDrawDesc& desc);
+	/// <summary>
+	/// 追加したスプライトを描画
+	/// </summary>
+	/// <param name="cmdList">コマンドリスト</param>
+	void End(TrackedCommandList* cmdList);
+
+	/// <summary>
+	/// インスタンス描画を使うか
+	/// </summary>
+	/// <param name="isInstancing"></param>
+	inline void SetIsInstancing(bool isInstancing) { isInstancing_ = isInstancing; }
+	/// <summary>
+	/// インスタンス描画を使うか
+	/// </summary>
+	/// <returns></returns>
+	inline bool GetIsInstancing() const { return isInstancing_; }
+
+	/// <summary>
+	/// 直前の End の統計を取得
+	/// </summary>
+	/// <returns></returns>
+	inline const Statistics& GetStatistics() const { return statistics_; }
+
+private:
+	// ブレンドモードごとのパイプライン
+	struct PipelineSet {
+		std::array<PipelineCache::PipelineKey, Sprite::kBlendModeCount> keys = {};
+		// 作り終えたもの(キャッシュに毎回問い合わせない)
+		std::array<ID3D12PipelineState*, Sprite::kBlendModeCount> pipelineStates = {};
+	};
+
+private:
+	static void CreatePipelineSet();
+	/// <summary>
+	/// パイプラインを取得(初めて使うときに作る、まだ無く飛ばす設定の場合は nullptr)
+	/// </summary>
+	static ID3D12PipelineState* GetPipelineState(PipelineSet& pipelineSet, uint32_t blendMode);
+
+	void Begin(const Matrix44& viewProjMatrix);
+	/// <summary>
+	/// 頂点、インデックス列をセット
+	/// </summary>
+	void SetVertices(TrackedCommandList* cmdList);
+	/// <summary>
+	/// インスタンス列をセット
+	/// </summary>
+	void SetInstances(TrackedCommandList* cmdList);
+
+private:
+	static PipelineSet sPipelineSet_;
+	static PipelineSet sInstancingPipelineSet_;
+
+private:
+	SpriteBatchBuilder builder_;
+	Matrix44 viewProjMatrix_ = Matrix44::Identity;
+	bool isBegin_ = false;
+	bool isInstancing_ = false;
+	Statistics statistics_;
+
+};
+
+#endif
@@ -0,0 +1,155 @@
+#include "SpriteBatchBuilder.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "ThreadPool.h"
+
+void SpriteBatchBuilder::ExpandQuad(const SpriteDrawDesc& desc, Vertex* vertices) {
+	float left = (0.0f - desc.anchorPoint.x) * desc.size.x;
+	float right = (1.0f - desc.anchorPoint.x) * desc.size.x;
+	float top = (0.0f - desc.anchorPoint.y) * desc.size.y;
+	float bottom = (1.0f - desc.anchorPoint.y) * desc.size.y;
+
+	if (desc.isFlipX) {
+		left = -left;
+		right = -right;
+	}
+	if (desc.isFlipY) {
+		top = -top;
+		bottom = -bottom;
+	}
+
+	// 回転 * 平行移動(Matrix44::CreateRotationZ と同じ)
+	float s, c;
+	Math::SinCos(desc.rotate, s, c);
+	auto transform = [&](float x, float y) {
+		return Vector3(x * c - y * s + desc.position.x, x * s + y * c + desc.position.y, 0.0f);
+	};
+	vertices[0].position = transform(left, bottom);		// 左下
+	vertices[1].position = transform(left, top);		// 左上
+	vertices[2].position = transform(right, bottom);	// 右下
+	vertices[3].position = transform(right, top);		// 右上
+
+	float uvLeft = desc.uvBase.x;
+	float uvRight = desc.uvBase.x + desc.uvSize.x;
+	float uvTop = desc.uvBase.y;
+	float uvBottom = desc.uvBase.y + desc.uvSize.y;
+
+	vertices[0].uv = Vector2(uvLeft, uvBottom);		// 左下
+	vertices[1].uv = Vector2(uvLeft, uvTop);		// 左上
+	vertices[2].uv = Vector2(uvRight, uvBottom);	// 右下
+	vertices[3].uv = Vector2(uvRight, uvTop);		// 右上
+
+	for (uint32_t i = 0; i < kVertexCountPerSprite; i++) {
+		vertices[i].color = desc.color;
+		vertices[i].textureIndex = desc.textureHandle;
+	}
+}
+
+SpriteBatchBuilder::Instance SpriteBatchBuilder::PackInstance(const SpriteDrawDesc& desc) {
+	Instance instance;
+	instance.position = desc.position;
+	instance.rotate = desc.rotate;
+	// 反転は基準点からの向きを逆にするのと同じ
+	instance.size.x = desc.isFlipX ? -desc.size.x : desc.size.x;
+	instance.size.y = desc.isFlipY ? -desc.size.y : desc.size.y;
+	instance.anchorPoint = desc.anchorPoint;
+	instance.uvBase = desc.uvBase;
+	instance.uvSize = desc.uvSize;
+
+	auto toByte = [](float value) {
+		return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+	};
+	instance.color =
+		toByte(desc.color.x) << 0 |
+		toByte(desc.color.y) << 8 |
+		toByte(desc.color.z) << 16 |
+		toByte(desc.color.w) << 24;
+	instance.textureIndex = desc.textureHandle;
+	return instance;
+}
+
+SpriteBatchBuilder::Vertex SpriteBatchBuilder::ExpandInstance(const Instance& instance, uint32_t vertexId) {
+	assert(vertexId < kVertexCountPerSprite);
+	// 0:左下 1:左上 2:右下 3:右上
+	float u = static_cast<float>(vertexId >> 1);
+	float v = static_cast<float>(~vertexId & 1);
+
+	float x = (u - instance.anchorPoint.x) * instance.size.x;
+	float y = (v - instance.anchorPoint.y) * instance.size.y;
+	float s, c;
+	Math::SinCos(instance.rotate, s, c);
+
+	Vertex vertex;
+	vertex.position = Vector3(x * c - y * s + instance.position.x, x * s + y * c + instance.position.y, 0.0f);
+	vertex.uv = Vector2(instance.uvBase.x + u * instance.uvSize.x, instance.uvBase.y + v * instance.uvSize.y);
+	vertex.color = Vector4(
+		static_cast<float>((instance.color >> 0) & 0xFF) / 255.0f,
+		static_cast<float>((instance.color >> 8) & 0xFF) / 255.0f,
+		static_cast<float>((instance.color >> 16) & 0xFF) / 255.0f,
+		static_cast<float>((instance.color >> 24) & 0xFF) / 255.0f);
+	vertex.textureIndex = instance.textureIndex;
+	return vertex;
+}
+
+void SpriteBatchBuilder::Clear() {
+	sprites_.clear();
+	runs_.clear();
+}
+
+void SpriteBatchBuilder::Add(const SpriteDrawDesc& desc) {
+	assert(GetVertexCount() + kVertexCountPerSprite <= UINT32_MAX);
+	// 直前と同じブレンドモードなら描画をまとめる(テクスチャはシェーダーが選ぶ)
+	if (runs_.empty() || runs_.back().blendMode != desc.blendMode) {
+		runs_.push_back(DrawRun{ desc.blendMode, static_cast<uint32_t>(GetSpriteCount()), 0 });
+	}
+	runs_.back().spriteCount++;
+	sprites_.push_back(desc);
+}
+
+void SpriteBatchBuilder::Build(std::span<Vertex> vertices, std::span<uint32_t> indices) const {
+	assert(vertices.size() >= GetVertexCount());
+	assert(indices.size() >= GetIndexCount());
+
+	auto build = [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			Vertex* quad = vertices.data() + i * kVertexCountPerSprite;
+			ExpandQuad(sprites_[i], quad);
+
+			// 三角形ストリップ(0, 1, 2, 3)と同じ向きの二枚
+			uint32_t base = static_cast<uint32_t>(i * kVertexCountPerSprite);
+			uint32_t* index = indices.data() + i * kIndexCountPerSprite;
+			index[0] = base + 0;
+			index[1] = base + 1;
+			index[2] = base + 2;
+			index[3] = base + 2;
+			index[4] = base + 1;
+			index[5] = base + 3;
+		}
+	};
+
+	size_t count = sprites_.size();
+	if (count < kParallelThreshold) {
+		build(0, count);
+		return;
+	}
+	ThreadPool::GetInstance()->ParallelFor(count, kParallelThreshold / 4, build);
+}
+
+void SpriteBatchBuilder::BuildInstances(std::span<Instance> instances) const {
+	assert(instances.size() >= GetSpriteCount());
+
+	auto build = [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			instances[i] = PackInstance(sprites_[i]);
+		}
+	};
+
+	size_t count = sprites_.size();
+	if (count < kParallelThreshold) {
+		build(0, count);
+		return;
+	}
+	ThreadPool::GetInstance()->ParallelFor(count, kParallelThreshold / 4, build);
+}
@@ -0,0 +1,142 @@
+#pragma once
+#ifndef SPRITEBATCHBUILDER_H_
+#define SPRITEBATCHBUILDER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "MathUtility.h"
+
+/// <summary>
+/// まとめて描画するスプライト一枚分
+/// </summary>
+struct SpriteDrawDesc {
+	Vector2 position = {};
+	float rotate = 0.0f;
+	Vector2 size = Vector2(100.0f, 100.0f);
+	Vector2 anchorPoint = {}; // 回転移動を行う基準点
+	bool isFlipX = false; // 左右反転を行うか
+	bool isFlipY = false; // 上下反転を行うか
+	Vector2 uvBase = {}; // UV の左上(0 ~ 1)
+	Vector2 uvSize = Vector2(1.0f, 1.0f); // UV の大きさ(0 ~ 1)
+	Vector4 color = Color::White;
+	uint32_t textureHandle = 0; // ResolveTextureHandle 済みのハンドル(テクスチャ配列の番号)
+	uint32_t blendMode = 0; // Sprite::BlendMode
+};
+
+/// <summary>
+/// スプライトを集めて一つの頂点、インデックス列を作る(D3D に依存しない部分)
+/// 追加した順に描画し、ブレンドモードが同じものが続く間は一つの描画にまとめる
+/// テクスチャは頂点(インスタンス)ごとの番号でシェーダーがテクスチャ配列から選ぶので、違っても分けない
+/// </summary>
+class SpriteBatchBuilder
+{
+public:
+	/// <summary>
+	/// 頂点(ワールド座標に変換済み)
+	/// </summary>
+	struct Vertex {
+		Vector3 position;
+		Vector2 uv;
+		Vector4 color;
+		uint32_t textureIndex;
+	};
+
+	/// <summary>
+	/// インスタンス描画用のスプライト一枚分(頂点シェーダで四隅に展開する)
+	/// 反転は size の符号に含める
+	/// </summary>
+	struct Instance {
+		Vector2 position;
+		float rotate;
+		Vector2 size;
+		Vector2 anchorPoint;
+		Vector2 uvBase;
+		Vector2 uvSize;
+		uint32_t color; // R8G8B8A8_UNORM の並び(下位バイトが R)
+		uint32_t textureIndex;
+	};
+
+	/// <summary>
+	/// 一回の描画
+	/// </summary>
+	struct DrawRun {
+		uint32_t blendMode;
+		// 先頭のスプライト番号
+		uint32_t spriteOffset;
+		uint32_t spriteCount;
+	};
+
+	static constexpr uint32_t kVertexCountPerSprite = 4;
+	static constexpr uint32_t kIndexCountPerSprite = 6;
+	// 頂点を並列に作るスプライト数
+	static constexpr size_t kParallelThreshold = 4 * 1024;
+
+public:
+	/// <summary>
+	/// 四隅の頂点を作る(左下、左上、右下、右上の順)
+	/// </summary>
+	/// <param name="desc">スプライト</param>
+	/// <param name="vertices">書き込み先(4つ)</param>
+	static void ExpandQuad(const SpriteDrawDesc& desc, Vertex* vertices);
+	/// <summary>
+	/// インスタンス描画用に詰める
+	/// </summary>
+	/// <param name="desc">スプライト</param>
+	/// <returns></returns>
+	static Instance PackInstance(const SpriteDrawDesc& desc);
+	/// <summary>
+	/// インスタンスから頂点を一つ作る(SpriteInstancedVS.hlsl と同じ計算)
+	/// </summary>
+	/// <param name="instance">インスタンス</param>
+	/// <param name="vertexId">0 ~ 3(左下、左上、右下、右上)</param>
+	/// <returns></returns>
+	static Vertex ExpandInstance(const Instance& instance, uint32_t vertexId);
+
+	/// <summary>
+	/// 空にする
+	/// </summary>
+	void Clear();
+	/// <summary>
+	/// スプライトを追加
+	/// </summary>
+	/// <param name="desc"></param>
+	void Add(const SpriteDrawDesc& desc);
+	/// <summary>
+	/// 頂点とインデックスを書き込む
+	/// </summary>
+	/// <param name="vertices">書き込み先(GetVertexCount 以上)</param>
+	/// <param name="indices">書き込み先(GetIndexCount 以上)</param>
+	void Build(std::span<Vertex> vertices, std::span<uint32_t> indices) const;
+	/// <summary>
+	/// インスタンスを書き込む
+	/// </summary>
+	/// <param name="instances">書き込み先(GetSpriteCount 以上)</param>
+	void BuildInstances(std::span<Instance> instances) const;
+
+	/// <summary>
+	/// スプライト数を取得
+	/// </summary>
+	inline size_t GetSpriteCount() const { return sprites_.size(); }
+	/// <summary>
+	/// 頂点数を取得
+	/// </summary>
+	inline size_t GetVertexCount() const { return sprites_.size() * kVertexCountPerSprite; }
+	/// <summary>
+	/// インデックス数を取得
+	/// </summary>
+	inline size_t GetIndexCount() const { return sprites_.size() * kIndexCountPerSprite; }
+	/// <summary>
+	/// 描画の並びを取得
+	/// </summary>
+	inline std::span<const DrawRun> GetDrawRuns() const { return runs_; }
+
+private:
+	std::vector<SpriteDrawDesc> sprites_;
+	std::vector<DrawRun> runs_;
+
+};
+
+#endif
@@ -0,0 +1,280 @@
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iomanip>
+#include <istream>
+#include <numeric>
+#include <ostream>
+
+namespace {
+	inline uint32_t AlignUp(uint32_t value, uint32_t alignment) {
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	inline bool Contains(const MaxRectsPacker::Rect& outer, const MaxRectsPacker::Rect& inner) {
+		return
+			inner.x >= outer.x && inner.y >= outer.y &&
+			inner.x + inner.width <= outer.x + outer.width &&
+			inner.y + inner.height <= outer.y + outer.height;
+	}
+
+	inline bool Intersects(const MaxRectsPacker::Rect& a, const MaxRectsPacker::Rect& b) {
+		return
+			a.x < b.x + b.width && b.x < a.x + a.width &&
+			a.y < b.y + b.height && b.y < a.y + a.height;
+	}
+
+	// 一覧の形式
+	constexpr char kLookupHeader[] = "atlas";
+	constexpr uint32_t kLookupVersion = 1;
+}
+
+void MaxRectsPacker::Initalize(uint32_t width, uint32_t height) {
+	width_ = width;
+	height_ = height;
+	usedArea_ = 0;
+	freeRects_.clear();
+	freeRects_.push_back(Rect{ 0, 0, width, height });
+}
+
+bool MaxRectsPacker::Insert(uint32_t width, uint32_t height, Rect& rect) {
+	if (width == 0 || height == 0) {
+		return false;
+	}
+
+	// 短辺の余り、長辺の余りの順に小さい空きを選ぶ
+	uint32_t bestShortSide = UINT32_MAX;
+	uint32_t bestLongSide = UINT32_MAX;
+	const Rect* best = nullptr;
+	for (auto& freeRect : freeRects_) {
+		if (freeRect.width < width || freeRect.height < height) {
+			continue;
+		}
+		uint32_t leftoverX = freeRect.width - width;
+		uint32_t leftoverY = freeRect.height - height;
+		uint32_t shortSide = std::min(leftoverX, leftoverY);
+		uint32_t longSide = std::max(leftoverX, leftoverY);
+		if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide)) {
+			bestShortSide = shortSide;
+			bestLongSide = longSide;
+			best = &freeRect;
+		}
+	}
+	if (best == nullptr) {
+		return false;
+	}
+
+	rect = Rect{ best->x, best->y, width, height };
+	SplitFreeRects(rect);
+	PruneFreeRects();
+	usedArea_ += static_cast<uint64_t>(width) * height;
+	return true;
+}
+
+float MaxRectsPacker::GetOccupancy() const {
+	if (width_ == 0 || height_ == 0) {
+		return 0.0f;
+	}
+	return static_cast<float>(static_cast<double>(usedArea_) / (static_cast<double>(width_) * height_));
+}
+
+void MaxRectsPacker::SplitFreeRects(const Rect& usedRect) {
+	size_t count = freeRects_.size();
+	for (size_t i = 0; i < count;) {
+		Rect freeRect = freeRects_[i];
+		if (!Intersects(freeRect, usedRect)) {
+			i++;
+			continue;
+		}
+		// 重なった空きを取り除き、重ならない部分(最大4つ)を追加
+		freeRects_[i] = freeRects_[count - 1];
+		freeRects_[count - 1] = freeRects_.back();
+		freeRects_.pop_back();
+		count--;
+
+		if (usedRect.x > freeRect.x) {
+			freeRects_.push_back(Rect{ freeRect.x, freeRect.y, usedRect.x - freeRect.x, freeRect.height });
+		}
+		if (usedRect.x + usedRect.width < freeRect.x + freeRect.width) {
+			uint32_t x = usedRect.x + usedRect.width;
+			freeRects_.push_back(Rect{ x, freeRect.y, freeRect.x + freeRect.width - x, freeRect.height });
+		}
+		if (usedRect.y > freeRect.y) {
+			freeRects_.push_back(Rect{ freeRect.x, freeRect.y, freeRect.width, usedRect.y - freeRect.y });
+		}
+		if (usedRect.y + usedRect.height < freeRect.y + freeRect.height) {
+			uint32_t y = usedRect.y + usedRect.height;
+			freeRects_.push_back(Rect{ freeRect.x, y, freeRect.width, freeRect.y + freeRect.height - y });
+		}
+	}
+}
+
+void MaxRectsPacker::PruneFreeRects() {
+	for (size_t i = 0; i < freeRects_.size(); i++) {
+		for (size_t j = i + 1; j < freeRects_.size();) {
+			if (Contains(freeRects_[j], freeRects_[i])) {
+				freeRects_.erase(freeRects_.begin() + i);
+				i--;
+				break;
+			}
+			if (Contains(freeRects_[i], freeRects_[j])) {
+				freeRects_.erase(freeRects_.begin() + j);
+				continue;
+			}
+			j++;
+		}
+	}
+}
+
+void TextureAtlasBuilder::Initalize(const Options& options) {
+	assert(options.alignment > 0 && (options.alignment & (options.alignment - 1)) == 0);
+	assert(options.pageWidth % options.alignment == 0);
+	assert(options.pageHeight % options.alignment == 0);
+	options_ = options;
+	pages_.clear();
+	entries_.clear();
+}
+
+const TextureAtlasBuilder::Entry* TextureAtlasBuilder::Add(const Image& image) {
+	assert(image.pixels != nullptr);
+	assert(image.rowPitch >= image.width * sizeof(uint32_t));
+
+	// 追加済み
+	if (auto entry = Find(image.name)) {
+		return entry;
+	}
+
+	uint32_t cellWidth = AlignUp(image.width + options_.padding * 2, options_.alignment);
+	uint32_t cellHeight = AlignUp(image.height + options_.padding * 2, options_.alignment);
+	if (image.width == 0 || image.height == 0 || cellWidth > options_.pageWidth || cellHeight > options_.pageHeight) {
+		return nullptr;
+	}
+
+	// 既存のページから順に空きを探す
+	Rect cell;
+	uint32_t pageIndex = 0;
+	for (; pageIndex < pages_.size(); pageIndex++) {
+		if (pages_[pageIndex].packer.Insert(cellWidth, cellHeight, cell)) {
+			break;
+		}
+	}
+	if (pageIndex == pages_.size()) {
+		Page& page = pages_.emplace_back();
+		page.width = options_.pageWidth;
+		page.height = options_.pageHeight;
+		page.pixels.assign(static_cast<size_t>(page.width) * page.height, 0);
+		page.packer.Initalize(page.width, page.height);
+		bool isInserted = page.packer.Insert(cellWidth, cellHeight, cell);
+		assert(isInserted);
+		(void)isInserted;
+	}
+
+	Blit(pages_[pageIndex], cell, image);
+
+	Entry entry;
+	entry.page = pageIndex;
+	entry.rect = Rect{ cell.x + options_.padding, cell.y + options_.padding, image.width, image.height };
+	return &entries_.emplace(image.name, entry).first->second;
+}
+
+bool TextureAtlasBuilder::Add(std::span<const Image> images) {
+	// 長辺、高さの大きい順
+	std::vector<size_t> order(images.size());
+	std::iota(order.begin(), order.end(), size_t(0));
+	std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+		uint32_t maxA = std::max(images[a].width, images[a].height);
+		uint32_t maxB = std::max(images[b].width, images[b].height);
+		if (maxA != maxB) {
+			return maxA > maxB;
+		}
+		return images[a].height > images[b].height;
+		});
+
+	bool isAllAdded = true;
+	for (size_t index : order) {
+		if (Add(images[index]) == nullptr) {
+			isAllAdded = false;
+		}
+	}
+	return isAllAdded;
+}
+
+const TextureAtlasBuilder::Entry* TextureAtlasBuilder::Find(const std::string& name) const {
+	auto it = entries_.find(name);
+	if (it == entries_.end()) {
+		return nullptr;
+	}
+	return &it->second;
+}
+
+void TextureAtlasBuilder::ClearDirty() {
+	for (auto& page : pages_) {
+		page.isDirty = false;
+	}
+}
+
+void TextureAtlasBuilder::WriteLookup(std::ostream& os, std::span<const std::string> pageNames) const {
+	assert(pageNames.size() == pages_.size());
+	os << kLookupHeader << ' ' << kLookupVersion << '\n';
+	for (auto& pageName : pageNames) {
+		os << "page " << std::quoted(pageName) << '\n';
+	}
+	for (auto& [name, entry] : entries_) {
+		os << "entry " << std::quoted(name) << ' ' << entry.page << ' '
+			<< entry.rect.x << ' ' << entry.rect.y << ' ' << entry.rect.width << ' ' << entry.rect.height << '\n';
+	}
+}
+
+bool TextureAtlasBuilder::ReadLookup(std::istream& is, std::vector<std::string>& pageNames, std::unordered_map<std::string, Entry>& entries) {
+	std::string header;
+	uint32_t version = 0;
+	if (!(is >> header >> version) || header != kLookupHeader || version != kLookupVersion) {
+		return false;
+	}
+
+	std::string tag;
+	while (is >> tag) {
+		if (tag == "page") {
+			std::string pageName;
+			if (!(is >> std::quoted(pageName))) {
+				return false;
+			}
+			pageNames.push_back(std::move(pageName));
+		}
+		else if (tag == "entry") {
+			std::string name;
+			Entry entry;
+			if (!(is >> std::quoted(name) >> entry.page >> entry.rect.x >> entry.rect.y >> entry.rect.width >> entry.rect.height)) {
+				return false;
+			}
+			if (entry.page >= pageNames.size()) {
+				return false;
+			}
+			entries[name] = entry;
+		}
+		else {
+			return false;
+		}
+	}
+	return true;
+}
+
+void TextureAtlasBuilder::Blit(Page& page, const Rect& cell, const Image& image) {
+	const uint8_t* src = reinterpret_cast<const uint8_t*>(image.pixels);
+	int32_t padding = static_cast<int32_t>(options_.padding);
+	int32_t maxX = static_cast<int32_t>(image.width) - 1;
+	int32_t maxY = static_cast<int32_t>(image.height) - 1;
+
+	// 余白と配置境界の余りは一番近い端のピクセルで埋める
+	for (uint32_t y = 0; y < cell.height; y++) {
+		int32_t srcY = std::clamp(static_cast<int32_t>(y) - padding, 0, maxY);
+		const uint32_t* srcRow = reinterpret_cast<const uint32_t*>(src + image.rowPitch * srcY);
+		uint32_t* dstRow = page.pixels.data() + static_cast<size_t>(cell.y + y) * page.width + cell.x;
+		for (uint32_t x = 0; x < cell.width; x++) {
+			int32_t srcX = std::clamp(static_cast<int32_t>(x) - padding, 0, maxX);
+			dstRow[x] = srcRow[srcX];
+		}
+	}
+	page.isDirty = true;
+}
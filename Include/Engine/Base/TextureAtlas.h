@@ -0,0 +1,199 @@
+#pragma once
+#ifndef TEXTUREATLAS_H_
+#define TEXTUREATLAS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// 矩形を詰め込む(MaxRects、短辺の余りが最小の位置に置く)
+/// </summary>
+class MaxRectsPacker
+{
+public:
+	/// <summary>
+	/// 矩形
+	/// </summary>
+	struct Rect {
+		uint32_t x = 0;
+		uint32_t y = 0;
+		uint32_t width = 0;
+		uint32_t height = 0;
+	};
+
+public:
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="width">幅</param>
+	/// <param name="height">高さ</param>
+	void Initalize(uint32_t width, uint32_t height);
+	/// <summary>
+	/// 矩形を置く
+	/// </summary>
+	/// <param name="width">幅</param>
+	/// <param name="height">高さ</param>
+	/// <param name="rect">置いた位置</param>
+	/// <returns>空きがない場合は false</returns>
+	bool Insert(uint32_t width, uint32_t height, Rect& rect);
+
+	/// <summary>
+	/// 使用率を取得
+	/// </summary>
+	/// <returns>0 ~ 1</returns>
+	float GetOccupancy() const;
+
+private:
+	/// <summary>
+	/// 置いた矩形と重なる空きを分割
+	/// </summary>
+	void SplitFreeRects(const Rect& usedRect);
+	/// <summary>
+	/// 他の空きに含まれる空きを取り除く
+	/// </summary>
+	void PruneFreeRects();
+
+private:
+	uint32_t width_ = 0;
+	uint32_t height_ = 0;
+	uint64_t usedArea_ = 0;
+	std::vector<Rect> freeRects_;
+
+};
+
+/// <summary>
+/// 画像をページにまとめる(D3D に依存しない部分)
+/// 画像の周りは端のピクセルを引き伸ばした余白で囲み、位置と大きさを alignment にそろえる
+/// alignment = 2^n なら n 段目までのミップマップで隣の画像と混ざらない
+/// </summary>
+class TextureAtlasBuilder
+{
+public:
+	using Rect = MaxRectsPacker::Rect;
+
+	/// <summary>
+	/// 設定
+	/// </summary>
+	struct Options {
+		uint32_t pageWidth = 2048;
+		uint32_t pageHeight = 2048;
+		// 端を引き伸ばす幅(ピクセル)
+		uint32_t padding = 2;
+		// 配置境界(2の累乗)
+		uint32_t alignment = 4;
+	};
+
+	/// <summary>
+	/// 追加する画像(R8G8B8A8)
+	/// </summary>
+	struct Image {
+		std::string name;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		const uint32_t* pixels = nullptr;
+		// 一行のバイト数
+		size_t rowPitch = 0;
+	};
+
+	/// <summary>
+	/// 画像の位置
+	/// </summary>
+	struct Entry {
+		uint32_t page = 0;
+		// ページ内の画像の範囲(余白を含まない)
+		Rect rect;
+	};
+
+	/// <summary>
+	/// ページ
+	/// </summary>
+	struct Page {
+		uint32_t width = 0;
+		uint32_t height = 0;
+		// R8G8B8A8
+		std::vector<uint32_t> pixels;
+		MaxRectsPacker packer;
+		// 前回 ClearDirty してから書き換えたか
+		bool isDirty = false;
+	};
+
+public:
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="options">設定</param>
+	void Initalize(const Options& options);
+	/// <summary>
+	/// 画像を追加(実行時に一枚ずつ追加する場合)
+	/// </summary>
+	/// <param name="image">画像</param>
+	/// <returns>ページに収まらない場合は nullptr</returns>
+	const Entry* Add(const Image& image);
+	/// <summary>
+	/// 画像をまとめて追加(大きい順に置くので一枚ずつより詰まる)
+	/// </summary>
+	/// <param name="images">画像</param>
+	/// <returns>全て置けたか</returns>
+	bool Add(std::span<const Image> images);
+	/// <summary>
+	/// 画像の位置を探す
+	/// </summary>
+	/// <param name="name">名前</param>
+	/// <returns>ない場合は nullptr</returns>
+	const Entry* Find(const std::string& name) const;
+
+	/// <summary>
+	/// ページの書き換えフラグを下ろす
+	/// </summary>
+	void ClearDirty();
+
+	/// <summary>
+	/// 位置の一覧を書き出す
+	/// </summary>
+	/// <param name="os">出力先</param>
+	/// <param name="pageNames">ページの名前(ページ数分)</param>
+	void WriteLookup(std::ostream& os, std::span<const std::string> pageNames) const;
+	/// <summary>
+	/// 位置の一覧を読み込む
+	/// </summary>
+	/// <param name="is">入力</param>
+	/// <param name="pageNames">ページの名前</param>
+	/// <param name="entries">位置</param>
+	/// <returns>形式が正しいか</returns>
+	static bool ReadLookup(std::istream& is, std::vector<std::string>& pageNames, std::unordered_map<std::string, Entry>& entries);
+
+	/// <summary>
+	/// 設定を取得
+	/// </summary>
+	/// <returns></returns>
+	inline const Options& GetOptions() const { return options_; }
+	/// <summary>
+	/// ページを取得
+	/// </summary>
+	/// <returns></returns>
+	inline const std::vector<Page>& GetPages() const { return pages_; }
+	/// <summary>
+	/// 位置の一覧を取得
+	/// </summary>
+	/// <returns></returns>
+	inline const std::unordered_map<std::string, Entry>& GetEntries() const { return entries_; }
+
+private:
+	/// <summary>
+	/// ページに画像を書き込む(余白は端を引き伸ばす)
+	/// </summary>
+	void Blit(Page& page, const Rect& cell, const Image& image);
+
+private:
+	Options options_;
+	std::vector<Page> pages_;
+	std::unordered_map<std::string, Entry> entries_;
+
+};
+
+#endif
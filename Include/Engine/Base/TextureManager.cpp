@@ -3,9 +3,67 @@
 #include <cassert>
 #include <DirectXTex.h>
 #include <d3dx12.h>
+#include <filesystem>
+#include <fstream>
 
 using namespace DirectX;
 
+namespace {
+	std::wstring ToWideString(const std::string& str) {
+		wchar_t wpath[256] = {};
+		MultiByteToWideChar(CP_ACP, 0, str.c_str(), -1, wpath, _countof(wpath));
+		return wpath;
+	}
+
+	/// <summary>
+	/// 画像を R8G8B8A8 で読み込む
+	/// </summary>
+	bool LoadRGBA(const std::string& filePath, ScratchImage& scratchImg) {
+		TexMetadata metadata = {};
+		HRESULT result = LoadFromWICFile(ToWideString(filePath).c_str(), WIC_FLAGS_NONE, &metadata, scratchImg);
+		if (FAILED(result)) {
+			return false;
+		}
+		if (metadata.format != DXGI_FORMAT_R8G8B8A8_UNORM) {
+			ScratchImage converted = {};
+			result = Convert(*scratchImg.GetImage(0, 0, 0), DXGI_FORMAT_R8G8B8A8_UNORM, TEX_FILTER_DEFAULT, TEX_THRESHOLD_DEFAULT, converted);
+			if (FAILED(result)) {
+				return false;
+			}
+			scratchImg = std::move(converted);
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// アトラスのページを画像にする
+	/// </summary>
+	Image GetPageImage(const TextureAtlasBuilder::Page& page) {
+		Image image = {};
+		image.width = page.width;
+		image.height = page.height;
+		image.format = DXGI_FORMAT_R8G8B8A8_UNORM;
+		image.rowPitch = page.width * sizeof(uint32_t);
+		image.slicePitch = image.rowPitch * page.height;
+		image.pixels = reinterpret_cast<uint8_t*>(const_cast<uint32_t*>(page.pixels.data()));
+		return image;
+	}
+
+	/// <summary>
+	/// 読み込んだ画像をアトラスに追加する形にする
+	/// </summary>
+	TextureAtlasBuilder::Image ToAtlasImage(const std::string& name, const ScratchImage& scratchImg) {
+		const Image* img = scratchImg.GetImage(0, 0, 0);
+		TextureAtlasBuilder::Image image;
+		image.name = name;
+		image.width = static_cast<uint32_t>(img->width);
+		image.height = static_cast<uint32_t>(img->height);
+		image.pixels = reinterpret_cast<const uint32_t*>(img->pixels);
+		image.rowPitch = img->rowPitch;
+		return image;
+	}
+}
+
 TextureManager* TextureManager::GetInstance() {
     static TextureManager instance;
     return &instance;
@@ -15,51 +73,183 @@ UINT TextureManager::LoadTexture(const std::string& filePath) {
     return GetInstance()->InternalLoadTexture(filePath);
 }
 
+bool TextureManager::LoadAtlas(const std::string& lookupPath) {
+    std::ifstream ifs(lookupPath);
+    if (!ifs) {
+        return false;
+    }
+    std::vector<std::string> pageNames;
+    std::unordered_map<std::string, TextureAtlasBuilder::Entry> entries;
+    if (!TextureAtlasBuilder::ReadLookup(ifs, pageNames, entries)) {
+        return false;
+    }
+
+    auto instance = GetInstance();
+    std::vector<UINT> pageHandles;
+    for (auto& pageName : pageNames) {
+        pageHandles.push_back(instance->InternalLoadTexture(pageName));
+    }
+    for (auto& [name, entry] : entries) {
+        instance->RegisterAtlasEntry(name, pageHandles[entry.page], entry.rect);
+    }
+    return true;
+}
+
+bool TextureManager::CookAtlas(const std::string& imageDirectory, const std::string& lookupPath, const TextureAtlasBuilder::Options& options) {
+    namespace fs = std::filesystem;
+
+    // フォルダ内の png を読み込む(名前は LoadTexture に渡すパスと同じ形)
+    std::vector<ScratchImage> scratchImages;
+    std::vector<std::string> names;
+    for (auto& file : fs::directory_iterator(imageDirectory)) {
+        if (!file.is_regular_file() || file.path().extension() != ".png") {
+            continue;
+        }
+        std::string name = (fs::path(imageDirectory) / file.path().filename()).generic_string();
+        ScratchImage scratchImg = {};
+        if (!LoadRGBA(name, scratchImg)) {
+            return false;
+        }
+        scratchImages.push_back(std::move(scratchImg));
+        names.push_back(std::move(name));
+    }
+
+    std::vector<TextureAtlasBuilder::Image> images;
+    for (size_t i = 0; i < scratchImages.size(); i++) {
+        images.push_back(ToAtlasImage(names[i], scratchImages[i]));
+    }
+
+    TextureAtlasBuilder builder;
+    builder.Initalize(options);
+    if (!builder.Add(images)) {
+        return false;
+    }
+
+    // ページを一覧と同じフォルダに書き出す
+    fs::path lookup(lookupPath);
+    std::vector<std::string> pageNames;
+    for (size_t i = 0; i < builder.GetPages().size(); i++) {
+        std::string pageName = (lookup.parent_path() / (lookup.stem().string() + "_" + std::to_string(i) + ".png")).generic_string();
+        HRESULT result = SaveToWICFile(
+            GetPageImage(builder.GetPages()[i]), WIC_FLAGS_NONE, GetWICCodec(WIC_CODEC_PNG),
+            ToWideString(pageName).c_str());
+        if (FAILED(result)) {
+            return false;
+        }
+        pageNames.push_back(std::move(pageName));
+    }
+
+    std::ofstream ofs(lookupPath);
+    if (!ofs) {
+        return false;
+    }
+    builder.WriteLookup(ofs, pageNames);
+    return true;
+}
+
+bool TextureManager::IsAtlasOutdated(const std::string& imageDirectory, const std::string& lookupPath) {
+    namespace fs = std::filesystem;
+
+    std::error_code error;
+    auto lookupTime = fs::last_write_time(lookupPath, error);
+    if (error) {
+        return true;
+    }
+    // 画像の追加と削除はフォルダの更新時刻に表れる
+    auto directoryTime = fs::last_write_time(imageDirectory, error);
+    if (error || directoryTime > lookupTime) {
+        return true;
+    }
+    for (auto& file : fs::directory_iterator(imageDirectory, error)) {
+        if (file.path().extension() == ".png" && file.last_write_time(error) > lookupTime) {
+            return true;
+        }
+    }
+    return false;
+}
+
+UINT TextureManager::LoadTextureToAtlas(const std::string& filePath) {
+    return GetInstance()->InternalLoadTextureToAtlas(filePath);
+}
+
 D3D12_RESOURCE_DESC TextureManager::GetResourceDesc(UINT texHandle) {
-    assert(nextLoadIndex_ < kDescriptorCount);
+    texHandle = ResolveTextureHandle(texHandle);
+    assert(texHandle < textures_.size() && textures_[texHandle].buffer.IsValid());
     return textures_[texHandle].buffer->GetDesc();
 }
 
+bool TextureManager::IsTextureReady(UINT texHandle) {
+    texHandle = ResolveTextureHandle(texHandle);
+    assert(texHandle < textures_.size() && textures_[texHandle].buffer.IsValid());
+    return directXCommon_->GetTextureUploader()->IsReady(textures_[texHandle].uploadTicket);
+}
+
+UINT TextureManager::ResolveTextureHandle(UINT texHandle) const {
+    if (texHandle < kAtlasHandleBase) {
+        return texHandle;
+    }
+    assert(texHandle - kAtlasHandleBase < atlasEntries_.size());
+    return atlasEntries_[texHandle - kAtlasHandleBase].pageHandle;
+}
+
+void TextureManager::GetTextureRect(UINT texHandle, Vector2& base, Vector2& size) {
+    if (texHandle >= kAtlasHandleBase) {
+        assert(texHandle - kAtlasHandleBase < atlasEntries_.size());
+        const AtlasEntry& entry = atlasEntries_[texHandle - kAtlasHandleBase];
+        base = entry.base;
+        size = entry.size;
+        return;
+    }
+    auto resDesc = GetResourceDesc(texHandle);
+    base = Vector2(0.0f, 0.0f);
+    size = Vector2(static_cast<float>(resDesc.Width), static_cast<float>(resDesc.Height));
+}
+
 void TextureManager::Initalize() {
     directXCommon_ = DirectXCommon::GetInstance();
 
     ResetAll();
-
-    descriptorIncrementSize_ = directXCommon_->GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 }
 
 void TextureManager::ResetAll() {
-	HRESULT result = S_FALSE;
-	// fXNv^q[v̐
-	D3D12_DESCRIPTOR_HEAP_DESC srvHeapDesc = {};
-	srvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-	srvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-	srvHeapDesc.NumDescriptors = kDescriptorCount;
-
-	result = directXCommon_->GetDevice()->CreateDescriptorHeap(&srvHeapDesc, IID_PPV_ARGS(&srvHeap_));
-	assert(SUCCEEDED(result));
-
+	// ディスクリプタとメモリを共有のヒープに返す
 	for (auto& it : textures_) {
-		it.buffer.Reset();
-		it.cpuHandle.ptr = 0;
-		it.gpuHandle.ptr = 0;
-		it.name.erase();
+		directXCommon_->GetSrvAllocator()->Free(it.srv);
+		directXCommon_->GetGpuMemoryAllocator()->Free(it.buffer);
 	}
-	nextLoadIndex_ = 0;
+	textures_.clear();
+
+	atlasEntries_.clear();
+	atlasHandles_.clear();
+	runtimeAtlas_.Initalize(kRuntimeAtlasOptions);
+	runtimeAtlasPages_.clear();
 }
 
-void TextureManager::SetGraphicsRootDescriptorTable(ID3D12GraphicsCommandList* cmdlist, UINT rootParamIndex, UINT texNumber) {
-	assert(texNumber < kDescriptorCount);
-	assert(textures_[texNumber].gpuHandle.ptr != 0); // eNX`[hĂȂ
+void TextureManager::SetGraphicsRootDescriptorTable(TrackedCommandList* cmdlist, UINT rootParamIndex, UINT texNumber) {
+	texNumber = ResolveTextureHandle(texNumber);
+	assert(texNumber < textures_.size() && textures_[texNumber].srv.IsValid()); // テクスチャがロードされていない
 
-	ID3D12DescriptorHeap* ppHeaps[] = { srvHeap_.Get() };
+	ID3D12DescriptorHeap* ppHeaps[] = { directXCommon_->GetSrvAllocator()->GetHeap() };
 	cmdlist->SetDescriptorHeaps(_countof(ppHeaps), ppHeaps);
 
-	cmdlist->SetGraphicsRootDescriptorTable(rootParamIndex, textures_[texNumber].gpuHandle);
+	cmdlist->SetGraphicsRootDescriptorTable(rootParamIndex, textures_[texNumber].srv.gpu);
+}
+
+void TextureManager::SetGraphicsRootBindlessTable(TrackedCommandList* cmdlist, UINT rootParamIndex) {
+	auto srvAllocator = directXCommon_->GetSrvAllocator();
+	ID3D12DescriptorHeap* ppHeaps[] = { srvAllocator->GetHeap() };
+	cmdlist->SetDescriptorHeaps(_countof(ppHeaps), ppHeaps);
+
+	// テーブルの先頭はヒープの先頭なのでハンドルがそのまま番号になる
+	cmdlist->SetGraphicsRootDescriptorTable(rootParamIndex, srvAllocator->GetPersistentTable());
 }
 
 UINT TextureManager::InternalLoadTexture(const std::string& filePath) {
-	assert(nextLoadIndex_ < kDescriptorCount);
+	// アトラス内の画像
+	auto atlasIt = atlasHandles_.find(filePath);
+	if (atlasIt != atlasHandles_.end()) {
+		return atlasIt->second;
+	}
 
 	auto it = std::find_if(
 		textures_.begin(), textures_.end(), 
@@ -80,6 +270,24 @@ UINT TextureManager::InternalLoadTexture(const std::string& filePath) {
 	result = LoadFromWICFile(wpath, WIC_FLAGS_NONE, &metadata, scratchImg);
 	assert(SUCCEEDED(result));
 
+	return CreateTexture(scratchImg, filePath);
+}
+
+UINT TextureManager::CreateTexture(ScratchImage& scratchImg, const std::string& name) {
+	HRESULT result = S_FALSE;
+
+	// 共有のヒープから永続的に割り当て、ヒープ内の位置をハンドルにする
+	DescriptorHandle srv = directXCommon_->GetSrvAllocator()->Allocate();
+	assert(srv.IsValid());
+	UINT handle = srv.offset;
+	assert(handle < kAtlasHandleBase);
+	if (textures_.size() <= handle) {
+		textures_.resize(handle + 1);
+	}
+	Texture& texture = textures_[handle];
+	texture.srv = srv;
+
+	TexMetadata metadata = scratchImg.GetMetadata();
 	ScratchImage mipChain = {};
 
 	result = GenerateMipMaps(
@@ -93,11 +301,6 @@ UINT TextureManager::InternalLoadTexture(const std::string& filePath) {
 	metadata.format = MakeSRGB(metadata.format);
 
 
-	D3D12_HEAP_PROPERTIES texHeapProp = {};
-	texHeapProp.Type = D3D12_HEAP_TYPE_CUSTOM;
-	texHeapProp.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_WRITE_BACK;
-	texHeapProp.MemoryPoolPreference = D3D12_MEMORY_POOL_L0;
-
 	D3D12_RESOURCE_DESC texResourceDesc = {};
 	texResourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
 	texResourceDesc.Format = metadata.format;
@@ -108,27 +311,10 @@ UINT TextureManager::InternalLoadTexture(const std::string& filePath) {
 	texResourceDesc.SampleDesc.Count = 1;
 
 
-	result = directXCommon_->GetDevice()->CreateCommittedResource(
-		&texHeapProp, D3D12_HEAP_FLAG_NONE, &texResourceDesc,
-		D3D12_RESOURCE_STATE_GENERIC_READ, nullptr,
-		IID_PPV_ARGS(&textures_[nextLoadIndex_].buffer));
-	assert(SUCCEEDED(result));
-
-	// S~bv}bvɂ
-	for (size_t i = 0; i < metadata.mipLevels; i++) {
-		// ~bv}bvxw肵ăC[W擾
-		const Image* img = scratchImg.GetImage(i, 0, 0);
-		// eNX`obt@Ƀf[^]
-		result = textures_[nextLoadIndex_].buffer->WriteToSubresource(
-			(UINT)i, nullptr, img->pixels,
-			(UINT)img->rowPitch, (UINT)img->slicePitch);
-		assert(SUCCEEDED(result));
-	}
-
-	textures_[nextLoadIndex_].cpuHandle = CD3DX12_CPU_DESCRIPTOR_HANDLE(
-		srvHeap_->GetCPUDescriptorHandleForHeapStart(), nextLoadIndex_, descriptorIncrementSize_);
-	textures_[nextLoadIndex_].gpuHandle = CD3DX12_GPU_DESCRIPTOR_HANDLE(
-		srvHeap_->GetGPUDescriptorHandleForHeapStart(), nextLoadIndex_, descriptorIncrementSize_);
+	// GPU から読むのが速いデフォルトヒープに配置し、中身はコピーキューで転送
+	texture.buffer = directXCommon_->GetGpuMemoryAllocator()->CreateResource(
+		GpuMemoryAllocator::kMemoryTypeDefault, texResourceDesc, D3D12_RESOURCE_STATE_COMMON);
+	UploadTexture(texture, scratchImg);
 
 
 	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
@@ -137,9 +323,105 @@ UINT TextureManager::InternalLoadTexture(const std::string& filePath) {
 	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
 	srvDesc.Texture2D.MipLevels = texResourceDesc.MipLevels;
 
-	directXCommon_->GetDevice()->CreateShaderResourceView(textures_[nextLoadIndex_].buffer.Get(), &srvDesc, textures_[nextLoadIndex_].cpuHandle);
+	directXCommon_->GetDevice()->CreateShaderResourceView(texture.buffer.Get(), &srvDesc, texture.srv.GetCpuHandle());
 
-	textures_[nextLoadIndex_].name = filePath;
+	texture.name = name;
+
+	return handle;
+}
+
+void TextureManager::UploadTexture(Texture& texture, const ScratchImage& scratchImg) {
+	const TexMetadata& metadata = scratchImg.GetMetadata();
+	D3D12_RESOURCE_DESC resDesc = texture.buffer->GetDesc();
+	UINT subresourceCount = static_cast<UINT>(metadata.arraySize * metadata.mipLevels);
+	assert(resDesc.MipLevels == metadata.mipLevels && resDesc.DepthOrArraySize == metadata.arraySize);
+
+	// ステージング領域での形(行の間隔は 256 バイトにそろう)
+	std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> layouts(subresourceCount);
+	std::vector<UINT> numRows(subresourceCount);
+	std::vector<UINT64> rowSizes(subresourceCount);
+	directXCommon_->GetDevice()->GetCopyableFootprints(
+		&resDesc, 0, subresourceCount, 0, layouts.data(), numRows.data(), rowSizes.data(), nullptr);
+
+	std::vector<TextureUploader::Subresource> subresources(subresourceCount);
+	for (size_t item = 0; item < metadata.arraySize; item++) {
+		for (size_t mip = 0; mip < metadata.mipLevels; mip++) {
+			UINT index = D3D12CalcSubresource((UINT)mip, (UINT)item, 0, (UINT)metadata.mipLevels, (UINT)metadata.arraySize);
+			const Image* img = scratchImg.GetImage(mip, item, 0);
+			TextureUploader::Subresource& subresource = subresources[index];
+			subresource.data.pData = img->pixels;
+			subresource.data.RowPitch = img->rowPitch;
+			subresource.data.SlicePitch = img->slicePitch;
+			subresource.layout = layouts[index];
+			subresource.numRows = numRows[index];
+			subresource.rowSize = rowSizes[index];
+		}
+	}
+	texture.uploadTicket = directXCommon_->GetTextureUploader()->Upload(texture.buffer.Get(), subresources);
+}
+
+UINT TextureManager::RegisterAtlasEntry(const std::string& name, UINT pageHandle, const TextureAtlasBuilder::Rect& rect) {
+	AtlasEntry entry;
+	entry.pageHandle = pageHandle;
+	entry.base = Vector2(static_cast<float>(rect.x), static_cast<float>(rect.y));
+	entry.size = Vector2(static_cast<float>(rect.width), static_cast<float>(rect.height));
+	atlasEntries_.push_back(entry);
+
+	UINT handle = kAtlasHandleBase + static_cast<UINT>(atlasEntries_.size() - 1);
+	atlasHandles_[name] = handle;
+	return handle;
+}
+
+UINT TextureManager::InternalLoadTextureToAtlas(const std::string& filePath) {
+	auto atlasIt = atlasHandles_.find(filePath);
+	if (atlasIt != atlasHandles_.end()) {
+		return atlasIt->second;
+	}
+
+	ScratchImage scratchImg = {};
+	bool isLoaded = LoadRGBA(filePath, scratchImg);
+	assert(isLoaded);
+	(void)isLoaded;
+
+	auto entry = runtimeAtlas_.Add(ToAtlasImage(filePath, scratchImg));
+	if (entry == nullptr) {
+		// ページに収まらない
+		return InternalLoadTexture(filePath);
+	}
+
+	// 書き換えたページを転送
+	auto& pages = runtimeAtlas_.GetPages();
+	for (size_t i = 0; i < pages.size(); i++) {
+		if (!pages[i].isDirty) {
+			continue;
+		}
+		ScratchImage pageImg = {};
+		HRESULT result = pageImg.InitializeFromImage(GetPageImage(pages[i]));
+		assert(SUCCEEDED(result));
+
+		std::string pageName = "runtime atlas " + std::to_string(i);
+		if (i == runtimeAtlasPages_.size()) {
+			runtimeAtlasPages_.push_back(CreateTexture(pageImg, pageName));
+			continue;
+		}
+
+		// 既存のページは先行しているフレームが読んでいる可能性があるので、上書きせず新しいテクスチャに書く
+		// 古いページのディスクリプタとメモリはフレームのフェンスを GPU が通過してから再利用される
+		UINT oldPage = runtimeAtlasPages_[i];
+		UINT newPage = CreateTexture(pageImg, pageName);
+		for (auto& atlasEntry : atlasEntries_) {
+			if (atlasEntry.pageHandle == oldPage) {
+				atlasEntry.pageHandle = newPage;
+			}
+		}
+		runtimeAtlasPages_[i] = newPage;
+
+		Texture& oldTexture = textures_[oldPage];
+		directXCommon_->GetSrvAllocator()->Free(oldTexture.srv);
+		directXCommon_->GetGpuMemoryAllocator()->Free(oldTexture.buffer);
+		oldTexture = {};
+	}
+	runtimeAtlas_.ClearDirty();
 
-	return nextLoadIndex_++;
+	return RegisterAtlasEntry(filePath, runtimeAtlasPages_[entry->page], entry->rect);
 }
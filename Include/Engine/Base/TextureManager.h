@@ -2,84 +2,185 @@
 #ifndef TEXTUREMANAGER_H_
 #define TEXTUREMANAGER_H_
 
-#include <array>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <wrl.h>
 
 #include "DirectXCommon.h"
+#include "TextureAtlas.h"
+
+namespace DirectX {
+	class ScratchImage;
+}
 
 class TextureManager
 {
-private: // ^
+private: // 型
 	template<class TYPE>
 	using ComPtr = Microsoft::WRL::ComPtr<TYPE>;
 
 	struct Texture {
-		ComPtr<ID3D12Resource> buffer; // obt@
-		D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle = {}; // CPUnh
-		D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle = {}; // GPUnh
-		std::string name; // t@C
+		GpuAllocation buffer; // バッファ(共有のヒープに配置)
+		DescriptorHandle srv; // シェーダーリソースビュー
+		std::string name; // ファイル名
+		TextureUploader::Ticket uploadTicket = TextureUploader::kReadyTicket; // 中身のコピーの完了を調べる番号
+	};
+
+	// アトラス内の画像
+	struct AtlasEntry {
+		UINT pageHandle; // ページのテクスチャハンドル
+		Vector2 base; // ページ内の左上(ピクセル)
+		Vector2 size; // 大きさ(ピクセル)
 	};
 
-private: // 萔
-	static constexpr size_t kDescriptorCount = 50;
+private: // 定数
+	// アトラス内の画像のハンドルはここから(テクスチャはこれより少ない)
+	static constexpr UINT kAtlasHandleBase = 1u << 16;
+	// 実行時に追加する画像のアトラスの設定
+	static constexpr TextureAtlasBuilder::Options kRuntimeAtlasOptions = { 1024, 1024, 2, 4 };
 
-public: // ÓIo֐
+public: // 静的メンバ関数
 	/// <summary>
-	/// VOgCX^X擾
+	/// シングルトンインスタンスを取得
 	/// </summary>
 	/// <returns></returns>
 	static TextureManager* GetInstance();
 	/// <summary>
-	/// eNX`[h
+	/// テクスチャをロード
 	/// </summary>
 	/// <param name="filePath"></param>
-	/// <returns>eNX`nh</returns>
+	/// <returns>テクスチャハンドル</returns>
 	static UINT LoadTexture(const std::string& filePath);
+	/// <summary>
+	/// アトラスの一覧を読み込む
+	/// 以降 LoadTexture に一覧内の画像の名前を渡すとアトラス内の画像のハンドルを返す
+	/// </summary>
+	/// <param name="lookupPath">CookAtlas で書き出した一覧</param>
+	/// <returns>読み込めたか</returns>
+	static bool LoadAtlas(const std::string& lookupPath);
+	/// <summary>
+	/// フォルダ内の png をアトラスにまとめ、ページの png と一覧を書き出す
+	/// </summary>
+	/// <param name="imageDirectory">画像のフォルダ</param>
+	/// <param name="lookupPath">一覧の書き出し先(ページは同じフォルダに書き出す)</param>
+	/// <param name="options">設定</param>
+	/// <returns>書き出せたか</returns>
+	static bool CookAtlas(const std::string& imageDirectory, const std::string& lookupPath, const TextureAtlasBuilder::Options& options);
+	/// <summary>
+	/// 一覧がフォルダ内の画像より古いか(一覧が無い場合も true)
+	/// </summary>
+	/// <param name="imageDirectory">画像のフォルダ</param>
+	/// <param name="lookupPath">CookAtlas で書き出した一覧</param>
+	/// <returns>作り直す必要があるか</returns>
+	static bool IsAtlasOutdated(const std::string& imageDirectory, const std::string& lookupPath);
+	/// <summary>
+	/// 実行時のアトラスに画像を追加する
+	/// 書き換えたページは新しいテクスチャに転送し、古いページは GPU が使い終えてから解放する
+	/// ページに収まらない画像は通常のテクスチャとしてロードする
+	/// </summary>
+	/// <param name="filePath"></param>
+	/// <returns>テクスチャハンドル</returns>
+	static UINT LoadTextureToAtlas(const std::string& filePath);
 
-public: // o֐
+public: // メンバ関数
 	/// <summary>
-	/// \[XfXN擾
+	/// リソースデスクを取得する
 	/// </summary>
-	/// <param name="texHanfle">eNX`nh</param>
+	/// <param name="texHanfle">テクスチャハンドル</param>
 	/// <returns></returns>
 	D3D12_RESOURCE_DESC GetResourceDesc(UINT texHandle);
 	/// <summary>
-	/// 
+	/// テクスチャの中身のコピーを GPU が終えたか
+	/// 描画はコピーを終えてから始まるので、描く前に調べる必要は無い
+	/// </summary>
+	/// <param name="texHandle">テクスチャハンドル</param>
+	/// <returns></returns>
+	bool IsTextureReady(UINT texHandle);
+	/// <summary>
+	/// 実際にセットするテクスチャのハンドルを取得(アトラス内の画像はページのハンドル)
+	/// ディスクリプタヒープ内の位置と同じで、シェーダーのテクスチャ配列の番号になる
+	/// </summary>
+	/// <param name="texHandle">テクスチャハンドル</param>
+	/// <returns></returns>
+	UINT ResolveTextureHandle(UINT texHandle) const;
+	/// <summary>
+	/// テクスチャ内の画像の範囲を取得(アトラス内の画像以外はテクスチャ全体)
+	/// </summary>
+	/// <param name="texHandle">テクスチャハンドル</param>
+	/// <param name="base">左上(ピクセル)</param>
+	/// <param name="size">大きさ(ピクセル)</param>
+	void GetTextureRect(UINT texHandle, Vector2& base, Vector2& size);
+	/// <summary>
+	/// 初期化
 	/// </summary>
 	void Initalize();
 	/// <summary>
-	/// [heNX`
+	/// ロードしたテクスチャを解放
+	/// ディスクリプタとメモリは先行しているフレームを GPU が終えてから再利用される
 	/// </summary>
 	void ResetAll();
 	/// <summary>
-	/// R}hXgɃZbg
+	/// コマンドリストにセットする
 	/// </summary>
 	/// <param name="cmdlist"></param>
 	/// <param name="rootParamIndex"></param>
 	/// <param name="texNumber"></param>
-	void SetGraphicsRootDescriptorTable(ID3D12GraphicsCommandList* cmdlist, UINT rootParamIndex, UINT texNumber);
+	void SetGraphicsRootDescriptorTable(TrackedCommandList* cmdlist, UINT rootParamIndex, UINT texNumber);
+	/// <summary>
+	/// 全テクスチャを並べたテーブルをコマンドリストにセットする
+	/// シェーダーは ResolveTextureHandle したハンドルを番号にしてテクスチャ配列から選ぶ
+	/// </summary>
+	/// <param name="cmdlist"></param>
+	/// <param name="rootParamIndex">テクスチャ配列(Bindless.hlsli)のルートパラメータ番号</param>
+	void SetGraphicsRootBindlessTable(TrackedCommandList* cmdlist, UINT rootParamIndex);
 
-private: // o֐
+private: // メンバ関数
 	TextureManager() = default;
 	~TextureManager() = default;
 	TextureManager(const TextureManager&) = delete;
 	const TextureManager& operator=(const TextureManager&) = delete;
 	/// <summary>
-	/// eNX`[h()
+	/// テクスチャをロード(内部)
 	/// </summary>
 	/// <param name="filePath"></param>
 	/// <returns></returns>
 	UINT InternalLoadTexture(const std::string& filePath);
+	/// <summary>
+	/// 画像からテクスチャを生成
+	/// </summary>
+	/// <param name="scratchImg">画像(ミップマップを生成する)</param>
+	/// <param name="name">名前</param>
+	/// <returns></returns>
+	UINT CreateTexture(DirectX::ScratchImage& scratchImg, const std::string& name);
+	/// <summary>
+	/// 画像をコピーキューでテクスチャに転送(ステージング領域に詰めるので画像はすぐ破棄してよい)
+	/// </summary>
+	/// <param name="texture">転送先(画像と同じ大きさとミップマップ数)</param>
+	/// <param name="scratchImg">画像</param>
+	void UploadTexture(Texture& texture, const DirectX::ScratchImage& scratchImg);
+	/// <summary>
+	/// アトラス内の画像を登録
+	/// </summary>
+	/// <returns>テクスチャハンドル</returns>
+	UINT RegisterAtlasEntry(const std::string& name, UINT pageHandle, const TextureAtlasBuilder::Rect& rect);
+	/// <summary>
+	/// 実行時のアトラスに画像を追加(内部)
+	/// </summary>
+	UINT InternalLoadTextureToAtlas(const std::string& filePath);
 
-private: // oϐ
+private: // メンバ変数
 	DirectXCommon* directXCommon_ = nullptr;
 
-	ComPtr<ID3D12DescriptorHeap> srvHeap_;
-	UINT descriptorIncrementSize_ = 0;
-	std::array<Texture, kDescriptorCount> textures_;
+	// テクスチャハンドル(ヒープ内の位置)で引く。間の空きは buffer が空
+	std::vector<Texture> textures_;
 
-	UINT nextLoadIndex_ = 0;
+	// アトラス内の画像(ハンドルは kAtlasHandleBase + 番号)
+	std::vector<AtlasEntry> atlasEntries_;
+	std::unordered_map<std::string, UINT> atlasHandles_;
+	// 実行時に追加する画像のアトラス
+	TextureAtlasBuilder runtimeAtlas_;
+	std::vector<UINT> runtimeAtlasPages_;
 
 };
 
@@ -0,0 +1,155 @@
+#include "TextureUploader.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+void TextureUploader::Initalize(CopyCommandQueue* queue, void* stagingBase, size_t stagingSize) {
+	assert(queue != nullptr);
+	assert(stagingSize >= 2 * D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+	queue_ = queue;
+	// GPU 仮想アドレスを 0 にしてステージング領域内の位置を受け取る
+	staging_.Initalize(stagingBase, 0, stagingSize,
+		[this](uint64_t fenceValue) { return queue_->Wait(fenceValue); });
+	// 現在の束が半分までなら、他の束を全て待てば必ず次のコピーが入る
+	batchLimit_ = stagingSize / 2;
+
+	batchTicket_ = kReadyTicket + 1;
+	batchBytes_ = 0;
+	batchCopyCount_ = 0;
+	pendingBatches_.clear();
+	completedTicket_ = kReadyTicket;
+	lastFenceValue_ = 0;
+	statistics_ = {};
+}
+
+TextureUploader::Ticket TextureUploader::Upload(ID3D12Resource* destination, std::span<const Subresource> subresources) {
+	assert(queue_ != nullptr);
+	assert(destination != nullptr);
+	if (subresources.empty()) {
+		return kReadyTicket;
+	}
+	// 前の束を GPU が終えていれば空けておく(待たない)
+	Retire(queue_->GetCompletedValue());
+
+	for (uint32_t i = 0; i < subresources.size(); i++) {
+		const Subresource& subresource = subresources[i];
+		const D3D12_SUBRESOURCE_FOOTPRINT& footprint = subresource.layout.Footprint;
+		assert(footprint.Depth == 1 && "3D テクスチャは未対応");
+		assert(subresource.numRows > 0 && footprint.Height % subresource.numRows == 0);
+		assert(footprint.RowPitch % D3D12_TEXTURE_DATA_PITCH_ALIGNMENT == 0);
+		assert(subresource.rowSize <= footprint.RowPitch);
+
+		// 圧縮フォーマットは一行が 4 ピクセル分の高さ
+		const uint32_t rowHeight = footprint.Height / subresource.numRows;
+		const size_t rowPitch = footprint.RowPitch;
+		const size_t maxRows = (batchLimit_ - D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT) / rowPitch;
+		assert(maxRows > 0 && "ステージング領域が一行より小さい");
+
+		const uint8_t* source = static_cast<const uint8_t*>(subresource.data.pData);
+		const size_t sourcePitch = static_cast<size_t>(subresource.data.RowPitch);
+		for (uint32_t firstRow = 0; firstRow < subresource.numRows;) {
+			// 束に入るだけ行を詰め、入らなければ束を送ってから詰める
+			size_t rowCount = std::min<size_t>(maxRows, subresource.numRows - firstRow);
+			size_t size = rowCount * rowPitch + D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT;
+			if (batchBytes_ + size > batchLimit_) {
+				size_t remainingRows = (batchLimit_ - std::min(batchBytes_ + D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT, batchLimit_)) / rowPitch;
+				if (remainingRows == 0) {
+					Submit();
+				}
+				else {
+					rowCount = remainingRows;
+				}
+			}
+			size = rowCount * rowPitch;
+
+			UploadRingBuffer::Allocation allocation = staging_.Allocate(size, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+			if (allocation.cpuAddress == nullptr) {
+				// 積んでいる束だけで埋まっている(束を半分までにしているので起きないはず)
+				// 途中まで積んだコピーを捨てずに束を送り、GPU を待って空けてから詰め直す
+				Submit();
+				allocation = staging_.Allocate(size, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+				assert(allocation.cpuAddress != nullptr);
+			}
+			batchBytes_ += size + D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT;
+
+			// 行の間隔が同じなら一度にコピーする
+			uint8_t* staged = static_cast<uint8_t*>(allocation.cpuAddress);
+			const uint8_t* rows = source + firstRow * sourcePitch;
+			if (sourcePitch == rowPitch) {
+				std::memcpy(staged, rows, (rowCount - 1) * rowPitch + subresource.rowSize);
+			}
+			else {
+				for (size_t row = 0; row < rowCount; row++) {
+					std::memcpy(staged + row * rowPitch, rows + row * sourcePitch, subresource.rowSize);
+				}
+			}
+
+			D3D12_SUBRESOURCE_FOOTPRINT chunk = footprint;
+			chunk.Height = static_cast<UINT>(rowCount) * rowHeight;
+			queue_->CopyTextureRegion(destination, i, firstRow * rowHeight, allocation.gpuAddress, chunk);
+			batchCopyCount_++;
+			statistics_.copyCount++;
+			statistics_.stagedBytes += size;
+			firstRow += static_cast<uint32_t>(rowCount);
+		}
+	}
+
+	statistics_.textureCount++;
+	return batchTicket_;
+}
+
+uint64_t TextureUploader::Submit() {
+	assert(queue_ != nullptr);
+	if (batchCopyCount_ == 0) {
+		return 0;
+	}
+	queue_->Execute();
+	uint64_t fenceValue = queue_->Signal();
+	staging_.FinishFrame(fenceValue);
+	pendingBatches_.push_back(PendingBatch{ batchTicket_, fenceValue });
+	lastFenceValue_ = fenceValue;
+
+	batchTicket_++;
+	batchBytes_ = 0;
+	batchCopyCount_ = 0;
+	statistics_.submitCount++;
+	return fenceValue;
+}
+
+bool TextureUploader::IsReady(Ticket ticket) {
+	assert(ticket <= batchTicket_);
+	if (ticket <= completedTicket_) {
+		return true;
+	}
+	// 積んでいるだけの束は送るまで終わらない
+	if (ticket == batchTicket_) {
+		return false;
+	}
+	Retire(queue_->GetCompletedValue());
+	return ticket <= completedTicket_;
+}
+
+void TextureUploader::WaitIdle() {
+	if (queue_ == nullptr) {
+		return;
+	}
+	Submit();
+	if (!pendingBatches_.empty()) {
+		Retire(queue_->Wait(lastFenceValue_));
+	}
+}
+
+TextureUploader::Statistics TextureUploader::GetStatistics() const {
+	Statistics statistics = statistics_;
+	statistics.staging = staging_.GetStatistics();
+	return statistics;
+}
+
+void TextureUploader::Retire(uint64_t completedFenceValue) {
+	while (!pendingBatches_.empty() && pendingBatches_.front().fenceValue <= completedFenceValue) {
+		completedTicket_ = pendingBatches_.front().ticket;
+		pendingBatches_.pop_front();
+	}
+	staging_.Release(completedFenceValue);
+}
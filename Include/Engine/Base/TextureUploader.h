@@ -0,0 +1,150 @@
+#pragma once
+#ifndef TEXTUREUPLOADER_H_
+#define TEXTUREUPLOADER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <d3d12.h>
+#include <deque>
+#include <span>
+
+#include "FramePacer.h"
+#include "UploadRingBuffer.h"
+
+/// <summary>
+/// コピーキュー
+/// TextureUploader はこれを通してのみ GPU にコピーを送る(テストでは CPU でコピーする偽物に差し替える)
+/// </summary>
+class CopyCommandQueue : public GpuQueue
+{
+public:
+	/// <summary>
+	/// ステージング領域からテクスチャへのコピーを記録
+	/// </summary>
+	/// <param name="destination">コピー先のテクスチャ</param>
+	/// <param name="subresource">コピー先のサブリソース</param>
+	/// <param name="destinationY">コピー先の上端(ピクセル)</param>
+	/// <param name="sourceOffset">ステージング領域内の位置</param>
+	/// <param name="footprint">ステージング領域での形</param>
+	virtual void CopyTextureRegion(ID3D12Resource* destination, uint32_t subresource, uint32_t destinationY,
+		uint64_t sourceOffset, const D3D12_SUBRESOURCE_FOOTPRINT& footprint) = 0;
+	/// <summary>
+	/// 記録したコピーを送る(この後に Signal する)
+	/// </summary>
+	virtual void Execute() = 0;
+};
+
+/// <summary>
+/// テクスチャの中身をステージング領域(アップロードヒープ)に詰め、コピーキューでテクスチャにコピーする
+/// Submit までに積んだテクスチャは一度に送り、フェンスで読み込みの完了を知る
+/// 大きなサブリソースは行ごとに分けて送るので、ステージング領域より大きなテクスチャも送れる
+/// スレッドセーフではない
+/// </summary>
+class TextureUploader
+{
+public:
+	// 読み込みの完了を調べる番号(送った束ごとに増える)
+	using Ticket = uint64_t;
+	// 読み込むものが無い
+	static constexpr Ticket kReadyTicket = 0;
+
+	/// <summary>
+	/// 送るサブリソース
+	/// </summary>
+	struct Subresource {
+		// 元の画素(行の間隔は RowPitch)
+		D3D12_SUBRESOURCE_DATA data = {};
+		// GetCopyableFootprints で求めたコピー先の形(Offset は使わない)
+		D3D12_PLACED_SUBRESOURCE_FOOTPRINT layout = {};
+		UINT numRows = 0;
+		UINT64 rowSize = 0;
+	};
+
+	/// <summary>
+	/// 統計
+	/// </summary>
+	struct Statistics {
+		size_t textureCount = 0;
+		// 記録したコピーの数(分けて送ったサブリソースは複数)
+		size_t copyCount = 0;
+		// 送った束の数
+		size_t submitCount = 0;
+		// ステージング領域に詰めたバイト数
+		size_t stagedBytes = 0;
+		UploadRingBuffer::Statistics staging;
+	};
+
+public:
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="queue">コピーキュー</param>
+	/// <param name="stagingBase">ステージング領域の先頭(マップ済みのアドレス)</param>
+	/// <param name="stagingSize">ステージング領域のバイト数(半分まで一つの束に詰める)</param>
+	void Initalize(CopyCommandQueue* queue, void* stagingBase, size_t stagingSize);
+	/// <summary>
+	/// テクスチャの中身を積む(送るのは Submit)
+	/// </summary>
+	/// <param name="destination">コピー先のテクスチャ(COMMON 状態)</param>
+	/// <param name="subresources">先頭から順にサブリソース 0, 1, ...</param>
+	/// <returns>IsReady に渡す番号</returns>
+	Ticket Upload(ID3D12Resource* destination, std::span<const Subresource> subresources);
+	/// <summary>
+	/// 積んだコピーを送る
+	/// </summary>
+	/// <returns>シグナルしたフェンス値(送るものが無ければ 0)</returns>
+	uint64_t Submit();
+	/// <summary>
+	/// 読み込みを終えたか
+	/// </summary>
+	/// <param name="ticket">Upload の戻り値</param>
+	/// <returns></returns>
+	bool IsReady(Ticket ticket);
+	/// <summary>
+	/// 積んだコピーを送り、全て終えるまで待つ
+	/// </summary>
+	void WaitIdle();
+
+	/// <summary>
+	/// 最後にシグナルしたフェンス値を取得
+	/// </summary>
+	/// <returns></returns>
+	inline uint64_t GetLastFenceValue() const { return lastFenceValue_; }
+	/// <summary>
+	/// 統計を取得
+	/// </summary>
+	/// <returns></returns>
+	Statistics GetStatistics() const;
+
+private:
+	// 送った束
+	struct PendingBatch {
+		Ticket ticket;
+		uint64_t fenceValue;
+	};
+
+	/// <summary>
+	/// GPU が終えた束を完了にし、ステージング領域を空ける
+	/// </summary>
+	void Retire(uint64_t completedFenceValue);
+
+private:
+	CopyCommandQueue* queue_ = nullptr;
+	// GPU 仮想アドレスの代わりにステージング領域内の位置を返す
+	UploadRingBuffer staging_;
+	// 一つの束(とコピー)に詰める最大
+	size_t batchLimit_ = 0;
+
+	// 積んでいる束
+	Ticket batchTicket_ = kReadyTicket + 1;
+	size_t batchBytes_ = 0;
+	size_t batchCopyCount_ = 0;
+	std::deque<PendingBatch> pendingBatches_;
+	Ticket completedTicket_ = kReadyTicket;
+	uint64_t lastFenceValue_ = 0;
+
+	Statistics statistics_;
+
+};
+
+#endif
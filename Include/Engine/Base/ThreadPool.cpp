@@ -0,0 +1,132 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <memory>
+
+ThreadPool* ThreadPool::GetInstance() {
+	static ThreadPool instance;
+	return &instance;
+}
+
+ThreadPool::~ThreadPool() {
+	Finalize();
+}
+
+void ThreadPool::Initalize(size_t workerCount) {
+	assert(workers_.empty());
+
+	if (workerCount == 0) {
+		size_t hardwareCount = std::thread::hardware_concurrency();
+		workerCount = hardwareCount > 1 ? hardwareCount - 1 : 0;
+	}
+
+	isStop_ = false;
+	workers_.reserve(workerCount);
+	for (size_t i = 0; i < workerCount; i++) {
+		workers_.emplace_back(&ThreadPool::WorkerMain, this);
+	}
+}
+
+void ThreadPool::Finalize() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		isStop_ = true;
+	}
+	condition_.notify_all();
+	for (auto& it : workers_) {
+		it.join();
+	}
+	workers_.clear();
+}
+
+void ThreadPool::Enqueue(std::function<void()> job) {
+	// ワーカーがいない場合はその場で実行
+	if (workers_.empty()) {
+		job();
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		jobs_.emplace_back(std::move(job));
+	}
+	condition_.notify_one();
+}
+
+void ThreadPool::EnqueueBackground(std::function<void()> job) {
+	if (workers_.empty()) {
+		job();
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		backgroundJobs_.emplace_back(std::move(job));
+	}
+	condition_.notify_one();
+}
+
+void ThreadPool::ParallelFor(size_t count, size_t minBatchSize, const RangeFunction& func) {
+	ParallelFor(count, minBatchSize, GetConcurrency(), func);
+}
+
+void ThreadPool::ParallelFor(size_t count, size_t minBatchSize, size_t maxConcurrency, const RangeFunction& func) {
+	if (count == 0) {
+		return;
+	}
+	minBatchSize = std::max<size_t>(minBatchSize, 1);
+	size_t jobCount = std::min({ (count + minBatchSize - 1) / minBatchSize, GetConcurrency(), std::max<size_t>(maxConcurrency, 1) });
+	// 分割するほどの量がない
+	if (jobCount <= 1) {
+		func(0, count);
+		return;
+	}
+
+	size_t batchSize = (count + jobCount - 1) / jobCount;
+	// 範囲は早い者勝ちで取る(呼び出し元が先に全て取ればワーカーのジョブは何もしない)
+	struct Batches {
+		std::atomic<size_t> next = 0;
+		std::atomic<size_t> finished = 0;
+	};
+	auto batches = std::make_shared<Batches>();
+	// 取った範囲を処理する。func は全ての範囲を終えるまで呼び出し元が持っている
+	auto runBatches = [&func, batches, batchSize, jobCount, count]() {
+		for (size_t i = batches->next.fetch_add(1); i < jobCount; i = batches->next.fetch_add(1)) {
+			size_t begin = i * batchSize;
+			size_t end = std::min(begin + batchSize, count);
+			if (begin < end) {
+				func(begin, end);
+			}
+			if (batches->finished.fetch_add(1) + 1 == jobCount) {
+				batches->finished.notify_all();
+			}
+		}
+		};
+	for (size_t i = 1; i < jobCount; i++) {
+		Enqueue(runBatches);
+	}
+	runBatches();
+
+	// 残りはワーカーが処理中なので終わるのを待つ
+	for (size_t value = batches->finished.load(); value != jobCount; value = batches->finished.load()) {
+		batches->finished.wait(value);
+	}
+}
+
+void ThreadPool::WorkerMain() {
+	while (true) {
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			condition_.wait(lock, [this]() { return isStop_ || !jobs_.empty() || !backgroundJobs_.empty(); });
+			if (isStop_ && jobs_.empty() && backgroundJobs_.empty()) {
+				return;
+			}
+			// 急ぐジョブを先に
+			auto& queue = !jobs_.empty() ? jobs_ : backgroundJobs_;
+			job = std::move(queue.front());
+			queue.pop_front();
+		}
+		job();
+	}
+}
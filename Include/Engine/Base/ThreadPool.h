@@ -0,0 +1,86 @@
+#pragma once
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool final
+{
+public:
+	// 範囲処理 [begin, end)
+	using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+public: // 静的メンバ関数
+	/// <summary>
+	/// シングルトンインスタンスを取得
+	/// </summary>
+	/// <returns>インスタンスのポインタ</returns>
+	static ThreadPool* GetInstance();
+
+public: // メンバ関数
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="workerCount">ワーカースレッド数(0の場合 論理コア数 - 1)</param>
+	void Initalize(size_t workerCount = 0);
+	/// <summary>
+	/// ワーカースレッドを終了
+	/// </summary>
+	void Finalize();
+	/// <summary>
+	/// 呼び出し元を含めた並列数を取得
+	/// </summary>
+	/// <returns></returns>
+	inline size_t GetConcurrency() const { return workers_.size() + 1; }
+	/// <summary>
+	/// ジョブを追加
+	/// </summary>
+	/// <param name="job"></param>
+	void Enqueue(std::function<void()> job);
+	/// <summary>
+	/// 急がないジョブを追加(ワーカーは Enqueue したジョブが無いときだけ実行する)
+	/// </summary>
+	/// <param name="job"></param>
+	void EnqueueBackground(std::function<void()> job);
+	/// <summary>
+	/// 範囲を分割して並列に処理する(すべて終わるまで戻らない)
+	/// 待つ間は自分の範囲だけを手伝う(他のジョブを呼び出し元のスレッドで実行しない)
+	/// </summary>
+	/// <param name="count">要素数</param>
+	/// <param name="minBatchSize">1ジョブあたりの最小要素数</param>
+	/// <param name="func">処理</param>
+	void ParallelFor(size_t count, size_t minBatchSize, const RangeFunction& func);
+	/// <summary>
+	/// 並列数を指定して範囲を分割して処理する
+	/// </summary>
+	/// <param name="count">要素数</param>
+	/// <param name="minBatchSize">1ジョブあたりの最小要素数</param>
+	/// <param name="maxConcurrency">最大並列数</param>
+	/// <param name="func">処理</param>
+	void ParallelFor(size_t count, size_t minBatchSize, size_t maxConcurrency, const RangeFunction& func);
+
+private: // メンバ関数
+	ThreadPool() = default;
+	~ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	const ThreadPool& operator=(const ThreadPool&) = delete;
+
+	void WorkerMain();
+
+private: // メンバ変数
+	std::vector<std::thread> workers_;
+	std::deque<std::function<void()>> jobs_;
+	std::deque<std::function<void()>> backgroundJobs_;
+	std::mutex mutex_;
+	std::condition_variable condition_;
+	bool isStop_ = false;
+
+};
+
+#endif
@@ -0,0 +1,329 @@
+#include "TlsfAllocator.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace {
+	inline uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+void TlsfAllocator::Initalize(uint64_t capacity) {
+	capacity_ = capacity & ~(kMinBlockSize - 1);
+	usedSize_ = 0;
+	allocationCount_ = 0;
+	freeBlockCount_ = 0;
+	blocks_.clear();
+	unusedBlocks_.clear();
+	firstBlock_ = kInvalidBlock;
+	firstLevelBitmap_ = 0;
+	secondLevelBitmaps_.fill(0);
+	for (auto& heads : freeHeads_) {
+		heads.fill(kInvalidBlock);
+	}
+
+	if (capacity_ == 0) {
+		return;
+	}
+	// 全体を一つの空きにする
+	firstBlock_ = CreateBlock();
+	Block& block = blocks_[firstBlock_];
+	block.offset = 0;
+	block.size = capacity_;
+	InsertFreeBlock(firstBlock_);
+}
+
+TlsfAllocator::Allocation TlsfAllocator::Allocate(uint64_t size, uint64_t alignment, void* userData) {
+	assert(std::has_single_bit(alignment));
+	alignment = std::max(alignment, kMinBlockSize);
+	size = AlignUp(std::max<uint64_t>(size, 1), kMinBlockSize);
+	if (size > capacity_) {
+		return {};
+	}
+
+	// まず大きさだけで探し、境界を合わせて入らなければ余裕を持って探し直す
+	uint32_t index = FindFreeBlock(size);
+	if (index != kInvalidBlock) {
+		const Block& block = blocks_[index];
+		if (AlignUp(block.offset, alignment) + size > block.offset + block.size) {
+			index = kInvalidBlock;
+		}
+	}
+	if (index == kInvalidBlock && alignment > kMinBlockSize) {
+		index = FindFreeBlock(size + alignment - kMinBlockSize);
+	}
+	if (index == kInvalidBlock) {
+		// 切り上げたせいで見つからない場合(全体と同じ大きさなど)は同じ区分を一つずつ確かめる
+		index = FindFreeBlockInClass(size, alignment);
+	}
+	if (index == kInvalidBlock) {
+		return {};
+	}
+	return AllocateFromBlock(index, size, alignment, userData);
+}
+
+void TlsfAllocator::Free(Allocation& allocation) {
+	assert(allocation.IsValid() && allocation.block < blocks_.size());
+	uint32_t index = allocation.block;
+	assert(!blocks_[index].isFree && blocks_[index].offset == allocation.offset);
+	usedSize_ -= blocks_[index].size;
+	allocationCount_--;
+	blocks_[index].userData = nullptr;
+	allocation = {};
+
+	// 後ろの空きとつなげる
+	uint32_t next = blocks_[index].nextPhysical;
+	if (next != kInvalidBlock && blocks_[next].isFree) {
+		RemoveFreeBlock(next);
+		blocks_[index].size += blocks_[next].size;
+		blocks_[index].nextPhysical = blocks_[next].nextPhysical;
+		if (blocks_[next].nextPhysical != kInvalidBlock) {
+			blocks_[blocks_[next].nextPhysical].prevPhysical = index;
+		}
+		DestroyBlock(next);
+	}
+	// 前の空きとつなげる
+	uint32_t prev = blocks_[index].prevPhysical;
+	if (prev != kInvalidBlock && blocks_[prev].isFree) {
+		RemoveFreeBlock(prev);
+		blocks_[prev].size += blocks_[index].size;
+		blocks_[prev].nextPhysical = blocks_[index].nextPhysical;
+		if (blocks_[index].nextPhysical != kInvalidBlock) {
+			blocks_[blocks_[index].nextPhysical].prevPhysical = prev;
+		}
+		DestroyBlock(index);
+		index = prev;
+	}
+	InsertFreeBlock(index);
+}
+
+void TlsfAllocator::SetUserData(const Allocation& allocation, void* userData) {
+	assert(allocation.IsValid() && !blocks_[allocation.block].isFree);
+	blocks_[allocation.block].userData = userData;
+}
+
+uint32_t TlsfAllocator::Defragment(uint32_t maxMoveCount, const MoveFunction& move) {
+	// 移す候補は呼ぶ前の使用中の範囲(移した先は候補にしない)
+	std::vector<uint32_t> usedBlocks;
+	for (uint32_t index = firstBlock_; index != kInvalidBlock; index = blocks_[index].nextPhysical) {
+		if (!blocks_[index].isFree) {
+			usedBlocks.push_back(index);
+		}
+	}
+
+	uint32_t moveCount = 0;
+	for (auto it = usedBlocks.rbegin(); it != usedBlocks.rend() && moveCount < maxMoveCount; ++it) {
+		uint64_t size = blocks_[*it].size;
+		uint64_t alignment = blocks_[*it].alignment;
+		uint64_t end = blocks_[*it].offset;
+		// より前で入る最初の空き(区分で探すと後ろの空きを選ぶことがある)
+		uint32_t target = kInvalidBlock;
+		for (uint32_t index = firstBlock_; index != kInvalidBlock && blocks_[index].offset < end; index = blocks_[index].nextPhysical) {
+			const Block& block = blocks_[index];
+			uint64_t offset = AlignUp(block.offset, alignment);
+			if (block.isFree && offset + size <= block.offset + block.size && offset + size <= end) {
+				target = index;
+				break;
+			}
+		}
+		if (target == kInvalidBlock) {
+			continue;
+		}
+
+		Allocation from = { blocks_[*it].offset, size, *it };
+		void* userData = blocks_[*it].userData;
+		Allocation to = AllocateFromBlock(target, size, alignment, userData);
+		if (!move(from, to, userData)) {
+			Free(to);
+			continue;
+		}
+		moveCount++;
+	}
+	return moveCount;
+}
+
+TlsfAllocator::Statistics TlsfAllocator::GetStatistics() const {
+	Statistics statistics;
+	statistics.capacity = capacity_;
+	statistics.usedSize = usedSize_;
+	statistics.freeSize = capacity_ - usedSize_;
+	statistics.allocationCount = allocationCount_;
+	statistics.freeBlockCount = freeBlockCount_;
+
+	// 最大の空きは一番大きい区分にある
+	if (firstLevelBitmap_ != 0) {
+		uint32_t firstLevel = 63 - std::countl_zero(firstLevelBitmap_);
+		uint32_t secondLevel = 31 - std::countl_zero(secondLevelBitmaps_[firstLevel]);
+		for (uint32_t index = freeHeads_[firstLevel][secondLevel]; index != kInvalidBlock; index = blocks_[index].nextFree) {
+			statistics.largestFreeSize = std::max(statistics.largestFreeSize, blocks_[index].size);
+		}
+	}
+	if (statistics.freeSize != 0) {
+		statistics.fragmentation = 1.0 - static_cast<double>(statistics.largestFreeSize) / static_cast<double>(statistics.freeSize);
+	}
+	return statistics;
+}
+
+void TlsfAllocator::Mapping(uint64_t size, uint32_t& firstLevel, uint32_t& secondLevel) {
+	if (size < kSmallBlockSize) {
+		firstLevel = 0;
+		secondLevel = static_cast<uint32_t>(size / kMinBlockSize);
+		return;
+	}
+	uint32_t topBit = static_cast<uint32_t>(std::bit_width(size)) - 1;
+	firstLevel = topBit - kSmallBlockShift + 1;
+	secondLevel = static_cast<uint32_t>(size >> (topBit - kSecondLevelShift)) ^ kSecondLevelCount;
+}
+
+uint32_t TlsfAllocator::FindFreeBlock(uint64_t size) const {
+	// 区分の中の大きさはばらばらなので、一つ上の区分から探す(どれを選んでも入る)
+	if (size >= kSmallBlockSize) {
+		uint32_t topBit = static_cast<uint32_t>(std::bit_width(size)) - 1;
+		size += (uint64_t(1) << (topBit - kSecondLevelShift)) - 1;
+	}
+	if (size > capacity_) {
+		return kInvalidBlock;
+	}
+	uint32_t firstLevel = 0;
+	uint32_t secondLevel = 0;
+	Mapping(size, firstLevel, secondLevel);
+
+	uint32_t secondLevelMap = secondLevelBitmaps_[firstLevel] & (~0u << secondLevel);
+	if (secondLevelMap == 0) {
+		uint64_t firstLevelMap = firstLevelBitmap_ & (~uint64_t(0) << (firstLevel + 1));
+		if (firstLevelMap == 0) {
+			return kInvalidBlock;
+		}
+		firstLevel = static_cast<uint32_t>(std::countr_zero(firstLevelMap));
+		secondLevelMap = secondLevelBitmaps_[firstLevel];
+	}
+	secondLevel = static_cast<uint32_t>(std::countr_zero(secondLevelMap));
+	return freeHeads_[firstLevel][secondLevel];
+}
+
+uint32_t TlsfAllocator::FindFreeBlockInClass(uint64_t size, uint64_t alignment) const {
+	uint32_t firstLevel = 0;
+	uint32_t secondLevel = 0;
+	Mapping(size, firstLevel, secondLevel);
+	for (uint32_t index = freeHeads_[firstLevel][secondLevel]; index != kInvalidBlock; index = blocks_[index].nextFree) {
+		const Block& block = blocks_[index];
+		if (AlignUp(block.offset, alignment) + size <= block.offset + block.size) {
+			return index;
+		}
+	}
+	return kInvalidBlock;
+}
+
+TlsfAllocator::Allocation TlsfAllocator::AllocateFromBlock(uint32_t index, uint64_t size, uint64_t alignment, void* userData) {
+	RemoveFreeBlock(index);
+
+	// 境界までの前の余り(前は使用中なので新しい空きにする)
+	uint64_t padding = AlignUp(blocks_[index].offset, alignment) - blocks_[index].offset;
+	if (padding != 0) {
+		uint32_t front = CreateBlock();
+		Block& block = blocks_[index];
+		blocks_[front].offset = block.offset;
+		blocks_[front].size = padding;
+		blocks_[front].prevPhysical = block.prevPhysical;
+		blocks_[front].nextPhysical = index;
+		if (block.prevPhysical != kInvalidBlock) {
+			blocks_[block.prevPhysical].nextPhysical = front;
+		}
+		else {
+			firstBlock_ = front;
+		}
+		block.prevPhysical = front;
+		block.offset += padding;
+		block.size -= padding;
+		InsertFreeBlock(front);
+	}
+	// 後ろの余り(後ろも使用中なので新しい空きにする)
+	assert(blocks_[index].size >= size);
+	if (blocks_[index].size > size) {
+		uint32_t back = CreateBlock();
+		Block& block = blocks_[index];
+		blocks_[back].offset = block.offset + size;
+		blocks_[back].size = block.size - size;
+		blocks_[back].prevPhysical = index;
+		blocks_[back].nextPhysical = block.nextPhysical;
+		if (block.nextPhysical != kInvalidBlock) {
+			blocks_[block.nextPhysical].prevPhysical = back;
+		}
+		block.nextPhysical = back;
+		block.size = size;
+		InsertFreeBlock(back);
+	}
+
+	Block& block = blocks_[index];
+	block.alignment = alignment;
+	block.userData = userData;
+	usedSize_ += size;
+	allocationCount_++;
+	return Allocation{ block.offset, size, index };
+}
+
+void TlsfAllocator::InsertFreeBlock(uint32_t index) {
+	Block& block = blocks_[index];
+	uint32_t firstLevel = 0;
+	uint32_t secondLevel = 0;
+	Mapping(block.size, firstLevel, secondLevel);
+
+	uint32_t& head = freeHeads_[firstLevel][secondLevel];
+	block.isFree = true;
+	block.prevFree = kInvalidBlock;
+	block.nextFree = head;
+	if (head != kInvalidBlock) {
+		blocks_[head].prevFree = index;
+	}
+	head = index;
+	firstLevelBitmap_ |= uint64_t(1) << firstLevel;
+	secondLevelBitmaps_[firstLevel] |= 1u << secondLevel;
+	freeBlockCount_++;
+}
+
+void TlsfAllocator::RemoveFreeBlock(uint32_t index) {
+	Block& block = blocks_[index];
+	assert(block.isFree);
+	uint32_t firstLevel = 0;
+	uint32_t secondLevel = 0;
+	Mapping(block.size, firstLevel, secondLevel);
+
+	if (block.prevFree != kInvalidBlock) {
+		blocks_[block.prevFree].nextFree = block.nextFree;
+	}
+	else {
+		freeHeads_[firstLevel][secondLevel] = block.nextFree;
+	}
+	if (block.nextFree != kInvalidBlock) {
+		blocks_[block.nextFree].prevFree = block.prevFree;
+	}
+	// 区分の空きリストが空になったらビットを落とす
+	if (freeHeads_[firstLevel][secondLevel] == kInvalidBlock) {
+		secondLevelBitmaps_[firstLevel] &= ~(1u << secondLevel);
+		if (secondLevelBitmaps_[firstLevel] == 0) {
+			firstLevelBitmap_ &= ~(uint64_t(1) << firstLevel);
+		}
+	}
+	block.isFree = false;
+	block.prevFree = kInvalidBlock;
+	block.nextFree = kInvalidBlock;
+	freeBlockCount_--;
+}
+
+uint32_t TlsfAllocator::CreateBlock() {
+	if (!unusedBlocks_.empty()) {
+		uint32_t index = unusedBlocks_.back();
+		unusedBlocks_.pop_back();
+		blocks_[index] = {};
+		return index;
+	}
+	blocks_.emplace_back();
+	return static_cast<uint32_t>(blocks_.size() - 1);
+}
+
+void TlsfAllocator::DestroyBlock(uint32_t index) {
+	blocks_[index] = {};
+	unusedBlocks_.push_back(index);
+}
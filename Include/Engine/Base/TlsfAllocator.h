@@ -0,0 +1,165 @@
+#pragma once
+#ifndef TLSFALLOCATOR_H_
+#define TLSFALLOCATOR_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/// <summary>
+/// 範囲を TLSF(二段階の大きさの区分と空きリスト)で管理する。切り出しも解放も O(1)
+/// 管理情報は範囲の外に持つので、CPU から触れない GPU のヒープにも使える
+/// 解放した範囲は隣の空きとつなげる。スレッドセーフではない
+/// </summary>
+class TlsfAllocator
+{
+public:
+	static constexpr uint64_t kInvalidOffset = UINT64_MAX;
+	static constexpr uint32_t kInvalidBlock = UINT32_MAX;
+	// 位置と大きさはこの倍数に切り上げる
+	static constexpr uint64_t kMinBlockSize = 256;
+
+	/// <summary>
+	/// 切り出した範囲
+	/// </summary>
+	struct Allocation {
+		uint64_t offset = kInvalidOffset;
+		// 切り上げた大きさ
+		uint64_t size = 0;
+		// 管理情報の番号(解放に使う)
+		uint32_t block = kInvalidBlock;
+
+		inline bool IsValid() const { return block != kInvalidBlock; }
+	};
+
+	/// <summary>
+	/// 統計
+	/// </summary>
+	struct Statistics {
+		uint64_t capacity = 0;
+		uint64_t usedSize = 0;
+		uint64_t freeSize = 0;
+		// 一度に切り出せる最大
+		uint64_t largestFreeSize = 0;
+		uint32_t allocationCount = 0;
+		// 空き範囲の数(多いほど断片化している)
+		uint32_t freeBlockCount = 0;
+		// 断片化の度合い(0 は空きが一続き、1 に近いほど細切れ)
+		double fragmentation = 0.0;
+	};
+
+	// 切り出した範囲を移す(from の中身を to に移し終えたら true)
+	// true を返した場合 from は呼び出し側が Free する(GPU が読み終えるまで待てるように)
+	using MoveFunction = std::function<bool(const Allocation& from, const Allocation& to, void* userData)>;
+
+public:
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="capacity">バイト数(kMinBlockSize の倍数に切り下げる)</param>
+	void Initalize(uint64_t capacity);
+	/// <summary>
+	/// 切り出す
+	/// </summary>
+	/// <param name="size">バイト数</param>
+	/// <param name="alignment">配置境界(2の累乗)</param>
+	/// <param name="userData">Defragment で渡す値</param>
+	/// <returns>空きがない場合は無効</returns>
+	Allocation Allocate(uint64_t size, uint64_t alignment = kMinBlockSize, void* userData = nullptr);
+	/// <summary>
+	/// 解放
+	/// </summary>
+	/// <param name="allocation">Allocate の戻り値(解放後は無効になる)</param>
+	void Free(Allocation& allocation);
+	/// <summary>
+	/// 切り出した範囲の値を設定
+	/// </summary>
+	/// <param name="allocation">Allocate の戻り値</param>
+	/// <param name="userData">Defragment で渡す値</param>
+	void SetUserData(const Allocation& allocation, void* userData);
+	/// <summary>
+	/// 後ろの範囲から順に、より前の空きへ移して空きをまとめる
+	/// </summary>
+	/// <param name="maxMoveCount">移す最大の数</param>
+	/// <param name="move">移す関数(false を返した範囲は移さない)</param>
+	/// <returns>移した数</returns>
+	uint32_t Defragment(uint32_t maxMoveCount, const MoveFunction& move);
+
+	inline uint64_t GetCapacity() const { return capacity_; }
+	inline uint64_t GetUsedSize() const { return usedSize_; }
+	inline uint32_t GetAllocationCount() const { return allocationCount_; }
+	/// <summary>
+	/// 統計を取得
+	/// </summary>
+	/// <returns></returns>
+	Statistics GetStatistics() const;
+
+private:
+	// 二段目の区分の数(一段目の 2 の累乗ごとにこの数に分ける)
+	static constexpr uint32_t kSecondLevelShift = 4;
+	static constexpr uint32_t kSecondLevelCount = 1u << kSecondLevelShift;
+	// これより小さい範囲は一段目を 0 にして kMinBlockSize ごとに分ける
+	static constexpr uint32_t kSmallBlockShift = 12;
+	static constexpr uint64_t kSmallBlockSize = uint64_t(1) << kSmallBlockShift;
+	static_assert(kSmallBlockSize / kSecondLevelCount == kMinBlockSize);
+	static constexpr uint32_t kFirstLevelCount = 64 - kSmallBlockShift + 1;
+
+	struct Block {
+		uint64_t offset = 0;
+		uint64_t size = 0;
+		// 位置の前後(つなげるときに使う)
+		uint32_t prevPhysical = kInvalidBlock;
+		uint32_t nextPhysical = kInvalidBlock;
+		// 同じ区分の空きリスト
+		uint32_t prevFree = kInvalidBlock;
+		uint32_t nextFree = kInvalidBlock;
+		uint64_t alignment = kMinBlockSize;
+		void* userData = nullptr;
+		bool isFree = false;
+	};
+
+	/// <summary>
+	/// 大きさの区分を求める
+	/// </summary>
+	static void Mapping(uint64_t size, uint32_t& firstLevel, uint32_t& secondLevel);
+	/// <summary>
+	/// size 以上が必ず入る空きを探す
+	/// </summary>
+	/// <returns>無ければ kInvalidBlock</returns>
+	uint32_t FindFreeBlock(uint64_t size) const;
+	/// <summary>
+	/// size の区分の空きリストから境界を合わせて入るものを探す
+	/// </summary>
+	/// <returns>無ければ kInvalidBlock</returns>
+	uint32_t FindFreeBlockInClass(uint64_t size, uint64_t alignment) const;
+	/// <summary>
+	/// 空きから切り出す(前後の余りは空きに戻す)
+	/// </summary>
+	Allocation AllocateFromBlock(uint32_t index, uint64_t size, uint64_t alignment, void* userData);
+	void InsertFreeBlock(uint32_t index);
+	void RemoveFreeBlock(uint32_t index);
+	uint32_t CreateBlock();
+	void DestroyBlock(uint32_t index);
+
+private:
+	uint64_t capacity_ = 0;
+	uint64_t usedSize_ = 0;
+	uint32_t allocationCount_ = 0;
+	uint32_t freeBlockCount_ = 0;
+
+	std::vector<Block> blocks_;
+	// 使っていない管理情報の番号
+	std::vector<uint32_t> unusedBlocks_;
+	// 位置が先頭の範囲
+	uint32_t firstBlock_ = kInvalidBlock;
+
+	// 空きリストがある区分のビット
+	uint64_t firstLevelBitmap_ = 0;
+	std::array<uint32_t, kFirstLevelCount> secondLevelBitmaps_ = {};
+	std::array<std::array<uint32_t, kSecondLevelCount>, kFirstLevelCount> freeHeads_ = {};
+
+};
+
+#endif
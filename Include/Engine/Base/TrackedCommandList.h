@@ -0,0 +1,355 @@
+#pragma once
+#ifndef TRACKEDCOMMANDLIST_H_
+#define TRACKEDCOMMANDLIST_H_
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <d3d12.h>
+
+#include "ResourceStateTracker.h"
+
+/// <summary>
+/// 直前と同じ状態をセットするコマンドを省くコマンドリスト
+/// パイプライン、ルートシグネチャ、ディスクリプタヒープ、ルートパラメータ、
+/// 頂点、インデックスバッファビュー、トポロジーを覚えておく
+/// 直接コマンドリストで状態を変えた後は Invalidate を呼ぶ
+/// リソースの遷移はためておき、次の描画かディスパッチの直前にまとめて発行する
+/// (直接コマンドリストでリソースを使う場合は先に FlushResourceBarriers を呼ぶ)
+/// </summary>
+/// <typeparam name="COMMAND_LIST">コマンドリストの型(テスト用に差し替えられる)</typeparam>
+template<class COMMAND_LIST>
+class BasicTrackedCommandList
+{
+public:
+	/// <summary>
+	/// 統計
+	/// </summary>
+	struct Statistics {
+		// 実際に発行した状態のセット
+		size_t issuedCount = 0;
+		// 省いた状態のセット
+		size_t filteredCount = 0;
+		// 描画、ディスパッチの数
+		size_t drawCount = 0;
+		// リソースバリア(BeginFrame でフレーム分をまとめる)
+		ResourceStateTracker::Statistics barrier;
+	};
+
+	// 覚えておくルートパラメータ数
+	static constexpr uint32_t kMaxRootParameterCount = 16;
+	// 覚えておく頂点バッファのスロット数
+	static constexpr uint32_t kMaxVertexBufferSlotCount = 4;
+	// ディスクリプタヒープの種類数(CBV_SRV_UAV と SAMPLER)
+	static constexpr uint32_t kMaxDescriptorHeapCount = 2;
+
+public:
+	/// <summary>
+	/// フレームの始めにコマンドリストをセット(覚えた状態と統計をリセット)
+	/// </summary>
+	/// <param name="cmdList">コマンドリスト</param>
+	void BeginFrame(COMMAND_LIST* cmdList);
+	/// <summary>
+	/// 覚えた状態を忘れる
+	/// </summary>
+	void Invalidate();
+
+	void SetPipelineState(ID3D12PipelineState* pipelineState);
+	void SetGraphicsRootSignature(ID3D12RootSignature* rootSignature);
+	void SetDescriptorHeaps(UINT numDescriptorHeaps, ID3D12DescriptorHeap* const* descriptorHeaps);
+	void SetGraphicsRootDescriptorTable(UINT rootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE baseDescriptor);
+	void SetGraphicsRootConstantBufferView(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS bufferLocation);
+	void SetGraphicsRootShaderResourceView(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS bufferLocation);
+	void SetGraphicsRoot32BitConstant(UINT rootParameterIndex, UINT srcData, UINT destOffsetIn32BitValues);
+	void IASetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY primitiveTopology);
+	void IASetVertexBuffers(UINT startSlot, UINT numViews, const D3D12_VERTEX_BUFFER_VIEW* views);
+	void IASetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW* view);
+
+	void DrawInstanced(UINT vertexCountPerInstance, UINT instanceCount, UINT startVertexLocation, UINT startInstanceLocation);
+	void DrawIndexedInstanced(UINT indexCountPerInstance, UINT instanceCount, UINT startIndexLocation, INT baseVertexLocation, UINT startInstanceLocation);
+	void Dispatch(UINT threadGroupCountX, UINT threadGroupCountY, UINT threadGroupCountZ);
+
+	/// <summary>
+	/// リソースの遷移をためる
+	/// </summary>
+	/// <param name="resource">リソース(GetStateTracker で登録済み)</param>
+	/// <param name="after">遷移後の状態</param>
+	/// <param name="subresource">サブリソース</param>
+	inline void TransitionResource(ID3D12Resource* resource, D3D12_RESOURCE_STATES after, UINT subresource = ResourceStateTracker::kAllSubresources) {
+		stateTracker_.Transition(resource, after, subresource);
+	}
+	/// <summary>
+	/// 分割バリアを始める(同じ遷移を TransitionResource で要求したときに終わる)
+	/// </summary>
+	/// <param name="resource">リソース(GetStateTracker で登録済み)</param>
+	/// <param name="after">遷移後の状態</param>
+	/// <param name="subresource">サブリソース</param>
+	inline void BeginTransitionResource(ID3D12Resource* resource, D3D12_RESOURCE_STATES after, UINT subresource = ResourceStateTracker::kAllSubresources) {
+		stateTracker_.BeginTransition(resource, after, subresource);
+	}
+	/// <summary>
+	/// ためたバリアを一度に発行
+	/// </summary>
+	inline void FlushResourceBarriers() {
+		assert(cmdList_ != nullptr);
+		stateTracker_.Flush(cmdList_);
+	}
+	/// <summary>
+	/// リソースの状態を取得
+	/// </summary>
+	/// <returns></returns>
+	inline ResourceStateTracker* GetStateTracker() { return &stateTracker_; }
+
+	/// <summary>
+	/// コマンドリストを取得
+	/// </summary>
+	/// <returns></returns>
+	inline COMMAND_LIST* Get() const { return cmdList_; }
+	/// <summary>
+	/// 現在のフレームの統計を取得
+	/// </summary>
+	/// <returns></returns>
+	inline const Statistics& GetStatistics() const { return statistics_; }
+	/// <summary>
+	/// 前のフレームの統計を取得
+	/// </summary>
+	/// <returns></returns>
+	inline const Statistics& GetLastFrameStatistics() const { return lastFrameStatistics_; }
+
+private:
+	// ルートパラメータの種類
+	enum RootParameterType : uint32_t {
+		kRootParameterNone,
+		kRootParameterDescriptorTable,
+		kRootParameterConstantBufferView,
+		kRootParameterShaderResourceView,
+		// 最後にセットした一つの値だけ覚える
+		kRootParameterConstant,
+	};
+
+	struct RootParameter {
+		RootParameterType type = kRootParameterNone;
+		uint64_t value = 0;
+	};
+
+	/// <summary>
+	/// ルートパラメータを比べて覚える
+	/// </summary>
+	/// <returns>セットが必要か</returns>
+	bool UpdateRootParameter(UINT rootParameterIndex, RootParameterType type, uint64_t value);
+	/// <summary>
+	/// 発行したか省いたかを数える
+	/// </summary>
+	/// <returns>isChanged</returns>
+	inline bool Count(bool isChanged) {
+		if (isChanged) {
+			statistics_.issuedCount++;
+		}
+		else {
+			statistics_.filteredCount++;
+		}
+		return isChanged;
+	}
+
+private:
+	COMMAND_LIST* cmdList_ = nullptr;
+	// リソースの状態はフレームをまたいで覚えておく
+	ResourceStateTracker stateTracker_;
+
+	ID3D12PipelineState* pipelineState_ = nullptr;
+	ID3D12RootSignature* rootSignature_ = nullptr;
+	UINT descriptorHeapCount_ = 0;
+	std::array<ID3D12DescriptorHeap*, kMaxDescriptorHeapCount> descriptorHeaps_ = {};
+	std::array<RootParameter, kMaxRootParameterCount> rootParameters_ = {};
+	D3D12_PRIMITIVE_TOPOLOGY primitiveTopology_ = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+	std::array<D3D12_VERTEX_BUFFER_VIEW, kMaxVertexBufferSlotCount> vertexBufferViews_ = {};
+	D3D12_INDEX_BUFFER_VIEW indexBufferView_ = {};
+
+	Statistics statistics_;
+	Statistics lastFrameStatistics_;
+
+};
+
+using TrackedCommandList = BasicTrackedCommandList<ID3D12GraphicsCommandList>;
+
+#pragma region // 関数の実装
+
+template<class COMMAND_LIST>
+inline void BasicTrackedCommandList<COMMAND_LIST>::BeginFrame(COMMAND_LIST* cmdList) {
+	assert(stateTracker_.GetPendingBarriers().empty() && "前のフレームのバリアが発行されていません");
+	cmdList_ = cmdList;
+	statistics_.barrier = stateTracker_.GetStatistics();
+	stateTracker_.ResetStatistics();
+	lastFrameStatistics_ = statistics_;
+	statistics_ = {};
+	Invalidate();
+}
+
+template<class COMMAND_LIST>
+inline void BasicTrackedCommandList<COMMAND_LIST>::Invalidate() {
+	pipelineState_ = nullptr;
+	rootSignature_ = nullptr;
+	descriptorHeapCount_ = 0;
+	descriptorHeaps_ = {};
+	rootParameters_ = {};
+	primitiveTopology_ = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
+	vertexBufferViews_ = {};
+	indexBufferView_ = {};
+}
+
+template<class COMMAND_LIST>
+inline void BasicTrackedCommandList<COMMAND_LIST>::SetPipelineState(ID3D12PipelineState* pipelineState) {
+	assert(cmdList_ != nullptr);
+	if (Count(pipelineState != pipelineState_)) {
+		pipelineState_ = pipelineState;
+		cmdList_->SetPipelineState(pipelineState);
+	}
+}
+
+template<class COMMAND_LIST>
+inline void BasicTrackedCommandList<COMMAND_LIST>::SetGraphicsRootSignature(ID3D12RootSignature* rootSignature) {
+	assert(cmdList_ != nullptr);
+	if (Count(rootSignature != rootSignature_)) {
+		rootSignature_ = rootSignature;
+		// ルートシグネチャが変わるとルートパラメータは無効になる
+		rootParameters_ = {};
+		cmdList_->SetGraphicsRootSignature(rootSignature);
+	}
+}
+
+template<class COMMAND_LIST>
+inline void BasicTrackedCommandList<COMMAND_LIST>::SetDescriptorHeaps(UINT numDescriptorHeaps, ID3D12DescriptorHeap* const* descriptorHeaps) {
+	assert(cmdList_ != nullptr);
+	assert(numDescriptorHeaps <= kMaxDescriptorHeapCount);
+	bool isChanged =
+		numDescriptorHeaps != descriptorHeapCount_ ||
+		!std::equal(descriptorHeaps, descriptorHeaps + numDescriptorHeaps, descriptorHeaps_.begin());
+	if (Count(isChanged)) {
+		descriptorHeapCount_ = numDescriptorHeaps;
+		std::copy(descriptorHeaps, descriptorHeaps + numDescriptorHeaps, descriptorHeaps_.begin());
+		// ヒープが変わるとディスクリプタテーブルは無効になる
+		for (auto& rootParameter : rootParameters_) {
+			if (rootParameter.type == kRootParameterDescriptorTable) {
+				rootParameter = {};
+			}
+		}
+		cmdList_->SetDescriptorHeaps(numDescriptorHeaps, descriptorHeaps);
+	}
+}
+
+template<class COMMAND_LIST>
+inline void BasicTrackedCommandList<COMMAND_LIST>::SetGraphicsRootDescriptorTable(UINT rootParameterIndex, D3D12_GPU_DESCRIPTOR_HANDLE baseDescriptor) {
+	assert(cmdList_ != nullptr);
+	if (Count(UpdateRootParameter(rootParameterIndex, kRootParameterDescriptorTable, baseDescriptor.ptr))) {
+		cmdList_->SetGraphicsRootDescriptorTable(rootParameterIndex, baseDescriptor);
+	}
+}
+
+template<class COMMAND_LIST>
+inline void BasicTrackedCommandList<COMMAND_LIST>::SetGraphicsRootConstantBufferView(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS bufferLocation) {
+	assert(cmdList_ != nullptr);
+	if (Count(UpdateRootParameter(rootParameterIndex, kRootParameterConstantBufferView, bufferLocation))) {
+		cmdList_->SetGraphicsRootConstantBufferView(rootParameterIndex, bufferLocation);
+	}
+}
+
+template<class COMMAND_LIST>
+inline void BasicTrackedCommandList<COMMAND_LIST>::SetGraphicsRootShaderResourceView(UINT rootParameterIndex, D3D12_GPU_VIRTUAL_ADDRESS bufferLocation) {
+	assert(cmdList_ != nullptr);
+	if (Count(UpdateRootParameter(rootParameterIndex, kRootParameterShaderResourceView, bufferLocation))) {
+		cmdList_->SetGraphicsRootShaderResourceView(rootParameterIndex, bufferLocation);
+	}
+}
+
+template<class COMMAND_LIST>
+inline void BasicTrackedCommandList<COMMAND_LIST>::SetGraphicsRoot32BitConstant(UINT rootParameterIndex, UINT srcData, UINT destOffsetIn32BitValues) {
+	assert(cmdList_ != nullptr);
+	uint64_t value = static_cast<uint64_t>(destOffsetIn32BitValues) << 32 | srcData;
+	if (Count(UpdateRootParameter(rootParameterIndex, kRootParameterConstant, value))) {
+		cmdList_->SetGraphicsRoot32BitConstant(rootParameterIndex, srcData, destOffsetIn32BitValues);
+	}
+}
+
+template<class COMMAND_LIST>
+inline void BasicTrackedCommandList<COMMAND_LIST>::IASetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY primitiveTopology) {
+	assert(cmdList_ != nullptr);
+	if (Count(primitiveTopology != primitiveTopology_)) {
+		primitiveTopology_ = primitiveTopology;
+		cmdList_->IASetPrimitiveTopology(primitiveTopology);
+	}
+}
+
+template<class COMMAND_LIST>
+inline void BasicTrackedCommandList<COMMAND_LIST>::IASetVertexBuffers(UINT startSlot, UINT numViews, const D3D12_VERTEX_BUFFER_VIEW* views) {
+	assert(cmdList_ != nullptr);
+	// 覚えきれないスロットと外す場合は毎回セットする
+	bool isChanged = startSlot + numViews > kMaxVertexBufferSlotCount || views == nullptr;
+	if (isChanged) {
+		vertexBufferViews_ = {};
+	}
+	else {
+		isChanged = std::memcmp(&vertexBufferViews_[startSlot], views, sizeof(D3D12_VERTEX_BUFFER_VIEW) * numViews) != 0;
+		if (isChanged) {
+			std::copy(views, views + numViews, vertexBufferViews_.begin() + startSlot);
+		}
+	}
+	if (Count(isChanged)) {
+		cmdList_->IASetVertexBuffers(startSlot, numViews, views);
+	}
+}
+
+template<class COMMAND_LIST>
+inline void BasicTrackedCommandList<COMMAND_LIST>::IASetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW* view) {
+	assert(cmdList_ != nullptr);
+	assert(view != nullptr);
+	if (Count(std::memcmp(&indexBufferView_, view, sizeof(D3D12_INDEX_BUFFER_VIEW)) != 0)) {
+		indexBufferView_ = *view;
+		cmdList_->IASetIndexBuffer(view);
+	}
+}
+
+template<class COMMAND_LIST>
+inline void BasicTrackedCommandList<COMMAND_LIST>::DrawInstanced(UINT vertexCountPerInstance, UINT instanceCount, UINT startVertexLocation, UINT startInstanceLocation) {
+	assert(cmdList_ != nullptr);
+	FlushResourceBarriers();
+	statistics_.drawCount++;
+	cmdList_->DrawInstanced(vertexCountPerInstance, instanceCount, startVertexLocation, startInstanceLocation);
+}
+
+template<class COMMAND_LIST>
+inline void BasicTrackedCommandList<COMMAND_LIST>::DrawIndexedInstanced(UINT indexCountPerInstance, UINT instanceCount, UINT startIndexLocation, INT baseVertexLocation, UINT startInstanceLocation) {
+	assert(cmdList_ != nullptr);
+	FlushResourceBarriers();
+	statistics_.drawCount++;
+	cmdList_->DrawIndexedInstanced(indexCountPerInstance, instanceCount, startIndexLocation, baseVertexLocation, startInstanceLocation);
+}
+
+template<class COMMAND_LIST>
+inline void BasicTrackedCommandList<COMMAND_LIST>::Dispatch(UINT threadGroupCountX, UINT threadGroupCountY, UINT threadGroupCountZ) {
+	assert(cmdList_ != nullptr);
+	FlushResourceBarriers();
+	statistics_.drawCount++;
+	cmdList_->Dispatch(threadGroupCountX, threadGroupCountY, threadGroupCountZ);
+}
+
+template<class COMMAND_LIST>
+inline bool BasicTrackedCommandList<COMMAND_LIST>::UpdateRootParameter(UINT rootParameterIndex, RootParameterType type, uint64_t value) {
+	// 覚えきれない番号は毎回セットする
+	if (rootParameterIndex >= kMaxRootParameterCount) {
+		return true;
+	}
+	RootParameter& rootParameter = rootParameters_[rootParameterIndex];
+	if (rootParameter.type == type && rootParameter.value == value) {
+		return false;
+	}
+	rootParameter.type = type;
+	rootParameter.value = value;
+	return true;
+}
+
+#pragma endregion
+
+#endif
@@ -0,0 +1,260 @@
+#include "TransformSystem.h"
+
+#include <cassert>
+
+#include "ThreadPool.h"
+
+TransformHandle TransformSystem::Create(TransformHandle parent) {
+	uint32_t parentIndex = kInvalidIndex;
+	uint32_t depth = 0;
+	if (!parent.IsNull()) {
+		parentIndex = static_cast<uint32_t>(GetDenseIndex(parent));
+		depth = depths_[parentIndex] + 1;
+	}
+
+	uint32_t slotIndex = 0;
+	if (!freeSlots_.empty()) {
+		slotIndex = freeSlots_.back();
+		freeSlots_.pop_back();
+	}
+	else {
+		assert(slots_.size() < TransformHandle::kInvalidIndex);
+		slotIndex = static_cast<uint32_t>(slots_.size());
+		slots_.emplace_back();
+	}
+
+	// 末尾に追加するので親より後ろになる
+	uint32_t denseIndex = static_cast<uint32_t>(positions_.size());
+	if (!depths_.empty() && depth < depths_.back()) {
+		isOrderDirty_ = true;
+	}
+	else if (!isOrderDirty_) {
+		// 末尾の深さか、一つ深い段が増える
+		if (levelOffsets_.empty()) {
+			levelOffsets_.emplace_back(0);
+		}
+		if (depth + 1 == levelOffsets_.size()) {
+			levelOffsets_.emplace_back(denseIndex);
+		}
+		levelOffsets_.back()++;
+	}
+	positions_.emplace_back(Math::kZero);
+	rotates_.emplace_back(Quaternion::Identity);
+	scales_.emplace_back(1.0f, 1.0f, 1.0f);
+	worldMatrices_.emplace_back(Matrix44::Identity);
+	parents_.emplace_back(parentIndex);
+	depths_.emplace_back(depth);
+	flags_.emplace_back(kFlagDirty);
+	slotIndices_.emplace_back(slotIndex);
+
+	slots_[slotIndex].denseIndex = denseIndex;
+	return TransformHandle{ slotIndex, slots_[slotIndex].generation };
+}
+
+void TransformSystem::Destroy(TransformHandle handle) {
+	size_t denseIndex = GetDenseIndex(handle);
+	flags_[denseIndex] |= kFlagDestroyed;
+	ReleaseSlot(slotIndices_[denseIndex]);
+	// 子孫と配列からの削除は次の更新でまとめて行う
+	isOrderDirty_ = true;
+}
+
+bool TransformSystem::IsValid(TransformHandle handle) const {
+	return handle.index < slots_.size() &&
+		slots_[handle.index].generation == handle.generation &&
+		slots_[handle.index].denseIndex != kInvalidIndex;
+}
+
+void TransformSystem::Clear() {
+	for (size_t i = 0; i < flags_.size(); i++) {
+		if (!(flags_[i] & kFlagDestroyed)) {
+			ReleaseSlot(slotIndices_[i]);
+		}
+	}
+	positions_.clear();
+	rotates_.clear();
+	scales_.clear();
+	worldMatrices_.clear();
+	parents_.clear();
+	depths_.clear();
+	flags_.clear();
+	slotIndices_.clear();
+	levelOffsets_.clear();
+	isOrderDirty_ = false;
+}
+
+void TransformSystem::SetParent(TransformHandle handle, TransformHandle parent) {
+	size_t denseIndex = GetDenseIndex(handle);
+	uint32_t parentIndex = kInvalidIndex;
+	uint32_t depth = 0;
+	if (!parent.IsNull()) {
+		parentIndex = static_cast<uint32_t>(GetDenseIndex(parent));
+		depth = depths_[parentIndex] + 1;
+#ifdef _DEBUG
+		// 自身の子孫を親にすると循環する
+		for (uint32_t i = parentIndex; i != kInvalidIndex; i = parents_[i]) {
+			assert(i != denseIndex);
+		}
+#endif
+	}
+	if (parents_[denseIndex] == parentIndex) {
+		return;
+	}
+
+	parents_[denseIndex] = parentIndex;
+	flags_[denseIndex] |= kFlagDirty;
+	// 親が後ろにある場合や深さが変わる場合(子孫の深さも変わる)は並べなおす
+	if ((parentIndex != kInvalidIndex && parentIndex > denseIndex) || depth != depths_[denseIndex]) {
+		isOrderDirty_ = true;
+	}
+}
+
+TransformHandle TransformSystem::GetParent(TransformHandle handle) const {
+	uint32_t parentIndex = parents_[GetDenseIndex(handle)];
+	if (parentIndex == kInvalidIndex) {
+		return TransformHandle{};
+	}
+	uint32_t slotIndex = slotIndices_[parentIndex];
+	return TransformHandle{ slotIndex, slots_[slotIndex].generation };
+}
+
+void TransformSystem::UpdateMatrix() {
+	if (isOrderDirty_) {
+		Rebuild();
+	}
+
+	if (concurrency_ == 1) {
+		UpdateRange(0, positions_.size());
+		return;
+	}
+
+	// 深さごとに分割する(前の深さがすべて終わってから次へ進む)
+	auto threadPool = ThreadPool::GetInstance();
+	size_t concurrency = concurrency_ == 0 ? threadPool->GetConcurrency() : concurrency_;
+	for (size_t depth = 0; depth + 1 < levelOffsets_.size(); depth++) {
+		size_t begin = levelOffsets_[depth];
+		size_t count = levelOffsets_[depth + 1] - begin;
+		if (count < kParallelMinBatchSize * 2) {
+			UpdateRange(begin, begin + count);
+			continue;
+		}
+		threadPool->ParallelFor(count, kParallelMinBatchSize, concurrency, [this, begin](size_t first, size_t last) {
+			UpdateRange(begin + first, begin + last);
+			});
+	}
+}
+
+void TransformSystem::UpdateRange(size_t begin, size_t end) {
+	// 親は必ず前にあるので、先頭から順に計算すれば親の結果が使える
+	for (size_t i = begin; i < end; i++) {
+		uint32_t parentIndex = parents_[i];
+		bool isParentChanged = parentIndex != kInvalidIndex && (flags_[parentIndex] & kFlagChanged);
+		if (!(flags_[i] & kFlagDirty) && !isParentChanged) {
+			flags_[i] = 0;
+			continue;
+		}
+
+		Matrix44 local = Matrix44::CreateTRS(scales_[i], rotates_[i], positions_[i]);
+		worldMatrices_[i] = parentIndex == kInvalidIndex ? local : Matrix44::AffineMultiply(local, worldMatrices_[parentIndex]);
+		flags_[i] = kFlagChanged;
+	}
+}
+
+size_t TransformSystem::GetDenseIndex(TransformHandle handle) const {
+	assert(IsValid(handle));
+	return slots_[handle.index].denseIndex;
+}
+
+void TransformSystem::Rebuild() {
+	size_t count = positions_.size();
+
+	// 深さを計算し直す(親が破棄されたノードも破棄する)
+	std::vector<uint32_t> stack;
+	std::fill(depths_.begin(), depths_.end(), kUnknownDepth);
+	for (uint32_t i = 0; i < count; i++) {
+		// 深さが分かっている祖先まで登る
+		for (uint32_t node = i; node != kInvalidIndex && depths_[node] == kUnknownDepth; node = parents_[node]) {
+			stack.emplace_back(node);
+		}
+		// 上から順に確定させる
+		while (!stack.empty()) {
+			uint32_t node = stack.back();
+			stack.pop_back();
+			uint32_t parentIndex = parents_[node];
+			if (parentIndex == kInvalidIndex) {
+				depths_[node] = 0;
+				continue;
+			}
+			depths_[node] = depths_[parentIndex] + 1;
+			if ((flags_[parentIndex] & kFlagDestroyed) && !(flags_[node] & kFlagDestroyed)) {
+				flags_[node] |= kFlagDestroyed;
+				ReleaseSlot(slotIndices_[node]);
+			}
+		}
+	}
+
+	// 深さで数え上げソート(同じ深さの中では元の順番を保つ)
+	std::vector<uint32_t> offsets;
+	for (size_t i = 0; i < count; i++) {
+		if (flags_[i] & kFlagDestroyed) {
+			continue;
+		}
+		if (depths_[i] >= offsets.size()) {
+			offsets.resize(depths_[i] + 1, 0);
+		}
+		offsets[depths_[i]]++;
+	}
+	uint32_t newCount = 0;
+	levelOffsets_.clear();
+	for (auto& offset : offsets) {
+		uint32_t levelCount = offset;
+		offset = newCount;
+		levelOffsets_.emplace_back(newCount);
+		newCount += levelCount;
+	}
+	levelOffsets_.emplace_back(newCount);
+	std::vector<uint32_t> newIndices(count, kInvalidIndex);
+	for (size_t i = 0; i < count; i++) {
+		if (!(flags_[i] & kFlagDestroyed)) {
+			newIndices[i] = offsets[depths_[i]]++;
+		}
+	}
+
+	// 親の位置を付け替えてから並べなおす
+	for (size_t i = 0; i < count; i++) {
+		if (parents_[i] != kInvalidIndex) {
+			parents_[i] = newIndices[parents_[i]];
+		}
+	}
+	Reorder(positions_, newIndices, newCount);
+	Reorder(rotates_, newIndices, newCount);
+	Reorder(scales_, newIndices, newCount);
+	Reorder(worldMatrices_, newIndices, newCount);
+	Reorder(parents_, newIndices, newCount);
+	Reorder(depths_, newIndices, newCount);
+	Reorder(flags_, newIndices, newCount);
+	Reorder(slotIndices_, newIndices, newCount);
+
+	for (uint32_t i = 0; i < newCount; i++) {
+		slots_[slotIndices_[i]].denseIndex = i;
+	}
+	isOrderDirty_ = false;
+}
+
+void TransformSystem::ReleaseSlot(uint32_t slotIndex) {
+	Slot& slot = slots_[slotIndex];
+	slot.denseIndex = kInvalidIndex;
+	slot.generation++;
+	freeSlots_.emplace_back(slotIndex);
+}
+
+template<class T>
+void TransformSystem::Reorder(std::vector<T>& values, const std::vector<uint32_t>& newIndices, size_t newCount) {
+	std::vector<T> reordered(newCount);
+	for (size_t i = 0; i < newIndices.size(); i++) {
+		if (newIndices[i] != kInvalidIndex) {
+			reordered[newIndices[i]] = values[i];
+		}
+	}
+	values.swap(reordered);
+}
@@ -0,0 +1,219 @@
+#pragma once
+#ifndef TRANSFORMSYSTEM_H_
+#define TRANSFORMSYSTEM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "MathUtility.h"
+
+/// <summary>
+/// TransformSystem のノードを指すハンドル
+/// ノードが破棄されると無効になり、同じ場所が再利用されても一致しない
+/// </summary>
+struct TransformHandle {
+	static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+	uint32_t index = kInvalidIndex;
+	uint32_t generation = 0;
+
+	/// <summary>
+	/// 何も指していないか
+	/// </summary>
+	/// <returns></returns>
+	inline bool IsNull() const { return index == kInvalidIndex; }
+
+	friend inline bool operator==(const TransformHandle& h1, const TransformHandle& h2) {
+		return h1.index == h2.index && h1.generation == h2.generation;
+	}
+	friend inline bool operator!=(const TransformHandle& h1, const TransformHandle& h2) {
+		return !(h1 == h2);
+	}
+};
+
+/// <summary>
+/// 階層付きトランスフォームをまとめて管理する
+/// 座標、回転、拡縮、ワールド行列を配列(SoA)で持ち、親が子より前に来るように並べる
+/// UpdateMatrix は先頭から一度走査するだけで、変更されていない部分木は計算しない
+/// 同じ深さのノードは互いに依存しないので、並列数を指定すると深さごとに ThreadPool で分割して処理する
+/// </summary>
+class TransformSystem
+{
+public:
+	// 1ジョブあたりの最小ノード数(これより少ない深さは呼び出し元で処理する)
+	static constexpr size_t kParallelMinBatchSize = 2 * 1024;
+
+public:
+	/// <summary>
+	/// ノードを生成
+	/// </summary>
+	/// <param name="parent">親(なしの場合はルート)</param>
+	/// <returns>ハンドル</returns>
+	TransformHandle Create(TransformHandle parent = {});
+	/// <summary>
+	/// ノードを破棄
+	/// 子孫も破棄されるが、子孫のハンドルが無効になるのは次の UpdateMatrix から
+	/// </summary>
+	/// <param name="handle">ハンドル</param>
+	void Destroy(TransformHandle handle);
+	/// <summary>
+	/// ハンドルが有効か
+	/// </summary>
+	/// <param name="handle">ハンドル</param>
+	/// <returns></returns>
+	bool IsValid(TransformHandle handle) const;
+	/// <summary>
+	/// すべて破棄
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// 親を変更
+	/// </summary>
+	/// <param name="handle">ハンドル</param>
+	/// <param name="parent">新しい親(なしの場合はルート、自身の子孫は不可)</param>
+	void SetParent(TransformHandle handle, TransformHandle parent);
+	/// <summary>
+	/// 親を取得
+	/// </summary>
+	/// <param name="handle">ハンドル</param>
+	/// <returns>親がない場合は空のハンドル</returns>
+	TransformHandle GetParent(TransformHandle handle) const;
+
+	/// <summary>
+	/// 座標を取得
+	/// </summary>
+	inline const Vector3& GetPosition(TransformHandle handle) const { return positions_[GetDenseIndex(handle)]; }
+	/// <summary>
+	/// 座標をセット
+	/// </summary>
+	inline void SetPosition(TransformHandle handle, const Vector3& position) { size_t i = GetDenseIndex(handle); positions_[i] = position; flags_[i] |= kFlagDirty; }
+	/// <summary>
+	/// 回転を取得
+	/// </summary>
+	inline const Quaternion& GetRotate(TransformHandle handle) const { return rotates_[GetDenseIndex(handle)]; }
+	/// <summary>
+	/// 回転をセット
+	/// </summary>
+	inline void SetRotate(TransformHandle handle, const Quaternion& rotate) { size_t i = GetDenseIndex(handle); rotates_[i] = rotate; flags_[i] |= kFlagDirty; }
+	/// <summary>
+	/// 拡縮を取得
+	/// </summary>
+	inline const Vector3& GetScale(TransformHandle handle) const { return scales_[GetDenseIndex(handle)]; }
+	/// <summary>
+	/// 拡縮をセット
+	/// </summary>
+	inline void SetScale(TransformHandle handle, const Vector3& scale) { size_t i = GetDenseIndex(handle); scales_[i] = scale; flags_[i] |= kFlagDirty; }
+	/// <summary>
+	/// ワールド行列を取得(UpdateMatrix 後の値)
+	/// </summary>
+	inline const Matrix44& GetWorldMatrix(TransformHandle handle) const { return worldMatrices_[GetDenseIndex(handle)]; }
+	/// <summary>
+	/// 直前の UpdateMatrix でワールド行列が変わったか
+	/// </summary>
+	inline bool IsChanged(TransformHandle handle) const { return (flags_[GetDenseIndex(handle)] & kFlagChanged) != 0; }
+
+	/// <summary>
+	/// ワールド行列を更新
+	/// </summary>
+	void UpdateMatrix();
+	/// <summary>
+	/// 更新の並列数を取得
+	/// </summary>
+	/// <returns></returns>
+	inline size_t GetConcurrency() const { return concurrency_; }
+	/// <summary>
+	/// 更新の並列数をセット(結果は並列数によらず同じ)
+	/// </summary>
+	/// <param name="concurrency">1: 直列 0: ThreadPool の並列数すべて</param>
+	inline void SetConcurrency(size_t concurrency) { concurrency_ = concurrency; }
+
+	/// <summary>
+	/// ノード数を取得(破棄待ちを含む)
+	/// </summary>
+	/// <returns></returns>
+	inline size_t GetCount() const { return positions_.size(); }
+	/// <summary>
+	/// 配列上の位置を取得(生成、破棄、親の変更後の UpdateMatrix で変わる)
+	/// </summary>
+	/// <param name="handle">ハンドル</param>
+	/// <returns></returns>
+	size_t GetDenseIndex(TransformHandle handle) const;
+	/// <summary>
+	/// ワールド行列の配列を取得(GetDenseIndex の順)
+	/// </summary>
+	/// <returns></returns>
+	inline std::span<const Matrix44> GetWorldMatrices() const { return worldMatrices_; }
+
+private:
+	// 親がない、または配列上にない
+	static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+	// 深さ未計算
+	static constexpr uint32_t kUnknownDepth = UINT32_MAX;
+
+	enum Flag : uint8_t {
+		// ローカルの値が変更された
+		kFlagDirty = 1 << 0,
+		// 直前の更新でワールド行列が変わった
+		kFlagChanged = 1 << 1,
+		// 破棄された
+		kFlagDestroyed = 1 << 2,
+	};
+
+	// ハンドルから配列上の位置への対応
+	struct Slot {
+		uint32_t denseIndex = kInvalidIndex;
+		uint32_t generation = 0;
+	};
+
+	/// <summary>
+	/// 破棄されたノードを取り除き、深さ順に並べなおす
+	/// </summary>
+	void Rebuild();
+	/// <summary>
+	/// 範囲のワールド行列を更新(親は更新済みであること)
+	/// </summary>
+	void UpdateRange(size_t begin, size_t end);
+	/// <summary>
+	/// スロットを解放
+	/// </summary>
+	void ReleaseSlot(uint32_t slotIndex);
+
+	template<class T>
+	static void Reorder(std::vector<T>& values, const std::vector<uint32_t>& newIndices, size_t newCount);
+
+private:
+	// ローカル座標
+	std::vector<Vector3> positions_;
+	// ローカル回転
+	std::vector<Quaternion> rotates_;
+	// ローカル拡縮
+	std::vector<Vector3> scales_;
+	// ワールド行列
+	std::vector<Matrix44> worldMatrices_;
+	// 親の配列上の位置(常に自身より前)
+	std::vector<uint32_t> parents_;
+	// 深さ(ルートが0)
+	std::vector<uint32_t> depths_;
+	// 深さごとの開始位置(深さ d は [levelOffsets_[d], levelOffsets_[d + 1]))
+	std::vector<uint32_t> levelOffsets_;
+	// フラグ
+	std::vector<uint8_t> flags_;
+	// 配列上の位置からスロットへの対応
+	std::vector<uint32_t> slotIndices_;
+
+	// スロット
+	std::vector<Slot> slots_;
+	// 空きスロット
+	std::vector<uint32_t> freeSlots_;
+
+	// 深さ順でなくなった
+	bool isOrderDirty_ = false;
+	// 更新の並列数
+	size_t concurrency_ = 1;
+
+};
+
+#endif
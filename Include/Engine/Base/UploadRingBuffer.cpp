@@ -0,0 +1,117 @@
+#include "UploadRingBuffer.h"
+
+#include <algorithm>
+#include <cassert>
+
+void UploadRingBuffer::Initalize(void* cpuBase, uint64_t gpuBase, size_t capacity, WaitFunction wait) {
+	assert(cpuBase != nullptr);
+	assert(capacity > 0);
+	cpuBase_ = static_cast<uint8_t*>(cpuBase);
+	gpuBase_ = gpuBase;
+	capacity_ = capacity;
+	wait_ = std::move(wait);
+
+	head_ = 0;
+	tail_ = 0;
+	usedBytes_ = 0;
+	frameBytes_ = 0;
+	pendingFrames_.clear();
+	statistics_ = {};
+}
+
+UploadRingBuffer::Allocation UploadRingBuffer::Allocate(size_t size, size_t alignment) {
+	assert(cpuBase_ != nullptr);
+	assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+	assert(size <= capacity_);
+	assert((gpuBase_ & (alignment - 1)) == 0);
+
+	size_t offset = 0;
+	while (!TryAllocate(size, alignment, offset)) {
+		// 現在のフレームだけで埋まっている場合は待っても空かない
+		if (pendingFrames_.empty()) {
+			assert(false && "アップロード領域が足りません");
+			return Allocation{};
+		}
+		// 最も古いフレームの完了を待つ
+		assert(wait_);
+		statistics_.stallCount++;
+		Release(wait_(pendingFrames_.front().fenceValue));
+	}
+
+	statistics_.allocationCount++;
+	statistics_.usedBytes = usedBytes_;
+	statistics_.peakUsedBytes = std::max(statistics_.peakUsedBytes, usedBytes_);
+	return Allocation{ cpuBase_ + offset, gpuBase_ + offset, size };
+}
+
+void UploadRingBuffer::FinishFrame(uint64_t fenceValue) {
+	assert(pendingFrames_.empty() || pendingFrames_.back().fenceValue < fenceValue);
+	if (frameBytes_ == 0) {
+		return;
+	}
+	pendingFrames_.push_back(PendingFrame{ fenceValue, head_, frameBytes_ });
+	frameBytes_ = 0;
+}
+
+void UploadRingBuffer::Release(uint64_t completedFenceValue) {
+	while (!pendingFrames_.empty() && pendingFrames_.front().fenceValue <= completedFenceValue) {
+		const PendingFrame& frame = pendingFrames_.front();
+		tail_ = frame.end;
+		usedBytes_ -= frame.size;
+		pendingFrames_.pop_front();
+	}
+	// 空になったら先頭から使う(折り返しを減らす)
+	if (usedBytes_ == 0) {
+		head_ = 0;
+		tail_ = 0;
+	}
+	statistics_.usedBytes = usedBytes_;
+}
+
+void UploadRingBuffer::ResetStatistics() {
+	statistics_ = {};
+	statistics_.usedBytes = usedBytes_;
+	statistics_.peakUsedBytes = usedBytes_;
+}
+
+bool UploadRingBuffer::TryAllocate(size_t size, size_t alignment, size_t& offset) {
+	size_t aligned = (head_ + alignment - 1) & ~(alignment - 1);
+	// head_ == tail_ は空か満杯のどちらか
+	bool isFull = head_ == tail_ && usedBytes_ != 0;
+	if (isFull) {
+		return false;
+	}
+
+	if (head_ >= tail_) {
+		// 空きは [head_, capacity_) と [0, tail_)
+		if (aligned + size <= capacity_) {
+			offset = aligned;
+		}
+		else if (size <= tail_) {
+			// 末尾を捨てて先頭に折り返す
+			size_t waste = capacity_ - head_;
+			usedBytes_ += waste;
+			frameBytes_ += waste;
+			head_ = 0;
+			aligned = 0;
+			offset = 0;
+			statistics_.wrapCount++;
+		}
+		else {
+			return false;
+		}
+	}
+	else {
+		// 空きは [head_, tail_)
+		if (aligned + size > tail_) {
+			return false;
+		}
+		offset = aligned;
+	}
+
+	size_t consumed = aligned - head_ + size;
+	usedBytes_ += consumed;
+	frameBytes_ += consumed;
+	head_ = aligned + size;
+	return true;
+}
@@ -0,0 +1,145 @@
+#pragma once
+#ifndef UPLOADRINGBUFFER_H_
+#define UPLOADRINGBUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+/// <summary>
+/// フレームごとに使い捨てるアップロード領域を輪状に切り出す
+/// 領域は呼び出し側が用意する(マップ済みのアップロードヒープや、テスト用の CPU メモリ)
+/// 切り出した領域は FinishFrame で渡したフェンス値を GPU が通過するまで再利用しない
+/// スレッドセーフではない
+/// </summary>
+class UploadRingBuffer
+{
+public:
+	// フェンス値まで待ち、完了したフェンス値を返す
+	using WaitFunction = std::function<uint64_t(uint64_t fenceValue)>;
+
+	/// <summary>
+	/// 切り出した領域
+	/// </summary>
+	struct Allocation {
+		// 書き込み先
+		void* cpuAddress = nullptr;
+		// GPU 仮想アドレス
+		uint64_t gpuAddress = 0;
+		// 大きさ
+		size_t size = 0;
+	};
+
+	/// <summary>
+	/// 統計
+	/// </summary>
+	struct Statistics {
+		// 使用中のバイト数(GPU 待ちのフレームと現在のフレームの合計、境界調整の無駄を含む)
+		size_t usedBytes = 0;
+		// 使用中のバイト数の最大
+		size_t peakUsedBytes = 0;
+		// 切り出した回数
+		size_t allocationCount = 0;
+		// 末尾から先頭に折り返した回数
+		size_t wrapCount = 0;
+		// 空きがなく GPU を待った回数
+		size_t stallCount = 0;
+	};
+
+	// 定数バッファの配置境界
+	static constexpr size_t kConstantBufferAlignment = 256;
+
+public:
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="cpuBase">領域の先頭(マップ済みのアドレス)</param>
+	/// <param name="gpuBase">領域の先頭の GPU 仮想アドレス</param>
+	/// <param name="capacity">バイト数</param>
+	/// <param name="wait">空きがないときに GPU を待つ関数</param>
+	void Initalize(void* cpuBase, uint64_t gpuBase, size_t capacity, WaitFunction wait);
+	/// <summary>
+	/// 領域を切り出す
+	/// 空きがない場合は古いフレームの完了を待つ
+	/// </summary>
+	/// <param name="size">バイト数</param>
+	/// <param name="alignment">配置境界(2の累乗)</param>
+	/// <returns>現在のフレームの間だけ有効</returns>
+	Allocation Allocate(size_t size, size_t alignment = kConstantBufferAlignment);
+	/// <summary>
+	/// 値を書き込んだ領域を切り出す
+	/// </summary>
+	/// <typeparam name="TYPE">書き込む型</typeparam>
+	/// <param name="value">値</param>
+	/// <param name="alignment">配置境界(2の累乗)</param>
+	/// <returns></returns>
+	template<class TYPE>
+	inline Allocation Push(const TYPE& value, size_t alignment = kConstantBufferAlignment) {
+		Allocation allocation = Allocate(sizeof(TYPE), alignment);
+		*static_cast<TYPE*>(allocation.cpuAddress) = value;
+		return allocation;
+	}
+	/// <summary>
+	/// 現在のフレームを締める
+	/// </summary>
+	/// <param name="fenceValue">このフレームのコマンドの完了を示すフェンス値</param>
+	void FinishFrame(uint64_t fenceValue);
+	/// <summary>
+	/// 完了したフレームの領域を解放
+	/// </summary>
+	/// <param name="completedFenceValue">GPU が通過したフェンス値</param>
+	void Release(uint64_t completedFenceValue);
+
+	/// <summary>
+	/// 容量を取得
+	/// </summary>
+	/// <returns></returns>
+	inline size_t GetCapacity() const { return capacity_; }
+	/// <summary>
+	/// 統計を取得(usedBytes 以外は ResetStatistics からの累計)
+	/// </summary>
+	/// <returns></returns>
+	inline const Statistics& GetStatistics() const { return statistics_; }
+	/// <summary>
+	/// 統計をリセット
+	/// </summary>
+	void ResetStatistics();
+
+private:
+	// GPU の完了を待っているフレーム
+	struct PendingFrame {
+		uint64_t fenceValue;
+		// フレーム終了時の書き込み位置
+		size_t end;
+		// フレームで使ったバイト数
+		size_t size;
+	};
+
+	/// <summary>
+	/// 空きから切り出す
+	/// </summary>
+	/// <returns>空きがない場合は false</returns>
+	bool TryAllocate(size_t size, size_t alignment, size_t& offset);
+
+private:
+	uint8_t* cpuBase_ = nullptr;
+	uint64_t gpuBase_ = 0;
+	size_t capacity_ = 0;
+	WaitFunction wait_;
+
+	// 次に書き込む位置
+	size_t head_ = 0;
+	// 最も古い使用中の位置
+	size_t tail_ = 0;
+	// 使用中のバイト数
+	size_t usedBytes_ = 0;
+	// 現在のフレームで使ったバイト数
+	size_t frameBytes_ = 0;
+	std::deque<PendingFrame> pendingFrames_;
+
+	Statistics statistics_;
+
+};
+
+#endif
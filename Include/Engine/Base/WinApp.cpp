@@ -6,17 +6,17 @@ WinApp* WinApp::GetInstance() {
 }
 
 LRESULT WinApp::WindowProc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam) {
-	// bZ[WɉăQ[ŗL̏s
+	// メッセージに応じてゲーム固有の処理を行う
 	switch (msg)
 	{
-		// EBhEjꂽ
+		// ウィンドウが破棄された
 	case WM_DESTROY:
-		// OSɑ΂āAAvI`
+		// OSに対して、アプリ終了を伝える
 		PostQuitMessage(0);
 		return 0;
 	}
 
-	// W̃bZ[Ws
+	// 標準のメッセージ処理を行う
 	return DefWindowProc(hwnd, msg, wparam, lparam);
 }
 
@@ -28,32 +28,32 @@ void WinApp::CreateGameWindow(const std::string& window_title, int window_width,
 	MultiByteToWideChar(CP_ACP, 0, window_title.c_str(), -1, wtitle, _countof(wtitle));
 
 	wnd_class_.cbSize = sizeof(WNDCLASSEX);
-	wnd_class_.lpfnWndProc = (WNDPROC)WindowProc;		// EBhEvV[Wݒ
-	wnd_class_.lpszClassName = wtitle;					// EBhENX
-	wnd_class_.hInstance = GetModuleHandle(nullptr);		// EBhEnh
-	wnd_class_.hCursor = LoadCursor(NULL, IDC_ARROW);	// J[\w
+	wnd_class_.lpfnWndProc = (WNDPROC)WindowProc;		// ウィンドウプロシージャを設定
+	wnd_class_.lpszClassName = wtitle;					// ウィンドウクラス名
+	wnd_class_.hInstance = GetModuleHandle(nullptr);		// ウィンドウハンドル
+	wnd_class_.hCursor = LoadCursor(NULL, IDC_ARROW);	// カーソル指定
 
 
-	RegisterClassEx(&wnd_class_); // EBhENXOSɓo^
-	RECT wrc = { 0, 0, window_width_, window_height_ }; // EBhETCY{ XW, YW, , c }
-	AdjustWindowRect(&wrc, WS_OVERLAPPEDWINDOW, false); // ŃTCY␳
+	RegisterClassEx(&wnd_class_); // ウィンドウクラスをOSに登録する
+	RECT wrc = { 0, 0, window_width_, window_height_ }; // ウィンドウサイズ{ X座標, Y座標, 横幅, 縦幅 }
+	AdjustWindowRect(&wrc, WS_OVERLAPPEDWINDOW, false); // 自動でサイズを補正する
 
-	// EBhEIuWFNg̐
+	// ウィンドウオブジェクトの生成
 	hwnd_ = CreateWindow(
-		wnd_class_.lpszClassName,		// NX
-		wtitle,					// ^Cgo[̕
-		WS_OVERLAPPEDWINDOW,	// ^Cgo[ƋEEBhE
-		CW_USEDEFAULT,			// \W OS ɂC
-		CW_USEDEFAULT,			// \W OS ɂC
-		wrc.right - wrc.left,	// EBhE
-		wrc.bottom - wrc.top,	// EBhE
-		nullptr,				// eEBhEnh
-		nullptr,				// j[nh
-		wnd_class_.hInstance,			// ĂяoAvP[Vnh,
-		nullptr);				// ǉp[^[
+		wnd_class_.lpszClassName,		// クラス名
+		wtitle,					// タイトルバーの文字
+		WS_OVERLAPPEDWINDOW,	// タイトルバーと境界線があるウィンドウ
+		CW_USEDEFAULT,			// 表示ｘ座標は OS にお任せ
+		CW_USEDEFAULT,			// 表示ｙ座標は OS にお任せ
+		wrc.right - wrc.left,	// ウィンドウ幅
+		wrc.bottom - wrc.top,	// ウィンドウ高
+		nullptr,				// 親ウィンドウハンドル
+		nullptr,				// メニューハンドル
+		wnd_class_.hInstance,			// 呼び出しアプリケーションハンドル,
+		nullptr);				// 追加パラメーター
 
 
-	// EBhE\Ԃɂ
+	// ウィンドウを表示状態にする
 	ShowWindow(hwnd_, SW_SHOW);
 }
 
@@ -65,7 +65,7 @@ bool WinApp::WindowQuit() {
 		DispatchMessage(&msg);
 	}
 
-	// AvP[VIƂ message  WM_QUIT ɂȂ
+	// アプリケーションが終わるときに message が WM_QUIT になる
 	return msg.message == WM_QUIT;
 }
 
@@ -7,15 +7,15 @@
 
 class WinApp final
 {
-public: // ÓIo֐
+public: // 静的メンバ関数
 	/// <summary>
-	/// VOgCX^X擾
+	/// シングルトンインスタンスを取得
 	/// </summary>
-	/// <returns>CX^X̃|C^</returns>
+	/// <returns>インスタンスのポインタ</returns>
 	static WinApp* GetInstance();
 	
 	/// <summary>
-	/// EBhEvV[W
+	/// ウィンドウプロシージャ
 	/// </summary>
 	/// <param name="hwnd"></param>
 	/// <param name="msg"></param>
@@ -24,69 +24,69 @@ public: // 
 	/// <returns></returns>
 	static LRESULT WindowProc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam);
 
-public: // o֐
+public: // メンバ関数
 	/// <summary>
-	/// EBhEnh̎擾
+	/// ウィンドウハンドルの取得
 	/// </summary>
 	/// <returns></returns>
 	inline HWND GetHwnd() const { return hwnd_; }
 	
 	/// <summary>
-	/// EBhENX̃CX^Xnh擾
+	/// ウィンドウクラスのインスタンスハンドルを取得
 	/// </summary>
 	/// <returns></returns>
 	inline HINSTANCE GetWindowClassHInstance() const { return wnd_class_.hInstance; }
 	
 	/// <summary>
-	/// EBhENX̖O擾
+	/// ウィンドウクラスの名前を取得
 	/// </summary>
 	/// <returns></returns>
 	inline const wchar_t* GetWindowClassName() const { return wnd_class_.lpszClassName; }
 	
 	/// <summary>
-	/// EBhE^Cg擾
+	/// ウィンドウタイトルを取得
 	/// </summary>
 	/// <returns></returns>
 	inline const std::string& GetWindowTitle() const { return window_title_; }
 	
 	/// <summary>
-	/// EBhE擾
+	/// ウィンドウ幅を取得
 	/// </summary>
 	/// <returns></returns>
 	inline int GetWindowWidth() const { return window_width_; }
 	
 	/// <summary>
-	/// EBhE擾
+	/// ウィンドウ高を取得
 	/// </summary>
 	/// <returns></returns>
 	inline int GetWindowHeight() const { return window_height_; }
 
 	/// <summary>
-	/// Q[EBhE쐬
+	/// ゲームウィンドウを作成する
 	/// </summary>
-	/// <param name="widnow_title">EBhE^Cg</param>
-	/// <param name="window_width">EBhE</param>
-	/// <param name="window_height">EBhE</param>
+	/// <param name="widnow_title">ウィンドウタイトル</param>
+	/// <param name="window_width">ウィンドウ幅</param>
+	/// <param name="window_height">ウィンドウ高</param>
 	void CreateGameWindow(const std::string& window_title = "DirectX", int window_width = 1280, int window_height = 720);
 	
 	/// <summary>
-	/// EBhEꂽ
+	/// ウィンドウが閉じられたか
 	/// </summary>
-	/// <returns></returns>
+	/// <returns>閉じたか</returns>
 	bool WindowQuit();
 	
 	/// <summary>
-	/// Q[EBhEj
+	/// ゲームウィンドウを破棄
 	/// </summary>
 	void TerminateGameWindow();
 
-private: // o֐
+private: // メンバ関数
 	WinApp() = default;
 	~WinApp() = default;
 	WinApp(const WinApp&) = delete;
 	const WinApp& operator=(const WinApp&) = delete;
 
-private: // oϐ
+private: // メンバ変数
 	WNDCLASSEX wnd_class_ = {};
 	HWND hwnd_ = nullptr;
 	std::string window_title_ = "DirectX";
@@ -1,44 +1,19 @@
 #include "WorldTransform.h"
 
-#include <cassert>
-#include <d3dx12.h>
-
 #include "DirectXCommon.h"
 
 
-void WorldTransform::CreateBuffer()
-{
-	HRESULT result = S_FALSE;
-	auto device = DirectXCommon::GetInstance()->GetDevice();
-
-	D3D12_HEAP_PROPERTIES heapProp = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-	D3D12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer((sizeof(ConstDataWorldTransform) + 0xFF) & ~0xFF);
-	// obt@̐
-	result = device->CreateCommittedResource(
-		&heapProp, D3D12_HEAP_FLAG_NONE,
-		&resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ,
-		nullptr, IID_PPV_ARGS(&constBuffer_));
-	assert(SUCCEEDED(result));
-
-	// }bsO
-	result = constBuffer_->Map(0, nullptr, (void**)&map_); // }bsO
-	assert(SUCCEEDED(result));
-}
-
 void WorldTransform::UpdateMatrix()
 {
-	worldMatrix = Matrix44::Identity;
-	worldMatrix *= Matrix44::CreateScaling(scale);
-	worldMatrix *= Matrix44::CreateRotationFromQuaternion(rotate);
-	worldMatrix *= Matrix44::CreateTranslation(position);
+	worldMatrix = Matrix44::CreateTRS(scale, rotate, position);
 
 	if (parent != nullptr) {
-		worldMatrix *= parent->worldMatrix;
+		worldMatrix = Matrix44::AffineMultiply(worldMatrix, parent->worldMatrix);
 	}
 }
 
-void WorldTransform::SetGraphicsCommand(ID3D12GraphicsCommandList* cmdList, UINT rootParameterIndex)
+void WorldTransform::SetGraphicsCommand(TrackedCommandList* cmdList, UINT rootParameterIndex)
 {
-	map_->world = worldMatrix;
-	cmdList->SetGraphicsRootConstantBufferView(rootParameterIndex, constBuffer_->GetGPUVirtualAddress());
+	auto constData = DirectXCommon::GetInstance()->GetUploadRing()->Push(ConstDataWorldTransform{ worldMatrix });
+	cmdList->SetGraphicsRootConstantBufferView(rootParameterIndex, constData.gpuAddress);
 }
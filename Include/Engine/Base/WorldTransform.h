@@ -3,10 +3,14 @@
 #define WORLDTRANSFORM_H_
 
 #include <d3d12.h>
-#include <wrl.h>
 
 #include "MathUtility.h"
+#include "TrackedCommandList.h"
 
+/// <summary>
+/// 単体で使うトランスフォーム(定数バッファへの転送も行う)
+/// 親は呼び出し側が子より先に UpdateMatrix する。数の多い階層は TransformSystem のハンドルで持つ
+/// </summary>
 class WorldTransform
 {
 private:
@@ -16,37 +20,27 @@ private:
 
 public:
 	/// <summary>
-	/// obt@𐶐
-	/// </summary>
-	void CreateBuffer();
-	/// <summary>
-	/// sXV
+	/// 行列を更新
 	/// </summary>
 	void UpdateMatrix();
 	/// <summary>
-	/// s]
+	/// 行列を転送(フレームごとのアップロード領域に書き込む)
 	/// </summary>
-	/// <param name="cmdList">R}hXg</param>
-	/// <param name="rootParameterIndexWorldTransform">[gp[^̃CfbNX</param>
-	void SetGraphicsCommand(ID3D12GraphicsCommandList* cmdList, UINT rootParameterIndex);
+	/// <param name="cmdList">コマンドリスト</param>
+	/// <param name="rootParameterIndexWorldTransform">ルートパラメータのインデックス</param>
+	void SetGraphicsCommand(TrackedCommandList* cmdList, UINT rootParameterIndex);
 
 public:
-	// W
-	Vector3 position;
-	// ]
-	Quaternion rotate;
-	// gk
+	// 座標
+	Vector3 position = {};
+	// 回転
+	Quaternion rotate = Quaternion::Identity;
+	// 拡縮
 	Vector3 scale = Vector3(1.0f, 1.0f, 1.0f);
-	// [hs
-	Matrix44 worldMatrix;
-	// eւ̃|C^
+	// ワールド行列
+	Matrix44 worldMatrix = Matrix44::Identity;
+	// 親へのポインタ(親の worldMatrix をそのまま掛ける)
 	const WorldTransform* parent = nullptr;
-
-private:
-	//@萔obt@
-	Microsoft::WRL::ComPtr<ID3D12Resource> constBuffer_;
-	// }bvp
-	ConstDataWorldTransform* map_ = nullptr;
 };
 
 #endif
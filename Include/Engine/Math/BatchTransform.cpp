@@ -0,0 +1,241 @@
+#include "BatchTransform.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "ThreadPool.h"
+
+namespace {
+	// 行列の各要素
+	struct MatrixElements {
+		float m00, m01, m02;
+		float m10, m11, m12;
+		float m20, m21, m22;
+		float m30, m31, m32;
+
+		MatrixElements(const Matrix44& mat, float w) :
+			m00(mat.m[0][0]), m01(mat.m[0][1]), m02(mat.m[0][2]),
+			m10(mat.m[1][0]), m11(mat.m[1][1]), m12(mat.m[1][2]),
+			m20(mat.m[2][0]), m21(mat.m[2][1]), m22(mat.m[2][2]),
+			m30(mat.m[3][0] * w), m31(mat.m[3][1] * w), m32(mat.m[3][2] * w) {}
+	};
+
+	// 法線用の行列(逆転置行列の3×3部分)
+	Matrix44 CreateNormalMatrix(const Matrix44& mat) {
+		Matrix44 normal = mat;
+		normal.m[3][0] = normal.m[3][1] = normal.m[3][2] = 0.0f;
+		normal.m[0][3] = normal.m[1][3] = normal.m[2][3] = 0.0f;
+		normal.m[3][3] = 1.0f;
+		return normal.Inverse().Transpose();
+	}
+
+	// 要素数に応じて分割して処理する
+	template<class FUNC>
+	void Dispatch(size_t count, FUNC&& func) {
+		if (count < Math::kBatchParallelThreshold) {
+			func(0, count);
+			return;
+		}
+		ThreadPool::GetInstance()->ParallelFor(count, Math::kBatchParallelThreshold / 4, func);
+	}
+
+	void TransformSoARange(
+		const float* sx, const float* sy, const float* sz,
+		float* dx, float* dy, float* dz,
+		size_t count, const MatrixElements& e) {
+		size_t i = 0;
+#if defined(MATH_SIMD_AVX2)
+		{
+			const __m256 m00 = _mm256_set1_ps(e.m00), m01 = _mm256_set1_ps(e.m01), m02 = _mm256_set1_ps(e.m02);
+			const __m256 m10 = _mm256_set1_ps(e.m10), m11 = _mm256_set1_ps(e.m11), m12 = _mm256_set1_ps(e.m12);
+			const __m256 m20 = _mm256_set1_ps(e.m20), m21 = _mm256_set1_ps(e.m21), m22 = _mm256_set1_ps(e.m22);
+			const __m256 m30 = _mm256_set1_ps(e.m30), m31 = _mm256_set1_ps(e.m31), m32 = _mm256_set1_ps(e.m32);
+			for (; i + 8 <= count; i += 8) {
+				__m256 x = _mm256_loadu_ps(sx + i);
+				__m256 y = _mm256_loadu_ps(sy + i);
+				__m256 z = _mm256_loadu_ps(sz + i);
+#if defined(MATH_SIMD_FMA)
+				__m256 rx = _mm256_fmadd_ps(z, m20, _mm256_fmadd_ps(y, m10, _mm256_fmadd_ps(x, m00, m30)));
+				__m256 ry = _mm256_fmadd_ps(z, m21, _mm256_fmadd_ps(y, m11, _mm256_fmadd_ps(x, m01, m31)));
+				__m256 rz = _mm256_fmadd_ps(z, m22, _mm256_fmadd_ps(y, m12, _mm256_fmadd_ps(x, m02, m32)));
+#else
+				__m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m00), _mm256_mul_ps(y, m10)), _mm256_add_ps(_mm256_mul_ps(z, m20), m30));
+				__m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m01), _mm256_mul_ps(y, m11)), _mm256_add_ps(_mm256_mul_ps(z, m21), m31));
+				__m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m02), _mm256_mul_ps(y, m12)), _mm256_add_ps(_mm256_mul_ps(z, m22), m32));
+#endif
+				_mm256_storeu_ps(dx + i, rx);
+				_mm256_storeu_ps(dy + i, ry);
+				_mm256_storeu_ps(dz + i, rz);
+			}
+		}
+#endif
+#if defined(MATH_SIMD_SSE)
+		{
+			const __m128 m00 = _mm_set1_ps(e.m00), m01 = _mm_set1_ps(e.m01), m02 = _mm_set1_ps(e.m02);
+			const __m128 m10 = _mm_set1_ps(e.m10), m11 = _mm_set1_ps(e.m11), m12 = _mm_set1_ps(e.m12);
+			const __m128 m20 = _mm_set1_ps(e.m20), m21 = _mm_set1_ps(e.m21), m22 = _mm_set1_ps(e.m22);
+			const __m128 m30 = _mm_set1_ps(e.m30), m31 = _mm_set1_ps(e.m31), m32 = _mm_set1_ps(e.m32);
+			for (; i + 4 <= count; i += 4) {
+				__m128 x = _mm_loadu_ps(sx + i);
+				__m128 y = _mm_loadu_ps(sy + i);
+				__m128 z = _mm_loadu_ps(sz + i);
+				using Math::SIMD::MulAdd;
+				_mm_storeu_ps(dx + i, MulAdd(z, m20, MulAdd(y, m10, MulAdd(x, m00, m30))));
+				_mm_storeu_ps(dy + i, MulAdd(z, m21, MulAdd(y, m11, MulAdd(x, m01, m31))));
+				_mm_storeu_ps(dz + i, MulAdd(z, m22, MulAdd(y, m12, MulAdd(x, m02, m32))));
+			}
+		}
+#elif defined(MATH_SIMD_NEON)
+		{
+			for (; i + 4 <= count; i += 4) {
+				float32x4_t x = vld1q_f32(sx + i);
+				float32x4_t y = vld1q_f32(sy + i);
+				float32x4_t z = vld1q_f32(sz + i);
+				vst1q_f32(dx + i, vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(vdupq_n_f32(e.m30), x, e.m00), y, e.m10), z, e.m20));
+				vst1q_f32(dy + i, vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(vdupq_n_f32(e.m31), x, e.m01), y, e.m11), z, e.m21));
+				vst1q_f32(dz + i, vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(vdupq_n_f32(e.m32), x, e.m02), y, e.m12), z, e.m22));
+			}
+		}
+#endif
+		// 端数
+		for (; i < count; i++) {
+			float x = sx[i], y = sy[i], z = sz[i];
+			dx[i] = x * e.m00 + y * e.m10 + z * e.m20 + e.m30;
+			dy[i] = x * e.m01 + y * e.m11 + z * e.m21 + e.m31;
+			dz[i] = x * e.m02 + y * e.m12 + z * e.m22 + e.m32;
+		}
+	}
+
+	void TransformAoSRange(const Vector3* src, Vector3* dst, size_t count, const MatrixElements& e) {
+		static_assert(sizeof(Vector3) == sizeof(float) * 3, "Vector3 must be tightly packed");
+		size_t i = 0;
+		const float* s = &src->x;
+		float* d = &dst->x;
+#if defined(MATH_SIMD_SSE)
+		{
+			using Math::SIMD::MulAdd;
+			using Math::SIMD::ShuffleMask;
+			const __m128 m00 = _mm_set1_ps(e.m00), m01 = _mm_set1_ps(e.m01), m02 = _mm_set1_ps(e.m02);
+			const __m128 m10 = _mm_set1_ps(e.m10), m11 = _mm_set1_ps(e.m11), m12 = _mm_set1_ps(e.m12);
+			const __m128 m20 = _mm_set1_ps(e.m20), m21 = _mm_set1_ps(e.m21), m22 = _mm_set1_ps(e.m22);
+			const __m128 m30 = _mm_set1_ps(e.m30), m31 = _mm_set1_ps(e.m31), m32 = _mm_set1_ps(e.m32);
+			// 4要素(12float)ずつ SoA に並べ替えて処理する
+			for (; i + 4 <= count; i += 4) {
+				// p0 = x0 y0 z0 x1, p1 = y1 z1 x2 y2, p2 = z2 x3 y3 z3
+				__m128 p0 = _mm_loadu_ps(s + i * 3 + 0);
+				__m128 p1 = _mm_loadu_ps(s + i * 3 + 4);
+				__m128 p2 = _mm_loadu_ps(s + i * 3 + 8);
+
+				__m128 x = _mm_shuffle_ps(p0, _mm_shuffle_ps(p1, p2, ShuffleMask(2, 2, 1, 1)), ShuffleMask(0, 3, 0, 2));
+				__m128 y = _mm_shuffle_ps(
+					_mm_shuffle_ps(p0, p1, ShuffleMask(1, 1, 0, 0)),
+					_mm_shuffle_ps(p1, p2, ShuffleMask(3, 3, 2, 2)), ShuffleMask(0, 2, 0, 2));
+				__m128 z = _mm_shuffle_ps(_mm_shuffle_ps(p0, p1, ShuffleMask(2, 2, 1, 1)), p2, ShuffleMask(0, 2, 0, 3));
+
+				__m128 rx = MulAdd(z, m20, MulAdd(y, m10, MulAdd(x, m00, m30)));
+				__m128 ry = MulAdd(z, m21, MulAdd(y, m11, MulAdd(x, m01, m31)));
+				__m128 rz = MulAdd(z, m22, MulAdd(y, m12, MulAdd(x, m02, m32)));
+
+				// AoS に戻す
+				__m128 xyLow = _mm_unpacklo_ps(rx, ry);
+				__m128 xyHigh = _mm_unpackhi_ps(rx, ry);
+				p0 = _mm_shuffle_ps(xyLow, _mm_shuffle_ps(rz, rx, ShuffleMask(0, 0, 1, 1)), ShuffleMask(0, 1, 0, 2));
+				p1 = _mm_shuffle_ps(_mm_shuffle_ps(ry, rz, ShuffleMask(1, 1, 1, 1)), xyHigh, ShuffleMask(0, 2, 0, 1));
+				p2 = _mm_shuffle_ps(
+					_mm_shuffle_ps(rz, rx, ShuffleMask(2, 2, 3, 3)),
+					_mm_shuffle_ps(ry, rz, ShuffleMask(3, 3, 3, 3)), ShuffleMask(0, 2, 0, 2));
+				_mm_storeu_ps(d + i * 3 + 0, p0);
+				_mm_storeu_ps(d + i * 3 + 4, p1);
+				_mm_storeu_ps(d + i * 3 + 8, p2);
+			}
+		}
+#elif defined(MATH_SIMD_NEON)
+		{
+			// vld3 で読み込み時に SoA に並べ替える
+			for (; i + 4 <= count; i += 4) {
+				float32x4x3_t p = vld3q_f32(s + i * 3);
+				float32x4x3_t r;
+				r.val[0] = vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(vdupq_n_f32(e.m30), p.val[0], e.m00), p.val[1], e.m10), p.val[2], e.m20);
+				r.val[1] = vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(vdupq_n_f32(e.m31), p.val[0], e.m01), p.val[1], e.m11), p.val[2], e.m21);
+				r.val[2] = vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(vdupq_n_f32(e.m32), p.val[0], e.m02), p.val[1], e.m12), p.val[2], e.m22);
+				vst3q_f32(d + i * 3, r);
+			}
+		}
+#endif
+		// 端数
+		for (; i < count; i++) {
+			float x = s[i * 3 + 0], y = s[i * 3 + 1], z = s[i * 3 + 2];
+			d[i * 3 + 0] = x * e.m00 + y * e.m10 + z * e.m20 + e.m30;
+			d[i * 3 + 1] = x * e.m01 + y * e.m11 + z * e.m21 + e.m31;
+			d[i * 3 + 2] = x * e.m02 + y * e.m12 + z * e.m22 + e.m32;
+		}
+	}
+
+	void TransformAoS(std::span<const Vector3> src, const Matrix44& mat, float w, std::span<Vector3> dst) {
+		assert(dst.size() >= src.size());
+		MatrixElements e(mat, w);
+		Dispatch(src.size(), [&](size_t begin, size_t end) {
+			TransformAoSRange(src.data() + begin, dst.data() + begin, end - begin, e);
+			});
+	}
+
+	void TransformSoA(const ConstVector3SoA& src, const Matrix44& mat, float w, const Vector3SoA& dst) {
+		assert(src.y.size() == src.size() && src.z.size() == src.size());
+		assert(dst.x.size() >= src.size() && dst.y.size() >= src.size() && dst.z.size() >= src.size());
+		MatrixElements e(mat, w);
+		Dispatch(src.size(), [&](size_t begin, size_t end) {
+			TransformSoARange(
+				src.x.data() + begin, src.y.data() + begin, src.z.data() + begin,
+				dst.x.data() + begin, dst.y.data() + begin, dst.z.data() + begin,
+				end - begin, e);
+			});
+	}
+}
+
+void Math::TransformPoints(std::span<const Vector3> src, const Matrix44& mat, std::span<Vector3> dst) {
+	TransformAoS(src, mat, 1.0f, dst);
+}
+
+void Math::TransformVectors(std::span<const Vector3> src, const Matrix44& mat, std::span<Vector3> dst) {
+	TransformAoS(src, mat, 0.0f, dst);
+}
+
+void Math::TransformNormals(std::span<const Vector3> src, const Matrix44& mat, std::span<Vector3> dst) {
+	TransformAoS(src, CreateNormalMatrix(mat), 0.0f, dst);
+}
+
+void Math::TransformPoints(const ConstVector3SoA& src, const Matrix44& mat, const Vector3SoA& dst) {
+	TransformSoA(src, mat, 1.0f, dst);
+}
+
+void Math::TransformVectors(const ConstVector3SoA& src, const Matrix44& mat, const Vector3SoA& dst) {
+	TransformSoA(src, mat, 0.0f, dst);
+}
+
+void Math::TransformNormals(const ConstVector3SoA& src, const Matrix44& mat, const Vector3SoA& dst) {
+	TransformSoA(src, CreateNormalMatrix(mat), 0.0f, dst);
+}
+
+void Math::TransformPointsStrided(const void* src, size_t srcStride, void* dst, size_t dstStride, size_t count, const Matrix44& mat) {
+	// 詰まっている場合は AoS の処理に回す
+	if (srcStride == sizeof(Vector3) && dstStride == sizeof(Vector3)) {
+		TransformAoS(
+			std::span<const Vector3>(static_cast<const Vector3*>(src), count), mat, 1.0f,
+			std::span<Vector3>(static_cast<Vector3*>(dst), count));
+		return;
+	}
+	MatrixElements e(mat, 1.0f);
+	const char* srcBytes = static_cast<const char*>(src);
+	char* dstBytes = static_cast<char*>(dst);
+	Dispatch(count, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			float p[3];
+			std::memcpy(p, srcBytes + i * srcStride, sizeof(p));
+			float r[3] = {
+				p[0] * e.m00 + p[1] * e.m10 + p[2] * e.m20 + e.m30,
+				p[0] * e.m01 + p[1] * e.m11 + p[2] * e.m21 + e.m31,
+				p[0] * e.m02 + p[1] * e.m12 + p[2] * e.m22 + e.m32 };
+			std::memcpy(dstBytes + i * dstStride, r, sizeof(r));
+		}
+		});
+}
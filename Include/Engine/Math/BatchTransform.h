@@ -0,0 +1,107 @@
+#pragma once
+#ifndef BATCHTRANSFORM_H_
+#define BATCHTRANSFORM_H_
+
+#include <cstddef>
+#include <span>
+
+#include "MathUtility.h"
+
+/// <summary>
+/// 三次元ベクトル配列(SoA)
+/// </summary>
+struct Vector3SoA {
+	std::span<float> x;
+	std::span<float> y;
+	std::span<float> z;
+
+	inline size_t size() const { return x.size(); }
+};
+/// <summary>
+/// 読み取り専用の三次元ベクトル配列(SoA)
+/// </summary>
+struct ConstVector3SoA {
+	std::span<const float> x;
+	std::span<const float> y;
+	std::span<const float> z;
+
+	ConstVector3SoA() = default;
+	ConstVector3SoA(std::span<const float> x, std::span<const float> y, std::span<const float> z) : x(x), y(y), z(z) {}
+	ConstVector3SoA(const Vector3SoA& soa) : x(soa.x), y(soa.y), z(soa.z) {}
+
+	inline size_t size() const { return x.size(); }
+};
+
+/// <summary>
+/// 一つの行列で配列をまとめて変換する
+/// 要素数が kBatchParallelThreshold 以上の場合は ThreadPool で分割して処理する
+/// src と dst は同じ配列でもよい(一部が重なるのは不可)
+/// </summary>
+namespace Math
+{
+	// 並列処理を行う要素数
+	constexpr size_t kBatchParallelThreshold = 16 * 1024;
+
+	/// <summary>
+	/// 座標を変換(w = 1)
+	/// </summary>
+	/// <param name="src">変換前</param>
+	/// <param name="mat">行列</param>
+	/// <param name="dst">変換後(src 以上の要素数)</param>
+	void TransformPoints(std::span<const Vector3> src, const Matrix44& mat, std::span<Vector3> dst);
+	/// <summary>
+	/// 方向ベクトルを変換(w = 0)
+	/// </summary>
+	/// <param name="src">変換前</param>
+	/// <param name="mat">行列</param>
+	/// <param name="dst">変換後(src 以上の要素数)</param>
+	void TransformVectors(std::span<const Vector3> src, const Matrix44& mat, std::span<Vector3> dst);
+	/// <summary>
+	/// 法線を変換(逆転置行列で変換し、正規化はしない)
+	/// </summary>
+	/// <param name="src">変換前</param>
+	/// <param name="mat">行列(法線用に変換する前のもの)</param>
+	/// <param name="dst">変換後(src 以上の要素数)</param>
+	void TransformNormals(std::span<const Vector3> src, const Matrix44& mat, std::span<Vector3> dst);
+
+	/// <summary>
+	/// 座標を変換(SoA, w = 1)
+	/// </summary>
+	void TransformPoints(const ConstVector3SoA& src, const Matrix44& mat, const Vector3SoA& dst);
+	/// <summary>
+	/// 方向ベクトルを変換(SoA, w = 0)
+	/// </summary>
+	void TransformVectors(const ConstVector3SoA& src, const Matrix44& mat, const Vector3SoA& dst);
+	/// <summary>
+	/// 法線を変換(SoA, 正規化はしない)
+	/// </summary>
+	void TransformNormals(const ConstVector3SoA& src, const Matrix44& mat, const Vector3SoA& dst);
+
+	/// <summary>
+	/// 頂点構造体の中の座標を変換する(AoS, ストライド指定)
+	/// </summary>
+	/// <param name="src">最初の座標へのポインタ</param>
+	/// <param name="srcStride">要素間のバイト数</param>
+	/// <param name="dst">最初の書き込み先へのポインタ</param>
+	/// <param name="dstStride">要素間のバイト数</param>
+	/// <param name="count">要素数</param>
+	/// <param name="mat">行列</param>
+	void TransformPointsStrided(const void* src, size_t srcStride, void* dst, size_t dstStride, size_t count, const Matrix44& mat);
+	/// <summary>
+	/// 頂点配列の座標を変換する
+	/// </summary>
+	/// <typeparam name="VERTEX_TYPE">頂点の型</typeparam>
+	/// <param name="vertices">頂点配列</param>
+	/// <param name="position">座標メンバへのポインタ</param>
+	/// <param name="mat">行列</param>
+	template<class VERTEX_TYPE>
+	inline void TransformVertexPositions(std::span<VERTEX_TYPE> vertices, Vector3 VERTEX_TYPE::* position, const Matrix44& mat) {
+		if (vertices.empty()) {
+			return;
+		}
+		Vector3* first = &(vertices.front().*position);
+		TransformPointsStrided(first, sizeof(VERTEX_TYPE), first, sizeof(VERTEX_TYPE), vertices.size(), mat);
+	}
+}
+
+#endif
@@ -0,0 +1,428 @@
+#include "Geometry.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+using namespace Math::SIMD;
+
+namespace {
+	// 平行に近いとみなす値
+	constexpr float kEpsilon = 1.0e-6f;
+
+	// 三次元ベクトル kWidthN 個
+	struct Vector3N {
+		FloatN x, y, z;
+	};
+
+	inline Vector3N LoadVector3N(const ConstVector3SoA& soa, size_t i) {
+		return { LoadN(soa.x.data() + i), LoadN(soa.y.data() + i), LoadN(soa.z.data() + i) };
+	}
+	inline Vector3N SetVector3N(const Vector3& v) {
+		return { SetN(v.x), SetN(v.y), SetN(v.z) };
+	}
+	inline Vector3N operator+(const Vector3N& a, const Vector3N& b) {
+		return { a.x + b.x, a.y + b.y, a.z + b.z };
+	}
+	inline Vector3N operator-(const Vector3N& a, const Vector3N& b) {
+		return { a.x - b.x, a.y - b.y, a.z - b.z };
+	}
+	inline FloatN Dot(const Vector3N& a, const Vector3N& b) {
+		return MulAddN(a.z, b.z, MulAddN(a.y, b.y, a.x * b.x));
+	}
+	inline Vector3N Cross(const Vector3N& a, const Vector3N& b) {
+		return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+	}
+
+	// 判定結果を書き込む
+	inline void StoreMask(unsigned int bits, uint8_t* results) {
+		for (size_t i = 0; i < kWidthN; i++) {
+			results[i] = static_cast<uint8_t>((bits >> i) & 1);
+		}
+	}
+
+	// kWidthN 個ずつ処理し、端数は単体の判定で処理する
+	// block(i) は交差した要素のビットを返し、single(i) は交差したかを返す
+	template<class BLOCK, class SINGLE>
+	size_t ForEachBlock(size_t count, BLOCK&& block, SINGLE&& single) {
+		size_t hitCount = 0;
+		size_t i = 0;
+		// 1要素ずつの場合は早期終了できる単体の判定の方が速い
+		if constexpr (kWidthN > 1) {
+			for (; i + kWidthN <= count; i += kWidthN) {
+				hitCount += std::popcount(block(i));
+			}
+		}
+		for (; i < count; i++) {
+			hitCount += single(i) ? 1 : 0;
+		}
+		return hitCount;
+	}
+
+	// 視錐台の平面を kWidthN 個に複製したもの
+	struct FrustumN {
+		Vector3N normal[Frustum::kPlaneCount];
+		Vector3N absNormal[Frustum::kPlaneCount];
+		FloatN distance[Frustum::kPlaneCount];
+
+		explicit FrustumN(const Frustum& frustum) {
+			for (size_t p = 0; p < Frustum::kPlaneCount; p++) {
+				const Plane& plane = frustum.planes[p];
+				normal[p] = SetVector3N(plane.normal);
+				absNormal[p] = SetVector3N(Vector3(Math::Abs(plane.normal.x), Math::Abs(plane.normal.y), Math::Abs(plane.normal.z)));
+				distance[p] = SetN(plane.distance);
+			}
+		}
+	};
+
+	// 視錐台と球
+	inline unsigned int IntersectsN(const FrustumN& frustum, const Vector3N& center, FloatN radius) {
+		FloatN negRadius = SetN(0.0f) - radius;
+		MaskN inside = Dot(frustum.normal[0], center) + frustum.distance[0] >= negRadius;
+		for (size_t p = 1; p < Frustum::kPlaneCount; p++) {
+			inside = inside & (Dot(frustum.normal[p], center) + frustum.distance[p] >= negRadius);
+		}
+		return MoveMaskN(inside);
+	}
+	// 視錐台と軸平行境界ボックス
+	inline unsigned int IntersectsN(const FrustumN& frustum, const Vector3N& center, const Vector3N& extents) {
+		MaskN inside = Dot(frustum.normal[0], center) + frustum.distance[0] >= SetN(0.0f) - Dot(frustum.absNormal[0], extents);
+		for (size_t p = 1; p < Frustum::kPlaneCount; p++) {
+			FloatN radius = Dot(frustum.absNormal[p], extents);
+			inside = inside & (Dot(frustum.normal[p], center) + frustum.distance[p] >= SetN(0.0f) - radius);
+		}
+		return MoveMaskN(inside);
+	}
+
+	// 有向境界ボックス同士の分離軸判定
+	inline unsigned int IntersectsN(const OBB& a, const Vector3N& center, const Vector3N (&axis)[3], const Vector3N& extents) {
+		const FloatN epsilon = SetN(kEpsilon);
+		const FloatN ae[3] = { SetN(a.extents.x), SetN(a.extents.y), SetN(a.extents.z) };
+		const FloatN be[3] = { extents.x, extents.y, extents.z };
+		// b の軸を a の空間で表した回転
+		FloatN r[3][3], absR[3][3];
+		for (size_t i = 0; i < 3; i++) {
+			Vector3N ai = SetVector3N(a.axis[i]);
+			for (size_t j = 0; j < 3; j++) {
+				r[i][j] = Dot(ai, axis[j]);
+				absR[i][j] = AbsN(r[i][j]) + epsilon;
+			}
+		}
+		// 中心間の距離を a の空間で表す
+		Vector3N d = center - SetVector3N(a.center);
+		FloatN t[3] = { Dot(d, SetVector3N(a.axis[0])), Dot(d, SetVector3N(a.axis[1])), Dot(d, SetVector3N(a.axis[2])) };
+
+		// a の軸(分離していない要素が残る)
+		MaskN overlap = AbsN(t[0]) <= ae[0] + be[0] * absR[0][0] + be[1] * absR[0][1] + be[2] * absR[0][2];
+		for (size_t i = 1; i < 3; i++) {
+			FloatN rb = be[0] * absR[i][0] + be[1] * absR[i][1] + be[2] * absR[i][2];
+			overlap = overlap & (AbsN(t[i]) <= ae[i] + rb);
+		}
+		// b の軸
+		for (size_t j = 0; j < 3; j++) {
+			FloatN ra = ae[0] * absR[0][j] + ae[1] * absR[1][j] + ae[2] * absR[2][j];
+			FloatN dist = t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j];
+			overlap = overlap & (AbsN(dist) <= ra + be[j]);
+		}
+		// 各軸同士の外積
+		for (size_t i = 0; i < 3; i++) {
+			size_t i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+			for (size_t j = 0; j < 3; j++) {
+				size_t j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+				FloatN ra = ae[i1] * absR[i2][j] + ae[i2] * absR[i1][j];
+				FloatN rb = be[j1] * absR[i][j2] + be[j2] * absR[i][j1];
+				FloatN dist = t[i2] * r[i1][j] - t[i1] * r[i2][j];
+				overlap = overlap & (AbsN(dist) <= ra + rb);
+			}
+		}
+		return MoveMaskN(overlap);
+	}
+}
+
+Sphere Sphere::Transformed(const Matrix44& mat) const {
+	float scaleSquare = std::max({ mat.GetXAxis().LengthSquare(), mat.GetYAxis().LengthSquare(), mat.GetZAxis().LengthSquare() });
+	return Sphere{ center * mat, radius * Math::Sqrt(scaleSquare) };
+}
+
+AABB AABB::Transformed(const Matrix44& mat) const {
+	// 中心を変換し、大きさは行列の絶対値で広げる
+	Vector3 center = GetCenter() * mat;
+	Vector3 extents = GetExtents();
+	Vector3 newExtents;
+	for (size_t j = 0; j < 3; j++) {
+		newExtents[j] =
+			Math::Abs(mat.m[0][j]) * extents.x +
+			Math::Abs(mat.m[1][j]) * extents.y +
+			Math::Abs(mat.m[2][j]) * extents.z;
+	}
+	return CreateFromCenterExtents(center, newExtents);
+}
+
+OBB OBB::CreateFromAABB(const AABB& aabb, const Matrix44& mat) {
+	OBB result;
+	result.center = aabb.GetCenter() * mat;
+	Vector3 extents = aabb.GetExtents();
+	Vector3 axes[3] = { mat.GetXAxis(), mat.GetYAxis(), mat.GetZAxis() };
+	for (size_t i = 0; i < 3; i++) {
+		float length = axes[i].Length();
+		result.axis[i] = axes[i] / length;
+		result.extents[i] = extents[i] * length;
+	}
+	return result;
+}
+
+Frustum Frustum::CreateFromMatrix(const Matrix44& viewProj) {
+	// クリップ空間の x, y, z, w 列から平面を取り出す
+	auto column = [&](size_t j) {
+		return Vector4(viewProj.m[0][j], viewProj.m[1][j], viewProj.m[2][j], viewProj.m[3][j]);
+	};
+	auto toPlane = [](const Vector4& v) {
+		return Plane{ v.xyz(), v.w }.Normalized();
+	};
+	Vector4 x = column(0), y = column(1), z = column(2), w = column(3);
+
+	Frustum result;
+	result.planes[kLeft] = toPlane(w + x);
+	result.planes[kRight] = toPlane(w - x);
+	result.planes[kBottom] = toPlane(w + y);
+	result.planes[kTop] = toPlane(w - y);
+	result.planes[kNear] = toPlane(z);
+	result.planes[kFar] = toPlane(w - z);
+	return result;
+}
+
+bool Math::Intersects(const Frustum& frustum, const Sphere& sphere) {
+	for (const auto& plane : frustum.planes) {
+		if (plane.GetSignedDistance(sphere.center) < -sphere.radius) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool Math::Intersects(const Frustum& frustum, const AABB& aabb) {
+	Vector3 center = aabb.GetCenter();
+	Vector3 extents = aabb.GetExtents();
+	for (const auto& plane : frustum.planes) {
+		float radius =
+			Math::Abs(plane.normal.x) * extents.x +
+			Math::Abs(plane.normal.y) * extents.y +
+			Math::Abs(plane.normal.z) * extents.z;
+		if (plane.GetSignedDistance(center) < -radius) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool Math::Intersects(const Ray& ray, const AABB& aabb, float& distance) {
+	float tMin = 0.0f;
+	float tMax = std::numeric_limits<float>::max();
+	for (size_t i = 0; i < 3; i++) {
+		float invDir = 1.0f / ray.direction[i];
+		float t1 = (aabb.min[i] - ray.origin[i]) * invDir;
+		float t2 = (aabb.max[i] - ray.origin[i]) * invDir;
+		tMin = Math::Max(tMin, Math::Min(t1, t2));
+		tMax = Math::Min(tMax, Math::Max(t1, t2));
+	}
+	if (tMin > tMax) {
+		return false;
+	}
+	distance = tMin;
+	return true;
+}
+
+bool Math::Intersects(const Ray& ray, const Vector3& v0, const Vector3& v1, const Vector3& v2, float& distance) {
+	Vector3 edge1 = v1 - v0;
+	Vector3 edge2 = v2 - v0;
+	Vector3 p = Cross(ray.direction, edge2);
+	float det = Dot(edge1, p);
+	if (Math::Abs(det) <= kEpsilon) {
+		return false;
+	}
+	float invDet = 1.0f / det;
+	Vector3 s = ray.origin - v0;
+	float u = Dot(s, p) * invDet;
+	if (u < 0.0f || u > 1.0f) {
+		return false;
+	}
+	Vector3 q = Cross(s, edge1);
+	float v = Dot(ray.direction, q) * invDet;
+	if (v < 0.0f || u + v > 1.0f) {
+		return false;
+	}
+	float t = Dot(edge2, q) * invDet;
+	if (t < 0.0f) {
+		return false;
+	}
+	distance = t;
+	return true;
+}
+
+bool Math::Intersects(const OBB& obb1, const OBB& obb2) {
+	float r[3][3], absR[3][3];
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < 3; j++) {
+			r[i][j] = Dot(obb1.axis[i], obb2.axis[j]);
+			absR[i][j] = Math::Abs(r[i][j]) + kEpsilon;
+		}
+	}
+	Vector3 d = obb2.center - obb1.center;
+	float t[3] = { Dot(d, obb1.axis[0]), Dot(d, obb1.axis[1]), Dot(d, obb1.axis[2]) };
+	const Vector3& ae = obb1.extents;
+	const Vector3& be = obb2.extents;
+
+	for (size_t i = 0; i < 3; i++) {
+		float rb = be.x * absR[i][0] + be.y * absR[i][1] + be.z * absR[i][2];
+		if (Math::Abs(t[i]) > ae[i] + rb) {
+			return false;
+		}
+	}
+	for (size_t j = 0; j < 3; j++) {
+		float ra = ae.x * absR[0][j] + ae.y * absR[1][j] + ae.z * absR[2][j];
+		float dist = t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j];
+		if (Math::Abs(dist) > ra + be[j]) {
+			return false;
+		}
+	}
+	for (size_t i = 0; i < 3; i++) {
+		size_t i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+		for (size_t j = 0; j < 3; j++) {
+			size_t j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+			float ra = ae[i1] * absR[i2][j] + ae[i2] * absR[i1][j];
+			float rb = be[j1] * absR[i][j2] + be[j2] * absR[i][j1];
+			float dist = t[i2] * r[i1][j] - t[i1] * r[i2][j];
+			if (Math::Abs(dist) > ra + rb) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+size_t Math::IntersectsBatch(const Frustum& frustum, const SphereSoA& spheres, std::span<uint8_t> results) {
+	assert(results.size() >= spheres.size());
+	FrustumN frustumN(frustum);
+	return ForEachBlock(spheres.size(),
+		[&](size_t i) {
+			unsigned int bits = IntersectsN(frustumN, LoadVector3N(spheres.center, i), LoadN(spheres.radius.data() + i));
+			StoreMask(bits, results.data() + i);
+			return bits;
+		},
+		[&](size_t i) {
+			Sphere sphere{ Vector3(spheres.center.x[i], spheres.center.y[i], spheres.center.z[i]), spheres.radius[i] };
+			bool hit = Intersects(frustum, sphere);
+			results[i] = hit ? 1 : 0;
+			return hit;
+		});
+}
+
+size_t Math::IntersectsBatch(const Frustum& frustum, const AABBSoA& aabbs, std::span<uint8_t> results) {
+	assert(results.size() >= aabbs.size());
+	FrustumN frustumN(frustum);
+	return ForEachBlock(aabbs.size(),
+		[&](size_t i) {
+			unsigned int bits = IntersectsN(frustumN, LoadVector3N(aabbs.center, i), LoadVector3N(aabbs.extents, i));
+			StoreMask(bits, results.data() + i);
+			return bits;
+		},
+		[&](size_t i) {
+			AABB aabb = AABB::CreateFromCenterExtents(
+				Vector3(aabbs.center.x[i], aabbs.center.y[i], aabbs.center.z[i]),
+				Vector3(aabbs.extents.x[i], aabbs.extents.y[i], aabbs.extents.z[i]));
+			bool hit = Intersects(frustum, aabb);
+			results[i] = hit ? 1 : 0;
+			return hit;
+		});
+}
+
+size_t Math::IntersectsBatch(const Ray& ray, const AABBSoA& aabbs, std::span<float> distances) {
+	assert(distances.size() >= aabbs.size());
+	const Vector3N origin = SetVector3N(ray.origin);
+	const Vector3N invDir = SetVector3N(Vector3(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z));
+	const FloatN noHit = SetN(kNoHit);
+	return ForEachBlock(aabbs.size(),
+		[&](size_t i) {
+			Vector3N center = LoadVector3N(aabbs.center, i);
+			Vector3N extents = LoadVector3N(aabbs.extents, i);
+			Vector3N t1 = center - extents - origin;
+			Vector3N t2 = center + extents - origin;
+			t1 = { t1.x * invDir.x, t1.y * invDir.y, t1.z * invDir.z };
+			t2 = { t2.x * invDir.x, t2.y * invDir.y, t2.z * invDir.z };
+			FloatN tMin = MaxN(MaxN(MinN(t1.x, t2.x), MinN(t1.y, t2.y)), MaxN(MinN(t1.z, t2.z), SetN(0.0f)));
+			FloatN tMax = MinN(MinN(MaxN(t1.x, t2.x), MaxN(t1.y, t2.y)), MaxN(t1.z, t2.z));
+			MaskN hit = tMin <= tMax;
+			StoreN(distances.data() + i, SelectN(hit, tMin, noHit));
+			return MoveMaskN(hit);
+		},
+		[&](size_t i) {
+			AABB aabb = AABB::CreateFromCenterExtents(
+				Vector3(aabbs.center.x[i], aabbs.center.y[i], aabbs.center.z[i]),
+				Vector3(aabbs.extents.x[i], aabbs.extents.y[i], aabbs.extents.z[i]));
+			float distance = kNoHit;
+			bool hit = Intersects(ray, aabb, distance);
+			distances[i] = distance;
+			return hit;
+		});
+}
+
+size_t Math::IntersectsBatch(const Ray& ray, const TriangleSoA& triangles, std::span<float> distances) {
+	assert(distances.size() >= triangles.size());
+	const Vector3N origin = SetVector3N(ray.origin);
+	const Vector3N direction = SetVector3N(ray.direction);
+	const FloatN zero = SetN(0.0f);
+	const FloatN one = SetN(1.0f);
+	const FloatN epsilon = SetN(kEpsilon);
+	const FloatN noHit = SetN(kNoHit);
+	return ForEachBlock(triangles.size(),
+		[&](size_t i) {
+			Vector3N v0 = LoadVector3N(triangles.v0, i);
+			Vector3N edge1 = LoadVector3N(triangles.v1, i) - v0;
+			Vector3N edge2 = LoadVector3N(triangles.v2, i) - v0;
+			Vector3N p = Cross(direction, edge2);
+			FloatN det = Dot(edge1, p);
+			// 平行な要素は 0 除算になるが結果をマスクで捨てる
+			FloatN invDet = one / det;
+			Vector3N s = origin - v0;
+			FloatN u = Dot(s, p) * invDet;
+			Vector3N q = Cross(s, edge1);
+			FloatN v = Dot(direction, q) * invDet;
+			FloatN t = Dot(edge2, q) * invDet;
+			MaskN hit = (AbsN(det) > epsilon) & (u >= zero) & (v >= zero) & (u + v <= one) & (t >= zero);
+			StoreN(distances.data() + i, SelectN(hit, t, noHit));
+			return MoveMaskN(hit);
+		},
+		[&](size_t i) {
+			float distance = kNoHit;
+			bool hit = Intersects(ray,
+				Vector3(triangles.v0.x[i], triangles.v0.y[i], triangles.v0.z[i]),
+				Vector3(triangles.v1.x[i], triangles.v1.y[i], triangles.v1.z[i]),
+				Vector3(triangles.v2.x[i], triangles.v2.y[i], triangles.v2.z[i]),
+				distance);
+			distances[i] = distance;
+			return hit;
+		});
+}
+
+size_t Math::IntersectsBatch(const OBB& obb, const OBBSoA& obbs, std::span<uint8_t> results) {
+	assert(results.size() >= obbs.size());
+	return ForEachBlock(obbs.size(),
+		[&](size_t i) {
+			Vector3N axis[3] = { LoadVector3N(obbs.axisX, i), LoadVector3N(obbs.axisY, i), LoadVector3N(obbs.axisZ, i) };
+			unsigned int bits = IntersectsN(obb, LoadVector3N(obbs.center, i), axis, LoadVector3N(obbs.extents, i));
+			StoreMask(bits, results.data() + i);
+			return bits;
+		},
+		[&](size_t i) {
+			auto load = [i](const ConstVector3SoA& soa) { return Vector3(soa.x[i], soa.y[i], soa.z[i]); };
+			OBB other;
+			other.center = load(obbs.center);
+			other.axis[0] = load(obbs.axisX);
+			other.axis[1] = load(obbs.axisY);
+			other.axis[2] = load(obbs.axisZ);
+			other.extents = load(obbs.extents);
+			bool hit = Intersects(obb, other);
+			results[i] = hit ? 1 : 0;
+			return hit;
+		});
+}
@@ -0,0 +1,269 @@
+#pragma once
+#ifndef GEOMETRY_H_
+#define GEOMETRY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include "MathUtility.h"
+#include "BatchTransform.h"
+
+/// <summary>
+/// 球
+/// </summary>
+struct Sphere {
+	Vector3 center;
+	float radius;
+
+	/// <summary>
+	/// 変換後の球を包む球
+	/// </summary>
+	/// <param name="mat">アフィン行列(拡縮は最も大きい軸に合わせる)</param>
+	/// <returns></returns>
+	Sphere Transformed(const Matrix44& mat) const;
+};
+/// <summary>
+/// 軸平行境界ボックス
+/// </summary>
+struct AABB {
+	Vector3 min;
+	Vector3 max;
+
+	/// <summary>
+	/// 中心
+	/// </summary>
+	/// <returns></returns>
+	inline Vector3 GetCenter() const { return (min + max) * 0.5f; }
+	/// <summary>
+	/// 各軸の半分の大きさ
+	/// </summary>
+	/// <returns></returns>
+	inline Vector3 GetExtents() const { return (max - min) * 0.5f; }
+	/// <summary>
+	/// 変換後のボックスを包むボックス
+	/// </summary>
+	/// <param name="mat">アフィン行列</param>
+	/// <returns></returns>
+	AABB Transformed(const Matrix44& mat) const;
+
+	/// <summary>
+	/// 中心と大きさから作成
+	/// </summary>
+	/// <param name="center">中心</param>
+	/// <param name="extents">各軸の半分の大きさ</param>
+	/// <returns></returns>
+	static inline AABB CreateFromCenterExtents(const Vector3& center, const Vector3& extents) {
+		return AABB{ center - extents, center + extents };
+	}
+};
+/// <summary>
+/// 有向境界ボックス
+/// </summary>
+struct OBB {
+	Vector3 center;
+	// 各軸の向き(正規化済み)
+	Vector3 axis[3];
+	// 各軸の半分の大きさ
+	Vector3 extents;
+
+	/// <summary>
+	/// AABB をアフィン行列で変換して作成
+	/// </summary>
+	/// <param name="aabb">ローカル空間のボックス</param>
+	/// <param name="mat">アフィン行列(せん断を含まないこと)</param>
+	/// <returns></returns>
+	static OBB CreateFromAABB(const AABB& aabb, const Matrix44& mat);
+};
+/// <summary>
+/// 平面
+/// Dot(normal, p) + distance = 0 で normal 側が表
+/// </summary>
+struct Plane {
+	Vector3 normal;
+	float distance;
+
+	/// <summary>
+	/// 点までの符号付き距離
+	/// </summary>
+	/// <param name="point">点</param>
+	/// <returns>表側が正</returns>
+	inline float GetSignedDistance(const Vector3& point) const { return Dot(normal, point) + distance; }
+	/// <summary>
+	/// 法線を正規化した平面
+	/// </summary>
+	/// <returns></returns>
+	inline Plane Normalized() const {
+		float invLength = 1.0f / normal.Length();
+		return Plane{ normal * invLength, distance * invLength };
+	}
+
+	/// <summary>
+	/// 平面上の点と法線から作成
+	/// </summary>
+	/// <param name="point">平面上の点</param>
+	/// <param name="normal">正規化済みの法線</param>
+	/// <returns></returns>
+	static inline Plane CreateFromPointNormal(const Vector3& point, const Vector3& normal) {
+		return Plane{ normal, -Dot(normal, point) };
+	}
+};
+/// <summary>
+/// 視錐台(法線は内向き)
+/// </summary>
+struct Frustum {
+	enum PlaneIndex {
+		kLeft,
+		kRight,
+		kBottom,
+		kTop,
+		kNear,
+		kFar,
+
+		kPlaneCount
+	};
+
+	Plane planes[kPlaneCount];
+
+	/// <summary>
+	/// ビュープロジェクション行列から作成(ワールド空間の視錐台になる)
+	/// </summary>
+	/// <param name="viewProj">ビュー行列 * 射影行列(z は 0 ~ 1)</param>
+	/// <returns></returns>
+	static Frustum CreateFromMatrix(const Matrix44& viewProj);
+};
+/// <summary>
+/// 半直線
+/// </summary>
+struct Ray {
+	Vector3 origin;
+	// 向き(交差距離はこの長さを単位とする)
+	Vector3 direction;
+};
+
+/// <summary>
+/// 球の配列(SoA)
+/// </summary>
+struct SphereSoA {
+	ConstVector3SoA center;
+	std::span<const float> radius;
+
+	inline size_t size() const { return radius.size(); }
+};
+/// <summary>
+/// 軸平行境界ボックスの配列(SoA)
+/// </summary>
+struct AABBSoA {
+	ConstVector3SoA center;
+	ConstVector3SoA extents;
+
+	inline size_t size() const { return center.size(); }
+};
+/// <summary>
+/// 三角形の配列(SoA)
+/// </summary>
+struct TriangleSoA {
+	ConstVector3SoA v0;
+	ConstVector3SoA v1;
+	ConstVector3SoA v2;
+
+	inline size_t size() const { return v0.size(); }
+};
+/// <summary>
+/// 有向境界ボックスの配列(SoA)
+/// </summary>
+struct OBBSoA {
+	ConstVector3SoA center;
+	ConstVector3SoA axisX;
+	ConstVector3SoA axisY;
+	ConstVector3SoA axisZ;
+	ConstVector3SoA extents;
+
+	inline size_t size() const { return center.size(); }
+};
+
+/// <summary>
+/// 交差判定
+/// 単体の判定はスカラーで実装した基準になるもの
+/// まとめて判定する関数(IntersectsBatch)は Math::SIMD::kWidthN 個ずつ処理し、端数は単体の判定で処理する
+/// </summary>
+namespace Math
+{
+	// 当たらなかった場合の距離
+	constexpr float kNoHit = std::numeric_limits<float>::infinity();
+
+	/// <summary>
+	/// 視錐台と球(一部でも内側なら true)
+	/// </summary>
+	bool Intersects(const Frustum& frustum, const Sphere& sphere);
+	/// <summary>
+	/// 視錐台と軸平行境界ボックス(一部でも内側なら true、角付近は保守的に true になる)
+	/// </summary>
+	bool Intersects(const Frustum& frustum, const AABB& aabb);
+	/// <summary>
+	/// 半直線と軸平行境界ボックス
+	/// </summary>
+	/// <param name="ray">半直線</param>
+	/// <param name="aabb">ボックス</param>
+	/// <param name="distance">交差距離(始点が内側の場合は0)</param>
+	/// <returns></returns>
+	bool Intersects(const Ray& ray, const AABB& aabb, float& distance);
+	/// <summary>
+	/// 半直線と三角形(両面)
+	/// </summary>
+	/// <param name="ray">半直線</param>
+	/// <param name="v0">頂点0</param>
+	/// <param name="v1">頂点1</param>
+	/// <param name="v2">頂点2</param>
+	/// <param name="distance">交差距離</param>
+	/// <returns></returns>
+	bool Intersects(const Ray& ray, const Vector3& v0, const Vector3& v1, const Vector3& v2, float& distance);
+	/// <summary>
+	/// 有向境界ボックス同士(分離軸判定)
+	/// </summary>
+	bool Intersects(const OBB& obb1, const OBB& obb2);
+
+	/// <summary>
+	/// 視錐台と球をまとめて判定
+	/// </summary>
+	/// <param name="frustum">視錐台</param>
+	/// <param name="spheres">球</param>
+	/// <param name="results">結果 1: 交差 0: 外側(spheres 以上の要素数)</param>
+	/// <returns>交差した数</returns>
+	size_t IntersectsBatch(const Frustum& frustum, const SphereSoA& spheres, std::span<uint8_t> results);
+	/// <summary>
+	/// 視錐台と軸平行境界ボックスをまとめて判定
+	/// </summary>
+	/// <param name="frustum">視錐台</param>
+	/// <param name="aabbs">ボックス</param>
+	/// <param name="results">結果 1: 交差 0: 外側(aabbs 以上の要素数)</param>
+	/// <returns>交差した数</returns>
+	size_t IntersectsBatch(const Frustum& frustum, const AABBSoA& aabbs, std::span<uint8_t> results);
+	/// <summary>
+	/// 半直線と軸平行境界ボックスをまとめて判定
+	/// </summary>
+	/// <param name="ray">半直線</param>
+	/// <param name="aabbs">ボックス</param>
+	/// <param name="distances">交差距離 当たらない場合は kNoHit(aabbs 以上の要素数)</param>
+	/// <returns>交差した数</returns>
+	size_t IntersectsBatch(const Ray& ray, const AABBSoA& aabbs, std::span<float> distances);
+	/// <summary>
+	/// 半直線と三角形をまとめて判定
+	/// </summary>
+	/// <param name="ray">半直線</param>
+	/// <param name="triangles">三角形</param>
+	/// <param name="distances">交差距離 当たらない場合は kNoHit(triangles 以上の要素数)</param>
+	/// <returns>交差した数</returns>
+	size_t IntersectsBatch(const Ray& ray, const TriangleSoA& triangles, std::span<float> distances);
+	/// <summary>
+	/// 一つの有向境界ボックスと複数の有向境界ボックスをまとめて判定
+	/// </summary>
+	/// <param name="obb">判定する側</param>
+	/// <param name="obbs">判定される側</param>
+	/// <param name="results">結果 1: 交差 0: 分離(obbs 以上の要素数)</param>
+	/// <returns>交差した数</returns>
+	size_t IntersectsBatch(const OBB& obb, const OBBSoA& obbs, std::span<uint8_t> results);
+}
+
+#endif
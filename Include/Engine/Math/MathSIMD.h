@@ -0,0 +1,632 @@
+#pragma once
+#ifndef MATHSIMD_H_
+#define MATHSIMD_H_
+
+#include <cmath>
+#include <cstddef>
+
+// 使用する命令セットをコンパイル時に選択する
+// MATH_SIMD_DISABLE を定義するとすべてスカラー実装になる
+#if !defined(MATH_SIMD_DISABLE)
+#if defined(__AVX2__)
+#define MATH_SIMD_AVX2
+#define MATH_SIMD_SSE
+#elif defined(_M_X64) || defined(_M_AMD64) || defined(__SSE4_1__) || defined(__SSE2__)
+#define MATH_SIMD_SSE
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#define MATH_SIMD_NEON
+#endif
+#endif
+
+#if defined(MATH_SIMD_AVX2) && (defined(_MSC_VER) || defined(__FMA__))
+#define MATH_SIMD_FMA
+#endif
+
+#if defined(MATH_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(MATH_SIMD_SSE)
+#include <emmintrin.h>
+#elif defined(MATH_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+/// <summary>
+/// 行列演算のカーネル
+/// 行列はすべて行優先の float[16] で 16 バイトアラインされていること
+/// </summary>
+namespace Math {
+namespace SIMD
+{
+#if defined(MATH_SIMD_SSE)
+	// _mm_shuffle_ps 用のマスク
+	constexpr int ShuffleMask(int x, int y, int z, int w) {
+		return x | (y << 2) | (z << 4) | (w << 6);
+	}
+	// a * b + c
+	inline __m128 MulAdd(__m128 a, __m128 b, __m128 c) {
+#if defined(MATH_SIMD_FMA)
+		return _mm_fmadd_ps(a, b, c);
+#else
+		return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+	}
+	// 2×2行列の積 A * B
+	inline __m128 Mat2Mul(__m128 a, __m128 b) {
+		return _mm_add_ps(
+			_mm_mul_ps(a, _mm_shuffle_ps(b, b, ShuffleMask(0, 3, 0, 3))),
+			_mm_mul_ps(_mm_shuffle_ps(a, a, ShuffleMask(1, 0, 3, 2)), _mm_shuffle_ps(b, b, ShuffleMask(2, 1, 2, 1))));
+	}
+	// 2×2行列の積 adj(A) * B
+	inline __m128 Mat2AdjMul(__m128 a, __m128 b) {
+		return _mm_sub_ps(
+			_mm_mul_ps(_mm_shuffle_ps(a, a, ShuffleMask(3, 3, 0, 0)), b),
+			_mm_mul_ps(_mm_shuffle_ps(a, a, ShuffleMask(1, 1, 2, 2)), _mm_shuffle_ps(b, b, ShuffleMask(2, 3, 0, 1))));
+	}
+	// 2×2行列の積 A * adj(B)
+	inline __m128 Mat2MulAdj(__m128 a, __m128 b) {
+		return _mm_sub_ps(
+			_mm_mul_ps(a, _mm_shuffle_ps(b, b, ShuffleMask(3, 0, 3, 0))),
+			_mm_mul_ps(_mm_shuffle_ps(a, a, ShuffleMask(1, 0, 3, 2)), _mm_shuffle_ps(b, b, ShuffleMask(2, 1, 2, 1))));
+	}
+	// 全要素の和を全要素に入れる
+	inline __m128 HorizontalSum(__m128 v) {
+		__m128 t = _mm_add_ps(v, _mm_shuffle_ps(v, v, ShuffleMask(1, 0, 3, 2)));
+		return _mm_add_ps(t, _mm_shuffle_ps(t, t, ShuffleMask(2, 3, 0, 1)));
+	}
+#endif
+
+	/// <summary>
+	/// 4×4行列の積
+	/// </summary>
+	/// <param name="a">左辺</param>
+	/// <param name="b">右辺</param>
+	/// <param name="out">結果(a, b と同じでもよい)</param>
+	inline void Multiply44(const float* a, const float* b, float* out) {
+#if defined(MATH_SIMD_AVX2)
+		__m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 0));
+		__m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 4));
+		__m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 8));
+		__m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 12));
+		// 2行ずつ処理する
+		__m256 a01 = _mm256_loadu_ps(a + 0);
+		__m256 a23 = _mm256_loadu_ps(a + 8);
+		__m256 r01 = _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0x00), b0);
+		__m256 r23 = _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0x00), b0);
+#if defined(MATH_SIMD_FMA)
+		r01 = _mm256_fmadd_ps(_mm256_shuffle_ps(a01, a01, 0x55), b1, r01);
+		r23 = _mm256_fmadd_ps(_mm256_shuffle_ps(a23, a23, 0x55), b1, r23);
+		r01 = _mm256_fmadd_ps(_mm256_shuffle_ps(a01, a01, 0xAA), b2, r01);
+		r23 = _mm256_fmadd_ps(_mm256_shuffle_ps(a23, a23, 0xAA), b2, r23);
+		r01 = _mm256_fmadd_ps(_mm256_shuffle_ps(a01, a01, 0xFF), b3, r01);
+		r23 = _mm256_fmadd_ps(_mm256_shuffle_ps(a23, a23, 0xFF), b3, r23);
+#else
+		r01 = _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0x55), b1), r01);
+		r23 = _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0x55), b1), r23);
+		r01 = _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0xAA), b2), r01);
+		r23 = _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0xAA), b2), r23);
+		r01 = _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0xFF), b3), r01);
+		r23 = _mm256_add_ps(_mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0xFF), b3), r23);
+#endif
+		_mm256_storeu_ps(out + 0, r01);
+		_mm256_storeu_ps(out + 8, r23);
+#elif defined(MATH_SIMD_SSE)
+		__m128 b0 = _mm_load_ps(b + 0);
+		__m128 b1 = _mm_load_ps(b + 4);
+		__m128 b2 = _mm_load_ps(b + 8);
+		__m128 b3 = _mm_load_ps(b + 12);
+		__m128 r[4];
+		for (int i = 0; i < 4; i++) {
+			__m128 row = _mm_load_ps(a + i * 4);
+			r[i] = _mm_mul_ps(_mm_shuffle_ps(row, row, ShuffleMask(0, 0, 0, 0)), b0);
+			r[i] = MulAdd(_mm_shuffle_ps(row, row, ShuffleMask(1, 1, 1, 1)), b1, r[i]);
+			r[i] = MulAdd(_mm_shuffle_ps(row, row, ShuffleMask(2, 2, 2, 2)), b2, r[i]);
+			r[i] = MulAdd(_mm_shuffle_ps(row, row, ShuffleMask(3, 3, 3, 3)), b3, r[i]);
+		}
+		// 全行を計算してから書き込む(out が a, b と同じ場合のため)
+		for (int i = 0; i < 4; i++) {
+			_mm_store_ps(out + i * 4, r[i]);
+		}
+#elif defined(MATH_SIMD_NEON)
+		float32x4_t b0 = vld1q_f32(b + 0);
+		float32x4_t b1 = vld1q_f32(b + 4);
+		float32x4_t b2 = vld1q_f32(b + 8);
+		float32x4_t b3 = vld1q_f32(b + 12);
+		float32x4_t r[4];
+		for (int i = 0; i < 4; i++) {
+			float32x4_t row = vld1q_f32(a + i * 4);
+			r[i] = vmulq_laneq_f32(b0, row, 0);
+			r[i] = vfmaq_laneq_f32(r[i], b1, row, 1);
+			r[i] = vfmaq_laneq_f32(r[i], b2, row, 2);
+			r[i] = vfmaq_laneq_f32(r[i], b3, row, 3);
+		}
+		for (int i = 0; i < 4; i++) {
+			vst1q_f32(out + i * 4, r[i]);
+		}
+#else
+		float r[16];
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++) {
+				r[i * 4 + j] =
+					a[i * 4 + 0] * b[0 * 4 + j] + a[i * 4 + 1] * b[1 * 4 + j] +
+					a[i * 4 + 2] * b[2 * 4 + j] + a[i * 4 + 3] * b[3 * 4 + j];
+			}
+		}
+		for (int i = 0; i < 16; i++) {
+			out[i] = r[i];
+		}
+#endif
+	}
+
+	/// <summary>
+	/// アフィン行列同士の積(4列目が (0, 0, 0, 1) であることを前提に省略する)
+	/// </summary>
+	/// <param name="a">左辺</param>
+	/// <param name="b">右辺</param>
+	/// <param name="out">結果(a, b と同じでもよい)</param>
+	inline void AffineMultiply44(const float* a, const float* b, float* out) {
+#if defined(MATH_SIMD_SSE)
+		// 1行あたりの積和が3回なので AVX2 でも 128bit で処理する
+		__m128 b0 = _mm_load_ps(b + 0);
+		__m128 b1 = _mm_load_ps(b + 4);
+		__m128 b2 = _mm_load_ps(b + 8);
+		__m128 b3 = _mm_load_ps(b + 12);
+		__m128 r[4];
+		for (int i = 0; i < 4; i++) {
+			__m128 row = _mm_load_ps(a + i * 4);
+			r[i] = _mm_mul_ps(_mm_shuffle_ps(row, row, ShuffleMask(0, 0, 0, 0)), b0);
+			r[i] = MulAdd(_mm_shuffle_ps(row, row, ShuffleMask(1, 1, 1, 1)), b1, r[i]);
+			r[i] = MulAdd(_mm_shuffle_ps(row, row, ShuffleMask(2, 2, 2, 2)), b2, r[i]);
+		}
+		// 平行移動成分は右辺の平行移動を足すだけ
+		r[3] = _mm_add_ps(r[3], b3);
+		for (int i = 0; i < 4; i++) {
+			_mm_store_ps(out + i * 4, r[i]);
+		}
+#elif defined(MATH_SIMD_NEON)
+		float32x4_t b0 = vld1q_f32(b + 0);
+		float32x4_t b1 = vld1q_f32(b + 4);
+		float32x4_t b2 = vld1q_f32(b + 8);
+		float32x4_t b3 = vld1q_f32(b + 12);
+		float32x4_t r[4];
+		for (int i = 0; i < 4; i++) {
+			float32x4_t row = vld1q_f32(a + i * 4);
+			r[i] = vmulq_laneq_f32(b0, row, 0);
+			r[i] = vfmaq_laneq_f32(r[i], b1, row, 1);
+			r[i] = vfmaq_laneq_f32(r[i], b2, row, 2);
+		}
+		r[3] = vaddq_f32(r[3], b3);
+		for (int i = 0; i < 4; i++) {
+			vst1q_f32(out + i * 4, r[i]);
+		}
+#else
+		float r[16];
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 3; j++) {
+				r[i * 4 + j] = a[i * 4 + 0] * b[0 * 4 + j] + a[i * 4 + 1] * b[1 * 4 + j] + a[i * 4 + 2] * b[2 * 4 + j];
+			}
+			r[i * 4 + 3] = 0.0f;
+		}
+		r[12] += b[12];
+		r[13] += b[13];
+		r[14] += b[14];
+		r[15] = 1.0f;
+		for (int i = 0; i < 16; i++) {
+			out[i] = r[i];
+		}
+#endif
+	}
+
+	/// <summary>
+	/// 4×4行列の行列式
+	/// </summary>
+	/// <param name="m">行列</param>
+	/// <returns></returns>
+	inline float Determinant44(const float* m) {
+#if defined(MATH_SIMD_SSE)
+		__m128 r0 = _mm_load_ps(m + 0);
+		__m128 r1 = _mm_load_ps(m + 4);
+		__m128 r2 = _mm_load_ps(m + 8);
+		__m128 r3 = _mm_load_ps(m + 12);
+		// 2×2の小行列に分割
+		__m128 A = _mm_movelh_ps(r0, r1);
+		__m128 B = _mm_movehl_ps(r1, r0);
+		__m128 C = _mm_movelh_ps(r2, r3);
+		__m128 D = _mm_movehl_ps(r3, r2);
+		// (|A|, |B|, |C|, |D|)
+		__m128 detSub = _mm_sub_ps(
+			_mm_mul_ps(_mm_shuffle_ps(r0, r2, ShuffleMask(0, 2, 0, 2)), _mm_shuffle_ps(r1, r3, ShuffleMask(1, 3, 1, 3))),
+			_mm_mul_ps(_mm_shuffle_ps(r0, r2, ShuffleMask(1, 3, 1, 3)), _mm_shuffle_ps(r1, r3, ShuffleMask(0, 2, 0, 2))));
+		// |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+		__m128 D_C = Mat2AdjMul(D, C);
+		__m128 A_B = Mat2AdjMul(A, B);
+		__m128 tr = HorizontalSum(_mm_mul_ps(A_B, _mm_shuffle_ps(D_C, D_C, ShuffleMask(0, 2, 1, 3))));
+		__m128 detAD = _mm_mul_ps(detSub, _mm_shuffle_ps(detSub, detSub, ShuffleMask(3, 2, 1, 0)));
+		__m128 det = _mm_sub_ss(_mm_add_ss(detAD, _mm_shuffle_ps(detAD, detAD, ShuffleMask(1, 1, 1, 1))), tr);
+		return _mm_cvtss_f32(det);
+#else
+		// 2×2の小行列式から余因子展開する
+		float s0 = m[0] * m[5] - m[1] * m[4];
+		float s1 = m[0] * m[6] - m[2] * m[4];
+		float s2 = m[0] * m[7] - m[3] * m[4];
+		float s3 = m[1] * m[6] - m[2] * m[5];
+		float s4 = m[1] * m[7] - m[3] * m[5];
+		float s5 = m[2] * m[7] - m[3] * m[6];
+		float c5 = m[10] * m[15] - m[11] * m[14];
+		float c4 = m[9] * m[15] - m[11] * m[13];
+		float c3 = m[9] * m[14] - m[10] * m[13];
+		float c2 = m[8] * m[15] - m[11] * m[12];
+		float c1 = m[8] * m[14] - m[10] * m[12];
+		float c0 = m[8] * m[13] - m[9] * m[12];
+		return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+#endif
+	}
+
+	/// <summary>
+	/// 4×4行列の逆行列
+	/// </summary>
+	/// <param name="m">行列</param>
+	/// <param name="out">結果(m と同じでもよい)</param>
+	/// <returns>行列式(0の場合 out は書き換えない)</returns>
+	inline float Inverse44(const float* m, float* out) {
+#if defined(MATH_SIMD_SSE)
+		__m128 r0 = _mm_load_ps(m + 0);
+		__m128 r1 = _mm_load_ps(m + 4);
+		__m128 r2 = _mm_load_ps(m + 8);
+		__m128 r3 = _mm_load_ps(m + 12);
+		// 2×2の小行列に分割
+		__m128 A = _mm_movelh_ps(r0, r1);
+		__m128 B = _mm_movehl_ps(r1, r0);
+		__m128 C = _mm_movelh_ps(r2, r3);
+		__m128 D = _mm_movehl_ps(r3, r2);
+		// (|A|, |B|, |C|, |D|)
+		__m128 detSub = _mm_sub_ps(
+			_mm_mul_ps(_mm_shuffle_ps(r0, r2, ShuffleMask(0, 2, 0, 2)), _mm_shuffle_ps(r1, r3, ShuffleMask(1, 3, 1, 3))),
+			_mm_mul_ps(_mm_shuffle_ps(r0, r2, ShuffleMask(1, 3, 1, 3)), _mm_shuffle_ps(r1, r3, ShuffleMask(0, 2, 0, 2))));
+		__m128 detA = _mm_shuffle_ps(detSub, detSub, ShuffleMask(0, 0, 0, 0));
+		__m128 detB = _mm_shuffle_ps(detSub, detSub, ShuffleMask(1, 1, 1, 1));
+		__m128 detC = _mm_shuffle_ps(detSub, detSub, ShuffleMask(2, 2, 2, 2));
+		__m128 detD = _mm_shuffle_ps(detSub, detSub, ShuffleMask(3, 3, 3, 3));
+
+		__m128 D_C = Mat2AdjMul(D, C);
+		__m128 A_B = Mat2AdjMul(A, B);
+		// 逆行列を 1/|M| * | X Y | としたときの各小行列の余因子
+		//                  | Z W |
+		__m128 X_ = _mm_sub_ps(_mm_mul_ps(detD, A), Mat2Mul(B, D_C));
+		__m128 W_ = _mm_sub_ps(_mm_mul_ps(detA, D), Mat2Mul(C, A_B));
+		__m128 Y_ = _mm_sub_ps(_mm_mul_ps(detB, C), Mat2MulAdj(D, A_B));
+		__m128 Z_ = _mm_sub_ps(_mm_mul_ps(detC, B), Mat2MulAdj(A, D_C));
+
+		// |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+		__m128 tr = HorizontalSum(_mm_mul_ps(A_B, _mm_shuffle_ps(D_C, D_C, ShuffleMask(0, 2, 1, 3))));
+		__m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+		float det = _mm_cvtss_f32(detM);
+		if (det == 0.0f) {
+			return det;
+		}
+
+		__m128 rDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+		X_ = _mm_mul_ps(X_, rDetM);
+		Y_ = _mm_mul_ps(Y_, rDetM);
+		Z_ = _mm_mul_ps(Z_, rDetM);
+		W_ = _mm_mul_ps(W_, rDetM);
+		// 余因子の並べ替えと書き込みを同時に行う
+		_mm_store_ps(out + 0, _mm_shuffle_ps(X_, Y_, ShuffleMask(3, 1, 3, 1)));
+		_mm_store_ps(out + 4, _mm_shuffle_ps(X_, Y_, ShuffleMask(2, 0, 2, 0)));
+		_mm_store_ps(out + 8, _mm_shuffle_ps(Z_, W_, ShuffleMask(3, 1, 3, 1)));
+		_mm_store_ps(out + 12, _mm_shuffle_ps(Z_, W_, ShuffleMask(2, 0, 2, 0)));
+		return det;
+#else
+		// 2×2の小行列式から余因子を求める
+		float s0 = m[0] * m[5] - m[1] * m[4];
+		float s1 = m[0] * m[6] - m[2] * m[4];
+		float s2 = m[0] * m[7] - m[3] * m[4];
+		float s3 = m[1] * m[6] - m[2] * m[5];
+		float s4 = m[1] * m[7] - m[3] * m[5];
+		float s5 = m[2] * m[7] - m[3] * m[6];
+		float c5 = m[10] * m[15] - m[11] * m[14];
+		float c4 = m[9] * m[15] - m[11] * m[13];
+		float c3 = m[9] * m[14] - m[10] * m[13];
+		float c2 = m[8] * m[15] - m[11] * m[12];
+		float c1 = m[8] * m[14] - m[10] * m[12];
+		float c0 = m[8] * m[13] - m[9] * m[12];
+
+		float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+		if (det == 0.0f) {
+			return det;
+		}
+		float inv = 1.0f / det;
+
+		float r[16];
+		r[0] = (m[5] * c5 - m[6] * c4 + m[7] * c3) * inv;
+		r[1] = (-m[1] * c5 + m[2] * c4 - m[3] * c3) * inv;
+		r[2] = (m[13] * s5 - m[14] * s4 + m[15] * s3) * inv;
+		r[3] = (-m[9] * s5 + m[10] * s4 - m[11] * s3) * inv;
+
+		r[4] = (-m[4] * c5 + m[6] * c2 - m[7] * c1) * inv;
+		r[5] = (m[0] * c5 - m[2] * c2 + m[3] * c1) * inv;
+		r[6] = (-m[12] * s5 + m[14] * s2 - m[15] * s1) * inv;
+		r[7] = (m[8] * s5 - m[10] * s2 + m[11] * s1) * inv;
+
+		r[8] = (m[4] * c4 - m[5] * c2 + m[7] * c0) * inv;
+		r[9] = (-m[0] * c4 + m[1] * c2 - m[3] * c0) * inv;
+		r[10] = (m[12] * s4 - m[13] * s2 + m[15] * s0) * inv;
+		r[11] = (-m[8] * s4 + m[9] * s2 - m[11] * s0) * inv;
+
+		r[12] = (-m[4] * c3 + m[5] * c1 - m[6] * c0) * inv;
+		r[13] = (m[0] * c3 - m[1] * c1 + m[2] * c0) * inv;
+		r[14] = (-m[12] * s3 + m[13] * s1 - m[14] * s0) * inv;
+		r[15] = (m[8] * s3 - m[9] * s1 + m[10] * s0) * inv;
+
+		for (int i = 0; i < 16; i++) {
+			out[i] = r[i];
+		}
+		return det;
+#endif
+	}
+
+	// sin, cos の範囲縮小用の定数
+	// 2π を上位(下位ビットが0なので商との積が丸められない)と残りに分けて引く
+	constexpr float kTrigInvTwoPi = 0.159154943f;
+	constexpr float kTrigTwoPiHi = 6.28125f;
+	constexpr float kTrigTwoPiLo = 1.93530717e-3f;
+	constexpr float kTrigPi = 3.14159265f;
+	constexpr float kTrigHalfPi = 1.57079633f;
+	// 足して引くと小数部が丸められる数(1.5 * 2^23)
+	constexpr float kTrigRoundMagic = 12582912.0f;
+	// 範囲縮小の結果を収める範囲(丸めで π を少し超えることがあり、畳み込みは 3π/2 まで正しい)
+	constexpr float kTrigReducedMax = kTrigPi + kTrigHalfPi;
+	// [-π/2, π/2] でのミニマックス近似の係数(高次から、x^2 の多項式)
+	// 精度重視 sin: 11次 cos: 10次
+	constexpr float kSinCoefPrecise[] = { -2.3889859e-08f, 2.7525562e-06f, -1.9840874e-04f, 8.3333310e-03f, -1.6666667e-01f, 1.0f };
+	constexpr float kCosCoefPrecise[] = { -2.6051615e-07f, 2.4760495e-05f, -1.3888378e-03f, 4.1666638e-02f, -5.0000000e-01f, 1.0f };
+	// 速度重視 sin: 7次 cos: 6次
+	constexpr float kSinCoefEst[] = { -1.8524670e-04f, 8.3139502e-03f, -1.6665852e-01f, 1.0f };
+	constexpr float kCosCoefEst[] = { -1.2712436e-03f, 4.1493919e-02f, -4.9992746e-01f, 1.0f };
+
+	// ホーナー法で多項式を計算
+	template<size_t N>
+	inline float Polynomial(const float(&coef)[N], float x) {
+		float result = coef[0];
+		for (size_t i = 1; i < N; i++) {
+			result = result * x + coef[i];
+		}
+		return result;
+	}
+#if defined(MATH_SIMD_SSE)
+	template<size_t N>
+	inline __m128 Polynomial(const float(&coef)[N], __m128 x) {
+		__m128 result = _mm_set1_ps(coef[0]);
+		for (size_t i = 1; i < N; i++) {
+			result = MulAdd(result, x, _mm_set1_ps(coef[i]));
+		}
+		return result;
+	}
+#elif defined(MATH_SIMD_NEON)
+	template<size_t N>
+	inline float32x4_t Polynomial(const float(&coef)[N], float32x4_t x) {
+		float32x4_t result = vdupq_n_f32(coef[0]);
+		for (size_t i = 1; i < N; i++) {
+			result = vfmaq_f32(vdupq_n_f32(coef[i]), result, x);
+		}
+		return result;
+	}
+#endif
+
+	/// <summary>
+	/// sin と cos を同時に求める(1要素)
+	/// |angle| が大きいほど範囲縮小の誤差が増える(結果は [-1, 1] に収まる)。NaN と無限大は NaN を返す
+	/// </summary>
+	/// <typeparam name="PRECISE">true: 精度重視 false: 速度重視</typeparam>
+	/// <param name="angle">ラジアン</param>
+	/// <param name="sinValue">sin</param>
+	/// <param name="cosValue">cos</param>
+	template<bool PRECISE>
+	inline void SinCos1(float angle, float& sinValue, float& cosValue) {
+		// 2π の倍数を引いて [-π, π] にする
+		// 商は整数に変換せずに丸める(int に入らない角度や NaN の変換は未定義)
+		float q = std::nearbyint(angle * kTrigInvTwoPi);
+		float y = (angle - q * kTrigTwoPiHi) - q * kTrigTwoPiLo;
+		// 大きな角度では縮小の誤差で大きくはみ出すので収める(NaN はそのまま)
+		y = y < -kTrigReducedMax ? -kTrigReducedMax : (y > kTrigReducedMax ? kTrigReducedMax : y);
+		// [-π/2, π/2] に畳み込む(sin は同じで cos の符号が反転する)
+		bool fold = (y > kTrigHalfPi) || (y < -kTrigHalfPi);
+		float sign = fold ? -1.0f : 1.0f;
+		y = fold ? (y > 0.0f ? kTrigPi : -kTrigPi) - y : y;
+		float y2 = y * y;
+		if constexpr (PRECISE) {
+			sinValue = Polynomial(kSinCoefPrecise, y2) * y;
+			cosValue = Polynomial(kCosCoefPrecise, y2) * sign;
+		}
+		else {
+			sinValue = Polynomial(kSinCoefEst, y2) * y;
+			cosValue = Polynomial(kCosCoefEst, y2) * sign;
+		}
+	}
+
+	/// <summary>
+	/// sin と cos を同時に求める(4要素)
+	/// 大きな角度、NaN、無限大の扱いは SinCos1 と同じ
+	/// </summary>
+	/// <typeparam name="PRECISE">true: 精度重視 false: 速度重視</typeparam>
+	/// <param name="angles">ラジアン[4]</param>
+	/// <param name="sins">sin[4]</param>
+	/// <param name="coss">cos[4]</param>
+	template<bool PRECISE>
+	inline void SinCos4(const float* angles, float* sins, float* coss) {
+#if defined(MATH_SIMD_SSE)
+		const __m128 signMask = _mm_set1_ps(-0.0f);
+		__m128 x = _mm_loadu_ps(angles);
+		// 2π の倍数を引いて [-π, π] にする
+		// 商は浮動小数点数のまま丸める(整数に変換すると大きな角度で商が壊れ、無限大が NaN にならない)
+		const __m128 roundMagic = _mm_set1_ps(kTrigRoundMagic);
+		__m128 q = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(kTrigInvTwoPi)), roundMagic), roundMagic);
+		x = _mm_sub_ps(x, _mm_mul_ps(q, _mm_set1_ps(kTrigTwoPiHi)));
+		x = _mm_sub_ps(x, _mm_mul_ps(q, _mm_set1_ps(kTrigTwoPiLo)));
+		// 大きな角度では縮小の誤差で大きくはみ出すので収める(NaN は第2引数にしてそのまま返す)
+		x = _mm_max_ps(_mm_set1_ps(-kTrigReducedMax), _mm_min_ps(_mm_set1_ps(kTrigReducedMax), x));
+		// [-π/2, π/2] に畳み込む
+		__m128 fold = _mm_cmpgt_ps(_mm_andnot_ps(signMask, x), _mm_set1_ps(kTrigHalfPi));
+		__m128 reflected = _mm_sub_ps(_mm_or_ps(_mm_set1_ps(kTrigPi), _mm_and_ps(signMask, x)), x);
+		x = _mm_or_ps(_mm_and_ps(fold, reflected), _mm_andnot_ps(fold, x));
+		__m128 x2 = _mm_mul_ps(x, x);
+		__m128 s, c;
+		if constexpr (PRECISE) {
+			s = Polynomial(kSinCoefPrecise, x2);
+			c = Polynomial(kCosCoefPrecise, x2);
+		}
+		else {
+			s = Polynomial(kSinCoefEst, x2);
+			c = Polynomial(kCosCoefEst, x2);
+		}
+		_mm_storeu_ps(sins, _mm_mul_ps(s, x));
+		_mm_storeu_ps(coss, _mm_xor_ps(c, _mm_and_ps(fold, signMask)));
+#elif defined(MATH_SIMD_NEON)
+		float32x4_t x = vld1q_f32(angles);
+		float32x4_t q = vrndnq_f32(vmulq_n_f32(x, kTrigInvTwoPi));
+		x = vfmsq_f32(x, q, vdupq_n_f32(kTrigTwoPiHi));
+		x = vfmsq_f32(x, q, vdupq_n_f32(kTrigTwoPiLo));
+		x = vmaxq_f32(vminq_f32(x, vdupq_n_f32(kTrigReducedMax)), vdupq_n_f32(-kTrigReducedMax));
+		uint32x4_t fold = vcagtq_f32(x, vdupq_n_f32(kTrigHalfPi));
+		float32x4_t signedPi = vbslq_f32(vdupq_n_u32(0x80000000u), x, vdupq_n_f32(kTrigPi));
+		x = vbslq_f32(fold, vsubq_f32(signedPi, x), x);
+		float32x4_t x2 = vmulq_f32(x, x);
+		float32x4_t s, c;
+		if constexpr (PRECISE) {
+			s = Polynomial(kSinCoefPrecise, x2);
+			c = Polynomial(kCosCoefPrecise, x2);
+		}
+		else {
+			s = Polynomial(kSinCoefEst, x2);
+			c = Polynomial(kCosCoefEst, x2);
+		}
+		vst1q_f32(sins, vmulq_f32(s, x));
+		vst1q_f32(coss, vbslq_f32(fold, vnegq_f32(c), c));
+#else
+		for (int i = 0; i < 4; i++) {
+			SinCos1<PRECISE>(angles[i], sins[i], coss[i]);
+		}
+#endif
+	}
+
+	/// <summary>
+	/// 複数要素をまとめて処理するためのレジスタ
+	/// AVX2: 8要素 SSE, NEON: 4要素 スカラー: 1要素
+	/// </summary>
+#if defined(MATH_SIMD_AVX2)
+	constexpr size_t kWidthN = 8;
+	struct FloatN { __m256 v; };
+	struct MaskN { __m256 v; };
+
+	inline FloatN LoadN(const float* p) { return { _mm256_loadu_ps(p) }; }
+	inline void StoreN(float* p, FloatN a) { _mm256_storeu_ps(p, a.v); }
+	inline FloatN SetN(float s) { return { _mm256_set1_ps(s) }; }
+	inline FloatN operator+(FloatN a, FloatN b) { return { _mm256_add_ps(a.v, b.v) }; }
+	inline FloatN operator-(FloatN a, FloatN b) { return { _mm256_sub_ps(a.v, b.v) }; }
+	inline FloatN operator*(FloatN a, FloatN b) { return { _mm256_mul_ps(a.v, b.v) }; }
+	inline FloatN operator/(FloatN a, FloatN b) { return { _mm256_div_ps(a.v, b.v) }; }
+	inline FloatN MinN(FloatN a, FloatN b) { return { _mm256_min_ps(a.v, b.v) }; }
+	inline FloatN MaxN(FloatN a, FloatN b) { return { _mm256_max_ps(a.v, b.v) }; }
+	inline FloatN AbsN(FloatN a) { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v) }; }
+	inline MaskN operator<(FloatN a, FloatN b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+	inline MaskN operator<=(FloatN a, FloatN b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ) }; }
+	inline MaskN operator>(FloatN a, FloatN b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; }
+	inline MaskN operator>=(FloatN a, FloatN b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ) }; }
+	inline MaskN operator&(MaskN a, MaskN b) { return { _mm256_and_ps(a.v, b.v) }; }
+	inline MaskN operator|(MaskN a, MaskN b) { return { _mm256_or_ps(a.v, b.v) }; }
+	// mask ? a : b
+	inline FloatN SelectN(MaskN mask, FloatN a, FloatN b) { return { _mm256_blendv_ps(b.v, a.v, mask.v) }; }
+	// 各要素の真偽をビットにする
+	inline unsigned int MoveMaskN(MaskN mask) { return static_cast<unsigned int>(_mm256_movemask_ps(mask.v)); }
+#elif defined(MATH_SIMD_SSE)
+	constexpr size_t kWidthN = 4;
+	struct FloatN { __m128 v; };
+	struct MaskN { __m128 v; };
+
+	inline FloatN LoadN(const float* p) { return { _mm_loadu_ps(p) }; }
+	inline void StoreN(float* p, FloatN a) { _mm_storeu_ps(p, a.v); }
+	inline FloatN SetN(float s) { return { _mm_set1_ps(s) }; }
+	inline FloatN operator+(FloatN a, FloatN b) { return { _mm_add_ps(a.v, b.v) }; }
+	inline FloatN operator-(FloatN a, FloatN b) { return { _mm_sub_ps(a.v, b.v) }; }
+	inline FloatN operator*(FloatN a, FloatN b) { return { _mm_mul_ps(a.v, b.v) }; }
+	inline FloatN operator/(FloatN a, FloatN b) { return { _mm_div_ps(a.v, b.v) }; }
+	inline FloatN MinN(FloatN a, FloatN b) { return { _mm_min_ps(a.v, b.v) }; }
+	inline FloatN MaxN(FloatN a, FloatN b) { return { _mm_max_ps(a.v, b.v) }; }
+	inline FloatN AbsN(FloatN a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+	inline MaskN operator<(FloatN a, FloatN b) { return { _mm_cmplt_ps(a.v, b.v) }; }
+	inline MaskN operator<=(FloatN a, FloatN b) { return { _mm_cmple_ps(a.v, b.v) }; }
+	inline MaskN operator>(FloatN a, FloatN b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+	inline MaskN operator>=(FloatN a, FloatN b) { return { _mm_cmpge_ps(a.v, b.v) }; }
+	inline MaskN operator&(MaskN a, MaskN b) { return { _mm_and_ps(a.v, b.v) }; }
+	inline MaskN operator|(MaskN a, MaskN b) { return { _mm_or_ps(a.v, b.v) }; }
+	// mask ? a : b
+	inline FloatN SelectN(MaskN mask, FloatN a, FloatN b) { return { _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) }; }
+	// 各要素の真偽をビットにする
+	inline unsigned int MoveMaskN(MaskN mask) { return static_cast<unsigned int>(_mm_movemask_ps(mask.v)); }
+#elif defined(MATH_SIMD_NEON)
+	constexpr size_t kWidthN = 4;
+	struct FloatN { float32x4_t v; };
+	struct MaskN { uint32x4_t v; };
+
+	inline FloatN LoadN(const float* p) { return { vld1q_f32(p) }; }
+	inline void StoreN(float* p, FloatN a) { vst1q_f32(p, a.v); }
+	inline FloatN SetN(float s) { return { vdupq_n_f32(s) }; }
+	inline FloatN operator+(FloatN a, FloatN b) { return { vaddq_f32(a.v, b.v) }; }
+	inline FloatN operator-(FloatN a, FloatN b) { return { vsubq_f32(a.v, b.v) }; }
+	inline FloatN operator*(FloatN a, FloatN b) { return { vmulq_f32(a.v, b.v) }; }
+	inline FloatN operator/(FloatN a, FloatN b) { return { vdivq_f32(a.v, b.v) }; }
+	inline FloatN MinN(FloatN a, FloatN b) { return { vminq_f32(a.v, b.v) }; }
+	inline FloatN MaxN(FloatN a, FloatN b) { return { vmaxq_f32(a.v, b.v) }; }
+	inline FloatN AbsN(FloatN a) { return { vabsq_f32(a.v) }; }
+	inline MaskN operator<(FloatN a, FloatN b) { return { vcltq_f32(a.v, b.v) }; }
+	inline MaskN operator<=(FloatN a, FloatN b) { return { vcleq_f32(a.v, b.v) }; }
+	inline MaskN operator>(FloatN a, FloatN b) { return { vcgtq_f32(a.v, b.v) }; }
+	inline MaskN operator>=(FloatN a, FloatN b) { return { vcgeq_f32(a.v, b.v) }; }
+	inline MaskN operator&(MaskN a, MaskN b) { return { vandq_u32(a.v, b.v) }; }
+	inline MaskN operator|(MaskN a, MaskN b) { return { vorrq_u32(a.v, b.v) }; }
+	// mask ? a : b
+	inline FloatN SelectN(MaskN mask, FloatN a, FloatN b) { return { vbslq_f32(mask.v, a.v, b.v) }; }
+	// 各要素の真偽をビットにする
+	inline unsigned int MoveMaskN(MaskN mask) {
+		const int32_t shift[4] = { 0, 1, 2, 3 };
+		return vaddvq_u32(vshlq_u32(vshrq_n_u32(mask.v, 31), vld1q_s32(shift)));
+	}
+#else
+	constexpr size_t kWidthN = 1;
+	struct FloatN { float v; };
+	struct MaskN { bool v; };
+
+	inline FloatN LoadN(const float* p) { return { *p }; }
+	inline void StoreN(float* p, FloatN a) { *p = a.v; }
+	inline FloatN SetN(float s) { return { s }; }
+	inline FloatN operator+(FloatN a, FloatN b) { return { a.v + b.v }; }
+	inline FloatN operator-(FloatN a, FloatN b) { return { a.v - b.v }; }
+	inline FloatN operator*(FloatN a, FloatN b) { return { a.v * b.v }; }
+	inline FloatN operator/(FloatN a, FloatN b) { return { a.v / b.v }; }
+	inline FloatN MinN(FloatN a, FloatN b) { return { a.v < b.v ? a.v : b.v }; }
+	inline FloatN MaxN(FloatN a, FloatN b) { return { a.v > b.v ? a.v : b.v }; }
+	inline FloatN AbsN(FloatN a) { return { a.v < 0.0f ? -a.v : a.v }; }
+	inline MaskN operator<(FloatN a, FloatN b) { return { a.v < b.v }; }
+	inline MaskN operator<=(FloatN a, FloatN b) { return { a.v <= b.v }; }
+	inline MaskN operator>(FloatN a, FloatN b) { return { a.v > b.v }; }
+	inline MaskN operator>=(FloatN a, FloatN b) { return { a.v >= b.v }; }
+	inline MaskN operator&(MaskN a, MaskN b) { return { a.v && b.v }; }
+	inline MaskN operator|(MaskN a, MaskN b) { return { a.v || b.v }; }
+	// mask ? a : b
+	inline FloatN SelectN(MaskN mask, FloatN a, FloatN b) { return { mask.v ? a.v : b.v }; }
+	// 各要素の真偽をビットにする
+	inline unsigned int MoveMaskN(MaskN mask) { return mask.v ? 1u : 0u; }
+#endif
+	// a * b + c
+	inline FloatN MulAddN(FloatN a, FloatN b, FloatN c) {
+#if defined(MATH_SIMD_AVX2) && defined(MATH_SIMD_FMA)
+		return { _mm256_fmadd_ps(a.v, b.v, c.v) };
+#elif defined(MATH_SIMD_NEON)
+		return { vfmaq_f32(c.v, a.v, b.v) };
+#else
+		return a * b + c;
+#endif
+	}
+}
+}
+
+#endif
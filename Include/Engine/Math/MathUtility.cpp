@@ -1,31 +1,7 @@
 #include "MathUtility.h"
 
-const Vector2 Vector2::UnitX = Vector2(1.0f, 0.0f);
-const Vector2 Vector2::UnitY = Vector2(0.0f, 1.0f);
-const Vector2 Vector2::Zero = Vector2(0.0f, 0.0f);
-
-const Vector3 Vector3::UnitX = Vector3(1.0f, 0.0f, 0.0f);
-const Vector3 Vector3::UnitY = Vector3(0.0f, 1.0f, 0.0f);
-const Vector3 Vector3::UnitZ = Vector3(0.0f, 0.0f, 1.0f);
-const Vector3 Vector3::Zero = Vector3(0.0f, 0.0f, 0.0f);
-
-const Vector4 Vector4::Zero = Vector4(0.0f, 0.0f, 0.0f, 0.0f);
-
-const Quaternion Quaternion::Identity = Quaternion(0.0f, 0.0f, 0.0f, 1.0f);
-
-const Matrix33 Matrix33::Identity = Matrix33(
-	1.0f, 0.0f, 0.0f, 
-	0.0f, 1.0f, 0.0f, 
-	0.0f, 0.0f, 1.0f);
-
-const Matrix44 Matrix44::Identity = Matrix44(
-	1.0f, 0.0f, 0.0f, 0.0f, 
-	0.0f, 1.0f, 0.0f, 0.0f, 
-	0.0f, 0.0f, 1.0f, 0.0f,
-	0.0f, 0.0f, 0.0f, 1.0f);
-
 unsigned int Color::HSVAtoRGBA_uint(float h, float s, float v, unsigned int a) {
-	Vector4 rgba;
+	Vector4 rgba = Vector4(Math::kZero);
 
 	float H = Math::Fmod(h, 360.0f);
 	float V = Math::Clamp(v, 0.0f, 1.0f);
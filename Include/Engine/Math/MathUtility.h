@@ -5,6 +5,8 @@
 #include <cmath>
 #include <cassert>
 
+#include "MathSIMD.h"
+
 struct Vector2;
 struct Vector3;
 struct Vector4;
@@ -13,7 +15,7 @@ struct Matrix33;
 struct Matrix44;
 
 /// <summary>
-/// w
+/// 数学
 /// </summary>
 namespace Math
 {
@@ -21,64 +23,71 @@ namespace Math
 	constexpr float TwoPi = 2.0f * Pi;
 	constexpr float PiDiv2 = Pi / 2.0f;
 
+	// 単位元で初期化するためのタグ
+	struct IdentityTag { explicit IdentityTag() = default; };
+	// ゼロで初期化するためのタグ
+	struct ZeroTag { explicit ZeroTag() = default; };
+	inline constexpr IdentityTag kIdentity{};
+	inline constexpr ZeroTag kZero{};
+
 	/// <summary>
-	/// ʓx@ϊ
+	/// 弧度法変換
 	/// </summary>
-	/// <param name="degrees">x@</param>
-	/// <returns>ʓx@</returns>
+	/// <param name="degrees">度数法</param>
+	/// <returns>弧度法</returns>
 	constexpr inline float ToRadians(float degrees) {
 		return (degrees * Pi / 180.0f);
 	}
 	/// <summary>
-	/// x@ϊ
+	/// 度数法変換
 	/// </summary>
-	/// <param name="radians">ʓx@</param>
-	/// <returns>x@</returns>
+	/// <param name="radians">弧度法</param>
+	/// <returns>度数法</returns>
 	constexpr inline float ToDegrees(float radians) {
 		return (radians * 180.0f / Pi);
 	}
 	/// <summary>
-	/// قڃ[
+	/// ほぼゼロ
 	/// </summary>
-	/// <param name="value">l</param>
-	/// <param name="epsilon">덷</param>
+	/// <param name="value">値</param>
+	/// <param name="epsilon">誤差</param>
 	/// <returns>true : false</returns>
 	inline bool NearZero(float value, float epsilon = 0.01f) {
 		return (fabs(value) <= epsilon);
 	}
 	/// <summary>
-	/// 𔻒f
+	/// 符号を判断
 	/// </summary>
-	/// <typeparam name="TYPE">^</typeparam>
-	/// <param name="v">l</param>
-	/// <returns> 00 </returns>
+	/// <typeparam name="TYPE">型</typeparam>
+	/// <param name="v">値</param>
+	/// <returns> 0は0 </returns>
 	template <typename TYPE>
 	int GetSign(TYPE v) {
 		return (v > 0) - (v < 0);
 	}
 	/// <summary>
-	/// 傫ق߂
+	/// 大きいほうを求める
 	/// </summary>
-	/// <typeparam name="TYPE">^</typeparam>
-	/// <param name="v1">lP</param>
-	/// <param name="v2">lQ</param>
-	/// <returns>lP@or@lQ</returns>
+	/// <typeparam name="TYPE">型</typeparam>
+	/// <param name="v1">値１</param>
+	/// <param name="v2">値２</param>
+	/// <returns>値１　or　値２</returns>
 	template <typename TYPE>
 	TYPE Max(const TYPE& v1, const TYPE& v2) {
 		return (v1 < v2 ? v2 : v1);
 	}
 	/// <summary>
-	/// ق߂
+	/// 小さいほうを求める
 	/// </summary>
-	/// <typeparam name="TYPE">^</typeparam>
-	/// <param name="v1">lP</param>
-	/// <param name="v2">lQ</param>
-	/// <returns>lP@or@lQ</returns>
+	/// <typeparam name="TYPE">型</typeparam>
+	/// <param name="v1">値１</param>
+	/// <param name="v2">値２</param>
+	/// <returns>値１　or　値２</returns>
 	template <typename TYPE>
 	TYPE Min(const TYPE& v1, const TYPE& v2) {
 		return (v1 < v2 ? v1 : v2);
 	}
-	// lւ
+	// 値を入れ替える
 	template <typename TYPE>
 	void Swap(TYPE& v1, TYPE& v2) {
 		TYPE tmp = v1;
@@ -86,23 +95,23 @@ namespace Math
 		v2 = tmp;
 	}
 	/// <summary>
-	/// l߂
+	/// 値を収める
 	/// </summary>
-	/// <typeparam name="TYPE">^</typeparam>
-	/// <param name="value">l</param>
-	/// <param name="lower"></param>
-	/// <param name="upper"></param>
+	/// <typeparam name="TYPE">型</typeparam>
+	/// <param name="value">値</param>
+	/// <param name="lower">下限</param>
+	/// <param name="upper">上限</param>
 	/// <returns></returns>
 	template <typename TYPE>
 	TYPE Clamp(const TYPE& value, const TYPE& lower, const TYPE& upper) {
 		return Min(upper, Max(lower, value));
 	}
 	/// <summary>
-	/// l[v
+	/// 値をループさせる
 	/// </summary>
-	/// <param name="value">l</param>
-	/// <param name="range">͈</param>
-	/// <param name="min">ŏ</param>
+	/// <param name="value">値</param>
+	/// <param name="range">範囲</param>
+	/// <param name="min">最小</param>
 	/// <returns></returns>
 	inline float Loop(float value, float range, float min = 0.0f) {
 		if (min < value && value < min + range) return value;
@@ -113,106 +122,127 @@ namespace Math
 		return x + min;
 	}
 	/// <summary>
-	/// Βl
+	/// 絶対値
 	/// </summary>
-	/// <param name="value">l</param>
+	/// <param name="value">値</param>
 	/// <returns></returns>
 	inline float Abs(float value) {
 		return fabsf(value);
 	}
 	/// <summary>
-	///	TC
+	///	サイン
 	/// </summary>
-	/// <param name="angle">WA</param>
+	/// <param name="angle">ラジアン</param>
 	/// <returns></returns>
 	inline float Sin(float angle) {
 		return sinf(angle);
 	}
 	/// <summary>
-	/// RTC
+	/// コサイン
 	/// </summary>
-	/// <param name="angle">WA</param>
+	/// <param name="angle">ラジアン</param>
 	/// <returns></returns>
 	inline float Cos(float angle) {
 		return cosf(angle);
 	}
 	/// <summary>
-	/// ^WFg
+	/// サインとコサインを同時に求める(多項式近似)
+	/// 最大誤差 約2.7e-7 (|angle| <= 100, FMA が使えるときは約2.4e-7, 絶対値0.5以上で 4ULP 以内)
+	/// |angle| が大きいほど誤差が増える(|angle| <= 1e5 で約1.3e-6、結果は [-1, 1] に収まる)。NaN と無限大は NaN を返す
+	/// </summary>
+	/// <param name="angle">ラジアン</param>
+	/// <param name="sinValue">サイン</param>
+	/// <param name="cosValue">コサイン</param>
+	inline void SinCos(float angle, float& sinValue, float& cosValue) {
+		SIMD::SinCos1<true>(angle, sinValue, cosValue);
+	}
+	/// <summary>
+	/// サインとコサインを同時に求める(低精度な多項式近似)
+	/// 最大誤差 約9.5e-6
 	/// </summary>
-	/// <param name="angle">WA</param>
+	/// <param name="angle">ラジアン</param>
+	/// <param name="sinValue">サイン</param>
+	/// <param name="cosValue">コサイン</param>
+	inline void SinCosEst(float angle, float& sinValue, float& cosValue) {
+		SIMD::SinCos1<false>(angle, sinValue, cosValue);
+	}
+	/// <summary>
+	/// タンジェント
+	/// </summary>
+	/// <param name="angle">ラジアン</param>
 	/// <returns></returns>
 	inline float Tan(float angle) {
 		return tanf(angle);
 	}
 	/// <summary>
-	/// A[NTC
+	/// アークサイン
 	/// </summary>
-	/// <param name="angle">WA</param>
+	/// <param name="angle">ラジアン</param>
 	/// <returns></returns>
 	inline float Asin(float angle) {
 		return asinf(angle);
 	}
 	/// <summary>
-	/// A[NRTC
+	/// アークコサイン
 	/// </summary>
-	/// <param name="angle">WA</param>
+	/// <param name="angle">ラジアン</param>
 	/// <returns></returns>
 	inline float Acos(float angle) {
 		return acosf(angle);
 	}
 	/// <summary>
-	/// A[N^WFg
+	/// アークタンジェント
 	/// </summary>
-	/// <param name="y">y</param>
-	/// <param name="x">x</param>
-	/// <returns>WA</returns>
+	/// <param name="y">y成分</param>
+	/// <param name="x">x成分</param>
+	/// <returns>ラジアン</returns>
 	inline float Atan2(float y, float x) {
 		return atan2f(y, x);
 	}
 	/// <summary>
-	/// `
+	/// 線形補間
 	/// </summary>
-	/// <param name="t">ω</param>
-	/// <param name="start">X^[g</param>
-	/// <param name="end">Gh</param>
+	/// <param name="t">変化量</param>
+	/// <param name="start">スタート</param>
+	/// <param name="end">エンド</param>
 	/// <returns></returns>
 	inline float Lerp(float t, float start, float end) {
 		return (start + t * (end - start));
 	}
 	/// <summary>
-	/// ݔ͈͂ʂ͈̔͂ɕϊ
+	/// 現在範囲から別の範囲に変換
 	/// </summary>
-	/// <param name="value">l</param>
-	/// <param name="start1">ݔ͈͂̍ŏ</param>
-	/// <param name="end1">ݔ͈͂̍ő</param>
-	/// <param name="start2">ῗ͈̍ŏ</param>
-	/// <param name="end2">ῗ͈̍ő</param>
+	/// <param name="value">値</param>
+	/// <param name="start1">現在範囲の最小</param>
+	/// <param name="end1">現在範囲の最大</param>
+	/// <param name="start2">変換範囲の最小</param>
+	/// <param name="end2">変換範囲の最大</param>
 	/// <returns></returns>
 	inline float Map(float value, float start1, float end1, float start2, float end2) {
 		return (start2 + (end1 - start2) * ((value - start1) / (end2 - start1)));
 	}
 	/// <summary>
-	/// 
+	/// 平方根
 	/// </summary>
-	/// <param name="value">l</param>
+	/// <param name="value">値</param>
 	/// <returns></returns>
 	inline float Sqrt(float value) {
 		return sqrtf(value);
 	}
 	/// <summary>
-	/// float]Z
+	/// float剰余演算
 	/// </summary>
-	/// <param name="number">鐔</param>
-	/// <param name="denom">鐔</param>
-	/// <returns>]</returns>
+	/// <param name="number">割られる数</param>
+	/// <param name="denom">割る数</param>
+	/// <returns>余り</returns>
 	inline float Fmod(float number, float denom) {
 		return fmodf(number, denom);
 	}
 	/// <summary>
-	/// p
+	/// 冪乗
 	/// </summary>
-	/// <param name="base"></param>
-	/// <param name="exponent">w</param>
+	/// <param name="base">底</param>
+	/// <param name="exponent">指数</param>
 	/// <returns></returns>
 	inline float Pow(float base, float exponent) {
 		return powf(base, exponent);
@@ -220,7 +250,7 @@ namespace Math
 
 };
 /// <summary>
-/// 񎟌xNg
+/// 二次元ベクトル
 /// </summary>
 struct Vector2 {
 	static const Vector2 UnitX;
@@ -228,41 +258,46 @@ struct Vector2 {
 	static const Vector2 Zero;
 
 
-	float x; // x
-	float y; // y
+	float x; // x成分
+	float y; // y成分
 
 
-	inline Vector2() : x(0.0f), y(0.0f) {}
-	inline explicit Vector2(float x, float y) : x(x), y(y) {}
-	inline explicit Vector2(float xy) : x(xy), y(xy) {}
+	// 初期化しない(ゼロにする場合は Vector2{} か kZero)
+	Vector2() = default;
+	constexpr inline explicit Vector2(Math::ZeroTag) : x(0.0f), y(0.0f) {}
+	constexpr inline explicit Vector2(float x, float y) : x(x), y(y) {}
+	constexpr inline explicit Vector2(float xy) : x(xy), y(xy) {}
 	
-#pragma region Zq̃I[o[[h
+#pragma region 演算子のオーバーロード
 	inline float& operator[](size_t i) {
 		return *((&x) + i);
 	}
+	inline const float& operator[](size_t i) const {
+		return *((&x) + i);
+	}
 
-	inline Vector2 operator+() const {
+	constexpr inline Vector2 operator+() const {
 		return Vector2(x, y);
 	}
-	inline Vector2 operator-() const {
+	constexpr inline Vector2 operator-() const {
 		return Vector2(-x, -y);
 	}
-	friend inline Vector2 operator+(const Vector2& v1, const Vector2& v2) {
+	friend constexpr inline Vector2 operator+(const Vector2& v1, const Vector2& v2) {
 		return Vector2(v1.x + v2.x, v1.y + v2.y);
 	}
-	friend inline Vector2 operator-(const Vector2& v1, const Vector2& v2) {
+	friend constexpr inline Vector2 operator-(const Vector2& v1, const Vector2& v2) {
 		return Vector2(v1.x - v2.x, v1.y - v2.y);
 	}
-	friend inline Vector2 operator*(const Vector2& v1, const Vector2& v2) {
+	friend constexpr inline Vector2 operator*(const Vector2& v1, const Vector2& v2) {
 		return Vector2(v1.x * v2.x, v1.y * v2.y);
 	}
-	friend inline Vector2 operator*(const Vector2& v, float s) {
+	friend constexpr inline Vector2 operator*(const Vector2& v, float s) {
 		return Vector2(v.x * s, v.y * s);
 	}
-	friend inline Vector2 operator*(float s, const Vector2& v) {
+	friend constexpr inline Vector2 operator*(float s, const Vector2& v) {
 		return Vector2(s * v.x, s * v.y);
 	}
-	friend inline Vector2 operator/(const Vector2& v, float s) {
+	friend constexpr inline Vector2 operator/(const Vector2& v, float s) {
 		return Vector2(v.x / s, v.y / s);
 	}
 	
@@ -300,48 +335,48 @@ struct Vector2 {
 #pragma endregion
 
 	/// <summary>
-	/// ̓
+	/// 長さの二乗
 	/// </summary>
 	/// <returns></returns>
 	inline float LengthSquare() const {
 		return (x * x + y * y);
 	}
 	/// <summary>
-	/// 
+	/// 長さ
 	/// </summary>
 	/// <returns></returns>
 	inline float Length() const {
 		return (Math::Sqrt(LengthSquare()));
 	}
 	/// <summary>
-	/// K
+	/// 正規化
 	/// </summary>
 	/// <returns></returns>
 	inline Vector2 Normalized() const {
 		return (*this / Length());
 	}
 	/// <summary>
-	/// ]xNg
+	/// 回転したベクトル
 	/// </summary>
-	/// <param name="angle">]px</param>
+	/// <param name="angle">回転させる角度</param>
 	/// <returns></returns>
 	inline Vector2 Rotated(float angle) const {
-		float s = Math::Sin(angle);
-		float c = Math::Cos(angle);
+		float s, c;
+		Math::SinCos(angle, s, c);
 		return Vector2(x * c - y * s, x * s + y * c );
 	}
 	/// <summary>
-	/// [xNg
+	/// ゼロベクトルか
 	/// </summary>
 	/// <returns></returns>
 	inline bool IsZero() const {
 		return x == 0.0f && y == 0.0f;
 	}
 
-// ÓI֐
+// 静的関数
 
 	/// <summary>
-	///  
+	/// 内積 
 	/// </summary>
 	/// <param name="v1"></param>
 	/// <param name="v2"></param>
@@ -350,7 +385,7 @@ struct Vector2 {
 		return (v1.x * v2.x + v1.y * v2.y);
 	}
 	/// <summary>
-	/// O
+	/// 外積
 	/// </summary>
 	/// <param name="v1"></param>
 	/// <param name="v2"></param>
@@ -359,17 +394,17 @@ struct Vector2 {
 		return (v1.x * v2.y - v1.y * v2.x);
 	}
 	/// <summary>
-	/// `
+	/// 線形補間
 	/// </summary>
 	/// <param name="t">0 ~ 1</param>
-	/// <param name="start">0̎</param>
-	/// <param name="end">1̎</param>
+	/// <param name="start">0の時</param>
+	/// <param name="end">1の時</param>
 	/// <returns></returns>
 	friend inline Vector2 Lerp(float t, const Vector2& start, const Vector2& end) {
 		return (start + t * (end - start));
 	}
 	/// <summary>
-	/// xNgƂ̋
+	/// 他ベクトルとの距離
 	/// </summary>
 	/// <param name="v1"></param>
 	/// <param name="v2"></param>
@@ -378,7 +413,7 @@ struct Vector2 {
 		return (v2 - v1).Length();
 	}
 	/// <summary>
-	/// _
+	/// 中点
 	/// </summary>
 	/// <param name="v1"></param>
 	/// <param name="v2"></param>
@@ -387,17 +422,20 @@ struct Vector2 {
 		return ((v1 + v2) * 0.5f);
 	}
 	/// <summary>
-	/// ˂xNg
+	/// 反射したベクトル
 	/// </summary>
-	/// <param name="v">xNg</param>
-	/// <param name="n">Kꂽǂ̖@</param>
+	/// <param name="v">ベクトル</param>
+	/// <param name="n">正規化された壁の法線</param>
 	/// <returns></returns>
 	friend inline Vector2 Reflected(const Vector2& v, const Vector2& n) {
 		return (Dot(n, -v) * 2.0f * n + v);
 	}
 };
+inline constexpr Vector2 Vector2::UnitX = Vector2(1.0f, 0.0f);
+inline constexpr Vector2 Vector2::UnitY = Vector2(0.0f, 1.0f);
+inline constexpr Vector2 Vector2::Zero = Vector2(Math::kZero);
 /// <summary>
-/// OxNg
+/// 三次元ベクトル
 /// </summary>
 struct Vector3 {
 	static const Vector3 UnitX;
@@ -406,15 +444,17 @@ struct Vector3 {
 	static const Vector3 Zero;
 
 
-	float x; // x
-	float y; // y
-	float z; // z
+	float x; // x成分
+	float y; // y成分
+	float z; // z成分
 
 
-	inline Vector3() : x(0.0f), y(0.0f), z(0.0f) {}
-	inline explicit Vector3(float x, float y, float z) : x(x), y(y), z(z) {}
-	inline explicit Vector3(float xyz) : x(xyz), y(xyz), z(xyz) {}
-	inline explicit Vector3(const Vector2& xy, float z) : x(xy.x), y(xy.y), z(z) {}
+	// 初期化しない(ゼロにする場合は Vector3{} か kZero)
+	Vector3() = default;
+	constexpr inline explicit Vector3(Math::ZeroTag) : x(0.0f), y(0.0f), z(0.0f) {}
+	constexpr inline explicit Vector3(float x, float y, float z) : x(x), y(y), z(z) {}
+	constexpr inline explicit Vector3(float xyz) : x(xyz), y(xyz), z(xyz) {}
+	constexpr inline explicit Vector3(const Vector2& xy, float z) : x(xy.x), y(xy.y), z(z) {}
 
 	inline void xy(const Vector2& xy) {
 		x = xy.x;
@@ -438,32 +478,35 @@ struct Vector3 {
 		return Vector2(y, z); 
 	}
 
-#pragma region Zq̃I[o[[h
+#pragma region 演算子のオーバーロード
 	inline float& operator[](size_t i) {
 		return *((&x) + i);
 	}
-	inline Vector3 operator+() const {
+	inline const float& operator[](size_t i) const {
+		return *((&x) + i);
+	}
+	constexpr inline Vector3 operator+() const {
 		return Vector3(x, y, z);
 	}
-	inline Vector3 operator-() const {
+	constexpr inline Vector3 operator-() const {
 		return Vector3(-x, -y, -z);
 	}
-	friend inline Vector3 operator+(const Vector3& v1, const Vector3& v2) {
+	friend constexpr inline Vector3 operator+(const Vector3& v1, const Vector3& v2) {
 		return Vector3(v1.x + v2.x, v1.y + v2.y, v1.z + v2.z);
 	}
-	friend inline Vector3 operator-(const Vector3& v1, const Vector3& v2) {
-		return Vector3(v1.x - v2.x, v1.y - v2.y, v1.z + v2.z);
+	friend constexpr inline Vector3 operator-(const Vector3& v1, const Vector3& v2) {
+		return Vector3(v1.x - v2.x, v1.y - v2.y, v1.z - v2.z);
 	}
-	friend inline Vector3 operator*(const Vector3& v1, const Vector3& v2) {
+	friend constexpr inline Vector3 operator*(const Vector3& v1, const Vector3& v2) {
 		return Vector3(v1.x * v2.x, v1.y * v2.y, v1.z * v2.z);
 	}
-	friend inline Vector3 operator*(const Vector3& v, float s) {
+	friend constexpr inline Vector3 operator*(const Vector3& v, float s) {
 		return Vector3(v.x * s, v.y * s, v.z * s);
 	}
-	friend inline Vector3 operator*(float s, const Vector3& v) {
+	friend constexpr inline Vector3 operator*(float s, const Vector3& v) {
 		return Vector3(s * v.x, s * v.y, s * v.z);
 	}
-	friend inline Vector3 operator/(const Vector3& v, float s) {
+	friend constexpr inline Vector3 operator/(const Vector3& v, float s) {
 		return Vector3(v.x / s, v.y / s, v.z / s);
 	}
 
@@ -506,38 +549,38 @@ struct Vector3 {
 #pragma endregion
 
 	/// <summary>
-	/// ̓
+	/// 長さの二乗
 	/// </summary>
 	/// <returns></returns>
 	inline float LengthSquare() const {
 		return (x * x + y * y + z * z);
 	}
 	/// <summary>
-	/// 
+	/// 長さ
 	/// </summary>
 	/// <returns></returns>
 	inline float Length() const {
 		return (Math::Sqrt(LengthSquare()));
 	}
 	/// <summary>
-	/// K
+	/// 正規化
 	/// </summary>
 	/// <returns></returns>
 	inline Vector3 Normalized() const {
 		return (*this / Length());
 	}
 	/// <summary>
-	/// [xNg
+	/// ゼロベクトルか
 	/// </summary>
 	/// <returns></returns>
 	inline bool IsZero() const {
 		return x == 0.0f && y == 0.0f && z == 0.0f;
 	}
 
-	// ÓI֐
+	// 静的関数
 
 	/// <summary>
-	///  
+	/// 内積 
 	/// </summary>
 	/// <param name="v1"></param>
 	/// <param name="v2"></param>
@@ -546,26 +589,26 @@ struct Vector3 {
 		return (v1.x * v2.x + v1.y * v2.y + v1.z * v2.z);
 	}
 	/// <summary>
-	/// O
+	/// 外積
 	/// </summary>
 	/// <param name="v1"></param>
 	/// <param name="v2"></param>
 	/// <returns></returns>
 	friend inline Vector3 Cross(const Vector3& v1, const Vector3& v2) {
-		return Vector3(v1.y * v2.z - v1.z * v2.y, v1.z * v2.x - v1.x - v2.z, v1.x * v2.y - v1.y * v2.x);
+		return Vector3(v1.y * v2.z - v1.z * v2.y, v1.z * v2.x - v1.x * v2.z, v1.x * v2.y - v1.y * v2.x);
 	}
 	/// <summary>
-	/// `
+	/// 線形補間
 	/// </summary>
 	/// <param name="t">0 ~ 1</param>
-	/// <param name="start">0̎</param>
-	/// <param name="end">1̎</param>
+	/// <param name="start">0の時</param>
+	/// <param name="end">1の時</param>
 	/// <returns></returns>
 	friend inline Vector3 Lerp(float t, const Vector3& start, const Vector3& end) {
 		return (start + t * (end - start));
 	}
 	/// <summary>
-	/// xNgƂ̋
+	/// 他ベクトルとの距離
 	/// </summary>
 	/// <param name="v1"></param>
 	/// <param name="v2"></param>
@@ -574,7 +617,7 @@ struct Vector3 {
 		return (v2 - v1).Length();
 	}
 	/// <summary>
-	/// _
+	/// 中点
 	/// </summary>
 	/// <param name="v1"></param>
 	/// <param name="v2"></param>
@@ -583,17 +626,21 @@ struct Vector3 {
 		return ((v1 + v2) * 0.5f);
 	}
 	/// <summary>
-	/// ˂xNg
+	/// 反射したベクトル
 	/// </summary>
-	/// <param name="v">xNg</param>
-	/// <param name="n">Kꂽǂ̖@</param>
+	/// <param name="v">ベクトル</param>
+	/// <param name="n">正規化された壁の法線</param>
 	/// <returns></returns>
 	friend inline Vector3 Reflected(const Vector3& v, const Vector3& n) {
 		return (Dot(n, -v) * 2.0f * n + v);
 	}
 };
+inline constexpr Vector3 Vector3::UnitX = Vector3(1.0f, 0.0f, 0.0f);
+inline constexpr Vector3 Vector3::UnitY = Vector3(0.0f, 1.0f, 0.0f);
+inline constexpr Vector3 Vector3::UnitZ = Vector3(0.0f, 0.0f, 1.0f);
+inline constexpr Vector3 Vector3::Zero = Vector3(Math::kZero);
 /// <summary>
-/// lxNg
+/// 四次元ベクトル
 /// </summary>
 struct Vector4 {
 	static const Vector4 Zero;
@@ -605,10 +652,12 @@ struct Vector4 {
 	float w;
 
 
-	inline Vector4() : x(0.0f), y(0.0f), z(0.0f), w(0.0f) {}
-	inline explicit Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
-	inline explicit Vector4(float xyzw) : x(xyzw), y(xyzw), z(xyzw), w(xyzw) {}
-	inline explicit Vector4(const Vector3& xyz, float w) : x(xyz.x), y(xyz.y), z(xyz.z), w(w) {}
+	// 初期化しない(ゼロにする場合は Vector4{} か kZero)
+	Vector4() = default;
+	constexpr inline explicit Vector4(Math::ZeroTag) : x(0.0f), y(0.0f), z(0.0f), w(0.0f) {}
+	constexpr inline explicit Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+	constexpr inline explicit Vector4(float xyzw) : x(xyzw), y(xyzw), z(xyzw), w(xyzw) {}
+	constexpr inline explicit Vector4(const Vector3& xyz, float w) : x(xyz.x), y(xyz.y), z(xyz.z), w(w) {}
 
 	inline void xyz(const Vector3& xyz) {
 		x = xyz.x;
@@ -619,29 +668,32 @@ struct Vector4 {
 		return Vector3(x, y, z);
 	}
 
-#pragma region Zq̃I[o[[h
+#pragma region 演算子のオーバーロード
 	inline float& operator[](size_t i) {
 		return *((&x) + i);
 	}
-	inline Vector4 operator+() const {
+	inline const float& operator[](size_t i) const {
+		return *((&x) + i);
+	}
+	constexpr inline Vector4 operator+() const {
 		return Vector4(x, y, z, w);
 	}
-	inline Vector4 operator-() const {
+	constexpr inline Vector4 operator-() const {
 		return Vector4(-x, -y, -z, -w);
 	}
-	friend inline Vector4 operator+(const Vector4& v1, const Vector4& v2) {
+	friend constexpr inline Vector4 operator+(const Vector4& v1, const Vector4& v2) {
 		return Vector4(v1.x + v2.x, v1.y + v2.y, v1.z + v2.z, v1.w + v2.w);
 	}
-	friend inline Vector4 operator-(const Vector4& v1, const Vector4& v2) {
-		return Vector4(v1.x - v2.x, v1.y - v2.y, v1.z + v2.z, v1.w - v2.w);
+	friend constexpr inline Vector4 operator-(const Vector4& v1, const Vector4& v2) {
+		return Vector4(v1.x - v2.x, v1.y - v2.y, v1.z - v2.z, v1.w - v2.w);
 	}
-	friend inline Vector4 operator*(const Vector4& v, float s) {
+	friend constexpr inline Vector4 operator*(const Vector4& v, float s) {
 		return Vector4(v.x * s, v.y * s, v.z * s, v.w * s);
 	}
-	friend inline Vector4 operator*(float s, const Vector4& v) {
+	friend constexpr inline Vector4 operator*(float s, const Vector4& v) {
 		return Vector4(s * v.x, s * v.y, s * v.z, s * v.w);
 	}
-	friend inline Vector4 operator/(const Vector4& v, float s) {
+	friend constexpr inline Vector4 operator/(const Vector4& v, float s) {
 		return Vector4(v.x / s, v.y / s, v.z / s, v.w / s);
 	}
 
@@ -684,43 +736,43 @@ struct Vector4 {
 		return v1.x == v2.x && v1.y == v2.y && v1.z == v2.z && v1.w == v2.w;
 	}
 	friend inline bool operator!=(const Vector4& v1, const Vector4& v2) {
-		return v1.x != v2.x || v1.y != v2.y || v1.z != v2.z && v1.w != v2.w;
+		return v1.x != v2.x || v1.y != v2.y || v1.z != v2.z || v1.w != v2.w;
 	}
 #pragma endregion
 
 	/// <summary>
-	/// ̓
+	/// 長さの二乗
 	/// </summary>
 	/// <returns></returns>
 	inline float LengthSquare() const {
 		return (x * x + y * y + z * z + w * w);
 	}
 	/// <summary>
-	/// 
+	/// 長さ
 	/// </summary>
 	/// <returns></returns>
 	inline float Length() const {
 		return (Math::Sqrt(LengthSquare()));
 	}
 	/// <summary>
-	/// K
+	/// 正規化
 	/// </summary>
 	/// <returns></returns>
 	inline Vector4 Normalized() const {
 		return (*this / Length());
 	}
 	/// <summary>
-	/// [xNg
+	/// ゼロベクトルか
 	/// </summary>
 	/// <returns></returns>
 	inline bool IsZero() const {
 		return x == 0.0f && y == 0.0f && z == 0.0f && w == 0.0f;
 	}
 
-	// ÓI֐
+	// 静的関数
 
 	/// <summary>
-	///  
+	/// 内積 
 	/// </summary>
 	/// <param name="v1"></param>
 	/// <param name="v2"></param>
@@ -729,18 +781,19 @@ struct Vector4 {
 		return (v1.x * v2.x + v1.y * v2.y + v1.z * v2.z + v1.w + v2.w);
 	}
 	/// <summary>
-	/// `
+	/// 線形補間
 	/// </summary>
 	/// <param name="t">0 ~ 1</param>
-	/// <param name="start">0̎</param>
-	/// <param name="end">1̎</param>
+	/// <param name="start">0の時</param>
+	/// <param name="end">1の時</param>
 	/// <returns></returns>
 	friend inline Vector4 Lerp(float t, const Vector4& start, const Vector4& end) {
 		return (start + t * (end - start));
 	}
 };
+inline constexpr Vector4 Vector4::Zero = Vector4(Math::kZero);
 /// <summary>
-/// NH[^jI
+/// クォータニオン
 /// </summary>
 struct Quaternion {
 	static const Quaternion Identity;
@@ -752,10 +805,10 @@ struct Quaternion {
 	float w;
 
 
-	inline Quaternion(){
-		*this = Identity;
-	}
-	inline explicit Quaternion(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+	// 初期化しない(単位元にする場合は kIdentity)
+	Quaternion() = default;
+	constexpr inline explicit Quaternion(Math::IdentityTag) : x(0.0f), y(0.0f), z(0.0f), w(1.0f) {}
+	constexpr inline explicit Quaternion(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
 
 
 	inline void xyz(const Vector3& xyz) {
@@ -767,21 +820,21 @@ struct Quaternion {
 		return Vector3(x, y, z);
 	}
 	/// <summary>
-	/// ̊px擾
+	/// 軸周りの角度を取得
 	/// </summary>
 	/// <returns></returns>
 	inline float GetAngle() const {
 		return Math::Acos(w) * 2.0f;
 	}
 	/// <summary>
-	/// ]擾
+	/// 回転軸を取得
 	/// </summary>
 	/// <returns></returns>
 	inline Vector3 GetAxis() const {
 		return xyz() / Math::Sin(Math::Acos(w));
 	}
 	/// <summary>
-	/// IC[p擾
+	/// オイラー角を取得
 	/// </summary>
 	/// <returns></returns>
 	inline Vector3 GetEuler() const {
@@ -797,7 +850,7 @@ struct Quaternion {
 		return result;
 	}
 
-#pragma region Zq̃I[o[[h
+#pragma region 演算子のオーバーロード
 	friend inline Quaternion operator+(const Quaternion& q1, const Quaternion& q2) {
 		return Quaternion(q1.x + q2.x, q1.y + q2.y, q1.z + q2.z, q1.w + q2.w);
 	}
@@ -824,56 +877,56 @@ struct Quaternion {
 
 #pragma endregion
 	/// <summary>
-	/// ̓
+	/// 長さの二乗
 	/// </summary>
 	/// <returns></returns>
 	inline float LengthSquare() const {
 		return (x * x + y * y + z * z + w * w);
 	}
 	/// <summary>
-	/// 
+	/// 長さ
 	/// </summary>
 	/// <returns></returns>
 	inline float Length() const {
 		return sqrtf(LengthSquare());
 	}
 	/// <summary>
-	/// K
+	/// 正規化
 	/// </summary>
 	inline Quaternion Normalized() const {
 		return *this / Length();
 	}
 	/// <summary>
-	/// 
+	/// 共役
 	/// </summary>
 	/// <returns></returns>
 	inline Quaternion Conjugate() const {
 		return Quaternion(-x, -y, -z, w);
 	}
 	/// <summary>
-	/// t
+	/// 逆
 	/// </summary>
 	/// <returns></returns>
 	inline Quaternion Inverse() const {
 		return Conjugate() / LengthSquare();
 	}
 	/// <summary>
-	/// 
+	/// 内積
 	/// </summary>
 	friend inline float Dot(const Quaternion& q1, const Quaternion& p2) {
 		return (q1.x * p2.x + q1.y * p2.y + q1.z * p2.z + q1.w * p2.w);
 	}
 	/// <summary>
-	/// ʐ`
+	/// 球面線形補間
 	/// </summary>
 	/// <param name="t">0 ~ 1</param>
-	/// <param name="start">0̎</param>
-	/// <param name="end">1̎</param>
+	/// <param name="start">0の時</param>
+	/// <param name="end">1の時</param>
 	/// <returns></returns>
 	friend inline Quaternion Slerp(float t, const Quaternion& start, const Quaternion& end) {
 		Quaternion s = start;
 		float dot_val = Dot(start, end);
-		// q1, q2Ό̏ꍇ
+		// q1, q2が反対向きの場合
 		if (dot_val < 0) {
 			s.w = -s.w;
 			s.x = -s.x;
@@ -881,35 +934,34 @@ struct Quaternion {
 			s.z = -s.z;
 			dot_val = -dot_val;
 		}
-		// ʐ`Ԃ̌vZ
+		// 球面線形補間の計算
 		float theta = Math::Acos(dot_val);
 		return (Math::Sin((1 - t) * theta) * s + Math::Sin(t * theta) * end) / Math::Sin(theta);
 	}
 
 	/// <summary>
-	/// ]pƉ]NH[^jI쐬
+	/// 回転角と回転軸からクォータニオンを作成
 	/// </summary>
 	/// <param name="angle"></param>
 	/// <param name="axis"></param>
 	/// <returns></returns>
 	static inline Quaternion CreateFromAngleAxis(float angle, const Vector3& axis) {
-		float sin2 = Math::Sin(angle * 0.5f);
-		Quaternion result;
-		result.x = axis.x * sin2;
-		result.y = axis.y * sin2;
-		result.z = axis.z * sin2;
-		result.w = Math::Cos(angle * 0.5f);
-		return result;
+		float sin2, cos2;
+		Math::SinCos(angle * 0.5f, sin2, cos2);
+		return Quaternion(axis.x * sin2, axis.y * sin2, axis.z * sin2, cos2);
 	}
 	/// <summary>
-	/// IC[pNH[^jI쐬
+	/// オイラー角からクォータニオンを作成
 	/// </summary>
 	/// /// <param name="euler"></param>
 	/// <returns></returns>
 	static inline Quaternion CreateFromEuler(const Vector3& euler) {
-		// sb` [ [̏
-		Vector3 s = Vector3(Math::Sin(euler.x / 2.0f), Math::Sin(euler.y / 2.0f), Math::Sin(euler.z / 2.0f));
-		Vector3 c = Vector3(Math::Cos(euler.x / 2.0f), Math::Cos(euler.y / 2.0f), Math::Cos(euler.z / 2.0f));
+		// ピッチ ヨー ロールの順
+		float angles[4] = { euler.x / 2.0f, euler.y / 2.0f, euler.z / 2.0f, 0.0f };
+		float sins[4], coss[4];
+		Math::SIMD::SinCos4<true>(angles, sins, coss);
+		Vector3 s = Vector3(sins[0], sins[1], sins[2]);
+		Vector3 c = Vector3(coss[0], coss[1], coss[2]);
 		Quaternion result;
 		result.x = -c.x * s.y * s.z + s.x * c.y * c.z;
 		result.y = c.x * s.y * c.z + s.x * c.y * s.z;
@@ -918,31 +970,37 @@ struct Quaternion {
 		return result;
 	}
 	/// <summary>
-	/// sb`pNH[^jI쐬
+	/// ピッチ角からクォータニオンを作成
 	/// </summary>
 	/// <param name="angle"></param>
 	/// <returns></returns>
 	static inline Quaternion CreateFromPitch(float angle) {
-		return Quaternion(Math::Sin(angle / 2.0f), 0.0f, 0.0f, Math::Cos(angle / 2.0f));
+		float s, c;
+		Math::SinCos(angle / 2.0f, s, c);
+		return Quaternion(s, 0.0f, 0.0f, c);
 	}
 	/// <summary>
-	/// [pNH[^jI쐬
+	/// ヨー角からクォータニオンを作成
 	/// </summary>
 	/// <param name="angle"></param>
 	/// <returns></returns>
 	static inline Quaternion CreateFromYaw(float angle) {
-		return Quaternion(0.0f, Math::Sin(angle / 2.0f), 0.0f, Math::Cos(angle / 2.0f));
+		float s, c;
+		Math::SinCos(angle / 2.0f, s, c);
+		return Quaternion(0.0f, s, 0.0f, c);
 	}
 	/// <summary>
-	/// [pNH[^jI쐬
+	/// ロール角からクォータニオンを作成
 	/// </summary>
 	/// <param name="angle"></param>
 	/// <returns></returns>
 	static inline Quaternion CreateFromRoll(float angle) {
-		return Quaternion(0.0f, 0.0f, Math::Sin(angle / 2.0f), Math::Cos(angle / 2.0f));
+		float s, c;
+		Math::SinCos(angle / 2.0f, s, c);
+		return Quaternion(0.0f, 0.0f, s, c);
 	}
 	/// <summary>
-	/// ̃xNgNH[^jI쐬
+	/// 二つのベクトルからクォータニオンを作成
 	/// </summary>
 	/// <param name="v1"></param>
 	/// <param name="v2"></param>
@@ -953,8 +1011,9 @@ struct Quaternion {
 		return CreateFromAngleAxis(angle, axis);
 	}
 };
+inline constexpr Quaternion Quaternion::Identity = Quaternion(Math::kIdentity);
 /// <summary>
-/// 3~3s
+/// 3×3行列
 /// </summary>
 struct Matrix33 {
 	static const Matrix33 Identity;
@@ -963,34 +1022,34 @@ struct Matrix33 {
 	float m[3][3];
 
 
-	inline Matrix33() {
-		*this = Identity;
-	}
-	inline explicit Matrix33(
+	// 初期化しない(単位行列にする場合は kIdentity)
+	Matrix33() = default;
+	constexpr inline explicit Matrix33(Math::IdentityTag) :
+		m{ { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } } {}
+	constexpr inline explicit Matrix33(Math::ZeroTag) :
+		m{} {}
+	constexpr inline explicit Matrix33(
 		float _00, float _01, float _02,
 		float _10, float _11, float _12,
-		float _20, float _21, float _22) {
-		m[0][0] = _00, m[0][1] = _01, m[0][2] = _02;
-		m[1][0] = _10, m[1][1] = _11, m[1][2] = _12;
-		m[2][0] = _20, m[2][1] = _21, m[2][2] = _22;
-	}
+		float _20, float _21, float _22) :
+		m{ { _00, _01, _02 }, { _10, _11, _12 }, { _20, _21, _22 } } {}
 	/// <summary>
-	/// x
+	/// x軸
 	/// </summary>
 	/// <returns></returns>
 	inline Vector2 GetXAxis() const { return Vector2(m[0][0], m[0][1]); }
 	/// <summary>
-	/// y
+	/// y軸
 	/// </summary>
 	/// <returns></returns>
 	inline Vector2 GetYAxis() const { return Vector2(m[1][0], m[1][1]); }
 	/// <summary>
-	/// sړ
+	/// 平行移動成分
 	/// </summary>
 	/// <returns></returns>
 	inline Vector2 GetTranslation() const { return Vector2(m[2][0], m[2][1]); }
 
-#pragma region Zq̃I[o[[h
+#pragma region 演算子のオーバーロード
 	inline float* operator[](size_t i) {
 		return m[i];
 	}
@@ -1015,7 +1074,7 @@ struct Matrix33 {
 		*this = *this * m;
 		return *this;
 	}
-	friend inline Vector2 operator*(const Vector2& v, const Matrix33& m) {
+	friend constexpr inline Vector2 operator*(const Vector2& v, const Matrix33& m) {
 		return Vector2(
 			v.x * m.m[0][0] + v.y * m.m[1][0] + 1.0f * m.m[2][0],
 			v.x * m.m[0][1] + v.y * m.m[1][1] + 1.0f * m.m[2][1]);
@@ -1034,7 +1093,7 @@ struct Matrix33 {
 	}
 #pragma endregion
 	/// <summary>
-	/// s
+	/// 行列式
 	/// </summary>
 	/// <returns></returns>
 	inline float Determinant() const {
@@ -1042,7 +1101,7 @@ struct Matrix33 {
 			- m[0][2] * m[1][1] * m[2][0] - m[0][1] * m[1][0] * m[2][2] - m[0][0] * m[1][2] * m[2][1];
 	}
 	/// <summary>
-	/// ]qs
+	/// 余因子行列
 	/// </summary>
 	/// <returns></returns>
 	inline Matrix33 Adjugate() const {
@@ -1060,19 +1119,34 @@ struct Matrix33 {
 			  m[0][0] * m[1][1] - m[0][1] * m[1][0]);
 	}
 	/// <summary>
-	/// ts
+	/// 逆行列
 	/// </summary>
 	/// <returns></returns>
 	inline Matrix33 Inverse() const {
 		float det = Determinant();
-		assert(det != 0.0f); // 0̏ꍇts񂪂Ȃ
+		assert(det != 0.0f); // 0の場合逆行列がない
 		return 1.0f / det * Adjugate();
 	}
 	/// <summary>
-	/// ]us
+	/// アフィン行列の逆行列(3列目が (0, 0, 1) であること)
 	/// </summary>
 	/// <returns></returns>
-	inline Matrix33 Transpose() const {
+	inline Matrix33 InverseAffine() const {
+		float det = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+		assert(det != 0.0f); // 0の場合逆行列がない
+		float invDet = 1.0f / det;
+		float i00 = m[1][1] * invDet, i01 = -m[0][1] * invDet;
+		float i10 = -m[1][0] * invDet, i11 = m[0][0] * invDet;
+		return Matrix33(
+			i00,										i01,										0.0f,
+			i10,										i11,										0.0f,
+			-(m[2][0] * i00 + m[2][1] * i10),			-(m[2][0] * i01 + m[2][1] * i11),			1.0f);
+	}
+	/// <summary>
+	/// 転置行列
+	/// </summary>
+	/// <returns></returns>
+	constexpr inline Matrix33 Transpose() const {
 		return Matrix33(
 			m[0][0], m[1][0], m[2][0],
 			m[0][1], m[1][1], m[2][1],
@@ -1080,63 +1154,64 @@ struct Matrix33 {
 	}
 
 	/// <summary>
-	/// gks쐬
+	/// 拡大縮小行列を作成
 	/// </summary>
 	/// <param name="scale"></param>
 	/// <returns></returns>
-	static inline Matrix33 CreateScaling(const Vector2& scale) {
+	static constexpr inline Matrix33 CreateScaling(const Vector2& scale) {
 		return Matrix33(
 			scale.x,	0.0f,		0.0f,
 			0.0f,		scale.y,	0.0f,
 			0.0f,		0.0f,		1.0f);
 	}
 	/// <summary>
-	/// ]s쐬
+	/// 回転行列を作成
 	/// </summary>
 	/// <param name="rotate"></param>
 	/// <returns></returns>
 	static inline Matrix33 CreateRotation(float rotate) {
-		float s = Math::Sin(rotate);
-		float c = Math::Cos(rotate);
+		float s, c;
+		Math::SinCos(rotate, s, c);
 		return Matrix33(
 			c,		s,		0.0f,
 			-s,		c,		0.0f,
 			0.0f,	0.0f,	1.0f);
 	}
 	/// <summary>
-	/// sړs쐬
+	/// 平行移動行列を作成
 	/// </summary>
 	/// <param name="vector"></param>
 	/// <returns></returns>
-	static inline Matrix33 CreateTranslation(const Vector2& vector) {
+	static constexpr inline Matrix33 CreateTranslation(const Vector2& vector) {
 		return Matrix33(
 			1.0f,		0.0f,		0.0f,
 			0.0f,		1.0f,		0.0f,
 			vector.x,	vector.y,	1.0f);
 	}
 	/// <summary>
-	/// AtBϊs쐬(SRT)
+	/// アフィン変換行列を作成する(SRT)
 	/// </summary>
 	/// <param name="scale"></param>
 	/// <param name="rotate"></param>
 	/// <param name="vector"></param>
 	/// <returns></returns>
 	static inline Matrix33 CreateAffineTransform(const Vector2& scale, float rotate, const Vector2& vector) {
-		Matrix33 result;
-		result *= CreateScaling(scale);
-		result *= CreateRotation(rotate);
-		result *= CreateTranslation(vector);
-		return result;
+		float s, c;
+		Math::SinCos(rotate, s, c);
+		return Matrix33(
+			scale.x * c,	scale.x * s,	0.0f,
+			scale.y * -s,	scale.y * c,	0.0f,
+			vector.x,		vector.y,		1.0f);
 	}
 	/// <summary>
-	/// ses쐬
+	/// 平行投影行列を作成する
 	/// </summary>
 	/// <param name="left"></param>
 	/// <param name="top"></param>
 	/// <param name="right"></param>
 	/// <param name="bottom"></param>
 	/// <returns></returns>
-	static inline Matrix33 CreateOrthoProjection(float left, float top, float right, float bottom) {
+	static constexpr inline Matrix33 CreateOrthoProjection(float left, float top, float right, float bottom) {
 		return Matrix33(
 			2.0f / (right - left) ,					0.0f,								0.0f,
 			0.0f,									2.0f / (top - bottom),				0.0f,
@@ -1144,14 +1219,14 @@ struct Matrix33 {
 
 	}
 	/// <summary>
-	/// r[|[gs쐬
+	/// ビューポート行列を作成する
 	/// </summary>
 	/// <param name="left"></param>
 	/// <param name="top"></param>
 	/// <param name="width"></param>
 	/// <param name="height"></param>
 	/// <returns></returns>
-	static inline Matrix33 CreateViewport(float left, float top, float width, float height) {
+	static constexpr inline Matrix33 CreateViewport(float left, float top, float width, float height) {
 		float halfW = width / 2.0f;
 		float halfh = height / 2.0f;
 		return Matrix33(
@@ -1160,58 +1235,58 @@ struct Matrix33 {
 			left + halfW,	top + halfh,	1.0f);
 	}
 	/// <summary>
-	/// 44s񂩂33s쐬
+	/// 44行列から33行列を作成
 	/// </summary>
 	/// <param name="mat"></param>
 	/// <returns></returns>
 	static Matrix33 CreateFromMatrix44(const Matrix44& mat);
 };
+inline constexpr Matrix33 Matrix33::Identity = Matrix33(Math::kIdentity);
 /// <summary>
-/// 4~4s
+/// 4×4行列
 /// </summary>
-struct Matrix44 {
+struct alignas(16) Matrix44 {
 	static const Matrix44 Identity;
 
 
 	float m[4][4];
 
 
-	inline Matrix44() {
-		*this = Identity;
-	}
-	inline explicit Matrix44(
+	// 初期化しない(単位行列にする場合は kIdentity)
+	Matrix44() = default;
+	constexpr inline explicit Matrix44(Math::IdentityTag) :
+		m{ { 1.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f } } {}
+	constexpr inline explicit Matrix44(Math::ZeroTag) :
+		m{} {}
+	constexpr inline explicit Matrix44(
 		float _00, float _01, float _02, float _03,
 		float _10, float _11, float _12, float _13,
 		float _20, float _21, float _22, float _23,
-		float _30, float _31, float _32, float _33) {
-		m[0][0] = _00, m[0][1] = _01, m[0][2] = _02, m[0][3] = _03;
-		m[1][0] = _10, m[1][1] = _11, m[1][2] = _12, m[1][3] = _13;
-		m[2][0] = _20, m[2][1] = _21, m[2][2] = _22, m[2][3] = _23;
-		m[3][0] = _30, m[3][1] = _31, m[3][2] = _32, m[3][3] = _33;
-	}
+		float _30, float _31, float _32, float _33) :
+		m{ { _00, _01, _02, _03 }, { _10, _11, _12, _13 }, { _20, _21, _22, _23 }, { _30, _31, _32, _33 } } {}
 
 	/// <summary>
-	/// x
+	/// x軸
 	/// </summary>
 	/// <returns></returns>
 	inline Vector3 GetXAxis() const { return Vector3(m[0][0], m[0][1], m[0][2]); }
 	/// <summary>
-	/// y
+	/// y軸
 	/// </summary>
 	/// <returns></returns>
 	inline Vector3 GetYAxis() const { return Vector3(m[1][0], m[1][1], m[1][2]); }
 	/// <summary>
-	/// z
+	/// z軸
 	/// </summary>
 	/// <returns></returns>
 	inline Vector3 GetZAxis() const { return Vector3(m[2][0], m[2][1], m[2][2]); }
 	/// <summary>
-	/// sړ
+	/// 平行移動成分
 	/// </summary>
 	/// <returns></returns>
 	inline Vector3 GetTranslation() const { return Vector3(m[3][0], m[3][1], m[3][2]); }
 
-#pragma region Zq̃I[o[[h
+#pragma region 演算子のオーバーロード
 	inline float* operator[](size_t i) {
 		return m[i];
 	}
@@ -1219,29 +1294,12 @@ struct Matrix44 {
 		return m[i];
 	}
 	friend inline Matrix44 operator*(const Matrix44& m1, const Matrix44& m2) {
-		return Matrix44(
-			m1.m[0][0] * m2.m[0][0] + m1.m[0][1] * m2.m[1][0] + m1.m[0][2] * m2.m[2][0] + m1.m[0][3] * m2.m[3][0],
-			m1.m[0][0] * m2.m[0][1] + m1.m[0][1] * m2.m[1][1] + m1.m[0][2] * m2.m[2][1] + m1.m[0][3] * m2.m[3][1],
-			m1.m[0][0] * m2.m[0][2] + m1.m[0][1] * m2.m[1][2] + m1.m[0][2] * m2.m[2][2] + m1.m[0][3] * m2.m[3][2],
-			m1.m[0][0] * m2.m[0][3] + m1.m[0][1] * m2.m[1][3] + m1.m[0][2] * m2.m[2][3] + m1.m[0][3] * m2.m[3][3],
-
-			m1.m[1][0] * m2.m[0][0] + m1.m[1][1] * m2.m[1][0] + m1.m[1][2] * m2.m[2][0] + m1.m[1][3] * m2.m[3][0],
-			m1.m[1][0] * m2.m[0][1] + m1.m[1][1] * m2.m[1][1] + m1.m[1][2] * m2.m[2][1] + m1.m[1][3] * m2.m[3][1],
-			m1.m[1][0] * m2.m[0][2] + m1.m[1][1] * m2.m[1][2] + m1.m[1][2] * m2.m[2][2] + m1.m[1][3] * m2.m[3][2],
-			m1.m[1][0] * m2.m[0][3] + m1.m[1][1] * m2.m[1][3] + m1.m[1][2] * m2.m[2][3] + m1.m[1][3] * m2.m[3][3],
-
-			m1.m[2][0] * m2.m[0][0] + m1.m[2][1] * m2.m[1][0] + m1.m[2][2] * m2.m[2][0] + m1.m[2][3] * m2.m[3][0],
-			m1.m[2][0] * m2.m[0][1] + m1.m[2][1] * m2.m[1][1] + m1.m[2][2] * m2.m[2][1] + m1.m[2][3] * m2.m[3][1],
-			m1.m[2][0] * m2.m[0][2] + m1.m[2][1] * m2.m[1][2] + m1.m[2][2] * m2.m[2][2] + m1.m[2][3] * m2.m[3][2],
-			m1.m[2][0] * m2.m[0][3] + m1.m[2][1] * m2.m[1][3] + m1.m[2][2] * m2.m[2][3] + m1.m[2][3] * m2.m[3][3],
-
-			m1.m[3][0] * m2.m[0][0] + m1.m[3][1] * m2.m[1][0] + m1.m[3][2] * m2.m[2][0] + m1.m[3][3] * m2.m[3][0],
-			m1.m[3][0] * m2.m[0][1] + m1.m[3][1] * m2.m[1][1] + m1.m[3][2] * m2.m[2][1] + m1.m[3][3] * m2.m[3][1],
-			m1.m[3][0] * m2.m[0][2] + m1.m[3][1] * m2.m[1][2] + m1.m[3][2] * m2.m[2][2] + m1.m[3][3] * m2.m[3][2],
-			m1.m[3][0] * m2.m[0][3] + m1.m[3][1] * m2.m[1][3] + m1.m[3][2] * m2.m[2][3] + m1.m[3][3] * m2.m[3][3]);
+		Matrix44 result;
+		Math::SIMD::Multiply44(&m1.m[0][0], &m2.m[0][0], &result.m[0][0]);
+		return result;
 	}
 	inline Matrix44& operator*=(const Matrix44& m) {
-		*this = *this * m;
+		Math::SIMD::Multiply44(&this->m[0][0], &m.m[0][0], &this->m[0][0]);
 		return *this;
 	}
 	friend inline Matrix44 operator*(float s, const Matrix44& m) {
@@ -1258,13 +1316,13 @@ struct Matrix44 {
 			m.m[2][0] * s, m.m[2][1] * s, m.m[2][2] * s, m.m[2][3] * s,
 			m.m[3][0] * s, m.m[3][1] * s, m.m[3][2] * s, m.m[3][3] * s);
 	}
-	friend inline Vector3 operator*(const Vector3& v, const Matrix44& m) {
+	friend constexpr inline Vector3 operator*(const Vector3& v, const Matrix44& m) {
 		return Vector3(
 			v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0] + m.m[3][0],
 			v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1] + m.m[3][1],
 			v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2] + m.m[3][2]);
 	}
-	friend inline Vector4 operator*(const Vector4& v, const Matrix44& m) {
+	friend constexpr inline Vector4 operator*(const Vector4& v, const Matrix44& m) {
 		return Vector4(
 			v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0] + v.w * m.m[3][0],
 			v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1] + v.w * m.m[3][1],
@@ -1273,53 +1331,19 @@ struct Matrix44 {
 	}
 #pragma endregion
 	/// <summary>
-	/// s
+	/// 行列式
 	/// </summary>
 	/// <returns></returns>
 	inline float Determinant() const {
-		float result = 0.0f;
-
-		result += m[0][0] * m[1][1] * m[2][2] * m[3][3]; // +11,22,33,44
-		result += m[0][0] * m[1][2] * m[2][3] * m[3][1]; // +11,23,34,42
-		result += m[0][0] * m[1][3] * m[2][1] * m[3][2]; // +11,24,32,43
-
-		result -= m[0][0] * m[1][3] * m[2][2] * m[3][1]; // -11,24,33,42
-		result -= m[0][0] * m[1][2] * m[2][1] * m[3][3]; // -11,23,32,44
-		result -= m[0][0] * m[1][1] * m[2][3] * m[3][2]; // -11,22,34,43
-
-		result -= m[0][1] * m[1][0] * m[2][2] * m[3][3]; // -12,21,33,44
-		result -= m[0][2] * m[1][0] * m[2][3] * m[3][1]; // -13,21,34,42
-		result -= m[0][3] * m[1][0] * m[2][1] * m[3][2]; // -14,21,32,43
-
-		result += m[0][3] * m[1][0] * m[2][2] * m[3][1]; // +14,21,33,42
-		result += m[0][2] * m[1][0] * m[2][1] * m[3][3]; // +13,21,32,44
-		result += m[0][1] * m[1][0] * m[2][3] * m[3][2]; // +12,21,34,43
-
-		result += m[0][1] * m[1][2] * m[2][0] * m[3][3]; // +12,23,31,44
-		result += m[0][2] * m[1][3] * m[2][0] * m[3][1]; // +13,24,31,42
-		result += m[0][3] * m[1][1] * m[2][0] * m[3][2]; // +14,22,31,43
-
-		result -= m[0][3] * m[1][2] * m[2][0] * m[3][1]; // -14,23,31,42
-		result -= m[0][2] * m[1][1] * m[2][0] * m[3][3]; // -13,22,31,44
-		result -= m[0][1] * m[1][3] * m[2][0] * m[3][2]; // -12,24,31,43
-
-		result -= m[0][1] * m[1][2] * m[2][3] * m[3][0]; // -12,23,34,41
-		result -= m[0][2] * m[1][3] * m[2][1] * m[3][0]; // -13,24,32,41
-		result -= m[0][3] * m[1][1] * m[2][2] * m[3][0]; // -14,22,33,41
-
-		result += m[0][3] * m[1][2] * m[2][1] * m[3][0]; // +14,23,32,41
-		result += m[0][2] * m[1][1] * m[2][3] * m[3][0]; // +13,22,34,41
-		result += m[0][1] * m[1][3] * m[2][2] * m[3][0]; // +12,24,33,41
-
-		return result;
+		return Math::SIMD::Determinant44(&m[0][0]);
 	}
 	/// <summary>
-	/// ]qs
+	/// 余因子行列
 	/// </summary>
 	/// <returns></returns>
 	inline Matrix44 Adjugate() const {
 		Matrix44 result;
-		// 1s
+		// 1行目
 		result.m[0][0] = 0.0f;							// 11
 		result.m[0][0] += m[1][1] * m[2][2] * m[3][3];	// +22,33,44
 		result.m[0][0] += m[1][2] * m[2][3] * m[3][1];	// +23,34,42
@@ -1353,7 +1377,7 @@ struct Matrix44 {
 		result.m[0][3] += m[0][1] * m[1][3] * m[2][2];	// +12,24,33
 
 
-		// 2s
+		// 2行目
 		result.m[1][0] = 0.0f;							// 21
 		result.m[1][0] -= m[1][0] * m[2][2] * m[3][3];	// -21,33,44
 		result.m[1][0] -= m[1][2] * m[2][3] * m[3][0];	// -23,34,41
@@ -1387,7 +1411,7 @@ struct Matrix44 {
 		result.m[1][3] -= m[0][0] * m[1][3] * m[2][2];	// -11,24,33
 
 
-		// 3s
+		// 3行目
 		result.m[2][0] = 0.0f;							// 31
 		result.m[2][0] += m[1][0] * m[2][1] * m[3][3];	// +21,32,44
 		result.m[2][0] += m[1][1] * m[2][3] * m[3][0];	// +22,34,41
@@ -1421,7 +1445,7 @@ struct Matrix44 {
 		result.m[2][3] += m[0][0] * m[1][3] * m[2][1];	// +11,24,32
 
 
-		// 4s
+		// 4行目
 		result.m[3][0] = 0.0f;							// 41
 		result.m[3][0] -= m[1][0] * m[2][1] * m[3][2];	// -21,32,43
 		result.m[3][0] -= m[1][1] * m[2][2] * m[3][0];	// -22,33,41
@@ -1457,32 +1481,77 @@ struct Matrix44 {
 		return result;
 	}
 	/// <summary>
-	/// ts()
+	/// 逆行列
 	/// </summary>
 	/// <returns></returns>
 	inline Matrix44 Inverse() const {
-		float det = Determinant();
-		assert(det != 0.0f); // 0̏ꍇts񂪂Ȃ
-		return (1.0f / det * Adjugate());
+		Matrix44 result;
+		float det = Math::SIMD::Inverse44(&m[0][0], &result.m[0][0]);
+		assert(det != 0.0f); // 0の場合逆行列がない
+		(void)det;
+		return result;
 	}
 	/// <summary>
-	/// ]us
+	/// アフィン行列の逆行列(4列目が (0, 0, 0, 1) であること)
 	/// </summary>
 	/// <returns></returns>
-	inline Matrix44 Transpose() const {
+	inline Matrix44 InverseAffine() const {
+		Vector3 x = GetXAxis(), y = GetYAxis(), z = GetZAxis();
+		// 3×3部分の余因子を外積で求める
+		Vector3 c0 = Cross(y, z), c1 = Cross(z, x), c2 = Cross(x, y);
+		float det = Dot(x, c0);
+		assert(det != 0.0f); // 0の場合逆行列がない
+		float invDet = 1.0f / det;
+		c0 *= invDet, c1 *= invDet, c2 *= invDet;
+		Vector3 t = GetTranslation();
+		return Matrix44(
+			c0.x,				c1.x,				c2.x,				0.0f,
+			c0.y,				c1.y,				c2.y,				0.0f,
+			c0.z,				c1.z,				c2.z,				0.0f,
+			-Dot(t, c0),		-Dot(t, c1),		-Dot(t, c2),		1.0f);
+	}
+	/// <summary>
+	/// 回転と平行移動のみの行列の逆行列(拡縮を含む場合は使えない)
+	/// </summary>
+	/// <returns></returns>
+	inline Matrix44 InverseOrthonormal() const {
+		Vector3 x = GetXAxis(), y = GetYAxis(), z = GetZAxis();
+		Vector3 t = GetTranslation();
+		return Matrix44(
+			x.x,				y.x,				z.x,				0.0f,
+			x.y,				y.y,				z.y,				0.0f,
+			x.z,				y.z,				z.z,				0.0f,
+			-Dot(t, x),			-Dot(t, y),			-Dot(t, z),			1.0f);
+	}
+	/// <summary>
+	/// 転置行列
+	/// </summary>
+	/// <returns></returns>
+	constexpr inline Matrix44 Transpose() const {
 		return Matrix44(
 			m[0][0], m[1][0], m[2][0], m[3][0],
 			m[0][1], m[1][1], m[2][1], m[3][1],
 			m[0][2], m[1][2], m[2][2], m[3][2],
 			m[0][3], m[1][3], m[2][3], m[3][3]);
 	}
+	/// <summary>
+	/// アフィン行列同士の積(4列目が (0, 0, 0, 1) であること)
+	/// </summary>
+	/// <param name="m1">左辺</param>
+	/// <param name="m2">右辺</param>
+	/// <returns></returns>
+	static inline Matrix44 AffineMultiply(const Matrix44& m1, const Matrix44& m2) {
+		Matrix44 result;
+		Math::SIMD::AffineMultiply44(&m1.m[0][0], &m2.m[0][0], &result.m[0][0]);
+		return result;
+	}
 
 	/// <summary>
-	/// gks쐬
+	/// 拡大縮小行列を作成
 	/// </summary>
 	/// <param name="scale"></param>
 	/// <returns></returns>
-	static inline Matrix44 CreateScaling(const Vector3& scale) {
+	static constexpr inline Matrix44 CreateScaling(const Vector3& scale) {
 		return Matrix44(
 			scale.x,	0.0f,		0.0f,		0.0f,
 			0.0f,		scale.y,	0.0f,		0.0f,
@@ -1490,13 +1559,13 @@ struct Matrix44 {
 			0.0f,		0.0f,		0.0f,		1.0f);
 	}
 	/// <summary>
-	/// x̉]s쐬
+	/// x軸回りの回転行列を作成
 	/// </summary>
 	/// <param name="theta"></param>
 	/// <returns></returns>
 	static inline Matrix44 CreateRotationX(float theta) {
-		float c = Math::Cos(theta);
-		float s = Math::Sin(theta);
+		float s, c;
+		Math::SinCos(theta, s, c);
 		return Matrix44(
 			1.0f,	0.0f,	0.0f,	0.0f,
 			0.0f,	c,		s,		0.0f,
@@ -1504,13 +1573,13 @@ struct Matrix44 {
 			0.0f,	0.0f,	0.0f,	1.0f);
 	}
 	/// <summary>
-	/// ỷ]s쐬
+	/// y軸回りの回転行列を作成
 	/// </summary>
 	/// <param name="theta"></param>
 	/// <returns></returns>
 	static inline Matrix44 CreateRotationY(float theta) {
-		float c = Math::Cos(theta);
-		float s = Math::Sin(theta);
+		float s, c;
+		Math::SinCos(theta, s, c);
 		return Matrix44(
 			c,		0.0f,	-s,		0.0f,
 			0.0f,	1.0f,	0.0f,	0.0f,
@@ -1518,13 +1587,13 @@ struct Matrix44 {
 			0.0f,	0.0f,	0.0f,	1.0f);
 	}
 	/// <summary>
-	/// z̉]s쐬
+	/// z軸回りの回転行列を作成
 	/// </summary>
 	/// /// <param name="theta"></param>
 	/// <returns></returns>
 	static inline Matrix44 CreateRotationZ(float theta) {
-		float c = Math::Cos(theta);
-		float s = Math::Sin(theta);
+		float s, c;
+		Math::SinCos(theta, s, c);
 		return Matrix44(
 			c,		s,		0.0f,	0.0f,
 			-s,		c,		0.0f,	0.0f,
@@ -1532,13 +1601,16 @@ struct Matrix44 {
 			0.0f,	0.0f,	0.0f,	1.0f);
 	}
 	/// <summary>
-	/// IC[p]s쐬
+	/// オイラー角から回転行列を作成
 	/// </summary>
 	/// <param name="euler"></param>
 	/// <returns></returns>
 	static inline Matrix44 CreateRotationFromEuler(const Vector3& euler) {
-		Vector3 s = Vector3(Math::Sin(euler.x), Math::Sin(euler.y), Math::Sin(euler.z));
-		Vector3 c = Vector3(Math::Cos(euler.x), Math::Cos(euler.y), Math::Cos(euler.z));
+		float angles[4] = { euler.x, euler.y, euler.z, 0.0f };
+		float sins[4], coss[4];
+		Math::SIMD::SinCos4<true>(angles, sins, coss);
+		Vector3 s = Vector3(sins[0], sins[1], sins[2]);
+		Vector3 c = Vector3(coss[0], coss[1], coss[2]);
 
 		return Matrix44(
 			-s.x * s.y * s.z + c.y * c.z,	s.x * s.y * c.z + c.y * s.z,	-c.x * s.y,		0.0f,
@@ -1547,7 +1619,7 @@ struct Matrix44 {
 			0.0f,							0.0f,							0.0f,			1.0f);;
 	}
 	/// <summary>
-	/// NH[^jI]s쐬
+	/// クォータニオン回転行列を作成
 	/// </summary>
 	/// <param name="q"></param>
 	/// <returns></returns>
@@ -1563,11 +1635,11 @@ struct Matrix44 {
 			0.0f,				0.0f,				0.0f,				1.0f);
 	}
 	/// <summary>
-	/// sړs쐬
+	/// 平行移動行列を作成
 	/// </summary>
 	/// <param name="vector"></param>
 	/// <returns></returns>
-	static inline Matrix44 CreateTranslation(const Vector3& vector) {
+	static constexpr inline Matrix44 CreateTranslation(const Vector3& vector) {
 		return Matrix44(
 			1.0f,		0.0f,		0.0f,		0.0f,
 			0.0f,		1.0f,		0.0f,		0.0f,
@@ -1575,11 +1647,30 @@ struct Matrix44 {
 			vector.x,	vector.y,	vector.z,	1.0f);
 	}
 	/// <summary>
-	/// bNAbgs쐬
+	/// 拡縮、回転、平行移動の順に適用するアフィン変換行列を作成する
+	/// CreateScaling(scale) * CreateRotationFromQuaternion(q) * CreateTranslation(vector) と同じ(q は正規化済み)
+	/// </summary>
+	/// <param name="scale">拡縮</param>
+	/// <param name="q">回転</param>
+	/// <param name="vector">平行移動</param>
+	/// <returns></returns>
+	static constexpr inline Matrix44 CreateTRS(const Vector3& scale, const Quaternion& q, const Vector3& vector) {
+		float w2 = q.w * q.w, x2 = q.x * q.x, y2 = q.y * q.y, z2 = q.z * q.z;
+		float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+		float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+
+		return Matrix44(
+			scale.x * (w2 + x2 - y2 - z2),	scale.x * 2.0f * (wz + xy),		scale.x * 2.0f * (xz - wy),		0.0f,
+			scale.y * 2.0f * (xy - wz),		scale.y * (w2 - x2 + y2 - z2),	scale.y * 2.0f * (yz + wx),		0.0f,
+			scale.z * 2.0f * (wy + xz),		scale.z * 2.0f * (-wx + yz),	scale.z * (w2 - x2 - y2 + z2),	0.0f,
+			vector.x,						vector.y,						vector.z,						1.0f);
+	}
+	/// <summary>
+	/// ルックアット行列を作成
 	/// </summary>
-	/// <param name="pos">W</param>
-	/// <param name="target">W</param>
-	/// <param name="up">xNg</param>
+	/// <param name="pos">座標</param>
+	/// <param name="target">向ける座標</param>
+	/// <param name="up">上ベクトル</param>
 	/// <returns></returns>
 	static inline Matrix44 CreateLookAt(const Vector3& pos, const Vector3& target, const Vector3& up) {
 		Vector3 z = (target - pos).Normalized();
@@ -1592,27 +1683,27 @@ struct Matrix44 {
 			0.0f,	0.0f,	0.0f,	1.0f);
 	}
 	/// <summary>
-	/// Sr{[hs쐬
+	/// 全方向ビルボード行列を作成
 	/// </summary>
-	/// <param name="camera_eye">J̍W</param>
-	/// <param name="camera_target">_W</param>
-	/// <param name="camera_up">xNg</param>
+	/// <param name="camera_eye">カメラの座標</param>
+	/// <param name="camera_target">注視点座標</param>
+	/// <param name="camera_up">上ベクトル</param>
 	/// <returns></returns>
 	static inline Matrix44 CreateBillBoard(const Vector3& camera_eye, const Vector3& camera_target, const Vector3& camera_up) {
 		return CreateLookAt(camera_eye, camera_target, camera_up);
 	}
 	/// <summary>
-	/// yr{[hs쐬
+	/// y軸ビルボード行列を作成
 	/// </summary>
-	/// <param name="camera_eye">J̍W</param>
-	/// <param name="camera_target">_W</param>
-	/// <param name="camera_up">xNg</param>
+	/// <param name="camera_eye">カメラの座標</param>
+	/// <param name="camera_target">注視点座標</param>
+	/// <param name="camera_up">上ベクトル</param>
 	/// <returns></returns>
 	static inline Matrix44 CreateBillBoardYAxis(const Vector3& camera_eye, const Vector3& camera_target, const Vector3& camera_up) {
 		Vector3 z = (camera_target - camera_eye).Normalized();
 		Vector3 x = Cross(camera_up, z).Normalized();
 		Vector3 y = camera_up.Normalized();
-		z = Cross(x, y);	// zČvZ
+		z = Cross(x, y);	// zを再計算
 		return Matrix44(
 			x.x,	x.y,	x.z,	0.0f,
 			y.z,	y.y,	y.z,	0.0f,
@@ -1620,11 +1711,11 @@ struct Matrix44 {
 			0.0f,	0.0f,	0.0f,	1.0f);
 	}
 	/// <summary>
-	/// r[s쐬
+	/// ビュー行列を作成
 	/// </summary>
-	/// <param name="eye">J̍W</param>
-	/// <param name="target">_W</param>
-	/// <param name="up">xNg</param>
+	/// <param name="eye">カメラの座標</param>
+	/// <param name="target">注視点座標</param>
+	/// <param name="up">上ベクトル</param>
 	/// <returns></returns>
 	static inline Matrix44 CreateView(const Vector3& eye, const Vector3& target, const Vector3& up) {
 		Vector3 z = (target - eye).Normalized();
@@ -1638,12 +1729,12 @@ struct Matrix44 {
 			w.x, w.y, w.z, 1.0f);
 	}
 	/// <summary>
-	/// es쐬
+	/// 透視投影行列を作成
 	/// </summary>
-	/// <param name="fovY">p</param>
-	/// <param name="aspect">AXyNg  / </param>
-	/// <param name="nearZ">NbsO()</param>
-	/// <param name="farZ">NbsO()</param>
+	/// <param name="fovY">垂直画角</param>
+	/// <param name="aspect">アスペクト比 高 / 幅</param>
+	/// <param name="nearZ">クリッピング距離(近)</param>
+	/// <param name="farZ">クリッピング距離(遠)</param>
 	/// <returns></returns>
 	static inline Matrix44 CreatePerspectiveProjection(float fovY, float aspect, float nearZ, float farZ) {
 		float s = 1.0f / Math::Tan(fovY / 2.0f);
@@ -1655,16 +1746,16 @@ struct Matrix44 {
 			 0.0f,			0.0f,		a * -nearZ,		0.0f);
 	}
 	/// <summary>
-	/// ses쐬
+	/// 平行投影行列を作成
 	/// </summary>
-	/// <param name="left"></param>
-	/// <param name="top"></param>
-	/// <param name="right">E</param>
-	/// <param name="bottom"></param>
-	/// <param name="nearZ">NbsO()</param>
-	/// <param name="farZ">NbsO()</param>
+	/// <param name="left">左</param>
+	/// <param name="top">上</param>
+	/// <param name="right">右</param>
+	/// <param name="bottom">下</param>
+	/// <param name="nearZ">クリッピング距離(近)</param>
+	/// <param name="farZ">クリッピング距離(遠)</param>
 	/// <returns></returns>
-	static inline Matrix44 CreateOrthographicProjection(float left, float top, float right, float bottom, float nearZ = 0.0f, float farZ = 1.0f) {
+	static constexpr inline Matrix44 CreateOrthographicProjection(float left, float top, float right, float bottom, float nearZ = 0.0f, float farZ = 1.0f) {
 		return Matrix44(
 			2.0f / (right - left),				0.0f,								0.0f,						0.0f,
 			0.0f,								2.0f / (top - bottom),				0.0f,						0.0f,
@@ -1672,16 +1763,16 @@ struct Matrix44 {
 			(left + right) / (left - right),	(top + bottom) / (bottom - top),	nearZ / (nearZ - farZ),		1.0f);
 	}
 	/// <summary>
-	/// r[|[gs쐬
+	/// ビューポート行列を作成
 	/// </summary>
-	/// <param name="left"></param>
-	/// <param name="top"></param>
-	/// <param name="width"></param>
-	/// <param name="height"></param>
-	/// <param name="nearZ">NbsO()</param>
-	/// <param name="farZ">NbsO()</param>
+	/// <param name="left">左</param>
+	/// <param name="top">上</param>
+	/// <param name="width">幅</param>
+	/// <param name="height">高</param>
+	/// <param name="nearZ">クリッピング距離(近)</param>
+	/// <param name="farZ">クリッピング距離(遠)</param>
 	/// <returns></returns>
-	static inline Matrix44 CreateViewport(float left, float top, float width, float height, float nearZ = 0.0f, float farZ = 1.0f) {
+	static constexpr inline Matrix44 CreateViewport(float left, float top, float width, float height, float nearZ = 0.0f, float farZ = 1.0f) {
 		float halfW = width / 2.0f;
 		float halfh = height / 2.0f;
 		return Matrix44(
@@ -1691,29 +1782,30 @@ struct Matrix44 {
 			left + halfW,	top + halfh,	nearZ,			1.0f);
 	}
 	/// <summary>
-	/// 33s񂩂44s쐬
+	/// 33行列から44行列を作成
 	/// </summary>
 	/// <param name="mat"></param>
 	/// <returns></returns>
 	static Matrix44 CreateFromMatrix33(const Matrix33& mat);
 };
+inline constexpr Matrix44 Matrix44::Identity = Matrix44(Math::kIdentity);
 /// <summary>
-/// F
+/// 色
 /// </summary>
 namespace Color {
-	static const unsigned char kByteMax = 0xFF;
+	constexpr unsigned char kByteMax = 0xFF;
 
-	static const Vector4 Black = Vector4(0.0f, 0.0f, 0.0f, 1.0f);
-	static const Vector4 White = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
-	static const Vector4 Red = Vector4(1.0f, 0.0f, 0.0f, 1.0f);
-	static const Vector4 Green = Vector4(0.0f, 1.0f, 0.0f, 1.0f);
-	static const Vector4 Blue = Vector4(0.0f, 0.0f, 1.0f, 1.0f);
+	inline constexpr Vector4 Black = Vector4(0.0f, 0.0f, 0.0f, 1.0f);
+	inline constexpr Vector4 White = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+	inline constexpr Vector4 Red = Vector4(1.0f, 0.0f, 0.0f, 1.0f);
+	inline constexpr Vector4 Green = Vector4(0.0f, 1.0f, 0.0f, 1.0f);
+	inline constexpr Vector4 Blue = Vector4(0.0f, 0.0f, 1.0f, 1.0f);
 
-	inline unsigned int Create(unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
+	constexpr inline unsigned int Create(unsigned char r, unsigned char g, unsigned char b, unsigned char a) {
 		return r << 24 | g << 16 | b << 8 | a;
 	}
 	/// <summary>
-	/// unsigned int  Vector4ɕϊ
+	/// unsigned int から Vector4に変換
 	/// </summary>
 	/// <param name="color"></param>
 	/// <returns></returns>
@@ -1737,21 +1829,21 @@ namespace Color {
 		return result;
 	}
 	/// <summary>
-	/// HSVRGBɕϊ
+	/// HSVからRGBに変換
 	/// </summary>
-	/// <param name="h">F : 0 ~ 360</param>
-	/// <param name="s">ʓx : 0 ~ 1</param>
-	/// <param name="v">x : 0 ~ 1</param>
-	/// <param name="a">x 0 ~ 255 Ȃ^</param>
+	/// <param name="h">色相 : 0 ~ 360</param>
+	/// <param name="s">彩度 : 0 ~ 1</param>
+	/// <param name="v">明度 : 0 ~ 1</param>
+	/// <param name="a">透明度 0 ~ 255 符号なし整数型</param>
 	/// <returns></returns>
 	unsigned int HSVAtoRGBA_uint(float h, float s, float v, unsigned int a);
 	/// <summary>
-	/// HSVARGBAɕϊ
+	/// HSVAからRGBAに変換
 	/// </summary>
-	/// <param name="H">F</param>
-	/// <param name="S">ʓx</param>
-	/// <param name="V">x</param>
-	/// <param name="A">x</param>
+	/// <param name="H">色相</param>
+	/// <param name="S">彩度</param>
+	/// <param name="V">明度</param>
+	/// <param name="A">透明度</param>
 	/// <returns></returns>
 	inline Vector4 HSVAtoRGBA(float H, float S, float V, float A) {
 		if (S <= 0.0f) {
@@ -1763,7 +1855,7 @@ namespace Color {
 		float q = V * (1.0f - f * S);
 		float t = V * (1.0f - (1.0f - f) * S);
 
-		Vector4 color;
+		Vector4 color = Vector4(Math::kZero);
 		switch (i % 6) {
 		case 0: {
 			color.x = V; 
@@ -0,0 +1,3 @@
+// TextureManager の全テクスチャ(シェーダーモデル 5.1 以上)
+// ResolveTextureHandle したハンドルを番号にして引く
+Texture2D<float4> g_textures[] : register(t0, space1);
\ No newline at end of file
@@ -1,11 +1,16 @@
 cbuffer ConstBufferData : register(b0)
 {
-    float4 color; // F
-    matrix transMat; // ϊs
+    float4 color; // 色
+    matrix transMat; // 変換行列
+}
+
+cbuffer DrawConstants : register(b1)
+{
+    uint textureIndex; // テクスチャ配列の番号
 }
 
 struct VSOutput
 {
-    float4 svpos : SV_POSITION; // VXep_W
-    float2 uv : TEXCOORD;       // uvl
+    float4 svpos : SV_POSITION; // システム用頂点座標
+    float2 uv : TEXCOORD;       // uv値
 };
\ No newline at end of file
@@ -0,0 +1,12 @@
+cbuffer ConstBufferData : register(b0)
+{
+    matrix viewProjMat; // ビュー射影行列
+}
+
+struct VSOutput
+{
+    float4 svpos : SV_POSITION; // システム用頂点座標
+    float2 uv : TEXCOORD;       // uv値
+    float4 color : COLOR;       // 色
+    nointerpolation uint textureIndex : TEXINDEX; // テクスチャ配列の番号
+};
\ No newline at end of file
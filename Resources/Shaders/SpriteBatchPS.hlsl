@@ -0,0 +1,10 @@
+#include "SpriteBatch.hlsli"
+#include "Bindless.hlsli"
+
+SamplerState smp : register(s0);
+
+float4 main(VSOutput input) : SV_TARGET
+{
+    // 一回の描画の中でスプライトごとに違う
+    return g_textures[NonUniformResourceIndex(input.textureIndex)].Sample(smp, input.uv) * input.color;
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+#include "SpriteBatch.hlsli"
+
+VSOutput main(float4 pos : POSITION, float2 uv : TEXCOORD, float4 color : COLOR, uint textureIndex : TEXINDEX)
+{
+    VSOutput output;
+    output.svpos = mul(viewProjMat, pos);
+    output.uv = uv;
+    output.color = color;
+    output.textureIndex = textureIndex;
+    return output;
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#include "SpriteBatch.hlsli"
+
+// SpriteBatchBuilder::Instance
+struct Instance
+{
+    float2 position : INSTANCE_POSITION;
+    float rotate : INSTANCE_ROTATE;
+    float2 size : INSTANCE_SIZE;         // 反転は符号に含まれる
+    float2 anchorPoint : INSTANCE_ANCHOR;
+    float2 uvBase : INSTANCE_UVBASE;
+    float2 uvSize : INSTANCE_UVSIZE;
+    float4 color : COLOR;
+    uint textureIndex : INSTANCE_TEXINDEX;
+};
+
+// SpriteBatchBuilder::ExpandInstance と同じ計算
+VSOutput main(Instance instance, uint vertexId : SV_VertexID)
+{
+    // 0:左下 1:左上 2:右下 3:右上
+    float2 corner = float2(vertexId >> 1, ~vertexId & 1);
+
+    float2 local = (corner - instance.anchorPoint) * instance.size;
+    float s, c;
+    sincos(instance.rotate, s, c);
+    float2 world = float2(local.x * c - local.y * s, local.x * s + local.y * c) + instance.position;
+
+    VSOutput output;
+    output.svpos = mul(viewProjMat, float4(world, 0.0f, 1.0f));
+    output.uv = instance.uvBase + corner * instance.uvSize;
+    output.color = instance.color;
+    output.textureIndex = instance.textureIndex;
+    return output;
+}
\ No newline at end of file
@@ -1,9 +1,9 @@
 #include "Sprite.hlsli"
+#include "Bindless.hlsli"
 
-Texture2D<float4> tex : register(t0);
 SamplerState smp : register(s0);
 
 float4 main(VSOutput input) : SV_TARGET
 {
-    return tex.Sample(smp, input.uv) * color;
+    return g_textures[textureIndex].Sample(smp, input.uv) * color;
 }
\ No newline at end of file
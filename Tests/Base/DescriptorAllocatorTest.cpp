@@ -0,0 +1,350 @@
+#include "TestFramework.h"
+
+#include <deque>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "DescriptorAllocator.h"
+
+// ヒープを作らない偽のページでディスクリプタの割り当てを確かめる
+// 生きている割り当ての範囲が重ならないことと、GPU が使い終える前に再利用しないことを見る
+
+namespace {
+	constexpr uint32_t kIncrementSize = 32;
+
+	/// <summary>
+	/// 偽のヒープを作る(ページごとにアドレスを離し、作った数を数える)
+	/// </summary>
+	class FakeHeapFactory
+	{
+	public:
+		DescriptorHeapPage operator()(uint32_t count) {
+			DescriptorHeapPage page;
+			page.cpuStart.ptr = 0x10000000 + static_cast<SIZE_T>(createdCounts_.size()) * 0x1000000;
+			page.gpuStart.ptr = 0x80000000 + static_cast<UINT64>(createdCounts_.size()) * 0x1000000;
+			createdCounts_.push_back(count);
+			return page;
+		}
+		const std::vector<uint32_t>& GetCreatedCounts() const { return createdCounts_; }
+
+	private:
+		std::vector<uint32_t> createdCounts_;
+	};
+
+	/// <summary>
+	/// 送ったフレームを古い順に終える GPU
+	/// </summary>
+	class SimulatedGpu
+	{
+	public:
+		uint64_t Submit() {
+			inFlight_.push_back(++lastSignaled_);
+			return lastSignaled_;
+		}
+		uint64_t CompleteOldest() {
+			if (!inFlight_.empty()) {
+				completed_ = inFlight_.front();
+				inFlight_.pop_front();
+			}
+			return completed_;
+		}
+		uint64_t Wait(uint64_t fenceValue) {
+			waitCount_++;
+			while (completed_ < fenceValue) {
+				CompleteOldest();
+			}
+			return completed_;
+		}
+		uint64_t GetCompletedValue() const { return completed_; }
+		size_t GetInFlightCount() const { return inFlight_.size(); }
+		size_t GetWaitCount() const { return waitCount_; }
+
+	private:
+		std::deque<uint64_t> inFlight_;
+		uint64_t lastSignaled_ = 0;
+		uint64_t completed_ = 0;
+		size_t waitCount_ = 0;
+	};
+
+	/// <summary>
+	/// CPU アドレスで、生きている割り当てが重ならないかを確かめる
+	/// </summary>
+	class OccupancyMap
+	{
+	public:
+		// 重なっていれば false
+		bool Add(const DescriptorHandle& handle) {
+			SIZE_T begin = handle.cpu.ptr, end = handle.GetCpuHandle(handle.count).ptr;
+			auto next = ranges_.lower_bound(begin);
+			if (next != ranges_.end() && next->first < end) {
+				return false;
+			}
+			if (next != ranges_.begin() && std::prev(next)->second > begin) {
+				return false;
+			}
+			ranges_.emplace(begin, end);
+			return true;
+		}
+		void Remove(const DescriptorHandle& handle) { ranges_.erase(handle.cpu.ptr); }
+		size_t GetCount() const { return ranges_.size(); }
+
+	private:
+		// 先頭 → 終端
+		std::map<SIZE_T, SIZE_T> ranges_;
+	};
+}
+
+TEST_CASE(FreeListFirstFitAndCoalesce) {
+	DescriptorFreeList freeList;
+	freeList.Initalize(16);
+	CHECK(freeList.Allocate(4) == 0);
+	CHECK(freeList.Allocate(4) == 4);
+	CHECK(freeList.Allocate(4) == 8);
+	CHECK(freeList.GetUsedCount() == 12);
+	CHECK(freeList.Allocate(5) == DescriptorFreeList::kInvalidOffset);
+
+	// 間を空けると空き範囲が分かれる
+	freeList.Free(0, 4);
+	freeList.Free(8, 4);
+	CHECK(freeList.GetFreeRangeCount() == 2);
+	// 先頭から探すので前の穴に入る
+	CHECK(freeList.Allocate(2) == 0);
+	freeList.Free(0, 2);
+	// 真ん中を解放すると前後とつながって一つになる
+	freeList.Free(4, 4);
+	CHECK(freeList.GetFreeRangeCount() == 1);
+	CHECK(freeList.GetUsedCount() == 0);
+	CHECK(freeList.Allocate(16) == 0);
+}
+
+TEST_CASE(RingWrapsAndWaitsForOldFrames) {
+	SimulatedGpu gpu;
+	DescriptorRing ring;
+	ring.Initalize(16, [&gpu](uint64_t fenceValue) { return gpu.Wait(fenceValue); });
+
+	CHECK(ring.Allocate(6) == 0);
+	ring.FinishFrame(gpu.Submit());
+	CHECK(ring.Allocate(6) == 6);
+	ring.FinishFrame(gpu.Submit());
+	// 末尾の 4 個には入らないので、先頭が空くまで最初のフレームを待って折り返す
+	CHECK(ring.Allocate(6) == 0);
+	CHECK(ring.GetStatistics().stallCount == 1);
+	CHECK(ring.GetStatistics().wrapCount == 1);
+	CHECK(gpu.GetCompletedValue() == 1);
+	// 捨てた末尾も GPU が終えるまで使用中に数える
+	CHECK(ring.GetStatistics().usedCount == 16);
+	ring.FinishFrame(gpu.Submit());
+
+	// 全て終えたら先頭から使い直す
+	ring.Release(gpu.Wait(3));
+	CHECK(ring.GetStatistics().usedCount == 0);
+	CHECK(ring.Allocate(16) == 0);
+	CHECK(ring.GetStatistics().peakUsedCount == 16);
+}
+
+TEST_CASE(RingNeverHandsOutRangesInUseByGpu) {
+	std::mt19937 random(5);
+	SimulatedGpu gpu;
+	DescriptorRing ring;
+	ring.Initalize(256, [&gpu](uint64_t fenceValue) { return gpu.Wait(fenceValue); });
+	// GPU が使っている範囲(フレームごと)
+	std::deque<std::pair<uint64_t, std::vector<DescriptorHandle>>> inFlight;
+	OccupancyMap occupancy;
+	auto retire = [&](uint64_t completedValue) {
+		while (!inFlight.empty() && inFlight.front().first <= completedValue) {
+			for (auto& handle : inFlight.front().second) {
+				occupancy.Remove(handle);
+			}
+			inFlight.pop_front();
+		}
+	};
+
+	for (int frame = 0; frame < 3000; frame++) {
+		std::vector<DescriptorHandle> handles;
+		int allocationCount = std::uniform_int_distribution<int>(0, 8)(random);
+		for (int i = 0; i < allocationCount; i++) {
+			// 一フレーム分は折り返しの無駄を含めても輪に収まる
+			uint32_t count = std::uniform_int_distribution<uint32_t>(1, 24)(random);
+			size_t waitCount = gpu.GetWaitCount();
+			uint32_t offset = ring.Allocate(count);
+			// 待った場合は GPU が終えたフレームの範囲を外す
+			if (gpu.GetWaitCount() != waitCount) {
+				retire(gpu.GetCompletedValue());
+			}
+			REQUIRE(offset != DescriptorRing::kInvalidOffset);
+			REQUIRE(offset + count <= 256);
+			DescriptorHandle handle;
+			handle.cpu.ptr = offset;
+			handle.count = count;
+			handle.incrementSize = 1;
+			CHECK(occupancy.Add(handle));
+			handles.push_back(handle);
+		}
+		uint64_t fenceValue = gpu.Submit();
+		ring.FinishFrame(fenceValue);
+		inFlight.emplace_back(fenceValue, std::move(handles));
+		// GPU は 0 ~ 2 フレーム進む
+		int completeCount = std::uniform_int_distribution<int>(0, 2)(random);
+		for (int i = 0; i < completeCount; i++) {
+			gpu.CompleteOldest();
+		}
+		ring.Release(gpu.GetCompletedValue());
+		retire(gpu.GetCompletedValue());
+	}
+	CHECK(ring.GetStatistics().stallCount > 0);
+	CHECK(ring.GetStatistics().wrapCount > 0);
+}
+
+TEST_CASE(StagingAddsPagesAndReusesImmediately) {
+	FakeHeapFactory factory;
+	StagingDescriptorAllocator allocator;
+	allocator.Initalize(std::ref(factory), kIncrementSize, 8);
+
+	DescriptorHandle a = allocator.Allocate(6);
+	DescriptorHandle b = allocator.Allocate(4);
+	// 最初のページに入らなければページを足す
+	CHECK(factory.GetCreatedCounts() == std::vector<uint32_t>({ 8, 8 }));
+	CHECK(a.page == 0);
+	CHECK(b.page == 1);
+	CHECK(a.GetCpuHandle(1).ptr == a.cpu.ptr + kIncrementSize);
+	CHECK(a.gpu.ptr == 0);
+
+	// 空いた所は GPU を待たずにすぐ使う
+	SIZE_T address = a.cpu.ptr;
+	allocator.Free(a);
+	CHECK(!a.IsValid());
+	DescriptorHandle c = allocator.Allocate(2);
+	CHECK(c.page == 0);
+	CHECK(c.cpu.ptr == address);
+	// 二度目の解放は何もしない
+	allocator.Free(a);
+
+	auto statistics = allocator.GetStatistics();
+	CHECK(statistics.pageCount == 2);
+	CHECK(statistics.capacity == 16);
+	CHECK(statistics.usedCount == 6);
+	CHECK(statistics.peakUsedCount == 10);
+	allocator.Free(b);
+	allocator.Free(c);
+	CHECK(allocator.GetStatistics().usedCount == 0);
+	CHECK(allocator.GetStatistics().freeRangeCount == 2);
+}
+
+TEST_CASE(StagingRandomTraceHasNoOverlap) {
+	std::mt19937 random(9);
+	FakeHeapFactory factory;
+	StagingDescriptorAllocator allocator;
+	allocator.Initalize(std::ref(factory), kIncrementSize, 64);
+	OccupancyMap occupancy;
+	std::vector<DescriptorHandle> live;
+	for (int step = 0; step < 20000; step++) {
+		if (live.empty() || std::uniform_int_distribution<int>(0, 2)(random) != 0) {
+			DescriptorHandle handle = allocator.Allocate(std::uniform_int_distribution<uint32_t>(1, 16)(random));
+			CHECK(occupancy.Add(handle));
+			live.push_back(handle);
+		}
+		else {
+			size_t index = std::uniform_int_distribution<size_t>(0, live.size() - 1)(random);
+			occupancy.Remove(live[index]);
+			allocator.Free(live[index]);
+			live[index] = live.back();
+			live.pop_back();
+		}
+	}
+	uint32_t usedCount = 0;
+	for (auto& handle : live) {
+		usedCount += handle.count;
+	}
+	CHECK(allocator.GetStatistics().usedCount == usedCount);
+}
+
+TEST_CASE(ShaderVisibleDefersFreeUntilFence) {
+	FakeHeapFactory factory;
+	SimulatedGpu gpu;
+	ShaderVisibleDescriptorAllocator allocator;
+	allocator.Initalize(std::ref(factory), kIncrementSize, 8, 16, [&gpu](uint64_t fenceValue) { return gpu.Wait(fenceValue); });
+	// 永続とフレームごとで一つのヒープを分ける
+	CHECK(factory.GetCreatedCounts() == std::vector<uint32_t>({ 24 }));
+
+	DescriptorHandle texture = allocator.Allocate(8);
+	CHECK(texture.offset == 0);
+	CHECK(texture.gpu.ptr == allocator.GetPersistentTable().ptr);
+	DescriptorHandle table = allocator.AllocateDynamic(4);
+	// フレームごとの範囲は永続の後ろ
+	CHECK(table.offset == 8);
+	CHECK(table.GetGpuHandle().ptr == allocator.GetPersistentTable().ptr + 8 * kIncrementSize);
+
+	// 解放したフレームを GPU が終えるまで再利用しない
+	allocator.Free(texture);
+	CHECK(allocator.GetStatistics().pendingFreeCount == 8);
+	uint64_t fenceValue = gpu.Submit();
+	allocator.FinishFrame(fenceValue);
+	allocator.Release(gpu.GetCompletedValue());
+	CHECK(allocator.GetStatistics().usedCount == 8);
+	gpu.CompleteOldest();
+	allocator.Release(gpu.GetCompletedValue());
+	CHECK(allocator.GetStatistics().usedCount == 0);
+	CHECK(allocator.GetStatistics().pendingFreeCount == 0);
+	CHECK(allocator.GetStatistics().dynamic.usedCount == 0);
+	CHECK(allocator.Allocate(8).offset == 0);
+}
+
+TEST_CASE(ShaderVisibleRandomFramesHaveNoOverlap) {
+	std::mt19937 random(11);
+	FakeHeapFactory factory;
+	SimulatedGpu gpu;
+	ShaderVisibleDescriptorAllocator allocator;
+	allocator.Initalize(std::ref(factory), kIncrementSize, 512, 128, [&gpu](uint64_t fenceValue) { return gpu.Wait(fenceValue); });
+
+	OccupancyMap occupancy;
+	std::vector<DescriptorHandle> live;
+	// GPU が使い終えるまで重なってはいけないもの(解放した永続の範囲とフレームごとのテーブル)
+	std::deque<std::pair<uint64_t, std::vector<DescriptorHandle>>> inFlight;
+	std::vector<DescriptorHandle> frameHandles;
+	auto retire = [&](uint64_t completedValue) {
+		while (!inFlight.empty() && inFlight.front().first <= completedValue) {
+			for (auto& handle : inFlight.front().second) {
+				occupancy.Remove(handle);
+			}
+			inFlight.pop_front();
+		}
+	};
+
+	for (int frame = 0; frame < 2000; frame++) {
+		for (int i = 0; i < 4; i++) {
+			if (live.size() < 20 && std::uniform_int_distribution<int>(0, 1)(random) == 0) {
+				DescriptorHandle handle = allocator.Allocate(std::uniform_int_distribution<uint32_t>(1, 16)(random));
+				REQUIRE(handle.IsValid());
+				CHECK(occupancy.Add(handle));
+				live.push_back(handle);
+			}
+			else if (!live.empty()) {
+				size_t index = std::uniform_int_distribution<size_t>(0, live.size() - 1)(random);
+				frameHandles.push_back(live[index]);
+				allocator.Free(live[index]);
+				live[index] = live.back();
+				live.pop_back();
+			}
+			size_t waitCount = gpu.GetWaitCount();
+			DescriptorHandle table = allocator.AllocateDynamic(std::uniform_int_distribution<uint32_t>(1, 24)(random));
+			if (gpu.GetWaitCount() != waitCount) {
+				retire(gpu.GetCompletedValue());
+			}
+			REQUIRE(table.IsValid());
+			CHECK(table.offset >= allocator.GetPersistentCount());
+			CHECK(occupancy.Add(table));
+			frameHandles.push_back(table);
+		}
+		uint64_t fenceValue = gpu.Submit();
+		allocator.FinishFrame(fenceValue);
+		inFlight.emplace_back(fenceValue, std::move(frameHandles));
+		frameHandles.clear();
+		if (std::uniform_int_distribution<int>(0, 2)(random) != 0) {
+			gpu.CompleteOldest();
+		}
+		allocator.Release(gpu.GetCompletedValue());
+		retire(gpu.GetCompletedValue());
+	}
+	CHECK(allocator.GetStatistics().dynamic.stallCount > 0);
+}
@@ -0,0 +1,156 @@
+#include "TestFramework.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "FramePacer.h"
+
+// GPU を時刻で動くシミュレーションに差し替えて、待つタイミングと先行するフレーム数を確かめる
+
+namespace {
+	/// <summary>
+	/// 一つずつ順にフレームを処理する GPU
+	/// シグナルしてから latency 後に処理を始め、gpuTime かけて終える
+	/// </summary>
+	class SimulatedQueue : public GpuQueue
+	{
+	public:
+		SimulatedQueue(double gpuTime, double latency) : gpuTime_(gpuTime), latency_(latency) {}
+
+		uint64_t Signal() override {
+			double start = std::max(now_ + latency_, finishTimes_.empty() ? 0.0 : finishTimes_.back());
+			finishTimes_.push_back(start + gpuTime_);
+			return finishTimes_.size();
+		}
+		uint64_t GetCompletedValue() override {
+			uint64_t value = 0;
+			while (value < finishTimes_.size() && finishTimes_[value] <= now_) {
+				value++;
+			}
+			return value;
+		}
+		uint64_t Wait(uint64_t fenceValue) override {
+			waitCount_++;
+			if (fenceValue > 0) {
+				now_ = std::max(now_, finishTimes_[fenceValue - 1]);
+			}
+			return GetCompletedValue();
+		}
+
+		// CPU の処理で時間を進める
+		void Advance(double time) { now_ += time; }
+		double GetNow() const { return now_; }
+		size_t GetWaitCount() const { return waitCount_; }
+
+	private:
+		double gpuTime_;
+		double latency_;
+		double now_ = 0.0;
+		// フェンス値 - 1 番目のフレームを終える時刻
+		std::vector<double> finishTimes_;
+		size_t waitCount_ = 0;
+	};
+
+	struct RunResult {
+		double frameTime = 0.0;
+		uint64_t maxFramesInFlight = 0;
+		size_t stallCount = 0;
+		bool isContextReusedEarly = false;
+	};
+
+	/// <summary>
+	/// CPU が cpuTime かけて組み立てたフレームを frameCount 回送る
+	/// </summary>
+	RunResult Run(uint32_t contextCount, double cpuTime, double gpuTime, double latency, int frameCount) {
+		SimulatedQueue queue(gpuTime, latency);
+		FramePacer pacer;
+		pacer.Initalize(&queue, contextCount);
+		// フレームコンテキストを最後に使ったフレームのフェンス値(テスト側でも覚えておく)
+		std::vector<uint64_t> contextFenceValues(contextCount, 0);
+		RunResult result;
+		for (int i = 0; i < frameCount; i++) {
+			uint32_t index = pacer.BeginFrame();
+			// GPU が読み終えていないコンテキストを書き換えてはいけない
+			if (queue.GetCompletedValue() < contextFenceValues[index]) {
+				result.isContextReusedEarly = true;
+			}
+			queue.Advance(cpuTime);
+			contextFenceValues[index] = pacer.EndFrame();
+			result.maxFramesInFlight = std::max(result.maxFramesInFlight, pacer.GetLastSignaledValue() - queue.GetCompletedValue());
+		}
+		pacer.WaitIdle();
+		result.frameTime = queue.GetNow() / frameCount;
+		result.stallCount = pacer.GetStatistics().stallCount;
+		CHECK(pacer.GetStatistics().frameCount == static_cast<size_t>(frameCount));
+		CHECK(pacer.GetCompletedValue() == pacer.GetLastSignaledValue());
+		return result;
+	}
+
+	constexpr int kFrameCount = 1000;
+}
+
+TEST_CASE(SingleContextSerializesCpuAndGpu) {
+	// 毎フレーム GPU を待つので CPU と GPU の時間が足される
+	RunResult result = Run(1, 4.0, 6.0, 0.0, kFrameCount);
+	CHECK(!result.isContextReusedEarly);
+	CHECK(result.maxFramesInFlight == 1);
+	CHECK(result.stallCount == kFrameCount - 1);
+	CHECK_NEAR(result.frameTime, 10.0, 0.01);
+}
+
+TEST_CASE(GpuBoundFramesOverlap) {
+	for (uint32_t contextCount = 2; contextCount <= FramePacer::kMaxFrameCount; contextCount++) {
+		// GPU が遅いときは GPU の時間で進み、先行するのはコンテキストの数まで
+		RunResult result = Run(contextCount, 4.0, 6.0, 0.0, kFrameCount);
+		CHECK(!result.isContextReusedEarly);
+		CHECK(result.maxFramesInFlight <= contextCount);
+		CHECK(result.stallCount > 0);
+		CHECK_NEAR(result.frameTime, 6.0, 0.05);
+	}
+}
+
+TEST_CASE(CpuBoundFramesNeverStall) {
+	// CPU が遅いときは GPU がすぐ追いつくので一度も待たない
+	RunResult result = Run(2, 6.0, 4.0, 0.0, kFrameCount);
+	CHECK(!result.isContextReusedEarly);
+	CHECK(result.stallCount == 0);
+	CHECK_NEAR(result.frameTime, 6.0, 0.01);
+}
+
+TEST_CASE(LatencyIsHiddenByMoreContexts) {
+	// 送ってから GPU が始めるまで 6 かかると、コンテキストが少ないほど待つ
+	RunResult two = Run(2, 4.0, 4.0, 6.0, kFrameCount);
+	RunResult four = Run(4, 4.0, 4.0, 6.0, kFrameCount);
+	CHECK(!two.isContextReusedEarly);
+	CHECK(!four.isContextReusedEarly);
+	CHECK(two.frameTime > 4.0 + 1.0);
+	CHECK(four.stallCount < two.stallCount);
+	CHECK(four.frameTime < two.frameTime);
+	// 送ってから終えるまでが CPU の 3 フレーム分に収まれば待たずに回る
+	CHECK(four.stallCount == 0);
+	CHECK_NEAR(four.frameTime, 4.0, 0.05);
+}
+
+TEST_CASE(WaitUsesCompletedValueFirst) {
+	SimulatedQueue queue(5.0, 0.0);
+	FramePacer pacer;
+	pacer.Initalize(&queue, 3);
+	pacer.BeginFrame();
+	uint64_t first = pacer.EndFrame();
+	pacer.BeginFrame();
+	uint64_t second = pacer.EndFrame();
+	CHECK(pacer.GetFramesInFlight() == 2);
+
+	// 通過済みなら GPU を待たない
+	queue.Advance(5.0);
+	CHECK(pacer.Wait(first) >= first);
+	CHECK(queue.GetWaitCount() == 0);
+	// 通過していなければ待つ
+	CHECK(pacer.Wait(second) == second);
+	CHECK(queue.GetWaitCount() == 1);
+	CHECK_NEAR(queue.GetNow(), 10.0, 1e-9);
+	CHECK(pacer.GetFramesInFlight() == 0);
+	// 何も送っていなければ WaitIdle は待たない
+	pacer.WaitIdle();
+	CHECK(queue.GetWaitCount() == 1);
+}
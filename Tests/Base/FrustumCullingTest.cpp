@@ -0,0 +1,176 @@
+#include "TestFramework.h"
+
+#include <random>
+#include <vector>
+
+#include "FrustumCulling.h"
+#include "ThreadPool.h"
+#include "WorldTransform.h"
+
+// 見えているインデックスがスカラーの Intersects と同じになるかを、一つのスレッドで処理する数と分割する数の両方で確かめる
+
+namespace {
+	// 一つのスレッドで処理する数(塊の端数あり)、しきい値の前後、分割して処理する数
+	constexpr size_t kCounts[] = { 0, 1, 5000, FrustumCulling::kParallelThreshold - 1, FrustumCulling::kParallelThreshold, 30001 };
+
+	class Generator
+	{
+	public:
+		explicit Generator(uint32_t seed) : random_(seed) {}
+		float Get(float min, float max) { return std::uniform_real_distribution<float>(min, max)(random_); }
+		Vector3 GetVector3(float min, float max) { return Vector3(Get(min, max), Get(min, max), Get(min, max)); }
+
+	private:
+		std::mt19937 random_;
+	};
+
+	// SoA の配列の持ち主
+	struct SphereArray {
+		std::vector<float> x, y, z, radius;
+
+		explicit SphereArray(size_t count) : x(count), y(count), z(count), radius(count) {}
+		void Set(size_t i, const Sphere& sphere) { x[i] = sphere.center.x; y[i] = sphere.center.y; z[i] = sphere.center.z; radius[i] = sphere.radius; }
+		Sphere Get(size_t i) const { return Sphere{ Vector3(x[i], y[i], z[i]), radius[i] }; }
+		SphereSoA GetSoA() const { return SphereSoA{ ConstVector3SoA(x, y, z), radius }; }
+	};
+
+	Frustum CreateTestFrustum() {
+		Matrix44 view = Matrix44::CreateView(Vector3(1.0f, 2.0f, -10.0f), Vector3::Zero, Vector3::UnitY);
+		Matrix44 proj = Matrix44::CreatePerspectiveProjection(Math::ToRadians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+		return Frustum::CreateFromMatrix(view * proj);
+	}
+
+	// 一部が視錐台に入るように散らした位置
+	Vector3 GeneratePosition(Generator& generator) {
+		return Vector3(generator.Get(-60.0f, 60.0f), generator.Get(-60.0f, 60.0f), generator.Get(-30.0f, 120.0f));
+	}
+
+	/// <summary>
+	/// 結果が期待する見えているインデックスと一致するか
+	/// </summary>
+	bool IsSameIndices(std::span<const uint32_t> actual, const std::vector<uint32_t>& expected) {
+		if (actual.size() != expected.size()) {
+			std::printf("  visible %zu expected %zu\n", actual.size(), expected.size());
+			return false;
+		}
+		for (size_t i = 0; i < actual.size(); i++) {
+			if (actual[i] != expected[i]) {
+				std::printf("  visible[%zu] = %u expected %u\n", i, actual[i], expected[i]);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	struct ThreadPoolScope {
+		ThreadPoolScope() { ThreadPool::GetInstance()->Initalize(3); }
+		~ThreadPoolScope() { ThreadPool::GetInstance()->Finalize(); }
+	};
+}
+
+TEST_CASE(SphereCullingMatchesScalar) {
+	ThreadPoolScope threadPoolScope;
+	Generator generator(1);
+	Frustum frustum = CreateTestFrustum();
+	FrustumCulling culling;
+	size_t testedCount = 0, visibleCount = 0;
+	for (size_t count : kCounts) {
+		SphereArray spheres(count);
+		std::vector<uint32_t> expected;
+		for (size_t i = 0; i < count; i++) {
+			spheres.Set(i, Sphere{ GeneratePosition(generator), generator.Get(0.1f, 5.0f) });
+			if (Math::Intersects(frustum, spheres.Get(i))) {
+				expected.push_back(static_cast<uint32_t>(i));
+			}
+		}
+		std::span<const uint32_t> visible = culling.Cull(frustum, spheres.GetSoA());
+		CHECK(IsSameIndices(visible, expected));
+		testedCount += count;
+		visibleCount += expected.size();
+		CHECK(culling.GetStatistics().testedCount == testedCount);
+		CHECK(culling.GetStatistics().visibleCount == visibleCount);
+		// どちらかに偏っていると比べる意味が無い
+		if (count > 1000) {
+			CHECK(expected.size() > count / 20 && expected.size() < count - count / 20);
+		}
+	}
+
+	culling.ResetStatistics();
+	CHECK(culling.GetStatistics().testedCount == 0);
+	CHECK(culling.GetStatistics().visibleCount == 0);
+}
+
+TEST_CASE(AABBCullingMatchesScalar) {
+	ThreadPoolScope threadPoolScope;
+	Generator generator(2);
+	Frustum frustum = CreateTestFrustum();
+	FrustumCulling culling;
+	for (size_t count : kCounts) {
+		std::vector<float> cx(count), cy(count), cz(count), ex(count), ey(count), ez(count);
+		std::vector<uint32_t> expected;
+		for (size_t i = 0; i < count; i++) {
+			Vector3 center = GeneratePosition(generator);
+			Vector3 extents = generator.GetVector3(0.1f, 5.0f);
+			cx[i] = center.x; cy[i] = center.y; cz[i] = center.z;
+			ex[i] = extents.x; ey[i] = extents.y; ez[i] = extents.z;
+			if (Math::Intersects(frustum, AABB::CreateFromCenterExtents(center, extents))) {
+				expected.push_back(static_cast<uint32_t>(i));
+			}
+		}
+		culling.ResetStatistics();
+		std::span<const uint32_t> visible = culling.Cull(frustum, AABBSoA{ ConstVector3SoA(cx, cy, cz), ConstVector3SoA(ex, ey, ez) });
+		CHECK(IsSameIndices(visible, expected));
+		CHECK(culling.GetStatistics().testedCount == count);
+		CHECK(culling.GetStatistics().visibleCount == expected.size());
+	}
+}
+
+TEST_CASE(AllOrNothingVisible) {
+	ThreadPoolScope threadPoolScope;
+	Frustum frustum = CreateTestFrustum();
+	FrustumCulling culling;
+	for (size_t count : kCounts) {
+		// 全て見えていると、詰める先と元が同じ位置になる
+		SphereArray spheres(count);
+		std::vector<uint32_t> all(count);
+		for (size_t i = 0; i < count; i++) {
+			spheres.Set(i, Sphere{ Vector3::Zero, 1.0f });
+			all[i] = static_cast<uint32_t>(i);
+		}
+		CHECK(IsSameIndices(culling.Cull(frustum, spheres.GetSoA()), all));
+
+		// 全て視点の後ろ
+		for (size_t i = 0; i < count; i++) {
+			spheres.Set(i, Sphere{ Vector3(1.0f, 2.0f, -20.0f), 1.0f });
+		}
+		CHECK(culling.Cull(frustum, spheres.GetSoA()).empty());
+	}
+}
+
+TEST_CASE(WorldTransformCullingMatchesScalar) {
+	ThreadPoolScope threadPoolScope;
+	Generator generator(3);
+	Frustum frustum = CreateTestFrustum();
+	const Sphere localBounds{ Vector3(0.0f, 0.5f, 0.0f), 1.0f };
+	FrustumCulling culling;
+	for (size_t count : kCounts) {
+		std::vector<WorldTransform> transforms(count);
+		std::vector<const WorldTransform*> pointers(count);
+		std::vector<uint32_t> expected;
+		for (size_t i = 0; i < count; i++) {
+			WorldTransform& transform = transforms[i];
+			transform.scale = generator.GetVector3(0.5f, 3.0f);
+			transform.rotate = Quaternion::CreateFromAngleAxis(generator.Get(-3.0f, 3.0f), generator.GetVector3(-1.0f, 1.0f).Normalized());
+			transform.position = GeneratePosition(generator);
+			transform.worldMatrix = Matrix44::CreateTRS(transform.scale, transform.rotate, transform.position);
+			pointers[i] = &transform;
+			if (Math::Intersects(frustum, localBounds.Transformed(transform.worldMatrix))) {
+				expected.push_back(static_cast<uint32_t>(i));
+			}
+		}
+		culling.ResetStatistics();
+		CHECK(IsSameIndices(culling.Cull(frustum, pointers, localBounds), expected));
+		CHECK(culling.GetStatistics().testedCount == count);
+		CHECK(culling.GetStatistics().visibleCount == expected.size());
+	}
+}
@@ -0,0 +1,356 @@
+#include "TestFramework.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "PipelineCacheStore.h"
+
+// パイプラインキャッシュのキー(設定のハッシュ)と保存形式をデバイスを使わずに確かめる
+
+namespace {
+	const uint8_t kVertexShader[] = { 0x44, 0x58, 0x42, 0x43, 1, 2, 3, 4, 5, 6, 7, 8 };
+	const uint8_t kPixelShader[] = { 0x44, 0x58, 0x42, 0x43, 9, 10, 11, 12 };
+
+	/// <summary>
+	/// スプライトに近いパイプラインの設定(配列は自分で持つ)
+	/// 構造体の隙間をわざと fill で埋め、隙間がハッシュに入らないことを確かめられるようにする
+	/// </summary>
+	struct PipelineSetup {
+		std::vector<uint8_t> vs;
+		std::vector<uint8_t> ps;
+		std::string positionName = "POSITION";
+		std::string texcoordName = "TEXCOORD";
+		D3D12_INPUT_ELEMENT_DESC elements[2];
+		D3D12_GRAPHICS_PIPELINE_STATE_DESC desc;
+
+		explicit PipelineSetup(uint8_t fill = 0) :
+			vs(std::begin(kVertexShader), std::end(kVertexShader)),
+			ps(std::begin(kPixelShader), std::end(kPixelShader)) {
+			std::memset(elements, fill, sizeof(elements));
+			std::memset(&desc, fill, sizeof(desc));
+			for (auto& element : elements) {
+				element.SemanticIndex = 0;
+				element.InputSlot = 0;
+				element.InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA;
+				element.InstanceDataStepRate = 0;
+			}
+			elements[0].SemanticName = positionName.c_str();
+			elements[0].Format = DXGI_FORMAT_R32G32B32_FLOAT;
+			elements[0].AlignedByteOffset = 0;
+			elements[1].SemanticName = texcoordName.c_str();
+			elements[1].Format = DXGI_FORMAT_R32G32_FLOAT;
+			elements[1].AlignedByteOffset = 12;
+
+			desc.pRootSignature = nullptr;
+			desc.VS = { vs.data(), vs.size() };
+			desc.PS = { ps.data(), ps.size() };
+			desc.DS = { nullptr, 0 };
+			desc.HS = { nullptr, 0 };
+			desc.GS = { nullptr, 0 };
+			desc.StreamOutput.pSODeclaration = nullptr;
+			desc.StreamOutput.NumEntries = 0;
+			desc.StreamOutput.pBufferStrides = nullptr;
+			desc.StreamOutput.NumStrides = 0;
+			desc.StreamOutput.RasterizedStream = 0;
+			desc.BlendState.AlphaToCoverageEnable = false;
+			desc.BlendState.IndependentBlendEnable = false;
+			for (auto& blend : desc.BlendState.RenderTarget) {
+				blend.BlendEnable = true;
+				blend.LogicOpEnable = false;
+				blend.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+				blend.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+				blend.BlendOp = D3D12_BLEND_OP_ADD;
+				blend.SrcBlendAlpha = D3D12_BLEND_ONE;
+				blend.DestBlendAlpha = D3D12_BLEND_ZERO;
+				blend.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+				blend.LogicOp = D3D12_LOGIC_OP_NOOP;
+				blend.RenderTargetWriteMask = 0xF;
+			}
+			desc.SampleMask = UINT32_MAX;
+			desc.RasterizerState.FillMode = D3D12_FILL_MODE_SOLID;
+			desc.RasterizerState.CullMode = D3D12_CULL_MODE_NONE;
+			desc.RasterizerState.FrontCounterClockwise = false;
+			desc.RasterizerState.DepthBias = 0;
+			desc.RasterizerState.DepthBiasClamp = 0.0f;
+			desc.RasterizerState.SlopeScaledDepthBias = 0.0f;
+			desc.RasterizerState.DepthClipEnable = true;
+			desc.RasterizerState.MultisampleEnable = false;
+			desc.RasterizerState.AntialiasedLineEnable = false;
+			desc.RasterizerState.ForcedSampleCount = 0;
+			desc.RasterizerState.ConservativeRaster = D3D12_CONSERVATIVE_RASTERIZATION_MODE_OFF;
+			desc.DepthStencilState.DepthEnable = false;
+			desc.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ZERO;
+			desc.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_ALWAYS;
+			desc.DepthStencilState.StencilEnable = false;
+			desc.DepthStencilState.StencilReadMask = 0xFF;
+			desc.DepthStencilState.StencilWriteMask = 0xFF;
+			desc.DepthStencilState.FrontFace = { D3D12_STENCIL_OP_KEEP, D3D12_STENCIL_OP_KEEP, D3D12_STENCIL_OP_KEEP, D3D12_COMPARISON_FUNC_ALWAYS };
+			desc.DepthStencilState.BackFace = desc.DepthStencilState.FrontFace;
+			desc.InputLayout = { elements, 2 };
+			desc.IBStripCutValue = D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_DISABLED;
+			desc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+			desc.NumRenderTargets = 1;
+			desc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+			desc.DSVFormat = DXGI_FORMAT_D32_FLOAT;
+			desc.SampleDesc = { 1, 0 };
+			desc.NodeMask = 0;
+			desc.CachedPSO = { nullptr, 0 };
+			desc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+		}
+		PipelineSetup(const PipelineSetup&) = delete;
+
+		uint64_t Hash(uint64_t rootSignatureHash = 1) const {
+			return PipelineCacheStore::HashGraphicsPipeline(desc, rootSignatureHash);
+		}
+	};
+
+	/// <summary>
+	/// テーブルと定数とサンプラーを持つルートシグネチャの設定
+	/// </summary>
+	struct RootSignatureSetup {
+		D3D12_DESCRIPTOR_RANGE range;
+		D3D12_ROOT_PARAMETER params[3];
+		D3D12_STATIC_SAMPLER_DESC sampler;
+		D3D12_ROOT_SIGNATURE_DESC desc;
+
+		explicit RootSignatureSetup(uint8_t fill = 0) {
+			std::memset(this, fill, sizeof(*this));
+			range = { D3D12_DESCRIPTOR_RANGE_TYPE_SRV, UINT32_MAX, 0, 1, 0 };
+			params[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+			params[0].DescriptorTable = { 1, &range };
+			params[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+			params[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+			params[1].Descriptor = { 0, 0 };
+			params[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+			params[2].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+			params[2].Constants = { 3, 0, 1 };
+			params[2].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+			sampler.Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
+			sampler.AddressU = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+			sampler.AddressV = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+			sampler.AddressW = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+			sampler.MipLODBias = 0.0f;
+			sampler.MaxAnisotropy = 16;
+			sampler.ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER;
+			sampler.BorderColor = D3D12_STATIC_BORDER_COLOR_TRANSPARENT_BLACK;
+			sampler.MinLOD = 0.0f;
+			sampler.MaxLOD = 1000.0f;
+			sampler.ShaderRegister = 0;
+			sampler.RegisterSpace = 0;
+			sampler.ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+			desc = { 3, params, 1, &sampler, D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT };
+		}
+		RootSignatureSetup(const RootSignatureSetup&) = delete;
+
+		uint64_t Hash() const { return PipelineCacheStore::HashRootSignature(desc); }
+	};
+
+	std::vector<uint8_t> MakeBlob(size_t size, uint8_t seed) {
+		std::vector<uint8_t> blob(size);
+		for (size_t i = 0; i < size; i++) {
+			blob[i] = static_cast<uint8_t>(seed + i * 7);
+		}
+		return blob;
+	}
+
+	std::string WriteToString(const PipelineCacheStore& store) {
+		std::ostringstream stream(std::ios::binary);
+		store.Write(stream);
+		return stream.str();
+	}
+}
+
+TEST_CASE(PipelineHashDependsOnContentNotAddresses) {
+	PipelineSetup a(0x00);
+	// 隙間とアドレスが違っても中身が同じなら同じキー
+	PipelineSetup b(0xCD);
+	CHECK(a.desc.VS.pShaderBytecode != b.desc.VS.pShaderBytecode);
+	CHECK(a.Hash() == b.Hash());
+
+	// ルートシグネチャはポインタではなくハッシュで、CachedPSO は含めない
+	ID3D12RootSignature rootSignature;
+	b.desc.pRootSignature = &rootSignature;
+	b.desc.CachedPSO = { kPixelShader, sizeof(kPixelShader) };
+	CHECK(a.Hash() == b.Hash());
+	CHECK(a.Hash(1) != a.Hash(2));
+
+	// 使わない出力先の形式は見ない
+	b.desc.RTVFormats[3] = DXGI_FORMAT_R32G32B32A32_FLOAT;
+	CHECK(a.Hash() == b.Hash());
+}
+
+TEST_CASE(PipelineHashChangesWithEachSetting) {
+	PipelineSetup base;
+	uint64_t baseHash = base.Hash();
+	const std::vector<std::pair<const char*, std::function<void(PipelineSetup&)>>> mutations = {
+		{ "vs byte", [](PipelineSetup& s) { s.vs.back() ^= 1; } },
+		{ "ps length", [](PipelineSetup& s) { s.desc.PS.BytecodeLength--; } },
+		{ "no gs -> gs", [](PipelineSetup& s) { s.desc.GS = { s.ps.data(), s.ps.size() }; } },
+		{ "blend", [](PipelineSetup& s) { s.desc.BlendState.RenderTarget[0].DestBlend = D3D12_BLEND_ONE; } },
+		{ "write mask", [](PipelineSetup& s) { s.desc.BlendState.RenderTarget[7].RenderTargetWriteMask = 0x7; } },
+		{ "sample mask", [](PipelineSetup& s) { s.desc.SampleMask = 1; } },
+		{ "cull", [](PipelineSetup& s) { s.desc.RasterizerState.CullMode = D3D12_CULL_MODE_BACK; } },
+		{ "depth bias clamp", [](PipelineSetup& s) { s.desc.RasterizerState.DepthBiasClamp = 0.5f; } },
+		{ "depth", [](PipelineSetup& s) { s.desc.DepthStencilState.DepthEnable = true; } },
+		{ "stencil back", [](PipelineSetup& s) { s.desc.DepthStencilState.BackFace.StencilFunc = D3D12_COMPARISON_FUNC_LESS; } },
+		{ "semantic", [](PipelineSetup& s) { s.texcoordName = "COLOR"; s.elements[1].SemanticName = s.texcoordName.c_str(); } },
+		{ "offset", [](PipelineSetup& s) { s.elements[1].AlignedByteOffset = 16; } },
+		{ "instancing", [](PipelineSetup& s) { s.elements[1].InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA; } },
+		{ "element count", [](PipelineSetup& s) { s.desc.InputLayout.NumElements = 1; } },
+		{ "rtv format", [](PipelineSetup& s) { s.desc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM; } },
+		{ "rtv count", [](PipelineSetup& s) { s.desc.NumRenderTargets = 2; s.desc.RTVFormats[1] = DXGI_FORMAT_UNKNOWN; } },
+		{ "dsv", [](PipelineSetup& s) { s.desc.DSVFormat = DXGI_FORMAT_UNKNOWN; } },
+		{ "msaa", [](PipelineSetup& s) { s.desc.SampleDesc.Count = 4; } },
+	};
+	std::vector<uint64_t> hashes;
+	for (auto& [name, mutate] : mutations) {
+		PipelineSetup setup;
+		mutate(setup);
+		uint64_t hash = setup.Hash();
+		if (hash == baseHash) {
+			std::printf("  unchanged by %s\n", name);
+		}
+		CHECK(hash != baseHash);
+		hashes.push_back(hash);
+	}
+	// どの変更どうしもぶつからない
+	std::sort(hashes.begin(), hashes.end());
+	CHECK(std::adjacent_find(hashes.begin(), hashes.end()) == hashes.end());
+}
+
+TEST_CASE(SemanticNameNullAndEmptyDiffer) {
+	PipelineSetup a, b;
+	a.elements[1].SemanticName = nullptr;
+	b.elements[1].SemanticName = "";
+	CHECK(a.Hash() != b.Hash());
+}
+
+TEST_CASE(RootSignatureHashIgnoresPaddingAndDiffersByParameter) {
+	RootSignatureSetup a(0x00), b(0xCD);
+	CHECK(a.Hash() == b.Hash());
+
+	b.range.RegisterSpace = 2;
+	CHECK(a.Hash() != b.Hash());
+	b.range.RegisterSpace = 1;
+	b.params[2].Constants.Num32BitValues = 2;
+	CHECK(a.Hash() != b.Hash());
+	b.params[2].Constants.Num32BitValues = 1;
+	b.sampler.Filter = D3D12_FILTER_MIN_MAG_MIP_POINT;
+	CHECK(a.Hash() != b.Hash());
+	b.sampler.Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
+	b.params[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+	CHECK(a.Hash() != b.Hash());
+	b.params[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+	b.desc.Flags = D3D12_ROOT_SIGNATURE_FLAG_NONE;
+	CHECK(a.Hash() != b.Hash());
+	b.desc.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
+	CHECK(a.Hash() == b.Hash());
+
+	// 空の設定でもルートシグネチャとパイプラインのキーは重ならない
+	D3D12_ROOT_SIGNATURE_DESC emptyRootSignature = {};
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC emptyPipeline = {};
+	CHECK(PipelineCacheStore::HashRootSignature(emptyRootSignature) != PipelineCacheStore::HashGraphicsPipeline(emptyPipeline, 0));
+}
+
+TEST_CASE(StoreRoundTripsUsedEntriesAndPrewarmKeys) {
+	PipelineCacheStore store;
+	CHECK(!store.IsDirty());
+	auto blobA = MakeBlob(100, 1), blobB = MakeBlob(3000, 2), blobC = MakeBlob(0, 3);
+	store.Store(10, blobA.data(), blobA.size());
+	store.Store(20, blobB.data(), blobB.size());
+	store.Store(30, blobC.data(), blobC.size());
+	store.SetPrewarmKeys({ 20, 10 });
+	CHECK(store.IsDirty());
+	std::string bytes = WriteToString(store);
+
+	PipelineCacheStore loaded;
+	std::istringstream input(bytes, std::ios::binary);
+	REQUIRE(loaded.Read(input));
+	CHECK(loaded.GetEntryCount() == 3);
+	CHECK((loaded.GetPrewarmKeys() == std::vector<uint64_t>{ 20, 10 }));
+	// 読み込んだだけではまだ何も使っていない
+	CHECK(loaded.IsDirty());
+	REQUIRE(loaded.Find(20) != nullptr);
+	CHECK(*loaded.Find(20) == blobB);
+	CHECK(loaded.Find(30)->empty());
+	CHECK(loaded.Find(40) == nullptr);
+
+	// 今回使ったものだけを書く(10 は消える)
+	PipelineCacheStore next;
+	std::istringstream nextInput(WriteToString(loaded), std::ios::binary);
+	REQUIRE(next.Read(nextInput));
+	CHECK(next.GetEntryCount() == 2);
+	CHECK(next.Find(10) == nullptr);
+	CHECK(*next.Find(20) == blobB);
+	CHECK(next.Find(30) != nullptr);
+	// 全て使えば書き直す必要はない
+	CHECK(!next.IsDirty());
+	next.SetPrewarmKeys({ 20, 10 });
+	CHECK(!next.IsDirty());
+	next.Remove(30);
+	CHECK(next.IsDirty());
+}
+
+TEST_CASE(StoreRejectsBrokenStreams) {
+	PipelineCacheStore store;
+	auto blob = MakeBlob(64, 7);
+	store.Store(1, blob.data(), blob.size());
+	store.Store(2, blob.data(), blob.size());
+	store.SetPrewarmKeys({ 1, 2 });
+	std::string bytes = WriteToString(store);
+
+	// 途中で切れたものは全て読まない
+	for (size_t length = 0; length < bytes.size(); length += 5) {
+		PipelineCacheStore loaded;
+		std::istringstream input(bytes.substr(0, length), std::ios::binary);
+		CHECK(!loaded.Read(input));
+		CHECK(loaded.GetEntryCount() == 0);
+		CHECK(loaded.GetPrewarmKeys().empty());
+	}
+
+	// 違う形式のファイル
+	std::string wrongVersion = bytes;
+	wrongVersion[4] ^= 0x7F;
+	std::string wrongMagic = bytes;
+	wrongMagic[0] = 'X';
+	for (const std::string& broken : { wrongVersion, wrongMagic }) {
+		PipelineCacheStore loaded;
+		std::istringstream input(broken, std::ios::binary);
+		CHECK(!loaded.Read(input));
+		CHECK(loaded.GetEntryCount() == 0);
+	}
+
+	// 大きさが壊れていても巨大な確保をしない
+	std::string hugeEntry = bytes;
+	uint32_t hugeSize = UINT32_MAX;
+	std::memcpy(&hugeEntry[12 + sizeof(uint64_t)], &hugeSize, sizeof(hugeSize));
+	PipelineCacheStore loaded;
+	std::istringstream input(hugeEntry, std::ios::binary);
+	CHECK(!loaded.Read(input));
+	CHECK(loaded.GetEntryCount() == 0);
+}
+
+TEST_CASE(StoreSavesAndLoadsFiles) {
+	std::filesystem::path directory = std::filesystem::temp_directory_path() / "PipelineCacheStoreTest";
+	std::filesystem::remove_all(directory);
+	std::string filePath = (directory / "nested" / "pipeline.cache").string();
+
+	PipelineCacheStore store;
+	// 無いファイルは空で false
+	CHECK(!store.Load(filePath));
+	auto blob = MakeBlob(256, 9);
+	store.Store(42, blob.data(), blob.size());
+	// ディレクトリも作る
+	CHECK(store.Save(filePath));
+
+	PipelineCacheStore loaded;
+	CHECK(loaded.Load(filePath));
+	REQUIRE(loaded.Find(42) != nullptr);
+	CHECK(*loaded.Find(42) == blob);
+	std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,282 @@
+#include "TestFramework.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "RenderGraph.h"
+
+// RenderGraph::Compile の結果(除外するパス、寿命、メモリの共有、バリア)を確かめる(デバイスは使わない)
+
+namespace {
+	using RG = RenderGraph;
+
+	// 1 ピクセル 4 バイト、64KB 境界
+	RG::AllocationInfo GetAllocationInfo(const RG::TextureDesc& desc, uint32_t) {
+		uint64_t size = uint64_t(desc.width) * desc.height * 4;
+		return RG::AllocationInfo{ (size + 65535) & ~uint64_t(65535), 65536 };
+	}
+
+	const RG::ExecuteFunction kEmptyPass = [](RenderGraphExecutor&) {};
+
+	// 寿命が重なる一時リソースのメモリが重ならない
+	bool HasNoOverlappingLiveMemory(const RG& graph) {
+		auto resources = graph.GetResources();
+		for (size_t i = 0; i < resources.size(); i++) {
+			for (size_t j = i + 1; j < resources.size(); j++) {
+				const RG::Resource& a = resources[i];
+				const RG::Resource& b = resources[j];
+				if (a.isImported || b.isImported || !a.IsUsed() || !b.IsUsed() || a.heapType != b.heapType) {
+					continue;
+				}
+				bool isLifetimeOverlapped = a.firstPass <= b.lastPass && b.firstPass <= a.lastPass;
+				bool isMemoryOverlapped = a.heapOffset < b.heapOffset + b.allocation.size && b.heapOffset < a.heapOffset + a.allocation.size;
+				if (isLifetimeOverlapped && isMemoryOverlapped) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	// 残ったパスの名前
+	std::vector<std::string> GetCompiledPassNames(const RG& graph) {
+		std::vector<std::string> names;
+		for (auto& compiledPass : graph.GetCompiledPasses()) {
+			names.push_back(graph.GetPass(compiledPass.pass).name);
+		}
+		return names;
+	}
+}
+
+TEST_CASE(PassesNotReachingOutputAreCulled) {
+	RG graph;
+	RG::TextureDesc desc{ 256, 256, 28 };
+	auto backBuffer = graph.ImportTexture("BackBuffer", RG::kUsagePresent, RG::kUsagePresent);
+	auto color = graph.CreateTexture("Color", desc);
+	auto debug = graph.CreateTexture("Debug", desc);
+	auto readback = graph.CreateTexture("Readback", desc);
+	graph.AddPass("Scene", { { color, RG::kUsageRenderTarget } }, kEmptyPass);
+	graph.AddPass("Debug", { { color, RG::kUsageShaderResource }, { debug, RG::kUsageRenderTarget } }, kEmptyPass);
+	graph.AddPass("Capture", { { readback, RG::kUsageRenderTarget } }, kEmptyPass, true);
+	graph.AddPass("Post", { { color, RG::kUsageShaderResource }, { backBuffer, RG::kUsageRenderTarget } }, kEmptyPass);
+	graph.Compile(GetAllocationInfo);
+
+	// 取り込んだリソースに届かない Debug だけが消え、副作用のある Capture は残る
+	CHECK((GetCompiledPassNames(graph) == std::vector<std::string>{ "Scene", "Capture", "Post" }));
+	CHECK(graph.GetReport().passCount == 4);
+	CHECK(graph.GetReport().culledPassCount == 1);
+	CHECK(!graph.GetResource(debug).IsUsed());
+	CHECK(graph.GetReport().transientCount == 2);
+
+	// 出力に届かなければ全て消える
+	graph.Reset();
+	auto orphan = graph.CreateTexture("Orphan", desc);
+	graph.AddPass("Orphan", { { orphan, RG::kUsageRenderTarget } }, kEmptyPass);
+	graph.Compile(GetAllocationInfo);
+	CHECK(graph.GetCompiledPasses().empty());
+	CHECK(graph.GetReport().transientCount == 0);
+	CHECK(graph.GetHeapSize(RG::kHeapTypeRenderTarget) == 0);
+}
+
+TEST_CASE(LifetimesAndUsagesFollowCompiledPasses) {
+	RG graph;
+	auto backBuffer = graph.ImportTexture("BackBuffer", RG::kUsagePresent, RG::kUsagePresent);
+	auto shadow = graph.CreateTexture("Shadow", RG::TextureDesc{ 512, 512, 40 });
+	auto color = graph.CreateTexture("Color", RG::TextureDesc{ 256, 256, 28 });
+	auto unused = graph.CreateTexture("Unused", RG::TextureDesc{ 64, 64, 28 });
+	graph.AddPass("Culled", { { unused, RG::kUsageRenderTarget } }, kEmptyPass);
+	graph.AddPass("Shadow", { { shadow, RG::kUsageDepthWrite } }, kEmptyPass);
+	graph.AddPass("Scene", { { shadow, RG::kUsageShaderResource }, { color, RG::kUsageRenderTarget } }, kEmptyPass);
+	graph.AddPass("Post", { { color, RG::kUsageShaderResource }, { backBuffer, RG::kUsageRenderTarget } }, kEmptyPass);
+	graph.Compile(GetAllocationInfo);
+
+	// 寿命は残ったパスの番号で数える
+	const RG::Resource& shadowResource = graph.GetResource(shadow);
+	CHECK(shadowResource.firstPass == 0);
+	CHECK(shadowResource.lastPass == 1);
+	CHECK(shadowResource.usages == (RG::kUsageDepthWrite | RG::kUsageShaderResource));
+	CHECK(shadowResource.heapType == RG::kHeapTypeRenderTarget);
+	CHECK(shadowResource.initialUsage == RG::kUsageDepthWrite);
+	const RG::Resource& colorResource = graph.GetResource(color);
+	CHECK(colorResource.firstPass == 1);
+	CHECK(colorResource.lastPass == 2);
+	CHECK(graph.GetResource(backBuffer).firstPass == 2);
+	CHECK(!graph.GetResource(unused).IsUsed());
+}
+
+TEST_CASE(TransientsWithDisjointLifetimesShareMemory) {
+	RG graph;
+	RG::TextureDesc desc{ 256, 256, 28 };
+	auto backBuffer = graph.ImportTexture("BackBuffer", RG::kUsagePresent, RG::kUsagePresent);
+	// A -> B -> C -> D と一つ前だけを読むので、一つおきの寿命は重ならない
+	auto a = graph.CreateTexture("A", desc);
+	auto b = graph.CreateTexture("B", desc);
+	auto c = graph.CreateTexture("C", desc);
+	auto d = graph.CreateTexture("D", desc);
+	graph.AddPass("WriteA", { { a, RG::kUsageRenderTarget } }, kEmptyPass);
+	graph.AddPass("WriteB", { { a, RG::kUsageShaderResource }, { b, RG::kUsageRenderTarget } }, kEmptyPass);
+	graph.AddPass("WriteC", { { b, RG::kUsageShaderResource }, { c, RG::kUsageRenderTarget } }, kEmptyPass);
+	graph.AddPass("WriteD", { { c, RG::kUsageShaderResource }, { d, RG::kUsageRenderTarget } }, kEmptyPass);
+	graph.AddPass("Present", { { d, RG::kUsageShaderResource }, { backBuffer, RG::kUsageRenderTarget } }, kEmptyPass);
+	graph.Compile(GetAllocationInfo);
+
+	uint64_t size = GetAllocationInfo(desc, 0).size;
+	CHECK(HasNoOverlappingLiveMemory(graph));
+	// 同時に生きるのは二つまでなので二つ分で足りる
+	CHECK(graph.GetHeapSize(RG::kHeapTypeRenderTarget) == size * 2);
+	CHECK(graph.GetReport().unaliasedBytes == size * 4);
+	CHECK(graph.GetReport().GetSavedBytes() == size * 2);
+	CHECK(graph.GetResource(a).heapOffset == graph.GetResource(c).heapOffset);
+	CHECK(graph.GetResource(b).heapOffset == graph.GetResource(d).heapOffset);
+	for (auto handle : { a, b, c, d }) {
+		CHECK(graph.GetResource(handle).isAliased);
+	}
+
+	// 共有するリソースは最初に使うパスの前で切り替える
+	auto compiledPasses = graph.GetCompiledPasses();
+	auto writeC = graph.GetBarriers(compiledPasses[2]);
+	bool hasAliasing = false;
+	for (auto& barrier : writeC) {
+		hasAliasing |= barrier.type == RG::Barrier::kTypeAliasing && barrier.resource == c;
+	}
+	CHECK(hasAliasing);
+}
+
+TEST_CASE(RandomGraphsNeverOverlapLiveMemory) {
+	std::mt19937 random(17);
+	RG graph;
+	for (int trial = 0; trial < 200; trial++) {
+		graph.Reset();
+		auto output = graph.ImportTexture("Output", RG::kUsagePresent, RG::kUsagePresent);
+		std::vector<RG::ResourceHandle> textures;
+		int textureCount = std::uniform_int_distribution<int>(1, 12)(random);
+		for (int i = 0; i < textureCount; i++) {
+			uint32_t width = std::uniform_int_distribution<uint32_t>(1, 1024)(random);
+			uint32_t height = std::uniform_int_distribution<uint32_t>(1, 1024)(random);
+			textures.push_back(graph.CreateTexture("T" + std::to_string(i), RG::TextureDesc{ width, height, 28 }));
+		}
+		// 各パスは前に書かれたものを読み、新しいものに書く
+		std::uniform_int_distribution<int> pick(0, textureCount - 1);
+		std::vector<bool> isWritten(textureCount, false);
+		for (int pass = 0; pass < 16; pass++) {
+			int read = pick(random), write = pick(random);
+			if (read == write) {
+				continue;
+			}
+			if (isWritten[read]) {
+				graph.AddPass("P" + std::to_string(pass),
+					{ { textures[read], RG::kUsageShaderResource }, { textures[write], RG::kUsageRenderTarget } }, kEmptyPass);
+			}
+			else {
+				graph.AddPass("P" + std::to_string(pass), { { textures[write], RG::kUsageRenderTarget } }, kEmptyPass);
+			}
+			isWritten[write] = true;
+		}
+		graph.AddPass("Output", { { textures[pick(random)], RG::kUsageShaderResource }, { output, RG::kUsageRenderTarget } }, kEmptyPass);
+		graph.Compile(GetAllocationInfo);
+
+		CHECK(HasNoOverlappingLiveMemory(graph));
+		CHECK(graph.GetReport().heapBytes <= graph.GetReport().unaliasedBytes);
+		for (auto& resource : graph.GetResources()) {
+			if (!resource.isImported && resource.IsUsed()) {
+				CHECK(resource.heapOffset % resource.allocation.alignment == 0);
+				CHECK(resource.heapOffset + resource.allocation.size <= graph.GetHeapSize(resource.heapType));
+			}
+		}
+		// フレームの終わりには決めた使い方に戻っている
+		for (auto& barrier : graph.GetFinalBarriers()) {
+			CHECK(barrier.after == graph.GetResource(barrier.resource).finalUsage);
+		}
+	}
+}
+
+TEST_CASE(ReadsAreMergedIntoOneTransition) {
+	RG graph;
+	auto backBuffer = graph.ImportTexture("BackBuffer", RG::kUsagePresent, RG::kUsagePresent);
+	auto bloom = graph.ImportTexture("Bloom", RG::kUsageRenderTarget, RG::kUsageRenderTarget);
+	auto color = graph.CreateTexture("Color", RG::TextureDesc{ 256, 256, 28 });
+	graph.AddPass("Scene", { { color, RG::kUsageRenderTarget } }, kEmptyPass);
+	graph.AddPass("Bloom", { { color, RG::kUsageShaderResource }, { bloom, RG::kUsageRenderTarget } }, kEmptyPass);
+	graph.AddPass("Copy", { { color, RG::kUsageCopySource }, { backBuffer, RG::kUsageCopyDest } }, kEmptyPass);
+	graph.Compile(GetAllocationInfo);
+
+	auto compiledPasses = graph.GetCompiledPasses();
+	REQUIRE(compiledPasses.size() == 3);
+	// 読み込みが続くので Bloom の前の一回で SR と CopySource の両方にする
+	auto bloomBarriers = graph.GetBarriers(compiledPasses[1]);
+	REQUIRE(bloomBarriers.size() == 1);
+	CHECK(bloomBarriers[0].resource == color);
+	CHECK(bloomBarriers[0].before == RG::kUsageRenderTarget);
+	CHECK(bloomBarriers[0].after == (RG::kUsageShaderResource | RG::kUsageCopySource));
+	CHECK(!bloomBarriers[0].isSplit);
+	auto copyBarriers = graph.GetBarriers(compiledPasses[2]);
+	REQUIRE(copyBarriers.size() == 1);
+	CHECK(copyBarriers[0].resource == backBuffer);
+	CHECK(copyBarriers[0].after == RG::kUsageCopyDest);
+
+	// 最後にバックバッファを表示状態に、Color を生成時の使い方に戻す
+	auto finalBarriers = graph.GetFinalBarriers();
+	REQUIRE(finalBarriers.size() == 2);
+	CHECK(finalBarriers[0].resource == backBuffer);
+	CHECK(finalBarriers[0].after == RG::kUsagePresent);
+	CHECK(finalBarriers[1].resource == color);
+	CHECK(finalBarriers[1].after == RG::kUsageRenderTarget);
+	CHECK(graph.GetReport().barrierCount == 4);
+	// バックバッファの遷移は Scene の前に始めるので、全てのパスの前とフレームの最後にまとめる
+	CHECK(copyBarriers[0].isSplit);
+	CHECK(graph.GetReport().barrierBatchCount == 4);
+}
+
+TEST_CASE(TransitionsAcrossIdlePassesAreSplit) {
+	RG graph;
+	auto backBuffer = graph.ImportTexture("BackBuffer", RG::kUsagePresent, RG::kUsagePresent);
+	auto shadow = graph.CreateTexture("Shadow", RG::TextureDesc{ 512, 512, 40 });
+	auto color = graph.CreateTexture("Color", RG::TextureDesc{ 256, 256, 28 });
+	graph.AddPass("Shadow", { { shadow, RG::kUsageDepthWrite } }, kEmptyPass);
+	graph.AddPass("Sky", { { color, RG::kUsageRenderTarget } }, kEmptyPass);
+	graph.AddPass("Scene", { { shadow, RG::kUsageShaderResource }, { color, RG::kUsageRenderTarget }, { backBuffer, RG::kUsageCopyDest } }, kEmptyPass);
+	graph.Compile(GetAllocationInfo);
+
+	auto compiledPasses = graph.GetCompiledPasses();
+	REQUIRE(compiledPasses.size() == 3);
+	// Shadow の遷移は間の Sky の前に始めて、Scene の前で終える
+	auto skySplits = graph.GetSplitBarriers(compiledPasses[1]);
+	REQUIRE(skySplits.size() == 1);
+	CHECK(skySplits[0].resource == shadow);
+	CHECK(skySplits[0].before == RG::kUsageDepthWrite);
+	CHECK(skySplits[0].after == RG::kUsageShaderResource);
+	bool isShadowEnded = false;
+	for (auto& barrier : graph.GetBarriers(compiledPasses[2])) {
+		if (barrier.resource == shadow) {
+			isShadowEnded = barrier.isSplit && barrier.after == RG::kUsageShaderResource;
+		}
+		// 直前まで使っていなかったバックバッファも分割する(フレームの最初に始める)
+		if (barrier.resource == backBuffer) {
+			CHECK(barrier.isSplit);
+		}
+	}
+	CHECK(isShadowEnded);
+	CHECK(graph.GetSplitBarriers(compiledPasses[0]).size() == 1);
+	CHECK(graph.GetSplitBarriers(compiledPasses[0])[0].resource == backBuffer);
+	CHECK(graph.GetSplitBarriers(compiledPasses[2]).empty());
+	CHECK(graph.GetReport().splitBarrierCount == 2);
+}
+
+TEST_CASE(ConsecutiveUnorderedAccessGetsUavBarrier) {
+	RG graph;
+	auto output = graph.ImportTexture("Output", RG::kUsageShaderResource, RG::kUsageShaderResource);
+	graph.AddPass("A", { { output, RG::kUsageUnorderedAccess } }, kEmptyPass);
+	graph.AddPass("B", { { output, RG::kUsageUnorderedAccess } }, kEmptyPass);
+	graph.Compile(GetAllocationInfo);
+
+	auto compiledPasses = graph.GetCompiledPasses();
+	REQUIRE(compiledPasses.size() == 2);
+	REQUIRE(graph.GetBarriers(compiledPasses[0]).size() == 1);
+	CHECK(graph.GetBarriers(compiledPasses[0])[0].type == RG::Barrier::kTypeTransition);
+	REQUIRE(graph.GetBarriers(compiledPasses[1]).size() == 1);
+	CHECK(graph.GetBarriers(compiledPasses[1])[0].type == RG::Barrier::kTypeUnorderedAccess);
+	REQUIRE(graph.GetFinalBarriers().size() == 1);
+	CHECK(graph.GetFinalBarriers()[0].before == RG::kUsageUnorderedAccess);
+	CHECK(graph.GetFinalBarriers()[0].after == RG::kUsageShaderResource);
+}
@@ -0,0 +1,196 @@
+#include "TestFramework.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "RenderQueue.h"
+
+// ソートキーの作り方、基数ソートの並び、状態の切り替え回数を確かめる(記録はしない)
+
+namespace {
+	using SortItem = RenderQueue::SortItem;
+
+	/// <summary>
+	/// 基数ソートと std::stable_sort の結果が同じか
+	/// </summary>
+	bool MatchesStableSort(const std::vector<SortItem>& items) {
+		std::vector<SortItem> sorted = items;
+		std::vector<SortItem> buffer(items.size());
+		RenderQueue::RadixSort(sorted, buffer);
+		std::vector<SortItem> expected = items;
+		std::stable_sort(expected.begin(), expected.end(), [](const SortItem& a, const SortItem& b) { return a.key < b.key; });
+		for (size_t i = 0; i < items.size(); i++) {
+			if (sorted[i].key != expected[i].key || sorted[i].index != expected[i].index) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	uint64_t Field(uint64_t key, uint32_t shift, uint32_t bits) {
+		return (key >> shift) & ((uint64_t(1) << bits) - 1);
+	}
+
+	uint64_t DepthBits(float depth) {
+		return Field(RenderQueue::CreateKey(0, 0, 0, 0, depth, 0), RenderQueue::kDepthShift, RenderQueue::kDepthBits);
+	}
+
+	RenderQueue::Command MakeCommand(ID3D12RootSignature* rootSignature, ID3D12PipelineState* pipelineState, UINT textureHandle) {
+		RenderQueue::Command command;
+		command.rootSignature = rootSignature;
+		command.pipelineState = pipelineState;
+		command.textureHandle = textureHandle;
+		command.draw = [](TrackedCommandList*) {};
+		return command;
+	}
+}
+
+TEST_CASE(RadixSortMatchesStableSort) {
+	const size_t sizes[] = { 0, 1, 2, 7, 255, 256, 257, 1000, 4097 };
+	// 全ての桁がばらばら、重複が多い、一部の桁だけ違う(残りの桁は飛ばす)、全て同じ
+	const uint64_t masks[] = { ~uint64_t(0), 0x7, 0x00FF00000000FF00, 0xF000000000000000, 0 };
+	std::mt19937_64 random(1);
+	for (size_t size : sizes) {
+		for (uint64_t mask : masks) {
+			std::vector<SortItem> items(size);
+			for (size_t i = 0; i < size; i++) {
+				items[i] = SortItem{ random() & mask, static_cast<uint32_t>(i) };
+			}
+			bool isMatched = MatchesStableSort(items);
+			if (!isMatched) {
+				std::printf("  size %zu mask %016llx\n", size, static_cast<unsigned long long>(mask));
+			}
+			CHECK(isMatched);
+		}
+	}
+
+	// 並び済み、逆順
+	std::vector<SortItem> items(1000);
+	for (uint32_t i = 0; i < 1000; i++) {
+		items[i] = SortItem{ uint64_t(i) << 20, i };
+	}
+	CHECK(MatchesStableSort(items));
+	std::reverse(items.begin(), items.end());
+	CHECK(MatchesStableSort(items));
+}
+
+TEST_CASE(CreateKeyFieldsLandInTheirBits) {
+	constexpr uint32_t kLayerMax = (1u << RenderQueue::kLayerBits) - 1;
+	constexpr uint32_t kBlendModeMax = (1u << RenderQueue::kBlendModeBits) - 1;
+	constexpr uint32_t kPipelineMax = (1u << RenderQueue::kPipelineBits) - 1;
+	constexpr uint32_t kTextureMax = (1u << RenderQueue::kTextureBits) - 1;
+	constexpr uint32_t kMaterialMax = (1u << RenderQueue::kMaterialBits) - 1;
+	constexpr uint64_t kDepthMax = (uint64_t(1) << RenderQueue::kDepthBits) - 1;
+
+	// 一つずつ最大にして、他の範囲に漏れないか
+	CHECK(RenderQueue::CreateKey(kLayerMax, 0, 0, 0, 0.0f, 0) == uint64_t(kLayerMax) << RenderQueue::kLayerShift);
+	CHECK(RenderQueue::CreateKey(0, kBlendModeMax, 0, 0, 0.0f, 0) == uint64_t(kBlendModeMax) << RenderQueue::kBlendModeShift);
+	CHECK(RenderQueue::CreateKey(0, 0, kPipelineMax, 0, 0.0f, 0) == uint64_t(kPipelineMax) << RenderQueue::kPipelineShift);
+	CHECK(RenderQueue::CreateKey(0, 0, 0, kTextureMax, 0.0f, 0) == uint64_t(kTextureMax) << RenderQueue::kTextureShift);
+	CHECK(RenderQueue::CreateKey(0, 0, 0, 0, 1.0f, 0) == kDepthMax << RenderQueue::kDepthShift);
+	CHECK(RenderQueue::CreateKey(0, 0, 0, 0, 0.0f, kMaterialMax) == uint64_t(kMaterialMax) << RenderQueue::kMaterialShift);
+	CHECK(RenderQueue::CreateKey(kLayerMax, kBlendModeMax, kPipelineMax, kTextureMax, 1.0f, kMaterialMax) == ~uint64_t(0));
+
+	// 組み合わせても読み戻せる
+	std::mt19937 random(2);
+	for (int i = 0; i < 1000; i++) {
+		uint32_t layer = random() & kLayerMax;
+		uint32_t blendMode = random() & kBlendModeMax;
+		uint32_t pipeline = random() & kPipelineMax;
+		uint32_t texture = random() & kTextureMax;
+		uint32_t material = random() & kMaterialMax;
+		uint64_t key = RenderQueue::CreateKey(layer, blendMode, pipeline, texture, 0.5f, material);
+		CHECK(Field(key, RenderQueue::kLayerShift, RenderQueue::kLayerBits) == layer);
+		CHECK(Field(key, RenderQueue::kBlendModeShift, RenderQueue::kBlendModeBits) == blendMode);
+		CHECK(Field(key, RenderQueue::kPipelineShift, RenderQueue::kPipelineBits) == pipeline);
+		CHECK(Field(key, RenderQueue::kTextureShift, RenderQueue::kTextureBits) == texture);
+		CHECK(Field(key, RenderQueue::kMaterialShift, RenderQueue::kMaterialBits) == material);
+	}
+
+	// 上位の項目が先に効く
+	CHECK(RenderQueue::CreateKey(0, kBlendModeMax, kPipelineMax, kTextureMax, 1.0f, kMaterialMax) < RenderQueue::CreateKey(1, 0, 0, 0, 0.0f, 0));
+	CHECK(RenderQueue::CreateKey(0, 0, 1, 0, 0.0f, 0) < RenderQueue::CreateKey(0, 0, 2, 0, 0.0f, 0));
+	CHECK(RenderQueue::CreateKey(0, 0, 0, 0, 0.25f, 0) < RenderQueue::CreateKey(0, 0, 0, 0, 0.75f, 0));
+}
+
+TEST_CASE(DepthIsClampedAndNaNGoesToTheBack) {
+	constexpr uint64_t kDepthMax = (uint64_t(1) << RenderQueue::kDepthBits) - 1;
+	CHECK(DepthBits(0.0f) == 0);
+	CHECK(DepthBits(1.0f) == kDepthMax);
+	CHECK(DepthBits(-0.5f) == 0);
+	CHECK(DepthBits(-std::numeric_limits<float>::infinity()) == 0);
+	CHECK(DepthBits(2.0f) == kDepthMax);
+	CHECK(DepthBits(std::numeric_limits<float>::infinity()) == kDepthMax);
+	CHECK(DepthBits(std::numeric_limits<float>::quiet_NaN()) == kDepthMax);
+	CHECK(DepthBits(-std::numeric_limits<float>::quiet_NaN()) == kDepthMax);
+	// 深度の範囲からはみ出さない
+	uint64_t key = RenderQueue::CreateKey(0, 0, 0, 0, std::numeric_limits<float>::quiet_NaN(), 0);
+	CHECK(Field(key, RenderQueue::kTextureShift, RenderQueue::kTextureBits) == 0);
+	CHECK(Field(key, RenderQueue::kMaterialShift, RenderQueue::kMaterialBits) == 0);
+
+	// 奥ほど大きい
+	uint64_t previous = 0;
+	bool isMonotonic = true;
+	for (int i = 0; i <= 1000; i++) {
+		uint64_t bits = DepthBits(i / 1000.0f);
+		if (bits < previous) {
+			isMonotonic = false;
+		}
+		previous = bits;
+	}
+	CHECK(isMonotonic);
+}
+
+TEST_CASE(StateChangesAreCountedBeforeAndAfterSorting) {
+	ID3D12RootSignature rootSignatures[2];
+	ID3D12PipelineState pipelines[3];
+
+	// パイプラインとテクスチャを交互に追加すると毎回切り替わる
+	RenderQueue queue;
+	for (uint32_t i = 0; i < 8; i++) {
+		uint32_t pipeline = i % 2;
+		uint32_t texture = i % 4;
+		queue.Submit(RenderQueue::CreateKey(0, 0, pipeline, texture, 0.0f, 0), MakeCommand(&rootSignatures[0], &pipelines[pipeline], texture));
+	}
+	queue.Sort();
+	const RenderQueue::Statistics& statistics = queue.GetStatistics();
+	CHECK(statistics.commandCount == 8);
+	CHECK(statistics.unsortedPipelineChangeCount == 8);
+	CHECK(statistics.unsortedTextureChangeCount == 8);
+	// パイプラインごとに 0,0,2,2 と 1,1,3,3 に並ぶ
+	CHECK(statistics.pipelineChangeCount == 2);
+	CHECK(statistics.textureChangeCount == 4);
+	const uint32_t expectedOrder[] = { 0, 4, 2, 6, 1, 5, 3, 7 };
+	REQUIRE(queue.GetSortItems().size() == 8);
+	for (size_t i = 0; i < 8; i++) {
+		CHECK(queue.GetSortItems()[i].index == expectedOrder[i]);
+	}
+
+	// ルートシグネチャが変わると同じテクスチャもセットし直す。kNoTexture は数えない
+	queue.Clear();
+	CHECK(queue.GetCount() == 0);
+	queue.Submit(0, MakeCommand(&rootSignatures[0], &pipelines[0], 5));
+	queue.Submit(0, MakeCommand(&rootSignatures[1], &pipelines[1], 5));
+	queue.Submit(0, MakeCommand(&rootSignatures[1], &pipelines[2], 5));
+	queue.Submit(0, MakeCommand(&rootSignatures[1], &pipelines[2], RenderQueue::kNoTexture));
+	queue.Submit(0, MakeCommand(&rootSignatures[1], &pipelines[2], 5));
+	queue.Sort();
+	CHECK(queue.GetStatistics().commandCount == 5);
+	CHECK(queue.GetStatistics().unsortedPipelineChangeCount == 3);
+	CHECK(queue.GetStatistics().unsortedTextureChangeCount == 2);
+	// 同じキーは追加した順のまま
+	CHECK(queue.GetStatistics().pipelineChangeCount == 3);
+	CHECK(queue.GetStatistics().textureChangeCount == 2);
+	for (uint32_t i = 0; i < 5; i++) {
+		CHECK(queue.GetSortItems()[i].index == i);
+	}
+
+	// 空でも数えられる
+	queue.Clear();
+	queue.Sort();
+	CHECK(queue.GetStatistics().commandCount == 0);
+	CHECK(queue.GetStatistics().pipelineChangeCount == 0);
+}
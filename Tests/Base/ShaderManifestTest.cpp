@@ -0,0 +1,144 @@
+#include "TestFramework.h"
+
+#include <cctype>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ShaderLibrary.h"
+
+// マニフェストの読み込みと、ソースとの照合を確かめる
+// ファイルは名前と中身の表、ハッシュは SHA-256 の代わりに 64 文字の16進数を返す関数で置き換える
+
+namespace {
+	std::string FakeHash(const void* data, size_t size) {
+		size_t value = std::hash<std::string>()(std::string(static_cast<const char*>(data), size));
+		constexpr char kDigits[] = "0123456789ABCDEF";
+		std::string hash;
+		for (int i = 0; i < 64; i++) {
+			hash += kDigits[(value >> ((i % 16) * 4)) & 0xF];
+		}
+		return hash;
+	}
+
+	std::string HashText(const std::string& text) {
+		return FakeHash(text.data(), text.size());
+	}
+
+	/// <summary>
+	/// 名前と中身の表をファイルの代わりにする
+	/// </summary>
+	ShaderLibrary::ReadFunction MakeReader(const std::map<std::string, std::string>& files) {
+		return [&files](const std::string& filePath, std::vector<char>& data) {
+			auto it = files.find(filePath);
+			if (it == files.end()) {
+				return false;
+			}
+			data.assign(it->second.begin(), it->second.end());
+			return true;
+		};
+	}
+
+	bool Parse(const std::string& text, ShaderLibrary::Manifest& manifest, std::string& error) {
+		std::istringstream stream(text);
+		return ShaderLibrary::ParseManifest(stream, manifest, error);
+	}
+}
+
+TEST_CASE(ParseGoodManifest) {
+	const std::string sourceHash = HashText("float4 main() : SV_TARGET { return 1; }");
+	std::string lowerHash = HashText("blob");
+	for (char& c : lowerHash) {
+		c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+	}
+	// 先頭の BOM と CRLF、空行は読み飛ばし、ハッシュは大文字にそろえる
+	const std::string text =
+		"\xEF\xBB\xBFprofile Debug\r\n"
+		"\r\n"
+		"source ..\\Resources\\Shaders\\SpritePS.hlsl " + sourceHash + "\r\n"
+		"shader SpritePS " + lowerHash + "\r\n";
+	ShaderLibrary::Manifest manifest;
+	std::string error;
+	REQUIRE(Parse(text, manifest, error));
+	CHECK(error.empty());
+	CHECK(manifest.profile == "Debug");
+	REQUIRE(manifest.sources.size() == 1);
+	CHECK(manifest.sources[0].name == "..\\Resources\\Shaders\\SpritePS.hlsl");
+	CHECK(manifest.sources[0].hash == sourceHash);
+	REQUIRE(manifest.shaders.size() == 1);
+	CHECK(manifest.shaders[0].name == "SpritePS");
+	CHECK(manifest.shaders[0].hash == HashText("blob"));
+}
+
+TEST_CASE(MalformedManifestLinesAreRejected) {
+	const std::string hash = HashText("x");
+	const std::string inputs[] = {
+		"",
+		"source a.hlsl " + hash + "\n",
+		"profile\n",
+		"profile Debug\nsource a.hlsl\n",
+		"profile Debug\nshader\n",
+		"profile Debug\nvertex a " + hash + "\n",
+		"profile Debug\nshader a " + hash + " extra\n",
+		"profile Debug\nshader a " + hash.substr(1) + "\n",
+		"profile Debug\nshader a " + hash.substr(1) + "G\n",
+	};
+	for (const std::string& input : inputs) {
+		ShaderLibrary::Manifest manifest;
+		std::string error;
+		bool isParsed = Parse(input, manifest, error);
+		if (isParsed) {
+			std::printf("  accepted: %s\n", input.c_str());
+		}
+		CHECK(!isParsed);
+		CHECK(!error.empty());
+	}
+
+	// 何行目かを知らせる
+	ShaderLibrary::Manifest manifest;
+	std::string error;
+	CHECK(!Parse("profile Debug\nshader a " + hash + "\nshader b\n", manifest, error));
+	CHECK(error.starts_with("line 3"));
+}
+
+TEST_CASE(SourcesMatchingTheManifestPass) {
+	std::map<std::string, std::string> files = {
+		{ "Sprite.hlsli", "struct VSOutput { float4 svpos : SV_POSITION; };" },
+		{ "SpriteVS.hlsl", "#include \"Sprite.hlsli\"" },
+	};
+	ShaderLibrary::Manifest manifest;
+	std::string error;
+	REQUIRE(Parse(
+		"profile Release\n"
+		"source Sprite.hlsli " + HashText(files["Sprite.hlsli"]) + "\n"
+		"source SpriteVS.hlsl " + HashText(files["SpriteVS.hlsl"]) + "\n",
+		manifest, error));
+	CHECK(ShaderLibrary::VerifySources(manifest, MakeReader(files), FakeHash, error));
+	CHECK(error.empty());
+}
+
+TEST_CASE(SourceHashMismatchFails) {
+	std::map<std::string, std::string> files = {
+		{ "SpritePS.hlsl", "return 1;" },
+	};
+	ShaderLibrary::Manifest manifest;
+	std::string error;
+	REQUIRE(Parse("profile Debug\nsource SpritePS.hlsl " + HashText(files["SpritePS.hlsl"]) + "\n", manifest, error));
+
+	// コンパイルした後でソースを書き換えた
+	files["SpritePS.hlsl"] = "return 0;";
+	CHECK(!ShaderLibrary::VerifySources(manifest, MakeReader(files), FakeHash, error));
+	CHECK(error.find("SpritePS.hlsl has changed") != std::string::npos);
+}
+
+TEST_CASE(MissingSourceFails) {
+	std::map<std::string, std::string> files;
+	ShaderLibrary::Manifest manifest;
+	std::string error;
+	REQUIRE(Parse("profile Debug\nsource SpritePS.hlsl " + HashText("return 1;") + "\n", manifest, error));
+	// ソースが無いときは読み飛ばさずに失敗する
+	CHECK(!ShaderLibrary::VerifySources(manifest, MakeReader(files), FakeHash, error));
+	CHECK(error.find("SpritePS.hlsl is missing") != std::string::npos);
+}
@@ -0,0 +1,182 @@
+#include "TestFramework.h"
+
+#include <random>
+#include <vector>
+
+#include "SpriteBatchBuilder.h"
+#include "ThreadPool.h"
+
+// デバイスを使わずに SpriteBatchBuilder が作る描画の並び、頂点、インデックスを確かめる
+
+namespace {
+	constexpr size_t kSpriteCount = 10000;
+	constexpr uint32_t kTextureCount = 8;
+
+	SpriteDrawDesc CreateRandomSprite(std::mt19937& random) {
+		std::uniform_real_distribution<float> dist(-500.0f, 500.0f), unit(0.0f, 1.0f);
+		SpriteDrawDesc desc;
+		desc.position = Vector2(dist(random), dist(random));
+		desc.rotate = dist(random) * 0.01f;
+		desc.size = Vector2(dist(random), dist(random));
+		desc.anchorPoint = Vector2(unit(random), unit(random));
+		desc.isFlipX = random() % 2 != 0;
+		desc.isFlipY = random() % 2 != 0;
+		desc.uvBase = Vector2(unit(random), unit(random));
+		desc.uvSize = Vector2(unit(random), unit(random));
+		desc.color = Vector4(unit(random), unit(random), unit(random), unit(random));
+		desc.textureHandle = random() % kTextureCount;
+		return desc;
+	}
+
+	// Sprite と同じく行列で変換した四隅(左下、左上、右下、右上)
+	void GetReferenceCorners(const SpriteDrawDesc& desc, Vector2* corners) {
+		float left = -desc.anchorPoint.x * desc.size.x;
+		float right = (1.0f - desc.anchorPoint.x) * desc.size.x;
+		float top = -desc.anchorPoint.y * desc.size.y;
+		float bottom = (1.0f - desc.anchorPoint.y) * desc.size.y;
+		if (desc.isFlipX) { left = -left; right = -right; }
+		if (desc.isFlipY) { top = -top; bottom = -bottom; }
+		Matrix44 world = Matrix44::CreateRotationZ(desc.rotate) * Matrix44::CreateTranslation(Vector3(desc.position.x, desc.position.y, 0.0f));
+		const Vector3 locals[] = { Vector3(left, bottom, 0.0f), Vector3(left, top, 0.0f), Vector3(right, bottom, 0.0f), Vector3(right, top, 0.0f) };
+		for (int i = 0; i < 4; i++) {
+			Vector3 position = locals[i] * world;
+			corners[i] = Vector2(position.x, position.y);
+		}
+	}
+
+	struct ThreadPoolScope {
+		ThreadPoolScope() { ThreadPool::GetInstance()->Initalize(3); }
+		~ThreadPoolScope() { ThreadPool::GetInstance()->Finalize(); }
+	};
+}
+
+TEST_CASE(TenThousandSpritesInAFewDraws) {
+	std::mt19937 random(1);
+	SpriteBatchBuilder builder;
+	// テクスチャはばらばらでも、ブレンドモードが変わる 3 か所でしか描画を分けない
+	const uint32_t blendModes[] = { 1, 2, 1, 0 };
+	for (size_t i = 0; i < kSpriteCount; i++) {
+		SpriteDrawDesc desc = CreateRandomSprite(random);
+		desc.blendMode = blendModes[i * 4 / kSpriteCount];
+		builder.Add(desc);
+	}
+
+	std::span<const SpriteBatchBuilder::DrawRun> runs = builder.GetDrawRuns();
+	REQUIRE(runs.size() == 4);
+	uint32_t spriteOffset = 0;
+	for (size_t i = 0; i < runs.size(); i++) {
+		CHECK(runs[i].blendMode == blendModes[i]);
+		CHECK(runs[i].spriteOffset == spriteOffset);
+		CHECK(runs[i].spriteCount == kSpriteCount / 4);
+		spriteOffset += runs[i].spriteCount;
+	}
+	CHECK(builder.GetVertexCount() == kSpriteCount * 4);
+	CHECK(builder.GetIndexCount() == kSpriteCount * 6);
+
+	builder.Clear();
+	CHECK(builder.GetSpriteCount() == 0);
+	CHECK(builder.GetDrawRuns().empty());
+}
+
+TEST_CASE(BuildWritesTransformedQuads) {
+	std::mt19937 random(2);
+	SpriteBatchBuilder builder;
+	std::vector<SpriteDrawDesc> descs;
+	for (size_t i = 0; i < kSpriteCount; i++) {
+		descs.push_back(CreateRandomSprite(random));
+		builder.Add(descs.back());
+	}
+	std::vector<SpriteBatchBuilder::Vertex> vertices(builder.GetVertexCount());
+	std::vector<uint32_t> indices(builder.GetIndexCount());
+	builder.Build(vertices, indices);
+
+	size_t positionErrorCount = 0, attributeErrorCount = 0, indexErrorCount = 0;
+	for (size_t i = 0; i < kSpriteCount; i++) {
+		const SpriteDrawDesc& desc = descs[i];
+		const SpriteBatchBuilder::Vertex* quad = vertices.data() + i * 4;
+		Vector2 corners[4];
+		GetReferenceCorners(desc, corners);
+		const Vector2 uvs[] = {
+			Vector2(desc.uvBase.x, desc.uvBase.y + desc.uvSize.y), desc.uvBase,
+			desc.uvBase + desc.uvSize, Vector2(desc.uvBase.x + desc.uvSize.x, desc.uvBase.y) };
+		for (int j = 0; j < 4; j++) {
+			positionErrorCount += std::fabs(quad[j].position.x - corners[j].x) > 1e-2f || std::fabs(quad[j].position.y - corners[j].y) > 1e-2f;
+			attributeErrorCount += quad[j].uv != uvs[j] || quad[j].color != desc.color || quad[j].textureIndex != desc.textureHandle;
+		}
+		// 二枚の三角形は (0, 1, 2) と (2, 1, 3)
+		const uint32_t expected[] = { 0, 1, 2, 2, 1, 3 };
+		for (int j = 0; j < 6; j++) {
+			indexErrorCount += indices[i * 6 + j] != static_cast<uint32_t>(i * 4) + expected[j];
+		}
+	}
+	CHECK(positionErrorCount == 0);
+	CHECK(attributeErrorCount == 0);
+	CHECK(indexErrorCount == 0);
+}
+
+TEST_CASE(ParallelBuildMatchesSerial) {
+	std::mt19937 random(3);
+	SpriteBatchBuilder builder;
+	for (size_t i = 0; i < kSpriteCount; i++) {
+		builder.Add(CreateRandomSprite(random));
+	}
+	std::vector<SpriteBatchBuilder::Vertex> serialVertices(builder.GetVertexCount()), parallelVertices(builder.GetVertexCount());
+	std::vector<uint32_t> serialIndices(builder.GetIndexCount()), parallelIndices(builder.GetIndexCount());
+	// ワーカーがいなければその場で処理される
+	builder.Build(serialVertices, serialIndices);
+	{
+		ThreadPoolScope threadPoolScope;
+		builder.Build(parallelVertices, parallelIndices);
+	}
+	CHECK(std::memcmp(serialVertices.data(), parallelVertices.data(), serialVertices.size() * sizeof(SpriteBatchBuilder::Vertex)) == 0);
+	CHECK(serialIndices == parallelIndices);
+}
+
+TEST_CASE(ExpandInstanceMatchesExpandQuad) {
+	std::mt19937 random(4);
+	size_t positionErrorCount = 0, uvErrorCount = 0, colorErrorCount = 0;
+	for (size_t i = 0; i < kSpriteCount; i++) {
+		SpriteDrawDesc desc = CreateRandomSprite(random);
+		SpriteBatchBuilder::Vertex quad[4];
+		SpriteBatchBuilder::ExpandQuad(desc, quad);
+		SpriteBatchBuilder::Instance instance = SpriteBatchBuilder::PackInstance(desc);
+		for (uint32_t vertexId = 0; vertexId < 4; vertexId++) {
+			SpriteBatchBuilder::Vertex vertex = SpriteBatchBuilder::ExpandInstance(instance, vertexId);
+			float scale = 1.0f + std::fabs(quad[vertexId].position.x) + std::fabs(quad[vertexId].position.y);
+			positionErrorCount += Distance(vertex.position, quad[vertexId].position) > scale * 1e-6f;
+			uvErrorCount += std::fabs(vertex.uv.x - quad[vertexId].uv.x) > 1e-6f || std::fabs(vertex.uv.y - quad[vertexId].uv.y) > 1e-6f;
+			// 色は 8bit に詰めるので半段階までずれる
+			for (size_t j = 0; j < 4; j++) {
+				colorErrorCount += std::fabs(vertex.color[j] - quad[vertexId].color[j]) > 0.5f / 255.0f + 1e-6f;
+			}
+			CHECK(vertex.textureIndex == desc.textureHandle);
+		}
+	}
+	CHECK(positionErrorCount == 0);
+	CHECK(uvErrorCount == 0);
+	CHECK(colorErrorCount == 0);
+}
+
+TEST_CASE(PackInstanceFoldsFlipIntoSize) {
+	SpriteDrawDesc desc;
+	desc.size = Vector2(30.0f, 40.0f);
+	desc.isFlipX = true;
+	desc.color = Vector4(1.0f, 0.0f, 0.5f, 2.0f);
+	SpriteBatchBuilder::Instance instance = SpriteBatchBuilder::PackInstance(desc);
+	CHECK(instance.size.x == -30.0f);
+	CHECK(instance.size.y == 40.0f);
+	// R が下位バイト、範囲外は丸める
+	CHECK(instance.color == 0xFF8000FFu);
+
+	std::vector<SpriteBatchBuilder::Instance> instances(3);
+	SpriteBatchBuilder builder;
+	for (int i = 0; i < 3; i++) {
+		desc.textureHandle = i;
+		builder.Add(desc);
+	}
+	builder.BuildInstances(instances);
+	for (uint32_t i = 0; i < 3; i++) {
+		CHECK(instances[i].textureIndex == i);
+		CHECK(std::memcmp(&instances[i].position, &instance.position, offsetof(SpriteBatchBuilder::Instance, textureIndex)) == 0);
+	}
+}
@@ -0,0 +1,255 @@
+#include "TestFramework.h"
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "TextureAtlas.h"
+
+// 詰め込みと余白の書き込み、位置の一覧の読み書きを確かめる(D3D に依存しない部分)
+
+namespace {
+	using Rect = MaxRectsPacker::Rect;
+
+	bool Intersects(const Rect& a, const Rect& b) {
+		return
+			a.x < b.x + b.width && b.x < a.x + a.width &&
+			a.y < b.y + b.height && b.y < a.y + a.height;
+	}
+
+	/// <summary>
+	/// 画素ごとに違う値を持つ画像(値は名前の番号と位置から決まる)
+	/// </summary>
+	struct TestImage {
+		std::vector<uint32_t> pixels;
+		TextureAtlasBuilder::Image image;
+
+		TestImage(uint32_t id, uint32_t width, uint32_t height) : pixels(static_cast<size_t>(width) * height) {
+			for (uint32_t y = 0; y < height; y++) {
+				for (uint32_t x = 0; x < width; x++) {
+					pixels[static_cast<size_t>(y) * width + x] = (id << 20) | (y << 10) | x;
+				}
+			}
+			image.name = "image" + std::to_string(id);
+			image.width = width;
+			image.height = height;
+			image.pixels = pixels.data();
+			image.rowPitch = width * sizeof(uint32_t);
+		}
+		uint32_t At(int32_t x, int32_t y) const {
+			return pixels[static_cast<size_t>(y) * image.width + x];
+		}
+	};
+
+	uint32_t PageAt(const TextureAtlasBuilder::Page& page, uint32_t x, uint32_t y) {
+		return page.pixels[static_cast<size_t>(y) * page.width + x];
+	}
+}
+
+TEST_CASE(PackerRandomInsertsNeverOverlap) {
+	for (uint32_t trial = 0; trial < 20; trial++) {
+		std::mt19937 random(trial);
+		MaxRectsPacker packer;
+		packer.Initalize(512, 256);
+		std::vector<Rect> rects;
+		uint64_t usedArea = 0;
+		uint32_t failCount = 0;
+		for (int i = 0; i < 300; i++) {
+			uint32_t width = 1 + random() % 64;
+			uint32_t height = 1 + random() % 64;
+			Rect rect;
+			if (!packer.Insert(width, height, rect)) {
+				failCount++;
+				continue;
+			}
+			CHECK(rect.width == width && rect.height == height);
+			CHECK(rect.x + rect.width <= 512 && rect.y + rect.height <= 256);
+			for (const Rect& other : rects) {
+				CHECK(!Intersects(rect, other));
+			}
+			rects.push_back(rect);
+			usedArea += static_cast<uint64_t>(width) * height;
+		}
+		// 300 個は入りきらない
+		CHECK(failCount > 0);
+		CHECK_NEAR(packer.GetOccupancy(), static_cast<double>(usedArea) / (512.0 * 256.0), 1e-6);
+		CHECK(packer.GetOccupancy() > 0.5f);
+	}
+
+	MaxRectsPacker packer;
+	packer.Initalize(64, 64);
+	Rect rect;
+	CHECK(!packer.Insert(0, 8, rect));
+	CHECK(!packer.Insert(65, 8, rect));
+	CHECK(packer.Insert(64, 64, rect));
+	CHECK(!packer.Insert(1, 1, rect));
+	CHECK(packer.GetOccupancy() == 1.0f);
+}
+
+TEST_CASE(GutterClampsEdgesAndCellsAreAligned) {
+	TextureAtlasBuilder::Options options;
+	options.pageWidth = 256;
+	options.pageHeight = 256;
+	options.padding = 2;
+	options.alignment = 8;
+	TextureAtlasBuilder builder;
+	builder.Initalize(options);
+
+	std::vector<TestImage> images;
+	for (uint32_t id = 0; id < 6; id++) {
+		images.emplace_back(id, 3 + id * 5, 17 - id * 2);
+	}
+	for (const TestImage& image : images) {
+		REQUIRE(builder.Add(image.image) != nullptr);
+	}
+	REQUIRE(builder.GetPages().size() == 1);
+	const TextureAtlasBuilder::Page& page = builder.GetPages()[0];
+	CHECK(page.isDirty);
+
+	const int32_t padding = static_cast<int32_t>(options.padding);
+	for (const TestImage& image : images) {
+		const TextureAtlasBuilder::Entry* entry = builder.Find(image.image.name);
+		REQUIRE(entry != nullptr);
+		CHECK(entry->page == 0);
+		CHECK(entry->rect.width == image.image.width && entry->rect.height == image.image.height);
+		// 余白を含めたセルの左上が配置境界にそろう
+		CHECK((entry->rect.x - options.padding) % options.alignment == 0);
+		CHECK((entry->rect.y - options.padding) % options.alignment == 0);
+
+		// 中身はそのまま、余白は一番近い端のピクセル
+		const int32_t width = static_cast<int32_t>(image.image.width);
+		const int32_t height = static_cast<int32_t>(image.image.height);
+		bool isMatched = true;
+		for (int32_t y = -padding; y < height + padding; y++) {
+			for (int32_t x = -padding; x < width + padding; x++) {
+				uint32_t expected = image.At(std::clamp(x, 0, width - 1), std::clamp(y, 0, height - 1));
+				if (PageAt(page, entry->rect.x + x, entry->rect.y + y) != expected) {
+					isMatched = false;
+				}
+			}
+		}
+		CHECK(isMatched);
+	}
+
+	// 同じ名前は追加済みの位置を返す
+	const TextureAtlasBuilder::Entry* entry = builder.Find(images[0].image.name);
+	CHECK(builder.Add(images[0].image) == entry);
+	builder.ClearDirty();
+	CHECK(!builder.GetPages()[0].isDirty);
+}
+
+TEST_CASE(OverflowSpillsOntoNewPage) {
+	TextureAtlasBuilder::Options options;
+	options.pageWidth = 64;
+	options.pageHeight = 64;
+	options.padding = 2;
+	options.alignment = 4;
+	TextureAtlasBuilder builder;
+	builder.Initalize(options);
+
+	// 余白込みで 32x32 のセルが一ページに 4 つ入る
+	std::vector<TestImage> images;
+	for (uint32_t id = 0; id < 6; id++) {
+		images.emplace_back(id, 28, 28);
+	}
+	for (uint32_t id = 0; id < 4; id++) {
+		REQUIRE(builder.Add(images[id].image) != nullptr);
+		CHECK(builder.Find(images[id].image.name)->page == 0);
+	}
+	builder.ClearDirty();
+	const TextureAtlasBuilder::Entry* spilled = builder.Add(images[4].image);
+	REQUIRE(spilled != nullptr);
+	CHECK(spilled->page == 1);
+	CHECK(builder.GetPages().size() == 2);
+	// 書き換えたページだけ印が付く
+	CHECK(!builder.GetPages()[0].isDirty);
+	CHECK(builder.GetPages()[1].isDirty);
+
+	// ページより大きい画像は置けない
+	TestImage tooLarge(9, 61, 8);
+	CHECK(builder.Add(tooLarge.image) == nullptr);
+	CHECK(builder.Find(tooLarge.image.name) == nullptr);
+
+	// まとめて追加しても、入らないものがあれば false
+	TextureAtlasBuilder batch;
+	batch.Initalize(options);
+	std::vector<TextureAtlasBuilder::Image> list;
+	for (const TestImage& image : images) {
+		list.push_back(image.image);
+	}
+	CHECK(batch.Add(list));
+	CHECK(batch.GetPages().size() == 2);
+	list.push_back(tooLarge.image);
+	CHECK(!batch.Add(list));
+}
+
+TEST_CASE(LookupRoundTrips) {
+	TextureAtlasBuilder::Options options;
+	options.pageWidth = 64;
+	options.pageHeight = 64;
+	TextureAtlasBuilder builder;
+	builder.Initalize(options);
+	std::vector<TestImage> images;
+	for (uint32_t id = 0; id < 8; id++) {
+		images.emplace_back(id, 20 + id, 24 - id);
+	}
+	// 名前に空白と引用符を含めても読み戻せる
+	images[3].image.name = "dir with space/\"quoted\".png";
+	for (const TestImage& image : images) {
+		REQUIRE(builder.Add(image.image) != nullptr);
+	}
+	std::vector<std::string> pageNames;
+	for (size_t i = 0; i < builder.GetPages().size(); i++) {
+		pageNames.push_back("page " + std::to_string(i) + ".png");
+	}
+	CHECK(pageNames.size() > 1);
+
+	std::stringstream stream;
+	builder.WriteLookup(stream, pageNames);
+	std::vector<std::string> readPageNames;
+	std::unordered_map<std::string, TextureAtlasBuilder::Entry> readEntries;
+	REQUIRE(TextureAtlasBuilder::ReadLookup(stream, readPageNames, readEntries));
+	CHECK(readPageNames == pageNames);
+	CHECK(readEntries.size() == builder.GetEntries().size());
+	for (auto& [name, entry] : builder.GetEntries()) {
+		auto it = readEntries.find(name);
+		REQUIRE(it != readEntries.end());
+		CHECK(it->second.page == entry.page);
+		CHECK(it->second.rect.x == entry.rect.x && it->second.rect.y == entry.rect.y);
+		CHECK(it->second.rect.width == entry.rect.width && it->second.rect.height == entry.rect.height);
+	}
+}
+
+TEST_CASE(MalformedLookupIsRejected) {
+	const char* inputs[] = {
+		"",
+		"atlas",
+		"atlas 2\n",
+		"atlus 1\n",
+		"atlas 1\npage\n",
+		"atlas 1\npage \"a.png\"\nentry \"x\" 0 1 2 3\n",
+		"atlas 1\npage \"a.png\"\nentry \"x\" 0 1 2 three 4\n",
+		"atlas 1\npage \"a.png\"\nentry \"x\" 1 0 0 4 4\n",
+		"atlas 1\nentry \"x\" 0 0 0 4 4\npage \"a.png\"\n",
+		"atlas 1\npage \"a.png\"\nsprite \"x\" 0 0 0 4 4\n",
+	};
+	for (const char* input : inputs) {
+		std::istringstream stream(input);
+		std::vector<std::string> pageNames;
+		std::unordered_map<std::string, TextureAtlasBuilder::Entry> entries;
+		bool isRead = TextureAtlasBuilder::ReadLookup(stream, pageNames, entries);
+		if (isRead) {
+			std::printf("  accepted: %s\n", input);
+		}
+		CHECK(!isRead);
+	}
+
+	// ページも画像も無い一覧は正しい
+	std::istringstream empty("atlas 1\n");
+	std::vector<std::string> pageNames;
+	std::unordered_map<std::string, TextureAtlasBuilder::Entry> entries;
+	CHECK(TextureAtlasBuilder::ReadLookup(empty, pageNames, entries));
+	CHECK(pageNames.empty() && entries.empty());
+}
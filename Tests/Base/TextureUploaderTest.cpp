@@ -0,0 +1,336 @@
+#include "TestFramework.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "TextureUploader.h"
+
+// コピーキューを、フェンスが完了したときにステージング領域から CPU でコピーする偽物に置き換える
+// 完了する前にステージング領域を上書きすると中身が壊れるので、ステージング領域の再利用の誤りも見つかる
+
+namespace {
+	/// <summary>
+	/// コピー先のテクスチャの代わり(サブリソースごとに行を詰めて持つ)
+	/// </summary>
+	struct FakeTexture {
+		std::vector<std::vector<uint8_t>> subresources;
+		std::vector<size_t> rowSizes;
+	};
+
+	/// <summary>
+	/// 送ったコピーをフェンスの完了で実行するコピーキュー
+	/// </summary>
+	class FakeCopyQueue : public CopyCommandQueue
+	{
+	public:
+		FakeCopyQueue(const uint8_t* staging, size_t stagingSize, std::map<ID3D12Resource*, FakeTexture>& textures) :
+			staging_(staging), stagingSize_(stagingSize), textures_(textures) {}
+
+		void CopyTextureRegion(ID3D12Resource* destination, uint32_t subresource, uint32_t destinationY,
+			uint64_t sourceOffset, const D3D12_SUBRESOURCE_FOOTPRINT& footprint) override {
+			if (sourceOffset % D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT != 0 ||
+				sourceOffset + static_cast<uint64_t>(footprint.RowPitch) * footprint.Height > stagingSize_) {
+				badCopyCount_++;
+			}
+			recorded_.push_back(Copy{ destination, subresource, destinationY, sourceOffset, footprint });
+		}
+		void Execute() override {
+			executed_.insert(executed_.end(), recorded_.begin(), recorded_.end());
+			recorded_.clear();
+			executeCount_++;
+		}
+		uint64_t Signal() override {
+			inFlight_.push_back(Batch{ ++signaledValue_, std::move(executed_) });
+			executed_.clear();
+			return signaledValue_;
+		}
+		uint64_t GetCompletedValue() override {
+			// 指定した確率で一つ先の束を終えておく
+			if (autoCompleteRate_ > 0.0 && !inFlight_.empty() && std::uniform_real_distribution<double>(0.0, 1.0)(random_) < autoCompleteRate_) {
+				Complete(inFlight_.front().fenceValue);
+			}
+			return completedValue_;
+		}
+		uint64_t Wait(uint64_t fenceValue) override {
+			waitCount_++;
+			Complete(fenceValue);
+			return completedValue_;
+		}
+
+		// フェンス値までの束のコピーを実行する
+		void Complete(uint64_t fenceValue) {
+			while (!inFlight_.empty() && inFlight_.front().fenceValue <= fenceValue) {
+				for (const Copy& copy : inFlight_.front().copies) {
+					FakeTexture& texture = textures_[copy.destination];
+					size_t rowSize = texture.rowSizes[copy.subresource];
+					uint8_t* destination = texture.subresources[copy.subresource].data();
+					for (uint32_t row = 0; row < copy.footprint.Height; row++) {
+						std::memcpy(destination + (copy.destinationY + row) * rowSize, staging_ + copy.sourceOffset + row * copy.footprint.RowPitch, rowSize);
+					}
+				}
+				copyCount_ += inFlight_.front().copies.size();
+				completedValue_ = inFlight_.front().fenceValue;
+				inFlight_.pop_front();
+			}
+		}
+		void SetAutoCompleteRate(double rate, uint32_t seed) {
+			autoCompleteRate_ = rate;
+			random_.seed(seed);
+		}
+
+		size_t GetRecordedCount() const { return recorded_.size(); }
+		size_t GetInFlightCount() const { return inFlight_.size(); }
+		size_t GetExecuteCount() const { return executeCount_; }
+		size_t GetCopyCount() const { return copyCount_; }
+		size_t GetWaitCount() const { return waitCount_; }
+		size_t GetBadCopyCount() const { return badCopyCount_; }
+
+	private:
+		struct Copy {
+			ID3D12Resource* destination;
+			uint32_t subresource;
+			uint32_t destinationY;
+			uint64_t sourceOffset;
+			D3D12_SUBRESOURCE_FOOTPRINT footprint;
+		};
+		struct Batch {
+			uint64_t fenceValue;
+			std::vector<Copy> copies;
+		};
+
+		const uint8_t* staging_;
+		size_t stagingSize_;
+		std::map<ID3D12Resource*, FakeTexture>& textures_;
+		std::vector<Copy> recorded_;
+		std::vector<Copy> executed_;
+		std::deque<Batch> inFlight_;
+		uint64_t signaledValue_ = 0;
+		uint64_t completedValue_ = 0;
+		double autoCompleteRate_ = 0.0;
+		std::mt19937 random_;
+		size_t executeCount_ = 0;
+		size_t copyCount_ = 0;
+		size_t waitCount_ = 0;
+		size_t badCopyCount_ = 0;
+	};
+
+	/// <summary>
+	/// 送る画素とコピー先を用意する
+	/// </summary>
+	class TextureSource
+	{
+	public:
+		// 幅と高さは 4 バイトの画素の数。元の行の間隔は詰めたものより sourcePadding だけ広くする
+		TextureSource(std::map<ID3D12Resource*, FakeTexture>& textures, ID3D12Resource* resource, uint32_t width, uint32_t height,
+			uint32_t mipLevels, size_t sourcePadding, std::mt19937& random) {
+			FakeTexture& texture = textures[resource];
+			for (uint32_t mip = 0; mip < mipLevels; mip++) {
+				uint32_t mipWidth = std::max(1u, width >> mip);
+				uint32_t mipHeight = std::max(1u, height >> mip);
+				size_t rowSize = mipWidth * 4;
+				size_t sourcePitch = rowSize + sourcePadding;
+				pixels_.emplace_back(sourcePitch * mipHeight);
+				for (uint8_t& value : pixels_.back()) {
+					value = static_cast<uint8_t>(random());
+				}
+				texture.subresources.emplace_back(rowSize * mipHeight);
+				texture.rowSizes.push_back(rowSize);
+
+				TextureUploader::Subresource subresource;
+				subresource.data.RowPitch = static_cast<LONG_PTR>(sourcePitch);
+				subresource.layout.Footprint = { DXGI_FORMAT_R8G8B8A8_UNORM, mipWidth, mipHeight, 1,
+					static_cast<UINT>((rowSize + D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1) & ~size_t(D3D12_TEXTURE_DATA_PITCH_ALIGNMENT - 1)) };
+				subresource.numRows = mipHeight;
+				subresource.rowSize = rowSize;
+				subresources_.push_back(subresource);
+			}
+			for (size_t i = 0; i < subresources_.size(); i++) {
+				subresources_[i].data.pData = pixels_[i].data();
+			}
+		}
+
+		const std::vector<TextureUploader::Subresource>& GetSubresources() const { return subresources_; }
+		// コピー先に元の画素がそろっているか
+		bool Matches(const FakeTexture& texture) const {
+			for (size_t i = 0; i < subresources_.size(); i++) {
+				size_t rowSize = texture.rowSizes[i];
+				size_t sourcePitch = static_cast<size_t>(subresources_[i].data.RowPitch);
+				for (uint32_t row = 0; row < subresources_[i].numRows; row++) {
+					if (std::memcmp(texture.subresources[i].data() + row * rowSize, pixels_[i].data() + row * sourcePitch, rowSize) != 0) {
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+	private:
+		std::vector<std::vector<uint8_t>> pixels_;
+		std::vector<TextureUploader::Subresource> subresources_;
+	};
+}
+
+TEST_CASE(UploadsAreBatchedUntilSubmit) {
+	std::vector<uint8_t> staging(64 * 1024);
+	std::map<ID3D12Resource*, FakeTexture> textures;
+	FakeCopyQueue queue(staging.data(), staging.size(), textures);
+	TextureUploader uploader;
+	uploader.Initalize(&queue, staging.data(), staging.size());
+	std::mt19937 random(1);
+	ID3D12Resource resources[4];
+	std::vector<TextureSource> sources;
+	for (ID3D12Resource& resource : resources) {
+		sources.emplace_back(textures, &resource, 16, 16, 1, 0, random);
+	}
+
+	// Submit までのテクスチャは一つの束にまとまり、同じ番号になる
+	std::vector<TextureUploader::Ticket> tickets;
+	for (size_t i = 0; i < sources.size(); i++) {
+		tickets.push_back(uploader.Upload(&resources[i], sources[i].GetSubresources()));
+		CHECK(tickets.back() != TextureUploader::kReadyTicket);
+		CHECK(tickets.back() == tickets.front());
+		CHECK(!uploader.IsReady(tickets.back()));
+	}
+	CHECK(queue.GetRecordedCount() == 4);
+	CHECK(queue.GetExecuteCount() == 0);
+
+	uint64_t fenceValue = uploader.Submit();
+	CHECK(fenceValue == 1);
+	CHECK(queue.GetExecuteCount() == 1);
+	CHECK(uploader.GetLastFenceValue() == 1);
+	// 送っただけでは終わらない
+	CHECK(!uploader.IsReady(tickets.front()));
+	queue.Complete(fenceValue);
+	CHECK(uploader.IsReady(tickets.front()));
+	for (size_t i = 0; i < sources.size(); i++) {
+		CHECK(sources[i].Matches(textures[&resources[i]]));
+	}
+
+	// 積んでいるものが無ければ送らない
+	CHECK(uploader.Submit() == 0);
+	CHECK(queue.GetExecuteCount() == 1);
+	CHECK(uploader.Upload(&resources[0], {}) == TextureUploader::kReadyTicket);
+	CHECK(uploader.IsReady(TextureUploader::kReadyTicket));
+
+	TextureUploader::Statistics statistics = uploader.GetStatistics();
+	CHECK(statistics.textureCount == 4);
+	CHECK(statistics.copyCount == 4);
+	CHECK(statistics.submitCount == 1);
+	CHECK(queue.GetBadCopyCount() == 0);
+}
+
+TEST_CASE(TicketsRetireInFenceOrder) {
+	std::vector<uint8_t> staging(64 * 1024);
+	std::map<ID3D12Resource*, FakeTexture> textures;
+	FakeCopyQueue queue(staging.data(), staging.size(), textures);
+	TextureUploader uploader;
+	uploader.Initalize(&queue, staging.data(), staging.size());
+	std::mt19937 random(2);
+	ID3D12Resource resources[4];
+	std::vector<TextureSource> sources;
+	std::vector<TextureUploader::Ticket> tickets;
+	std::vector<uint64_t> fenceValues;
+	for (size_t i = 0; i < 3; i++) {
+		sources.emplace_back(textures, &resources[i], 8, 8, 1, 0, random);
+		tickets.push_back(uploader.Upload(&resources[i], sources[i].GetSubresources()));
+		fenceValues.push_back(uploader.Submit());
+	}
+	CHECK(tickets[0] < tickets[1] && tickets[1] < tickets[2]);
+	CHECK(queue.GetInFlightCount() == 3);
+
+	// 終えたフェンスまでの番号だけが完了になる
+	queue.Complete(fenceValues[1]);
+	CHECK(uploader.IsReady(tickets[0]));
+	CHECK(uploader.IsReady(tickets[1]));
+	CHECK(!uploader.IsReady(tickets[2]));
+	CHECK(sources[1].Matches(textures[&resources[1]]));
+
+	// 積んでいるだけの束は WaitIdle で送って待つ
+	sources.emplace_back(textures, &resources[3], 8, 8, 1, 0, random);
+	TextureUploader::Ticket last = uploader.Upload(&resources[3], sources[3].GetSubresources());
+	CHECK(last == tickets[2] + 1);
+	CHECK(!uploader.IsReady(last));
+	uploader.WaitIdle();
+	CHECK(uploader.IsReady(tickets[2]));
+	CHECK(uploader.IsReady(last));
+	CHECK(queue.GetInFlightCount() == 0);
+	for (size_t i = 0; i < sources.size(); i++) {
+		CHECK(sources[i].Matches(textures[&resources[i]]));
+	}
+}
+
+TEST_CASE(LargeSubresourcesAreSplitAcrossBatches) {
+	// 一行 1024 バイトで 64 行(64KB)を、半分の 4KB までしか詰められないステージング領域で送る
+	std::vector<uint8_t> staging(8 * 1024);
+	std::map<ID3D12Resource*, FakeTexture> textures;
+	FakeCopyQueue queue(staging.data(), staging.size(), textures);
+	TextureUploader uploader;
+	uploader.Initalize(&queue, staging.data(), staging.size());
+	std::mt19937 random(3);
+	ID3D12Resource resource;
+	TextureSource source(textures, &resource, 256, 64, 3, 32, random);
+
+	TextureUploader::Ticket ticket = uploader.Upload(&resource, source.GetSubresources());
+	CHECK(ticket != TextureUploader::kReadyTicket);
+	TextureUploader::Statistics statistics = uploader.GetStatistics();
+	CHECK(statistics.submitCount > 1);
+	CHECK(statistics.copyCount > 3);
+	CHECK(statistics.staging.stallCount > 0);
+	// 途中の束は送ってあるが、最後の束は Submit まで送らない
+	CHECK(!uploader.IsReady(ticket));
+	uploader.WaitIdle();
+	CHECK(uploader.IsReady(ticket));
+	CHECK(source.Matches(textures[&resource]));
+	CHECK(queue.GetCopyCount() == uploader.GetStatistics().copyCount);
+	CHECK(queue.GetBadCopyCount() == 0);
+}
+
+TEST_CASE(RandomUploadsArriveIntact) {
+	const size_t capacities[] = { 4 * 1024, 8 * 1024, 64 * 1024, 1024 * 1024 };
+	for (size_t capacity : capacities) {
+		std::vector<uint8_t> staging(capacity);
+		std::map<ID3D12Resource*, FakeTexture> textures;
+		FakeCopyQueue queue(staging.data(), staging.size(), textures);
+		queue.SetAutoCompleteRate(0.3, static_cast<uint32_t>(capacity));
+		TextureUploader uploader;
+		uploader.Initalize(&queue, staging.data(), staging.size());
+		std::mt19937 random(static_cast<uint32_t>(capacity));
+
+		std::vector<ID3D12Resource> resources(100);
+		std::vector<TextureSource> sources;
+		std::vector<TextureUploader::Ticket> tickets;
+		for (ID3D12Resource& resource : resources) {
+			// 一行がステージング領域の半分に入る大きさまで
+			uint32_t maxWidth = static_cast<uint32_t>(std::min<size_t>(300, (capacity / 2 - D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT) / 4));
+			uint32_t width = 1 + random() % maxWidth;
+			uint32_t height = 1 + random() % 300;
+			uint32_t mipLevels = 1 + random() % 4;
+			sources.emplace_back(textures, &resource, width, height, mipLevels, random() % 3 * 16, random);
+			TextureUploader::Ticket ticket = uploader.Upload(&resource, sources.back().GetSubresources());
+			// 途中まで積んで失敗したまま完了扱いにしない
+			CHECK(ticket != TextureUploader::kReadyTicket);
+			CHECK(tickets.empty() || ticket >= tickets.back());
+			tickets.push_back(ticket);
+			if (random() % 4 == 0) {
+				uploader.Submit();
+			}
+		}
+		uploader.WaitIdle();
+
+		size_t badCount = 0;
+		for (size_t i = 0; i < resources.size(); i++) {
+			if (!uploader.IsReady(tickets[i]) || !sources[i].Matches(textures[&resources[i]])) {
+				badCount++;
+			}
+		}
+		CHECK(badCount == 0);
+		CHECK(queue.GetBadCopyCount() == 0);
+		TextureUploader::Statistics statistics = uploader.GetStatistics();
+		CHECK(statistics.textureCount == resources.size());
+		CHECK(statistics.staging.usedBytes == 0);
+	}
+}
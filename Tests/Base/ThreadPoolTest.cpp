@@ -0,0 +1,155 @@
+#include "TestFramework.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ThreadPool.h"
+
+// ParallelFor が他のジョブを呼び出し元で実行しないことと、急がないジョブが後回しになることを確かめる
+
+namespace {
+	struct ThreadPoolScope {
+		explicit ThreadPoolScope(size_t workerCount) { ThreadPool::GetInstance()->Initalize(workerCount); }
+		~ThreadPoolScope() { ThreadPool::GetInstance()->Finalize(); }
+	};
+
+	/// <summary>
+	/// ワーカーを Release まで止めておくジョブ
+	/// </summary>
+	class WorkerBlocker
+	{
+	public:
+		void Enqueue() {
+			ThreadPool::GetInstance()->Enqueue([this]() {
+				std::unique_lock<std::mutex> lock(mutex_);
+				isStarted_ = true;
+				condition_.notify_all();
+				condition_.wait(lock, [this]() { return isReleased_; });
+				});
+			std::unique_lock<std::mutex> lock(mutex_);
+			condition_.wait(lock, [this]() { return isStarted_; });
+		}
+		void Release() {
+			std::lock_guard<std::mutex> lock(mutex_);
+			isReleased_ = true;
+			condition_.notify_all();
+		}
+
+	private:
+		std::mutex mutex_;
+		std::condition_variable condition_;
+		bool isStarted_ = false;
+		bool isReleased_ = false;
+	};
+
+	/// <summary>
+	/// 実行したジョブの名前とスレッドを順に記録する
+	/// </summary>
+	class JobLog
+	{
+	public:
+		std::function<void()> MakeJob(const std::string& name) {
+			return [this, name]() {
+				std::lock_guard<std::mutex> lock(mutex_);
+				entries_.push_back(Entry{ name, std::this_thread::get_id() });
+				};
+		}
+		struct Entry {
+			std::string name;
+			std::thread::id thread;
+		};
+		std::vector<Entry> GetEntries() {
+			std::lock_guard<std::mutex> lock(mutex_);
+			return entries_;
+		}
+
+	private:
+		std::mutex mutex_;
+		std::vector<Entry> entries_;
+	};
+}
+
+TEST_CASE(ParallelForDoesNotRunOtherJobsOnCaller) {
+	JobLog log;
+	{
+		ThreadPoolScope scope(1);
+		ThreadPool* threadPool = ThreadPool::GetInstance();
+		WorkerBlocker blocker;
+		blocker.Enqueue();
+		// パイプラインの作成のような重いジョブが積まれている
+		threadPool->EnqueueBackground(log.MakeJob("background"));
+		threadPool->Enqueue(log.MakeJob("other"));
+
+		// ワーカーが塞がっていても自分の範囲を全て処理して戻る
+		std::vector<std::thread::id> batchThreads;
+		std::mutex batchMutex;
+		size_t processedCount = 0;
+		threadPool->ParallelFor(100, 1, [&](size_t begin, size_t end) {
+			std::lock_guard<std::mutex> lock(batchMutex);
+			batchThreads.push_back(std::this_thread::get_id());
+			processedCount += end - begin;
+			});
+		CHECK(processedCount == 100);
+		CHECK(batchThreads.size() == 2);
+		for (auto& thread : batchThreads) {
+			CHECK(thread == std::this_thread::get_id());
+		}
+		// 積まれていたジョブには手を出さない
+		CHECK(log.GetEntries().empty());
+		blocker.Release();
+	}
+
+	// 終了時に全て実行し、急ぐジョブを先にする
+	auto entries = log.GetEntries();
+	REQUIRE(entries.size() == 2);
+	CHECK(entries[0].name == "other");
+	CHECK(entries[1].name == "background");
+	for (auto& entry : entries) {
+		CHECK(entry.thread != std::this_thread::get_id());
+	}
+}
+
+TEST_CASE(ParallelForCoversEveryIndexOnce) {
+	ThreadPoolScope scope(3);
+	ThreadPool* threadPool = ThreadPool::GetInstance();
+	for (size_t count : { size_t(1), size_t(7), size_t(1000), size_t(100003) }) {
+		std::vector<std::atomic<int>> visits(count);
+		threadPool->ParallelFor(count, 16, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				visits[i].fetch_add(1);
+			}
+			});
+		bool isEachOnce = true;
+		for (auto& visit : visits) {
+			isEachOnce &= visit.load() == 1;
+		}
+		CHECK(isEachOnce);
+	}
+
+	// ワーカーの中から呼んでも止まらない
+	std::atomic<size_t> total = 0;
+	threadPool->ParallelFor(8, 1, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			threadPool->ParallelFor(1000, 10, [&](size_t innerBegin, size_t innerEnd) {
+				total.fetch_add(innerEnd - innerBegin);
+				});
+		}
+		});
+	CHECK(total.load() == 8000);
+}
+
+TEST_CASE(JobsRunInlineWithoutWorkers) {
+	ThreadPoolScope scope(1);
+	ThreadPool::GetInstance()->Finalize();
+	// ワーカーがいなければその場で実行する
+	bool isRun = false, isBackgroundRun = false;
+	ThreadPool::GetInstance()->Enqueue([&]() { isRun = true; });
+	ThreadPool::GetInstance()->EnqueueBackground([&]() { isBackgroundRun = true; });
+	CHECK(isRun);
+	CHECK(isBackgroundRun);
+	CHECK(ThreadPool::GetInstance()->GetConcurrency() == 1);
+}
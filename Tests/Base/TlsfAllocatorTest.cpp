@@ -0,0 +1,247 @@
+#include "TestFramework.h"
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "TlsfAllocator.h"
+
+// 使用中の範囲を外側で覚えておき、確保と解放と詰め直しを繰り返しても重ならず、統計と合うかを確かめる
+
+namespace {
+	struct LiveBlock {
+		TlsfAllocator::Allocation allocation;
+		uint64_t alignment = TlsfAllocator::kMinBlockSize;
+		uint32_t id = 0;
+	};
+
+	/// <summary>
+	/// 使用中の範囲が重ならず、揃えと統計が合っているか
+	/// </summary>
+	bool IsConsistent(const TlsfAllocator& allocator, const std::map<uint64_t, LiveBlock>& live) {
+		uint64_t usedSize = 0;
+		uint64_t end = 0;
+		for (const auto& [offset, block] : live) {
+			const TlsfAllocator::Allocation& allocation = block.allocation;
+			if (offset < end || offset % block.alignment != 0 || offset + allocation.size > allocator.GetCapacity()) {
+				return false;
+			}
+			end = offset + allocation.size;
+			usedSize += allocation.size;
+		}
+		TlsfAllocator::Statistics statistics = allocator.GetStatistics();
+		return statistics.usedSize == usedSize &&
+			statistics.allocationCount == live.size() &&
+			statistics.freeSize == allocator.GetCapacity() - usedSize &&
+			statistics.largestFreeSize <= statistics.freeSize;
+	}
+}
+
+TEST_CASE(SplitAndMergeNeighbours) {
+	TlsfAllocator allocator;
+	allocator.Initalize(1 << 20);
+	TlsfAllocator::Allocation a = allocator.Allocate(1000);
+	TlsfAllocator::Allocation b = allocator.Allocate(4096);
+	TlsfAllocator::Allocation c = allocator.Allocate(256);
+	REQUIRE(a.IsValid() && b.IsValid() && c.IsValid());
+	// kMinBlockSize に切り上げて前から切り出す
+	CHECK(a.offset == 0);
+	CHECK(a.size == 1024);
+	CHECK(b.offset == 1024);
+	CHECK(c.offset == 1024 + 4096);
+	CHECK(allocator.GetStatistics().freeBlockCount == 1);
+
+	// 真ん中を解放すると穴が一つ増え、両隣を解放すると一つにまとまる
+	allocator.Free(b);
+	CHECK(!b.IsValid());
+	CHECK(allocator.GetStatistics().freeBlockCount == 2);
+	allocator.Free(a);
+	CHECK(allocator.GetStatistics().freeBlockCount == 2);
+	CHECK(allocator.GetStatistics().largestFreeSize == (1 << 20) - 1024 - 4096 - 256);
+	allocator.Free(c);
+	TlsfAllocator::Statistics statistics = allocator.GetStatistics();
+	CHECK(statistics.freeBlockCount == 1);
+	CHECK(statistics.usedSize == 0);
+	CHECK(statistics.largestFreeSize == allocator.GetCapacity());
+	CHECK(statistics.fragmentation == 0.0);
+}
+
+TEST_CASE(AlignmentSplitsOffThePadding) {
+	TlsfAllocator allocator;
+	allocator.Initalize(1 << 20);
+	TlsfAllocator::Allocation small = allocator.Allocate(256);
+	TlsfAllocator::Allocation aligned = allocator.Allocate(1000, 65536);
+	REQUIRE(aligned.IsValid());
+	CHECK(aligned.offset == 65536);
+	CHECK(aligned.size == 1024);
+	// 揃えで飛ばした前の部分は空きとして残り、次の確保で使える
+	CHECK(allocator.GetStatistics().freeBlockCount == 2);
+	TlsfAllocator::Allocation filler = allocator.Allocate(4096);
+	REQUIRE(filler.IsValid());
+	CHECK(filler.offset == 256);
+	allocator.Free(small);
+	allocator.Free(aligned);
+	allocator.Free(filler);
+	CHECK(allocator.GetStatistics().freeBlockCount == 1);
+}
+
+TEST_CASE(OutOfMemoryReturnsInvalid) {
+	TlsfAllocator allocator;
+	allocator.Initalize(64 * 1024);
+	CHECK(!allocator.Allocate(64 * 1024 + 256).IsValid());
+	TlsfAllocator::Allocation all = allocator.Allocate(64 * 1024);
+	REQUIRE(all.IsValid());
+	CHECK(!allocator.Allocate(256).IsValid());
+	allocator.Free(all);
+
+	// 空きの合計は足りても、続いた空きが無ければ失敗する
+	std::vector<TlsfAllocator::Allocation> allocations;
+	for (int i = 0; i < 16; i++) {
+		allocations.push_back(allocator.Allocate(4096));
+	}
+	for (int i = 0; i < 16; i += 2) {
+		allocator.Free(allocations[i]);
+	}
+	TlsfAllocator::Statistics statistics = allocator.GetStatistics();
+	CHECK(statistics.freeSize == 32 * 1024);
+	CHECK(statistics.largestFreeSize == 4096);
+	CHECK(!allocator.Allocate(8192).IsValid());
+	CHECK(allocator.Allocate(4096).IsValid());
+}
+
+TEST_CASE(RandomTraceNeverOverlaps) {
+	const uint64_t alignments[] = { 256, 512, 4096, 65536 };
+	for (uint32_t trial = 0; trial < 8; trial++) {
+		std::mt19937 random(trial);
+		TlsfAllocator allocator;
+		allocator.Initalize(16 * 1024 * 1024);
+		std::map<uint64_t, LiveBlock> live;
+		uint32_t nextId = 0;
+		uint32_t failCount = 0;
+		for (int step = 0; step < 20000; step++) {
+			if (live.empty() || random() % 100 < 55) {
+				// 小さいものを多めに、たまに大きいもの
+				uint64_t size = random() % 8 == 0 ? 1 + random() % (1024 * 1024) : 1 + random() % 16384;
+				uint64_t alignment = alignments[random() % 4];
+				LiveBlock block;
+				block.allocation = allocator.Allocate(size, alignment, reinterpret_cast<void*>(static_cast<uintptr_t>(nextId + 1)));
+				block.alignment = alignment;
+				block.id = nextId++;
+				if (!block.allocation.IsValid()) {
+					failCount++;
+					continue;
+				}
+				CHECK(block.allocation.size >= size);
+				CHECK(live.find(block.allocation.offset) == live.end());
+				live[block.allocation.offset] = block;
+			} else {
+				auto it = live.begin();
+				std::advance(it, random() % live.size());
+				allocator.Free(it->second.allocation);
+				live.erase(it);
+			}
+			if (step % 500 == 0) {
+				CHECK(IsConsistent(allocator, live));
+			}
+		}
+		CHECK(IsConsistent(allocator, live));
+		// 容量に対して確保が多すぎるので失敗も通る
+		CHECK(failCount > 0);
+
+		for (auto& [offset, block] : live) {
+			allocator.Free(block.allocation);
+		}
+		TlsfAllocator::Statistics statistics = allocator.GetStatistics();
+		CHECK(statistics.freeBlockCount == 1);
+		CHECK(statistics.usedSize == 0);
+		CHECK(statistics.largestFreeSize == allocator.GetCapacity());
+	}
+}
+
+TEST_CASE(DefragmentMovesToEarlierRanges) {
+	// 偶数番目を解放して穴だらけにしてから詰める
+	constexpr uint64_t kBlockSize = 16384;
+	TlsfAllocator allocator;
+	allocator.Initalize(64 * kBlockSize);
+	std::vector<uint8_t> memory(allocator.GetCapacity());
+	std::vector<TlsfAllocator::Allocation> allocations(64);
+	for (uint32_t i = 0; i < 64; i++) {
+		allocations[i] = allocator.Allocate(kBlockSize, TlsfAllocator::kMinBlockSize, reinterpret_cast<void*>(static_cast<uintptr_t>(i)));
+		std::memset(memory.data() + allocations[i].offset, static_cast<int>(i), kBlockSize);
+	}
+	for (uint32_t i = 0; i < 64; i += 2) {
+		allocator.Free(allocations[i]);
+	}
+	TlsfAllocator::Statistics before = allocator.GetStatistics();
+	CHECK(before.freeBlockCount == 32);
+	CHECK(before.fragmentation > 0.9);
+
+	uint32_t badMoveCount = 0;
+	uint32_t moveCount = allocator.Defragment(100, [&](const TlsfAllocator::Allocation& from, const TlsfAllocator::Allocation& to, void* userData) {
+		uint32_t i = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(userData));
+		if (allocations[i].block != from.block || to.offset >= from.offset || to.size != from.size) {
+			badMoveCount++;
+			return false;
+		}
+		// 呼び出し側が中身を移して元を解放する
+		std::memmove(memory.data() + to.offset, memory.data() + from.offset, from.size);
+		TlsfAllocator::Allocation old = allocations[i];
+		allocations[i] = to;
+		allocator.Free(old);
+		return true;
+	});
+	CHECK(badMoveCount == 0);
+	CHECK(moveCount > 0);
+
+	TlsfAllocator::Statistics after = allocator.GetStatistics();
+	CHECK(after.freeBlockCount == 1);
+	CHECK(after.fragmentation == 0.0);
+	CHECK(after.usedSize == before.usedSize);
+	std::map<uint64_t, LiveBlock> live;
+	for (uint32_t i = 1; i < 64; i += 2) {
+		live[allocations[i].offset] = LiveBlock{ allocations[i], TlsfAllocator::kMinBlockSize, i };
+		// 移した先に中身がそろっている
+		CHECK(memory[allocations[i].offset] == i);
+		CHECK(memory[allocations[i].offset + kBlockSize - 1] == i);
+	}
+	CHECK(IsConsistent(allocator, live));
+	CHECK(live.rbegin()->first + kBlockSize == 32 * kBlockSize);
+}
+
+TEST_CASE(DefragmentKeepsBlocksWhenMoveIsRefused) {
+	TlsfAllocator allocator;
+	allocator.Initalize(1 << 20);
+	TlsfAllocator::Allocation a = allocator.Allocate(4096);
+	TlsfAllocator::Allocation b = allocator.Allocate(4096);
+	allocator.Free(a);
+	uint64_t offset = b.offset;
+	// 移せなかったときは先に用意した範囲が返され、元はそのまま残る
+	uint32_t moveCount = allocator.Defragment(10, [](const TlsfAllocator::Allocation&, const TlsfAllocator::Allocation&, void*) { return false; });
+	CHECK(moveCount == 0);
+	CHECK(allocator.GetStatistics().allocationCount == 1);
+	CHECK(allocator.GetStatistics().usedSize == 4096);
+	CHECK(b.offset == offset);
+	TlsfAllocator::Allocation c = allocator.Allocate(4096);
+	CHECK(c.offset == 0);
+
+	// 移す数の上限を守る
+	allocator.Free(c);
+	std::vector<TlsfAllocator::Allocation> allocations;
+	for (int i = 0; i < 16; i++) {
+		allocations.push_back(allocator.Allocate(4096));
+	}
+	for (int i = 0; i < 16; i += 2) {
+		allocator.Free(allocations[i]);
+	}
+	std::vector<TlsfAllocator::Allocation> moved;
+	moveCount = allocator.Defragment(3, [&](const TlsfAllocator::Allocation& from, const TlsfAllocator::Allocation& to, void*) {
+		moved.push_back(to);
+		TlsfAllocator::Allocation old = from;
+		allocator.Free(old);
+		return true;
+	});
+	CHECK(moveCount == 3);
+	CHECK(moved.size() == 3);
+}
@@ -0,0 +1,202 @@
+#include "TestFramework.h"
+
+#include <string>
+#include <vector>
+
+#include "TrackedCommandList.h"
+
+// 記録するだけのコマンドリストに差し替えて、実際に発行されるコマンドの並びを確かめる
+
+namespace {
+	/// <summary>
+	/// 呼ばれたコマンドの名前と、発行されたバリアを記録するコマンドリスト
+	/// </summary>
+	class RecordingCommandList
+	{
+	public:
+		void SetPipelineState(ID3D12PipelineState*) { Record("pipeline"); }
+		void SetGraphicsRootSignature(ID3D12RootSignature*) { Record("rootSignature"); }
+		void SetDescriptorHeaps(UINT, ID3D12DescriptorHeap* const*) { Record("heaps"); }
+		void SetGraphicsRootDescriptorTable(UINT index, D3D12_GPU_DESCRIPTOR_HANDLE) { Record("table" + std::to_string(index)); }
+		void SetGraphicsRootConstantBufferView(UINT index, D3D12_GPU_VIRTUAL_ADDRESS) { Record("cbv" + std::to_string(index)); }
+		void SetGraphicsRootShaderResourceView(UINT index, D3D12_GPU_VIRTUAL_ADDRESS) { Record("srv" + std::to_string(index)); }
+		void SetGraphicsRoot32BitConstant(UINT index, UINT, UINT) { Record("constant" + std::to_string(index)); }
+		void IASetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY) { Record("topology"); }
+		void IASetVertexBuffers(UINT, UINT, const D3D12_VERTEX_BUFFER_VIEW*) { Record("vertexBuffers"); }
+		void IASetIndexBuffer(const D3D12_INDEX_BUFFER_VIEW*) { Record("indexBuffer"); }
+		void DrawInstanced(UINT, UINT, UINT, UINT) { Record("draw"); }
+		void DrawIndexedInstanced(UINT, UINT, UINT, INT, UINT) { Record("drawIndexed"); }
+		void Dispatch(UINT, UINT, UINT) { Record("dispatch"); }
+		void ResourceBarrier(UINT count, const D3D12_RESOURCE_BARRIER* barriers) {
+			Record("barrier" + std::to_string(count));
+			barriers_.insert(barriers_.end(), barriers, barriers + count);
+		}
+
+		// 記録を取り出して空にする
+		std::vector<std::string> TakeCommands() { return std::move(commands_); }
+		const std::vector<D3D12_RESOURCE_BARRIER>& GetBarriers() const { return barriers_; }
+
+	private:
+		void Record(std::string command) { commands_.push_back(std::move(command)); }
+
+		std::vector<std::string> commands_;
+		std::vector<D3D12_RESOURCE_BARRIER> barriers_;
+	};
+
+	using Commands = std::vector<std::string>;
+}
+
+TEST_CASE(RedundantStateIsFiltered) {
+	RecordingCommandList recorder;
+	BasicTrackedCommandList<RecordingCommandList> cmdList;
+	cmdList.BeginFrame(&recorder);
+
+	ID3D12PipelineState pipeline;
+	ID3D12RootSignature rootSignature;
+	ID3D12DescriptorHeap heap;
+	ID3D12DescriptorHeap* heaps[] = { &heap };
+	D3D12_VERTEX_BUFFER_VIEW vertexBuffer = { 0x1000, 64, 16 };
+	// 同じパイプラインとテクスチャで、定数と頂点だけが違う 100 回の描画
+	for (int i = 0; i < 100; i++) {
+		cmdList.SetPipelineState(&pipeline);
+		cmdList.SetGraphicsRootSignature(&rootSignature);
+		cmdList.SetDescriptorHeaps(1, heaps);
+		cmdList.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+		vertexBuffer.BufferLocation = 0x1000 + i * 64;
+		cmdList.IASetVertexBuffers(0, 1, &vertexBuffer);
+		cmdList.SetGraphicsRootConstantBufferView(0, 0x10000 + i * 256);
+		cmdList.SetGraphicsRootDescriptorTable(1, D3D12_GPU_DESCRIPTOR_HANDLE{ 77 });
+		cmdList.DrawInstanced(4, 1, 0, 0);
+	}
+
+	Commands commands = recorder.TakeCommands();
+	CHECK((Commands(commands.begin(), commands.begin() + 8) ==
+		Commands{ "pipeline", "rootSignature", "heaps", "topology", "vertexBuffers", "cbv0", "table1", "draw" }));
+	// 2 回目以降は変わった頂点と定数だけ
+	CHECK((Commands(commands.begin() + 8, commands.begin() + 11) == Commands{ "vertexBuffers", "cbv0", "draw" }));
+	CHECK(commands.size() == 8 + 99 * 3);
+
+	const auto& statistics = cmdList.GetStatistics();
+	CHECK(statistics.issuedCount == 5 + 100 * 2);
+	CHECK(statistics.filteredCount == 99 * 5);
+	CHECK(statistics.drawCount == 100);
+}
+
+TEST_CASE(RootSignatureAndHeapChangesInvalidateParameters) {
+	RecordingCommandList recorder;
+	BasicTrackedCommandList<RecordingCommandList> cmdList;
+	cmdList.BeginFrame(&recorder);
+
+	ID3D12RootSignature rootSignatures[2];
+	ID3D12DescriptorHeap heaps[2];
+	ID3D12DescriptorHeap* firstHeaps[] = { &heaps[0] };
+	ID3D12DescriptorHeap* secondHeaps[] = { &heaps[1] };
+	cmdList.SetGraphicsRootSignature(&rootSignatures[0]);
+	cmdList.SetDescriptorHeaps(1, firstHeaps);
+	cmdList.SetGraphicsRootConstantBufferView(0, 0x100);
+	cmdList.SetGraphicsRootDescriptorTable(1, D3D12_GPU_DESCRIPTOR_HANDLE{ 5 });
+	recorder.TakeCommands();
+
+	// ヒープが変わるとテーブルだけがやり直しになる
+	cmdList.SetDescriptorHeaps(1, secondHeaps);
+	cmdList.SetGraphicsRootConstantBufferView(0, 0x100);
+	cmdList.SetGraphicsRootDescriptorTable(1, D3D12_GPU_DESCRIPTOR_HANDLE{ 5 });
+	CHECK((recorder.TakeCommands() == Commands{ "heaps", "table1" }));
+
+	// ルートシグネチャが変わるとすべてやり直し
+	cmdList.SetGraphicsRootSignature(&rootSignatures[1]);
+	cmdList.SetGraphicsRootConstantBufferView(0, 0x100);
+	cmdList.SetGraphicsRootDescriptorTable(1, D3D12_GPU_DESCRIPTOR_HANDLE{ 5 });
+	CHECK((recorder.TakeCommands() == Commands{ "rootSignature", "cbv0", "table1" }));
+
+	// 同じ番号でも種類が変われば発行する
+	cmdList.SetGraphicsRootShaderResourceView(0, 0x100);
+	cmdList.SetGraphicsRoot32BitConstant(2, 7, 0);
+	cmdList.SetGraphicsRoot32BitConstant(2, 7, 0);
+	cmdList.SetGraphicsRoot32BitConstant(2, 8, 0);
+	CHECK((recorder.TakeCommands() == Commands{ "srv0", "constant2", "constant2" }));
+
+	// 覚えきれない番号は毎回発行する
+	UINT index = BasicTrackedCommandList<RecordingCommandList>::kMaxRootParameterCount;
+	cmdList.SetGraphicsRootConstantBufferView(index, 0x100);
+	cmdList.SetGraphicsRootConstantBufferView(index, 0x100);
+	CHECK(recorder.TakeCommands().size() == 2);
+
+	// 直接変えた後は Invalidate で忘れる
+	cmdList.Invalidate();
+	cmdList.SetGraphicsRootSignature(&rootSignatures[1]);
+	CHECK((recorder.TakeCommands() == Commands{ "rootSignature" }));
+}
+
+TEST_CASE(BuffersAndTopologyAreCompared) {
+	RecordingCommandList recorder;
+	BasicTrackedCommandList<RecordingCommandList> cmdList;
+	cmdList.BeginFrame(&recorder);
+
+	D3D12_VERTEX_BUFFER_VIEW vertexBuffers[2] = { { 0x1000, 64, 16 }, { 0x2000, 64, 32 } };
+	D3D12_INDEX_BUFFER_VIEW indexBuffer = { 0x3000, 12, 42 };
+	cmdList.IASetVertexBuffers(0, 2, vertexBuffers);
+	cmdList.IASetVertexBuffers(0, 2, vertexBuffers);
+	cmdList.IASetVertexBuffers(1, 1, &vertexBuffers[1]);
+	cmdList.IASetIndexBuffer(&indexBuffer);
+	cmdList.IASetIndexBuffer(&indexBuffer);
+	cmdList.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	cmdList.IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	CHECK((recorder.TakeCommands() == Commands{ "vertexBuffers", "indexBuffer", "topology" }));
+
+	// 外す場合と覚えきれないスロットは毎回発行する
+	cmdList.IASetVertexBuffers(0, 1, nullptr);
+	cmdList.IASetVertexBuffers(0, 2, vertexBuffers);
+	CHECK((recorder.TakeCommands() == Commands{ "vertexBuffers", "vertexBuffers" }));
+
+	// フレームが変わると忘れて統計を前のフレームに移す
+	cmdList.BeginFrame(&recorder);
+	cmdList.IASetIndexBuffer(&indexBuffer);
+	CHECK((recorder.TakeCommands() == Commands{ "indexBuffer" }));
+	CHECK(cmdList.GetLastFrameStatistics().issuedCount == 5);
+	CHECK(cmdList.GetLastFrameStatistics().filteredCount == 4);
+	CHECK(cmdList.GetStatistics().issuedCount == 1);
+}
+
+TEST_CASE(BarriersAreBatchedBeforeDraw) {
+	RecordingCommandList recorder;
+	BasicTrackedCommandList<RecordingCommandList> cmdList;
+	ID3D12Resource textures[3];
+	for (auto& texture : textures) {
+		cmdList.GetStateTracker()->Register(&texture, D3D12_RESOURCE_STATE_COPY_DEST);
+	}
+	cmdList.BeginFrame(&recorder);
+
+	for (auto& texture : textures) {
+		cmdList.TransitionResource(&texture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+	}
+	// 既にその状態なら何もしない
+	cmdList.TransitionResource(&textures[0], D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+	CHECK(recorder.TakeCommands().empty());
+	cmdList.DrawInstanced(3, 1, 0, 0);
+	// 描画の直前に一回の ResourceBarrier でまとめて発行する
+	CHECK((recorder.TakeCommands() == Commands{ "barrier3", "draw" }));
+	REQUIRE(recorder.GetBarriers().size() == 3);
+	for (size_t i = 0; i < 3; i++) {
+		const D3D12_RESOURCE_BARRIER& barrier = recorder.GetBarriers()[i];
+		CHECK(barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION);
+		CHECK(barrier.Transition.pResource == &textures[i]);
+		CHECK(barrier.Transition.StateBefore == D3D12_RESOURCE_STATE_COPY_DEST);
+		CHECK(barrier.Transition.StateAfter == D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+	}
+
+	// 分割バリアは始めた時点で BEGIN_ONLY、同じ遷移を要求した時点で END_ONLY を出す
+	cmdList.BeginTransitionResource(&textures[0], D3D12_RESOURCE_STATE_RENDER_TARGET);
+	cmdList.Dispatch(1, 1, 1);
+	cmdList.TransitionResource(&textures[0], D3D12_RESOURCE_STATE_RENDER_TARGET);
+	cmdList.DrawInstanced(3, 1, 0, 0);
+	CHECK((recorder.TakeCommands() == Commands{ "barrier1", "dispatch", "barrier1", "draw" }));
+	REQUIRE(recorder.GetBarriers().size() == 5);
+	CHECK(recorder.GetBarriers()[3].Flags == D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY);
+	CHECK(recorder.GetBarriers()[4].Flags == D3D12_RESOURCE_BARRIER_FLAG_END_ONLY);
+
+	cmdList.BeginFrame(&recorder);
+	CHECK(cmdList.GetLastFrameStatistics().drawCount == 3);
+	CHECK(cmdList.GetLastFrameStatistics().barrier.barrierCount == 5);
+	CHECK(cmdList.GetLastFrameStatistics().barrier.batchCount == 3);
+}
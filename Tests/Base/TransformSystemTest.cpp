@@ -0,0 +1,294 @@
+#include "TestFramework.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "ThreadPool.h"
+#include "TransformSystem.h"
+
+// 深さごとの並列更新が直列の更新と同じ結果になり、親子の行列の積とも合うかを確かめる
+// ハンドルの世代、子孫ごとの破棄、親の付け替えと並べなおし、変更の無いノードを飛ばすことも確かめる
+
+namespace {
+	// 深さごとに kParallelMinBatchSize * 2 以上のノードがあり、並列に処理される階層
+	constexpr size_t kNodeCount = 60000;
+
+	struct Node {
+		TransformHandle handle;
+		size_t parent;
+		Vector3 scale;
+		Quaternion rotate;
+		Vector3 position;
+	};
+
+	std::vector<Node> CreateNodes(uint32_t seed) {
+		std::mt19937 random(seed);
+		std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+		std::vector<Node> nodes(kNodeCount);
+		for (size_t i = 0; i < kNodeCount; i++) {
+			Node& node = nodes[i];
+			// 先頭の 100 個をルートにして、残りは前のノードのどれかにつなぐ
+			node.parent = i < 100 ? SIZE_MAX : random() % i;
+			node.scale = Vector3(1.0f + dist(random) * 0.1f, 1.0f + dist(random) * 0.1f, 1.0f + dist(random) * 0.1f);
+			node.rotate = Quaternion::CreateFromAngleAxis(dist(random), Vector3(dist(random), dist(random), dist(random)).Normalized());
+			node.position = Vector3(dist(random), dist(random), dist(random));
+		}
+		return nodes;
+	}
+
+	void Build(TransformSystem& system, std::vector<Node>& nodes) {
+		for (Node& node : nodes) {
+			node.handle = system.Create(node.parent == SIZE_MAX ? TransformHandle{} : nodes[node.parent].handle);
+			system.SetScale(node.handle, node.scale);
+			system.SetRotate(node.handle, node.rotate);
+			system.SetPosition(node.handle, node.position);
+		}
+	}
+
+	Matrix44 GetReferenceMatrix(const std::vector<Node>& nodes, size_t i) {
+		const Node& node = nodes[i];
+		Matrix44 local = Matrix44::CreateTRS(node.scale, node.rotate, node.position);
+		return node.parent == SIZE_MAX ? local : local * GetReferenceMatrix(nodes, node.parent);
+	}
+
+	bool IsSameMatrix(const Matrix44& a, const Matrix44& b) {
+		return std::memcmp(&a, &b, sizeof(Matrix44)) == 0;
+	}
+
+	float GetMaxError(const Matrix44& a, const Matrix44& b) {
+		float maxError = 0.0f;
+		for (int row = 0; row < 4; row++) {
+			for (int column = 0; column < 4; column++) {
+				maxError = std::max(maxError, std::fabs(a.m[row][column] - b.m[row][column]));
+			}
+		}
+		return maxError;
+	}
+
+	Matrix44 GetLocalMatrix(const TransformSystem& system, TransformHandle handle) {
+		return Matrix44::CreateTRS(system.GetScale(handle), system.GetRotate(handle), system.GetPosition(handle));
+	}
+
+	struct ThreadPoolScope {
+		ThreadPoolScope() { ThreadPool::GetInstance()->Initalize(3); }
+		~ThreadPoolScope() { ThreadPool::GetInstance()->Finalize(); }
+	};
+}
+
+TEST_CASE(ParallelUpdateMatchesSerial) {
+	ThreadPoolScope threadPoolScope;
+	std::vector<Node> serialNodes = CreateNodes(1), parallelNodes = serialNodes;
+	TransformSystem serial, parallel;
+	serial.SetConcurrency(1);
+	parallel.SetConcurrency(0);
+	Build(serial, serialNodes);
+	Build(parallel, parallelNodes);
+
+	std::mt19937 random(2);
+	for (int frame = 0; frame < 4; frame++) {
+		serial.UpdateMatrix();
+		parallel.UpdateMatrix();
+		size_t mismatchCount = 0, changedCount = 0;
+		for (size_t i = 0; i < kNodeCount; i++) {
+			mismatchCount += !IsSameMatrix(serial.GetWorldMatrix(serialNodes[i].handle), parallel.GetWorldMatrix(parallelNodes[i].handle));
+			mismatchCount += serial.IsChanged(serialNodes[i].handle) != parallel.IsChanged(parallelNodes[i].handle);
+			changedCount += parallel.IsChanged(parallelNodes[i].handle);
+		}
+		CHECK(mismatchCount == 0);
+		CHECK(changedCount > 0);
+
+		// 一部を動かして子孫だけが更新されるフレームを作る
+		for (int move = 0; move < 500; move++) {
+			size_t i = random() % kNodeCount;
+			Vector3 position(static_cast<float>(frame), 0.0f, static_cast<float>(move));
+			serial.SetPosition(serialNodes[i].handle, position);
+			parallel.SetPosition(parallelNodes[i].handle, position);
+		}
+	}
+}
+
+TEST_CASE(WorldMatrixIsProductOfAncestors) {
+	ThreadPoolScope threadPoolScope;
+	std::vector<Node> nodes = CreateNodes(3);
+	TransformSystem system;
+	system.SetConcurrency(0);
+	Build(system, nodes);
+	system.UpdateMatrix();
+
+	for (size_t i = 0; i < kNodeCount; i += 97) {
+		// 深い階層では誤差が積み重なる
+		CHECK_NEAR(GetMaxError(GetReferenceMatrix(nodes, i), system.GetWorldMatrix(nodes[i].handle)), 0.0f, 1e-2f);
+		// 親は必ず前に並ぶ
+		if (nodes[i].parent != SIZE_MAX) {
+			CHECK(system.GetDenseIndex(nodes[nodes[i].parent].handle) < system.GetDenseIndex(nodes[i].handle));
+		}
+	}
+}
+
+TEST_CASE(StaleHandlesAreRejected) {
+	TransformSystem system;
+	CHECK(!system.IsValid(TransformHandle{}));
+	TransformHandle a = system.Create();
+	CHECK(system.IsValid(a));
+	CHECK(!system.IsValid(TransformHandle{ a.index + 1, 0 }));
+	CHECK(!system.IsValid(TransformHandle{ a.index, a.generation + 1 }));
+
+	// 破棄したハンドルはすぐに無効になり、同じスロットを使っても世代が違う
+	system.Destroy(a);
+	CHECK(!system.IsValid(a));
+	TransformHandle b = system.Create();
+	CHECK(b.index == a.index);
+	CHECK(b.generation != a.generation);
+	CHECK(b != a);
+	CHECK(system.IsValid(b));
+	CHECK(!system.IsValid(a));
+	system.UpdateMatrix();
+	CHECK(system.GetCount() == 1);
+	CHECK(system.IsValid(b));
+	CHECK(!system.IsValid(a));
+
+	// Clear の後は全て無効
+	system.Clear();
+	CHECK(!system.IsValid(b));
+	CHECK(system.GetCount() == 0);
+	TransformHandle c = system.Create();
+	CHECK(system.IsValid(c));
+	CHECK(c != b);
+}
+
+TEST_CASE(DestroyRemovesDescendants) {
+	TransformSystem system;
+	TransformHandle root = system.Create();
+	TransformHandle child = system.Create(root);
+	TransformHandle grandChild = system.Create(child);
+	TransformHandle greatGrandChild = system.Create(grandChild);
+	TransformHandle sibling = system.Create(root);
+	TransformHandle siblingChild = system.Create(sibling);
+	system.SetPosition(root, Vector3(1.0f, 0.0f, 0.0f));
+	system.SetPosition(sibling, Vector3(0.0f, 2.0f, 0.0f));
+	system.SetPosition(siblingChild, Vector3(0.0f, 0.0f, 3.0f));
+	system.UpdateMatrix();
+	CHECK(system.GetCount() == 6);
+
+	system.Destroy(child);
+	CHECK(!system.IsValid(child));
+	// 子孫が無効になるのは次の更新から
+	CHECK(system.IsValid(grandChild));
+	CHECK(system.IsValid(greatGrandChild));
+	system.UpdateMatrix();
+	CHECK(!system.IsValid(grandChild));
+	CHECK(!system.IsValid(greatGrandChild));
+	CHECK(system.GetCount() == 3);
+
+	// 残ったノードは親子関係と行列を保つ
+	REQUIRE(system.IsValid(root) && system.IsValid(sibling) && system.IsValid(siblingChild));
+	CHECK(system.GetParent(sibling) == root);
+	CHECK(system.GetParent(siblingChild) == sibling);
+	CHECK(system.GetDenseIndex(root) < system.GetDenseIndex(sibling));
+	CHECK(system.GetDenseIndex(sibling) < system.GetDenseIndex(siblingChild));
+	Vector3 translation(system.GetWorldMatrix(siblingChild).m[3][0], system.GetWorldMatrix(siblingChild).m[3][1], system.GetWorldMatrix(siblingChild).m[3][2]);
+	CHECK_NEAR(translation.x, 1.0f, 1e-6f);
+	CHECK_NEAR(translation.y, 2.0f, 1e-6f);
+	CHECK_NEAR(translation.z, 3.0f, 1e-6f);
+
+	// 破棄されたノードのスロットを再利用しても元のハンドルは無効のまま
+	std::vector<TransformHandle> reused;
+	for (int i = 0; i < 3; i++) {
+		reused.push_back(system.Create(siblingChild));
+	}
+	CHECK(!system.IsValid(child));
+	CHECK(!system.IsValid(grandChild));
+	CHECK(!system.IsValid(greatGrandChild));
+	for (TransformHandle handle : reused) {
+		CHECK(system.IsValid(handle));
+		CHECK(system.GetParent(handle) == siblingChild);
+	}
+}
+
+TEST_CASE(SetParentReordersHierarchy) {
+	TransformSystem system;
+	TransformHandle a = system.Create();
+	TransformHandle aChild = system.Create(a);
+	TransformHandle b = system.Create();
+	// b より前にある a を b の子にすると、a と子孫は b の後ろに並べなおす
+	TransformHandle c = system.Create(b);
+	system.SetScale(a, Vector3(2.0f, 2.0f, 2.0f));
+	system.SetPosition(aChild, Vector3(1.0f, 0.0f, 0.0f));
+	system.SetRotate(b, Quaternion::CreateFromAngleAxis(0.5f, Vector3(0.0f, 0.0f, 1.0f)));
+	system.SetPosition(b, Vector3(0.0f, 5.0f, 0.0f));
+	system.SetPosition(c, Vector3(0.0f, 0.0f, 1.0f));
+	system.UpdateMatrix();
+	CHECK(system.GetDenseIndex(a) < system.GetDenseIndex(b));
+
+	system.SetParent(a, c);
+	CHECK(system.GetParent(a) == c);
+	system.UpdateMatrix();
+	CHECK(system.GetDenseIndex(b) < system.GetDenseIndex(c));
+	CHECK(system.GetDenseIndex(c) < system.GetDenseIndex(a));
+	CHECK(system.GetDenseIndex(a) < system.GetDenseIndex(aChild));
+	CHECK(system.GetParent(aChild) == a);
+	CHECK(system.IsChanged(a));
+	CHECK(system.IsChanged(aChild));
+	CHECK(!system.IsChanged(b));
+	CHECK(!system.IsChanged(c));
+	Matrix44 expectedA = GetLocalMatrix(system, a) * GetLocalMatrix(system, c) * GetLocalMatrix(system, b);
+	CHECK_NEAR(GetMaxError(system.GetWorldMatrix(a), expectedA), 0.0f, 1e-5f);
+	CHECK_NEAR(GetMaxError(system.GetWorldMatrix(aChild), GetLocalMatrix(system, aChild) * expectedA), 0.0f, 1e-5f);
+
+	// ルートに戻すとローカル行列そのもの
+	system.SetParent(a, TransformHandle{});
+	CHECK(system.GetParent(a).IsNull());
+	system.UpdateMatrix();
+	CHECK(system.GetDenseIndex(a) < system.GetDenseIndex(c));
+	CHECK_NEAR(GetMaxError(system.GetWorldMatrix(a), GetLocalMatrix(system, a)), 0.0f, 1e-6f);
+	CHECK_NEAR(GetMaxError(system.GetWorldMatrix(aChild), GetLocalMatrix(system, aChild) * GetLocalMatrix(system, a)), 0.0f, 1e-6f);
+
+	// 同じ親をセットしても何も変わらない
+	system.SetParent(aChild, a);
+	system.UpdateMatrix();
+	CHECK(!system.IsChanged(aChild));
+}
+
+TEST_CASE(CleanNodesAreSkipped) {
+	std::vector<Node> nodes = CreateNodes(4);
+	TransformSystem system;
+	Build(system, nodes);
+	system.UpdateMatrix();
+	std::vector<Matrix44> before(system.GetWorldMatrices().begin(), system.GetWorldMatrices().end());
+
+	// 何も変えなければどれも計算しない
+	system.UpdateMatrix();
+	size_t changedCount = 0;
+	for (const Node& node : nodes) {
+		changedCount += system.IsChanged(node.handle);
+	}
+	CHECK(changedCount == 0);
+
+	// 一つ動かすと、そのノードと子孫だけが変わる
+	const size_t moved = 150;
+	system.SetPosition(nodes[moved].handle, Vector3(9.0f, 9.0f, 9.0f));
+	nodes[moved].position = Vector3(9.0f, 9.0f, 9.0f);
+	system.UpdateMatrix();
+	size_t mismatchCount = 0;
+	changedCount = 0;
+	for (size_t i = 0; i < kNodeCount; i++) {
+		bool isDescendant = false;
+		for (size_t node = i; node != SIZE_MAX; node = nodes[node].parent) {
+			if (node == moved) {
+				isDescendant = true;
+				break;
+			}
+		}
+		bool isChanged = system.IsChanged(nodes[i].handle);
+		changedCount += isChanged;
+		mismatchCount += isChanged != isDescendant;
+		// 変わらなかったノードは前の結果のまま
+		if (!isDescendant) {
+			mismatchCount += !IsSameMatrix(system.GetWorldMatrix(nodes[i].handle), before[system.GetDenseIndex(nodes[i].handle)]);
+		}
+	}
+	CHECK(mismatchCount == 0);
+	CHECK(changedCount >= 1);
+	CHECK_NEAR(GetMaxError(system.GetWorldMatrix(nodes[moved].handle), GetReferenceMatrix(nodes, moved)), 0.0f, 1e-2f);
+}
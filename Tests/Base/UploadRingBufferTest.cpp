@@ -0,0 +1,203 @@
+#include "TestFramework.h"
+
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "UploadRingBuffer.h"
+
+// アップロードヒープの代わりに CPU メモリを渡し、GPU はフェンス値を進めるだけのシミュレーションで置き換える
+
+namespace {
+	constexpr uint64_t kGpuBase = 0x10000000;
+
+	/// <summary>
+	/// 送ったフレームを遅れて完了させる GPU の代わり
+	/// </summary>
+	class SimulatedGpu
+	{
+	public:
+		void Submit(uint64_t fenceValue) { inFlight_.push_back(fenceValue); }
+		// 最も古いフレームを一つ完了させる
+		void CompleteOldest() {
+			completedValue_ = inFlight_.front();
+			inFlight_.pop_front();
+		}
+		// フェンス値まで完了させる(UploadRingBuffer の待ち関数)
+		uint64_t Wait(uint64_t fenceValue) {
+			waitedValues_.push_back(fenceValue);
+			while (!inFlight_.empty() && inFlight_.front() <= fenceValue) {
+				CompleteOldest();
+			}
+			return completedValue_;
+		}
+		size_t GetInFlightCount() const { return inFlight_.size(); }
+		uint64_t GetCompletedValue() const { return completedValue_; }
+		const std::vector<uint64_t>& GetWaitedValues() const { return waitedValues_; }
+
+	private:
+		std::deque<uint64_t> inFlight_;
+		uint64_t completedValue_ = 0;
+		std::vector<uint64_t> waitedValues_;
+	};
+
+	size_t GetOffset(const std::vector<uint8_t>& memory, const UploadRingBuffer::Allocation& allocation) {
+		return static_cast<const uint8_t*>(allocation.cpuAddress) - memory.data();
+	}
+}
+
+TEST_CASE(AllocateAlignsAndCountsBytes) {
+	std::vector<uint8_t> memory(4096);
+	SimulatedGpu gpu;
+	UploadRingBuffer ring;
+	ring.Initalize(memory.data(), kGpuBase, memory.size(), [&](uint64_t value) { return gpu.Wait(value); });
+
+	UploadRingBuffer::Allocation first = ring.Allocate(10);
+	UploadRingBuffer::Allocation second = ring.Allocate(10);
+	UploadRingBuffer::Allocation third = ring.Allocate(3, 4);
+	CHECK(GetOffset(memory, first) == 0);
+	CHECK(GetOffset(memory, second) == 256);
+	CHECK(GetOffset(memory, third) == 268);
+	CHECK(second.gpuAddress == kGpuBase + 256);
+	CHECK(second.size == 10);
+	// 境界調整で飛ばした分も使用中に数える
+	CHECK(ring.GetStatistics().usedBytes == 271);
+	CHECK(ring.GetStatistics().allocationCount == 3);
+
+	int value = 12345;
+	UploadRingBuffer::Allocation pushed = ring.Push(value);
+	CHECK(GetOffset(memory, pushed) == 512);
+	CHECK(*static_cast<int*>(pushed.cpuAddress) == value);
+}
+
+TEST_CASE(ReleaseFreesFinishedFrames) {
+	std::vector<uint8_t> memory(4096);
+	SimulatedGpu gpu;
+	UploadRingBuffer ring;
+	ring.Initalize(memory.data(), kGpuBase, memory.size(), [&](uint64_t value) { return gpu.Wait(value); });
+
+	ring.Allocate(1000, 1);
+	ring.FinishFrame(1);
+	ring.Allocate(1000, 1);
+	ring.FinishFrame(2);
+	CHECK(ring.GetStatistics().usedBytes == 2000);
+	ring.Release(1);
+	CHECK(ring.GetStatistics().usedBytes == 1000);
+	ring.Release(2);
+	CHECK(ring.GetStatistics().usedBytes == 0);
+	CHECK(ring.GetStatistics().peakUsedBytes == 2000);
+	// 空になったら先頭から使う
+	CHECK(GetOffset(memory, ring.Allocate(16)) == 0);
+	CHECK(ring.GetStatistics().stallCount == 0);
+}
+
+TEST_CASE(WrapsToFrontWhenTailIsFree) {
+	std::vector<uint8_t> memory(4096);
+	SimulatedGpu gpu;
+	UploadRingBuffer ring;
+	ring.Initalize(memory.data(), kGpuBase, memory.size(), [&](uint64_t value) { return gpu.Wait(value); });
+
+	ring.Allocate(1500, 1);
+	ring.FinishFrame(1);
+	ring.Allocate(1500, 1);
+	ring.FinishFrame(2);
+	ring.Release(1);
+	// 末尾には 1096 バイトしか残っていないので先頭の空きに折り返す
+	UploadRingBuffer::Allocation wrapped = ring.Allocate(1200, 1);
+	CHECK(GetOffset(memory, wrapped) == 0);
+	CHECK(ring.GetStatistics().wrapCount == 1);
+	// 捨てた末尾も現在のフレームの使用量に含める
+	CHECK(ring.GetStatistics().usedBytes == 1500 + 1096 + 1200);
+	ring.FinishFrame(3);
+	ring.Release(3);
+	CHECK(ring.GetStatistics().usedBytes == 0);
+}
+
+TEST_CASE(StallsOnOldestFrameWhenFull) {
+	std::vector<uint8_t> memory(4096);
+	SimulatedGpu gpu;
+	UploadRingBuffer ring;
+	ring.Initalize(memory.data(), kGpuBase, memory.size(), [&](uint64_t value) { return gpu.Wait(value); });
+
+	for (uint64_t frame = 1; frame <= 4; frame++) {
+		ring.Allocate(1024, 1);
+		ring.FinishFrame(frame);
+		gpu.Submit(frame);
+	}
+	// 満杯なので最も古いフレームだけを待ち、空いた先頭に折り返す
+	UploadRingBuffer::Allocation allocation = ring.Allocate(512, 1);
+	CHECK(GetOffset(memory, allocation) == 0);
+	CHECK(ring.GetStatistics().stallCount == 1);
+	REQUIRE(gpu.GetWaitedValues().size() == 1);
+	CHECK(gpu.GetWaitedValues()[0] == 1);
+	CHECK(gpu.GetInFlightCount() == 3);
+	// 連続した空きが足りない間は次のフレームも待つ
+	ring.Allocate(1024, 1);
+	CHECK(ring.GetStatistics().stallCount == 2);
+	CHECK(gpu.GetWaitedValues().back() == 2);
+}
+
+TEST_CASE(RandomFramesNeverOverwriteInFlightData) {
+	std::vector<uint8_t> memory(64 * 1024);
+	SimulatedGpu gpu;
+	UploadRingBuffer ring;
+	ring.Initalize(memory.data(), kGpuBase, memory.size(), [&](uint64_t value) { return gpu.Wait(value); });
+
+	// GPU が読み終わっていない領域と書き込んだ値
+	struct Live {
+		size_t offset;
+		size_t size;
+		uint64_t fenceValue;
+		uint8_t pattern;
+	};
+	std::vector<Live> lives;
+	std::mt19937 random(7);
+	size_t overlapCount = 0, corruptCount = 0, misalignedCount = 0;
+	auto removeFinished = [&]() {
+		std::erase_if(lives, [&](const Live& live) { return live.fenceValue <= gpu.GetCompletedValue(); });
+		};
+
+	for (uint64_t frame = 1; frame <= 5000; frame++) {
+		int allocationCount = random() % 20;
+		for (int i = 0; i < allocationCount; i++) {
+			size_t size = random() % 4 == 0 ? random() % 8000 + 1 : random() % 300 + 1;
+			size_t alignment = size_t(1) << (random() % 9);
+			UploadRingBuffer::Allocation allocation = ring.Allocate(size, alignment);
+			// 待った場合は完了したフレームの領域が再利用される
+			removeFinished();
+			size_t offset = GetOffset(memory, allocation);
+			misalignedCount += offset % alignment != 0 || allocation.gpuAddress != kGpuBase + offset || offset + size > memory.size();
+			for (const Live& live : lives) {
+				overlapCount += offset < live.offset + live.size && live.offset < offset + size;
+			}
+			uint8_t pattern = static_cast<uint8_t>(random());
+			std::fill_n(static_cast<uint8_t*>(allocation.cpuAddress), size, pattern);
+			lives.push_back(Live{ offset, size, frame, pattern });
+		}
+		for (const Live& live : lives) {
+			corruptCount += std::any_of(memory.begin() + live.offset, memory.begin() + live.offset + live.size, [&](uint8_t value) { return value != live.pattern; });
+		}
+
+		ring.FinishFrame(frame);
+		gpu.Submit(frame);
+		// GPU は最大 3 フレーム遅れてまちまちに進む
+		while (gpu.GetInFlightCount() > 3 || (gpu.GetInFlightCount() > 0 && random() % 2)) {
+			gpu.CompleteOldest();
+		}
+		ring.Release(gpu.GetCompletedValue());
+		removeFinished();
+	}
+
+	const UploadRingBuffer::Statistics& statistics = ring.GetStatistics();
+	std::printf("  allocations %zu, wraps %zu, stalls %zu, peak %zu bytes\n",
+		statistics.allocationCount, statistics.wrapCount, statistics.stallCount, statistics.peakUsedBytes);
+	CHECK(overlapCount == 0);
+	CHECK(corruptCount == 0);
+	CHECK(misalignedCount == 0);
+	CHECK(statistics.peakUsedBytes <= memory.size());
+	// 折り返しと待ちの両方を通っている
+	CHECK(statistics.wrapCount > 0);
+	CHECK(statistics.stallCount > 0);
+	CHECK(statistics.stallCount == gpu.GetWaitedValues().size());
+}
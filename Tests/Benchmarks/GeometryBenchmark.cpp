@@ -0,0 +1,112 @@
+#include "TestFramework.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "Geometry.h"
+
+// IntersectsBatch と単体の Intersects を一つずつ呼んだ場合の速さを比べる
+//   GeometryBenchmark [要素数]
+
+namespace {
+	constexpr int kRepeatCount = 20;
+
+	struct Vector3Array {
+		std::vector<float> x, y, z;
+
+		explicit Vector3Array(size_t count) : x(count), y(count), z(count) {}
+		void Set(size_t i, const Vector3& v) { x[i] = v.x; y[i] = v.y; z[i] = v.z; }
+		Vector3 Get(size_t i) const { return Vector3(x[i], y[i], z[i]); }
+		ConstVector3SoA GetSoA() const { return ConstVector3SoA(x, y, z); }
+	};
+
+	// 最も速かった回の要素あたりのナノ秒
+	template<class FUNCTION>
+	double Measure(size_t count, FUNCTION function) {
+		double best = 1e30;
+		for (int repeat = 0; repeat < kRepeatCount; repeat++) {
+			Test::Stopwatch stopwatch;
+			size_t hitCount = function();
+			best = std::min(best, stopwatch.GetMilliseconds());
+			Test::DoNotOptimize(hitCount);
+		}
+		return best * 1e6 / static_cast<double>(count);
+	}
+
+	void Report(const char* name, double batch, double scalar) {
+		std::printf("%-16s %10.2f %10.2f %9.2fx\n", name, batch, scalar, scalar / batch);
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t count = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 100000;
+	std::mt19937 random(1);
+	auto get = [&](float min, float max) { return std::uniform_real_distribution<float>(min, max)(random); };
+	auto getVector3 = [&](float min, float max) { return Vector3(get(min, max), get(min, max), get(min, max)); };
+
+	Vector3Array centers(count), extents(count), v1(count), v2(count), axisX(count), axisY(count), axisZ(count);
+	std::vector<float> radii(count);
+	for (size_t i = 0; i < count; i++) {
+		centers.Set(i, Vector3(get(-60.0f, 60.0f), get(-60.0f, 60.0f), get(-30.0f, 120.0f)));
+		extents.Set(i, getVector3(0.1f, 5.0f));
+		radii[i] = get(0.1f, 5.0f);
+		v1.Set(i, centers.Get(i) + getVector3(-5.0f, 5.0f));
+		v2.Set(i, centers.Get(i) + getVector3(-5.0f, 5.0f));
+		Matrix44 rotation = Matrix44::CreateRotationFromQuaternion(Quaternion::CreateFromAngleAxis(get(0.0f, 6.0f), getVector3(-1.0f, 1.0f).Normalized()));
+		axisX.Set(i, rotation.GetXAxis());
+		axisY.Set(i, rotation.GetYAxis());
+		axisZ.Set(i, rotation.GetZAxis());
+	}
+	Matrix44 view = Matrix44::CreateView(Vector3(1.0f, 2.0f, -10.0f), Vector3::Zero, Vector3::UnitY);
+	Frustum frustum = Frustum::CreateFromMatrix(view * Matrix44::CreatePerspectiveProjection(Math::ToRadians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f));
+	Ray ray{ Vector3(0.0f, 0.0f, -50.0f), Vector3(0.1f, 0.05f, 1.0f) };
+	OBB obb = OBB::CreateFromAABB(AABB{ Vector3(-20.0f, -10.0f, -30.0f), Vector3(20.0f, 10.0f, 30.0f) }, Matrix44::CreateRotationFromQuaternion(Quaternion::CreateFromAngleAxis(0.5f, Vector3::UnitY)));
+
+	SphereSoA spheres{ centers.GetSoA(), radii };
+	AABBSoA aabbs{ centers.GetSoA(), extents.GetSoA() };
+	TriangleSoA triangles{ centers.GetSoA(), v1.GetSoA(), v2.GetSoA() };
+	OBBSoA obbs{ centers.GetSoA(), axisX.GetSoA(), axisY.GetSoA(), axisZ.GetSoA(), extents.GetSoA() };
+	std::vector<uint8_t> results(count);
+	std::vector<float> distances(count);
+
+	std::printf("%zu objects, SIMD width %zu\n", count, static_cast<size_t>(Math::SIMD::kWidthN));
+	std::printf("%-16s %10s %10s %10s\n", "ns/object", "batch", "scalar", "speedup");
+	Report("frustum-sphere",
+		Measure(count, [&]() { return Math::IntersectsBatch(frustum, spheres, results); }),
+		Measure(count, [&]() {
+			size_t hitCount = 0;
+			for (size_t i = 0; i < count; i++) { hitCount += Math::Intersects(frustum, Sphere{ centers.Get(i), radii[i] }); }
+			return hitCount; }));
+	Report("frustum-aabb",
+		Measure(count, [&]() { return Math::IntersectsBatch(frustum, aabbs, results); }),
+		Measure(count, [&]() {
+			size_t hitCount = 0;
+			for (size_t i = 0; i < count; i++) { hitCount += Math::Intersects(frustum, AABB::CreateFromCenterExtents(centers.Get(i), extents.Get(i))); }
+			return hitCount; }));
+	Report("ray-aabb",
+		Measure(count, [&]() { return Math::IntersectsBatch(ray, aabbs, distances); }),
+		Measure(count, [&]() {
+			size_t hitCount = 0;
+			float distance;
+			for (size_t i = 0; i < count; i++) { hitCount += Math::Intersects(ray, AABB::CreateFromCenterExtents(centers.Get(i), extents.Get(i)), distance); }
+			return hitCount; }));
+	Report("ray-triangle",
+		Measure(count, [&]() { return Math::IntersectsBatch(ray, triangles, distances); }),
+		Measure(count, [&]() {
+			size_t hitCount = 0;
+			float distance;
+			for (size_t i = 0; i < count; i++) { hitCount += Math::Intersects(ray, centers.Get(i), v1.Get(i), v2.Get(i), distance); }
+			return hitCount; }));
+	Report("obb-obb",
+		Measure(count, [&]() { return Math::IntersectsBatch(obb, obbs, results); }),
+		Measure(count, [&]() {
+			size_t hitCount = 0;
+			for (size_t i = 0; i < count; i++) {
+				OBB other{ centers.Get(i), { axisX.Get(i), axisY.Get(i), axisZ.Get(i) }, extents.Get(i) };
+				hitCount += Math::Intersects(obb, other);
+			}
+			return hitCount; }));
+	return 0;
+}
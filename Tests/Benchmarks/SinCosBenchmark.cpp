@@ -0,0 +1,72 @@
+#include "TestFramework.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "MathUtility.h"
+
+// SinCos と標準ライブラリの sinf, cosf の速さと誤差を比べる
+//   SinCosBenchmark [角度の数]
+// 誤差は倍精度の sin, cos との差の最大値(MathUtility.h に書いた値の確認用)
+
+namespace {
+	constexpr int kRepeatCount = 20;
+
+	struct Result {
+		double nanoseconds;
+		double maxError;
+	};
+
+	template<class FUNCTION>
+	Result Measure(const std::vector<float>& angles, std::vector<float>& sins, std::vector<float>& coss, FUNCTION function) {
+		double best = 1e30;
+		for (int repeat = 0; repeat < kRepeatCount; repeat++) {
+			Test::Stopwatch stopwatch;
+			function(angles.data(), sins.data(), coss.data(), angles.size());
+			best = std::min(best, stopwatch.GetMilliseconds());
+			Test::DoNotOptimize(sins);
+			Test::DoNotOptimize(coss);
+		}
+		double maxError = 0.0;
+		for (size_t i = 0; i < angles.size(); i++) {
+			maxError = std::max(maxError, std::fabs(sins[i] - std::sin(static_cast<double>(angles[i]))));
+			maxError = std::max(maxError, std::fabs(coss[i] - std::cos(static_cast<double>(angles[i]))));
+		}
+		return Result{ best * 1e6 / static_cast<double>(angles.size()), maxError };
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t count = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 1 << 20;
+	count = (count + 3) & ~size_t(3);
+	std::vector<float> angles(count), sins(count), coss(count);
+	for (size_t i = 0; i < count; i++) {
+		angles[i] = static_cast<float>(-100.0 + 200.0 * static_cast<double>(i) / static_cast<double>(count));
+	}
+
+	struct Entry {
+		const char* name;
+		Result result;
+	};
+	Entry entries[] = {
+		{ "sinf, cosf", Measure(angles, sins, coss, [](const float* a, float* s, float* c, size_t n) {
+			for (size_t i = 0; i < n; i++) { s[i] = std::sin(a[i]); c[i] = std::cos(a[i]); } }) },
+		{ "SinCos", Measure(angles, sins, coss, [](const float* a, float* s, float* c, size_t n) {
+			for (size_t i = 0; i < n; i++) { Math::SinCos(a[i], s[i], c[i]); } }) },
+		{ "SinCosEst", Measure(angles, sins, coss, [](const float* a, float* s, float* c, size_t n) {
+			for (size_t i = 0; i < n; i++) { Math::SinCosEst(a[i], s[i], c[i]); } }) },
+		{ "SinCos4", Measure(angles, sins, coss, [](const float* a, float* s, float* c, size_t n) {
+			for (size_t i = 0; i < n; i += 4) { Math::SIMD::SinCos4<true>(a + i, s + i, c + i); } }) },
+		{ "SinCos4 (Est)", Measure(angles, sins, coss, [](const float* a, float* s, float* c, size_t n) {
+			for (size_t i = 0; i < n; i += 4) { Math::SIMD::SinCos4<false>(a + i, s + i, c + i); } }) },
+	};
+
+	std::printf("%zu angles in [-100, 100]\n", count);
+	std::printf("%-16s %10s %10s %12s\n", "", "ns/angle", "speedup", "max error");
+	for (const Entry& entry : entries) {
+		std::printf("%-16s %10.2f %9.2fx %12.3g\n", entry.name, entry.result.nanoseconds,
+			entries[0].result.nanoseconds / entry.result.nanoseconds, entry.result.maxError);
+	}
+	return 0;
+}
@@ -0,0 +1,77 @@
+#include "TestFramework.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "ThreadPool.h"
+#include "TransformSystem.h"
+
+// TransformSystem::UpdateMatrix の並列数ごとの速さ
+//   TransformSystemBenchmark [最大並列数]
+// ノード数 10k, 100k, 1M のそれぞれで、すべて動かした場合と 1% だけ動かした場合を測る
+
+namespace {
+	constexpr int kRepeatCount = 10;
+
+	struct Scene {
+		TransformSystem system;
+		std::vector<TransformHandle> handles;
+	};
+
+	// 1/8 をルートにして、残りは前のノードのどれかにつなぐ
+	void Build(Scene& scene, size_t nodeCount) {
+		std::mt19937 random(1);
+		std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+		scene.handles.reserve(nodeCount);
+		for (size_t i = 0; i < nodeCount; i++) {
+			TransformHandle parent = i > 0 && random() % 8 ? scene.handles[random() % i] : TransformHandle{};
+			TransformHandle handle = scene.system.Create(parent);
+			scene.system.SetPosition(handle, Vector3(dist(random), dist(random), dist(random)));
+			scene.system.SetRotate(handle, Quaternion::CreateFromAngleAxis(dist(random), Vector3(dist(random), dist(random), dist(random)).Normalized()));
+			scene.handles.push_back(handle);
+		}
+		scene.system.UpdateMatrix();
+	}
+
+	// 最も速かった回のミリ秒
+	double Measure(Scene& scene, size_t step) {
+		double best = 1e30;
+		for (int repeat = 0; repeat < kRepeatCount; repeat++) {
+			for (size_t i = 0; i < scene.handles.size(); i += step) {
+				scene.system.SetPosition(scene.handles[i], scene.system.GetPosition(scene.handles[i]));
+			}
+			Test::Stopwatch stopwatch;
+			scene.system.UpdateMatrix();
+			best = std::min(best, stopwatch.GetMilliseconds());
+		}
+		return best;
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t maxConcurrency = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+	ThreadPool::GetInstance()->Initalize(maxConcurrency - 1);
+
+	std::printf("%10s %8s %12s %10s %12s\n", "nodes", "threads", "all (ms)", "speedup", "1% (ms)");
+	for (size_t nodeCount : { size_t(10000), size_t(100000), size_t(1000000) }) {
+		Scene scene;
+		Build(scene, nodeCount);
+		double serialMilliseconds = 0.0;
+		for (size_t concurrency = 1; concurrency <= maxConcurrency; concurrency++) {
+			scene.system.SetConcurrency(concurrency);
+			double all = Measure(scene, 1);
+			double few = Measure(scene, 100);
+			if (concurrency == 1) {
+				serialMilliseconds = all;
+			}
+			std::printf("%10zu %8zu %12.3f %9.2fx %12.3f\n", nodeCount, concurrency, all, serialMilliseconds / all, few);
+		}
+	}
+
+	ThreadPool::GetInstance()->Finalize();
+	return 0;
+}
@@ -0,0 +1,353 @@
+#pragma once
+#ifndef FAKES_D3D12_H_
+#define FAKES_D3D12_H_
+
+// テスト用の d3d12.h の代わり
+// エンジンのうちテストするコードが使う型と定数だけを同じ名前で定義する(値は本物と同じにしてある)
+// インターフェースは中身を持たない構造体で、テストはアドレスだけを使う
+
+#include <cstddef>
+#include <cstdint>
+
+typedef int INT;
+typedef unsigned int UINT;
+typedef uint64_t UINT64;
+typedef int BOOL;
+typedef long HRESULT;
+typedef size_t SIZE_T;
+typedef uint64_t D3D12_GPU_VIRTUAL_ADDRESS;
+
+#define S_OK ((HRESULT)0)
+#define E_FAIL ((HRESULT)0x80004005L)
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#define FAILED(hr) (((HRESULT)(hr)) < 0)
+
+struct ID3D12Resource {};
+struct ID3D12PipelineState {};
+struct ID3D12RootSignature {};
+struct ID3D12DescriptorHeap {};
+struct ID3D12GraphicsCommandList;
+
+struct D3D12_CPU_DESCRIPTOR_HANDLE { SIZE_T ptr; };
+struct D3D12_GPU_DESCRIPTOR_HANDLE { UINT64 ptr; };
+
+enum D3D12_PRIMITIVE_TOPOLOGY {
+	D3D_PRIMITIVE_TOPOLOGY_UNDEFINED = 0,
+	D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST = 4,
+	D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP = 5,
+};
+
+struct D3D12_VERTEX_BUFFER_VIEW {
+	D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
+	UINT SizeInBytes;
+	UINT StrideInBytes;
+};
+struct D3D12_INDEX_BUFFER_VIEW {
+	D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
+	UINT SizeInBytes;
+	UINT Format;
+};
+
+enum D3D12_RESOURCE_STATES : int {
+	D3D12_RESOURCE_STATE_COMMON = 0,
+	D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER = 0x1,
+	D3D12_RESOURCE_STATE_INDEX_BUFFER = 0x2,
+	D3D12_RESOURCE_STATE_RENDER_TARGET = 0x4,
+	D3D12_RESOURCE_STATE_UNORDERED_ACCESS = 0x8,
+	D3D12_RESOURCE_STATE_DEPTH_WRITE = 0x10,
+	D3D12_RESOURCE_STATE_DEPTH_READ = 0x20,
+	D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE = 0x40,
+	D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE = 0x80,
+	D3D12_RESOURCE_STATE_COPY_DEST = 0x400,
+	D3D12_RESOURCE_STATE_COPY_SOURCE = 0x800,
+	D3D12_RESOURCE_STATE_GENERIC_READ = 0xac3,
+	D3D12_RESOURCE_STATE_PRESENT = 0,
+};
+inline constexpr D3D12_RESOURCE_STATES operator|(D3D12_RESOURCE_STATES a, D3D12_RESOURCE_STATES b) {
+	return static_cast<D3D12_RESOURCE_STATES>(static_cast<int>(a) | static_cast<int>(b));
+}
+inline constexpr D3D12_RESOURCE_STATES operator&(D3D12_RESOURCE_STATES a, D3D12_RESOURCE_STATES b) {
+	return static_cast<D3D12_RESOURCE_STATES>(static_cast<int>(a) & static_cast<int>(b));
+}
+inline D3D12_RESOURCE_STATES& operator|=(D3D12_RESOURCE_STATES& a, D3D12_RESOURCE_STATES b) {
+	return a = a | b;
+}
+
+enum D3D12_RESOURCE_BARRIER_TYPE {
+	D3D12_RESOURCE_BARRIER_TYPE_TRANSITION = 0,
+	D3D12_RESOURCE_BARRIER_TYPE_ALIASING = 1,
+	D3D12_RESOURCE_BARRIER_TYPE_UAV = 2,
+};
+enum D3D12_RESOURCE_BARRIER_FLAGS {
+	D3D12_RESOURCE_BARRIER_FLAG_NONE = 0,
+	D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY = 0x1,
+	D3D12_RESOURCE_BARRIER_FLAG_END_ONLY = 0x2,
+};
+#define D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES 0xffffffff
+
+struct D3D12_RESOURCE_TRANSITION_BARRIER {
+	ID3D12Resource* pResource;
+	UINT Subresource;
+	D3D12_RESOURCE_STATES StateBefore;
+	D3D12_RESOURCE_STATES StateAfter;
+};
+struct D3D12_RESOURCE_ALIASING_BARRIER {
+	ID3D12Resource* pResourceBefore;
+	ID3D12Resource* pResourceAfter;
+};
+struct D3D12_RESOURCE_UAV_BARRIER {
+	ID3D12Resource* pResource;
+};
+struct D3D12_RESOURCE_BARRIER {
+	D3D12_RESOURCE_BARRIER_TYPE Type;
+	D3D12_RESOURCE_BARRIER_FLAGS Flags;
+	union {
+		D3D12_RESOURCE_TRANSITION_BARRIER Transition;
+		D3D12_RESOURCE_ALIASING_BARRIER Aliasing;
+		D3D12_RESOURCE_UAV_BARRIER UAV;
+	};
+};
+
+// ルートシグネチャとパイプラインの設定(列挙子はテストで使うものだけ)
+typedef float FLOAT;
+typedef uint8_t UINT8;
+typedef const char* LPCSTR;
+
+enum DXGI_FORMAT {
+	DXGI_FORMAT_UNKNOWN = 0,
+	DXGI_FORMAT_R32G32B32A32_FLOAT = 2,
+	DXGI_FORMAT_R32G32B32_FLOAT = 6,
+	DXGI_FORMAT_R32G32_FLOAT = 16,
+	DXGI_FORMAT_R8G8B8A8_UNORM = 28,
+	DXGI_FORMAT_R8G8B8A8_UNORM_SRGB = 29,
+	DXGI_FORMAT_D32_FLOAT = 40,
+};
+
+enum D3D12_ROOT_PARAMETER_TYPE {
+	D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE = 0,
+	D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS = 1,
+	D3D12_ROOT_PARAMETER_TYPE_CBV = 2,
+	D3D12_ROOT_PARAMETER_TYPE_SRV = 3,
+	D3D12_ROOT_PARAMETER_TYPE_UAV = 4,
+};
+enum D3D12_SHADER_VISIBILITY {
+	D3D12_SHADER_VISIBILITY_ALL = 0,
+	D3D12_SHADER_VISIBILITY_VERTEX = 1,
+	D3D12_SHADER_VISIBILITY_PIXEL = 5,
+};
+enum D3D12_DESCRIPTOR_RANGE_TYPE {
+	D3D12_DESCRIPTOR_RANGE_TYPE_SRV = 0,
+	D3D12_DESCRIPTOR_RANGE_TYPE_UAV = 1,
+	D3D12_DESCRIPTOR_RANGE_TYPE_CBV = 2,
+};
+enum D3D12_FILTER { D3D12_FILTER_MIN_MAG_MIP_POINT = 0, D3D12_FILTER_MIN_MAG_MIP_LINEAR = 0x15 };
+enum D3D12_TEXTURE_ADDRESS_MODE { D3D12_TEXTURE_ADDRESS_MODE_WRAP = 1, D3D12_TEXTURE_ADDRESS_MODE_CLAMP = 3 };
+enum D3D12_COMPARISON_FUNC { D3D12_COMPARISON_FUNC_NEVER = 1, D3D12_COMPARISON_FUNC_LESS = 2, D3D12_COMPARISON_FUNC_ALWAYS = 8 };
+enum D3D12_STATIC_BORDER_COLOR { D3D12_STATIC_BORDER_COLOR_TRANSPARENT_BLACK = 0 };
+enum D3D12_ROOT_SIGNATURE_FLAGS {
+	D3D12_ROOT_SIGNATURE_FLAG_NONE = 0,
+	D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT = 0x1,
+};
+
+struct D3D12_DESCRIPTOR_RANGE {
+	D3D12_DESCRIPTOR_RANGE_TYPE RangeType;
+	UINT NumDescriptors;
+	UINT BaseShaderRegister;
+	UINT RegisterSpace;
+	UINT OffsetInDescriptorsFromTableStart;
+};
+struct D3D12_ROOT_DESCRIPTOR_TABLE {
+	UINT NumDescriptorRanges;
+	const D3D12_DESCRIPTOR_RANGE* pDescriptorRanges;
+};
+struct D3D12_ROOT_CONSTANTS {
+	UINT ShaderRegister;
+	UINT RegisterSpace;
+	UINT Num32BitValues;
+};
+struct D3D12_ROOT_DESCRIPTOR {
+	UINT ShaderRegister;
+	UINT RegisterSpace;
+};
+struct D3D12_ROOT_PARAMETER {
+	D3D12_ROOT_PARAMETER_TYPE ParameterType;
+	union {
+		D3D12_ROOT_DESCRIPTOR_TABLE DescriptorTable;
+		D3D12_ROOT_CONSTANTS Constants;
+		D3D12_ROOT_DESCRIPTOR Descriptor;
+	};
+	D3D12_SHADER_VISIBILITY ShaderVisibility;
+};
+struct D3D12_STATIC_SAMPLER_DESC {
+	D3D12_FILTER Filter;
+	D3D12_TEXTURE_ADDRESS_MODE AddressU;
+	D3D12_TEXTURE_ADDRESS_MODE AddressV;
+	D3D12_TEXTURE_ADDRESS_MODE AddressW;
+	FLOAT MipLODBias;
+	UINT MaxAnisotropy;
+	D3D12_COMPARISON_FUNC ComparisonFunc;
+	D3D12_STATIC_BORDER_COLOR BorderColor;
+	FLOAT MinLOD;
+	FLOAT MaxLOD;
+	UINT ShaderRegister;
+	UINT RegisterSpace;
+	D3D12_SHADER_VISIBILITY ShaderVisibility;
+};
+struct D3D12_ROOT_SIGNATURE_DESC {
+	UINT NumParameters;
+	const D3D12_ROOT_PARAMETER* pParameters;
+	UINT NumStaticSamplers;
+	const D3D12_STATIC_SAMPLER_DESC* pStaticSamplers;
+	D3D12_ROOT_SIGNATURE_FLAGS Flags;
+};
+
+enum D3D12_BLEND { D3D12_BLEND_ZERO = 1, D3D12_BLEND_ONE = 2, D3D12_BLEND_SRC_ALPHA = 5, D3D12_BLEND_INV_SRC_ALPHA = 6 };
+enum D3D12_BLEND_OP { D3D12_BLEND_OP_ADD = 1 };
+enum D3D12_LOGIC_OP { D3D12_LOGIC_OP_CLEAR = 0, D3D12_LOGIC_OP_NOOP = 4 };
+enum D3D12_FILL_MODE { D3D12_FILL_MODE_WIREFRAME = 2, D3D12_FILL_MODE_SOLID = 3 };
+enum D3D12_CULL_MODE { D3D12_CULL_MODE_NONE = 1, D3D12_CULL_MODE_FRONT = 2, D3D12_CULL_MODE_BACK = 3 };
+enum D3D12_CONSERVATIVE_RASTERIZATION_MODE { D3D12_CONSERVATIVE_RASTERIZATION_MODE_OFF = 0 };
+enum D3D12_DEPTH_WRITE_MASK { D3D12_DEPTH_WRITE_MASK_ZERO = 0, D3D12_DEPTH_WRITE_MASK_ALL = 1 };
+enum D3D12_STENCIL_OP { D3D12_STENCIL_OP_KEEP = 1 };
+enum D3D12_INPUT_CLASSIFICATION {
+	D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA = 0,
+	D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA = 1,
+};
+enum D3D12_INDEX_BUFFER_STRIP_CUT_VALUE { D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_DISABLED = 0 };
+enum D3D12_PRIMITIVE_TOPOLOGY_TYPE { D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE = 3 };
+enum D3D12_PIPELINE_STATE_FLAGS { D3D12_PIPELINE_STATE_FLAG_NONE = 0 };
+
+struct D3D12_SHADER_BYTECODE {
+	const void* pShaderBytecode;
+	SIZE_T BytecodeLength;
+};
+struct D3D12_SO_DECLARATION_ENTRY {
+	UINT Stream;
+	LPCSTR SemanticName;
+	UINT SemanticIndex;
+	UINT8 StartComponent;
+	UINT8 ComponentCount;
+	UINT8 OutputSlot;
+};
+struct D3D12_STREAM_OUTPUT_DESC {
+	const D3D12_SO_DECLARATION_ENTRY* pSODeclaration;
+	UINT NumEntries;
+	const UINT* pBufferStrides;
+	UINT NumStrides;
+	UINT RasterizedStream;
+};
+struct D3D12_RENDER_TARGET_BLEND_DESC {
+	BOOL BlendEnable;
+	BOOL LogicOpEnable;
+	D3D12_BLEND SrcBlend;
+	D3D12_BLEND DestBlend;
+	D3D12_BLEND_OP BlendOp;
+	D3D12_BLEND SrcBlendAlpha;
+	D3D12_BLEND DestBlendAlpha;
+	D3D12_BLEND_OP BlendOpAlpha;
+	D3D12_LOGIC_OP LogicOp;
+	UINT8 RenderTargetWriteMask;
+};
+struct D3D12_BLEND_DESC {
+	BOOL AlphaToCoverageEnable;
+	BOOL IndependentBlendEnable;
+	D3D12_RENDER_TARGET_BLEND_DESC RenderTarget[8];
+};
+struct D3D12_RASTERIZER_DESC {
+	D3D12_FILL_MODE FillMode;
+	D3D12_CULL_MODE CullMode;
+	BOOL FrontCounterClockwise;
+	INT DepthBias;
+	FLOAT DepthBiasClamp;
+	FLOAT SlopeScaledDepthBias;
+	BOOL DepthClipEnable;
+	BOOL MultisampleEnable;
+	BOOL AntialiasedLineEnable;
+	UINT ForcedSampleCount;
+	D3D12_CONSERVATIVE_RASTERIZATION_MODE ConservativeRaster;
+};
+struct D3D12_DEPTH_STENCILOP_DESC {
+	D3D12_STENCIL_OP StencilFailOp;
+	D3D12_STENCIL_OP StencilDepthFailOp;
+	D3D12_STENCIL_OP StencilPassOp;
+	D3D12_COMPARISON_FUNC StencilFunc;
+};
+struct D3D12_DEPTH_STENCIL_DESC {
+	BOOL DepthEnable;
+	D3D12_DEPTH_WRITE_MASK DepthWriteMask;
+	D3D12_COMPARISON_FUNC DepthFunc;
+	BOOL StencilEnable;
+	UINT8 StencilReadMask;
+	UINT8 StencilWriteMask;
+	D3D12_DEPTH_STENCILOP_DESC FrontFace;
+	D3D12_DEPTH_STENCILOP_DESC BackFace;
+};
+struct D3D12_INPUT_ELEMENT_DESC {
+	LPCSTR SemanticName;
+	UINT SemanticIndex;
+	DXGI_FORMAT Format;
+	UINT InputSlot;
+	UINT AlignedByteOffset;
+	D3D12_INPUT_CLASSIFICATION InputSlotClass;
+	UINT InstanceDataStepRate;
+};
+struct D3D12_INPUT_LAYOUT_DESC {
+	const D3D12_INPUT_ELEMENT_DESC* pInputElementDescs;
+	UINT NumElements;
+};
+struct DXGI_SAMPLE_DESC {
+	UINT Count;
+	UINT Quality;
+};
+struct D3D12_CACHED_PIPELINE_STATE {
+	const void* pCachedBlob;
+	SIZE_T CachedBlobSizeInBytes;
+};
+struct D3D12_GRAPHICS_PIPELINE_STATE_DESC {
+	ID3D12RootSignature* pRootSignature;
+	D3D12_SHADER_BYTECODE VS;
+	D3D12_SHADER_BYTECODE PS;
+	D3D12_SHADER_BYTECODE DS;
+	D3D12_SHADER_BYTECODE HS;
+	D3D12_SHADER_BYTECODE GS;
+	D3D12_STREAM_OUTPUT_DESC StreamOutput;
+	D3D12_BLEND_DESC BlendState;
+	UINT SampleMask;
+	D3D12_RASTERIZER_DESC RasterizerState;
+	D3D12_DEPTH_STENCIL_DESC DepthStencilState;
+	D3D12_INPUT_LAYOUT_DESC InputLayout;
+	D3D12_INDEX_BUFFER_STRIP_CUT_VALUE IBStripCutValue;
+	D3D12_PRIMITIVE_TOPOLOGY_TYPE PrimitiveTopologyType;
+	UINT NumRenderTargets;
+	DXGI_FORMAT RTVFormats[8];
+	DXGI_FORMAT DSVFormat;
+	DXGI_SAMPLE_DESC SampleDesc;
+	UINT NodeMask;
+	D3D12_CACHED_PIPELINE_STATE CachedPSO;
+	D3D12_PIPELINE_STATE_FLAGS Flags;
+};
+
+// テクスチャのコピー
+typedef intptr_t LONG_PTR;
+
+#define D3D12_TEXTURE_DATA_PITCH_ALIGNMENT 256
+#define D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT 512
+
+struct D3D12_SUBRESOURCE_DATA {
+	const void* pData;
+	LONG_PTR RowPitch;
+	LONG_PTR SlicePitch;
+};
+struct D3D12_SUBRESOURCE_FOOTPRINT {
+	DXGI_FORMAT Format;
+	UINT Width;
+	UINT Height;
+	UINT Depth;
+	UINT RowPitch;
+};
+struct D3D12_PLACED_SUBRESOURCE_FOOTPRINT {
+	UINT64 Offset;
+	D3D12_SUBRESOURCE_FOOTPRINT Footprint;
+};
+
+#endif
@@ -0,0 +1,215 @@
+#include "TestFramework.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "BatchTransform.h"
+#include "ThreadPool.h"
+
+// AoS、SoA、ストライド指定のまとめた変換が v * mat と同じ結果になるかを確かめる
+// 要素数は SIMD の幅で割り切れない数と、kBatchParallelThreshold の前後(スレッドで分割する数)にする
+
+namespace {
+	constexpr size_t kCounts[] = {
+		0, 1, 2, 3, 4, 5, 7, 8, 9, 13, 1001,
+		Math::kBatchParallelThreshold - 1, Math::kBatchParallelThreshold, Math::kBatchParallelThreshold + 5, Math::kBatchParallelThreshold * 3 + 7 };
+	// 書き込まない部分の目印
+	const Vector3 kGuard(-12345.0f, 12345.0f, -12345.0f);
+
+	enum Kind {
+		kPoint,
+		kVector,
+		kNormal,
+
+		kKindCount
+	};
+
+	std::vector<Vector3> CreateVectors(size_t count, uint32_t seed) {
+		std::mt19937 random(seed);
+		std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+		std::vector<Vector3> vectors(count);
+		for (Vector3& v : vectors) {
+			v = Vector3(dist(random), dist(random), dist(random));
+		}
+		return vectors;
+	}
+
+	Matrix44 CreateTestMatrix() {
+		return Matrix44::CreateTRS(
+			Vector3(1.5f, 0.5f, 2.0f),
+			Quaternion::CreateFromAngleAxis(0.7f, Vector3(1.0f, 2.0f, 3.0f).Normalized()),
+			Vector3(3.0f, -4.0f, 5.0f));
+	}
+
+	Vector3 Expected(const Vector3& v, const Matrix44& mat, Kind kind) {
+		switch (kind) {
+		case kPoint:
+			return v * mat;
+		case kVector: {
+			Vector4 r = Vector4(v, 0.0f) * mat;
+			return Vector3(r.x, r.y, r.z);
+		}
+		case kNormal: default: {
+			Vector4 r = Vector4(v, 0.0f) * mat.Inverse().Transpose();
+			return Vector3(r.x, r.y, r.z);
+		}
+		}
+	}
+
+	bool IsNear(const Vector3& actual, const Vector3& expected) {
+		// FMA の有無で丸めが変わるので大きさに応じて許す
+		auto isNear = [](float a, float b) { return std::fabs(a - b) <= 1e-4f * (1.0f + std::fabs(b)); };
+		return isNear(actual.x, expected.x) && isNear(actual.y, expected.y) && isNear(actual.z, expected.z);
+	}
+
+	/// <summary>
+	/// 先頭 count 個が期待する値と一致し、その後ろは書き換えていないか
+	/// </summary>
+	size_t CountMismatches(const std::vector<Vector3>& src, const Matrix44& mat, Kind kind, const std::vector<Vector3>& dst, size_t count) {
+		size_t mismatchCount = 0;
+		for (size_t i = 0; i < count; i++) {
+			mismatchCount += !IsNear(dst[i], Expected(src[i], mat, kind));
+		}
+		for (size_t i = count; i < dst.size(); i++) {
+			mismatchCount += dst[i] != kGuard;
+		}
+		return mismatchCount;
+	}
+
+	void TransformAoS(std::span<const Vector3> src, const Matrix44& mat, Kind kind, std::span<Vector3> dst) {
+		switch (kind) {
+		case kPoint: Math::TransformPoints(src, mat, dst); break;
+		case kVector: Math::TransformVectors(src, mat, dst); break;
+		case kNormal: default: Math::TransformNormals(src, mat, dst); break;
+		}
+	}
+
+	void TransformSoA(const ConstVector3SoA& src, const Matrix44& mat, Kind kind, const Vector3SoA& dst) {
+		switch (kind) {
+		case kPoint: Math::TransformPoints(src, mat, dst); break;
+		case kVector: Math::TransformVectors(src, mat, dst); break;
+		case kNormal: default: Math::TransformNormals(src, mat, dst); break;
+		}
+	}
+
+	// SoA の配列の持ち主
+	struct Vector3Array {
+		std::vector<float> x, y, z;
+
+		explicit Vector3Array(const std::vector<Vector3>& vectors) {
+			for (const Vector3& v : vectors) {
+				x.push_back(v.x); y.push_back(v.y); z.push_back(v.z);
+			}
+		}
+		std::vector<Vector3> Get() const {
+			std::vector<Vector3> vectors(x.size());
+			for (size_t i = 0; i < x.size(); i++) {
+				vectors[i] = Vector3(x[i], y[i], z[i]);
+			}
+			return vectors;
+		}
+		ConstVector3SoA GetConstSoA(size_t count) const {
+			return ConstVector3SoA(std::span(x).first(count), std::span(y).first(count), std::span(z).first(count));
+		}
+		Vector3SoA GetSoA() { return Vector3SoA{ x, y, z }; }
+	};
+
+	// 座標の前後に別のメンバがある頂点
+	struct Vertex {
+		float weight;
+		Vector3 position;
+		float uv[2];
+	};
+
+	struct ThreadPoolScope {
+		ThreadPoolScope() { ThreadPool::GetInstance()->Initalize(3); }
+		~ThreadPoolScope() { ThreadPool::GetInstance()->Finalize(); }
+	};
+}
+
+TEST_CASE(AoSMatchesVectorTimesMatrix) {
+	ThreadPoolScope threadPoolScope;
+	const Matrix44 mat = CreateTestMatrix();
+	for (size_t count : kCounts) {
+		std::vector<Vector3> src = CreateVectors(count, static_cast<uint32_t>(count));
+		for (int kind = 0; kind < kKindCount; kind++) {
+			// dst は src より長くてもよい
+			std::vector<Vector3> dst(count + 3, kGuard);
+			TransformAoS(src, mat, static_cast<Kind>(kind), dst);
+			size_t mismatchCount = CountMismatches(src, mat, static_cast<Kind>(kind), dst, count);
+			if (mismatchCount != 0) {
+				std::printf("  count %zu kind %d\n", count, kind);
+			}
+			CHECK(mismatchCount == 0);
+
+			// 同じ配列に書き込む
+			std::vector<Vector3> inPlace = src;
+			TransformAoS(inPlace, mat, static_cast<Kind>(kind), inPlace);
+			CHECK(CountMismatches(src, mat, static_cast<Kind>(kind), inPlace, count) == 0);
+		}
+	}
+}
+
+TEST_CASE(SoAMatchesVectorTimesMatrix) {
+	ThreadPoolScope threadPoolScope;
+	const Matrix44 mat = CreateTestMatrix();
+	for (size_t count : kCounts) {
+		std::vector<Vector3> src = CreateVectors(count, static_cast<uint32_t>(count) + 1);
+		Vector3Array srcArray(src);
+		for (int kind = 0; kind < kKindCount; kind++) {
+			std::vector<Vector3> guards(count + 3, kGuard);
+			Vector3Array dstArray(guards);
+			TransformSoA(srcArray.GetConstSoA(count), mat, static_cast<Kind>(kind), dstArray.GetSoA());
+			size_t mismatchCount = CountMismatches(src, mat, static_cast<Kind>(kind), dstArray.Get(), count);
+			if (mismatchCount != 0) {
+				std::printf("  count %zu kind %d\n", count, kind);
+			}
+			CHECK(mismatchCount == 0);
+
+			Vector3Array inPlace(src);
+			TransformSoA(inPlace.GetConstSoA(count), mat, static_cast<Kind>(kind), inPlace.GetSoA());
+			CHECK(CountMismatches(src, mat, static_cast<Kind>(kind), inPlace.Get(), count) == 0);
+		}
+	}
+}
+
+TEST_CASE(StridedMatchesVectorTimesMatrix) {
+	ThreadPoolScope threadPoolScope;
+	const Matrix44 mat = CreateTestMatrix();
+	for (size_t count : kCounts) {
+		std::vector<Vector3> src = CreateVectors(count, static_cast<uint32_t>(count) + 2);
+		std::vector<Vertex> vertices(count);
+		for (size_t i = 0; i < count; i++) {
+			vertices[i] = Vertex{ static_cast<float>(i), src[i], { 0.25f, 0.75f } };
+		}
+
+		// 頂点の中の座標をその場で変換し、他のメンバは触らない
+		Math::TransformVertexPositions(std::span<Vertex>(vertices), &Vertex::position, mat);
+		size_t mismatchCount = 0;
+		for (size_t i = 0; i < count; i++) {
+			mismatchCount += !IsNear(vertices[i].position, src[i] * mat);
+			mismatchCount += vertices[i].weight != static_cast<float>(i) || vertices[i].uv[0] != 0.25f || vertices[i].uv[1] != 0.75f;
+		}
+		if (mismatchCount != 0) {
+			std::printf("  count %zu\n", count);
+		}
+		CHECK(mismatchCount == 0);
+
+		// 頂点から詰めた配列へ(ストライドが違う)
+		std::vector<Vector3> packed(count + 3, kGuard);
+		std::vector<Vector3> transformed(count);
+		for (size_t i = 0; i < count; i++) {
+			transformed[i] = vertices[i].position;
+		}
+		if (count > 0) {
+			Math::TransformPointsStrided(&vertices[0].position, sizeof(Vertex), packed.data(), sizeof(Vector3), count, mat);
+		}
+		CHECK(CountMismatches(transformed, mat, kPoint, packed, count) == 0);
+
+		// 詰まっている場合は AoS の処理に回る
+		std::vector<Vector3> dst(count + 3, kGuard);
+		Math::TransformPointsStrided(src.data(), sizeof(Vector3), dst.data(), sizeof(Vector3), count, mat);
+		CHECK(CountMismatches(src, mat, kPoint, dst, count) == 0);
+	}
+}
@@ -0,0 +1,192 @@
+#include "TestFramework.h"
+
+#include <random>
+#include <vector>
+
+#include "Geometry.h"
+
+// IntersectsBatch がスカラーの Intersects と同じ結果になるかを確かめる
+// 要素数は SIMD の幅で割り切れない数にして端数の処理も通す
+
+namespace {
+	constexpr size_t kCount = 10007;
+
+	class Generator
+	{
+	public:
+		explicit Generator(uint32_t seed) : random_(seed) {}
+		float Get(float min, float max) { return std::uniform_real_distribution<float>(min, max)(random_); }
+		Vector3 GetVector3(float min, float max) { return Vector3(Get(min, max), Get(min, max), Get(min, max)); }
+
+	private:
+		std::mt19937 random_;
+	};
+
+	// SoA の配列の持ち主
+	struct Vector3Array {
+		std::vector<float> x, y, z;
+
+		explicit Vector3Array(size_t count) : x(count), y(count), z(count) {}
+		void Set(size_t i, const Vector3& v) { x[i] = v.x; y[i] = v.y; z[i] = v.z; }
+		Vector3 Get(size_t i) const { return Vector3(x[i], y[i], z[i]); }
+		ConstVector3SoA GetSoA() const { return ConstVector3SoA(x, y, z); }
+	};
+
+	Frustum CreateTestFrustum() {
+		Matrix44 view = Matrix44::CreateView(Vector3(1.0f, 2.0f, -10.0f), Vector3::Zero, Vector3::UnitY);
+		Matrix44 proj = Matrix44::CreatePerspectiveProjection(Math::ToRadians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+		return Frustum::CreateFromMatrix(view * proj);
+	}
+
+	// 一部が視錐台に入るように散らしたボックス
+	void GenerateBoxes(Generator& generator, Vector3Array& centers, Vector3Array& extents) {
+		for (size_t i = 0; i < centers.x.size(); i++) {
+			centers.Set(i, Vector3(generator.Get(-60.0f, 60.0f), generator.Get(-60.0f, 60.0f), generator.Get(-30.0f, 120.0f)));
+			extents.Set(i, generator.GetVector3(0.1f, 5.0f));
+		}
+	}
+}
+
+TEST_CASE(FrustumContainsTarget) {
+	Frustum frustum = CreateTestFrustum();
+	CHECK(Math::Intersects(frustum, Sphere{ Vector3::Zero, 0.1f }));
+	// 視点の後ろ
+	CHECK(!Math::Intersects(frustum, Sphere{ Vector3(1.0f, 2.0f, -20.0f), 0.1f }));
+	// 遠クリップ面の先
+	CHECK(!Math::Intersects(frustum, Sphere{ Vector3(0.0f, 0.0f, 200.0f), 1.0f }));
+}
+
+TEST_CASE(FrustumSphereBatchMatchesScalar) {
+	Generator generator(1);
+	Frustum frustum = CreateTestFrustum();
+	Vector3Array centers(kCount), extents(kCount);
+	std::vector<float> radii(kCount);
+	GenerateBoxes(generator, centers, extents);
+	for (float& radius : radii) { radius = generator.Get(0.1f, 5.0f); }
+
+	std::vector<uint8_t> results(kCount);
+	size_t hitCount = Math::IntersectsBatch(frustum, SphereSoA{ centers.GetSoA(), radii }, results);
+	size_t expectedHitCount = 0, mismatchCount = 0;
+	for (size_t i = 0; i < kCount; i++) {
+		bool expected = Math::Intersects(frustum, Sphere{ centers.Get(i), radii[i] });
+		expectedHitCount += expected;
+		mismatchCount += expected != (results[i] != 0);
+	}
+	CHECK(mismatchCount == 0);
+	CHECK(hitCount == expectedHitCount);
+	// どちらかに偏っていると比べる意味が無い
+	CHECK(expectedHitCount > kCount / 20 && expectedHitCount < kCount - kCount / 20);
+}
+
+TEST_CASE(FrustumAABBBatchMatchesScalar) {
+	Generator generator(2);
+	Frustum frustum = CreateTestFrustum();
+	Vector3Array centers(kCount), extents(kCount);
+	GenerateBoxes(generator, centers, extents);
+
+	std::vector<uint8_t> results(kCount);
+	size_t hitCount = Math::IntersectsBatch(frustum, AABBSoA{ centers.GetSoA(), extents.GetSoA() }, results);
+	size_t expectedHitCount = 0, mismatchCount = 0;
+	for (size_t i = 0; i < kCount; i++) {
+		bool expected = Math::Intersects(frustum, AABB::CreateFromCenterExtents(centers.Get(i), extents.Get(i)));
+		expectedHitCount += expected;
+		mismatchCount += expected != (results[i] != 0);
+	}
+	CHECK(mismatchCount == 0);
+	CHECK(hitCount == expectedHitCount);
+	CHECK(expectedHitCount > kCount / 20 && expectedHitCount < kCount - kCount / 20);
+}
+
+TEST_CASE(RayAABBBatchMatchesScalar) {
+	Generator generator(3);
+	Vector3Array centers(kCount), extents(kCount);
+	for (size_t i = 0; i < kCount; i++) {
+		centers.Set(i, generator.GetVector3(-20.0f, 20.0f));
+		extents.Set(i, generator.GetVector3(0.5f, 5.0f));
+	}
+	// 始点がボックスの内側になるものも含む
+	Ray ray{ Vector3(0.0f, 0.0f, -10.0f), Vector3(0.2f, -0.1f, 1.0f) };
+
+	std::vector<float> distances(kCount);
+	size_t hitCount = Math::IntersectsBatch(ray, AABBSoA{ centers.GetSoA(), extents.GetSoA() }, distances);
+	size_t expectedHitCount = 0, mismatchCount = 0;
+	for (size_t i = 0; i < kCount; i++) {
+		float distance = Math::kNoHit;
+		bool expected = Math::Intersects(ray, AABB::CreateFromCenterExtents(centers.Get(i), extents.Get(i)), distance);
+		expectedHitCount += expected;
+		if (expected != (distances[i] != Math::kNoHit)) {
+			mismatchCount++;
+		}
+		else if (expected) {
+			CHECK_NEAR(distances[i], distance, 1e-4f * (1.0f + distance));
+		}
+	}
+	CHECK(mismatchCount == 0);
+	CHECK(hitCount == expectedHitCount);
+	CHECK(expectedHitCount > 0);
+}
+
+TEST_CASE(RayTriangleBatchMatchesScalar) {
+	Generator generator(4);
+	Vector3Array v0(kCount), v1(kCount), v2(kCount);
+	for (size_t i = 0; i < kCount; i++) {
+		Vector3 base = generator.GetVector3(-20.0f, 20.0f);
+		v0.Set(i, base);
+		v1.Set(i, base + generator.GetVector3(-5.0f, 5.0f));
+		v2.Set(i, base + generator.GetVector3(-5.0f, 5.0f));
+	}
+	Ray ray{ Vector3(0.0f, 0.0f, -50.0f), Vector3(0.1f, 0.05f, 1.0f) };
+
+	std::vector<float> distances(kCount);
+	size_t hitCount = Math::IntersectsBatch(ray, TriangleSoA{ v0.GetSoA(), v1.GetSoA(), v2.GetSoA() }, distances);
+	size_t expectedHitCount = 0, mismatchCount = 0;
+	for (size_t i = 0; i < kCount; i++) {
+		float distance = Math::kNoHit;
+		bool expected = Math::Intersects(ray, v0.Get(i), v1.Get(i), v2.Get(i), distance);
+		expectedHitCount += expected;
+		if (expected != (distances[i] != Math::kNoHit)) {
+			mismatchCount++;
+		}
+		else if (expected) {
+			CHECK_NEAR(distances[i], distance, 1e-4f * (1.0f + distance));
+		}
+	}
+	CHECK(mismatchCount == 0);
+	CHECK(hitCount == expectedHitCount);
+	CHECK(expectedHitCount > 0);
+}
+
+TEST_CASE(OBBBatchMatchesScalar) {
+	Generator generator(5);
+	Vector3Array centers(kCount), axisX(kCount), axisY(kCount), axisZ(kCount), extents(kCount);
+	std::vector<OBB> obbs(kCount);
+	for (size_t i = 0; i < kCount; i++) {
+		Quaternion rotation = Quaternion::CreateFromAngleAxis(generator.Get(0.0f, 6.0f), generator.GetVector3(-1.0f, 1.0f).Normalized());
+		Matrix44 mat = Matrix44::CreateRotationFromQuaternion(rotation);
+		OBB& obb = obbs[i];
+		obb.center = generator.GetVector3(-10.0f, 10.0f);
+		obb.axis[0] = mat.GetXAxis();
+		obb.axis[1] = mat.GetYAxis();
+		obb.axis[2] = mat.GetZAxis();
+		obb.extents = generator.GetVector3(0.5f, 3.0f);
+		centers.Set(i, obb.center);
+		axisX.Set(i, obb.axis[0]);
+		axisY.Set(i, obb.axis[1]);
+		axisZ.Set(i, obb.axis[2]);
+		extents.Set(i, obb.extents);
+	}
+	OBB obb = OBB::CreateFromAABB(AABB{ Vector3(-2.0f, -1.0f, -3.0f), Vector3(2.0f, 1.0f, 3.0f) },
+		Matrix44::CreateTRS(Vector3(1.0f, 1.0f, 1.0f), Quaternion::CreateFromAngleAxis(0.5f, Vector3::UnitY), Vector3::UnitX));
+
+	std::vector<uint8_t> results(kCount);
+	size_t hitCount = Math::IntersectsBatch(obb, OBBSoA{ centers.GetSoA(), axisX.GetSoA(), axisY.GetSoA(), axisZ.GetSoA(), extents.GetSoA() }, results);
+	size_t expectedHitCount = 0, mismatchCount = 0;
+	for (size_t i = 0; i < kCount; i++) {
+		bool expected = Math::Intersects(obb, obbs[i]);
+		expectedHitCount += expected;
+		mismatchCount += expected != (results[i] != 0);
+	}
+	CHECK(mismatchCount == 0);
+	CHECK(hitCount == expectedHitCount);
+	CHECK(expectedHitCount > kCount / 20 && expectedHitCount < kCount - kCount / 20);
+}
@@ -0,0 +1,273 @@
+#include "TestFramework.h"
+
+#include <cstring>
+#include <random>
+
+#include "MathUtility.h"
+
+// Matrix44 の積、行列式、逆行列のカーネルを倍精度の素直な実装と比べる
+// CreateTRS が拡縮、回転、平行移動の行列の積と一致するかも確かめる
+// 同じソースを SIMD、スカラー(MATH_SIMD_DISABLE)、AVX2 でビルドするので、全て同じ許容誤差に収まれば実装どうしも一致する
+
+namespace {
+	constexpr int kTrialCount = 20000;
+
+	const char* GetBackendName() {
+#if defined(MATH_SIMD_AVX2)
+		return "AVX2";
+#elif defined(MATH_SIMD_SSE)
+		return "SSE";
+#elif defined(MATH_SIMD_NEON)
+		return "NEON";
+#else
+		return "Scalar";
+#endif
+	}
+
+	Matrix44 RandomMatrix(std::mt19937& random) {
+		std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+		Matrix44 result;
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++) {
+				result.m[i][j] = dist(random);
+			}
+		}
+		return result;
+	}
+
+	Matrix44 RandomAffine(std::mt19937& random) {
+		std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+		Vector3 axis = Vector3(dist(random), dist(random), dist(random) + 3.0f).Normalized();
+		Quaternion q = Quaternion::CreateFromAngleAxis(dist(random), axis);
+		Vector3 scale(std::fabs(dist(random)) + 0.5f, std::fabs(dist(random)) + 0.5f, std::fabs(dist(random)) + 0.5f);
+		return Matrix44::CreateTRS(scale, q, Vector3(dist(random), dist(random), dist(random)) * 10.0f);
+	}
+
+	void ReferenceMultiply(const Matrix44& a, const Matrix44& b, double out[4][4]) {
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++) {
+				double sum = 0.0;
+				for (int k = 0; k < 4; k++) {
+					sum += static_cast<double>(a.m[i][k]) * b.m[k][j];
+				}
+				out[i][j] = sum;
+			}
+		}
+	}
+
+	// 置換の総和で求める
+	double ReferenceDeterminant(const Matrix44& m) {
+		double result = 0.0;
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++) {
+				for (int k = 0; k < 4; k++) {
+					for (int l = 0; l < 4; l++) {
+						if (i == j || i == k || i == l || j == k || j == l || k == l) {
+							continue;
+						}
+						int p[4] = { i, j, k, l };
+						int inversionCount = 0;
+						for (int x = 0; x < 4; x++) {
+							for (int y = x + 1; y < 4; y++) {
+								inversionCount += p[x] > p[y] ? 1 : 0;
+							}
+						}
+						double term = static_cast<double>(m.m[0][i]) * m.m[1][j] * m.m[2][k] * m.m[3][l];
+						result += inversionCount % 2 == 0 ? term : -term;
+					}
+				}
+			}
+		}
+		return result;
+	}
+
+	// 単位行列との差の最大
+	double IdentityError(const Matrix44& m) {
+		double result = 0.0;
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++) {
+				result = std::fmax(result, std::fabs(m.m[i][j] - (i == j ? 1.0 : 0.0)));
+			}
+		}
+		return result;
+	}
+}
+
+TEST_CASE(Backend) {
+	std::printf("  backend: %s\n", GetBackendName());
+}
+
+TEST_CASE(MultiplyMatchesReference) {
+	std::mt19937 random(1);
+	double maxError = 0.0;
+	for (int trial = 0; trial < kTrialCount; trial++) {
+		Matrix44 a = RandomMatrix(random), b = RandomMatrix(random);
+		Matrix44 result = a * b;
+		double reference[4][4];
+		ReferenceMultiply(a, b, reference);
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++) {
+				maxError = std::fmax(maxError, std::fabs(result.m[i][j] - reference[i][j]));
+			}
+		}
+	}
+	std::printf("  max error %g\n", maxError);
+	CHECK(maxError <= 1e-5);
+}
+
+TEST_CASE(MultiplyInPlace) {
+	std::mt19937 random(2);
+	for (int trial = 0; trial < 1000; trial++) {
+		Matrix44 a = RandomMatrix(random), b = RandomMatrix(random);
+		Matrix44 expected = a * b;
+		// 左辺と結果が同じ
+		Matrix44 left = a;
+		left *= b;
+		// 右辺と結果が同じ
+		Matrix44 right = b;
+		Math::SIMD::Multiply44(&a.m[0][0], &right.m[0][0], &right.m[0][0]);
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++) {
+				CHECK(left.m[i][j] == expected.m[i][j]);
+				CHECK(right.m[i][j] == expected.m[i][j]);
+			}
+		}
+	}
+}
+
+TEST_CASE(DeterminantMatchesReference) {
+	std::mt19937 random(3);
+	double maxRelativeError = 0.0;
+	for (int trial = 0; trial < kTrialCount; trial++) {
+		Matrix44 m = RandomMatrix(random);
+		double reference = ReferenceDeterminant(m);
+		// 0 に近いと相対誤差が意味を持たない
+		if (std::fabs(reference) < 0.05) {
+			continue;
+		}
+		maxRelativeError = std::fmax(maxRelativeError, std::fabs(m.Determinant() - reference) / std::fabs(reference));
+	}
+	std::printf("  max relative error %g\n", maxRelativeError);
+	CHECK(maxRelativeError <= 1e-4);
+}
+
+TEST_CASE(InverseTimesMatrixIsIdentity) {
+	std::mt19937 random(4);
+	double maxError = 0.0;
+	for (int trial = 0; trial < kTrialCount; trial++) {
+		Matrix44 m = RandomMatrix(random);
+		if (std::fabs(ReferenceDeterminant(m)) < 0.05) {
+			continue;
+		}
+		Matrix44 inverse = m.Inverse();
+		maxError = std::fmax(maxError, IdentityError(m * inverse));
+		maxError = std::fmax(maxError, IdentityError(inverse * m));
+	}
+	std::printf("  max error %g\n", maxError);
+	CHECK(maxError <= 1e-3);
+}
+
+TEST_CASE(InverseReturnsDeterminantAndWorksInPlace) {
+	std::mt19937 random(5);
+	for (int trial = 0; trial < 1000; trial++) {
+		Matrix44 m = RandomMatrix(random);
+		double reference = ReferenceDeterminant(m);
+		if (std::fabs(reference) < 0.05) {
+			continue;
+		}
+		Matrix44 expected = m.Inverse();
+		Matrix44 inPlace = m;
+		float det = Math::SIMD::Inverse44(&inPlace.m[0][0], &inPlace.m[0][0]);
+		CHECK_NEAR(det, reference, std::fabs(reference) * 1e-4);
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++) {
+				CHECK(inPlace.m[i][j] == expected.m[i][j]);
+			}
+		}
+	}
+}
+
+TEST_CASE(SingularInverseLeavesOutputUnchanged) {
+	// 2行目が1行目の2倍
+	Matrix44 singular(
+		1.0f, 2.0f, 3.0f, 4.0f,
+		2.0f, 4.0f, 6.0f, 8.0f,
+		0.0f, 1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f, 1.0f);
+	CHECK(singular.Determinant() == 0.0f);
+	Matrix44 out = Matrix44::Identity;
+	float det = Math::SIMD::Inverse44(&singular.m[0][0], &out.m[0][0]);
+	CHECK(det == 0.0f);
+	CHECK(IdentityError(out) == 0.0);
+}
+
+TEST_CASE(AffineMultiplyMatchesGeneral) {
+	std::mt19937 random(6);
+	double maxError = 0.0;
+	for (int trial = 0; trial < kTrialCount; trial++) {
+		Matrix44 a = RandomAffine(random), b = RandomAffine(random);
+		Matrix44 affine = Matrix44::AffineMultiply(a, b);
+		double reference[4][4];
+		ReferenceMultiply(a, b, reference);
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++) {
+				maxError = std::fmax(maxError, std::fabs(affine.m[i][j] - reference[i][j]) / (1.0 + std::fabs(reference[i][j])));
+			}
+		}
+		// 4列目はそのまま (0, 0, 0, 1)
+		CHECK(affine.m[0][3] == 0.0f && affine.m[1][3] == 0.0f && affine.m[2][3] == 0.0f && affine.m[3][3] == 1.0f);
+	}
+	std::printf("  max error %g\n", maxError);
+	CHECK(maxError <= 1e-5);
+}
+
+TEST_CASE(AffineInversesMatchGeneralInverse) {
+	std::mt19937 random(7);
+	double maxError = 0.0;
+	for (int trial = 0; trial < kTrialCount; trial++) {
+		Matrix44 m = RandomAffine(random);
+		maxError = std::fmax(maxError, IdentityError(m * m.InverseAffine()));
+
+		// 回転と平行移動のみ
+		Matrix44 rigid = Matrix44::CreateRotationFromQuaternion(
+			Quaternion::CreateFromAngleAxis(static_cast<float>(trial), Vector3(0.0f, 1.0f, 0.0f))) *
+			Matrix44::CreateTranslation(m.GetTranslation());
+		maxError = std::fmax(maxError, IdentityError(rigid * rigid.InverseOrthonormal()));
+	}
+	std::printf("  max error %g\n", maxError);
+	CHECK(maxError <= 1e-4);
+}
+
+TEST_CASE(CreateTRSMatchesScaleRotateTranslate) {
+	std::mt19937 random(8);
+	std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+	double maxError = 0.0;
+	for (int trial = 0; trial < kTrialCount; trial++) {
+		// 負の拡縮(反転)も含める
+		Vector3 scale(dist(random), dist(random), dist(random));
+		Vector3 axis = Vector3(dist(random), dist(random), dist(random) + 3.0f).Normalized();
+		Quaternion q = Quaternion::CreateFromAngleAxis(dist(random) * 2.0f, axis);
+		Vector3 translation = Vector3(dist(random), dist(random), dist(random)) * 10.0f;
+
+		Matrix44 trs = Matrix44::CreateTRS(scale, q, translation);
+		Matrix44 product = Matrix44::CreateScaling(scale) * Matrix44::CreateRotationFromQuaternion(q) * Matrix44::CreateTranslation(translation);
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++) {
+				maxError = std::fmax(maxError, std::fabs(trs.m[i][j] - product.m[i][j]) / (1.0 + std::fabs(product.m[i][j])));
+			}
+		}
+		// 点には拡縮、回転、平行移動の順にかかる
+		Vector3 point(dist(random), dist(random), dist(random));
+		Vector3 expected = q * (point * scale) + translation;
+		Vector3 actual = point * trs;
+		maxError = std::fmax(maxError, (actual - expected).Length() / (1.0 + expected.Length()));
+	}
+	std::printf("  max error %g\n", maxError);
+	CHECK(maxError <= 1e-5);
+
+	// 単位の値では平行移動だけの行列になる
+	const Vector3 translation(1.0f, 2.0f, 3.0f);
+	Matrix44 trs = Matrix44::CreateTRS(Vector3(1.0f, 1.0f, 1.0f), Quaternion::Identity, translation);
+	Matrix44 expected = Matrix44::CreateTranslation(translation);
+	CHECK(std::memcmp(&trs, &expected, sizeof(Matrix44)) == 0);
+}
@@ -0,0 +1,167 @@
+#include "TestFramework.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include "MathUtility.h"
+
+// SinCos の誤差が MathUtility.h に書いた値に収まるかを倍精度の sin, cos と比べて確かめる
+//   SinCos    : 最大誤差 2.7e-7 (|angle| <= 100)、絶対値 0.5 以上で 4ULP 以内
+//   SinCosEst : 最大誤差 9.5e-6
+//   大きな角度 : 最大誤差 2e-6 (|angle| <= 1e5)
+// 大きな角度は誤差が増えるだけで壊れず、NaN と無限大は NaN になることも確かめる
+
+namespace {
+	constexpr double kRange = 100.0;
+	constexpr int kSampleCount = 2000000;
+	// 大きな角度の範囲と、その中の最大誤差
+	constexpr double kLargeRange = 1.0e5;
+	constexpr double kLargeRangeError = 2.0e-6;
+
+	// 同じ符号の float どうしの ULP の差
+	int64_t UlpDistance(float a, float b) {
+		int32_t ia, ib;
+		std::memcpy(&ia, &a, sizeof(a));
+		std::memcpy(&ib, &b, sizeof(b));
+		// 負の数は順序が逆になるので折り返す
+		int64_t la = ia < 0 ? static_cast<int64_t>(INT32_MIN) - ia : ia;
+		int64_t lb = ib < 0 ? static_cast<int64_t>(INT32_MIN) - ib : ib;
+		return la > lb ? la - lb : lb - la;
+	}
+
+	struct ErrorReport {
+		double maxError = 0.0;
+		int64_t maxUlp = 0;
+
+		void Add(float value, double reference) {
+			maxError = std::fmax(maxError, std::fabs(value - reference));
+			if (std::fabs(reference) >= 0.5) {
+				maxUlp = std::max(maxUlp, UlpDistance(value, static_cast<float>(reference)));
+			}
+		}
+	};
+
+	float GetAngle(int i) {
+		return static_cast<float>(-kRange + 2.0 * kRange * i / (kSampleCount - 1));
+	}
+}
+
+TEST_CASE(SinCosPreciseErrorBound) {
+	ErrorReport report;
+	for (int i = 0; i < kSampleCount; i++) {
+		float angle = GetAngle(i);
+		float s, c;
+		Math::SinCos(angle, s, c);
+		report.Add(s, std::sin(static_cast<double>(angle)));
+		report.Add(c, std::cos(static_cast<double>(angle)));
+	}
+	std::printf("  max error %g, max %lld ULP\n", report.maxError, static_cast<long long>(report.maxUlp));
+	CHECK(report.maxError <= 2.7e-7);
+	CHECK(report.maxUlp <= 4);
+}
+
+TEST_CASE(SinCosEstErrorBound) {
+	ErrorReport report;
+	for (int i = 0; i < kSampleCount; i++) {
+		float angle = GetAngle(i);
+		float s, c;
+		Math::SinCosEst(angle, s, c);
+		report.Add(s, std::sin(static_cast<double>(angle)));
+		report.Add(c, std::cos(static_cast<double>(angle)));
+	}
+	std::printf("  max error %g, max %lld ULP\n", report.maxError, static_cast<long long>(report.maxUlp));
+	CHECK(report.maxError <= 9.5e-6);
+}
+
+TEST_CASE(SinCos4ErrorBound) {
+	ErrorReport precise, estimate;
+	for (int i = 0; i < kSampleCount; i += 4) {
+		float angles[4] = { GetAngle(i), GetAngle(i + 1), GetAngle(i + 2), GetAngle(i + 3) };
+		float sins[4], coss[4], sinEsts[4], cosEsts[4];
+		Math::SIMD::SinCos4<true>(angles, sins, coss);
+		Math::SIMD::SinCos4<false>(angles, sinEsts, cosEsts);
+		for (int j = 0; j < 4; j++) {
+			double s = std::sin(static_cast<double>(angles[j])), c = std::cos(static_cast<double>(angles[j]));
+			precise.Add(sins[j], s);
+			precise.Add(coss[j], c);
+			estimate.Add(sinEsts[j], s);
+			estimate.Add(cosEsts[j], c);
+		}
+	}
+	std::printf("  precise max error %g, max %lld ULP, estimate max error %g\n",
+		precise.maxError, static_cast<long long>(precise.maxUlp), estimate.maxError);
+	CHECK(precise.maxError <= 2.7e-7);
+	CHECK(precise.maxUlp <= 4);
+	CHECK(estimate.maxError <= 9.5e-6);
+}
+
+TEST_CASE(SinCosSpecialAngles) {
+	float s, c;
+	Math::SinCos(0.0f, s, c);
+	CHECK(s == 0.0f);
+	CHECK(c == 1.0f);
+	// 2π の倍数を引いた後も符号が合う
+	const float angles[] = { Math::Pi * 0.5f, -Math::Pi * 0.5f, Math::Pi, -Math::Pi, Math::Pi * 1.5f, Math::Pi * 2.0f, 64.0f * Math::Pi };
+	for (float angle : angles) {
+		Math::SinCos(angle, s, c);
+		CHECK_NEAR(s, std::sin(static_cast<double>(angle)), 2.7e-7);
+		CHECK_NEAR(c, std::cos(static_cast<double>(angle)), 2.7e-7);
+	}
+}
+
+TEST_CASE(SinCosNaNAndInfinityReturnNaN) {
+	const float inputs[] = { std::numeric_limits<float>::quiet_NaN(), -std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
+	for (float angle : inputs) {
+		float s, c;
+		Math::SinCos(angle, s, c);
+		CHECK(std::isnan(s) && std::isnan(c));
+		Math::SinCosEst(angle, s, c);
+		CHECK(std::isnan(s) && std::isnan(c));
+	}
+	// 4要素のうち一つだけ NaN でも他は正しい
+	float angles[4] = { 1.0f, std::numeric_limits<float>::quiet_NaN(), -2.0f, std::numeric_limits<float>::infinity() };
+	float sins[4], coss[4];
+	Math::SIMD::SinCos4<true>(angles, sins, coss);
+	CHECK(std::isnan(sins[1]) && std::isnan(coss[1]));
+	CHECK(std::isnan(sins[3]) && std::isnan(coss[3]));
+	CHECK_NEAR(sins[0], std::sin(1.0), 2.7e-7);
+	CHECK_NEAR(coss[2], std::cos(-2.0), 2.7e-7);
+}
+
+TEST_CASE(SinCosLargeAngles) {
+	// 範囲縮小の誤差は角度に比例して増える
+	ErrorReport report;
+	for (int i = 0; i < kSampleCount; i += 16) {
+		float angle = static_cast<float>(GetAngle(i) * kLargeRange / kRange);
+		float s, c;
+		Math::SinCos(angle, s, c);
+		report.Add(s, std::sin(static_cast<double>(angle)));
+		report.Add(c, std::cos(static_cast<double>(angle)));
+	}
+	std::printf("  |angle| <= %g: max error %g\n", kLargeRange, report.maxError);
+	CHECK(report.maxError <= kLargeRangeError);
+
+	// int に入らない角度でも壊れず、[-1, 1] に収まる
+	const float angles[] = { 1.0e6f, 3.0e9f, -3.0e9f, 1.0e20f, -1.0e30f, std::numeric_limits<float>::max(), -std::numeric_limits<float>::max() };
+	for (float angle : angles) {
+		float s, c, sEst, cEst;
+		Math::SinCos(angle, s, c);
+		Math::SinCosEst(angle, sEst, cEst);
+		float values[] = { s, c, sEst, cEst };
+		for (float value : values) {
+			CHECK(std::isfinite(value));
+			CHECK(std::fabs(value) <= 1.0f + 1e-5f);
+		}
+		CHECK_NEAR(s * s + c * c, 1.0f, 1e-5f);
+
+		float angles4[4] = { angle, -angle, angle, 0.5f };
+		float sins[4], coss[4];
+		Math::SIMD::SinCos4<true>(angles4, sins, coss);
+		for (int j = 0; j < 4; j++) {
+			CHECK(std::isfinite(sins[j]) && std::isfinite(coss[j]));
+			CHECK(std::fabs(sins[j]) <= 1.0f + 1e-5f && std::fabs(coss[j]) <= 1.0f + 1e-5f);
+		}
+		CHECK_NEAR(sins[3], std::sin(0.5), 2.7e-7);
+	}
+}
@@ -0,0 +1,97 @@
+#include "TestFramework.h"
+
+#include <random>
+
+#include "MathUtility.h"
+
+// ベクトルの演算と、それを使う行列の生成の回帰テスト
+
+namespace {
+	Vector3 RandomVector3(std::mt19937& random) {
+		std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+		return Vector3(dist(random), dist(random), dist(random));
+	}
+}
+
+TEST_CASE(SubtractComponents) {
+	// z 成分は引き算(以前は足し算になっていた)
+	Vector3 v3 = Vector3(5.0f, 7.0f, 9.0f) - Vector3(1.0f, 2.0f, 3.0f);
+	CHECK(v3.x == 4.0f);
+	CHECK(v3.y == 5.0f);
+	CHECK(v3.z == 6.0f);
+	Vector4 v4 = Vector4(5.0f, 7.0f, 9.0f, 11.0f) - Vector4(1.0f, 2.0f, 3.0f, 4.0f);
+	CHECK(v4.x == 4.0f);
+	CHECK(v4.y == 5.0f);
+	CHECK(v4.z == 6.0f);
+	CHECK(v4.w == 7.0f);
+
+	std::mt19937 random(3);
+	for (int trial = 0; trial < 1000; trial++) {
+		Vector3 a = RandomVector3(random), b = RandomVector3(random);
+		CHECK(a - b == a + -b);
+		CHECK(Vector4(a, 1.0f) - Vector4(b, 1.0f) == Vector4(a - b, 0.0f));
+	}
+}
+
+TEST_CASE(Vector4NotEqual) {
+	// どれか一つの成分が違えば等しくない(以前は && が混ざって z, w だけの違いを見落とした)
+	const Vector4 v(1.0f, 2.0f, 3.0f, 4.0f);
+	CHECK(!(v != v));
+	CHECK(v != Vector4(0.0f, 2.0f, 3.0f, 4.0f));
+	CHECK(v != Vector4(1.0f, 0.0f, 3.0f, 4.0f));
+	CHECK(v != Vector4(1.0f, 2.0f, 0.0f, 4.0f));
+	CHECK(v != Vector4(1.0f, 2.0f, 3.0f, 0.0f));
+}
+
+TEST_CASE(CrossOfBasisVectors) {
+	Vector3 z = Cross(Vector3::UnitX, Vector3::UnitY);
+	Vector3 x = Cross(Vector3::UnitY, Vector3::UnitZ);
+	Vector3 y = Cross(Vector3::UnitZ, Vector3::UnitX);
+	CHECK(z == Vector3::UnitZ);
+	CHECK(x == Vector3::UnitX);
+	// y 成分は z1 * x2 - x1 * z2 (以前は x1 - z2 になっていた)
+	CHECK(y == Vector3::UnitY);
+}
+
+TEST_CASE(CrossComponents) {
+	Vector3 result = Cross(Vector3(1.0f, 2.0f, 3.0f), Vector3(4.0f, 5.0f, 6.0f));
+	CHECK(result.x == -3.0f);
+	CHECK(result.y == 6.0f);
+	CHECK(result.z == -3.0f);
+}
+
+TEST_CASE(CrossIsOrthogonalAndAntiCommutative) {
+	std::mt19937 random(1);
+	for (int trial = 0; trial < 10000; trial++) {
+		Vector3 a = RandomVector3(random), b = RandomVector3(random);
+		Vector3 c = Cross(a, b);
+		float scale = a.Length() * b.Length() * 10.0f;
+		CHECK_NEAR(Dot(c, a), 0.0f, scale * 1e-6f);
+		CHECK_NEAR(Dot(c, b), 0.0f, scale * 1e-6f);
+		CHECK_NEAR(Distance(Cross(b, a), -c), 0.0f, scale * 1e-6f);
+	}
+}
+
+TEST_CASE(LookAtIsOrthonormal) {
+	std::mt19937 random(2);
+	for (int trial = 0; trial < 1000; trial++) {
+		Vector3 eye = RandomVector3(random), target = RandomVector3(random);
+		Matrix44 view = Matrix44::CreateView(eye, target, Vector3::UnitY);
+		Matrix44 lookAt = Matrix44::CreateLookAt(eye, target, Vector3::UnitY);
+		Vector3 x = lookAt.GetXAxis(), y = lookAt.GetYAxis(), z = lookAt.GetZAxis();
+		CHECK_NEAR(Dot(x, y), 0.0f, 1e-5f);
+		CHECK_NEAR(Dot(y, z), 0.0f, 1e-5f);
+		CHECK_NEAR(Dot(z, x), 0.0f, 1e-5f);
+		CHECK_NEAR(y.Length(), 1.0f, 1e-5f);
+		// 基底の向きがそろっている(x × y = z)
+		CHECK_NEAR(Distance(Cross(x, y), z), 0.0f, 1e-5f);
+
+		// ビュー行列は視点を原点に、注視点を +z 上に移す
+		Vector3 eyeInView = eye * view;
+		Vector3 targetInView = target * view;
+		CHECK_NEAR(eyeInView.Length(), 0.0f, 1e-4f);
+		CHECK_NEAR(targetInView.x, 0.0f, 1e-4f);
+		CHECK_NEAR(targetInView.y, 0.0f, 1e-4f);
+		CHECK_NEAR(targetInView.z, Distance(eye, target), 1e-4f);
+	}
+}
@@ -0,0 +1,105 @@
+#pragma once
+#ifndef TESTFRAMEWORK_H_
+#define TESTFRAMEWORK_H_
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+/// <summary>
+/// テストの登録と実行(外部のライブラリを使わない最小限のもの)
+/// TEST_CASE で関数を登録し、CHECK で失敗を数える。REQUIRE は失敗したらそのテストを抜ける
+/// </summary>
+namespace Test
+{
+	struct Case {
+		const char* name;
+		void (*function)();
+	};
+
+	inline std::vector<Case>& GetCases() {
+		static std::vector<Case> cases;
+		return cases;
+	}
+
+	inline int& GetFailureCount() {
+		static int failureCount = 0;
+		return failureCount;
+	}
+
+	struct Registrar {
+		Registrar(const char* name, void (*function)()) {
+			GetCases().push_back(Case{ name, function });
+		}
+	};
+
+	inline void ReportFailure(const char* file, int line, const char* expression) {
+		std::printf("%s(%d): failed: %s\n", file, line, expression);
+		GetFailureCount()++;
+	}
+
+	/// <summary>
+	/// 登録したテストを実行(引数があれば名前に含むものだけ)
+	/// </summary>
+	/// <returns>失敗が無ければ 0</returns>
+	inline int RunAll(int argc, char** argv) {
+		const char* filter = argc > 1 ? argv[1] : nullptr;
+		int runCount = 0;
+		for (const Case& testCase : GetCases()) {
+			if (filter != nullptr && std::strstr(testCase.name, filter) == nullptr) {
+				continue;
+			}
+			int failureCount = GetFailureCount();
+			testCase.function();
+			std::printf("[%s] %s\n", GetFailureCount() == failureCount ? "  OK  " : " FAIL ", testCase.name);
+			runCount++;
+		}
+		std::printf("%d tests, %d failures\n", runCount, GetFailureCount());
+		return GetFailureCount() == 0 && runCount > 0 ? 0 : 1;
+	}
+
+	/// <summary>
+	/// 経過時間を測る(ベンチマーク用)
+	/// </summary>
+	class Stopwatch
+	{
+	public:
+		Stopwatch() : start_(std::chrono::steady_clock::now()) {}
+		inline double GetMilliseconds() const {
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_).count();
+		}
+
+	private:
+		std::chrono::steady_clock::time_point start_;
+	};
+
+	/// <summary>
+	/// 最適化で計算を消されないようにする(ベンチマーク用)
+	/// </summary>
+	template<class TYPE>
+	inline void DoNotOptimize(const TYPE& value) {
+		static volatile const void* sink;
+		sink = &value;
+		(void)sink;
+	}
+}
+
+#define TEST_CASE(name) \
+	static void name(); \
+	static Test::Registrar name##Registrar_(#name, name); \
+	static void name()
+
+#define CHECK(expression) \
+	do { if (!(expression)) { Test::ReportFailure(__FILE__, __LINE__, #expression); } } while (false)
+
+#define CHECK_NEAR(actual, expected, tolerance) \
+	do { if (!(std::fabs(static_cast<double>(actual) - static_cast<double>(expected)) <= static_cast<double>(tolerance))) { \
+		std::printf("  actual %.9g expected %.9g\n", static_cast<double>(actual), static_cast<double>(expected)); \
+		Test::ReportFailure(__FILE__, __LINE__, #actual " ~= " #expected); } } while (false)
+
+#define REQUIRE(expression) \
+	do { if (!(expression)) { Test::ReportFailure(__FILE__, __LINE__, #expression); return; } } while (false)
+
+#endif
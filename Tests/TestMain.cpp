@@ -0,0 +1,5 @@
+#include "TestFramework.h"
+
+int main(int argc, char** argv) {
+	return Test::RunAll(argc, argv);
+}
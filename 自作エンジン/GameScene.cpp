@@ -2,6 +2,7 @@
 
 #include "DirectXCommon.h"
 #include "Sprite.h"
+#include "TextureManager.h"
 
 GameScene::GameScene()
 {
@@ -14,7 +15,9 @@ GameScene::~GameScene()
 void GameScene::Initalize()
 {
 	sprite_ = std::make_unique<Sprite>();
-	sprite_->CreateBuffers();
+	// 小さな画像は実行時のアトラスに詰める(同じページのスプライトは一度の描画にまとまる)
+	TextureManager::LoadTextureToAtlas("../Resources/Images/white32x32.png");
+	sprite_->SetTextureRect("../Resources/Images/white32x32.png");
 }
 
 void GameScene::Update()
@@ -1,13 +1,56 @@
+#include <cassert>
+#include <filesystem>
+#include <format>
+#include <string>
+#include <string_view>
+
 #include "WinApp.h"
 #include "DirectXCommon.h"
 #include "TextureManager.h"
 #include "Input.h"
 #include "Scene.h"
+#include "ShaderLibrary.h"
 #include "GameScene.h"
 #include "Sprite.h"
+#include "SpriteBatch.h"
+#include "ThreadPool.h"
+
+namespace {
+	// Atlas フォルダの画像はまとめたページとして読み込む
+	const std::string kAtlasImageDirectory = "../Resources/Images/Atlas";
+	const std::string kAtlasLookupPath = "../Resources/Atlas/atlas.txt";
+
+	/// <summary>
+	/// 画像が一覧より新しければアトラスをまとめ直す(ビルドの後に --cook-atlas を付けて実行される)
+	/// </summary>
+	/// <returns>終了コード</returns>
+	int CookAtlas() {
+		if (!std::filesystem::is_directory(kAtlasImageDirectory) || !TextureManager::IsAtlasOutdated(kAtlasImageDirectory, kAtlasLookupPath)) {
+			return 0;
+		}
+		// WIC で画像を読み書きする
+		HRESULT result = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+		if (FAILED(result)) {
+			return 1;
+		}
+		std::filesystem::create_directories(std::filesystem::path(kAtlasLookupPath).parent_path());
+		bool isCooked = TextureManager::CookAtlas(kAtlasImageDirectory, kAtlasLookupPath, TextureAtlasBuilder::Options{});
+		CoUninitialize();
+		return isCooked ? 0 : 1;
+	}
+}
 
 int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_  HINSTANCE hPrevInstance, _In_ LPSTR lpCmdLine, _In_ int nShowCmd) {
 
+	// ビルドの手順として呼ばれた場合はウィンドウを作らない
+	if (std::string_view(lpCmdLine) == "--cook-atlas") {
+		return CookAtlas();
+	}
+
+	auto threadPool = ThreadPool::GetInstance();
+	threadPool->Initalize();
+	// コンパイル済みシェーダーが揃っているかを最初に確かめる
+	ShaderLibrary::GetInstance()->Initalize();
 	auto winApp = WinApp::GetInstance();
 	winApp->CreateGameWindow();
 	auto dixCom = DirectXCommon::GetInstance();
@@ -15,13 +58,21 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_  HINSTANCE hPrevInstance,
 	auto texMana = TextureManager::GetInstance();
 	texMana->Initalize();
 	TextureManager::LoadTexture("../Resources/Images/white1x1.png");
+	{
+		// アトラスはビルドの後にまとめ直してあるので読むだけ
+		bool isAtlasLoaded = TextureManager::LoadAtlas(kAtlasLookupPath);
+		assert(isAtlasLoaded || !std::filesystem::is_directory(kAtlasImageDirectory));
+		assert(!isAtlasLoaded || !TextureManager::IsAtlasOutdated(kAtlasImageDirectory, kAtlasLookupPath));
+		(void)isAtlasLoaded;
+	}
 	auto input = Input::GetInstance();
 	input->Initialize();
 	Sprite::StaticInitalize();
+	SpriteBatch::StaticInitalize();
 
 	auto scene = SceneManager::GetInstance();
 	scene->Initalize();
-	// ŏ̃V[GameScene
+	// 最初のシーンをGameSceneに
 	scene->Transition<GameScene>();
 
 	while (winApp->WindowQuit() == false)
@@ -31,11 +82,44 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_  HINSTANCE hPrevInstance,
 		
 		scene->Update();
 		
-		scene->Draw();
+		dixCom->AddScenePass([scene]() { scene->Draw(); });
 		
 		dixCom->PostDraw();
 	}
+	// 先行しているフレームを終えてから解放する
+	dixCom->WaitIdle();
+	// 次回の起動のために残す(ワーカーが作っているものを待つ)
+	dixCom->GetPipelineCache()->Save();
+	{
+		// パイプラインは初めて使うときに作るので実行全体で数える
+		// 二回目以降の起動ではファイルのバイナリから作るので生成時間が短くなる
+		auto cacheStats = dixCom->GetPipelineCache()->GetStatistics();
+		OutputDebugStringA(std::format(
+			"PipelineCache: pipeline hit {} / disk {} / miss {} / reject {} / prewarm {}, root signature hit {} / disk {} / miss {}, create {:.2f} ms, load {:.2f} ms\n",
+			cacheStats.pipelineHitCount, cacheStats.pipelineDiskHitCount, cacheStats.pipelineMissCount, cacheStats.pipelineRejectCount, cacheStats.prewarmCount,
+			cacheStats.rootSignatureHitCount, cacheStats.rootSignatureDiskHitCount, cacheStats.rootSignatureMissCount,
+			cacheStats.createMilliseconds, cacheStats.loadMilliseconds).c_str());
+	}
+	{
+		// 断片化が大きければページの大きさを見直すか Defragment を使う
+		auto memoryStats = dixCom->GetGpuMemoryAllocator()->GetStatistics();
+		OutputDebugStringA(std::format(
+			"GpuMemory: pages {} (dedicated {}), heap {:.1f} MB, used {:.1f} MB by {} resources, free blocks {}, largest free {:.1f} MB, fragmentation {:.2f}\n",
+			memoryStats.pageCount, memoryStats.dedicatedPageCount,
+			memoryStats.heapSize / (1024.0 * 1024.0), memoryStats.usedSize / (1024.0 * 1024.0), memoryStats.allocationCount,
+			memoryStats.freeBlockCount, memoryStats.largestFreeSize / (1024.0 * 1024.0), memoryStats.fragmentation).c_str());
+	}
+	{
+		// 待ちが多ければステージング領域を大きくする
+		auto uploadStats = dixCom->GetTextureUploader()->GetStatistics();
+		OutputDebugStringA(std::format(
+			"TextureUpload: {} textures in {} submits ({} copies), staged {:.1f} MB, peak {:.1f} MB, wrap {}, stall {}\n",
+			uploadStats.textureCount, uploadStats.submitCount, uploadStats.copyCount,
+			uploadStats.stagedBytes / (1024.0 * 1024.0), uploadStats.staging.peakUsedBytes / (1024.0 * 1024.0),
+			uploadStats.staging.wrapCount, uploadStats.staging.stallCount).c_str());
+	}
 
+	threadPool->Finalize();
 	winApp->TerminateGameWindow();
 
 	return 0;